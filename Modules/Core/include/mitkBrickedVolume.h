@@ -0,0 +1,116 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkBrickedVolume_h
+#define mitkBrickedVolume_h
+
+#include <itkIntTypes.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace mitk
+{
+  /** \brief Type independent base of BrickedVolume, e.g. to keep bricked volumes of arbitrary pixel type in a cache.
+   */
+  class BrickedVolumeBase
+  {
+  public:
+    virtual ~BrickedVolumeBase() {}
+
+    /** \brief Modification time of the image the bricked volume was created from. */
+    itk::ModifiedTimeType GetSourceMTime() const { return m_SourceMTime; }
+    void SetSourceMTime(itk::ModifiedTimeType mTime) { m_SourceMTime = mTime; }
+
+  protected:
+    BrickedVolumeBase() : m_SourceMTime(0) {}
+
+  private:
+    itk::ModifiedTimeType m_SourceMTime;
+  };
+
+  /** \brief Copy of a 3-d volume in bricked voxel layout.
+   *
+   * The volume is split into cubic bricks of BrickEdgeLength^3 voxels and every brick is stored contiguously.
+   * Within a brick, voxels are stored x-fastest. Neighboring voxels in y- and z-direction are therefore much
+   * closer in memory than in the linear layout of mitk::Image, which makes sampling along sagittal, coronal or
+   * oblique planes about as cache friendly as sampling along axial planes.
+   *
+   * The volume is padded to multiples of BrickEdgeLength. Only scalar pixel types are supported.
+   *
+   * \sa ExtractSliceFilter2::SetUseBrickedLayout()
+   */
+  template <typename TPixel>
+  class BrickedVolume : public BrickedVolumeBase
+  {
+  public:
+    typedef TPixel PixelType;
+
+    static const unsigned int BrickEdgeBits = 4;
+    static const unsigned int BrickEdgeLength = 1u << BrickEdgeBits;
+    static const unsigned int BrickEdgeMask = BrickEdgeLength - 1;
+
+    /** \brief Creates the bricked copy of the x-fastest volume @a linearData with size @a dimensions. */
+    BrickedVolume(const TPixel *linearData, const unsigned int *dimensions)
+    {
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        m_Dimensions[i] = dimensions[i];
+        m_NumberOfBricks[i] = (dimensions[i] + BrickEdgeMask) >> BrickEdgeBits;
+      }
+
+      const std::size_t brickSize = BrickEdgeLength * BrickEdgeLength * BrickEdgeLength;
+      m_Data.resize(brickSize * m_NumberOfBricks[0] * m_NumberOfBricks[1] * m_NumberOfBricks[2], TPixel());
+
+      // Copy whole brick rows at once, so the source is read linearly
+      const TPixel *source = linearData;
+      for (unsigned int z = 0; z < m_Dimensions[2]; ++z)
+      {
+        for (unsigned int y = 0; y < m_Dimensions[1]; ++y)
+        {
+          for (unsigned int x = 0; x < m_Dimensions[0]; x += BrickEdgeLength)
+          {
+            const unsigned int length = std::min(BrickEdgeLength, m_Dimensions[0] - x);
+            std::copy(source, source + length, m_Data.begin() + this->GetOffset(x, y, z));
+            source += length;
+          }
+        }
+      }
+    }
+
+    unsigned int GetDimension(unsigned int i) const { return m_Dimensions[i]; }
+
+    /** \brief Memory used by the bricked copy in bytes. */
+    std::size_t GetSizeInBytes() const { return m_Data.size() * sizeof(TPixel); }
+
+    std::size_t GetOffset(unsigned int x, unsigned int y, unsigned int z) const
+    {
+      const std::size_t brick =
+        ((static_cast<std::size_t>(z >> BrickEdgeBits) * m_NumberOfBricks[1] + (y >> BrickEdgeBits)) *
+           m_NumberOfBricks[0] +
+         (x >> BrickEdgeBits));
+
+      return (brick << (3 * BrickEdgeBits)) +
+             ((((z & BrickEdgeMask) << BrickEdgeBits) + (y & BrickEdgeMask)) << BrickEdgeBits) + (x & BrickEdgeMask);
+    }
+
+    TPixel GetPixel(unsigned int x, unsigned int y, unsigned int z) const { return m_Data[this->GetOffset(x, y, z)]; }
+
+  private:
+    std::vector<TPixel> m_Data;
+    unsigned int m_Dimensions[3];
+    unsigned int m_NumberOfBricks[3];
+  };
+}
+
+#endif
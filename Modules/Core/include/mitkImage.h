@@ -24,6 +24,11 @@ found in the LICENSE file.
 #include <MitkCoreExports.h>
 #include <mitkProportionalTimeGeometry.h>
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
 // DEPRECATED
 #include <mitkTimeSlicedGeometry.h>
 
@@ -259,6 +264,18 @@ namespace mitk
                                   int n = 0,
                                   ImportMemoryManagementType importMemoryManagement = CopyMemory);
 
+    /**
+      * @brief Use the uncompressed raw data in file @a fileName, starting at byte @a offset, as channel @a n.
+      *
+      * The file is memory mapped copy-on-write instead of being read: data is paged in on first access only,
+      * so e.g. time steps that are never accessed do not cost resident memory. Changes to the image data are
+      * never written back to the file. It is in the responsibility of the caller to ensure that the data in the
+      * file matches pixel type, dimensions and byte order of the image.
+      * @throws mitk::Exception if the file cannot be mapped (e.g. it is too small).
+      * @sa MemoryMappedFile
+      */
+    virtual bool SetMappedChannel(const std::string &fileName, std::size_t offset = 0, int n = 0);
+
     /**
       * initialize new (or re-initialize) image information
       * @warning Initialize() by pic assumes a plane, evenly spaced geometry starting at (0,0,0).
@@ -744,6 +761,15 @@ namespace mitk
 
     /** A mutex, which needs to be locked to manage m_Readers and m_Writers */
     itk::SimpleFastMutexLock m_ReadWriteLock;
+    /** Number of ImageWriteAccessors that are either registered in m_Writers or waiting to be. As long as it is
+        zero, ImageReadAccessors are granted access without touching m_ReadWriteLock. */
+    mutable std::atomic<unsigned int> m_PendingWriterCount;
+    /** Slots of the ImageReadAccessors that were granted lock-free access and are therefore not listed in
+        m_Readers. If all slots are in use, further readers use the registered access. */
+    mutable std::array<ImageAccessorLockFreeSlot, 16> m_LockFreeReaderSlots;
+    /** Released lock-free ImageReadAccessors notify m_LockFreeReaderReleased while writers are pending */
+    mutable std::mutex m_LockFreeReaderMutex;
+    mutable std::condition_variable m_LockFreeReaderReleased;
     /** A mutex, which needs to be locked to manage m_VtkReaders */
     itk::SimpleFastMutexLock m_VtkReadersLock;
   };
@@ -21,6 +21,8 @@ found in the LICENSE file.
 
 #include "mitkImageDataItem.h"
 
+#include <atomic>
+
 namespace mitk
 {
   //##Documentation
@@ -40,6 +42,27 @@ namespace mitk
     itk::SimpleFastMutexLock m_Mutex;
   };
 
+  /** \brief A slot of an mitk::Image, in which an ImageReadAccessor with lock-free access publishes its image part.
+
+    A reader claims a free slot, stores its memory area and activates the slot. Writers only wait for active slots
+    whose memory area overlaps their own.
+  */
+  struct ImageAccessorLockFreeSlot
+  {
+    enum State
+    {
+      Free,
+      Claimed,
+      Active
+    };
+
+    ImageAccessorLockFreeSlot() : m_State(Free), m_AddressBegin(nullptr), m_AddressEnd(nullptr) {}
+
+    std::atomic<int> m_State;
+    std::atomic<void *> m_AddressBegin;
+    std::atomic<void *> m_AddressEnd;
+  };
+
 // Defs to assure dead lock prevention only in case of possible thread handling.
 #if defined(ITK_USE_SPROC) || defined(ITK_USE_PTHREADS) || defined(ITK_USE_WIN32_THREADS)
 #define MITK_USE_RECURSIVE_MUTEX_PREVENTION
@@ -121,9 +144,16 @@ namespace mitk
     /** Defines if the accessed image part lies coherently in memory */
     bool m_CoherentMemory;
 
-    /** \brief Pointer to a WaitLock struct, that allows other ImageAccessors to wait for this ImageAccessor */
+    /** \brief Pointer to a WaitLock struct, that allows other ImageAccessors to wait for this ImageAccessor.
+      * It is only created (see CreateWaitLock()) for accessors that are registered in the Image, i.e. it stays
+      * nullptr for ImageReadAccessors using the lock-free path.
+      */
     ImageAccessorWaitLock *m_WaitLock;
 
+    /** \brief Creates m_WaitLock, if not done yet. A call of this method is prohibited unless the Mutex
+     * m_ReadWriteLock in the mitk::Image class is Locked. */
+    void CreateWaitLock();
+
     /** \brief Increments m_WaiterCount. A call of this method is prohibited unless the Mutex m_ReadWriteLock in the
      * mitk::Image class is Locked. */
     inline void Increment() { m_WaitLock->m_WaiterCount += 1; }
@@ -133,6 +163,9 @@ namespace mitk
       */
     bool Overlap(const ImageAccessorBase *iAB);
 
+    /** \brief Computes if the memory area [addressBegin, addressEnd) overlaps the image part of this ImageAccessor */
+    bool Overlap(const void *addressBegin, const void *addressEnd) const;
+
     /** \brief Uses the WaitLock to wait for another ImageAccessor*/
     void WaitForReleaseOf(ImageAccessorWaitLock *wL);
 
@@ -141,6 +174,16 @@ namespace mitk
     /** \brief Prevents a recursive mutex lock by comparing thread ids of competing image accessors */
     void PreventRecursiveMutexLock(ImageAccessorBase *iAB);
 
+    /** \brief Remembers that the calling thread holds the given lock-free read access */
+    static void RegisterLockFreeReadAccess(const ImageAccessorBase *accessor);
+
+    /** \brief Forgets the given lock-free read access of the calling thread */
+    static void UnregisterLockFreeReadAccess(const ImageAccessorBase *accessor);
+
+    /** \brief Checks if the calling thread holds a lock-free read access to the given image, which overlaps the
+     * image part of this ImageAccessor */
+    bool HoldsOverlappingLockFreeReadAccess(const Image *image) const;
+
     virtual const Image *GetImage() const = 0;
 
   private:
@@ -20,10 +20,13 @@ found in the LICENSE file.
 #include "mitkImageDescriptor.h"
 //#include "mitkImageVtkAccessor.h"
 
+#include <memory>
+
 class vtkImageData;
 
 namespace mitk
 {
+  class MemoryMappedFile;
   class PixelType;
   class ImageVtkReadAccessor;
   class ImageVtkWriteAccessor;
@@ -86,6 +89,14 @@ namespace mitk
                   void *data,
                   bool manageMemory);
 
+    /**
+     * @brief Creates an item whose data is backed by a memory mapped file instead of a heap buffer.
+     *
+     * The data is paged in on first access. The item keeps the mapping alive, as do all items that
+     * reference parts of it (e.g. volumes of a mapped channel).
+     */
+    ImageDataItem(const mitk::ImageDescriptor::Pointer desc, int timestep, std::shared_ptr<MemoryMappedFile> mappedFile);
+
     ImageDataItem(const ImageDataItem &other);
 
     /**
@@ -130,6 +141,9 @@ namespace mitk
     size_t GetSize() const { return m_Size; }
     virtual void Modified() const;
 
+    /** Returns if the data of this item (or of its parent) is backed by a memory mapped file. */
+    bool IsMemoryMapped() const { return m_MappedFile != nullptr || (m_Parent.IsNotNull() && m_Parent->IsMemoryMapped()); }
+
   protected:
     unsigned char *m_Data;
 
@@ -151,6 +165,9 @@ namespace mitk
 
     ImageDataItem::ConstPointer m_Parent;
 
+    /** Keeps the mapping alive, if m_Data points into a memory mapped file */
+    std::shared_ptr<MemoryMappedFile> m_MappedFile;
+
     unsigned int m_Dimension;
 
     unsigned int m_Dimensions[MAX_IMAGE_DIMENSIONS];
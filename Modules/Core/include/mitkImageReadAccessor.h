@@ -22,6 +22,11 @@ namespace mitk
 
   /**
    * @brief ImageReadAccessor class to get locked read access for a particular image part
+   *
+   * As long as no ImageWriteAccessor is pending for the image, read access is granted lock-free: the accessor is
+   * only counted in the image instead of being registered under the image-wide mutex. As soon as a writer shows up,
+   * new readers fall back to the registered (region based) locking, and the writer waits until all lock-free
+   * readers are released.
    * @ingroup Data
    */
   class MITKCORE_EXPORT ImageReadAccessor : public ImageAccessorBase
@@ -63,10 +68,21 @@ namespace mitk
     /** \brief manages a consistent read access and locks the ordered image part */
     void OrganizeReadAccess();
 
+    /** \brief grants read access without registering in the image, if no writer is pending and a lock-free slot
+     *  of the image is free
+     *  \return true, if lock-free access was granted; false if the registered access has to be used */
+    bool TryLockFreeReadAccess();
+
+    /** \brief frees the lock-free slot and wakes up pending writers */
+    void ReleaseLockFreeSlot(ImageAccessorLockFreeSlot *slot);
+
     ImageReadAccessor &operator=(const ImageReadAccessor &); // Not implemented on purpose.
     ImageReadAccessor(const ImageReadAccessor &);
 
     ImageConstPointer m_Image;
+
+    /** \brief The slot of the image, if the access was granted via TryLockFreeReadAccess() */
+    ImageAccessorLockFreeSlot *m_LockFreeSlot;
   };
 }
 
@@ -0,0 +1,161 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkImageSliceCache_h
+#define mitkImageSliceCache_h
+
+#include <MitkCoreExports.h>
+#include <mitkTimeGeometry.h>
+
+#include <vtkImageData.h>
+#include <vtkMatrix4x4.h>
+#include <vtkSmartPointer.h>
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace mitk
+{
+  class Image;
+  class PlaneGeometry;
+
+  /** \brief Least recently used cache of resliced 2-d images shared by all renderers.
+   *
+   * Reslicing is the most expensive step of rendering an image in a 2-d render window.
+   * Render windows that show the same plane, and scrolling back to a previously shown
+   * plane, can reuse slices from this cache instead of reslicing the image again.
+   *
+   * Slices are identified by the address of the image and its modification time, the
+   * plane geometry and its reference geometry (compared by value), the time step, the
+   * interpolation mode, and the thick slice settings. Code that changes the pixels of an
+   * image must therefore call Modified() on the image, otherwise outdated slices are
+   * returned. Slices of modified images are never returned and are removed as soon as a
+   * slice of the modified image is added.
+   *
+   * The cache does not observe the images. Slices of a deleted image are never returned
+   * either, because an image that is created at the same address gets a later modification
+   * time. They are removed as soon as such an image adds a slice, or when they are the
+   * least recently used slices.
+   *
+   * The cache is limited by a memory budget. Least recently used slices are removed
+   * when the budget is exceeded. A budget of 0 disables the cache.
+   *
+   * The cache is thread-safe.
+   *
+   * \sa ImageVtkMapper2D
+   */
+  class MITKCORE_EXPORT ImageSliceCache
+  {
+  public:
+    /** \brief Identifies a resliced image. */
+    class MITKCORE_EXPORT SliceKey
+    {
+    public:
+      SliceKey(const Image *image,
+               const PlaneGeometry *planeGeometry,
+               TimeStepType timeStep,
+               int interpolationMode,
+               int thickSlicesMode,
+               int thickSlicesNum,
+               bool inPlaneResampleExtentByGeometry);
+
+      const Image *GetImage() const { return m_Image; }
+
+      bool operator<(const SliceKey &other) const;
+
+    private:
+      const Image *m_Image;
+      itk::ModifiedTimeType m_ImageMTime;
+      TimeStepType m_TimeStep;
+      int m_InterpolationMode;
+      int m_ThickSlicesMode;
+      int m_ThickSlicesNum;
+      bool m_InPlaneResampleExtentByGeometry;
+      std::vector<double> m_Geometry;
+
+      friend class ImageSliceCache;
+    };
+
+    /** \brief A resliced image together with the reslicer state needed to display it. */
+    struct Slice
+    {
+      vtkSmartPointer<vtkImageData> Image;
+      vtkSmartPointer<vtkMatrix4x4> ResliceAxes;
+      ScalarType Spacing[2];
+    };
+
+    static ImageSliceCache *GetInstance();
+
+    /** \brief Get a cached slice.
+     *
+     * The returned image is shared by all users of the cache and must not be modified.
+     *
+     * \return False if the slice is not cached.
+     */
+    bool GetSlice(const SliceKey &key, Slice &slice);
+
+    /** \brief Add a slice to the cache.
+     *
+     * The slice is stored as is, i.e. the image and reslice axes must not be modified afterwards.
+     * Slices larger than the memory budget are not cached, nor are slices of a previous version
+     * of an image whose current version is cached already.
+     */
+    void AddSlice(const SliceKey &key, const Slice &slice);
+
+    /** \brief Remove all slices of an image, e.g. to release their memory before it is deleted. */
+    void RemoveSlices(const Image *image);
+
+    void Clear();
+
+    /** \brief Memory budget in bytes. Default is 128 MiB. */
+    std::size_t GetMemoryBudget() const;
+    void SetMemoryBudget(std::size_t memoryBudget);
+
+    /** \brief Memory in bytes used by all cached slices. */
+    std::size_t GetMemoryUsage() const;
+
+    std::size_t GetNumberOfSlices() const;
+
+  private:
+    struct Entry
+    {
+      SliceKey Key;
+      Slice Value;
+      std::size_t Size;
+    };
+
+    typedef std::list<Entry> EntryList;
+    typedef std::map<SliceKey, EntryList::iterator> IndexType;
+
+    ImageSliceCache();
+    ~ImageSliceCache();
+
+    ImageSliceCache(const ImageSliceCache &) = delete;
+    ImageSliceCache &operator=(const ImageSliceCache &) = delete;
+
+    /** \brief First slice of the image in the index whose modification time is at least imageMTime. */
+    IndexType::iterator FindFirstSlice(const Image *image, itk::ModifiedTimeType imageMTime);
+
+    void RemoveEntry(EntryList::iterator entry);
+    void EnforceMemoryBudget();
+
+    mutable std::mutex m_Mutex;
+    EntryList m_Entries;
+    IndexType m_Index;
+    std::size_t m_MemoryBudget;
+    std::size_t m_MemoryUsage;
+  };
+}
+
+#endif
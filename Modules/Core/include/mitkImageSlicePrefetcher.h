@@ -0,0 +1,140 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkImageSlicePrefetcher_h
+#define mitkImageSlicePrefetcher_h
+
+#include <MitkCoreExports.h>
+#include <mitkImage.h>
+#include <mitkImageSliceCache.h>
+#include <mitkImageVtkMapper2D.h>
+#include <mitkPlaneGeometry.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace mitk
+{
+  class BaseRenderer;
+
+  /** \brief Reslices images in background threads and stores the slices in the mitk::ImageSliceCache.
+   *
+   * Slices are resliced exactly like mitk::ImageVtkMapper2D does, so the mapper finds them in the
+   * cache instead of reslicing the image on the render thread. The mitk::SliceNavigationController
+   * uses the prefetcher to reslice the slices ahead of the current scrolling direction.
+   *
+   * Requests are created on the main thread by AddRequests(). They reference the pixel data of the
+   * image but are resliced from an image of their own, i.e. the worker threads never touch the
+   * pipeline of the requested image. Slices of images that were modified before or while being
+   * resliced are discarded.
+   *
+   * The requested images are referenced and observed by the prefetcher on the thread that owns it,
+   * which also releases them in Prefetch(), Cancel(), WaitForCompletion() or the destructor once
+   * their requests are processed. Thus an image is never deleted by a worker thread.
+   *
+   * All prefetchers share a small pool of worker threads, which take the requests of the
+   * prefetchers in turns.
+   *
+   * Pending requests are replaced by each call of Prefetch(), so only the slices around the most
+   * recent position are resliced.
+   */
+  class MITKCORE_EXPORT ImageSlicePrefetcher
+  {
+  public:
+    /** \brief A slice to be resliced. */
+    struct Request
+    {
+      ImageSliceCache::SliceKey Key;
+      Image::ConstPointer RequestedImage;
+      itk::ModifiedTimeType RequestedImageMTime;
+      TimeStepType TimeStep;
+      BaseGeometry::ConstPointer ImageGeometry;
+      PlaneGeometry::ConstPointer WorldGeometry;
+      ImageVtkMapper2D::ResliceParameters ResliceParameters;
+    };
+
+    ImageSlicePrefetcher();
+    ~ImageSlicePrefetcher();
+
+    /** \brief Create requests for all images rendered by mitk::ImageVtkMapper2D in a renderer.
+     *
+     * \param renderer The renderer whose data storage and properties are used.
+     * \param worldGeometry The plane to reslice, typically a slice of the world geometry of the renderer.
+     * \param timeStep Time step of the world geometry of the renderer.
+     * \param requests The created requests are appended.
+     */
+    static void AddRequests(BaseRenderer *renderer,
+                            const PlaneGeometry *worldGeometry,
+                            TimeStepType timeStep,
+                            std::vector<Request> &requests);
+
+    /** \brief Replace all pending requests. Requests are processed in the given order. */
+    void Prefetch(const std::vector<Request> &requests);
+
+    /** \brief Discard all pending requests. */
+    void Cancel();
+
+    /** \brief Block until all pending requests are processed. */
+    void WaitForCompletion();
+
+    /** \brief Number of slices that were resliced and added to the cache. */
+    std::size_t GetNumberOfPrefetchedSlices() const;
+
+  private:
+    class WorkerPool;
+
+    /** \brief Counts the modifications of a requested image, incremented by an observer on the owning thread. */
+    typedef std::shared_ptr<std::atomic<unsigned long>> ModificationCountPointer;
+
+    /** \brief A requested image, referenced and observed as long as requests of it are pending. */
+    struct ObservedImage
+    {
+      Image::ConstPointer RequestedImage;
+      unsigned long ObserverTag;
+      ModificationCountPointer ModificationCount;
+    };
+
+    /** \brief A request as seen by the worker threads, without a reference to the image. */
+    struct PendingRequest
+    {
+      Request Data;
+      const Image *RequestedImage;
+      ModificationCountPointer ModificationCount;
+      unsigned long RequestedModificationCount;
+    };
+
+    ImageSlicePrefetcher(const ImageSlicePrefetcher &) = delete;
+    ImageSlicePrefetcher &operator=(const ImageSlicePrefetcher &) = delete;
+
+    void ProcessRequest(const PendingRequest &request);
+
+    /** \brief Stop observing and release the images without pending requests. Called on the owning thread. */
+    void ReleaseUnusedImages();
+
+    WorkerPool *m_WorkerPool;
+
+    // Guarded by the mutex of the worker pool
+    std::condition_variable m_RequestsProcessed;
+    std::deque<PendingRequest> m_Requests;
+    std::vector<const Image *> m_ImagesInProcess;
+    std::size_t m_NumberOfPrefetchedSlices;
+
+    // Only accessed by the owning thread
+    std::map<const Image *, ObservedImage> m_ObservedImages;
+  };
+}
+
+#endif
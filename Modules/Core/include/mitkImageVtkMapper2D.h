@@ -194,6 +194,12 @@ namespace mitk
       /** \brief mmPerPixel relation between pixel and mm. (World spacing).*/
       mitk::ScalarType *m_mmPerPixel;
 
+      /** \brief Storage of m_mmPerPixel for slices taken from the ImageSliceCache. */
+      mitk::ScalarType m_CachedSliceSpacing[2];
+
+      /** \brief Reslice axes of the current slice, used to transform the actors. */
+      vtkSmartPointer<vtkMatrix4x4> m_ResliceAxes;
+
       /** \brief This filter is used to apply the level window to Grayvalue and RBG(A) images. */
       vtkSmartPointer<vtkMitkLevelWindowFilter> m_LevelWindowFilter;
 
@@ -209,6 +215,24 @@ namespace mitk
     /** \brief Set the default properties for general image rendering. */
     static void SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer = nullptr, bool overwrite = false);
 
+    /** \brief Parameters the mapper uses to reslice an image, see GetResliceParameters(). */
+    struct ResliceParameters
+    {
+      int InterpolationMode;
+      int ThickSlicesMode;
+      int ThickSlicesNum;
+      bool InPlaneResampleExtentByGeometry;
+    };
+
+    /** \brief Get the reslice parameters of an image from the properties of its node and of the
+     * plane geometry node of the renderer.
+     *
+     * Used to create mitk::ImageSliceCache keys that match the slices resliced by the mapper.
+     */
+    static ResliceParameters GetResliceParameters(const mitk::Image *image,
+                                                  const mitk::DataNode *node,
+                                                  mitk::BaseRenderer *renderer);
+
     /** \brief This method switches between different rendering modes (e.g. use a lookup table or a transfer function).
      * Detailed documentation about the modes can be found here: \link mitk::RenderingModeProperty \endlink
      */
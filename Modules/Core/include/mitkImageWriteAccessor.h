@@ -20,6 +20,9 @@ namespace mitk
 {
   /**
    * @brief ImageWriteAccessor class to get locked write-access for a particular image part.
+   *
+   * Lock-free ImageReadAccessors (see ImageReadAccessor) are not registered with their image part, so a writer
+   * waits until all of them are released before it registers itself.
    * @ingroup Data
    */
   class MITKCORE_EXPORT ImageWriteAccessor : public ImageAccessorBase
@@ -55,6 +58,17 @@ namespace mitk
     /** \brief manages a consistent write access and locks the ordered image part */
     void OrganizeWriteAccess();
 
+    /** \brief waits until all lock-free ImageReadAccessors of the image, whose image part overlaps the one of this
+     *  accessor, are released
+     *  \throws mitk::Exception if the calling thread holds an overlapping lock-free read access itself
+     *  \throws mitk::MemoryIsLockedException if overlapping lock-free readers exist and
+     * mitk::ImageAccessorBase::ExceptionIfLocked is set
+     */
+    void WaitForLockFreeReaders();
+
+    /** \brief checks if an active lock-free ImageReadAccessor overlaps the image part of this accessor */
+    bool OverlapsLockFreeReader() const;
+
     ImageWriteAccessor &operator=(const ImageWriteAccessor &); // Not implemented on purpose.
     ImageWriteAccessor(const ImageWriteAccessor &);
 
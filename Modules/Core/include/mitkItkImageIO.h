@@ -29,6 +29,11 @@ namespace mitk
    * For all ITK ImageIOs that support the serialization of MetaData
    * (e.g. nrrd or mhd) the ItkImageIO ensures the serialization
    * of Identification UID.
+   *
+   * For nrrd and mhd files, the reader option OPTION_MEMORY_MAPPING() allows
+   * to memory map uncompressed raw data instead of reading it (see
+   * Image::SetMappedChannel()). Files that cannot be mapped (e.g. compressed
+   * data, foreign byte order or multi-component pixels) are read as usual.
    */
   class MITKCORE_EXPORT ItkImageIO : public AbstractFileIO
   {
@@ -36,6 +41,9 @@ namespace mitk
     ItkImageIO(itk::ImageIOBase::Pointer imageIO);
     ItkImageIO(const CustomMimeType &mimeType, itk::ImageIOBase::Pointer imageIO, int rank);
 
+    /** Reader option (bool) to memory map uncompressed raw image data instead of reading it */
+    static std::string OPTION_MEMORY_MAPPING();
+
     // -------------- AbstractFileReader -------------
 
     using AbstractFileReader::Read;
@@ -54,6 +62,9 @@ namespace mitk
     // Fills the m_DefaultMetaDataKeys vector with default values
     virtual void InitializeDefaultMetaDataKeys();
 
+    // Sets the default reader options supported by the wrapped ITK ImageIO
+    virtual void InitializeDefaultReaderOptions();
+
     // -------------- AbstractFileReader -------------
     std::vector<itk::SmartPointer<BaseData>> DoRead() override;
 
@@ -100,6 +100,24 @@ namespace mitk
     //## @param limit the maximum number of items on the stack
     void SetUndoLimit(std::size_t limit) override;
 
+    //##Documentation
+    //## @brief Gets the limit on the memory of the undo history in bytes.
+    //## If the value is 0 that means that there is no limit.
+    std::size_t GetMemoryLimit() const;
+
+    //##Documentation
+    //## @brief Sets a limit on the memory of the undo history in bytes.
+    //## If the memory occupied by the items of the undo and the redo stack exceeds the
+    //## limit, the oldest undo items will be dropped from the bottom of the undo stack.
+    //## The most recent undo item is always kept, even if it exceeds the limit alone.
+    //## The 0 value means that there is no limit.
+    //## @param limit the maximum number of bytes of the stacks
+    void SetMemoryLimit(std::size_t limit);
+
+    //##Documentation
+    //## @brief Returns the number of bytes occupied by the items of the undo and the redo stack
+    std::size_t GetMemorySize() const;
+
     //##Documentation
     //## @brief Returns the ObjectEventId of the
     //## top element in the OperationHistory
@@ -128,6 +146,13 @@ namespace mitk
     //## elements in the list and to clear the list
     void ClearList(UndoContainer *list);
 
+    //## @brief Puts the item on top of the undo stack and drops the oldest undo items
+    //## until the undo limit and the memory limit are met
+    void PushUndoItem(UndoStackItem *item);
+
+    //## @brief Drops the oldest undo items until the undo limit and the memory limit are met
+    void ApplyLimits();
+
     UndoContainer m_UndoList;
 
     UndoContainer m_RedoList;
@@ -136,7 +161,10 @@ namespace mitk
     int FirstObjectEventIdOfCurrentGroup(UndoContainer &stack);
 
     std::size_t m_UndoLimit;
+    std::size_t m_MemoryLimit;
 
+    // sum of the memory sizes of the items of both stacks
+    std::size_t m_MemorySize;
   };
 
 #pragma GCC visibility push(default)
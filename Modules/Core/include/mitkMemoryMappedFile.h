@@ -0,0 +1,72 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkMemoryMappedFile_h
+#define mitkMemoryMappedFile_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <string>
+
+namespace mitk
+{
+  /**
+   * @brief Maps a part of a file into memory.
+   *
+   * The mapping is private (copy-on-write): the pages are read from the file on first access only, so parts that
+   * are never touched do not cost resident memory. Writing to the mapped memory is allowed, but the changes stay
+   * in memory and are never written back to the file.
+   *
+   * Used by ImageDataItem to back image data by uncompressed raw data on disk (see Image::SetMappedChannel()).
+   * @ingroup Data
+   */
+  class MITKCORE_EXPORT MemoryMappedFile
+  {
+  public:
+    /**
+     * @brief Maps @a length bytes of the file @a fileName, starting at byte @a offset.
+     * @throws mitk::Exception if the file cannot be opened, is too small or cannot be mapped.
+     */
+    MemoryMappedFile(const std::string &fileName, std::size_t offset, std::size_t length);
+
+    ~MemoryMappedFile();
+
+    /** @brief Pointer to the first requested byte (i.e. the byte at offset in the file). */
+    void *GetData() const { return m_Data; }
+
+    /** @brief Number of mapped bytes, starting at GetData(). */
+    std::size_t GetSize() const { return m_Size; }
+
+    const std::string &GetFileName() const { return m_FileName; }
+
+  private:
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+    std::string m_FileName;
+
+    /** Start and size of the mapping, which has to start at a page aligned offset in the file */
+    void *m_Mapping;
+    std::size_t m_MappingSize;
+
+    void *m_Data;
+    std::size_t m_Size;
+
+#ifdef _WIN32
+    void *m_FileHandle;
+    void *m_MappingHandle;
+#endif
+  };
+}
+
+#endif
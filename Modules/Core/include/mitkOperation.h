@@ -18,6 +18,8 @@ found in the LICENSE file.
 
 #include <mitkCommon.h>
 
+#include <cstddef>
+
 namespace mitk
 {
   typedef int OperationType;
@@ -39,6 +41,13 @@ namespace mitk
 
     OperationType GetOperationType();
 
+    //##Documentation
+    //## @brief Returns the number of bytes occupied by the operation.
+    //##
+    //## Used by undo models to limit the memory of their stacks. Operations that hold
+    //## large data, e.g. image slices, have to take it into account.
+    virtual std::size_t GetMemorySize() const;
+
   protected:
     OperationType m_OperationType;
   };
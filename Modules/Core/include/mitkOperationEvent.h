@@ -74,6 +74,10 @@ namespace mitk
     virtual void ReverseOperations();
     virtual void ReverseAndExecute();
 
+    //##Documentation
+    //## @brief Returns the number of bytes occupied by the item
+    virtual std::size_t GetMemorySize() const;
+
     //##Documentation
     //## @brief Increases the current ObjectEventId
     //## For example if a button click generates operations the ObjectEventId has to be incremented to be able to undo
@@ -166,6 +170,9 @@ namespace mitk
     //##reverses and executes both operations (used, when moved from undo to redo stack)
     void ReverseAndExecute() override;
 
+    //## @brief Returns the number of bytes occupied by the item including both operations
+    std::size_t GetMemorySize() const override;
+
     //## @brief returns true if the destination still is present
     //## and false if it already has been deleted
     virtual bool IsValid();
@@ -0,0 +1,41 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkParallelFor_h
+#define mitkParallelFor_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <functional>
+
+namespace mitk
+{
+  /**
+    \brief Calls task(i) for all i in [begin, end) on several threads of an itk::MultiThreader.
+
+    Every thread fetches the next index as soon as it is done with the previous one, thus tasks
+    of different duration do not leave threads idle. If there are less than two tasks or threads,
+    the tasks are called on the calling thread.
+
+    If a task throws, no further tasks are started and the exception is rethrown on the calling
+    thread after all threads have finished. If several tasks throw, one of the exceptions is rethrown.
+
+    \param numberOfThreads Maximum number of threads, 0 uses the global default number of threads of ITK.
+  */
+  MITKCORE_EXPORT void ParallelFor(std::size_t begin,
+                                   std::size_t end,
+                                   const std::function<void(std::size_t)> &task,
+                                   unsigned int numberOfThreads = 0);
+}
+
+#endif
@@ -24,6 +24,7 @@ found in the LICENSE file.
 #include "mitkDataStorage.h"
 #include "mitkRestorePlanePositionOperation.h"
 #include <itkCommand.h>
+#include <memory>
 #include <sstream>
 
 namespace mitk
@@ -47,6 +48,7 @@ namespace mitk
   class PlaneGeometry;
   class BaseGeometry;
   class BaseRenderer;
+  class ImageSlicePrefetcher;
 
   /**
    * \brief Controls the selection of the slice the associated BaseRenderer
@@ -430,10 +432,25 @@ namespace mitk
      * If the time geometry is not yet set, this function will always return 0.0.*/
     TimePointType GetSelectedTimePoint() const;
 
+    /**
+     * \brief Number of slices ahead of the current slice that are resliced in the background.
+     *
+     * Slices are prefetched in the direction of the last slice change and, for
+     * images with multiple time steps, also in the direction of the last time
+     * step change. The prefetched slices are stored in the mitk::ImageSliceCache
+     * and used by mitk::ImageVtkMapper2D. Requires a renderer (see SetRenderer()).
+     * Default is 0, which disables prefetching.
+     */
+    itkSetMacro(NumberOfPrefetchedSlices, unsigned int);
+    itkGetConstMacro(NumberOfPrefetchedSlices, unsigned int);
+
   protected:
     SliceNavigationController();
     ~SliceNavigationController() override;
 
+    /** \brief Reslice the slices ahead of the current slice and time step in the background. */
+    void PrefetchSlices();
+
     mitk::BaseGeometry::ConstPointer m_InputWorldGeometry3D;
     mitk::TimeGeometry::ConstPointer m_InputWorldTimeGeometry;
 
@@ -467,6 +484,12 @@ namespace mitk
     bool m_SliceLocked;
     bool m_SliceRotationLocked;
     unsigned int m_OldPos;
+    unsigned int m_OldTimePos;
+    int m_SliceDirection;
+    int m_TimeDirection;
+
+    unsigned int m_NumberOfPrefetchedSlices;
+    std::unique_ptr<ImageSlicePrefetcher> m_SlicePrefetcher;
 
     typedef std::map<void *, std::list<unsigned long>> ObserverTagsMapType;
     ObserverTagsMapType m_ReceiverToObserverTagsMap;
@@ -11,6 +11,7 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkExtractSliceFilter2.h>
+#include <mitkBrickedVolume.h>
 #include <mitkExceptionMacro.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageWriteAccessor.h>
@@ -19,7 +20,12 @@ found in the LICENSE file.
 #include <itkLinearInterpolateImageFunction.h>
 #include <itkNearestNeighborInterpolateImageFunction.h>
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <limits>
+#include <memory>
+#include <type_traits>
 
 struct mitk::ExtractSliceFilter2::Impl
 {
@@ -29,10 +35,16 @@ struct mitk::ExtractSliceFilter2::Impl
   PlaneGeometry::Pointer OutputGeometry;
   mitk::ExtractSliceFilter2::Interpolator Interpolator;
   itk::Object::Pointer InterpolateImageFunction;
+  itk::ModifiedTimeType InterpolateImageFunctionMTime;
+  bool UseBrickedLayout;
+  std::shared_ptr<BrickedVolumeBase> BrickedVolume;
+  std::function<void(const OutputImageRegionType&)> GenerateRegion;
 };
 
 mitk::ExtractSliceFilter2::Impl::Impl()
-  : Interpolator(NearestNeighbor)
+  : Interpolator(NearestNeighbor),
+    InterpolateImageFunctionMTime(0),
+    UseBrickedLayout(false)
 {
 }
 
@@ -42,6 +54,211 @@ mitk::ExtractSliceFilter2::Impl::~Impl()
 
 namespace
 {
+  typedef std::function<void(const mitk::ExtractSliceFilter2::OutputImageRegionType&)> RegionGenerator;
+
+  /** \brief Continuous input image indices of the output slice.
+   *
+   * The mapping from output pixels to continuous input indices is affine, so
+   * the index of every output pixel is calculated incrementally from the index
+   * of the first output pixel instead of transforming each physical point.
+   */
+  struct SliceSampling
+  {
+    double Origin[3];
+    double XStep[3];
+    double YStep[3];
+    double UpperBound[3];
+    std::size_t Width;
+
+    bool IsInside(const double* index) const
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        if (!(index[i] >= -0.5 && index[i] < this->UpperBound[i]))
+          return false;
+      }
+
+      return true;
+    }
+  };
+
+  template <class TInputImage>
+  SliceSampling ComputeSliceSampling(const TInputImage* inputImage, const mitk::PlaneGeometry* outputGeometry)
+  {
+    auto origin = outputGeometry->GetOrigin();
+    auto spacing = outputGeometry->GetSpacing();
+    auto xDirection = outputGeometry->GetAxisVector(0);
+    auto yDirection = outputGeometry->GetAxisVector(1);
+
+    xDirection.Normalize();
+    yDirection.Normalize();
+
+    itk::ContinuousIndex<mitk::ScalarType, 3> originIndex;
+    itk::ContinuousIndex<mitk::ScalarType, 3> xIndex;
+    itk::ContinuousIndex<mitk::ScalarType, 3> yIndex;
+
+    inputImage->TransformPhysicalPointToContinuousIndex(origin, originIndex);
+    inputImage->TransformPhysicalPointToContinuousIndex(origin + xDirection * spacing[0], xIndex);
+    inputImage->TransformPhysicalPointToContinuousIndex(origin + yDirection * spacing[1], yIndex);
+
+    auto size = inputImage->GetBufferedRegion().GetSize();
+
+    SliceSampling sampling;
+
+    for (int i = 0; i < 3; ++i)
+    {
+      sampling.Origin[i] = originIndex[i];
+      sampling.XStep[i] = xIndex[i] - originIndex[i];
+      sampling.YStep[i] = yIndex[i] - originIndex[i];
+      sampling.UpperBound[i] = size[i] - 0.5;
+    }
+
+    sampling.Width = outputGeometry->GetExtent(0);
+
+    return sampling;
+  }
+
+  template <typename TPixel, class TSampler>
+  void SampleSlice(const SliceSampling& sampling, mitk::Image* outputImage, const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion, const TSampler& sample)
+  {
+    const std::size_t xBegin = outputRegion.GetIndex(0);
+    const std::size_t yBegin = outputRegion.GetIndex(1);
+    const std::size_t xEnd = xBegin + outputRegion.GetSize(0);
+    const std::size_t yEnd = yBegin + outputRegion.GetSize(1);
+
+    mitk::ImageWriteAccessor writeAccess(outputImage, nullptr, mitk::ImageAccessorBase::IgnoreLock);
+    auto data = static_cast<TPixel*>(writeAccess.GetData());
+
+    const TPixel backgroundPixel = std::numeric_limits<TPixel>::lowest();
+
+    double rowIndex[3];
+    double index[3];
+
+    for (std::size_t y = yBegin; y < yEnd; ++y)
+    {
+      for (int i = 0; i < 3; ++i)
+        rowIndex[i] = sampling.Origin[i] + sampling.YStep[i] * y;
+
+      TPixel* row = data + sampling.Width * y;
+
+      for (std::size_t x = xBegin; x < xEnd; ++x)
+      {
+        for (int i = 0; i < 3; ++i)
+          index[i] = rowIndex[i] + sampling.XStep[i] * x;
+
+        row[x] = sampling.IsInside(index)
+          ? sample(index)
+          : backgroundPixel;
+      }
+    }
+  }
+
+  /** \brief Direct access to the linear pixel buffer of a 3-d ITK image.
+   *
+   * Provides the same interface as mitk::BrickedVolume, so both layouts
+   * can be sampled by the same interpolation kernels.
+   */
+  template <typename TPixel>
+  class LinearVolume
+  {
+  public:
+    typedef TPixel PixelType;
+    typedef itk::Image<TPixel, 3> ImageType;
+
+    explicit LinearVolume(const ImageType* image)
+      : m_Image(image),
+        m_Data(image->GetBufferPointer())
+    {
+      auto size = image->GetBufferedRegion().GetSize();
+
+      for (int i = 0; i < 3; ++i)
+        m_Dimensions[i] = static_cast<unsigned int>(size[i]);
+
+      m_SliceSize = static_cast<std::size_t>(m_Dimensions[0]) * m_Dimensions[1];
+    }
+
+    unsigned int GetDimension(unsigned int i) const
+    {
+      return m_Dimensions[i];
+    }
+
+    TPixel GetPixel(unsigned int x, unsigned int y, unsigned int z) const
+    {
+      return m_Data[m_SliceSize * z + static_cast<std::size_t>(m_Dimensions[0]) * y + x];
+    }
+
+  private:
+    typename ImageType::ConstPointer m_Image;
+    const TPixel* m_Data;
+    unsigned int m_Dimensions[3];
+    std::size_t m_SliceSize;
+  };
+
+  /** \brief Nearest neighbor interpolation that rounds half integers up like
+   * itk::NearestNeighborInterpolateImageFunction.
+   */
+  template <class TVolume>
+  typename TVolume::PixelType EvaluateNearestNeighbor(const TVolume& volume, const double* index)
+  {
+    unsigned int nearestIndex[3];
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      const double rounded = std::floor(index[i] + 0.5);
+      nearestIndex[i] = rounded <= 0.0 ? 0u : std::min(static_cast<unsigned int>(rounded), volume.GetDimension(i) - 1);
+    }
+
+    return volume.GetPixel(nearestIndex[0], nearestIndex[1], nearestIndex[2]);
+  }
+
+  /** \brief Trilinear interpolation that replaces voxels outside of the volume
+   * by the nearest border voxel like itk::LinearInterpolateImageFunction.
+   */
+  template <class TVolume>
+  double EvaluateLinear(const TVolume& volume, const double* index)
+  {
+    unsigned int lower[3];
+    unsigned int upper[3];
+    double distance[3];
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      const double floored = std::floor(index[i]);
+
+      if (floored < 0.0)
+      {
+        lower[i] = 0;
+        distance[i] = 0.0;
+      }
+      else
+      {
+        lower[i] = std::min(static_cast<unsigned int>(floored), volume.GetDimension(i) - 1);
+        distance[i] = index[i] - floored;
+      }
+
+      upper[i] = std::min(lower[i] + 1, volume.GetDimension(i) - 1);
+    }
+
+    const double v000 = volume.GetPixel(lower[0], lower[1], lower[2]);
+    const double v100 = volume.GetPixel(upper[0], lower[1], lower[2]);
+    const double v010 = volume.GetPixel(lower[0], upper[1], lower[2]);
+    const double v110 = volume.GetPixel(upper[0], upper[1], lower[2]);
+    const double v001 = volume.GetPixel(lower[0], lower[1], upper[2]);
+    const double v101 = volume.GetPixel(upper[0], lower[1], upper[2]);
+    const double v011 = volume.GetPixel(lower[0], upper[1], upper[2]);
+    const double v111 = volume.GetPixel(upper[0], upper[1], upper[2]);
+
+    const double v00 = v000 + (v100 - v000) * distance[0];
+    const double v10 = v010 + (v110 - v010) * distance[0];
+    const double v01 = v001 + (v101 - v001) * distance[0];
+    const double v11 = v011 + (v111 - v011) * distance[0];
+
+    const double v0 = v00 + (v10 - v00) * distance[1];
+    const double v1 = v01 + (v11 - v01) * distance[1];
+
+    return v0 + (v1 - v0) * distance[2];
+  }
+
   template <class TInputImage>
   void CreateInterpolateImageFunction(const TInputImage* inputImage, mitk::ExtractSliceFilter2::Interpolator interpolator, itk::Object::Pointer& result)
   {
@@ -75,61 +292,110 @@ namespace
   }
 
   template <typename TPixel, unsigned int VImageDimension>
-  void GenerateData(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion, itk::Object* interpolateImageFunction)
+  void CreateBrickedVolume(const itk::Image<TPixel, VImageDimension>* inputImage, std::shared_ptr<mitk::BrickedVolumeBase>& result, std::true_type)
   {
-    typedef itk::Image<TPixel, VImageDimension> TInputImage;
-    typedef itk::InterpolateImageFunction<TInputImage> TInterpolateImageFunction;
+    auto size = inputImage->GetBufferedRegion().GetSize();
+    unsigned int dimensions[3];
 
-    auto outputGeometry = outputImage->GetSlicedGeometry()->GetPlaneGeometry(0);
-    auto interpolator = static_cast<TInterpolateImageFunction*>(interpolateImageFunction);
+    for (unsigned int i = 0; i < 3; ++i)
+      dimensions[i] = static_cast<unsigned int>(size[i]);
 
-    auto origin = outputGeometry->GetOrigin();
-    auto spacing = outputGeometry->GetSpacing();
-    auto xDirection = outputGeometry->GetAxisVector(0);
-    auto yDirection = outputGeometry->GetAxisVector(1);
+    result.reset(new mitk::BrickedVolume<TPixel>(inputImage->GetBufferPointer(), dimensions));
+  }
 
-    xDirection.Normalize();
-    yDirection.Normalize();
+  template <typename TPixel, unsigned int VImageDimension>
+  void CreateBrickedVolume(const itk::Image<TPixel, VImageDimension>*, std::shared_ptr<mitk::BrickedVolumeBase>& result, std::false_type)
+  {
+    // Composite pixel types are not supported and always sampled by ITK interpolate image functions
+    result.reset();
+  }
 
-    auto spacingAlongXDirection = xDirection * spacing[0];
-    auto spacingAlongYDirection = yDirection * spacing[1];
+  template <typename TPixel, unsigned int VImageDimension>
+  void CreateBrickedVolume(const itk::Image<TPixel, VImageDimension>* inputImage, std::shared_ptr<mitk::BrickedVolumeBase>& result)
+  {
+    CreateBrickedVolume(inputImage, result, typename std::is_arithmetic<TPixel>::type());
+  }
 
-    const std::size_t pixelSize = outputImage->GetPixelType().GetSize();
-    const std::size_t width = outputGeometry->GetExtent(0);
-    const std::size_t xBegin = outputRegion.GetIndex(0);
-    const std::size_t yBegin = outputRegion.GetIndex(1);
-    const std::size_t xEnd = xBegin + outputRegion.GetSize(0);
-    const std::size_t yEnd = yBegin + outputRegion.GetSize(1);
+  template <typename TPixel, class TVolume>
+  void CreateVolumeRegionGenerator(const SliceSampling& sampling, mitk::Image* outputImage, mitk::ExtractSliceFilter2::Interpolator interpolator, std::shared_ptr<const TVolume> volume, RegionGenerator& result)
+  {
+    if (mitk::ExtractSliceFilter2::Linear == interpolator)
+    {
+      result = [sampling, outputImage, volume](const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion) {
+        const TVolume* v = volume.get();
+        SampleSlice<TPixel>(sampling, outputImage, outputRegion, [v](const double* index) {
+          return static_cast<TPixel>(EvaluateLinear(*v, index));
+        });
+      };
+    }
+    else
+    {
+      result = [sampling, outputImage, volume](const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion) {
+        const TVolume* v = volume.get();
+        SampleSlice<TPixel>(sampling, outputImage, outputRegion, [v](const double* index) {
+          return EvaluateNearestNeighbor(*v, index);
+        });
+      };
+    }
+  }
 
-    mitk::ImageWriteAccessor writeAccess(outputImage, nullptr, mitk::ImageAccessorBase::IgnoreLock);
-    auto data = static_cast<char*>(writeAccess.GetData());
+  template <typename TPixel, unsigned int VImageDimension>
+  void CreateScalarRegionGenerator(const itk::Image<TPixel, VImageDimension>* inputImage, const SliceSampling& sampling, mitk::Image* outputImage, mitk::ExtractSliceFilter2::Interpolator interpolator, const std::shared_ptr<mitk::BrickedVolumeBase>& brickedVolume, RegionGenerator& result, std::true_type)
+  {
+    if (nullptr != brickedVolume)
+    {
+      std::shared_ptr<const mitk::BrickedVolume<TPixel>> volume = std::static_pointer_cast<const mitk::BrickedVolume<TPixel>>(brickedVolume);
+      CreateVolumeRegionGenerator<TPixel>(sampling, outputImage, interpolator, volume, result);
+    }
+    else
+    {
+      std::shared_ptr<const LinearVolume<TPixel>> volume = std::make_shared<LinearVolume<TPixel>>(inputImage);
+      CreateVolumeRegionGenerator<TPixel>(sampling, outputImage, interpolator, volume, result);
+    }
+  }
 
-    const TPixel backgroundPixel = std::numeric_limits<TPixel>::lowest();
-    TPixel pixel;
+  template <typename TPixel, unsigned int VImageDimension>
+  void CreateScalarRegionGenerator(const itk::Image<TPixel, VImageDimension>*, const SliceSampling&, mitk::Image*, mitk::ExtractSliceFilter2::Interpolator, const std::shared_ptr<mitk::BrickedVolumeBase>&, RegionGenerator&, std::false_type)
+  {
+    mitkThrow() << "Composite pixel types require an interpolate image function.";
+  }
 
-    itk::ContinuousIndex<mitk::ScalarType, 3> index;
-    mitk::Point3D yPoint;
-    mitk::Point3D point;
+  /** \brief Creates the function that is called by every thread to generate its part of the output slice.
+   *
+   * If an interpolate image function is passed, it is used to sample the input
+   * image. Otherwise the input image must have a scalar pixel type and is sampled
+   * by the nearest neighbor or linear kernels above, either in its linear layout
+   * or in the layout of the passed bricked volume.
+   */
+  template <typename TPixel, unsigned int VImageDimension>
+  void CreateRegionGenerator(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, mitk::ExtractSliceFilter2::Interpolator interpolator, itk::Object* interpolateImageFunction, const std::shared_ptr<mitk::BrickedVolumeBase>& brickedVolume, RegionGenerator& result)
+  {
+    typedef itk::Image<TPixel, VImageDimension> TInputImage;
+    typedef itk::InterpolateImageFunction<TInputImage> TInterpolateImageFunction;
 
-    for (std::size_t y = yBegin; y < yEnd; ++y)
-    {
-      yPoint = origin + spacingAlongYDirection * y;
+    const auto sampling = ComputeSliceSampling(inputImage, outputImage->GetSlicedGeometry()->GetPlaneGeometry(0));
 
-      for (std::size_t x = xBegin; x < xEnd; ++x)
-      {
-        point = yPoint + spacingAlongXDirection * x;
-
-        if (inputImage->TransformPhysicalPointToContinuousIndex(point, index))
-        {
-          pixel = interpolator->EvaluateAtContinuousIndex(index);
-          memcpy(static_cast<void*>(data + pixelSize * (width * y + x)), static_cast<const void*>(&pixel), pixelSize);
-        }
-        else
-        {
-          memcpy(static_cast<void*>(data + pixelSize * (width * y + x)), static_cast<const void*>(&backgroundPixel), pixelSize);
-        }
-      }
+    if (nullptr == interpolateImageFunction)
+    {
+      CreateScalarRegionGenerator(inputImage, sampling, outputImage, interpolator, brickedVolume, result, typename std::is_arithmetic<TPixel>::type());
+      return;
     }
+
+    typename TInterpolateImageFunction::ConstPointer interpolateFunction = static_cast<TInterpolateImageFunction*>(interpolateImageFunction);
+
+    result = [sampling, outputImage, interpolateFunction](const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion) {
+      const TInterpolateImageFunction* function = interpolateFunction.GetPointer();
+      SampleSlice<TPixel>(sampling, outputImage, outputRegion, [function](const double* index) {
+        itk::ContinuousIndex<mitk::ScalarType, 3> continuousIndex;
+
+        for (int i = 0; i < 3; ++i)
+          continuousIndex[i] = index[i];
+
+        TPixel pixel;
+        pixel = function->EvaluateAtContinuousIndex(continuousIndex);
+        return pixel;
+      });
+    };
   }
 
   void VerifyInputImage(const mitk::Image* inputImage)
@@ -194,36 +460,59 @@ void mitk::ExtractSliceFilter2::AllocateOutputs()
   {
     delete[] data;
   }
-}
 
-/*void mitk::ExtractSliceFilter2::BeforeThreadedGenerateData()
-{
-  if (nullptr != m_Impl->InterpolateImageFunction && this->GetInput()->GetMTime() < this->GetMTime())
-    return;
-
-  const auto* inputImage = this->GetInput();
-  AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
+  // The requested region is split among the threads, so it has to match the newly initialized output image
+  outputImage->SetRequestedRegionToLargestPossibleRegion();
 }
 
-void mitk::ExtractSliceFilter2::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType)
+void mitk::ExtractSliceFilter2::BeforeThreadedGenerateData()
 {
   const auto* inputImage = this->GetInput();
-  AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), outputRegionForThread, m_Impl->InterpolateImageFunction);
-}*/
+  const auto interpolator = this->GetInterpolator();
 
-void mitk::ExtractSliceFilter2::GenerateData()
-{
-  if (nullptr != m_Impl->InterpolateImageFunction && this->GetInput()->GetMTime() < this->GetMTime())
-    return;
+  // Nearest neighbor and linear interpolation of scalar images is done by the
+  // kernels of this filter. Everything else is delegated to ITK.
+  const bool useInterpolateImageFunction = Cubic == interpolator ||
+    itk::ImageIOBase::SCALAR != inputImage->GetPixelType().GetPixelType();
 
-  const auto* inputImage = this->GetInput();
+  itk::Object* interpolateImageFunction = nullptr;
+  std::shared_ptr<BrickedVolumeBase> brickedVolume;
 
-  AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
+  if (useInterpolateImageFunction)
+  {
+    if (nullptr == m_Impl->InterpolateImageFunction || m_Impl->InterpolateImageFunctionMTime != inputImage->GetMTime())
+    {
+      AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, interpolator, m_Impl->InterpolateImageFunction);
+      m_Impl->InterpolateImageFunctionMTime = inputImage->GetMTime();
+    }
 
-  this->AllocateOutputs();
-  auto outputRegion = this->GetOutput()->GetLargestPossibleRegion();
+    interpolateImageFunction = m_Impl->InterpolateImageFunction;
+  }
+  else if (m_Impl->UseBrickedLayout)
+  {
+    if (nullptr == m_Impl->BrickedVolume || m_Impl->BrickedVolume->GetSourceMTime() != inputImage->GetMTime())
+    {
+      AccessFixedDimensionByItk_1(inputImage, CreateBrickedVolume, 3, m_Impl->BrickedVolume);
 
-  AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), outputRegion, m_Impl->InterpolateImageFunction);
+      if (nullptr != m_Impl->BrickedVolume)
+        m_Impl->BrickedVolume->SetSourceMTime(inputImage->GetMTime());
+    }
+
+    brickedVolume = m_Impl->BrickedVolume;
+  }
+
+  AccessFixedDimensionByItk_n(inputImage, CreateRegionGenerator, 3, (this->GetOutput(), interpolator, interpolateImageFunction, brickedVolume, m_Impl->GenerateRegion));
+}
+
+void mitk::ExtractSliceFilter2::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType)
+{
+  m_Impl->GenerateRegion(outputRegionForThread);
+}
+
+void mitk::ExtractSliceFilter2::AfterThreadedGenerateData()
+{
+  // Release the references to the input image held by the region generator
+  m_Impl->GenerateRegion = nullptr;
 }
 
 void mitk::ExtractSliceFilter2::SetInput(const InputImageType* image)
@@ -233,6 +522,7 @@ void mitk::ExtractSliceFilter2::SetInput(const InputImageType* image)
 
   Superclass::SetInput(image);
   m_Impl->InterpolateImageFunction = nullptr;
+  m_Impl->BrickedVolume.reset();
 }
 
 void mitk::ExtractSliceFilter2::SetInput(unsigned int index, const InputImageType* image)
@@ -272,6 +562,24 @@ void mitk::ExtractSliceFilter2::SetInterpolator(Interpolator interpolator)
   }
 }
 
+bool mitk::ExtractSliceFilter2::GetUseBrickedLayout() const
+{
+  return m_Impl->UseBrickedLayout;
+}
+
+void mitk::ExtractSliceFilter2::SetUseBrickedLayout(bool useBrickedLayout)
+{
+  if (m_Impl->UseBrickedLayout != useBrickedLayout)
+  {
+    m_Impl->UseBrickedLayout = useBrickedLayout;
+
+    if (!useBrickedLayout)
+      m_Impl->BrickedVolume.reset();
+
+    this->Modified();
+  }
+}
+
 void mitk::ExtractSliceFilter2::VerifyInputInformation()
 {
   Superclass::VerifyInputInformation();
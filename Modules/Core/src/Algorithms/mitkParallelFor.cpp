@@ -0,0 +1,92 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkParallelFor.h"
+
+#include <itkMultiThreader.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <vector>
+
+namespace
+{
+  struct ParallelForData
+  {
+    const std::function<void(std::size_t)> *Task;
+    std::size_t End;
+    std::atomic<std::size_t> Next;
+    std::vector<std::exception_ptr> Exceptions;
+  };
+
+  ITK_THREAD_RETURN_TYPE ParallelForThreaderCallback(void *arg)
+  {
+    auto *threadInfo = static_cast<itk::MultiThreader::ThreadInfoStruct *>(arg);
+    auto *data = static_cast<ParallelForData *>(threadInfo->UserData);
+
+    try
+    {
+      for (auto i = data->Next++; i < data->End; i = data->Next++)
+      {
+        (*data->Task)(i);
+      }
+    }
+    catch (...)
+    {
+      data->Exceptions[threadInfo->ThreadID] = std::current_exception();
+      data->Next = data->End; // stop the other threads
+    }
+
+    return ITK_THREAD_RETURN_VALUE;
+  }
+}
+
+void mitk::ParallelFor(std::size_t begin,
+                       std::size_t end,
+                       const std::function<void(std::size_t)> &task,
+                       unsigned int numberOfThreads)
+{
+  if (begin >= end)
+    return;
+
+  if (0 == numberOfThreads)
+    numberOfThreads = itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+
+  numberOfThreads = static_cast<unsigned int>(std::min<std::size_t>(numberOfThreads, end - begin));
+
+  if (numberOfThreads < 2)
+  {
+    for (auto i = begin; i < end; ++i)
+      task(i);
+
+    return;
+  }
+
+  ParallelForData data;
+  data.Task = &task;
+  data.End = end;
+  data.Next = begin;
+
+  auto threader = itk::MultiThreader::New();
+  threader->SetNumberOfThreads(numberOfThreads); // limited to ITK's maximum number of threads
+  data.Exceptions.resize(threader->GetNumberOfThreads());
+
+  threader->SetSingleMethod(&ParallelForThreaderCallback, &data);
+  threader->SingleMethodExecute();
+
+  for (const auto &exception : data.Exceptions)
+  {
+    if (exception)
+      std::rethrow_exception(exception);
+  }
+}
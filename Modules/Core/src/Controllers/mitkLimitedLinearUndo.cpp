@@ -14,7 +14,7 @@ found in the LICENSE file.
 #include <mitkRenderingManager.h>
 
 mitk::LimitedLinearUndo::LimitedLinearUndo()
-: m_UndoLimit(0)
+: m_UndoLimit(0), m_MemoryLimit(0), m_MemorySize(0)
 {
   // nothing to do
 }
@@ -32,6 +32,26 @@ void mitk::LimitedLinearUndo::ClearList(UndoContainer *list)
   {
     UndoStackItem *item = list->back();
     list->pop_back();
+    m_MemorySize -= item->GetMemorySize();
+    delete item;
+  }
+}
+
+void mitk::LimitedLinearUndo::PushUndoItem(UndoStackItem *item)
+{
+  m_UndoList.push_back(item);
+  m_MemorySize += item->GetMemorySize();
+  this->ApplyLimits();
+}
+
+void mitk::LimitedLinearUndo::ApplyLimits()
+{
+  while ((0 != m_UndoLimit && m_UndoList.size() > m_UndoLimit) ||
+         (0 != m_MemoryLimit && m_MemorySize > m_MemoryLimit && m_UndoList.size() > 1))
+  {
+    UndoStackItem *item = m_UndoList.front();
+    m_UndoList.pop_front();
+    m_MemorySize -= item->GetMemorySize();
     delete item;
   }
 }
@@ -49,13 +69,7 @@ bool mitk::LimitedLinearUndo::SetOperationEvent(UndoStackItem *stackItem)
     InvokeEvent(RedoEmptyEvent());
   }
 
-  if (0 != m_UndoLimit && m_UndoList.size() == m_UndoLimit)
-  {
-    auto item = m_UndoList.front();
-    m_UndoList.pop_front();
-    delete item;
-  }
-  m_UndoList.push_back(operationEvent);
+  this->PushUndoItem(operationEvent);
 
   InvokeEvent(UndoNotEmptyEvent());
 
@@ -182,14 +196,30 @@ void mitk::LimitedLinearUndo::SetUndoLimit(std::size_t undoLimit)
 {
   if (undoLimit != m_UndoLimit)
   {
-    if (m_UndoList.size() > undoLimit)
-    {
-      m_UndoList.erase(m_UndoList.begin(), m_UndoList.end() - undoLimit);
-    }
     m_UndoLimit = undoLimit;
+    this->ApplyLimits();
   }
 }
 
+std::size_t mitk::LimitedLinearUndo::GetMemoryLimit() const
+{
+  return m_MemoryLimit;
+}
+
+void mitk::LimitedLinearUndo::SetMemoryLimit(std::size_t memoryLimit)
+{
+  if (memoryLimit != m_MemoryLimit)
+  {
+    m_MemoryLimit = memoryLimit;
+    this->ApplyLimits();
+  }
+}
+
+std::size_t mitk::LimitedLinearUndo::GetMemorySize() const
+{
+  return m_MemorySize;
+}
+
 int mitk::LimitedLinearUndo::GetLastObjectEventIdInList()
 {
   return m_UndoList.back()->GetObjectEventId();
@@ -72,6 +72,11 @@ void mitk::UndoStackItem::ReverseAndExecute()
   ReverseOperations();
 }
 
+std::size_t mitk::UndoStackItem::GetMemorySize() const
+{
+  return sizeof(UndoStackItem) + m_Description.capacity();
+}
+
 // ******************** mitk::OperationEvent ********************
 
 mitk::Operation *mitk::OperationEvent::GetOperation()
@@ -134,6 +139,19 @@ void mitk::OperationEvent::ReverseAndExecute()
     m_Destination->ExecuteOperation(m_Operation);
 }
 
+std::size_t mitk::OperationEvent::GetMemorySize() const
+{
+  std::size_t memorySize = UndoStackItem::GetMemorySize() + sizeof(OperationEvent) - sizeof(UndoStackItem);
+
+  if (m_Operation != nullptr)
+    memorySize += m_Operation->GetMemorySize();
+
+  if (m_UndoOperation != nullptr)
+    memorySize += m_UndoOperation->GetMemorySize();
+
+  return memorySize;
+}
+
 mitk::OperationActor *mitk::OperationEvent::GetDestination()
 {
   return m_Destination;
@@ -26,6 +26,7 @@ found in the LICENSE file.
 
 #include "mitkImage.h"
 #include "mitkImagePixelReadAccessor.h"
+#include "mitkImageSlicePrefetcher.h"
 #include "mitkInteractionConst.h"
 #include "mitkNodePredicateDataType.h"
 #include "mitkOperationEvent.h"
@@ -58,7 +59,11 @@ namespace mitk
       m_BlockUpdate(false),
       m_SliceLocked(false),
       m_SliceRotationLocked(false),
-      m_OldPos(0)
+      m_OldPos(0),
+      m_OldTimePos(0),
+      m_SliceDirection(1),
+      m_TimeDirection(1),
+      m_NumberOfPrefetchedSlices(0)
   {
     typedef itk::SimpleMemberCommand<SliceNavigationController> SNCCommandType;
     SNCCommandType::Pointer sliceStepperChangedCommand, timeStepperChangedCommand;
@@ -368,8 +373,18 @@ namespace mitk
     {
       if (m_CreatedWorldGeometry.IsNotNull())
       {
-        this->InvokeEvent(GeometrySliceEvent(m_CreatedWorldGeometry, m_Slice->GetPos()));
+        const unsigned int pos = m_Slice->GetPos();
+
+        if (pos != m_OldPos)
+        {
+          m_SliceDirection = pos > m_OldPos ? 1 : -1;
+          m_OldPos = pos;
+        }
+
+        this->InvokeEvent(GeometrySliceEvent(m_CreatedWorldGeometry, pos));
         RenderingManager::GetInstance()->RequestUpdateAll();
+
+        this->PrefetchSlices();
       }
     }
   }
@@ -380,10 +395,70 @@ namespace mitk
     {
       if (m_CreatedWorldGeometry.IsNotNull())
       {
-        this->InvokeEvent(GeometryTimeEvent(m_CreatedWorldGeometry, m_Time->GetPos()));
+        const unsigned int pos = m_Time->GetPos();
+
+        if (pos != m_OldTimePos)
+        {
+          m_TimeDirection = pos > m_OldTimePos ? 1 : -1;
+          m_OldTimePos = pos;
+        }
+
+        this->InvokeEvent(GeometryTimeEvent(m_CreatedWorldGeometry, pos));
         RenderingManager::GetInstance()->RequestUpdateAll();
+
+        this->PrefetchSlices();
+      }
+    }
+  }
+
+  void SliceNavigationController::PrefetchSlices()
+  {
+    if (0 == m_NumberOfPrefetchedSlices || nullptr == m_Renderer)
+      return;
+
+    // The renderer has already been moved to the current slice and time step by the events
+    const auto *worldTimeGeometry = m_Renderer->GetWorldTimeGeometry();
+
+    if (nullptr == worldTimeGeometry)
+      return;
+
+    const int slice = m_Renderer->GetSlice();
+    const int timeStep = m_Renderer->GetTimeStep();
+    const int numberOfTimeSteps = worldTimeGeometry->CountTimeSteps();
+
+    const auto *slicedGeometry =
+      dynamic_cast<const SlicedGeometry3D *>(worldTimeGeometry->GetGeometryForTimeStep(timeStep).GetPointer());
+
+    if (nullptr == slicedGeometry)
+      return;
+
+    std::vector<ImageSlicePrefetcher::Request> requests;
+
+    // Nearest slices and time steps first, as they are needed first
+    for (int i = 1; i <= static_cast<int>(m_NumberOfPrefetchedSlices); ++i)
+    {
+      const int nextSlice = slice + i * m_SliceDirection;
+
+      if (0 <= nextSlice && nextSlice < static_cast<int>(slicedGeometry->GetSlices()))
+        ImageSlicePrefetcher::AddRequests(m_Renderer, slicedGeometry->GetPlaneGeometry(nextSlice), timeStep, requests);
+
+      const int nextTimeStep = timeStep + i * m_TimeDirection;
+
+      if (0 <= nextTimeStep && nextTimeStep < numberOfTimeSteps)
+      {
+        const auto *nextSlicedGeometry = dynamic_cast<const SlicedGeometry3D *>(
+          worldTimeGeometry->GetGeometryForTimeStep(nextTimeStep).GetPointer());
+
+        if (nullptr != nextSlicedGeometry && slice < static_cast<int>(nextSlicedGeometry->GetSlices()))
+          ImageSlicePrefetcher::AddRequests(
+            m_Renderer, nextSlicedGeometry->GetPlaneGeometry(slice), nextTimeStep, requests);
       }
     }
+
+    if (nullptr == m_SlicePrefetcher)
+      m_SlicePrefetcher.reset(new ImageSlicePrefetcher);
+
+    m_SlicePrefetcher->Prefetch(requests);
   }
 
   void SliceNavigationController::SetGeometry(const itk::EventObject &) {}
@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkImageStatisticsHolder.h"
 #include "mitkImageVtkReadAccessor.h"
 #include "mitkImageVtkWriteAccessor.h"
+#include "mitkMemoryMappedFile.h"
 #include "mitkPixelTypeMultiplex.h"
 #include <mitkProportionalTimeGeometry.h>
 
@@ -41,7 +42,8 @@ mitk::Image::Image()
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_PendingWriterCount(0)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -56,7 +58,8 @@ mitk::Image::Image(const Image &other)
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_PendingWriterCount(0)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -800,6 +803,46 @@ bool mitk::Image::SetImportChannel(void *data, int n, ImportMemoryManagementType
   return true;
 }
 
+bool mitk::Image::SetMappedChannel(const std::string &fileName, std::size_t offset, int n)
+{
+  if (IsValidChannel(n) == false)
+    return false;
+
+  const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
+  auto mappedFile = std::make_shared<MemoryMappedFile>(fileName, offset, m_OffsetTable[4] * ptypeSize);
+
+  const bool wasSet = IsChannelSet(n);
+
+  {
+    MutexHolder lock(m_ImageDataArraysLock);
+
+    ImageDataItemPointer ch = new ImageDataItem(this->m_ImageDescriptor, -1, mappedFile);
+    ch->SetComplete(true);
+    m_Channels[n] = ch;
+
+    // volumes and slices are created on demand as references into the mapped channel
+    auto volumesIt = m_Volumes.begin() + n * m_Dimensions[3];
+    for (unsigned int t = 0; t < m_Dimensions[3]; ++t, ++volumesIt)
+    {
+      *volumesIt = nullptr;
+    }
+    auto slicesIt = m_Slices.begin() + n * m_Dimensions[2] * m_Dimensions[3];
+    for (unsigned int i = 0; i < m_Dimensions[2] * m_Dimensions[3]; ++i, ++slicesIt)
+    {
+      *slicesIt = nullptr;
+    }
+
+    this->m_ImageDescriptor->GetChannelDescriptor(n).SetData(ch->GetData());
+  }
+
+  if (wasSet)
+  {
+    // we have changed the data: call Modified()!
+    Modified();
+  }
+  return true;
+}
+
 void mitk::Image::Initialize()
 {
   ImageDataItemPointerArray::iterator it, end;
@@ -13,6 +13,20 @@ found in the LICENSE file.
 #include "mitkImageAccessorBase.h"
 #include "mitkImage.h"
 
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+  /** Lock-free read accessors of the current thread. Only needed to detect recursive write requests, which would
+      otherwise wait for themselves. */
+  std::vector<const mitk::ImageAccessorBase *> &GetLockFreeReadAccessorsOfThread()
+  {
+    thread_local std::vector<const mitk::ImageAccessorBase *> accessors;
+    return accessors;
+  }
+}
+
 mitk::ImageAccessorBase::ThreadIDType mitk::ImageAccessorBase::CurrentThreadHandle()
 {
 #ifdef ITK_USE_SPROC
@@ -49,9 +63,8 @@ mitk::ImageAccessorBase::ImageAccessorBase(ImageConstPointer image,
 {
   m_Thread = CurrentThreadHandle();
 
-  // Initialize WaitLock
-  m_WaitLock = new ImageAccessorWaitLock();
-  m_WaitLock->m_WaiterCount = 0;
+  // WaitLock is only created once the accessor gets registered in the image (see CreateWaitLock())
+  m_WaitLock = nullptr;
 
   // Check validity of ImageAccessor
 
@@ -88,10 +101,8 @@ mitk::ImageAccessorBase::ImageAccessorBase(ImageConstPointer image,
   {
     m_CoherentMemory = true;
 
-    // Organize first image channel
-    image->m_ReadWriteLock.Lock();
+    // Organize first image channel (GetChannelData() is guarded by the image data arrays lock itself)
     imageDataItem = image->GetChannelData();
-    image->m_ReadWriteLock.Unlock();
 
     // Set memory area
     m_AddressBegin = imageDataItem->m_Data;
@@ -148,6 +159,24 @@ bool mitk::ImageAccessorBase::Overlap(const ImageAccessorBase *iAB)
   return false;
 }
 
+bool mitk::ImageAccessorBase::Overlap(const void *addressBegin, const void *addressEnd) const
+{
+  auto begin = static_cast<const unsigned char *>(addressBegin);
+  auto end = static_cast<const unsigned char *>(addressEnd);
+
+  return begin < static_cast<const unsigned char *>(m_AddressEnd) &&
+         static_cast<const unsigned char *>(m_AddressBegin) < end;
+}
+
+void mitk::ImageAccessorBase::CreateWaitLock()
+{
+  if (m_WaitLock == nullptr)
+  {
+    m_WaitLock = new ImageAccessorWaitLock();
+    m_WaitLock->m_WaiterCount = 0;
+  }
+}
+
 /** \brief Uses the WaitLock to wait for another ImageAccessor*/
 void mitk::ImageAccessorBase::WaitForReleaseOf(ImageAccessorWaitLock *wL)
 {
@@ -182,3 +211,26 @@ void mitk::ImageAccessorBase::PreventRecursiveMutexLock(mitk::ImageAccessorBase
   }
 #endif
 }
+
+void mitk::ImageAccessorBase::RegisterLockFreeReadAccess(const ImageAccessorBase *accessor)
+{
+  GetLockFreeReadAccessorsOfThread().push_back(accessor);
+}
+
+void mitk::ImageAccessorBase::UnregisterLockFreeReadAccess(const ImageAccessorBase *accessor)
+{
+  auto &accessors = GetLockFreeReadAccessorsOfThread();
+  auto it = std::find(accessors.begin(), accessors.end(), accessor);
+  if (it != accessors.end())
+  {
+    accessors.erase(it);
+  }
+}
+
+bool mitk::ImageAccessorBase::HoldsOverlappingLockFreeReadAccess(const Image *image) const
+{
+  const auto &accessors = GetLockFreeReadAccessorsOfThread();
+  return std::any_of(accessors.begin(), accessors.end(), [this, image](const ImageAccessorBase *accessor) {
+    return accessor->GetImage() == image && this->Overlap(accessor->m_AddressBegin, accessor->m_AddressEnd);
+  });
+}
@@ -11,6 +11,7 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkImageDataItem.h"
+#include "mitkMemoryMappedFile.h"
 #include "mitkMemoryUtilities.h"
 #include <vtkImageData.h>
 #include <vtkPointData.h>
@@ -164,6 +165,41 @@ mitk::ImageDataItem::ImageDataItem(const mitk::PixelType &type,
   m_ReferenceCount = 0;
 }
 
+mitk::ImageDataItem::ImageDataItem(const mitk::ImageDescriptor::Pointer desc,
+                                   int timestep,
+                                   std::shared_ptr<MemoryMappedFile> mappedFile)
+  : m_Data(static_cast<unsigned char *>(mappedFile->GetData())),
+    m_PixelType(new mitk::PixelType(desc->GetChannelDescriptor(0).GetPixelType())),
+    m_ManageMemory(false),
+    m_VtkImageData(nullptr),
+    m_VtkImageReadAccessor(nullptr),
+    m_VtkImageWriteAccessor(nullptr),
+    m_Offset(0),
+    m_IsComplete(false),
+    m_Size(0),
+    m_MappedFile(mappedFile),
+    m_Dimension(desc->GetNumberOfDimensions()),
+    m_Timestep(timestep)
+{
+  // compute size
+  const unsigned int *dimensions = desc->GetDimensions();
+  for (unsigned int i = 0; i < m_Dimension; i++)
+  {
+    m_Dimensions[i] = dimensions[i];
+  }
+
+  this->ComputeItemSize(m_Dimensions, m_Dimension);
+
+  if (m_Size > mappedFile->GetSize())
+  {
+    delete m_PixelType;
+    mitkThrow() << "Memory mapped file " << mappedFile->GetFileName() << " provides " << mappedFile->GetSize()
+                << " bytes, but the image data item needs " << m_Size << " bytes";
+  }
+
+  m_ReferenceCount = 0;
+}
+
 mitk::ImageDataItem::ImageDataItem(const ImageDataItem &other)
   : itk::LightObject(),
     m_Data(other.m_Data),
@@ -176,6 +212,7 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &other)
     m_IsComplete(other.m_IsComplete),
     m_Size(other.m_Size),
     m_Parent(other.m_Parent),
+    m_MappedFile(other.m_MappedFile),
     m_Dimension(other.m_Dimension),
     m_Timestep(other.m_Timestep)
 {
@@ -15,7 +15,7 @@ found in the LICENSE file.
 #include "mitkImage.h"
 
 mitk::ImageReadAccessor::ImageReadAccessor(ImageConstPointer image, const mitk::ImageDataItem *iDI, int OptionFlags)
-  : ImageAccessorBase(image, iDI, OptionFlags), m_Image(image)
+  : ImageAccessorBase(image, iDI, OptionFlags), m_Image(image), m_LockFreeSlot(nullptr)
 {
   if (!(OptionFlags & ImageAccessorBase::IgnoreLock))
   {
@@ -32,7 +32,7 @@ mitk::ImageReadAccessor::ImageReadAccessor(ImageConstPointer image, const mitk::
 }
 
 mitk::ImageReadAccessor::ImageReadAccessor(ImagePointer image, const mitk::ImageDataItem *iDI, int OptionFlags)
-  : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags), m_Image(image.GetPointer())
+  : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags), m_Image(image.GetPointer()), m_LockFreeSlot(nullptr)
 {
   if (!(OptionFlags & ImageAccessorBase::IgnoreLock))
   {
@@ -49,14 +49,19 @@ mitk::ImageReadAccessor::ImageReadAccessor(ImagePointer image, const mitk::Image
 }
 
 mitk::ImageReadAccessor::ImageReadAccessor(const mitk::Image *image, const ImageDataItem *iDI)
-  : ImageAccessorBase(image, iDI, ImageAccessorBase::DefaultBehavior), m_Image(image)
+  : ImageAccessorBase(image, iDI, ImageAccessorBase::DefaultBehavior), m_Image(image), m_LockFreeSlot(nullptr)
 {
   OrganizeReadAccess();
 }
 
 mitk::ImageReadAccessor::~ImageReadAccessor()
 {
-  if (!(m_Options & ImageAccessorBase::IgnoreLock))
+  if (m_LockFreeSlot != nullptr)
+  {
+    UnregisterLockFreeReadAccess(this);
+    ReleaseLockFreeSlot(m_LockFreeSlot);
+  }
+  else if (!(m_Options & ImageAccessorBase::IgnoreLock))
   {
     // Future work: In case of non-coherent memory, copied area needs to be deleted
 
@@ -90,8 +95,63 @@ const mitk::Image *mitk::ImageReadAccessor::GetImage() const
   return m_Image.GetPointer();
 }
 
+bool mitk::ImageReadAccessor::TryLockFreeReadAccess()
+{
+  if (m_Image->m_PendingWriterCount.load() != 0)
+  {
+    return false;
+  }
+
+  for (auto &slot : m_Image->m_LockFreeReaderSlots)
+  {
+    int expected = ImageAccessorLockFreeSlot::Free;
+    if (!slot.m_State.compare_exchange_strong(expected, ImageAccessorLockFreeSlot::Claimed))
+    {
+      continue;
+    }
+
+    // Announce the read access first and check for writers afterwards. Writers do it the other way round
+    // (see ImageWriteAccessor::WaitForLockFreeReaders()), so with sequentially consistent atomics either
+    // the writer sees this reader or this reader sees the writer.
+    slot.m_AddressBegin = m_AddressBegin;
+    slot.m_AddressEnd = m_AddressEnd;
+    slot.m_State = ImageAccessorLockFreeSlot::Active;
+
+    if (m_Image->m_PendingWriterCount.load() != 0)
+    {
+      // A writer came in between, use the registered access
+      ReleaseLockFreeSlot(&slot);
+      return false;
+    }
+
+    RegisterLockFreeReadAccess(this);
+    m_LockFreeSlot = &slot;
+    return true;
+  }
+
+  // All slots are in use
+  return false;
+}
+
+void mitk::ImageReadAccessor::ReleaseLockFreeSlot(ImageAccessorLockFreeSlot *slot)
+{
+  slot->m_State = ImageAccessorLockFreeSlot::Free;
+
+  if (m_Image->m_PendingWriterCount.load() != 0)
+  {
+    // Locking the mutex makes sure that a writer is either waiting or has not checked the slots yet
+    std::lock_guard<std::mutex> lock(m_Image->m_LockFreeReaderMutex);
+    m_Image->m_LockFreeReaderReleased.notify_all();
+  }
+}
+
 void mitk::ImageReadAccessor::OrganizeReadAccess()
 {
+  if (TryLockFreeReadAccess())
+  {
+    return;
+  }
+
   m_Image->m_ReadWriteLock.Lock();
 
   // Check, if there is any Write-Access going on
@@ -136,6 +196,7 @@ void mitk::ImageReadAccessor::OrganizeReadAccess()
 
   // Now, we know, that there is no conflict with a Write-Access
   // Lock the Mutex in ImageAccessorBase, to make sure that every other ImageAccessor has to wait if it locks the mutex
+  CreateWaitLock();
   m_WaitLock->m_Mutex.Lock();
 
   // insert self into readers list in Image
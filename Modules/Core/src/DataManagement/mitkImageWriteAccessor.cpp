@@ -12,11 +12,26 @@ found in the LICENSE file.
 
 #include "mitkImageWriteAccessor.h"
 
+#include <mutex>
+
 mitk::ImageWriteAccessor::ImageWriteAccessor(ImagePointer image, const mitk::ImageDataItem *iDI, int OptionFlags)
   : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags), m_Image(image)
 
 {
-  OrganizeWriteAccess();
+  // From now on, new ImageReadAccessors have to register themselves, so the lock-free readers can only drain
+  m_Image->m_PendingWriterCount.fetch_add(1);
+
+  try
+  {
+    WaitForLockFreeReaders();
+    OrganizeWriteAccess();
+  }
+  catch (...)
+  {
+    m_Image->m_PendingWriterCount.fetch_sub(1);
+    delete m_WaitLock;
+    throw;
+  }
 }
 
 mitk::ImageWriteAccessor::~ImageWriteAccessor()
@@ -42,6 +57,8 @@ mitk::ImageWriteAccessor::~ImageWriteAccessor()
   }
 
   m_Image->m_ReadWriteLock.Unlock();
+
+  m_Image->m_PendingWriterCount.fetch_sub(1);
 }
 
 const mitk::Image *mitk::ImageWriteAccessor::GetImage() const
@@ -49,6 +66,46 @@ const mitk::Image *mitk::ImageWriteAccessor::GetImage() const
   return m_Image.GetPointer();
 }
 
+void mitk::ImageWriteAccessor::WaitForLockFreeReaders()
+{
+  // Lock-free readers of the calling thread would never be released while it waits
+  if (HoldsOverlappingLockFreeReadAccess(m_Image.GetPointer()))
+  {
+    mitkThrow()
+      << "Prohibited image access: the requested image part is already in use and cannot be requested recursively!";
+  }
+
+  if (!OverlapsLockFreeReader())
+  {
+    return;
+  }
+
+  if (m_Options & ExceptionIfLocked)
+  {
+    mitkThrowException(mitk::MemoryIsLockedException)
+      << "The image part being ordered by the ImageAccessor is already in use and locked";
+  }
+
+  std::unique_lock<std::mutex> lock(m_Image->m_LockFreeReaderMutex);
+  m_Image->m_LockFreeReaderReleased.wait(lock, [this]() { return !OverlapsLockFreeReader(); });
+}
+
+bool mitk::ImageWriteAccessor::OverlapsLockFreeReader() const
+{
+  // Claimed slots can be ignored: their readers activate them after m_PendingWriterCount has been incremented,
+  // thus they see this writer and release the slot again.
+  for (const auto &slot : m_Image->m_LockFreeReaderSlots)
+  {
+    if (slot.m_State.load() == ImageAccessorLockFreeSlot::Active &&
+        Overlap(slot.m_AddressBegin.load(), slot.m_AddressEnd.load()))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 void mitk::ImageWriteAccessor::OrganizeWriteAccess()
 {
   m_Image->m_ReadWriteLock.Lock();
@@ -136,6 +193,7 @@ void mitk::ImageWriteAccessor::OrganizeWriteAccess()
 
   // Now, we know, that there is no conflict with a Read- or Write-Access
   // Lock the Mutex in ImageAccessorBase, to make sure that every other ImageAccessor has to wait
+  CreateWaitLock();
   m_WaitLock->m_Mutex.Lock();
 
   // insert self into Writers list in Image
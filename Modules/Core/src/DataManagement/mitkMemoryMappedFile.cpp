@@ -0,0 +1,129 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkMemoryMappedFile.h"
+#include "mitkException.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+mitk::MemoryMappedFile::MemoryMappedFile(const std::string &fileName, std::size_t offset, std::size_t length)
+  : m_FileName(fileName),
+    m_Mapping(nullptr),
+    m_MappingSize(0),
+    m_Data(nullptr),
+    m_Size(length)
+#ifdef _WIN32
+    ,
+    m_FileHandle(INVALID_HANDLE_VALUE),
+    m_MappingHandle(nullptr)
+#endif
+{
+  if (length == 0)
+  {
+    mitkThrow() << "Cannot map zero bytes of file " << fileName;
+  }
+
+#ifdef _WIN32
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  const std::size_t granularity = systemInfo.dwAllocationGranularity;
+#else
+  const std::size_t granularity = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+
+  // mappings have to start at a multiple of the allocation granularity
+  const std::size_t alignedOffset = (offset / granularity) * granularity;
+  const std::size_t delta = offset - alignedOffset;
+  m_MappingSize = length + delta;
+
+#ifdef _WIN32
+  m_FileHandle =
+    CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (m_FileHandle == INVALID_HANDLE_VALUE)
+  {
+    mitkThrow() << "Cannot open file " << fileName << " for memory mapping";
+  }
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(m_FileHandle, &fileSize) || static_cast<std::size_t>(fileSize.QuadPart) < offset + length)
+  {
+    CloseHandle(m_FileHandle);
+    mitkThrow() << "File " << fileName << " is too small to map " << length << " bytes at offset " << offset;
+  }
+
+  m_MappingHandle = CreateFileMappingA(m_FileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  if (m_MappingHandle == nullptr)
+  {
+    CloseHandle(m_FileHandle);
+    mitkThrow() << "Cannot create file mapping for " << fileName;
+  }
+
+  const unsigned long long offset64 = alignedOffset;
+  m_Mapping = MapViewOfFile(m_MappingHandle,
+                            FILE_MAP_COPY,
+                            static_cast<DWORD>(offset64 >> 32),
+                            static_cast<DWORD>(offset64 & 0xFFFFFFFF),
+                            m_MappingSize);
+  if (m_Mapping == nullptr)
+  {
+    CloseHandle(m_MappingHandle);
+    CloseHandle(m_FileHandle);
+    mitkThrow() << "Cannot map " << length << " bytes of file " << fileName;
+  }
+#else
+  int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+  if (fileDescriptor < 0)
+  {
+    mitkThrow() << "Cannot open file " << fileName << " for memory mapping";
+  }
+
+  struct stat fileStatus;
+  if (fstat(fileDescriptor, &fileStatus) != 0 || static_cast<std::size_t>(fileStatus.st_size) < offset + length)
+  {
+    close(fileDescriptor);
+    mitkThrow() << "File " << fileName << " is too small to map " << length << " bytes at offset " << offset;
+  }
+
+  void *mapping =
+    mmap(nullptr, m_MappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDescriptor, static_cast<off_t>(alignedOffset));
+
+  // the mapping stays valid after closing the file descriptor
+  close(fileDescriptor);
+
+  if (mapping == MAP_FAILED)
+  {
+    mitkThrow() << "Cannot map " << length << " bytes of file " << fileName;
+  }
+
+  m_Mapping = mapping;
+#endif
+
+  m_Data = static_cast<unsigned char *>(m_Mapping) + delta;
+}
+
+mitk::MemoryMappedFile::~MemoryMappedFile()
+{
+#ifdef _WIN32
+  UnmapViewOfFile(m_Mapping);
+  CloseHandle(m_MappingHandle);
+  CloseHandle(m_FileHandle);
+#else
+  munmap(m_Mapping, m_MappingSize);
+#endif
+}
@@ -22,13 +22,17 @@ found in the LICENSE file.
 #include <mitkLocaleSwitch.h>
 #include <mitkUIDManipulator.h>
 
+#include <itkByteSwapper.h>
 #include <itkImage.h>
 #include <itkImageFileReader.h>
 #include <itkImageIOFactory.h>
 #include <itkImageIORegion.h>
 #include <itkMetaDataObject.h>
+#include <itksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <cctype>
+#include <fstream>
 
 namespace mitk
 {
@@ -38,6 +42,253 @@ namespace mitk
   const char *const PROPERTY_KEY_TIMEGEOMETRY_TIMEPOINTS = "org_mitk_timegeometry_timepoints";
   const char* const PROPERTY_KEY_UID = "org_mitk_uid";
 
+  namespace
+  {
+    bool SupportsMemoryMapping(const itk::ImageIOBase *imageIO)
+    {
+      const std::string imageIOName = imageIO->GetNameOfClass();
+      return imageIOName == "NrrdImageIO" || imageIOName == "MetaImageIO";
+    }
+
+    std::string Trim(const std::string &value)
+    {
+      const auto begin = value.find_first_not_of(" \t\r");
+      if (begin == std::string::npos)
+      {
+        return std::string();
+      }
+      return value.substr(begin, value.find_last_not_of(" \t\r") - begin + 1);
+    }
+
+    std::string ToLower(std::string value)
+    {
+      std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+      return value;
+    }
+
+    std::string GetDataFilePath(const std::string &headerPath, const std::string &dataFile)
+    {
+      if (itksys::SystemTools::FileIsFullPath(dataFile))
+      {
+        return dataFile;
+      }
+      const std::string directory = itksys::SystemTools::GetFilenamePath(headerPath);
+      return directory.empty() ? dataFile : directory + "/" + dataFile;
+    }
+
+    /** Determines file and byte offset of the data of an uncompressed nrrd file (attached or detached header).
+     Returns false for every case the data cannot simply be mapped, e.g. for compressed or byte swapped data. */
+    bool GetNrrdRawDataLocation(const std::string &path,
+                                const itk::ImageIOBase *imageIO,
+                                std::string &dataFile,
+                                long long &byteSkip)
+    {
+      std::ifstream file(path.c_str(), std::ios::binary);
+      std::string line;
+      if (!std::getline(file, line) || line.compare(0, 4, "NRRD") != 0)
+      {
+        return false;
+      }
+
+      std::string encoding, endian;
+      unsigned int dimension = 0;
+      long long lineSkip = 0;
+      bool headerComplete = false;
+      byteSkip = 0;
+
+      while (std::getline(file, line))
+      {
+        line = Trim(line);
+        if (line.empty())
+        {
+          headerComplete = true;
+          break;
+        }
+        if (line[0] == '#')
+        {
+          continue;
+        }
+
+        const auto pos = line.find(':');
+        if (pos == std::string::npos || (pos + 1 < line.size() && line[pos + 1] == '='))
+        {
+          continue; // no field, but key/value pair
+        }
+
+        const std::string key = ToLower(Trim(line.substr(0, pos)));
+        const std::string value = Trim(line.substr(pos + 1));
+
+        if (key == "encoding")
+          encoding = ToLower(value);
+        else if (key == "endian")
+          endian = ToLower(value);
+        else if (key == "dimension")
+          dimension = std::stoul(value);
+        else if (key == "byte skip" || key == "byteskip")
+          byteSkip = std::stoll(value);
+        else if (key == "line skip" || key == "lineskip")
+          lineSkip = std::stoll(value);
+        else if (key == "data file" || key == "datafile")
+        {
+          if (value.find(' ') != std::string::npos)
+          {
+            return false; // file lists and file name patterns cannot be mapped as one block
+          }
+          dataFile = GetDataFilePath(path, value);
+        }
+      }
+
+      if (encoding != "raw" || lineSkip != 0 || dimension != imageIO->GetNumberOfDimensions())
+      {
+        return false;
+      }
+
+      if (imageIO->GetComponentSize() > 1 &&
+          (endian == "big") != itk::ByteSwapper<short>::SystemIsBigEndian())
+      {
+        return false;
+      }
+
+      if (dataFile.empty())
+      {
+        if (!headerComplete)
+        {
+          return false;
+        }
+        dataFile = path;
+        if (byteSkip >= 0)
+        {
+          byteSkip += static_cast<long long>(file.tellg());
+        }
+      }
+
+      return true;
+    }
+
+    /** Determines file and byte offset of the data of an uncompressed MetaImage (mhd/mha) file.
+     Returns false for every case the data cannot simply be mapped, e.g. for compressed or byte swapped data. */
+    bool GetMetaImageRawDataLocation(const std::string &path,
+                                     const itk::ImageIOBase *imageIO,
+                                     std::string &dataFile,
+                                     long long &byteSkip)
+    {
+      std::ifstream file(path.c_str(), std::ios::binary);
+      std::string line;
+      bool bigEndian = false;
+      byteSkip = 0;
+
+      while (std::getline(file, line))
+      {
+        const auto pos = line.find('=');
+        if (pos == std::string::npos)
+        {
+          continue;
+        }
+
+        const std::string key = ToLower(Trim(line.substr(0, pos)));
+        const std::string value = Trim(line.substr(pos + 1));
+        const std::string lowerValue = ToLower(value);
+
+        if (key == "compresseddata" && lowerValue == "true")
+        {
+          return false;
+        }
+        else if (key == "binarydatabyteordermsb" || key == "elementbyteordermsb")
+        {
+          bigEndian = lowerValue == "true";
+        }
+        else if (key == "headersize")
+        {
+          byteSkip = std::stoll(value);
+        }
+        else if (key == "elementdatafile")
+        {
+          // ElementDataFile is always the last field of the header
+          if (lowerValue == "local")
+          {
+            dataFile = path;
+            if (byteSkip >= 0)
+            {
+              byteSkip += static_cast<long long>(file.tellg());
+            }
+          }
+          else if (lowerValue == "list" || value.find(' ') != std::string::npos)
+          {
+            return false;
+          }
+          else
+          {
+            dataFile = GetDataFilePath(path, value);
+          }
+          break;
+        }
+      }
+
+      if (dataFile.empty())
+      {
+        return false;
+      }
+
+      return imageIO->GetComponentSize() <= 1 || bigEndian == itk::ByteSwapper<short>::SystemIsBigEndian();
+    }
+
+    /** Determines file and byte offset of uncompressed scalar raw data that can be memory mapped as it is. */
+    bool GetMappableRawDataLocation(const std::string &path,
+                                    const itk::ImageIOBase *imageIO,
+                                    std::string &dataFile,
+                                    std::size_t &offset)
+    {
+      if (imageIO->GetNumberOfComponents() != 1)
+      {
+        return false;
+      }
+
+      long long byteSkip = 0;
+      const std::string imageIOName = imageIO->GetNameOfClass();
+
+      try
+      {
+        if (imageIOName == "NrrdImageIO")
+        {
+          if (!GetNrrdRawDataLocation(path, imageIO, dataFile, byteSkip))
+            return false;
+        }
+        else if (imageIOName == "MetaImageIO")
+        {
+          if (!GetMetaImageRawDataLocation(path, imageIO, dataFile, byteSkip))
+            return false;
+        }
+        else
+        {
+          return false;
+        }
+      }
+      catch (const std::exception &)
+      {
+        return false; // malformed numbers in the header
+      }
+
+      const auto fileSize = static_cast<long long>(itksys::SystemTools::FileLength(dataFile));
+      const auto dataSize = static_cast<long long>(imageIO->GetImageSizeInBytes());
+
+      // a negative byte skip means that the data is located at the end of the file
+      const long long dataOffset = byteSkip < 0 ? fileSize - dataSize : byteSkip;
+      if (dataOffset < 0 || dataOffset + dataSize > fileSize)
+      {
+        return false;
+      }
+
+      offset = static_cast<std::size_t>(dataOffset);
+      return true;
+    }
+  }
+
+  std::string ItkImageIO::OPTION_MEMORY_MAPPING()
+  {
+    static std::string s = "Memory mapping";
+    return s;
+  }
+
   ItkImageIO::ItkImageIO(const ItkImageIO &other)
     : AbstractFileIO(other), m_ImageIO(dynamic_cast<itk::ImageIOBase *>(other.m_ImageIO->Clone().GetPointer()))
   {
@@ -122,6 +373,7 @@ namespace mitk
 
     this->AbstractFileReader::SetMimeTypePrefix(IOMimeTypes::DEFAULT_BASE_NAME() + ".image.");
     this->InitializeDefaultMetaDataKeys();
+    this->InitializeDefaultReaderOptions();
 
     std::vector<std::string> readExtensions = m_ImageIO->GetSupportedReadExtensions();
 
@@ -207,6 +459,7 @@ namespace mitk
 
     this->AbstractFileReader::SetMimeTypePrefix(IOMimeTypes::DEFAULT_BASE_NAME() + ".image.");
     this->InitializeDefaultMetaDataKeys();
+    this->InitializeDefaultReaderOptions();
 
     if (rank)
     {
@@ -336,13 +589,38 @@ namespace mitk
     ioRegion.SetSize(ioSize);
     ioRegion.SetIndex(ioStart);
 
-    MITK_INFO << "ioRegion: " << ioRegion << std::endl;
-    m_ImageIO->SetIORegion(ioRegion);
-    void *buffer = new unsigned char[m_ImageIO->GetImageSizeInBytes()];
-    m_ImageIO->Read(buffer);
+    bool useMemoryMapping = false;
+    if (SupportsMemoryMapping(m_ImageIO))
+    {
+      try
+      {
+        useMemoryMapping = us::any_cast<bool>(this->GetReaderOption(OPTION_MEMORY_MAPPING()));
+      }
+      catch (const us::BadAnyCastException &e)
+      {
+        MITK_WARN << "Unexpected error: " << e.what();
+      }
+    }
 
     image->Initialize(MakePixelType(m_ImageIO), ndim, dimensions);
-    image->SetImportChannel(buffer, 0, Image::ManageMemory);
+
+    std::string rawDataFile;
+    std::size_t rawDataOffset = 0;
+    if (useMemoryMapping && ndim == m_ImageIO->GetNumberOfDimensions() &&
+        GetMappableRawDataLocation(path, m_ImageIO, rawDataFile, rawDataOffset))
+    {
+      MITK_INFO << "memory mapping " << rawDataFile << " at offset " << rawDataOffset << std::endl;
+      image->SetMappedChannel(rawDataFile, rawDataOffset);
+    }
+    else
+    {
+      MITK_INFO << "ioRegion: " << ioRegion << std::endl;
+      m_ImageIO->SetIORegion(ioRegion);
+      void *buffer = new unsigned char[m_ImageIO->GetImageSizeInBytes()];
+      m_ImageIO->Read(buffer);
+
+      image->SetImportChannel(buffer, 0, Image::ManageMemory);
+    }
 
     const itk::MetaDataDictionary &dictionary = m_ImageIO->GetMetaDataDictionary();
 
@@ -435,7 +713,6 @@ namespace mitk
 
     image->SetTimeGeometry(timeGeometry);
 
-    buffer = nullptr;
     MITK_INFO << "number of image components: " << image->GetPixelType().GetNumberOfComponents();
 
     for (auto iter = dictionary.Begin(), iterEnd = dictionary.End(); iter != iterEnd;
@@ -751,4 +1028,14 @@ namespace mitk
     this->m_DefaultMetaDataKeys.push_back(PROPERTY_NAME_TIMEGEOMETRY_TIMEPOINTS);
     this->m_DefaultMetaDataKeys.push_back("ITK.InputFilterName");
   }
+
+  void ItkImageIO::InitializeDefaultReaderOptions()
+  {
+    if (SupportsMemoryMapping(m_ImageIO))
+    {
+      Options defaultOptions;
+      defaultOptions[OPTION_MEMORY_MAPPING()] = us::Any(false);
+      this->SetDefaultReaderOptions(defaultOptions);
+    }
+  }
 }
@@ -0,0 +1,248 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImageSliceCache.h"
+
+#include <mitkImage.h>
+#include <mitkPlaneGeometry.h>
+
+#include <iterator>
+#include <limits>
+#include <tuple>
+
+namespace
+{
+  void AppendGeometry(const mitk::BaseGeometry *geometry, std::vector<double> &values)
+  {
+    if (nullptr == geometry)
+    {
+      values.push_back(0.0);
+      return;
+    }
+
+    values.push_back(1.0);
+
+    auto transform = geometry->GetIndexToWorldTransform();
+    const auto &matrix = transform->GetMatrix();
+    const auto &offset = transform->GetOffset();
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      for (unsigned int j = 0; j < 3; ++j)
+        values.push_back(matrix[i][j]);
+
+      values.push_back(offset[i]);
+    }
+
+    const auto &bounds = geometry->GetBounds();
+
+    for (unsigned int i = 0; i < 6; ++i)
+      values.push_back(bounds[i]);
+
+    values.push_back(geometry->GetImageGeometry() ? 1.0 : 0.0);
+  }
+
+  std::size_t GetMemorySize(const mitk::ImageSliceCache::Slice &slice)
+  {
+    // vtkDataObject::GetActualMemorySize() returns kibibytes
+    return nullptr != slice.Image
+      ? static_cast<std::size_t>(slice.Image->GetActualMemorySize()) * 1024
+      : 0;
+  }
+}
+
+mitk::ImageSliceCache::SliceKey::SliceKey(const Image *image,
+                                          const PlaneGeometry *planeGeometry,
+                                          TimeStepType timeStep,
+                                          int interpolationMode,
+                                          int thickSlicesMode,
+                                          int thickSlicesNum,
+                                          bool inPlaneResampleExtentByGeometry)
+  : m_Image(image),
+    m_ImageMTime(nullptr != image ? image->GetMTime() : 0),
+    m_TimeStep(timeStep),
+    m_InterpolationMode(interpolationMode),
+    m_ThickSlicesMode(thickSlicesMode),
+    m_ThickSlicesNum(0 != thickSlicesMode ? thickSlicesNum : 0),
+    m_InPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry)
+{
+  m_Geometry.reserve(2 * 20);
+
+  AppendGeometry(planeGeometry, m_Geometry);
+  AppendGeometry(nullptr != planeGeometry ? planeGeometry->GetReferenceGeometry() : nullptr, m_Geometry);
+}
+
+bool mitk::ImageSliceCache::SliceKey::operator<(const SliceKey &other) const
+{
+  return std::tie(m_Image,
+                  m_ImageMTime,
+                  m_TimeStep,
+                  m_InterpolationMode,
+                  m_ThickSlicesMode,
+                  m_ThickSlicesNum,
+                  m_InPlaneResampleExtentByGeometry,
+                  m_Geometry) < std::tie(other.m_Image,
+                                         other.m_ImageMTime,
+                                         other.m_TimeStep,
+                                         other.m_InterpolationMode,
+                                         other.m_ThickSlicesMode,
+                                         other.m_ThickSlicesNum,
+                                         other.m_InPlaneResampleExtentByGeometry,
+                                         other.m_Geometry);
+}
+
+mitk::ImageSliceCache *mitk::ImageSliceCache::GetInstance()
+{
+  static ImageSliceCache instance;
+  return &instance;
+}
+
+mitk::ImageSliceCache::ImageSliceCache()
+  : m_MemoryBudget(128 * 1024 * 1024),
+    m_MemoryUsage(0)
+{
+}
+
+mitk::ImageSliceCache::~ImageSliceCache()
+{
+}
+
+bool mitk::ImageSliceCache::GetSlice(const SliceKey &key, Slice &slice)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto it = m_Index.find(key);
+
+  if (m_Index.end() == it)
+    return false;
+
+  // Move the entry to the front of the least recently used list
+  m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+
+  slice = it->second->Value;
+  return true;
+}
+
+void mitk::ImageSliceCache::AddSlice(const SliceKey &key, const Slice &slice)
+{
+  const std::size_t size = GetMemorySize(slice);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  // Slices of previous versions of the image, or of a deleted image at the same address, will never be
+  // requested again
+  for (auto it = this->FindFirstSlice(key.m_Image, 0);
+       m_Index.end() != it && it->first.m_Image == key.m_Image && it->first.m_ImageMTime < key.m_ImageMTime;)
+  {
+    const auto entry = it->second;
+    ++it;
+    this->RemoveEntry(entry);
+  }
+
+  // Neither is this slice if a later version of the image is cached
+  const auto laterSlice = this->FindFirstSlice(key.m_Image, key.m_ImageMTime + 1);
+
+  if (m_Index.end() != laterSlice && laterSlice->first.m_Image == key.m_Image)
+    return;
+
+  auto existingEntry = m_Index.find(key);
+
+  if (m_Index.end() != existingEntry)
+    this->RemoveEntry(existingEntry->second);
+
+  if (0 == size || size > m_MemoryBudget)
+    return;
+
+  m_Entries.push_front(Entry{key, slice, size});
+  m_Index.emplace(key, m_Entries.begin());
+  m_MemoryUsage += size;
+
+  this->EnforceMemoryBudget();
+}
+
+void mitk::ImageSliceCache::RemoveSlices(const Image *image)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  for (auto it = this->FindFirstSlice(image, 0); m_Index.end() != it && it->first.m_Image == image;)
+  {
+    const auto entry = it->second;
+    ++it;
+    this->RemoveEntry(entry);
+  }
+}
+
+void mitk::ImageSliceCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_Index.clear();
+  m_Entries.clear();
+  m_MemoryUsage = 0;
+}
+
+std::size_t mitk::ImageSliceCache::GetMemoryBudget() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MemoryBudget;
+}
+
+void mitk::ImageSliceCache::SetMemoryBudget(std::size_t memoryBudget)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_MemoryBudget = memoryBudget;
+  this->EnforceMemoryBudget();
+}
+
+std::size_t mitk::ImageSliceCache::GetMemoryUsage() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MemoryUsage;
+}
+
+std::size_t mitk::ImageSliceCache::GetNumberOfSlices() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Entries.size();
+}
+
+mitk::ImageSliceCache::IndexType::iterator mitk::ImageSliceCache::FindFirstSlice(const Image *image,
+                                                                                itk::ModifiedTimeType imageMTime)
+{
+  // The index is ordered by the image and its modification time first, i.e. the slices of an image are adjacent
+  SliceKey firstKey(nullptr,
+                    nullptr,
+                    0,
+                    std::numeric_limits<int>::lowest(),
+                    std::numeric_limits<int>::lowest(),
+                    std::numeric_limits<int>::lowest(),
+                    false);
+  firstKey.m_Image = image;
+  firstKey.m_ImageMTime = imageMTime;
+  firstKey.m_Geometry.clear();
+
+  return m_Index.lower_bound(firstKey);
+}
+
+void mitk::ImageSliceCache::RemoveEntry(EntryList::iterator entry)
+{
+  m_MemoryUsage -= entry->Size;
+  m_Index.erase(entry->Key);
+  m_Entries.erase(entry);
+}
+
+void mitk::ImageSliceCache::EnforceMemoryBudget()
+{
+  while (m_MemoryUsage > m_MemoryBudget && !m_Entries.empty())
+    this->RemoveEntry(std::prev(m_Entries.end()));
+}
@@ -0,0 +1,446 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImageSlicePrefetcher.h"
+
+#include <mitkAbstractTransformGeometry.h>
+#include <mitkBaseRenderer.h>
+#include <mitkDataStorage.h>
+#include <mitkExtractSliceFilter.h>
+#include <mitkImageReadAccessor.h>
+
+#include "vtkMitkThickSlicesFilter.h"
+
+#include <vtkImageData.h>
+#include <vtkImageReslice.h>
+#include <vtkMatrix4x4.h>
+
+#include <itkCommand.h>
+
+#include <algorithm>
+#include <set>
+#include <thread>
+
+namespace
+{
+  void CountModification(const itk::Object *, const itk::EventObject &, void *modificationCount)
+  {
+    ++*static_cast<std::atomic<unsigned long> *>(modificationCount);
+  }
+}
+
+/** \brief Worker threads shared by all prefetchers.
+ *
+ * The threads run as long as prefetchers exist. Its mutex guards the requests of all prefetchers.
+ */
+class mitk::ImageSlicePrefetcher::WorkerPool
+{
+public:
+  static WorkerPool *GetInstance()
+  {
+    static WorkerPool instance;
+    return &instance;
+  }
+
+  std::mutex &GetMutex() { return m_Mutex; }
+
+  void Register()
+  {
+    std::lock_guard<std::mutex> threadsLock(m_ThreadsMutex);
+
+    if (0 != m_NumberOfPrefetchers++)
+      return;
+
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Stop = false;
+    }
+
+    // Reslicing is memory bound, few threads suffice and leave the others to the application
+    const unsigned int numberOfThreads = std::max(1u, std::min(4u, std::thread::hardware_concurrency() / 2));
+
+    for (unsigned int i = 0; i < numberOfThreads; ++i)
+      m_Threads.emplace_back(&WorkerPool::Run, this);
+  }
+
+  void Unregister(ImageSlicePrefetcher *prefetcher)
+  {
+    std::lock_guard<std::mutex> threadsLock(m_ThreadsMutex);
+
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Prefetchers.erase(std::remove(m_Prefetchers.begin(), m_Prefetchers.end(), prefetcher), m_Prefetchers.end());
+
+      if (0 != --m_NumberOfPrefetchers)
+        return;
+
+      m_Stop = true;
+    }
+
+    m_RequestsAvailable.notify_all();
+
+    for (auto &thread : m_Threads)
+      thread.join();
+
+    m_Threads.clear();
+  }
+
+  /** \brief Let the workers take the requests of a prefetcher. The mutex must be locked. */
+  void Schedule(ImageSlicePrefetcher *prefetcher)
+  {
+    if (m_Prefetchers.end() == std::find(m_Prefetchers.begin(), m_Prefetchers.end(), prefetcher))
+      m_Prefetchers.push_back(prefetcher);
+
+    m_RequestsAvailable.notify_all();
+  }
+
+private:
+  WorkerPool() : m_NumberOfPrefetchers(0), m_Stop(false) {}
+
+  void Run()
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    while (true)
+    {
+      m_RequestsAvailable.wait(lock, [this] { return m_Stop || !m_Prefetchers.empty(); });
+
+      if (m_Stop)
+        break;
+
+      // Take the requests of the prefetchers in turns
+      ImageSlicePrefetcher *prefetcher = m_Prefetchers.front();
+      m_Prefetchers.pop_front();
+
+      if (prefetcher->m_Requests.empty())
+        continue;
+
+      const PendingRequest request = prefetcher->m_Requests.front();
+      prefetcher->m_Requests.pop_front();
+      prefetcher->m_ImagesInProcess.push_back(request.RequestedImage);
+
+      if (!prefetcher->m_Requests.empty())
+        m_Prefetchers.push_back(prefetcher);
+
+      lock.unlock();
+      prefetcher->ProcessRequest(request);
+      lock.lock();
+
+      auto &imagesInProcess = prefetcher->m_ImagesInProcess;
+      imagesInProcess.erase(std::find(imagesInProcess.begin(), imagesInProcess.end(), request.RequestedImage));
+
+      if (prefetcher->m_Requests.empty() && imagesInProcess.empty())
+        prefetcher->m_RequestsProcessed.notify_all();
+    }
+  }
+
+  std::mutex m_Mutex;
+  std::condition_variable m_RequestsAvailable;
+  std::deque<ImageSlicePrefetcher *> m_Prefetchers;
+  bool m_Stop;
+
+  std::mutex m_ThreadsMutex;
+  std::vector<std::thread> m_Threads;
+  unsigned int m_NumberOfPrefetchers;
+};
+
+mitk::ImageSlicePrefetcher::ImageSlicePrefetcher()
+  : m_WorkerPool(WorkerPool::GetInstance()),
+    m_NumberOfPrefetchedSlices(0)
+{
+  m_WorkerPool->Register();
+}
+
+mitk::ImageSlicePrefetcher::~ImageSlicePrefetcher()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_WorkerPool->GetMutex());
+    m_Requests.clear();
+    m_RequestsProcessed.wait(lock, [this] { return m_ImagesInProcess.empty(); });
+  }
+
+  m_WorkerPool->Unregister(this);
+  this->ReleaseUnusedImages();
+}
+
+void mitk::ImageSlicePrefetcher::AddRequests(BaseRenderer *renderer,
+                                             const PlaneGeometry *worldGeometry,
+                                             TimeStepType timeStep,
+                                             std::vector<Request> &requests)
+{
+  if (nullptr == renderer || nullptr == worldGeometry || BaseRenderer::Standard2D != renderer->GetMapperID())
+    return;
+
+  // Slices on curved planes are not cached by the mapper
+  if (nullptr != dynamic_cast<const AbstractTransformGeometry *>(worldGeometry))
+    return;
+
+  auto dataStorage = renderer->GetDataStorage();
+  const auto *worldTimeGeometry = renderer->GetWorldTimeGeometry();
+
+  if (dataStorage.IsNull() || nullptr == worldTimeGeometry || !worldTimeGeometry->IsValidTimeStep(timeStep))
+    return;
+
+  const TimePointType timePoint = worldTimeGeometry->TimeStepToTimePoint(timeStep);
+
+  // The worker thread must not access geometries that may be changed on the main thread
+  PlaneGeometry::ConstPointer worldGeometryClone = worldGeometry->Clone().GetPointer();
+
+  auto nodes = dataStorage->GetAll();
+
+  for (const auto &node : *nodes)
+  {
+    const auto *image = dynamic_cast<const Image *>(node->GetData());
+
+    if (nullptr == image || !image->IsInitialized() || !node->IsVisible(renderer))
+      continue;
+
+    if (nullptr == dynamic_cast<ImageVtkMapper2D *>(node->GetMapper(BaseRenderer::Standard2D)))
+      continue;
+
+    const auto *imageTimeGeometry = image->GetTimeGeometry();
+
+    if (!imageTimeGeometry->IsValidTimePoint(timePoint))
+      continue;
+
+    const TimeStepType imageTimeStep = imageTimeGeometry->TimePointToTimeStep(timePoint);
+
+    if (!image->IsVolumeSet(imageTimeStep))
+      continue;
+
+    const auto resliceParameters = ImageVtkMapper2D::GetResliceParameters(image, node, renderer);
+
+    Request request{ImageSliceCache::SliceKey(image,
+                                              worldGeometryClone,
+                                              imageTimeStep,
+                                              resliceParameters.InterpolationMode,
+                                              resliceParameters.ThickSlicesMode,
+                                              resliceParameters.ThickSlicesNum,
+                                              resliceParameters.InPlaneResampleExtentByGeometry),
+                    image,
+                    image->GetMTime(),
+                    imageTimeStep,
+                    imageTimeGeometry->GetGeometryForTimeStep(imageTimeStep)->Clone().GetPointer(),
+                    worldGeometryClone,
+                    resliceParameters};
+
+    requests.push_back(request);
+  }
+}
+
+void mitk::ImageSlicePrefetcher::Prefetch(const std::vector<Request> &requests)
+{
+  std::deque<PendingRequest> pendingRequests;
+
+  for (const auto &request : requests)
+  {
+    // Requests of images modified since their creation are outdated
+    if (request.RequestedImage.IsNull() || request.RequestedImage->GetMTime() != request.RequestedImageMTime)
+      continue;
+
+    auto observedImage = m_ObservedImages.find(request.RequestedImage.GetPointer());
+
+    if (m_ObservedImages.end() == observedImage)
+    {
+      ObservedImage newObservedImage;
+      newObservedImage.RequestedImage = request.RequestedImage;
+      newObservedImage.ModificationCount = std::make_shared<std::atomic<unsigned long>>(0);
+
+      auto command = itk::CStyleCommand::New();
+      command->SetClientData(newObservedImage.ModificationCount.get());
+      command->SetConstCallback(&CountModification);
+      newObservedImage.ObserverTag = request.RequestedImage->AddObserver(itk::ModifiedEvent(), command);
+
+      observedImage = m_ObservedImages.emplace(request.RequestedImage.GetPointer(), newObservedImage).first;
+    }
+
+    // The worker threads do not reference the image, it is kept by m_ObservedImages
+    PendingRequest pendingRequest{request,
+                                  request.RequestedImage.GetPointer(),
+                                  observedImage->second.ModificationCount,
+                                  observedImage->second.ModificationCount->load()};
+    pendingRequest.Data.RequestedImage = nullptr;
+
+    pendingRequests.push_back(pendingRequest);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_WorkerPool->GetMutex());
+    m_Requests.swap(pendingRequests);
+
+    if (!m_Requests.empty())
+      m_WorkerPool->Schedule(this);
+  }
+
+  this->ReleaseUnusedImages();
+}
+
+void mitk::ImageSlicePrefetcher::Cancel()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_WorkerPool->GetMutex());
+    m_Requests.clear();
+  }
+
+  this->ReleaseUnusedImages();
+}
+
+void mitk::ImageSlicePrefetcher::WaitForCompletion()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_WorkerPool->GetMutex());
+    m_RequestsProcessed.wait(lock, [this] { return m_Requests.empty() && m_ImagesInProcess.empty(); });
+  }
+
+  this->ReleaseUnusedImages();
+}
+
+std::size_t mitk::ImageSlicePrefetcher::GetNumberOfPrefetchedSlices() const
+{
+  std::lock_guard<std::mutex> lock(m_WorkerPool->GetMutex());
+  return m_NumberOfPrefetchedSlices;
+}
+
+void mitk::ImageSlicePrefetcher::ReleaseUnusedImages()
+{
+  std::set<const Image *> usedImages;
+
+  {
+    std::lock_guard<std::mutex> lock(m_WorkerPool->GetMutex());
+
+    for (const auto &request : m_Requests)
+      usedImages.insert(request.RequestedImage);
+
+    usedImages.insert(m_ImagesInProcess.begin(), m_ImagesInProcess.end());
+  }
+
+  for (auto it = m_ObservedImages.begin(); it != m_ObservedImages.end();)
+  {
+    if (0 != usedImages.count(it->first))
+    {
+      ++it;
+      continue;
+    }
+
+    // Observers of const objects are added and removed likewise
+    const_cast<Image *>(it->second.RequestedImage.GetPointer())->RemoveObserver(it->second.ObserverTag);
+    it = m_ObservedImages.erase(it);
+  }
+}
+
+void mitk::ImageSlicePrefetcher::ProcessRequest(const PendingRequest &pendingRequest)
+{
+  const Request &request = pendingRequest.Data;
+  const Image *image = pendingRequest.RequestedImage;
+
+  // The modification count is incremented on the thread that modifies the image, unlike its modification time
+  // which must not be read here
+  auto isOutdated = [&pendingRequest] {
+    return *pendingRequest.ModificationCount != pendingRequest.RequestedModificationCount;
+  };
+
+  auto *cache = ImageSliceCache::GetInstance();
+
+  if (0 == cache->GetMemoryBudget())
+    return;
+
+  ImageSliceCache::Slice slice;
+
+  if (cache->GetSlice(request.Key, slice))
+    return;
+
+  const auto &parameters = request.ResliceParameters;
+
+  try
+  {
+    // Prevent writers from changing the pixel data while it is resliced
+    const auto volumeData = image->GetVolumeData(static_cast<int>(request.TimeStep));
+    ImageReadAccessor accessor(image, volumeData);
+
+    if (isOutdated())
+      return;
+
+    // Reslice an image of its own to keep the pipeline of the requested image untouched
+    auto volume = Image::New();
+    volume->Initialize(image->GetPixelType(), *request.ImageGeometry);
+    volume->SetImportVolume(const_cast<void *>(accessor.GetData()), 0, 0, Image::ReferenceMemory);
+
+    auto reslicer = ExtractSliceFilter::New();
+    reslicer->SetInput(volume);
+    reslicer->SetWorldGeometry(request.WorldGeometry);
+    reslicer->SetTimeStep(0);
+    reslicer->SetResliceTransformByGeometry(request.ImageGeometry);
+    reslicer->SetInPlaneResampleExtentByGeometry(parameters.InPlaneResampleExtentByGeometry);
+    reslicer->SetVtkOutputRequest(true);
+
+    switch (parameters.InterpolationMode)
+    {
+      case VTK_RESLICE_LINEAR:
+        reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_LINEAR);
+        break;
+      case VTK_RESLICE_CUBIC:
+        reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_CUBIC);
+        break;
+      default:
+        reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
+        break;
+    }
+
+    // Detach the slice from the pipeline of the reslicer which is destroyed afterwards
+    slice.Image = vtkSmartPointer<vtkImageData>::New();
+
+    if (parameters.ThickSlicesMode > 0)
+    {
+      Vector3D normal = request.WorldGeometry->GetNormal();
+      normal.Normalize();
+
+      Vector3D normInIndex;
+      request.ImageGeometry->WorldToIndex(normal, normInIndex);
+
+      reslicer->SetOutputDimensionality(3);
+      reslicer->SetOutputSpacingZDirection(1.0 / normInIndex.GetNorm());
+      reslicer->SetOutputExtentZDirection(-parameters.ThickSlicesNum, parameters.ThickSlicesNum);
+      reslicer->Update();
+
+      auto thickSlicesFilter = vtkSmartPointer<vtkMitkThickSlicesFilter>::New();
+      thickSlicesFilter->SetThickSliceMode(parameters.ThickSlicesMode - 1);
+      thickSlicesFilter->SetInputData(reslicer->GetVtkOutput());
+      thickSlicesFilter->Update();
+
+      slice.Image->ShallowCopy(thickSlicesFilter->GetOutput());
+    }
+    else
+    {
+      reslicer->UpdateLargestPossibleRegion();
+      slice.Image->ShallowCopy(reslicer->GetVtkOutput());
+    }
+
+    slice.ResliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+    slice.ResliceAxes->DeepCopy(reslicer->GetResliceAxes());
+    slice.Spacing[0] = reslicer->GetOutputSpacing()[0];
+    slice.Spacing[1] = reslicer->GetOutputSpacing()[1];
+  }
+  catch (const std::exception &e)
+  {
+    MITK_WARN << "Could not prefetch slice: " << e.what();
+    return;
+  }
+
+  // Slices of outdated images would remove the slices of the current image from the cache
+  if (isOutdated())
+    return;
+
+  cache->AddSlice(request.Key, slice);
+
+  std::lock_guard<std::mutex> lock(m_WorkerPool->GetMutex());
+  ++m_NumberOfPrefetchedSlices;
+}
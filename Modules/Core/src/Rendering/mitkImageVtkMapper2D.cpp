@@ -13,6 +13,7 @@ found in the LICENSE file.
 // MITK
 #include <mitkAbstractTransformGeometry.h>
 #include <mitkDataNode.h>
+#include <mitkImageSliceCache.h>
 #include <mitkImageSliceSelector.h>
 #include <mitkLevelWindowProperty.h>
 #include <mitkLookupTableProperty.h>
@@ -197,77 +198,53 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
   localStorage->m_Reslicer->SetResliceTransformByGeometry(
     image->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()));
 
+  const ResliceParameters resliceParameters = GetResliceParameters(image, datanode, renderer);
+  const int interpolationMode = resliceParameters.InterpolationMode;
+  const int thickSlicesMode = resliceParameters.ThickSlicesMode;
+  const int thickSlicesNum = resliceParameters.ThickSlicesNum;
+  const bool inPlaneResampleExtentByGeometry = resliceParameters.InPlaneResampleExtentByGeometry;
+
   // is the geometry of the slice based on the input image or the worldgeometry?
-  bool inPlaneResampleExtentByGeometry = false;
-  datanode->GetBoolProperty("in plane resample extent by geometry", inPlaneResampleExtentByGeometry, renderer);
   localStorage->m_Reslicer->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
 
-  // Initialize the interpolation mode for resampling; switch to nearest
-  // neighbor if the input image is too small.
-  if ((image->GetDimension() >= 3) && (image->GetDimension(2) > 1))
-  {
-    VtkResliceInterpolationProperty *resliceInterpolationProperty;
-    datanode->GetProperty(resliceInterpolationProperty, "reslice interpolation", renderer);
-
-    int interpolationMode = VTK_RESLICE_NEAREST;
-    if (resliceInterpolationProperty != nullptr)
-    {
-      interpolationMode = resliceInterpolationProperty->GetInterpolation();
-    }
-
-    switch (interpolationMode)
-    {
-      case VTK_RESLICE_NEAREST:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
-        break;
-      case VTK_RESLICE_LINEAR:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_LINEAR);
-        break;
-      case VTK_RESLICE_CUBIC:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_CUBIC);
-        break;
-    }
-  }
-  else
+  switch (interpolationMode)
   {
-    localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
+    case VTK_RESLICE_LINEAR:
+      localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_LINEAR);
+      break;
+    case VTK_RESLICE_CUBIC:
+      localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_CUBIC);
+      break;
+    default:
+      localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
+      break;
   }
 
   // set the vtk output property to true, makes sure that no unneeded mitk image convertion
   // is done.
   localStorage->m_Reslicer->SetVtkOutputRequest(true);
 
-  // Thickslicing
-  int thickSlicesMode = 0;
-  int thickSlicesNum = 1;
-  // Thick slices parameters
-  if (image->GetPixelType().GetNumberOfComponents() == 1) // for now only single component are allowed
-  {
-    DataNode *dn = renderer->GetCurrentWorldPlaneGeometryNode();
-    if (dn)
-    {
-      ResliceMethodProperty *resliceMethodEnumProperty = nullptr;
-
-      if (dn->GetProperty(resliceMethodEnumProperty, "reslice.thickslices", renderer) && resliceMethodEnumProperty)
-        thickSlicesMode = resliceMethodEnumProperty->GetValueAsId();
-
-      IntProperty *intProperty = nullptr;
-      if (dn->GetProperty(intProperty, "reslice.thickslices.num", renderer) && intProperty)
-      {
-        thickSlicesNum = intProperty->GetValue();
-        if (thickSlicesNum < 1)
-          thickSlicesNum = 1;
-      }
-    }
-    else
-    {
-      MITK_WARN << "no associated widget plane data tree node found";
-    }
-  }
-
   const auto *planeGeometry = dynamic_cast<const PlaneGeometry *>(worldGeometry);
 
-  if (thickSlicesMode > 0)
+  // Slices on curved planes depend on more than the plane geometry and are therefore not cached
+  const bool useSliceCache = nullptr == dynamic_cast<const AbstractTransformGeometry *>(worldGeometry);
+  const ImageSliceCache::SliceKey sliceKey(image,
+                                           worldGeometry,
+                                           this->GetTimestep(),
+                                           interpolationMode,
+                                           thickSlicesMode,
+                                           thickSlicesNum,
+                                           inPlaneResampleExtentByGeometry);
+  ImageSliceCache::Slice cachedSlice;
+
+  if (useSliceCache && ImageSliceCache::GetInstance()->GetSlice(sliceKey, cachedSlice))
+  {
+    localStorage->m_ReslicedImage = cachedSlice.Image;
+    localStorage->m_ResliceAxes = cachedSlice.ResliceAxes;
+    localStorage->m_CachedSliceSpacing[0] = cachedSlice.Spacing[0];
+    localStorage->m_CachedSliceSpacing[1] = cachedSlice.Spacing[1];
+  }
+  else if (thickSlicesMode > 0)
   {
     double dataZSpacing = 1.0;
 
@@ -323,6 +300,28 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     localStorage->m_ReslicedImage = localStorage->m_Reslicer->GetVtkOutput();
   }
 
+  if (nullptr == cachedSlice.Image)
+  {
+    // Cached reslice axes are shared, so they are never modified in place
+    cachedSlice.ResliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+    cachedSlice.ResliceAxes->DeepCopy(localStorage->m_Reslicer->GetResliceAxes());
+    cachedSlice.Spacing[0] = localStorage->m_Reslicer->GetOutputSpacing()[0];
+    cachedSlice.Spacing[1] = localStorage->m_Reslicer->GetOutputSpacing()[1];
+
+    localStorage->m_ResliceAxes = cachedSlice.ResliceAxes;
+    localStorage->m_CachedSliceSpacing[0] = cachedSlice.Spacing[0];
+    localStorage->m_CachedSliceSpacing[1] = cachedSlice.Spacing[1];
+
+    if (useSliceCache && 0 != ImageSliceCache::GetInstance()->GetMemoryBudget())
+    {
+      // The cache shares the pixels of the reslicer output. VTK filters only reuse output scalars that are not
+      // referenced elsewhere, so the next update allocates new ones instead of overwriting the cached slice.
+      cachedSlice.Image = vtkSmartPointer<vtkImageData>::New();
+      cachedSlice.Image->ShallowCopy(localStorage->m_ReslicedImage);
+      ImageSliceCache::GetInstance()->AddSlice(sliceKey, cachedSlice);
+    }
+  }
+
   // Bounds information for reslicing (only reuqired if reference geometry
   // is present)
   // this used for generating a vtkPLaneSource with the right size
@@ -334,7 +333,7 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
   localStorage->m_Reslicer->GetClippedPlaneBounds(sliceBounds);
 
   // get the spacing of the slice
-  localStorage->m_mmPerPixel = localStorage->m_Reslicer->GetOutputSpacing();
+  localStorage->m_mmPerPixel = localStorage->m_CachedSliceSpacing;
 
   // calculate minimum bounding rect of IMAGE in texture
   {
@@ -721,6 +720,60 @@ void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
   localStorage->m_LastUpdateTime.Modified();
 }
 
+mitk::ImageVtkMapper2D::ResliceParameters mitk::ImageVtkMapper2D::GetResliceParameters(const Image *image,
+                                                                                      const DataNode *node,
+                                                                                      BaseRenderer *renderer)
+{
+  ResliceParameters parameters;
+
+  parameters.InPlaneResampleExtentByGeometry = false;
+  node->GetBoolProperty("in plane resample extent by geometry", parameters.InPlaneResampleExtentByGeometry, renderer);
+
+  // Initialize the interpolation mode for resampling; switch to nearest
+  // neighbor if the input image is too small.
+  parameters.InterpolationMode = VTK_RESLICE_NEAREST;
+  if ((image->GetDimension() >= 3) && (image->GetDimension(2) > 1))
+  {
+    VtkResliceInterpolationProperty *resliceInterpolationProperty;
+    node->GetProperty(resliceInterpolationProperty, "reslice interpolation", renderer);
+
+    if (resliceInterpolationProperty != nullptr)
+    {
+      parameters.InterpolationMode = resliceInterpolationProperty->GetInterpolation();
+    }
+  }
+
+  // Thickslicing
+  parameters.ThickSlicesMode = 0;
+  parameters.ThickSlicesNum = 1;
+  // Thick slices parameters
+  if (image->GetPixelType().GetNumberOfComponents() == 1) // for now only single component are allowed
+  {
+    DataNode *dn = renderer->GetCurrentWorldPlaneGeometryNode();
+    if (dn)
+    {
+      ResliceMethodProperty *resliceMethodEnumProperty = nullptr;
+
+      if (dn->GetProperty(resliceMethodEnumProperty, "reslice.thickslices", renderer) && resliceMethodEnumProperty)
+        parameters.ThickSlicesMode = resliceMethodEnumProperty->GetValueAsId();
+
+      IntProperty *intProperty = nullptr;
+      if (dn->GetProperty(intProperty, "reslice.thickslices.num", renderer) && intProperty)
+      {
+        parameters.ThickSlicesNum = intProperty->GetValue();
+        if (parameters.ThickSlicesNum < 1)
+          parameters.ThickSlicesNum = 1;
+      }
+    }
+    else
+    {
+      MITK_WARN << "no associated widget plane data tree node found";
+    }
+  }
+
+  return parameters;
+}
+
 void mitk::ImageVtkMapper2D::SetDefaultProperties(mitk::DataNode *node, mitk::BaseRenderer *renderer, bool overwrite)
 {
   mitk::Image::Pointer image = dynamic_cast<mitk::Image *>(node->GetData());
@@ -1058,7 +1111,7 @@ void mitk::ImageVtkMapper2D::TransformActor(mitk::BaseRenderer *renderer)
   LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
   // get the transformation matrix of the reslicer in order to render the slice as axial, coronal or saggital
   vtkSmartPointer<vtkTransform> trans = vtkSmartPointer<vtkTransform>::New();
-  vtkSmartPointer<vtkMatrix4x4> matrix = localStorage->m_Reslicer->GetResliceAxes();
+  vtkSmartPointer<vtkMatrix4x4> matrix = localStorage->m_ResliceAxes;
   trans->SetMatrix(matrix);
   // transform the plane/contour (the actual actor) to the corresponding view (axial, coronal or saggital)
   localStorage->m_ImageActor->SetUserTransform(trans);
@@ -1122,6 +1175,10 @@ mitk::ImageVtkMapper2D::LocalStorage::LocalStorage()
   m_TSFilter = vtkSmartPointer<vtkMitkThickSlicesFilter>::New();
   m_OutlinePolyData = vtkSmartPointer<vtkPolyData>::New();
   m_ReslicedImage = vtkSmartPointer<vtkImageData>::New();
+  m_ResliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+  m_CachedSliceSpacing[0] = 1.0;
+  m_CachedSliceSpacing[1] = 1.0;
+  m_mmPerPixel = m_CachedSliceSpacing;
   m_EmptyPolyData = vtkSmartPointer<vtkPolyData>::New();
 
   // the following actions are always the same and thus can be performed
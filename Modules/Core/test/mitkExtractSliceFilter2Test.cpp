@@ -0,0 +1,247 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkExtractSliceFilter.h"
+#include "mitkExtractSliceFilter2.h"
+#include "mitkImagePixelWriteAccessor.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+namespace
+{
+  const unsigned int VolumeSize = 192;
+  const unsigned int NumberOfRepetitions = 10;
+}
+
+/** Tests and benchmarks for mitk::ExtractSliceFilter2.
+ *
+ * Slices of all three standard orientations are extracted with and without bricked layout and have to be equal.
+ * The extraction times are reported to compare both layouts. The first update with bricked layout includes the
+ * creation of the bricked copy and is therefore not part of the measurement. The multithreaded extraction has to
+ * produce the same slices as a single thread and its timings are reported next to the vtkImageReslice-based
+ * mitk::ExtractSliceFilter.
+ */
+class mitkExtractSliceFilter2TestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkExtractSliceFilter2TestSuite);
+  MITK_TEST(NearestNeighborBrickedEqualsLinearLayout);
+  MITK_TEST(LinearBrickedEqualsLinearLayout);
+  MITK_TEST(BrickedCopyIsUpdatedOnModifiedInput);
+  MITK_TEST(MultithreadedEqualsSingleThreaded);
+  MITK_TEST(CompareToExtractSliceFilter);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+
+  mitk::PlaneGeometry::Pointer CreatePlaneGeometry(mitk::PlaneGeometry::PlaneOrientation orientation)
+  {
+    auto planeGeometry = mitk::PlaneGeometry::New();
+    planeGeometry->InitializeStandardPlane(m_Image->GetGeometry(), orientation, VolumeSize / 2 + 0.3);
+    planeGeometry->ChangeImageGeometryConsideringOriginOffset(true);
+    return planeGeometry;
+  }
+
+  double MeasureExtraction(mitk::ExtractSliceFilter2 *filter, mitk::PlaneGeometry *planeGeometry)
+  {
+    filter->SetOutputGeometry(planeGeometry);
+    filter->Update();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < NumberOfRepetitions; ++i)
+    {
+      filter->Modified();
+      filter->Update();
+    }
+
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count() / NumberOfRepetitions;
+  }
+
+  double MeasureVtkExtraction(mitk::ExtractSliceFilter *filter, mitk::PlaneGeometry *planeGeometry)
+  {
+    filter->SetWorldGeometry(planeGeometry);
+    filter->Modified();
+    filter->Update();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < NumberOfRepetitions; ++i)
+    {
+      filter->Modified();
+      filter->Update();
+    }
+
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count() / NumberOfRepetitions;
+  }
+
+  int MaximumDifference(mitk::Image *image1, mitk::Image *image2)
+  {
+    const std::size_t numberOfPixels = image1->GetDimension(0) * image1->GetDimension(1);
+    mitk::ImageReadAccessor accessor1(image1);
+    mitk::ImageReadAccessor accessor2(image2);
+    auto data1 = static_cast<const short *>(accessor1.GetData());
+    auto data2 = static_cast<const short *>(accessor2.GetData());
+
+    int maximumDifference = 0;
+    for (std::size_t i = 0; i < numberOfPixels; ++i)
+    {
+      maximumDifference = std::max(maximumDifference, std::abs(static_cast<int>(data1[i]) - data2[i]));
+    }
+    return maximumDifference;
+  }
+
+  void CompareLayouts(mitk::ExtractSliceFilter2::Interpolator interpolator, int tolerance)
+  {
+    const mitk::PlaneGeometry::PlaneOrientation orientations[] = {
+      mitk::PlaneGeometry::Axial, mitk::PlaneGeometry::Sagittal, mitk::PlaneGeometry::Frontal};
+    const char *names[] = {"axial", "sagittal", "frontal"};
+
+    auto linearFilter = mitk::ExtractSliceFilter2::New();
+    linearFilter->SetInput(m_Image);
+    linearFilter->SetInterpolator(interpolator);
+
+    auto brickedFilter = mitk::ExtractSliceFilter2::New();
+    brickedFilter->SetInput(m_Image);
+    brickedFilter->SetInterpolator(interpolator);
+    brickedFilter->SetUseBrickedLayout(true);
+
+    for (int i = 0; i < 3; ++i)
+    {
+      auto planeGeometry = CreatePlaneGeometry(orientations[i]);
+
+      double linearTime = MeasureExtraction(linearFilter, planeGeometry);
+      double brickedTime = MeasureExtraction(brickedFilter, planeGeometry);
+
+      MITK_INFO << names[i] << " slice of " << VolumeSize << "^3 volume: linear layout " << linearTime
+                << " ms, bricked layout " << brickedTime << " ms";
+
+      CPPUNIT_ASSERT_EQUAL(linearFilter->GetOutput()->GetDimension(0), brickedFilter->GetOutput()->GetDimension(0));
+      CPPUNIT_ASSERT_EQUAL(linearFilter->GetOutput()->GetDimension(1), brickedFilter->GetOutput()->GetDimension(1));
+      CPPUNIT_ASSERT_MESSAGE("Bricked layout produces the same slice",
+                             MaximumDifference(linearFilter->GetOutput(), brickedFilter->GetOutput()) <= tolerance);
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[] = {VolumeSize, VolumeSize, VolumeSize};
+    m_Image = mitk::Image::New();
+    m_Image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions);
+
+    mitk::ImagePixelWriteAccessor<short, 3> accessor(m_Image);
+    const itk::IndexValueType size = VolumeSize;
+    itk::Index<3> index;
+    for (index[2] = 0; index[2] < size; ++index[2])
+      for (index[1] = 0; index[1] < size; ++index[1])
+        for (index[0] = 0; index[0] < size; ++index[0])
+          accessor.SetPixelByIndex(index, static_cast<short>(index[0] * 3 + index[1] * 5 - index[2] * 7));
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void NearestNeighborBrickedEqualsLinearLayout() { CompareLayouts(mitk::ExtractSliceFilter2::NearestNeighbor, 0); }
+
+  void LinearBrickedEqualsLinearLayout()
+  {
+    // Both layouts truncate the interpolated value, rounding errors may flip the result by one
+    CompareLayouts(mitk::ExtractSliceFilter2::Linear, 1);
+  }
+
+  void BrickedCopyIsUpdatedOnModifiedInput()
+  {
+    auto filter = mitk::ExtractSliceFilter2::New();
+    filter->SetInput(m_Image);
+    filter->SetUseBrickedLayout(true);
+    filter->SetOutputGeometry(CreatePlaneGeometry(mitk::PlaneGeometry::Sagittal));
+    filter->Update();
+
+    {
+      mitk::ImagePixelWriteAccessor<short, 3> accessor(m_Image);
+      auto data = accessor.GetData();
+      std::fill(data, data + VolumeSize * VolumeSize * VolumeSize, short(42));
+    }
+    m_Image->Modified();
+
+    filter->Update();
+
+    mitk::ImageReadAccessor accessor(filter->GetOutput());
+    CPPUNIT_ASSERT_EQUAL(short(42), static_cast<const short *>(accessor.GetData())[0]);
+  }
+
+  void MultithreadedEqualsSingleThreaded()
+  {
+    const mitk::ExtractSliceFilter2::Interpolator interpolators[] = {
+      mitk::ExtractSliceFilter2::NearestNeighbor, mitk::ExtractSliceFilter2::Linear};
+
+    for (auto interpolator : interpolators)
+    {
+      auto planeGeometry = CreatePlaneGeometry(mitk::PlaneGeometry::Frontal);
+
+      auto singleThreadedFilter = mitk::ExtractSliceFilter2::New();
+      singleThreadedFilter->SetInput(m_Image);
+      singleThreadedFilter->SetInterpolator(interpolator);
+      singleThreadedFilter->SetNumberOfThreads(1);
+      singleThreadedFilter->SetOutputGeometry(planeGeometry);
+      singleThreadedFilter->Update();
+
+      auto multithreadedFilter = mitk::ExtractSliceFilter2::New();
+      multithreadedFilter->SetInput(m_Image);
+      multithreadedFilter->SetInterpolator(interpolator);
+      multithreadedFilter->SetNumberOfThreads(8);
+      multithreadedFilter->SetOutputGeometry(planeGeometry);
+      multithreadedFilter->Update();
+
+      CPPUNIT_ASSERT_EQUAL(0, MaximumDifference(singleThreadedFilter->GetOutput(), multithreadedFilter->GetOutput()));
+    }
+  }
+
+  void CompareToExtractSliceFilter()
+  {
+    const mitk::PlaneGeometry::PlaneOrientation orientations[] = {
+      mitk::PlaneGeometry::Axial, mitk::PlaneGeometry::Sagittal, mitk::PlaneGeometry::Frontal};
+    const char *names[] = {"axial", "sagittal", "frontal"};
+
+    auto filter = mitk::ExtractSliceFilter2::New();
+    filter->SetInput(m_Image);
+    filter->SetInterpolator(mitk::ExtractSliceFilter2::Linear);
+
+    auto vtkFilter = mitk::ExtractSliceFilter::New();
+    vtkFilter->SetInput(m_Image);
+    vtkFilter->SetInterpolationMode(mitk::ExtractSliceFilter::RESLICE_LINEAR);
+
+    for (int i = 0; i < 3; ++i)
+    {
+      auto planeGeometry = CreatePlaneGeometry(orientations[i]);
+
+      double time = MeasureExtraction(filter, planeGeometry);
+      double vtkTime = MeasureVtkExtraction(vtkFilter, planeGeometry);
+
+      MITK_INFO << names[i] << " slice of " << VolumeSize << "^3 volume, linear interpolation: ExtractSliceFilter2 ("
+                << filter->GetNumberOfThreads() << " threads) " << time << " ms, ExtractSliceFilter " << vtkTime
+                << " ms";
+
+      CPPUNIT_ASSERT(vtkFilter->GetOutput()->IsInitialized());
+      CPPUNIT_ASSERT(filter->GetOutput()->IsInitialized());
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkExtractSliceFilter2)
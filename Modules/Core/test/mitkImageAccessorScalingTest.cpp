@@ -0,0 +1,182 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImage.h"
+#include "mitkImagePixelReadAccessor.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  const unsigned int NumberOfAccessesPerThread = 20000;
+}
+
+/** Microbenchmark for concurrent ImageReadAccessors.
+ *
+ * Every thread repeatedly orders read access to the first slice of a shared image. Without a writer, the readers
+ * use the lock-free path. With a writer parked on the last slice (no overlap), every reader has to use the
+ * registered path via the image-wide mutex, which is the behavior all readers had before the lock-free path
+ * existed. The timings are only reported, the assertions check that both modes work and leave the image unlocked.
+ */
+class mitkImageAccessorScalingTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageAccessorScalingTestSuite);
+  MITK_TEST(ReaderScaling);
+  MITK_TEST(WriterWaitsForLockFreeReaders);
+  MITK_TEST(RecursiveWriteAfterLockFreeRead);
+  MITK_TEST(WriterIgnoresNonOverlappingLockFreeReaders);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+
+  double MeasureConcurrentReads(unsigned int numberOfThreads, bool &successful)
+  {
+    mitk::ImageDataItem *firstSlice = m_Image->GetSliceData(0);
+    std::atomic<bool> failed(false);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < numberOfThreads; ++i)
+    {
+      threads.emplace_back([this, firstSlice, &failed]() {
+        try
+        {
+          for (unsigned int j = 0; j < NumberOfAccessesPerThread; ++j)
+          {
+            mitk::ImagePixelReadAccessor<short, 2> accessor(m_Image, firstSlice);
+            if (accessor.GetData() == nullptr)
+            {
+              failed = true;
+            }
+          }
+        }
+        catch (const mitk::Exception &)
+        {
+          failed = true;
+        }
+      });
+    }
+
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+
+    auto stop = std::chrono::steady_clock::now();
+    successful = !failed;
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+  }
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[] = {256, 256, 16};
+    m_Image = mitk::Image::New();
+    m_Image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions);
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void ReaderScaling()
+  {
+    mitk::ImageDataItem *lastSlice = m_Image->GetSliceData(m_Image->GetDimension(2) - 1);
+
+    for (unsigned int numberOfThreads = 1; numberOfThreads <= 16; numberOfThreads *= 2)
+    {
+      bool lockFreeSuccessful = false;
+      double lockFreeTime = MeasureConcurrentReads(numberOfThreads, lockFreeSuccessful);
+
+      bool registeredSuccessful = false;
+      double registeredTime = 0.0;
+      {
+        mitk::ImageWriteAccessor writer(m_Image, lastSlice);
+        registeredTime = MeasureConcurrentReads(numberOfThreads, registeredSuccessful);
+      }
+
+      MITK_INFO << numberOfThreads << " thread(s) x " << NumberOfAccessesPerThread
+                << " read accesses: lock-free " << lockFreeTime << " ms, registered " << registeredTime << " ms";
+
+      CPPUNIT_ASSERT_MESSAGE("Lock-free concurrent read access", lockFreeSuccessful);
+      CPPUNIT_ASSERT_MESSAGE("Registered concurrent read access", registeredSuccessful);
+    }
+
+    // All readers are gone, so exclusive access has to be granted immediately
+    CPPUNIT_ASSERT_NO_THROW(mitk::ImageWriteAccessor(m_Image, nullptr, mitk::ImageAccessorBase::ExceptionIfLocked));
+  }
+
+  void WriterWaitsForLockFreeReaders()
+  {
+    std::atomic<bool> readerActive(false);
+    std::atomic<bool> writerDone(false);
+    std::atomic<bool> writeBeforeRelease(false);
+
+    std::thread reader([this, &readerActive, &writerDone, &writeBeforeRelease]() {
+      mitk::ImageReadAccessor accessor(m_Image);
+      readerActive = true;
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      writeBeforeRelease = writerDone.load();
+    });
+
+    while (!readerActive)
+    {
+      std::this_thread::yield();
+    }
+
+    bool lockedExceptionThrown = false;
+    try
+    {
+      mitk::ImageWriteAccessor writer(m_Image, nullptr, mitk::ImageAccessorBase::ExceptionIfLocked);
+    }
+    catch (const mitk::MemoryIsLockedException &)
+    {
+      lockedExceptionThrown = true;
+    }
+
+    {
+      mitk::ImageWriteAccessor writer(m_Image);
+      writerDone = true;
+    }
+
+    reader.join();
+    CPPUNIT_ASSERT_MESSAGE("ExceptionIfLocked writer throws while a lock-free reader is active", lockedExceptionThrown);
+    CPPUNIT_ASSERT_MESSAGE("Writer was granted access while a lock-free reader was active", !writeBeforeRelease);
+  }
+
+  void RecursiveWriteAfterLockFreeRead()
+  {
+    mitk::ImageReadAccessor reader(m_Image);
+    CPPUNIT_ASSERT_THROW(mitk::ImageWriteAccessor(m_Image, nullptr), mitk::Exception);
+  }
+
+  void WriterIgnoresNonOverlappingLockFreeReaders()
+  {
+    mitk::ImageDataItem *firstSlice = m_Image->GetSliceData(0);
+    mitk::ImageDataItem *lastSlice = m_Image->GetSliceData(m_Image->GetDimension(2) - 1);
+
+    mitk::ImageReadAccessor reader(m_Image, firstSlice);
+    CPPUNIT_ASSERT_NO_THROW(
+      mitk::ImageWriteAccessor(m_Image, lastSlice, mitk::ImageAccessorBase::ExceptionIfLocked));
+    CPPUNIT_ASSERT_THROW(mitk::ImageWriteAccessor(m_Image, firstSlice, mitk::ImageAccessorBase::ExceptionIfLocked),
+                         mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageAccessorScaling)
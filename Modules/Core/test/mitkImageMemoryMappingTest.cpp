@@ -0,0 +1,175 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkIOUtil.h"
+#include "mitkImage.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
+#include "mitkItkImageIO.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <itkByteSwapper.h>
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+  const std::size_t HeaderSize = 100;
+}
+
+class mitkImageMemoryMappingTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageMemoryMappingTestSuite);
+  MITK_TEST(MappedChannel);
+  MITK_TEST(MappedChannelIsCopyOnWrite);
+  MITK_TEST(FileTooSmall);
+  MITK_TEST(LoadNrrdWithMemoryMapping);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::vector<std::string> m_TemporaryFiles;
+  std::vector<short> m_Data;
+  unsigned int m_Dimensions[4];
+
+  std::string WriteFile(const std::string &header, const std::string &templateName)
+  {
+    std::ofstream stream;
+    const std::string fileName = mitk::IOUtil::CreateTemporaryFile(stream, std::ios_base::binary, templateName);
+    m_TemporaryFiles.push_back(fileName);
+
+    stream << header;
+    stream.write(reinterpret_cast<const char *>(m_Data.data()), m_Data.size() * sizeof(short));
+    stream.close();
+
+    return fileName;
+  }
+
+  mitk::Image::Pointer CreateImage()
+  {
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<short>(), 4, m_Dimensions);
+    return image;
+  }
+
+  bool VolumeEquals(const mitk::Image *image, unsigned int t)
+  {
+    const std::size_t volumeSize = m_Dimensions[0] * m_Dimensions[1] * m_Dimensions[2];
+    mitk::ImageReadAccessor accessor(image, image->GetVolumeData(t));
+    const auto *data = static_cast<const short *>(accessor.GetData());
+    return std::equal(data, data + volumeSize, m_Data.begin() + t * volumeSize);
+  }
+
+public:
+  void setUp() override
+  {
+    m_Dimensions[0] = 8;
+    m_Dimensions[1] = 6;
+    m_Dimensions[2] = 4;
+    m_Dimensions[3] = 3;
+
+    m_Data.resize(m_Dimensions[0] * m_Dimensions[1] * m_Dimensions[2] * m_Dimensions[3]);
+    for (std::size_t i = 0; i < m_Data.size(); ++i)
+    {
+      m_Data[i] = static_cast<short>(i * 7 - 300);
+    }
+  }
+
+  void tearDown() override
+  {
+    for (const auto &fileName : m_TemporaryFiles)
+    {
+      itksys::SystemTools::RemoveFile(fileName);
+    }
+    m_TemporaryFiles.clear();
+  }
+
+  void MappedChannel()
+  {
+    const std::string fileName = WriteFile(std::string(HeaderSize, 'x'), "mitkImageMemoryMappingTest_XXXXXX.raw");
+
+    auto image = CreateImage();
+    CPPUNIT_ASSERT(image->SetMappedChannel(fileName, HeaderSize));
+
+    CPPUNIT_ASSERT_MESSAGE("Channel is memory mapped", image->GetChannelData()->IsMemoryMapped());
+    CPPUNIT_ASSERT_MESSAGE("Volume is part of the mapped channel", image->GetVolumeData(2)->IsMemoryMapped());
+
+    for (unsigned int t = 0; t < m_Dimensions[3]; ++t)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Mapped volume data equals file content", VolumeEquals(image, t));
+    }
+  }
+
+  void MappedChannelIsCopyOnWrite()
+  {
+    const std::string fileName = WriteFile(std::string(HeaderSize, 'x'), "mitkImageMemoryMappingTest_XXXXXX.raw");
+
+    auto image = CreateImage();
+    image->SetMappedChannel(fileName, HeaderSize);
+
+    {
+      mitk::ImageWriteAccessor accessor(image);
+      static_cast<short *>(accessor.GetData())[0] = 12345;
+    }
+
+    {
+      mitk::ImageReadAccessor accessor(image);
+      CPPUNIT_ASSERT_EQUAL(short(12345), static_cast<const short *>(accessor.GetData())[0]);
+    }
+
+    auto remapped = CreateImage();
+    remapped->SetMappedChannel(fileName, HeaderSize);
+    CPPUNIT_ASSERT_MESSAGE("Changes are not written back to the file", VolumeEquals(remapped, 0));
+  }
+
+  void FileTooSmall()
+  {
+    const std::string fileName = WriteFile(std::string(), "mitkImageMemoryMappingTest_XXXXXX.raw");
+
+    auto image = CreateImage();
+    CPPUNIT_ASSERT_THROW(image->SetMappedChannel(fileName, HeaderSize), mitk::Exception);
+  }
+
+  void LoadNrrdWithMemoryMapping()
+  {
+    std::ostringstream header;
+    header << "NRRD0004\n"
+           << "type: short\n"
+           << "dimension: 4\n"
+           << "sizes: " << m_Dimensions[0] << " " << m_Dimensions[1] << " " << m_Dimensions[2] << " "
+           << m_Dimensions[3] << "\n"
+           << "encoding: raw\n"
+           << "endian: " << (itk::ByteSwapper<short>::SystemIsBigEndian() ? "big" : "little") << "\n\n";
+    const std::string fileName = WriteFile(header.str(), "mitkImageMemoryMappingTest_XXXXXX.nrrd");
+
+    mitk::IFileReader::Options options;
+    options[mitk::ItkImageIO::OPTION_MEMORY_MAPPING()] = us::Any(true);
+    auto image = mitk::IOUtil::Load<mitk::Image>(fileName, options);
+
+    CPPUNIT_ASSERT(image.IsNotNull());
+    CPPUNIT_ASSERT_MESSAGE("Raw nrrd data is memory mapped", image->GetChannelData()->IsMemoryMapped());
+    for (unsigned int t = 0; t < m_Dimensions[3]; ++t)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Mapped volume data equals file content", VolumeEquals(image, t));
+    }
+
+    auto readImage = mitk::IOUtil::Load<mitk::Image>(fileName);
+    CPPUNIT_ASSERT_MESSAGE("Memory mapping is off by default", !readImage->GetChannelData()->IsMemoryMapped());
+    CPPUNIT_ASSERT_MESSAGE("Read volume data equals file content", VolumeEquals(readImage, 1));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageMemoryMapping)
@@ -0,0 +1,201 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImage.h"
+#include "mitkImageSliceCache.h"
+#include "mitkPlaneGeometry.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <vtkImageData.h>
+#include <vtkMatrix4x4.h>
+
+class mitkImageSliceCacheTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageSliceCacheTestSuite);
+  MITK_TEST(CachedSliceIsReturned);
+  MITK_TEST(EqualPlanesShareSlices);
+  MITK_TEST(ModifiedImageInvalidatesSlices);
+  MITK_TEST(SlicesOfPreviousVersionsAreNotAdded);
+  MITK_TEST(SlicesOfDeletedImagesAreEvicted);
+  MITK_TEST(LeastRecentlyUsedSliceIsRemoved);
+  MITK_TEST(ZeroBudgetDisablesCache);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::ImageSliceCache *m_Cache;
+  std::size_t m_OriginalMemoryBudget;
+  mitk::Image::Pointer m_Image;
+
+  mitk::PlaneGeometry::Pointer CreatePlaneGeometry(mitk::ScalarType zPosition)
+  {
+    auto planeGeometry = mitk::PlaneGeometry::New();
+    planeGeometry->InitializeStandardPlane(m_Image->GetGeometry(), mitk::PlaneGeometry::Axial, zPosition);
+    return planeGeometry;
+  }
+
+  mitk::ImageSliceCache::SliceKey CreateKey(const mitk::PlaneGeometry *planeGeometry)
+  {
+    return mitk::ImageSliceCache::SliceKey(m_Image, planeGeometry, 0, 0, 0, 1, false);
+  }
+
+  mitk::ImageSliceCache::Slice CreateSlice()
+  {
+    mitk::ImageSliceCache::Slice slice;
+    slice.Image = vtkSmartPointer<vtkImageData>::New();
+    slice.Image->SetDimensions(64, 64, 1);
+    slice.Image->AllocateScalars(VTK_SHORT, 1);
+    slice.ResliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+    slice.Spacing[0] = 1.0;
+    slice.Spacing[1] = 1.0;
+    return slice;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Cache = mitk::ImageSliceCache::GetInstance();
+    m_OriginalMemoryBudget = m_Cache->GetMemoryBudget();
+    m_Cache->Clear();
+
+    unsigned int dimensions[] = {64, 64, 16};
+    m_Image = mitk::Image::New();
+    m_Image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions);
+  }
+
+  void tearDown() override
+  {
+    m_Cache->Clear();
+    m_Cache->SetMemoryBudget(m_OriginalMemoryBudget);
+    m_Image = nullptr;
+  }
+
+  void CachedSliceIsReturned()
+  {
+    auto key = CreateKey(CreatePlaneGeometry(3));
+    auto slice = CreateSlice();
+
+    mitk::ImageSliceCache::Slice cachedSlice;
+    CPPUNIT_ASSERT(!m_Cache->GetSlice(key, cachedSlice));
+
+    m_Cache->AddSlice(key, slice);
+
+    CPPUNIT_ASSERT(m_Cache->GetSlice(key, cachedSlice));
+    CPPUNIT_ASSERT(cachedSlice.Image == slice.Image);
+    CPPUNIT_ASSERT(m_Cache->GetMemoryUsage() > 0);
+
+    mitk::ImageSliceCache::Slice otherSlice;
+    CPPUNIT_ASSERT_MESSAGE("Different planes are different slices",
+                           !m_Cache->GetSlice(CreateKey(CreatePlaneGeometry(4)), otherSlice));
+  }
+
+  void EqualPlanesShareSlices()
+  {
+    auto slice = CreateSlice();
+    m_Cache->AddSlice(CreateKey(CreatePlaneGeometry(5)), slice);
+
+    // A different plane geometry object at the same position, e.g. of another render window
+    mitk::ImageSliceCache::Slice cachedSlice;
+    CPPUNIT_ASSERT(m_Cache->GetSlice(CreateKey(CreatePlaneGeometry(5)), cachedSlice));
+    CPPUNIT_ASSERT(cachedSlice.Image == slice.Image);
+  }
+
+  void ModifiedImageInvalidatesSlices()
+  {
+    auto planeGeometry = CreatePlaneGeometry(3);
+    m_Cache->AddSlice(CreateKey(planeGeometry), CreateSlice());
+
+    m_Image->Modified();
+
+    mitk::ImageSliceCache::Slice cachedSlice;
+    CPPUNIT_ASSERT(!m_Cache->GetSlice(CreateKey(planeGeometry), cachedSlice));
+
+    m_Cache->AddSlice(CreateKey(CreatePlaneGeometry(4)), CreateSlice());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Outdated slices are removed", std::size_t(1), m_Cache->GetNumberOfSlices());
+  }
+
+  void SlicesOfPreviousVersionsAreNotAdded()
+  {
+    auto planeGeometry = CreatePlaneGeometry(3);
+    auto previousKey = CreateKey(planeGeometry);
+
+    m_Image->Modified();
+    m_Cache->AddSlice(CreateKey(planeGeometry), CreateSlice());
+
+    // e.g. resliced in the background while the image was modified
+    m_Cache->AddSlice(previousKey, CreateSlice());
+
+    mitk::ImageSliceCache::Slice cachedSlice;
+    CPPUNIT_ASSERT(!m_Cache->GetSlice(previousKey, cachedSlice));
+    CPPUNIT_ASSERT(m_Cache->GetSlice(CreateKey(planeGeometry), cachedSlice));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_Cache->GetNumberOfSlices());
+  }
+
+  void SlicesOfDeletedImagesAreEvicted()
+  {
+    m_Cache->AddSlice(CreateKey(CreatePlaneGeometry(3)), CreateSlice());
+    m_Cache->AddSlice(CreateKey(CreatePlaneGeometry(4)), CreateSlice());
+    m_Cache->SetMemoryBudget(m_Cache->GetMemoryUsage());
+
+    // The slices of a deleted image stay until they are the least recently used ones
+    auto otherImage = m_Image->Clone();
+    m_Image = nullptr;
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Cache->GetNumberOfSlices());
+
+    m_Image = otherImage;
+    m_Cache->AddSlice(CreateKey(CreatePlaneGeometry(3)), CreateSlice());
+    m_Cache->AddSlice(CreateKey(CreatePlaneGeometry(4)), CreateSlice());
+
+    mitk::ImageSliceCache::Slice cachedSlice;
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Cache->GetNumberOfSlices());
+    CPPUNIT_ASSERT(m_Cache->GetSlice(CreateKey(CreatePlaneGeometry(3)), cachedSlice));
+    CPPUNIT_ASSERT(m_Cache->GetSlice(CreateKey(CreatePlaneGeometry(4)), cachedSlice));
+  }
+
+  void LeastRecentlyUsedSliceIsRemoved()
+  {
+    auto slice = CreateSlice();
+    m_Cache->AddSlice(CreateKey(CreatePlaneGeometry(0)), slice);
+    const std::size_t sliceSize = m_Cache->GetMemoryUsage();
+
+    m_Cache->SetMemoryBudget(3 * sliceSize);
+    m_Cache->AddSlice(CreateKey(CreatePlaneGeometry(1)), CreateSlice());
+    m_Cache->AddSlice(CreateKey(CreatePlaneGeometry(2)), CreateSlice());
+
+    // Use the first slice, so the second one is the least recently used slice
+    mitk::ImageSliceCache::Slice cachedSlice;
+    CPPUNIT_ASSERT(m_Cache->GetSlice(CreateKey(CreatePlaneGeometry(0)), cachedSlice));
+
+    m_Cache->AddSlice(CreateKey(CreatePlaneGeometry(3)), CreateSlice());
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), m_Cache->GetNumberOfSlices());
+    CPPUNIT_ASSERT(m_Cache->GetMemoryUsage() <= m_Cache->GetMemoryBudget());
+    CPPUNIT_ASSERT(m_Cache->GetSlice(CreateKey(CreatePlaneGeometry(0)), cachedSlice));
+    CPPUNIT_ASSERT(!m_Cache->GetSlice(CreateKey(CreatePlaneGeometry(1)), cachedSlice));
+    CPPUNIT_ASSERT(m_Cache->GetSlice(CreateKey(CreatePlaneGeometry(2)), cachedSlice));
+    CPPUNIT_ASSERT(m_Cache->GetSlice(CreateKey(CreatePlaneGeometry(3)), cachedSlice));
+  }
+
+  void ZeroBudgetDisablesCache()
+  {
+    m_Cache->SetMemoryBudget(0);
+
+    auto key = CreateKey(CreatePlaneGeometry(3));
+    m_Cache->AddSlice(key, CreateSlice());
+
+    mitk::ImageSliceCache::Slice cachedSlice;
+    CPPUNIT_ASSERT(!m_Cache->GetSlice(key, cachedSlice));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Cache->GetMemoryUsage());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageSliceCache)
@@ -0,0 +1,189 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkImage.h"
+#include "mitkImageSliceCache.h"
+#include "mitkImageSlicePrefetcher.h"
+#include "mitkPlaneGeometry.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <vtkImageData.h>
+#include <vtkImageReslice.h>
+
+class mitkImageSlicePrefetcherTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageSlicePrefetcherTestSuite);
+  MITK_TEST(RequestedSlicesAreCached);
+  MITK_TEST(ThickSlicesAreCached);
+  MITK_TEST(SlicesOfModifiedImagesAreDiscarded);
+  MITK_TEST(PendingRequestsAreReplaced);
+  MITK_TEST(SeveralPrefetchersShareTheWorkers);
+  MITK_TEST(ImagesAreReleasedAfterProcessing);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::ImageSliceCache *m_Cache;
+  mitk::Image::Pointer m_Image;
+
+  mitk::ImageSlicePrefetcher::Request CreateRequest(mitk::ScalarType zPosition, int thickSlicesMode = 0)
+  {
+    auto planeGeometry = mitk::PlaneGeometry::New();
+    planeGeometry->InitializeStandardPlane(m_Image->GetGeometry(), mitk::PlaneGeometry::Axial, zPosition);
+
+    mitk::ImageVtkMapper2D::ResliceParameters parameters;
+    parameters.InterpolationMode = VTK_RESLICE_NEAREST;
+    parameters.ThickSlicesMode = thickSlicesMode;
+    parameters.ThickSlicesNum = 2;
+    parameters.InPlaneResampleExtentByGeometry = false;
+
+    return mitk::ImageSlicePrefetcher::Request{mitk::ImageSliceCache::SliceKey(m_Image,
+                                                                               planeGeometry,
+                                                                               0,
+                                                                               parameters.InterpolationMode,
+                                                                               parameters.ThickSlicesMode,
+                                                                               parameters.ThickSlicesNum,
+                                                                               parameters.InPlaneResampleExtentByGeometry),
+                                               m_Image.GetPointer(),
+                                               m_Image->GetMTime(),
+                                               0,
+                                               m_Image->GetGeometry()->Clone().GetPointer(),
+                                               planeGeometry.GetPointer(),
+                                               parameters};
+  }
+
+public:
+  void setUp() override
+  {
+    m_Cache = mitk::ImageSliceCache::GetInstance();
+    m_Cache->Clear();
+
+    unsigned int dimensions[] = {32, 32, 16};
+    m_Image = mitk::Image::New();
+    m_Image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions);
+  }
+
+  void tearDown() override
+  {
+    m_Cache->Clear();
+    m_Image = nullptr;
+  }
+
+  void RequestedSlicesAreCached()
+  {
+    std::vector<mitk::ImageSlicePrefetcher::Request> requests;
+    requests.push_back(CreateRequest(3));
+    requests.push_back(CreateRequest(4));
+
+    mitk::ImageSlicePrefetcher prefetcher;
+    prefetcher.Prefetch(requests);
+    prefetcher.WaitForCompletion();
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), prefetcher.GetNumberOfPrefetchedSlices());
+
+    mitk::ImageSliceCache::Slice slice;
+    CPPUNIT_ASSERT(m_Cache->GetSlice(requests.front().Key, slice));
+    CPPUNIT_ASSERT(nullptr != slice.Image);
+    CPPUNIT_ASSERT(nullptr != slice.ResliceAxes);
+    CPPUNIT_ASSERT_EQUAL(32, slice.Image->GetDimensions()[0]);
+    CPPUNIT_ASSERT_EQUAL(32, slice.Image->GetDimensions()[1]);
+
+    // Cached slices are not resliced again
+    prefetcher.Prefetch(requests);
+    prefetcher.WaitForCompletion();
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), prefetcher.GetNumberOfPrefetchedSlices());
+  }
+
+  void ThickSlicesAreCached()
+  {
+    std::vector<mitk::ImageSlicePrefetcher::Request> requests;
+    requests.push_back(CreateRequest(8, 1));
+
+    mitk::ImageSlicePrefetcher prefetcher;
+    prefetcher.Prefetch(requests);
+    prefetcher.WaitForCompletion();
+
+    mitk::ImageSliceCache::Slice slice;
+    CPPUNIT_ASSERT(m_Cache->GetSlice(requests.front().Key, slice));
+    CPPUNIT_ASSERT(nullptr != slice.Image);
+  }
+
+  void SlicesOfModifiedImagesAreDiscarded()
+  {
+    std::vector<mitk::ImageSlicePrefetcher::Request> requests;
+    requests.push_back(CreateRequest(3));
+
+    m_Image->Modified();
+
+    mitk::ImageSlicePrefetcher prefetcher;
+    prefetcher.Prefetch(requests);
+    prefetcher.WaitForCompletion();
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), prefetcher.GetNumberOfPrefetchedSlices());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Cache->GetNumberOfSlices());
+  }
+
+  void PendingRequestsAreReplaced()
+  {
+    std::vector<mitk::ImageSlicePrefetcher::Request> requests;
+
+    for (int z = 0; z < 16; ++z)
+      requests.push_back(CreateRequest(z));
+
+    mitk::ImageSlicePrefetcher prefetcher;
+    prefetcher.Prefetch(requests);
+    prefetcher.Prefetch(std::vector<mitk::ImageSlicePrefetcher::Request>(1, requests.back()));
+    prefetcher.WaitForCompletion();
+
+    // At most the request that was already being processed is resliced in addition
+    CPPUNIT_ASSERT(prefetcher.GetNumberOfPrefetchedSlices() <= 2);
+
+    mitk::ImageSliceCache::Slice slice;
+    CPPUNIT_ASSERT(m_Cache->GetSlice(requests.back().Key, slice));
+  }
+
+  void SeveralPrefetchersShareTheWorkers()
+  {
+    std::vector<mitk::ImageSlicePrefetcher::Request> requests;
+    std::vector<mitk::ImageSlicePrefetcher::Request> otherRequests;
+
+    for (int z = 0; z < 4; ++z)
+    {
+      requests.push_back(CreateRequest(z));
+      otherRequests.push_back(CreateRequest(z + 8));
+    }
+
+    mitk::ImageSlicePrefetcher prefetcher;
+    mitk::ImageSlicePrefetcher otherPrefetcher;
+    prefetcher.Prefetch(requests);
+    otherPrefetcher.Prefetch(otherRequests);
+    prefetcher.WaitForCompletion();
+    otherPrefetcher.WaitForCompletion();
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), prefetcher.GetNumberOfPrefetchedSlices());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), otherPrefetcher.GetNumberOfPrefetchedSlices());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(8), m_Cache->GetNumberOfSlices());
+  }
+
+  void ImagesAreReleasedAfterProcessing()
+  {
+    mitk::ImageSlicePrefetcher prefetcher;
+    prefetcher.Prefetch(std::vector<mitk::ImageSlicePrefetcher::Request>(1, CreateRequest(3)));
+    prefetcher.WaitForCompletion();
+
+    // Only the test references the image, i.e. it would be deleted by this thread
+    CPPUNIT_ASSERT_EQUAL(1, m_Image->GetReferenceCount());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageSlicePrefetcher)
@@ -0,0 +1,152 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include "mitkInteractionConst.h"
+#include "mitkLimitedLinearUndo.h"
+#include "mitkOperationEvent.h"
+
+namespace
+{
+  int g_NumberOfOperations = 0;
+
+  class SizedTestOperation : public mitk::Operation
+  {
+  public:
+    SizedTestOperation(std::size_t memorySize) : Operation(mitk::OpTEST), m_MemorySize(memorySize)
+    {
+      ++g_NumberOfOperations;
+    }
+
+    ~SizedTestOperation() override { --g_NumberOfOperations; }
+
+    std::size_t GetMemorySize() const override { return m_MemorySize; }
+
+  private:
+    std::size_t m_MemorySize;
+  };
+}
+
+class mitkLimitedLinearUndoTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLimitedLinearUndoTestSuite);
+  MITK_TEST(MemorySize);
+  MITK_TEST(MemoryLimit);
+  MITK_TEST(MemoryLimitKeepsNewestItem);
+  MITK_TEST(UndoLimit);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::LimitedLinearUndo::Pointer m_Undo;
+
+  mitk::OperationEvent *AddItem(std::size_t operationSize)
+  {
+    auto *operationEvent = new mitk::OperationEvent(
+      nullptr, new SizedTestOperation(operationSize), new SizedTestOperation(operationSize), "Test");
+    m_Undo->SetOperationEvent(operationEvent);
+    mitk::OperationEvent::IncCurrObjectEventId();
+    return operationEvent;
+  }
+
+public:
+  void setUp() override
+  {
+    g_NumberOfOperations = 0;
+    m_Undo = mitk::LimitedLinearUndo::New();
+  }
+
+  void tearDown() override
+  {
+    m_Undo = nullptr;
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Operations have not been deleted", 0, g_NumberOfOperations);
+  }
+
+  void MemorySize()
+  {
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Undo->GetMemorySize());
+
+    const std::size_t itemSize = this->AddItem(1000)->GetMemorySize();
+    CPPUNIT_ASSERT(itemSize >= 2000);
+    CPPUNIT_ASSERT_EQUAL(itemSize, m_Undo->GetMemorySize());
+
+    this->AddItem(1000);
+    CPPUNIT_ASSERT_EQUAL(2 * itemSize, m_Undo->GetMemorySize());
+
+    // moving items to the redo stack does not change the memory
+    m_Undo->Undo();
+    CPPUNIT_ASSERT_EQUAL(2 * itemSize, m_Undo->GetMemorySize());
+
+    m_Undo->ClearRedoList();
+    CPPUNIT_ASSERT_EQUAL(itemSize, m_Undo->GetMemorySize());
+    CPPUNIT_ASSERT_EQUAL(2, g_NumberOfOperations);
+
+    m_Undo->Clear();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Undo->GetMemorySize());
+    CPPUNIT_ASSERT_EQUAL(0, g_NumberOfOperations);
+  }
+
+  void MemoryLimit()
+  {
+    const std::size_t itemSize = this->AddItem(1000)->GetMemorySize();
+    m_Undo->SetMemoryLimit(3 * itemSize);
+
+    for (int i = 0; i < 4; ++i)
+      this->AddItem(1000);
+
+    // the oldest items have been dropped
+    CPPUNIT_ASSERT_EQUAL(3 * itemSize, m_Undo->GetMemorySize());
+    CPPUNIT_ASSERT_EQUAL(6, g_NumberOfOperations);
+
+    // lowering the limit drops items immediately
+    m_Undo->SetMemoryLimit(itemSize);
+    CPPUNIT_ASSERT_EQUAL(itemSize, m_Undo->GetMemorySize());
+    CPPUNIT_ASSERT_EQUAL(2, g_NumberOfOperations);
+
+    CPPUNIT_ASSERT(m_Undo->Undo() == false);
+    CPPUNIT_ASSERT(!m_Undo->RedoListEmpty());
+  }
+
+  void MemoryLimitKeepsNewestItem()
+  {
+    m_Undo->SetMemoryLimit(100);
+
+    this->AddItem(1000);
+    this->AddItem(1000);
+
+    CPPUNIT_ASSERT_EQUAL(2, g_NumberOfOperations);
+    CPPUNIT_ASSERT(m_Undo->GetMemorySize() > m_Undo->GetMemoryLimit());
+  }
+
+  void UndoLimit()
+  {
+    m_Undo->SetUndoLimit(2);
+
+    for (int i = 0; i < 3; ++i)
+      this->AddItem(10);
+
+    CPPUNIT_ASSERT_EQUAL(4, g_NumberOfOperations);
+
+    m_Undo->SetUndoLimit(1);
+    CPPUNIT_ASSERT_EQUAL(2, g_NumberOfOperations);
+
+    // no limit keeps all items
+    m_Undo->SetUndoLimit(0);
+    this->AddItem(10);
+    CPPUNIT_ASSERT_EQUAL(4, g_NumberOfOperations);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLimitedLinearUndo)
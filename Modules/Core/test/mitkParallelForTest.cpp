@@ -0,0 +1,75 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkParallelFor.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+class mitkParallelForTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkParallelForTestSuite);
+  MITK_TEST(CallsEveryTaskOnce);
+  MITK_TEST(CallsTasksOfRange);
+  MITK_TEST(RethrowsExceptionOfTask);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void CallsEveryTaskOnce()
+  {
+    for (unsigned int numberOfThreads : {0u, 1u, 4u, 64u})
+    {
+      std::vector<std::atomic<unsigned int>> calls(1000);
+      for (auto &call : calls)
+        call = 0;
+
+      mitk::ParallelFor(0, calls.size(), [&calls](std::size_t i) { ++calls[i]; }, numberOfThreads);
+
+      for (const auto &call : calls)
+        CPPUNIT_ASSERT_EQUAL(1u, call.load());
+    }
+  }
+
+  void CallsTasksOfRange()
+  {
+    std::atomic<std::size_t> sum(0);
+    std::atomic<std::size_t> numberOfCalls(0);
+
+    mitk::ParallelFor(10, 20, [&](std::size_t i) {
+      sum += i;
+      ++numberOfCalls;
+    });
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), numberOfCalls.load());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(145), sum.load());
+
+    mitk::ParallelFor(5, 5, [&](std::size_t) { ++numberOfCalls; });
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), numberOfCalls.load());
+  }
+
+  void RethrowsExceptionOfTask()
+  {
+    for (unsigned int numberOfThreads : {1u, 4u})
+    {
+      CPPUNIT_ASSERT_THROW(mitk::ParallelFor(0, 100, [](std::size_t i) {
+                             if (42 == i)
+                               throw std::runtime_error("task failed");
+                           }, numberOfThreads),
+                           std::runtime_error);
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkParallelFor)
@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include "mitkDICOMIOMetaInformationPropertyConstants.h"
 #include "mitkIPropertyPersistence.h"
 #include "mitkTemporoSpatialStringProperty.h"
+#include "mitkDICOMTagIndex.h"
 
 #include <usModuleContext.h>
 #include <usModuleRegistry.h>
@@ -106,6 +107,19 @@ namespace mitk {
 
   void DICOMImageIOActivator::Unload(us::ModuleContext*)
   {
+    // the scanners only update the index in memory, an index that the application has enabled is written once here
+    auto tagIndex = DICOMTagIndex::GetDefaultIndex();
+    if (tagIndex.IsNotNull())
+    {
+      try
+      {
+        tagIndex->Save();
+      }
+      catch (const mitk::Exception& e)
+      {
+        MITK_WARN << "Cannot save the DICOM tag index: " << e.GetDescription();
+      }
+    }
   }
 
   void DICOMImageIOActivator::EnsureManualSelectingDICOMSeriesReader(const us::ModuleEvent event)
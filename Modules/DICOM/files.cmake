@@ -27,6 +27,7 @@ set(CPP_FILES
   mitkDICOMTag.cpp
   mitkDICOMTagsOfInterestHelper.cpp
   mitkDICOMTagCache.cpp
+  mitkDICOMTagIndex.cpp
   mitkDICOMGDCMTagCache.cpp
   mitkDICOMGenericTagCache.cpp
   mitkDICOMEnums.cpp
@@ -14,9 +14,13 @@ found in the LICENSE file.
 #define mitkDICOMGDCMTagCache_h
 
 #include "mitkDICOMTagCache.h"
+#include "mitkDICOMTagIndex.h"
 
 #include <set>
 #include <memory>
+#include <vector>
+#include <list>
+#include <map>
 
 #include <gdcmScanner.h>
 
@@ -43,6 +47,17 @@ namespace mitk
 
       void InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles);
 
+      /**
+        \brief Initializes the cache with the results of several scanners, e.g. of a parallel scan.
+        Files that are not scanned take their values from indexedValues, see DICOMTagIndex.
+        The frames are listed in the order of inputFiles.
+      */
+      void InitCache(const std::set<DICOMTag>& scannedTags,
+                     const StringList& inputFiles,
+                     const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners,
+                     const std::map<std::string, DICOMTagIndex::TagValuesType>& indexedValues);
+
+      /** \brief Returns the (first) scanner of the scan. */
       const gdcm::Scanner& GetScanner() const;
 
   protected:
@@ -54,6 +69,12 @@ namespace mitk
 
       std::shared_ptr<gdcm::Scanner> m_Scanner;
 
+      /** the frame infos refer to the values of all scanners, so they are kept alive with the cache */
+      std::vector<std::shared_ptr<gdcm::Scanner>> m_Scanners;
+
+      /** storage of the indexed values the frame infos refer to, a list keeps the values at their address */
+      std::list<std::string> m_IndexedValues;
+
       DICOMDatasetAccessingImageFrameList m_ScanResult;
 
     private:
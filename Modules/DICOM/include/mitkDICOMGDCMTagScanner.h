@@ -41,6 +41,10 @@ namespace mitk
     results, care should be taken that all the tags and files of interest
     are communicated to DICOMGDCMTagScanner before requesting the results!
 
+    The files are split into partitions that are scanned in parallel by one gdcm::Scanner each,
+    see DICOMTagScanner::SetNumberOfThreads(). Like gdcm::Scanner, every file is only read up
+    to the last tag of interest.
+
     @remark This scanner does only support the scanning for simple value tag.
     If you need to scann for sequence items or non-top-level elements, this scanner
     will not be sufficient. See i.a. DICOMDCMTKTagScanner for these cases.
@@ -109,7 +113,6 @@ namespace mitk
       std::set<DICOMTag> m_ScannedTags;
       StringList m_InputFilenames;
       DICOMGDCMTagCache::Pointer m_Cache;
-      std::shared_ptr<gdcm::Scanner> m_GDCMScanner;
 
     private:
       DICOMGDCMTagScanner(const DICOMGDCMTagScanner&);
@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include "mitkDICOMGDCMImageFrameInfo.h"
 #include "mitkEquiDistantBlocksSorter.h"
 #include "mitkNormalDirectionConsistencySorter.h"
+#include "mitkDICOMImageBlockSlicesLoadedEvent.h"
 #include "MitkDICOMExports.h"
 
 
@@ -31,6 +32,8 @@ namespace itk
 namespace mitk
 {
 
+class ITKDICOMSeriesReaderHelper;
+
 /**
   \ingroup DICOMModule
   \brief Flexible reader based on itk::ImageSeriesReader and GDCM, for single-slice modalities like CT, MR, PET, CR, etc.
@@ -227,6 +230,26 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
     bool GetFixTiltByShearing() const;
 
+    /**
+      \brief Controls whether LoadImages() makes the images available while their slices are loaded.
+
+      In progressive mode, the image of an output is allocated, cleared and set at the
+      output before its files are decoded. The files are decoded in chunks in their order.
+      After each chunk, the loaded slices are marked (DICOMImageBlockDescriptor::IsSliceLoaded()),
+      the image is marked as modified and a DICOMImageBlockSlicesLoadedEvent is invoked,
+      so that observers can render the slices that are already available.
+      LoadImages() itself still returns when all images are loaded. Off by default.
+    */
+    void SetProgressiveLoading(bool on);
+    bool GetProgressiveLoading() const;
+
+    /**
+      \brief Number of files that are decoded between two DICOMImageBlockSlicesLoadedEvent%s.
+      0 (default) chooses the number from the number of decoding threads.
+    */
+    void SetProgressiveLoadingChunkSize(unsigned int numberOfFiles);
+    unsigned int GetProgressiveLoadingChunkSize() const;
+
     /**
       \brief Controls whether groups of only two images are accepted when ensuring consecutive slices via EquiDistantBlocksSorter.
     */
@@ -331,6 +354,16 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
     virtual bool LoadMitkImageForImageBlockDescriptor(DICOMImageBlockDescriptor& block) const;
 
+    /**
+      \brief Prepares helper for loading block, which includes progressive loading if enabled (see SetProgressiveLoading()).
+    */
+    void ConfigureHelperForImageBlockDescriptor(ITKDICOMSeriesReaderHelper& helper, DICOMImageBlockDescriptor& block) const;
+
+    /**
+      \brief Marks all slices of block as loaded after its image has been loaded completely.
+    */
+    void SetAllSlicesLoaded(DICOMImageBlockDescriptor& block) const;
+
     /// \brief Describe this reader's confidence for given SOP class UID
   static ReaderImplementationLevel GetReaderImplementationLevel(const std::string sopClassUID);
   private:
@@ -345,6 +378,9 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
     bool m_SimpleVolumeReading;
 
+    bool m_ProgressiveLoading;
+    unsigned int m_ProgressiveLoadingChunkSize;
+
   private:
 
     SortingBlockList m_SortingResultInProgress;
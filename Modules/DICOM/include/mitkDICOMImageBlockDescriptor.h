@@ -128,17 +128,13 @@ namespace mitk
 
     std::vector<std::string> GetPropertyContextNames() const override;
 
-  private:
-
-    // For future implementation: load slice-by-slice, mark this using these methods
+    /// Marks whether the frame with the given index of the frame list is loaded into the MITK image, see DICOMITKSeriesGDCMReader::SetProgressiveLoading()
     void SetSliceIsLoaded(unsigned int index, bool isLoaded);
-    // For future implementation: load slice-by-slice, mark this using these methods
+    /// Whether the frame with the given index of the frame list is loaded into the MITK image
     bool IsSliceLoaded(unsigned int index) const;
-    // For future implementation: load slice-by-slice, mark this using these methods
+    /// Whether all frames are loaded into the MITK image
     bool AllSlicesAreLoaded() const;
 
-  public:
-
     /// Describe how the mitk::Image's pixel spacing should be interpreted
     PixelSpacingInterpretation GetPixelSpacingInterpretation() const;
 
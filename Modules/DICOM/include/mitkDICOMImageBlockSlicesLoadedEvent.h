@@ -0,0 +1,64 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMImageBlockSlicesLoadedEvent_h
+#define mitkDICOMImageBlockSlicesLoadedEvent_h
+
+#include <itkEventObject.h>
+
+namespace mitk
+{
+  class DICOMImageBlockDescriptor;
+
+  /**
+    \ingroup DICOMModule
+    \brief Invoked by DICOMITKSeriesGDCMReader during progressive loading whenever further slices of an output are loaded.
+
+    The event is invoked on the thread that calls LoadImages(), while no slice is decoded.
+    The image of the block is complete up to GetNumberOfLoadedSlices() slices of GetTimeStep(),
+    see DICOMITKSeriesGDCMReader::SetProgressiveLoading().
+  */
+  class DICOMImageBlockSlicesLoadedEvent : public itk::AnyEvent
+  {
+  public:
+    typedef DICOMImageBlockSlicesLoadedEvent Self;
+    typedef itk::AnyEvent Superclass;
+
+    DICOMImageBlockSlicesLoadedEvent(const DICOMImageBlockDescriptor *block = nullptr,
+                                     unsigned int timeStep = 0,
+                                     unsigned int numberOfLoadedSlices = 0)
+      : m_Block(block), m_TimeStep(timeStep), m_NumberOfLoadedSlices(numberOfLoadedSlices)
+    {
+    }
+    ~DICOMImageBlockSlicesLoadedEvent() override {}
+    const char *GetEventName() const override { return "DICOMImageBlockSlicesLoadedEvent"; }
+    bool CheckEvent(const ::itk::EventObject *e) const override { return dynamic_cast<const Self *>(e); }
+    ::itk::EventObject *MakeObject() const override { return new Self(m_Block, m_TimeStep, m_NumberOfLoadedSlices); }
+    DICOMImageBlockSlicesLoadedEvent(const Self &s)
+      : itk::AnyEvent(s), m_Block(s.m_Block), m_TimeStep(s.m_TimeStep), m_NumberOfLoadedSlices(s.m_NumberOfLoadedSlices){};
+
+    /** The output of the reader whose image has been extended. */
+    const DICOMImageBlockDescriptor *GetBlock() const { return m_Block; }
+    unsigned int GetTimeStep() const { return m_TimeStep; }
+    unsigned int GetNumberOfLoadedSlices() const { return m_NumberOfLoadedSlices; }
+
+  protected:
+    const DICOMImageBlockDescriptor *m_Block;
+    unsigned int m_TimeStep;
+    unsigned int m_NumberOfLoadedSlices;
+
+  private:
+    void operator=(const Self &);
+  };
+}
+
+#endif
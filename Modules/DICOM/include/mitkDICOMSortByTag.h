@@ -43,6 +43,8 @@ class MITKDICOM_EXPORT DICOMSortByTag : public DICOMSortCriterion
 
     double NumericDistance(const mitk::DICOMDatasetAccess* from, const mitk::DICOMDatasetAccess* to) const override;
 
+    bool ExtractSortKeys(const DICOMDatasetList& datasets, std::vector<double>& keys) const override;
+
     void Print(std::ostream& os) const override;
 
     bool operator==(const DICOMSortCriterion& other) const override;
@@ -52,6 +52,25 @@ class MITKDICOM_EXPORT DICOMSortCriterion : public itk::LightObject
     /// This ansers the question of consecutive datasets.
     virtual double NumericDistance(const mitk::DICOMDatasetAccess* from, const mitk::DICOMDatasetAccess* to) const = 0;
 
+    /**
+      \brief Extract one numeric sort key per dataset, for criteria that order datasets by a single number.
+
+      IsLeftBeforeRight() reads and parses the tag values of both datasets in each
+      of the O(n log n) comparisons of a sort. Criteria that can express their order
+      by a number per dataset override this method, so that DICOMTagBasedSorter reads
+      and parses the tags only once per dataset. A dataset is sorted before another one
+      if its key is smaller and the keys differ by more than GetSortKeyTolerance(),
+      otherwise the secondary criterion decides, just as in IsLeftBeforeRight().
+
+      The datasets passed are a group of DICOMTagBasedSorter, i.e. they match in all distinguishing tags.
+
+      \return false if the criterion cannot provide keys (default). Sorting then uses IsLeftBeforeRight().
+    */
+    virtual bool ExtractSortKeys(const DICOMDatasetList& datasets, std::vector<double>& keys) const;
+
+    /// \brief Sort keys that differ by at most this value are equal, see ExtractSortKeys().
+    virtual double GetSortKeyTolerance() const;
+
     /// \brief The fallback criterion.
     DICOMSortCriterion::ConstPointer GetSecondaryCriterion() const;
 
@@ -167,7 +167,7 @@ class MITKDICOM_EXPORT DICOMTagBasedSorter : public DICOMDatasetSorter
     /**
       \brief Helper for SplitInputGroups().
     */
-    std::string BuildGroupID( DICOMDatasetAccess* dataset );
+    std::string BuildGroupID( DICOMDatasetAccess* dataset ) const;
 
     typedef std::map<std::string, DICOMDatasetList> GroupIDToListType;
 
@@ -184,6 +184,15 @@ class MITKDICOM_EXPORT DICOMTagBasedSorter : public DICOMDatasetSorter
     */
     GroupIDToListType& SortGroups(GroupIDToListType& groups);
 
+    /**
+      \brief Sorts the datasets of one group by m_SortCriterion.
+
+      If all criteria of the chain provide sort keys (DICOMSortCriterion::ExtractSortKeys()),
+      the tag values are read and parsed once per dataset instead of in every comparison.
+      Otherwise, the criteria are asked in every comparison (ParameterizedDatasetSort).
+    */
+    void SortDatasets(DICOMDatasetList& datasets) const;
+
     DICOMTagList m_DistinguishingTags;
     typedef std::map<const DICOMTag, TagValueProcessor*>  TagValueProcessorMap;
     TagValueProcessorMap m_TagValueProcessor;
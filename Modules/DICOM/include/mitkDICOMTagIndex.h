@@ -0,0 +1,168 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMTagIndex_h
+#define mitkDICOMTagIndex_h
+
+#include "itkObjectFactory.h"
+#include "mitkCommon.h"
+
+#include "mitkDICOMTagPath.h"
+
+#include "MitkDICOMExports.h"
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace mitk
+{
+
+  /**
+    \ingroup DICOMModule
+    \brief Persistent index of the tag values of scanned DICOM files.
+
+    DICOMTagScanner implementations consult the index before they read a file.
+    If the index knows the file with unchanged size and modification time and
+    all requested tags have been scanned before, the values are taken from the
+    index and the file is not parsed again. Newly scanned files are added to
+    the index.
+
+    The index can be written to a file with Save() and read again with Load(),
+    so that repeated loading of the same DICOM archive skips the header parsing
+    of unchanged files, also across sessions. Scanners only update the index in
+    memory; the owner of the index decides when it is saved. Beyond
+    GetMaximumNumberOfEntries(), Save() drops the files that have been used
+    least recently. Scanners use the index that is set with
+    DICOMTagScanner::SetTagIndex(), which defaults to GetDefaultIndex().
+
+    @remark The index stores the scanned tag values in plain text, which
+    includes patient data like the name or the birth date. Applications
+    should therefore only use a persistent index if the user has asked for
+    it.
+
+    @remark The modification time has a resolution of one second. Files that
+    are overwritten with the same size within one second after they have been
+    scanned are not detected as changed.
+
+    All methods are thread-safe.
+  */
+  class MITKDICOM_EXPORT DICOMTagIndex : public itk::Object
+  {
+    public:
+
+      mitkClassMacroItkParent(DICOMTagIndex, itk::Object);
+      itkFactorylessNewMacro(DICOMTagIndex);
+
+      typedef std::map<DICOMTagPath, std::string> TagValuesType;
+
+      /**
+        \brief The file the index is read from and written to.
+      */
+      void SetFileName(const std::string& fileName);
+      std::string GetFileName() const;
+
+      /**
+        \brief Replaces the content of the index with the content of the index file.
+        A missing index file results in an empty index. An invalid index file is
+        ignored with a warning, because the index can always be rebuilt by scanning.
+      */
+      void Load();
+
+      /**
+        \brief Writes the index to the index file if it has changed since the last Load() or Save().
+        The least recently used files beyond GetMaximumNumberOfEntries() are removed
+        from the index before. Files are not checked on disk, Lookup() ignores
+        files that have changed or no longer exist.
+        \throw mitk::Exception if the file cannot be written
+      */
+      void Save();
+
+      /**
+        \brief Maximum number of files that Save() keeps in the index. Default is 100000.
+      */
+      void SetMaximumNumberOfEntries(std::size_t maximumNumberOfEntries);
+      std::size_t GetMaximumNumberOfEntries() const;
+
+      /**
+        \brief Retrieves the values of a file.
+        \param fileName the file
+        \param paths the tag paths of interest, they may contain wildcards
+        \param values receives the values of all explicit tag paths of the file that match one of paths
+        \return false if the file is unknown, has changed since it was added, or was not scanned for all paths
+      */
+      bool Lookup(const std::string& fileName, const DICOMTagPathList& paths, TagValuesType& values) const;
+
+      /**
+        \brief Adds the scan result of a file.
+        If the file is already known and unchanged, the values are merged with the existing ones.
+        \param fileName the scanned file
+        \param paths the tag paths the file has been scanned for
+        \param values all values that have been found for paths
+      */
+      void Update(const std::string& fileName, const DICOMTagPathList& paths, const TagValuesType& values);
+
+      /** \brief Removes all files from the index. */
+      void Clear();
+
+      std::size_t GetNumberOfEntries() const;
+
+      /**
+        \brief The index that new scanners use. Default is nullptr, which disables the index
+        for new scanners. Applications set an index if the user has enabled it; the DICOM
+        image IO module saves the default index when it is unloaded.
+      */
+      static void SetDefaultIndex(DICOMTagIndex* index);
+      static DICOMTagIndex::Pointer GetDefaultIndex();
+
+    protected:
+
+      DICOMTagIndex();
+      ~DICOMTagIndex() override;
+
+      struct Entry
+      {
+        unsigned long Size = 0;
+        long ModificationTime = 0;
+        std::set<DICOMTagPath> ScannedPaths;
+        TagValuesType Values;
+        /** sequence number of the last Lookup() or Update() of the file */
+        mutable unsigned long long LastUse = 0;
+      };
+
+      typedef std::map<std::string, Entry> EntryMapType;
+
+      /** returns false if the file does not exist */
+      static bool GetFileState(const std::string& fileName, unsigned long& size, long& modificationTime);
+
+      static std::string Escape(const std::string& value);
+      static std::string Unescape(const std::string& value);
+
+      /** removes the least recently used files beyond m_MaximumNumberOfEntries */
+      void Prune();
+
+      EntryMapType m_Entries;
+      std::string m_FileName;
+      bool m_HasUnsavedChanges;
+      std::size_t m_MaximumNumberOfEntries;
+      mutable unsigned long long m_LastUse;
+
+      mutable std::mutex m_Mutex;
+
+    private:
+      DICOMTagIndex(const DICOMTagIndex&);
+      DICOMTagIndex& operator=(const DICOMTagIndex&);
+  };
+}
+
+#endif
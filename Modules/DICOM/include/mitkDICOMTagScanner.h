@@ -13,12 +13,14 @@ found in the LICENSE file.
 #ifndef mitkDICOMTagScanner_h
 #define mitkDICOMTagScanner_h
 
+#include <functional>
 #include <stack>
 #include "itkMutexLock.h"
 
 #include "mitkDICOMEnums.h"
 #include "mitkDICOMTagPath.h"
 #include "mitkDICOMTagCache.h"
+#include "mitkDICOMTagIndex.h"
 #include "mitkDICOMDatasetAccessingImageFrameInfo.h"
 
 namespace mitk
@@ -38,6 +40,9 @@ namespace mitk
     @remark When used in a process where multiple classes will access the scan
     results, care should be taken that all the tags and files of interest
     are communicated to DICOMTagScanner before requesting the results!
+
+    Implementations may scan the files on several threads, see SetNumberOfThreads().
+    The scan results do not depend on the number of threads.
   */
   class MITKDICOM_EXPORT DICOMTagScanner : public itk::Object
   {
@@ -86,8 +91,41 @@ namespace mitk
       */
       virtual DICOMTagCache::Pointer GetScanCache() const = 0;
 
+      /**
+        \brief Number of threads that scan the files.
+        0 (default) uses the default number of threads of ITK, 1 scans sequentially.
+      */
+      itkSetMacro(NumberOfThreads, unsigned int);
+      itkGetConstMacro(NumberOfThreads, unsigned int);
+
+      /**
+        \brief Index that is consulted before a file is read and that receives the values of scanned files.
+        Defaults to DICOMTagIndex::GetDefaultIndex(), nullptr scans all files.
+      */
+      itkSetObjectMacro(TagIndex, DICOMTagIndex);
+      itkGetObjectMacro(TagIndex, DICOMTagIndex);
+
     protected:
 
+      /**
+        \brief Number of partitions of the input files that are scanned in parallel.
+        Small file lists are not split, because starting threads costs more than scanning a few headers.
+      */
+      unsigned int GetNumberOfScanPartitions(std::size_t numberOfFiles) const;
+
+      /**
+        \brief Calls scanPartition(partition) for all partitions below numberOfPartitions, each on its own thread
+        as far as ITK's maximum number of threads allows (see mitk::ParallelFor()).
+        Exceptions of scanPartition are passed on to the caller after all started partitions have finished.
+      */
+      static void ScanPartitions(unsigned int numberOfPartitions,
+                                 const std::function<void(unsigned int)> &scanPartition);
+
+      /** \brief First index of the files of a partition, the files of partition p are [begin(p), begin(p+1)) */
+      static std::size_t GetPartitionBegin(std::size_t numberOfFiles,
+                                           unsigned int numberOfPartitions,
+                                           unsigned int partition);
+
       /** \brief Return active C locale */
       static std::string GetActiveLocale();
       /**
@@ -108,6 +146,9 @@ namespace mitk
 
       static itk::MutexLock::Pointer s_LocaleMutex;
 
+      unsigned int m_NumberOfThreads;
+      DICOMTagIndex::Pointer m_TagIndex;
+
       mutable std::stack<std::string> m_ReplacedCLocales;
       mutable std::stack<std::locale> m_ReplacedCinLocales;
 
@@ -19,13 +19,27 @@ found in the LICENSE file.
 
 #include <itkGDCMImageIO.h>
 
+#include <MitkDICOMExports.h>
+
+#include <functional>
+#include <mutex>
+
 /* Forward deceleration of an DCMTK class. Used in the txx but part of the interface.*/
 class OFDateTime;
 
 namespace mitk
 {
 
-class ITKDICOMSeriesReaderHelper
+/**
+  \brief Loads the pixel data of sorted DICOM files into an mitk::Image.
+
+  The geometry of a volume is determined by itk::ImageSeriesReader from the
+  first and last file, the files themselves are decoded in parallel, each by
+  its own itk::GDCMImageIO, directly into the buffer of the resulting image.
+  This matters most for compressed (e.g. JPEG 2000 or JPEG-LS) series, where
+  decoding dominates the load time.
+*/
+class MITKDICOM_EXPORT ITKDICOMSeriesReaderHelper
 {
   public:
 
@@ -36,6 +50,42 @@ class ITKDICOMSeriesReaderHelper
     typedef std::vector<std::string> StringContainer;
     typedef std::list<StringContainer> StringContainerList;
 
+    /** Called after every decoded file with the number of decoded files and the number of all files of the
+        Load() or Load3DnT() call. Calls are serialized, but may come from different threads. */
+    typedef std::function<void(unsigned int numberOfLoadedFiles, unsigned int numberOfFiles)> ProgressCallback;
+
+    /** Called during progressive loading with the number of slices of a time step that are loaded, see
+        SetSlicesLoadedCallback(). */
+    typedef std::function<void(Image* image, unsigned int timeStep, unsigned int numberOfLoadedSlices)> SlicesLoadedCallback;
+
+    ITKDICOMSeriesReaderHelper();
+
+    /** Number of threads that decode files. 0 (default) uses the default number of threads of ITK. */
+    void SetNumberOfThreads(unsigned int numberOfThreads);
+    unsigned int GetNumberOfThreads() const;
+
+    void SetProgressCallback(const ProgressCallback& callback);
+
+    /**
+      \brief Enables progressive loading, which makes the image available before all files are decoded.
+
+      The image is allocated and cleared before the files of a time step are decoded,
+      and the callback is called with 0 loaded slices. The files are then decoded in
+      chunks in their order, and the callback is called after each chunk with the
+      number of loaded slices, which are always the first slices of the time step.
+      Unloaded slices are 0. All calls come from the calling thread while no file
+      is decoded, so the callback may render the image.
+
+      With gantry tilt correction, which needs all slices of a time step, the
+      callback is only called when a time step is complete.
+    */
+    void SetSlicesLoadedCallback(const SlicesLoadedCallback& callback);
+
+    /** Number of files that are decoded between two calls of the SlicesLoadedCallback.
+        0 (default) uses twice the number of threads. */
+    void SetChunkSize(unsigned int chunkSize);
+    unsigned int GetChunkSize() const;
+
     Image::Pointer Load( const StringContainer& filenames, bool correctTilt, const GantryTiltInformation& tiltInfo );
     Image::Pointer Load3DnT( const StringContainerList& filenamesLists, bool correctTilt, const GantryTiltInformation& tiltInfo );
 
@@ -83,6 +133,33 @@ class ITKDICOMSeriesReaderHelper
     typename ImageType::Pointer
     FixUpTiltedGeometry( ImageType* input, const GantryTiltInformation& tiltInfo );
 
+    /** Returns an image with the geometry of the volume that the files form, without pixel buffer.
+        Only the headers of the first and the last file are read. */
+    template <typename ImageType>
+    typename ImageType::Pointer
+    ReadVolumeInformation( const StringContainer& filenames, itk::GDCMImageIO::Pointer& io );
+
+    /** Decodes the files into buffer, which holds the pixels of the volume the files form. If chunkRead is set,
+        the files are decoded in chunks of GetChunkSize() files and chunkRead is called with the number of
+        decoded files after each chunk. */
+    template <typename ImageType>
+    void ReadFiles( const StringContainer& filenames, typename ImageType::PixelType* buffer, std::size_t numberOfPixels,
+                    const std::function<void(std::size_t numberOfReadFiles)>& chunkRead = nullptr );
+
+    /** Decodes a time step of image progressively, see SetSlicesLoadedCallback(). */
+    template <typename ImageType>
+    void ReadFilesProgressively( const StringContainer& filenames, Image* image, unsigned int timeStep );
+
+    /** Calls readFile(i) for the files [firstFile, endFile). The very first file is read on the calling thread,
+        which also initializes the global state of GDCM, the others on several threads. Exceptions are passed on
+        to the caller. */
+    void ReadFilesInParallel( std::size_t firstFile, std::size_t endFile, const std::function<void(std::size_t)>& readFile );
+
+    /** The number of threads that ReadFilesInParallel() uses. */
+    unsigned int GetNumberOfReadingThreads() const;
+
+    void ReportReadFile();
+
     template <typename PixelType>
     Image::Pointer
     LoadDICOMByITK( const StringContainer& filenames,
@@ -97,7 +174,14 @@ class ITKDICOMSeriesReaderHelper
                         const GantryTiltInformation& tiltInfo,
                         itk::GDCMImageIO::Pointer& io);
 
+    unsigned int m_NumberOfThreads;
+    ProgressCallback m_ProgressCallback;
+    SlicesLoadedCallback m_SlicesLoadedCallback;
+    unsigned int m_ChunkSize;
 
+    std::mutex m_ProgressMutex;
+    unsigned int m_NumberOfLoadedFiles;
+    unsigned int m_NumberOfFiles;
 };
 
 }
@@ -12,27 +12,25 @@ found in the LICENSE file.
 
 #include "mitkITKDICOMSeriesReaderHelper.h"
 
+#include <mitkImageWriteAccessor.h>
+
+#include <itkImageFileReader.h>
 #include <itkImageSeriesReader.h>
 #include <itkResampleImageFilter.h>
+
+#include <algorithm>
+#include <memory>
 //#include <itkAffineTransform.h>
 //#include <itkLinearInterpolateImageFunction.h>
 //#include <itkTimeProbesCollectorBase.h>
 
 #include "dcmtk/ofstd/ofdatime.h"
 
-template <typename PixelType>
-mitk::Image::Pointer
+template <typename ImageType>
+typename ImageType::Pointer
 mitk::ITKDICOMSeriesReaderHelper
-::LoadDICOMByITK(
-    const StringContainer& filenames,
-    bool correctTilt,
-    const GantryTiltInformation& tiltInfo,
-    itk::GDCMImageIO::Pointer& io)
+::ReadVolumeInformation( const StringContainer& filenames, itk::GDCMImageIO::Pointer& io )
 {
-  /******** Normal Case, 3D (also for GDCM < 2 usable) ***************/
-  mitk::Image::Pointer image = mitk::Image::New();
-
-  typedef itk::Image<PixelType, 3> ImageType;
   typedef itk::ImageSeriesReader<ImageType> ReaderType;
 
   io = itk::GDCMImageIO::New();
@@ -46,17 +44,140 @@ mitk::ITKDICOMSeriesReaderHelper
                              // see NormalDirectionConsistencySorter.
 
   reader->SetFileNames(filenames);
-  reader->Update();
-  typename ImageType::Pointer readVolume = reader->GetOutput();
+  reader->UpdateOutputInformation(); // reads no pixel data
+
+  typename ImageType::Pointer volume = ImageType::New();
+  volume->CopyInformation(reader->GetOutput());
+  volume->SetRegions(reader->GetOutput()->GetLargestPossibleRegion());
+
+  return volume;
+}
+
+template <typename ImageType>
+void
+mitk::ITKDICOMSeriesReaderHelper
+::ReadFiles( const StringContainer& filenames, typename ImageType::PixelType* buffer, std::size_t numberOfPixels,
+             const std::function<void(std::size_t numberOfReadFiles)>& chunkRead )
+{
+  typedef itk::ImageFileReader<ImageType> FileReaderType;
+
+  // the files are stacked along the first dimension that they do not have, so each file fills a contiguous block
+  const std::size_t numberOfPixelsPerFile = numberOfPixels / filenames.size();
+
+  const std::function<void(std::size_t)> readFile = [&filenames, buffer, numberOfPixelsPerFile](std::size_t i)
+  {
+    typename FileReaderType::Pointer reader = FileReaderType::New();
+    reader->SetImageIO(itk::GDCMImageIO::New());
+    reader->SetFileName(filenames[i]);
+    reader->Update();
+
+    const ImageType* file = reader->GetOutput();
+    if (file->GetLargestPossibleRegion().GetNumberOfPixels() != numberOfPixelsPerFile)
+    {
+      mitkThrow() << "Size of file " << filenames[i] << " differs from the size of the other files of the series.";
+    }
+
+    std::copy(file->GetBufferPointer(), file->GetBufferPointer() + numberOfPixelsPerFile, buffer + i * numberOfPixelsPerFile);
+  };
+
+  if (!chunkRead)
+  {
+    this->ReadFilesInParallel(0, filenames.size(), readFile);
+    return;
+  }
+
+  const std::size_t chunkSize = std::max(this->GetChunkSize(), 1u);
+  for (std::size_t firstFile = 0; firstFile < filenames.size(); firstFile += chunkSize)
+  {
+    const std::size_t endFile = std::min(firstFile + chunkSize, filenames.size());
+    this->ReadFilesInParallel(firstFile, endFile, readFile);
+    chunkRead(endFile);
+  }
+}
+
+template <typename ImageType>
+void
+mitk::ITKDICOMSeriesReaderHelper
+::ReadFilesProgressively( const StringContainer& filenames, Image* image, unsigned int timeStep )
+{
+  typedef typename ImageType::PixelType PixelType;
+
+  const std::size_t numberOfPixels =
+    static_cast<std::size_t>(image->GetDimension(0)) * image->GetDimension(1) * image->GetDimension(2);
+  const unsigned int numberOfSlicesPerFile = image->GetDimension(2) / static_cast<unsigned int>(filenames.size());
+
+  // The files are only decoded while the write access is held. It is released just for the callback, because the
+  // callback may render the image, which needs read access. The buffer stays valid, the volume data item is owned
+  // by image.
+  std::unique_ptr<mitk::ImageWriteAccessor> accessor(new mitk::ImageWriteAccessor(image, image->GetVolumeData(timeStep)));
+  PixelType* buffer = static_cast<PixelType*>(accessor->GetData());
+  std::fill(buffer, buffer + numberOfPixels, PixelType());
+
+  const auto slicesLoaded = [this, &accessor, image, timeStep](unsigned int numberOfLoadedSlices)
+  {
+    accessor.reset();
+    m_SlicesLoadedCallback(image, timeStep, numberOfLoadedSlices);
+    accessor.reset(new mitk::ImageWriteAccessor(image, image->GetVolumeData(timeStep)));
+  };
+
+  slicesLoaded(0);
+
+  ReadFiles<ImageType>(filenames, buffer, numberOfPixels,
+    [&slicesLoaded, numberOfSlicesPerFile](std::size_t numberOfReadFiles)
+    {
+      slicesLoaded(static_cast<unsigned int>(numberOfReadFiles) * numberOfSlicesPerFile);
+    });
+}
+
+template <typename PixelType>
+mitk::Image::Pointer
+mitk::ITKDICOMSeriesReaderHelper
+::LoadDICOMByITK(
+    const StringContainer& filenames,
+    bool correctTilt,
+    const GantryTiltInformation& tiltInfo,
+    itk::GDCMImageIO::Pointer& io)
+{
+  /******** Normal Case, 3D (also for GDCM < 2 usable) ***************/
+  mitk::Image::Pointer image = mitk::Image::New();
+
+  typedef itk::Image<PixelType, 3> ImageType;
+
+  typename ImageType::Pointer readVolume = ReadVolumeInformation<ImageType>(filenames, io);
+  const std::size_t numberOfPixels = readVolume->GetLargestPossibleRegion().GetNumberOfPixels();
+
+  m_NumberOfLoadedFiles = 0;
+  m_NumberOfFiles = filenames.size();
 
   // if we detected that the images are from a tilted gantry acquisition, we need to push some pixels into the right position
   if (correctTilt)
   {
-    readVolume = FixUpTiltedGeometry( reader->GetOutput(), tiltInfo );
+    readVolume->Allocate();
+    ReadFiles<ImageType>(filenames, readVolume->GetBufferPointer(), numberOfPixels);
+
+    readVolume = FixUpTiltedGeometry( readVolume.GetPointer(), tiltInfo );
+
+    image->InitializeByItk(readVolume.GetPointer());
+    image->SetImportVolume(readVolume->GetBufferPointer());
+
+    if (m_SlicesLoadedCallback)
+    {
+      m_SlicesLoadedCallback(image, 0, image->GetDimension(2));
+    }
+  }
+  else if (m_SlicesLoadedCallback)
+  {
+    image->InitializeByItk(readVolume.GetPointer());
+    ReadFilesProgressively<ImageType>(filenames, image, 0);
   }
+  else
+  {
+    // decode straight into the image, no intermediate volume
+    image->InitializeByItk(readVolume.GetPointer());
 
-  image->InitializeByItk(readVolume.GetPointer());
-  image->SetImportVolume(readVolume->GetBufferPointer());
+    mitk::ImageWriteAccessor accessor(image, image->GetVolumeData(0));
+    ReadFiles<ImageType>(filenames, static_cast<PixelType*>(accessor.GetData()), numberOfPixels);
+  }
 
 #ifdef MBILOG_ENABLE_DEBUG
 
@@ -101,41 +222,17 @@ mitk::ITKDICOMSeriesReaderHelper
   mitk::Image::Pointer image = mitk::Image::New();
 
   typedef itk::Image<PixelType, 4> ImageType;
-  typedef itk::ImageSeriesReader<ImageType> ReaderType;
-
-  io = itk::GDCMImageIO::New();
-  typename ReaderType::Pointer reader = ReaderType::New();
-
-  reader->SetImageIO(io);
-  reader->ReverseOrderOff(); // at this point we require an order of input images so that
-                             // the direction between the origin of the first and the last slice
-                             // is the same direction as the image normals! Otherwise we might
-                             // see images upside down. Unclear whether this is a bug in MITK,
-                             // see NormalDirectionConsistencySorter.
-
-
-  unsigned int currentTimeStep = 0;
-
-#ifdef MBILOG_ENABLE_DEBUG
-  MITK_DEBUG << "Start loading timestep " << currentTimeStep;
-  MITK_DEBUG_OUTPUT_FILELIST( filenamesForTimeSteps.front() )
-#endif // MBILOG_ENABLE_DEBUG
-
-  reader->SetFileNames(filenamesForTimeSteps.front());
-  reader->Update();
-  typename ImageType::Pointer readVolume = reader->GetOutput();
 
-  // if we detected that the images are from a tilted gantry acquisition, we need to push some pixels into the right position
-  if (correctTilt)
+  m_NumberOfLoadedFiles = 0;
+  m_NumberOfFiles = 0;
+  for (const auto& filenames : filenamesForTimeSteps)
   {
-    readVolume = FixUpTiltedGeometry( reader->GetOutput(), tiltInfo );
+    m_NumberOfFiles += filenames.size();
   }
 
-  image->InitializeByItk(readVolume.GetPointer(), 1, numberOfTimeSteps);
-  image->SetImportVolume(readVolume->GetBufferPointer(), currentTimeStep++); // timestep 0
+  unsigned int currentTimeStep = 0;
 
-  // for other time-steps
-  for (auto timestepsIter = ++(filenamesForTimeSteps.cbegin()); // start with SECOND entry
+  for (auto timestepsIter = filenamesForTimeSteps.cbegin();
       timestepsIter != filenamesForTimeSteps.cend();
       ++currentTimeStep, ++timestepsIter)
   {
@@ -144,16 +241,52 @@ mitk::ITKDICOMSeriesReaderHelper
     MITK_DEBUG_OUTPUT_FILELIST( *timestepsIter )
 #endif // MBILOG_ENABLE_DEBUG
 
-    reader->SetFileNames( *timestepsIter );
-    reader->Update();
-    readVolume = reader->GetOutput();
+    typename ImageType::Pointer readVolume = ReadVolumeInformation<ImageType>(*timestepsIter, io);
+    const std::size_t numberOfPixels = readVolume->GetLargestPossibleRegion().GetNumberOfPixels();
 
+    // if we detected that the images are from a tilted gantry acquisition, we need to push some pixels into the right position
     if (correctTilt)
     {
-      readVolume = FixUpTiltedGeometry( reader->GetOutput(), tiltInfo );
-    }
+      readVolume->Allocate();
+      ReadFiles<ImageType>(*timestepsIter, readVolume->GetBufferPointer(), numberOfPixels);
+
+      readVolume = FixUpTiltedGeometry( readVolume.GetPointer(), tiltInfo );
+
+      if (0 == currentTimeStep)
+      {
+        image->InitializeByItk(readVolume.GetPointer(), 1, numberOfTimeSteps);
+      }
 
-    image->SetImportVolume(readVolume->GetBufferPointer(), currentTimeStep);
+      image->SetImportVolume(readVolume->GetBufferPointer(), currentTimeStep);
+
+      if (m_SlicesLoadedCallback)
+      {
+        m_SlicesLoadedCallback(image, currentTimeStep, image->GetDimension(2));
+      }
+    }
+    else
+    {
+      if (0 == currentTimeStep)
+      {
+        image->InitializeByItk(readVolume.GetPointer(), 1, numberOfTimeSteps);
+      }
+
+      if (numberOfPixels != static_cast<std::size_t>(image->GetDimension(0)) * image->GetDimension(1) * image->GetDimension(2))
+      {
+        mitkThrow() << "Error while loading 3D+t. Time step " << currentTimeStep << " differs in size from the first time step.";
+      }
+
+      if (m_SlicesLoadedCallback)
+      {
+        ReadFilesProgressively<ImageType>(*timestepsIter, image, currentTimeStep);
+      }
+      else
+      {
+        // decode straight into the time step of the image, no intermediate volume
+        mitk::ImageWriteAccessor accessor(image, image->GetVolumeData(currentTimeStep));
+        ReadFiles<ImageType>(*timestepsIter, static_cast<PixelType*>(accessor.GetData()), numberOfPixels);
+      }
+    }
   }
 
 #ifdef MBILOG_ENABLE_DEBUG
@@ -181,6 +314,10 @@ mitk::ITKDICOMSeriesReaderHelper
   typedef itk::ResampleImageFilter<ImageType,ImageType> ResampleFilterType;
   typename ResampleFilterType::Pointer resampler = ResampleFilterType::New();
   resampler->SetInput( input );
+  if ( m_NumberOfThreads > 0 )
+  {
+    resampler->SetNumberOfThreads( m_NumberOfThreads );
+  }
 
   /*
      Transform for a point is
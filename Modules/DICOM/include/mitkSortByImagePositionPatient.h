@@ -42,6 +42,11 @@ class MITKDICOM_EXPORT SortByImagePositionPatient : public DICOMSortCriterion
 
     double NumericDistance(const mitk::DICOMDatasetAccess* from, const mitk::DICOMDatasetAccess* to) const override;
 
+    /// \brief Distances to the world origin along the normal of the first dataset.
+    /// IsLeftBeforeRight() uses the normal of the left dataset, which is the same within the tolerated orientation differences.
+    bool ExtractSortKeys(const DICOMDatasetList& datasets, std::vector<double>& keys) const override;
+    double GetSortKeyTolerance() const override;
+
     void Print(std::ostream& os) const override;
 
     bool operator==(const DICOMSortCriterion& other) const override;
@@ -16,6 +16,8 @@ found in the LICENSE file.
 #include <dcmtk/dcmdata/dcfilefo.h>
 #include <dcmtk/dcmdata/dcpath.h>
 
+#include <vector>
+
 mitk::DICOMDCMTKTagScanner::DICOMDCMTKTagScanner()
 {
 }
@@ -98,61 +100,129 @@ mitk::DICOMTagPath DcmPathToTagPath(DcmPath * dcmpath)
   return result;
 }
 
+namespace
+{
+  /** Reads the tags of one file, returns false if the file cannot be read. */
+  bool ScanFile(const std::string& fileName,
+                const std::set<mitk::DICOMTagPath>& scannedTags,
+                DcmPathProcessor& processor,
+                mitk::DICOMTagIndex::TagValuesType& values)
+  {
+    DcmFileFormat dfile;
+    OFCondition cond = dfile.loadFile(fileName.c_str());
+    if (cond.bad())
+    {
+      MITK_ERROR << "Error when scanning for tags. Cannot open given file. File: " << fileName;
+      return false;
+    }
+
+    for (const auto& path : scannedTags)
+    {
+      std::string tagPath = mitk::DICOMTagPathToDCMTKSearchPath(path);
+      cond = processor.findOrCreatePath(dfile.getDataset(), tagPath.c_str());
+      if (cond.good())
+      {
+        OFList< DcmPath * > findings;
+        processor.getResults(findings);
+        for (const auto& finding : findings)
+        {
+          auto element = dynamic_cast<DcmElement*>(finding->back()->m_obj);
+          if (!element)
+          {
+            auto item = dynamic_cast<DcmItem*>(finding->back()->m_obj);
+            if (item)
+            {
+              element = item->getElement(finding->back()->m_itemNo);
+            }
+          }
+
+          if (element)
+          {
+            OFString value;
+            cond = element->getOFStringArray(value);
+            if (cond.good())
+            {
+              values[DcmPathToTagPath(finding)] = std::string(value.c_str());
+            }
+          }
+        }
+      }
+    }
+
+    return true;
+  }
+
+  mitk::DICOMGenericImageFrameInfo::Pointer CreateFrameInfo(const std::string& fileName,
+                                                            const mitk::DICOMTagIndex::TagValuesType& values)
+  {
+    mitk::DICOMGenericImageFrameInfo::Pointer info = mitk::DICOMGenericImageFrameInfo::New(fileName);
+
+    for (const auto& value : values)
+    {
+      info->SetTagValue(value.first, value.second);
+    }
+
+    return info;
+  }
+}
+
 void mitk::DICOMDCMTKTagScanner::Scan()
 {
   this->PushLocale();
 
   try
   {
-    DcmPathProcessor processor;
-    processor.setItemWildcardSupport(true);
+    const DICOMTagPathList scannedPaths(m_ScannedTags.cbegin(), m_ScannedTags.cend());
 
-    DICOMGenericTagCache::Pointer newCache = DICOMGenericTagCache::New();
+    // one result slot per file, so that the frames keep the order of the input files
+    std::vector<DICOMGenericImageFrameInfo::Pointer> infos(m_InputFilenames.size());
 
-    for (const auto& fileName : this->m_InputFilenames)
+    // files that are known to the tag index do not need to be read again
+    std::vector<std::size_t> filesToScan;
+    for (std::size_t i = 0; i < m_InputFilenames.size(); ++i)
     {
-      DcmFileFormat dfile;
-      OFCondition cond = dfile.loadFile(fileName.c_str());
-      if (cond.bad())
+      DICOMTagIndex::TagValuesType values;
+      if (m_TagIndex.IsNotNull() && m_TagIndex->Lookup(m_InputFilenames[i], scannedPaths, values))
       {
-        MITK_ERROR << "Error when scanning for tags. Cannot open given file. File: " << fileName;
+        infos[i] = CreateFrameInfo(m_InputFilenames[i], values);
       }
       else
       {
-        DICOMGenericImageFrameInfo::Pointer info = DICOMGenericImageFrameInfo::New(fileName);
+        filesToScan.push_back(i);
+      }
+    }
+
+    const unsigned int numberOfPartitions = this->GetNumberOfScanPartitions(filesToScan.size());
+
+    ScanPartitions(numberOfPartitions, [this, numberOfPartitions, &filesToScan, &scannedPaths, &infos](unsigned int partition) {
+      // the path processor keeps the results of the last search, so every partition needs its own
+      DcmPathProcessor processor;
+      processor.setItemWildcardSupport(true);
+
+      const auto end = GetPartitionBegin(filesToScan.size(), numberOfPartitions, partition + 1);
+      for (auto i = GetPartitionBegin(filesToScan.size(), numberOfPartitions, partition); i < end; ++i)
+      {
+        const std::string& fileName = m_InputFilenames[filesToScan[i]];
 
-        for (const auto& path : this->m_ScannedTags)
+        DICOMTagIndex::TagValuesType values;
+        if (ScanFile(fileName, m_ScannedTags, processor, values))
         {
-          std::string tagPath = DICOMTagPathToDCMTKSearchPath(path);
-          cond = processor.findOrCreatePath(dfile.getDataset(), tagPath.c_str());
-          if (cond.good())
+          infos[filesToScan[i]] = CreateFrameInfo(fileName, values);
+
+          if (m_TagIndex.IsNotNull())
           {
-            OFList< DcmPath * > findings;
-            processor.getResults(findings);
-            for (const auto& finding : findings)
-            {
-              auto element = dynamic_cast<DcmElement*>(finding->back()->m_obj);
-              if (!element)
-              {
-                auto item = dynamic_cast<DcmItem*>(finding->back()->m_obj);
-                if (item)
-                {
-                  element = item->getElement(finding->back()->m_itemNo);
-                }
-              }
-
-              if (element)
-              {
-                OFString value;
-                cond = element->getOFStringArray(value);
-                if (cond.good())
-                {
-                  info->SetTagValue(DcmPathToTagPath(finding), std::string(value.c_str()));
-                }
-              }
-            }
+            m_TagIndex->Update(fileName, scannedPaths, values);
           }
         }
+      }
+    });
+
+    DICOMGenericTagCache::Pointer newCache = DICOMGenericTagCache::New();
+
+    for (const auto& info : infos)
+    {
+      if (info.IsNotNull())
+      {
         newCache->AddFrameInfo(info);
       }
     }
@@ -82,18 +82,56 @@ mitk::DICOMDatasetAccessingImageFrameList mitk::DICOMGDCMTagCache::GetFrameInfoL
 
 void
 mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles)
+{
+  this->InitCache(scannedTags,
+                  inputFiles,
+                  std::vector<std::shared_ptr<gdcm::Scanner>>(1, scanner),
+                  std::map<std::string, DICOMTagIndex::TagValuesType>());
+}
+
+void
+mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags,
+                                   const StringList& inputFiles,
+                                   const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners,
+                                   const std::map<std::string, DICOMTagIndex::TagValuesType>& indexedValues)
 {
   m_ScannedTags = scannedTags;
   m_InputFilenames = inputFiles;
-  m_Scanner = scanner;
+  m_Scanners = scanners;
+  m_Scanner = scanners.empty() ? nullptr : scanners.front();
+  m_IndexedValues.clear();
 
   m_ScanResult.clear();
   m_ScanResult.reserve(m_InputFilenames.size());
 
   for (auto inputIter = m_InputFilenames.cbegin(); inputIter != m_InputFilenames.cend(); ++inputIter)
   {
-    m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(*inputIter, 0),
-      m_Scanner->GetMapping(inputIter->c_str())).GetPointer());
+    gdcm::Scanner::TagToValue mapping;
+
+    const auto indexed = indexedValues.find(*inputIter);
+    if (indexed != indexedValues.cend())
+    {
+      for (const auto& value : indexed->second)
+      {
+        const DICOMTag& tag = value.first.GetFirstNode().tag;
+        m_IndexedValues.push_back(value.second);
+        mapping[gdcm::Tag(tag.GetGroup(), tag.GetElement())] = m_IndexedValues.back().c_str();
+      }
+    }
+    else
+    {
+      // files that could not be read are known to no scanner and get an empty mapping
+      for (const auto& scanner : m_Scanners)
+      {
+        if (scanner->IsKey(inputIter->c_str()))
+        {
+          mapping = scanner->GetMapping(inputIter->c_str());
+          break;
+        }
+      }
+    }
+
+    m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(*inputIter, 0), mapping).GetPointer());
   }
 }
 
@@ -16,9 +16,10 @@ found in the LICENSE file.
 
 #include <gdcmScanner.h>
 
+#include <map>
+
 mitk::DICOMGDCMTagScanner::DICOMGDCMTagScanner()
 {
-  m_GDCMScanner = std::make_shared<gdcm::Scanner>();
 }
 
 mitk::DICOMGDCMTagScanner::~DICOMGDCMTagScanner()
@@ -40,9 +41,7 @@ mitk::DICOMDatasetFinding mitk::DICOMGDCMTagScanner::GetTagValue( DICOMImageFram
 
 void mitk::DICOMGDCMTagScanner::AddTag( const DICOMTag& tag )
 {
-  m_ScannedTags.insert( tag );
-  m_GDCMScanner->AddTag(
-    gdcm::Tag( tag.GetGroup(), tag.GetElement() ) ); // also a set, duplicate calls to AddTag don't hurt
+  m_ScannedTags.insert( tag ); // a set, duplicate calls to AddTag don't hurt
 }
 
 void mitk::DICOMGDCMTagScanner::AddTags( const DICOMTagList& tags )
@@ -93,10 +92,79 @@ void mitk::DICOMGDCMTagScanner::SetInputFiles( const StringList& filenames )
 void mitk::DICOMGDCMTagScanner::Scan()
 {
   // TODO integrate push/pop locale??
-  m_GDCMScanner->Scan( m_InputFilenames );
+  DICOMTagPathList scannedPaths;
+  for (const auto& tag : m_ScannedTags)
+  {
+    scannedPaths.push_back(DICOMTagPath(tag));
+  }
+
+  // files that are known to the tag index do not need to be read again
+  std::map<std::string, DICOMTagIndex::TagValuesType> indexedValues;
+  StringList filesToScan;
+
+  for (const auto& fileName : m_InputFilenames)
+  {
+    DICOMTagIndex::TagValuesType values;
+    if (m_TagIndex.IsNotNull() && m_TagIndex->Lookup(fileName, scannedPaths, values))
+    {
+      indexedValues[fileName] = values;
+    }
+    else
+    {
+      filesToScan.push_back(fileName);
+    }
+  }
+
+  const unsigned int numberOfPartitions = this->GetNumberOfScanPartitions(filesToScan.size());
+
+  std::vector<std::shared_ptr<gdcm::Scanner>> scanners(numberOfPartitions);
+  std::vector<StringList> partitionFilenames(numberOfPartitions);
+
+  for (unsigned int partition = 0; partition < numberOfPartitions; ++partition)
+  {
+    const auto begin = GetPartitionBegin(filesToScan.size(), numberOfPartitions, partition);
+    const auto end = GetPartitionBegin(filesToScan.size(), numberOfPartitions, partition + 1);
+    partitionFilenames[partition].assign(filesToScan.cbegin() + begin, filesToScan.cbegin() + end);
+
+    scanners[partition] = std::make_shared<gdcm::Scanner>();
+    for (const auto& tag : m_ScannedTags)
+    {
+      scanners[partition]->AddTag(gdcm::Tag(tag.GetGroup(), tag.GetElement()));
+    }
+  }
+
+  // every partition has its own scanner, the scanners do not share any state
+  ScanPartitions(numberOfPartitions, [&scanners, &partitionFilenames](unsigned int partition) {
+    if (!partitionFilenames[partition].empty())
+    {
+      scanners[partition]->Scan(partitionFilenames[partition]);
+    }
+  });
+
+  if (m_TagIndex.IsNotNull() && !filesToScan.empty())
+  {
+    for (unsigned int partition = 0; partition < numberOfPartitions; ++partition)
+    {
+      for (const auto& fileName : partitionFilenames[partition])
+      {
+        if (!scanners[partition]->IsKey(fileName.c_str()))
+        {
+          continue; // not readable, maybe next time
+        }
+
+        DICOMTagIndex::TagValuesType values;
+        for (const auto& value : scanners[partition]->GetMapping(fileName.c_str()))
+        {
+          values[DICOMTagPath(value.first.GetGroup(), value.first.GetElement())] =
+            value.second != nullptr ? value.second : "";
+        }
+        m_TagIndex->Update(fileName, scannedPaths, values);
+      }
+    }
+  }
 
   DICOMGDCMTagCache::Pointer newCache = DICOMGDCMTagCache::New();
-  newCache->InitCache(m_ScannedTags, m_GDCMScanner, m_InputFilenames);
+  newCache->InitCache(m_ScannedTags, m_InputFilenames, scanners, indexedValues);
 
   m_Cache = newCache;
 }
@@ -28,6 +28,8 @@ mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( unsigned int decimalPl
 : DICOMFileReader()
 , m_FixTiltByShearing(m_DefaultFixTiltByShearing)
 , m_SimpleVolumeReading( simpleVolumeImport )
+, m_ProgressiveLoading( false )
+, m_ProgressiveLoadingChunkSize( 0 )
 , m_DecimalPlacesForOrientation( decimalPlacesForOrientation )
 , m_ExternalCache(false)
 {
@@ -38,6 +40,8 @@ mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( unsigned int decimalPl
 mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( const DICOMITKSeriesGDCMReader& other )
 : DICOMFileReader( other )
 , m_FixTiltByShearing( other.m_FixTiltByShearing)
+, m_ProgressiveLoading( other.m_ProgressiveLoading )
+, m_ProgressiveLoadingChunkSize( other.m_ProgressiveLoadingChunkSize )
 , m_SortingResultInProgress( other.m_SortingResultInProgress )
 , m_Sorter( other.m_Sorter )
 , m_EquiDistantBlocksSorter( other.m_EquiDistantBlocksSorter->Clone() )
@@ -61,6 +65,8 @@ mitk::DICOMITKSeriesGDCMReader& mitk::DICOMITKSeriesGDCMReader::
   {
     DICOMFileReader::operator                =( other );
     this->m_FixTiltByShearing                = other.m_FixTiltByShearing;
+    this->m_ProgressiveLoading               = other.m_ProgressiveLoading;
+    this->m_ProgressiveLoadingChunkSize      = other.m_ProgressiveLoadingChunkSize;
     this->m_SortingResultInProgress          = other.m_SortingResultInProgress;
     this->m_Sorter                           = other.m_Sorter; // TODO should clone the list items
     this->m_EquiDistantBlocksSorter          = other.m_EquiDistantBlocksSorter->Clone();
@@ -119,6 +125,28 @@ bool mitk::DICOMITKSeriesGDCMReader::GetFixTiltByShearing() const
   return m_FixTiltByShearing;
 }
 
+void mitk::DICOMITKSeriesGDCMReader::SetProgressiveLoading( bool on )
+{
+  this->Modified();
+  m_ProgressiveLoading = on;
+}
+
+bool mitk::DICOMITKSeriesGDCMReader::GetProgressiveLoading() const
+{
+  return m_ProgressiveLoading;
+}
+
+void mitk::DICOMITKSeriesGDCMReader::SetProgressiveLoadingChunkSize( unsigned int numberOfFiles )
+{
+  this->Modified();
+  m_ProgressiveLoadingChunkSize = numberOfFiles;
+}
+
+unsigned int mitk::DICOMITKSeriesGDCMReader::GetProgressiveLoadingChunkSize() const
+{
+  return m_ProgressiveLoadingChunkSize;
+}
+
 void mitk::DICOMITKSeriesGDCMReader::SetAcceptTwoSlicesGroups( bool accept ) const
 {
   this->Modified();
@@ -447,15 +475,19 @@ bool mitk::DICOMITKSeriesGDCMReader::LoadMitkImageForImageBlockDescriptor(
   }
 
   mitk::ITKDICOMSeriesReaderHelper helper;
+  this->ConfigureHelperForImageBlockDescriptor( helper, block );
+
   bool success( true );
   try
   {
     mitk::Image::Pointer mitkImage = helper.Load( filenames, m_FixTiltByShearing && hasTilt, tiltInfo );
     block.SetMitkImage( mitkImage );
+    this->SetAllSlicesLoaded( block );
   }
   catch ( const std::exception& e )
   {
     success = false;
+    block.SetMitkImage( nullptr ); // progressive loading might have set a partial image
     MITK_ERROR << "Exception during image loading: " << e.what();
   }
 
@@ -464,6 +496,44 @@ bool mitk::DICOMITKSeriesGDCMReader::LoadMitkImageForImageBlockDescriptor(
   return success;
 }
 
+void mitk::DICOMITKSeriesGDCMReader::ConfigureHelperForImageBlockDescriptor( ITKDICOMSeriesReaderHelper& helper,
+                                                                            DICOMImageBlockDescriptor& block ) const
+{
+  for ( unsigned int frame = 0; frame < block.GetImageFrameList().size(); ++frame )
+  {
+    block.SetSliceIsLoaded( frame, false );
+  }
+
+  if ( !m_ProgressiveLoading )
+  {
+    return;
+  }
+
+  helper.SetChunkSize( m_ProgressiveLoadingChunkSize );
+  helper.SetSlicesLoadedCallback(
+    [this, &block]( Image* image, unsigned int timeStep, unsigned int numberOfLoadedSlices )
+    {
+      // the first call comes right after the allocation, from then on observers find the image at the output
+      block.SetMitkImage( image );
+
+      const unsigned int numberOfFramesPerTimeStep = block.GetNumberOfFramesPerTimeStep();
+      for ( unsigned int slice = 0; slice < numberOfLoadedSlices && slice < numberOfFramesPerTimeStep; ++slice )
+      {
+        block.SetSliceIsLoaded( timeStep * numberOfFramesPerTimeStep + slice, true );
+      }
+
+      image->Modified();
+      this->InvokeEvent( DICOMImageBlockSlicesLoadedEvent( &block, timeStep, numberOfLoadedSlices ) );
+    } );
+}
+
+void mitk::DICOMITKSeriesGDCMReader::SetAllSlicesLoaded( DICOMImageBlockDescriptor& block ) const
+{
+  for ( unsigned int frame = 0; frame < block.GetImageFrameList().size(); ++frame )
+  {
+    block.SetSliceIsLoaded( frame, true );
+  }
+}
 
 bool mitk::DICOMITKSeriesGDCMReader::LoadMitkImageForOutput( unsigned int o )
 {
@@ -146,6 +146,22 @@ mitk::DICOMSortByTag
   }
 }
 
+bool
+mitk::DICOMSortByTag
+::ExtractSortKeys(const DICOMDatasetList& datasets, std::vector<double>& keys) const
+{
+  // same conversion as NumericCompare(), which never falls back to StringCompare() because atof() does not throw
+  keys.clear();
+  keys.reserve(datasets.size());
+  for (const auto* dataset : datasets)
+  {
+    assert(dataset);
+    keys.push_back(OFStandard::atof(dataset->GetTagValueAsString(m_Tag).value.c_str()));
+  }
+
+  return true;
+}
+
 double
 mitk::DICOMSortByTag
 ::NumericDistance(const mitk::DICOMDatasetAccess* from, const mitk::DICOMDatasetAccess* to) const
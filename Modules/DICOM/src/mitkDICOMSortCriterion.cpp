@@ -80,3 +80,17 @@ mitk::DICOMSortCriterion
     return (void*)left < (void*)right;
   }
 }
+
+bool
+mitk::DICOMSortCriterion
+::ExtractSortKeys(const DICOMDatasetList& /*datasets*/, std::vector<double>& /*keys*/) const
+{
+  return false;
+}
+
+double
+mitk::DICOMSortCriterion
+::GetSortKeyTolerance() const
+{
+  return 0.0;
+}
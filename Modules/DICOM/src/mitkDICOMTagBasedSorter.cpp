@@ -14,6 +14,8 @@ found in the LICENSE file.
 
 #include <algorithm>
 #include <iomanip>
+#include <numeric>
+#include <unordered_map>
 
 mitk::DICOMTagBasedSorter::CutDecimalPlaces
 ::CutDecimalPlaces(unsigned int precision)
@@ -318,40 +320,40 @@ mitk::DICOMTagBasedSorter
 
 std::string
 mitk::DICOMTagBasedSorter
-::BuildGroupID( DICOMDatasetAccess* dataset )
+::BuildGroupID( DICOMDatasetAccess* dataset ) const
 {
   // just concatenate all tag values
   assert(dataset);
-  std::stringstream groupID;
-  groupID << "g";
+  std::string groupID("g");
   for (auto tagIter = m_DistinguishingTags.cbegin();
        tagIter != m_DistinguishingTags.cend();
        ++tagIter)
   {
-    groupID << tagIter->GetGroup() << tagIter->GetElement(); // make group/element part of the id to cover empty tags
+    groupID += std::to_string(tagIter->GetGroup()) + std::to_string(tagIter->GetElement()); // make group/element part of the id to cover empty tags
     DICOMDatasetFinding rawTagValue = dataset->GetTagValueAsString(*tagIter);
-    std::string processedTagValue;
-    if ( m_TagValueProcessor[*tagIter] != nullptr && rawTagValue.isValid)
+    const auto processor = m_TagValueProcessor.find(*tagIter);
+    if ( processor != m_TagValueProcessor.cend() && processor->second != nullptr && rawTagValue.isValid)
     {
-      processedTagValue = (*m_TagValueProcessor[*tagIter])(rawTagValue.value);
+      groupID += (*processor->second)(rawTagValue.value);
     }
     else
     {
-      processedTagValue = rawTagValue.value;
+      groupID += rawTagValue.value;
     }
-    groupID << processedTagValue;
   }
   // shorten ID?
-  return groupID.str();
+  return groupID;
 }
 
 mitk::DICOMTagBasedSorter::GroupIDToListType
 mitk::DICOMTagBasedSorter
 ::SplitInputGroups()
 {
-  DICOMDatasetList input = GetInput(); // copy
+  const DICOMDatasetList& input = GetInput();
 
-  GroupIDToListType listForGroupID;
+  // Hashing the long group IDs is cheaper than ordering them for every dataset,
+  // the ordered result is built once per group.
+  std::unordered_map<std::string, DICOMDatasetList> datasetsForGroupID;
 
   for (auto dsIter = input.cbegin();
        dsIter != input.cend();
@@ -362,7 +364,13 @@ mitk::DICOMTagBasedSorter
 
     std::string groupID = this->BuildGroupID( dataset );
     MITK_DEBUG << "Group ID for for " << dataset->GetFilenameIfAvailable() << ": " << groupID;
-    listForGroupID[groupID].push_back(dataset);
+    datasetsForGroupID[groupID].push_back(dataset);
+  }
+
+  GroupIDToListType listForGroupID;
+  for (auto& group : datasetsForGroupID)
+  {
+    listForGroupID[group.first].swap(group.second);
   }
 
   MITK_DEBUG << "After tag based splitting: " << listForGroupID.size() << " groups";
@@ -413,7 +421,7 @@ mitk::DICOMTagBasedSorter
 #endif // #ifdef MBILOG_ENABLE_DEBUG
 
 
-      std::sort( dsList.begin(), dsList.end(), ParameterizedDatasetSort( m_SortCriterion ) );
+      this->SortDatasets( dsList );
 
 #ifdef MBILOG_ENABLE_DEBUG
       MITK_DEBUG << "   --------------------------------------------------------------------------------";
@@ -534,25 +542,26 @@ mitk::DICOMTagBasedSorter
       firstSlices.push_back(gIter->second.front());
     }
 
+    // one dataset per group, and the groups may differ in the tags that sort keys assume to be equal within a group
     std::sort( firstSlices.begin(), firstSlices.end(), ParameterizedDatasetSort( m_SortCriterion ) );
 
+    std::unordered_map<const DICOMDatasetAccess*, const DICOMDatasetList*> groupForFirstSlice;
+    for (auto gIter = consecutiveGroups.cbegin();
+         gIter != consecutiveGroups.cend();
+         ++gIter)
+    {
+      groupForFirstSlice[gIter->second.front()] = &gIter->second;
+    }
+
     GroupIDToListType sortedResultBlocks;
     unsigned int groupKeyValue(0);
     for (auto firstSlice = firstSlices.cbegin();
          firstSlice != firstSlices.cend();
-         ++firstSlice)
+         ++groupKeyValue, ++firstSlice)
     {
-      for (auto gIter = consecutiveGroups.cbegin();
-           gIter != consecutiveGroups.cend();
-           ++groupKeyValue, ++gIter)
-      {
-        if (gIter->second.front() == *firstSlice)
-        {
-          std::stringstream groupKey;
-          groupKey << std::setfill('0') << std::setw(6) << groupKeyValue; // try more than 999,999 groups and you are doomed (your application already is)
-          sortedResultBlocks[groupKey.str()] = gIter->second;
-        }
-      }
+      std::stringstream groupKey;
+      groupKey << std::setfill('0') << std::setw(6) << groupKeyValue; // try more than 999,999 groups and you are doomed (your application already is)
+      sortedResultBlocks[groupKey.str()] = *groupForFirstSlice[*firstSlice];
     }
 
     groups = sortedResultBlocks;
@@ -578,6 +587,59 @@ mitk::DICOMTagBasedSorter
   return groups;
 }
 
+void
+mitk::DICOMTagBasedSorter
+::SortDatasets(DICOMDatasetList& datasets) const
+{
+  if (m_SortCriterion.IsNull())
+  {
+    return;
+  }
+
+  // one list of keys per criterion of the chain, see DICOMSortCriterion::ExtractSortKeys()
+  std::vector<std::vector<double>> keys;
+  std::vector<double> tolerances;
+  for (const DICOMSortCriterion* criterion = m_SortCriterion.GetPointer();
+       criterion != nullptr;
+       criterion = criterion->GetSecondaryCriterion().GetPointer())
+  {
+    keys.emplace_back();
+    if (!criterion->ExtractSortKeys(datasets, keys.back()) || keys.back().size() != datasets.size())
+    {
+      std::sort( datasets.begin(), datasets.end(), ParameterizedDatasetSort( m_SortCriterion ) );
+      return;
+    }
+    tolerances.push_back(criterion->GetSortKeyTolerance());
+  }
+
+  // sort indices, so that comparisons find the keys of a dataset without any lookup
+  std::vector<std::size_t> order(datasets.size());
+  std::iota(order.begin(), order.end(), 0);
+
+  std::sort(order.begin(), order.end(), [&datasets, &keys, &tolerances](std::size_t left, std::size_t right)
+  {
+    for (std::size_t level = 0; level < keys.size(); ++level)
+    {
+      const double leftKey = keys[level][left];
+      const double rightKey = keys[level][right];
+      if (fabs(leftKey - rightKey) > tolerances[level])
+      {
+        return leftKey < rightKey;
+      }
+    }
+
+    return (void*)datasets[left] < (void*)datasets[right]; // as DICOMSortCriterion::NextLevelIsLeftBeforeRight()
+  });
+
+  DICOMDatasetList sortedDatasets;
+  sortedDatasets.reserve(datasets.size());
+  for (const std::size_t index : order)
+  {
+    sortedDatasets.push_back(datasets[index]);
+  }
+  datasets.swap(sortedDatasets);
+}
+
 mitk::DICOMTagBasedSorter::ParameterizedDatasetSort
 ::ParameterizedDatasetSort(DICOMSortCriterion::ConstPointer criterion)
 :m_SortCriterion(criterion)
@@ -0,0 +1,390 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMTagIndex.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkLogMacros.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+  const char* const IndexFileHeader = "MITK DICOM tag index 2";
+
+  std::mutex s_DefaultIndexMutex;
+  mitk::DICOMTagIndex::Pointer s_DefaultIndex;
+}
+
+mitk::DICOMTagIndex::DICOMTagIndex()
+  : m_HasUnsavedChanges(false), m_MaximumNumberOfEntries(100000), m_LastUse(0)
+{
+}
+
+mitk::DICOMTagIndex::~DICOMTagIndex()
+{
+}
+
+void mitk::DICOMTagIndex::SetFileName(const std::string& fileName)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_FileName = fileName;
+}
+
+std::string mitk::DICOMTagIndex::GetFileName() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_FileName;
+}
+
+void mitk::DICOMTagIndex::SetMaximumNumberOfEntries(std::size_t maximumNumberOfEntries)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_MaximumNumberOfEntries = maximumNumberOfEntries;
+}
+
+std::size_t mitk::DICOMTagIndex::GetMaximumNumberOfEntries() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumNumberOfEntries;
+}
+
+bool mitk::DICOMTagIndex::GetFileState(const std::string& fileName, unsigned long& size, long& modificationTime)
+{
+  if (!itksys::SystemTools::FileExists(fileName, true))
+  {
+    return false;
+  }
+
+  size = itksys::SystemTools::FileLength(fileName);
+  modificationTime = itksys::SystemTools::ModifiedTime(fileName);
+  return true;
+}
+
+std::string mitk::DICOMTagIndex::Escape(const std::string& value)
+{
+  std::string result;
+  result.reserve(value.size());
+
+  for (const char c : value)
+  {
+    switch (c)
+    {
+      case '\\': result += "\\\\"; break;
+      case '\t': result += "\\t"; break;
+      case '\n': result += "\\n"; break;
+      case '\r': result += "\\r"; break;
+      default: result += c;
+    }
+  }
+
+  return result;
+}
+
+std::string mitk::DICOMTagIndex::Unescape(const std::string& value)
+{
+  std::string result;
+  result.reserve(value.size());
+
+  for (std::string::size_type i = 0; i < value.size(); ++i)
+  {
+    if (value[i] == '\\' && i + 1 < value.size())
+    {
+      switch (value[++i])
+      {
+        case 't': result += '\t'; break;
+        case 'n': result += '\n'; break;
+        case 'r': result += '\r'; break;
+        default: result += value[i];
+      }
+    }
+    else
+    {
+      result += value[i];
+    }
+  }
+
+  return result;
+}
+
+void mitk::DICOMTagIndex::Load()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_Entries.clear();
+  m_HasUnsavedChanges = false;
+  m_LastUse = 0;
+
+  std::ifstream file(m_FileName.c_str());
+  if (!file.is_open())
+  {
+    return;
+  }
+
+  std::string line;
+  if (!std::getline(file, line) || line != IndexFileHeader)
+  {
+    MITK_WARN << "Ignoring DICOM tag index " << m_FileName << " of unknown format.";
+    return;
+  }
+
+  // the file consists of one "F" line per file, followed by its scanned paths ("S") and values ("V")
+  Entry* entry = nullptr;
+  while (std::getline(file, line))
+  {
+    std::istringstream fields(line);
+    std::string type;
+    std::getline(fields, type, '\t');
+
+    if (type == "F")
+    {
+      std::string size, modificationTime, lastUse, fileName;
+      if (std::getline(fields, size, '\t') && std::getline(fields, modificationTime, '\t') &&
+          std::getline(fields, lastUse, '\t') && std::getline(fields, fileName))
+      {
+        try
+        {
+          entry = &m_Entries[Unescape(fileName)];
+          entry->Size = std::stoul(size);
+          entry->ModificationTime = std::stol(modificationTime);
+          entry->LastUse = std::stoull(lastUse);
+          m_LastUse = std::max(m_LastUse, entry->LastUse);
+          continue;
+        }
+        catch (const std::logic_error&)
+        {
+          // invalid number, handled below
+        }
+      }
+    }
+    else if (type == "S" && entry != nullptr)
+    {
+      std::string path;
+      if (std::getline(fields, path))
+      {
+        entry->ScannedPaths.insert(PropertyNameToDICOMTagPath(path));
+        continue;
+      }
+    }
+    else if (type == "V" && entry != nullptr)
+    {
+      std::string path, value;
+      if (std::getline(fields, path, '\t'))
+      {
+        std::getline(fields, value); // empty values are valid
+        entry->Values[PropertyNameToDICOMTagPath(path)] = Unescape(value);
+        continue;
+      }
+    }
+
+    MITK_WARN << "Ignoring invalid DICOM tag index " << m_FileName << ".";
+    m_Entries.clear();
+    return;
+  }
+}
+
+void mitk::DICOMTagIndex::Save()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  if (!m_HasUnsavedChanges || m_FileName.empty())
+  {
+    return;
+  }
+
+  this->Prune();
+
+  // write to a temporary file first, so that a concurrent Load() never reads a partial index
+  const std::string temporaryFileName = m_FileName + ".tmp";
+
+  {
+    std::ofstream file(temporaryFileName.c_str(), std::ios::trunc);
+    if (!file.is_open())
+    {
+      mitkThrow() << "Cannot write DICOM tag index " << temporaryFileName;
+    }
+
+    file << IndexFileHeader << '\n';
+
+    for (const auto& entry : m_Entries)
+    {
+      file << "F\t" << entry.second.Size << '\t' << entry.second.ModificationTime << '\t' << entry.second.LastUse << '\t'
+           << Escape(entry.first) << '\n';
+
+      for (const auto& path : entry.second.ScannedPaths)
+      {
+        file << "S\t" << DICOMTagPathToPropertyName(path) << '\n';
+      }
+
+      for (const auto& value : entry.second.Values)
+      {
+        file << "V\t" << DICOMTagPathToPropertyName(value.first) << '\t' << Escape(value.second) << '\n';
+      }
+    }
+
+    if (!file.good())
+    {
+      mitkThrow() << "Cannot write DICOM tag index " << temporaryFileName;
+    }
+  }
+
+  itksys::SystemTools::RemoveFile(m_FileName);
+  if (!itksys::SystemTools::RenameFile(temporaryFileName.c_str(), m_FileName.c_str()))
+  {
+    mitkThrow() << "Cannot write DICOM tag index " << m_FileName;
+  }
+
+  m_HasUnsavedChanges = false;
+}
+
+bool mitk::DICOMTagIndex::Lookup(const std::string& fileName, const DICOMTagPathList& paths, TagValuesType& values) const
+{
+  unsigned long size = 0;
+  long modificationTime = 0;
+  if (!GetFileState(fileName, size, modificationTime))
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  const auto entry = m_Entries.find(fileName);
+  if (entry == m_Entries.cend() || entry->second.Size != size || entry->second.ModificationTime != modificationTime)
+  {
+    return false;
+  }
+
+  for (const auto& path : paths)
+  {
+    if (entry->second.ScannedPaths.find(path) == entry->second.ScannedPaths.cend())
+    {
+      return false;
+    }
+  }
+
+  entry->second.LastUse = ++m_LastUse;
+
+  values.clear();
+  for (const auto& value : entry->second.Values)
+  {
+    for (const auto& path : paths)
+    {
+      if (path.Equals(value.first))
+      {
+        values.insert(value);
+        break;
+      }
+    }
+  }
+
+  return true;
+}
+
+void mitk::DICOMTagIndex::Update(const std::string& fileName, const DICOMTagPathList& paths, const TagValuesType& values)
+{
+  unsigned long size = 0;
+  long modificationTime = 0;
+  if (!GetFileState(fileName, size, modificationTime))
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  Entry& entry = m_Entries[fileName];
+  if (entry.Size != size || entry.ModificationTime != modificationTime)
+  {
+    // new or changed file
+    entry.Size = size;
+    entry.ModificationTime = modificationTime;
+    entry.ScannedPaths.clear();
+    entry.Values.clear();
+  }
+
+  entry.LastUse = ++m_LastUse;
+  entry.ScannedPaths.insert(paths.cbegin(), paths.cend());
+  for (const auto& value : values)
+  {
+    entry.Values[value.first] = value.second;
+  }
+
+  m_HasUnsavedChanges = true;
+}
+
+void mitk::DICOMTagIndex::Prune()
+{
+  // missing or changed files are not looked up on disk here, Lookup() never answers for them and
+  // they are dropped as soon as they are the least recently used ones
+  if (m_Entries.size() <= m_MaximumNumberOfEntries)
+  {
+    return;
+  }
+
+  // keep the most recently used entries
+  std::vector<unsigned long long> lastUses;
+  lastUses.reserve(m_Entries.size());
+  for (const auto& entry : m_Entries)
+  {
+    lastUses.push_back(entry.second.LastUse);
+  }
+
+  const auto numberOfEntriesToRemove = m_Entries.size() - m_MaximumNumberOfEntries;
+  std::nth_element(lastUses.begin(), lastUses.begin() + numberOfEntriesToRemove, lastUses.end());
+  const unsigned long long oldestKeptUse = lastUses[numberOfEntriesToRemove];
+
+  for (auto entry = m_Entries.begin(); entry != m_Entries.end();)
+  {
+    if (entry->second.LastUse < oldestKeptUse)
+    {
+      entry = m_Entries.erase(entry);
+    }
+    else
+    {
+      ++entry;
+    }
+  }
+}
+
+void mitk::DICOMTagIndex::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  if (!m_Entries.empty())
+  {
+    m_Entries.clear();
+    m_HasUnsavedChanges = true;
+  }
+}
+
+std::size_t mitk::DICOMTagIndex::GetNumberOfEntries() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Entries.size();
+}
+
+void mitk::DICOMTagIndex::SetDefaultIndex(DICOMTagIndex* index)
+{
+  std::lock_guard<std::mutex> lock(s_DefaultIndexMutex);
+  s_DefaultIndex = index;
+}
+
+mitk::DICOMTagIndex::Pointer mitk::DICOMTagIndex::GetDefaultIndex()
+{
+  std::lock_guard<std::mutex> lock(s_DefaultIndexMutex);
+  return s_DefaultIndex;
+}
@@ -12,9 +12,15 @@ found in the LICENSE file.
 
 #include "mitkDICOMTagScanner.h"
 
+#include <mitkParallelFor.h>
+
+#include <itkMultiThreader.h>
+
+#include <algorithm>
+
 itk::MutexLock::Pointer mitk::DICOMTagScanner::s_LocaleMutex = itk::MutexLock::New();
 
-mitk::DICOMTagScanner::DICOMTagScanner()
+mitk::DICOMTagScanner::DICOMTagScanner() : m_NumberOfThreads(0), m_TagIndex(DICOMTagIndex::GetDefaultIndex())
 {
 }
 
@@ -66,6 +72,34 @@ void mitk::DICOMTagScanner::PopLocale() const
   s_LocaleMutex->Unlock();
 }
 
+unsigned int mitk::DICOMTagScanner::GetNumberOfScanPartitions(std::size_t numberOfFiles) const
+{
+  // scanning less files than this is faster than starting a thread
+  const std::size_t minimumFilesPerPartition = 16;
+
+  const unsigned int numberOfThreads =
+    0 == m_NumberOfThreads ? itk::MultiThreader::GetGlobalDefaultNumberOfThreads() : m_NumberOfThreads;
+
+  return static_cast<unsigned int>(
+    std::max<std::size_t>(1, std::min<std::size_t>(numberOfThreads, numberOfFiles / minimumFilesPerPartition)));
+}
+
+void mitk::DICOMTagScanner::ScanPartitions(unsigned int numberOfPartitions,
+                                           const std::function<void(unsigned int)> &scanPartition)
+{
+  // one thread per partition, as far as ITK's maximum number of threads allows
+  mitk::ParallelFor(0, numberOfPartitions, [&scanPartition](std::size_t partition) {
+    scanPartition(static_cast<unsigned int>(partition));
+  }, numberOfPartitions);
+}
+
+std::size_t mitk::DICOMTagScanner::GetPartitionBegin(std::size_t numberOfFiles,
+                                                     unsigned int numberOfPartitions,
+                                                     unsigned int partition)
+{
+  return numberOfFiles * partition / numberOfPartitions;
+}
+
 std::string mitk::DICOMTagScanner::GetActiveLocale()
 {
   return setlocale(LC_NUMERIC, nullptr);
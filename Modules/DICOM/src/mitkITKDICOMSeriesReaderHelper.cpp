@@ -32,11 +32,91 @@ found in the LICENSE file.
 
 #include "dcmtk/dcmdata/dcvrda.h"
 
+#include <mitkParallelFor.h>
+
+#include <itkMultiThreader.h>
+
+#include <algorithm>
 
 const mitk::DICOMTag mitk::ITKDICOMSeriesReaderHelper::AcquisitionDateTag = mitk::DICOMTag( 0x0008, 0x0022 );
 const mitk::DICOMTag mitk::ITKDICOMSeriesReaderHelper::AcquisitionTimeTag = mitk::DICOMTag( 0x0008, 0x0032 );
 const mitk::DICOMTag mitk::ITKDICOMSeriesReaderHelper::TriggerTimeTag = mitk::DICOMTag( 0x0018, 0x1060 );
 
+mitk::ITKDICOMSeriesReaderHelper::ITKDICOMSeriesReaderHelper()
+  : m_NumberOfThreads(0), m_ChunkSize(0), m_NumberOfLoadedFiles(0), m_NumberOfFiles(0)
+{
+}
+
+void mitk::ITKDICOMSeriesReaderHelper::SetNumberOfThreads(unsigned int numberOfThreads)
+{
+  m_NumberOfThreads = numberOfThreads;
+}
+
+unsigned int mitk::ITKDICOMSeriesReaderHelper::GetNumberOfThreads() const
+{
+  return m_NumberOfThreads;
+}
+
+void mitk::ITKDICOMSeriesReaderHelper::SetProgressCallback(const ProgressCallback& callback)
+{
+  m_ProgressCallback = callback;
+}
+
+void mitk::ITKDICOMSeriesReaderHelper::SetSlicesLoadedCallback(const SlicesLoadedCallback& callback)
+{
+  m_SlicesLoadedCallback = callback;
+}
+
+void mitk::ITKDICOMSeriesReaderHelper::SetChunkSize(unsigned int chunkSize)
+{
+  m_ChunkSize = chunkSize;
+}
+
+unsigned int mitk::ITKDICOMSeriesReaderHelper::GetChunkSize() const
+{
+  return 0 == m_ChunkSize ? 2 * this->GetNumberOfReadingThreads() : m_ChunkSize;
+}
+
+unsigned int mitk::ITKDICOMSeriesReaderHelper::GetNumberOfReadingThreads() const
+{
+  return 0 == m_NumberOfThreads ? itk::MultiThreader::GetGlobalDefaultNumberOfThreads() : m_NumberOfThreads;
+}
+
+void mitk::ITKDICOMSeriesReaderHelper::ReportReadFile()
+{
+  std::lock_guard<std::mutex> lock(m_ProgressMutex);
+
+  ++m_NumberOfLoadedFiles;
+  if (m_ProgressCallback)
+  {
+    m_ProgressCallback(m_NumberOfLoadedFiles, m_NumberOfFiles);
+  }
+}
+
+void mitk::ITKDICOMSeriesReaderHelper::ReadFilesInParallel(std::size_t firstFile,
+                                                           std::size_t endFile,
+                                                           const std::function<void(std::size_t)>& readFile)
+{
+  if (firstFile >= endFile)
+  {
+    return;
+  }
+
+  const std::function<void(std::size_t)> readAndReportFile = [this, &readFile](std::size_t i)
+  {
+    readFile(i);
+    this->ReportReadFile();
+  };
+
+  if (0 == firstFile)
+  {
+    readAndReportFile(firstFile++);
+  }
+
+  // the decoding time differs between files, so the threads take the next file when they are done
+  mitk::ParallelFor(firstFile, endFile, readAndReportFile, this->GetNumberOfReadingThreads());
+}
+
 #define switch3DCase( IOType, T ) \
   case IOType:                    \
     return LoadDICOMByITK<T>( filenames, correctTilt, tiltInfo, io );
@@ -162,3 +162,69 @@ mitk::SortByImagePositionPatient
   double retVal = InternalNumericDistance(from, to, possible); // returns 0.0 if not possible
   return possible ? retVal : 0.0;
 }
+
+bool
+mitk::SortByImagePositionPatient
+::ExtractSortKeys(const DICOMDatasetList& datasets, std::vector<double>& keys) const
+{
+  static const DICOMTag tagImagePositionPatient = DICOMTag(0x0020,0x0032); // Image Position (Patient)
+  static const DICOMTag    tagImageOrientation = DICOMTag(0x0020, 0x0037); // Image Orientation
+
+  keys.clear();
+  if (datasets.empty())
+  {
+    return true;
+  }
+
+  keys.reserve(datasets.size());
+
+  Vector3D firstRight; firstRight.Fill(0.0);
+  Vector3D firstUp; firstUp.Fill(0.0);
+  bool firstHasOrientation(false);
+  DICOMStringToOrientationVectors( datasets.front()->GetTagValueAsString( tagImageOrientation ).value,
+                                   firstRight, firstUp, firstHasOrientation );
+
+  Vector3D normal;
+  normal[0] = firstRight[1] * firstUp[2] - firstRight[2] * firstUp[1];
+  normal[1] = firstRight[2] * firstUp[0] - firstRight[0] * firstUp[2];
+  normal[2] = firstRight[0] * firstUp[1] - firstRight[1] * firstUp[0];
+
+  for (const auto* dataset : datasets)
+  {
+    Vector3D right; right.Fill(0.0);
+    Vector3D up; up.Fill(0.0);
+    bool hasOrientation(false);
+    DICOMStringToOrientationVectors( dataset->GetTagValueAsString( tagImageOrientation ).value,
+                                     right, up, hasOrientation );
+
+    // same tolerance as in InternalNumericDistance()
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      if (   fabs(firstRight[dim] - right[dim]) > 0.0001
+          || fabs(firstUp[dim] - up[dim]) > 0.0001)
+      {
+        MITK_ERROR << "Dicom images have different orientations.";
+        throw std::logic_error("Dicom images have different orientations. Call GetSeries() first to separate images.");
+      }
+    }
+
+    bool hasOrigin(false);
+    const Point3D origin = DICOMStringToPoint3D(dataset->GetTagValueAsString(tagImagePositionPatient).value, hasOrigin);
+
+    double distance = 0.0;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      distance += normal[dim] * origin[dim];
+    }
+    keys.push_back(distance);
+  }
+
+  return true;
+}
+
+double
+mitk::SortByImagePositionPatient
+::GetSortKeyTolerance() const
+{
+  return mitk::eps; // as InternalNumericDistance()
+}
@@ -223,11 +223,6 @@ bool
 mitk::ThreeDnTDICOMSeriesReader
 ::LoadMitkImageForImageBlockDescriptor(DICOMImageBlockDescriptor& block) const
 {
-  PushLocale();
-  const DICOMImageFrameList& frames = block.GetImageFrameList();
-  const GantryTiltInformation tiltInfo = block.GetTiltInformation();
-  const bool hasTilt = tiltInfo.IsRegularGantryTilt();
-
   const int numberOfTimesteps = block.GetNumberOfTimeSteps();
 
   if (numberOfTimesteps == 1)
@@ -235,6 +230,11 @@ mitk::ThreeDnTDICOMSeriesReader
     return DICOMITKSeriesGDCMReader::LoadMitkImageForImageBlockDescriptor(block);
   }
 
+  PushLocale();
+  const DICOMImageFrameList& frames = block.GetImageFrameList();
+  const GantryTiltInformation tiltInfo = block.GetTiltInformation();
+  const bool hasTilt = tiltInfo.IsRegularGantryTilt();
+
   const int numberOfFramesPerTimestep = block.GetNumberOfFramesPerTimeStep();
 
   ITKDICOMSeriesReaderHelper::StringContainerList filenamesPerTimestep;
@@ -254,11 +254,23 @@ mitk::ThreeDnTDICOMSeriesReader
   }
 
   mitk::ITKDICOMSeriesReaderHelper helper;
-  mitk::Image::Pointer mitkImage = helper.Load3DnT( filenamesPerTimestep, m_FixTiltByShearing && hasTilt, tiltInfo );
+  this->ConfigureHelperForImageBlockDescriptor( helper, block );
 
-  block.SetMitkImage( mitkImage );
+  bool success( true );
+  try
+  {
+    mitk::Image::Pointer mitkImage = helper.Load3DnT( filenamesPerTimestep, m_FixTiltByShearing && hasTilt, tiltInfo );
+    block.SetMitkImage( mitkImage );
+    this->SetAllSlicesLoaded( block );
+  }
+  catch ( const std::exception& e )
+  {
+    success = false;
+    block.SetMitkImage( nullptr ); // progressive loading might have set a partial image
+    MITK_ERROR << "Exception during image loading: " << e.what();
+  }
 
   PopLocale();
 
-  return true;
+  return success;
 }
@@ -1,6 +1,10 @@
 set(MODULE_TESTS
   mitkDICOMReaderConfiguratorTest.cpp
   mitkDICOMDCMTKTagScannerTest.cpp
+  mitkDICOMTagScannerParallelScanTest.cpp
+  mitkDICOMTagIndexTest.cpp
+  mitkITKDICOMSeriesReaderHelperTest.cpp
+  mitkDICOMTagBasedSorterTest.cpp
   mitkDICOMSimpleVolumeImportTest.cpp
   mitkDICOMTagPathTest.cpp
   mitkDICOMPropertyTest.cpp
@@ -45,6 +45,7 @@ public:
     ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/104"));
 
     scanner = mitk::DICOMDCMTKTagScanner::New();
+    scanner->SetTagIndex(nullptr);
   }
 
   void tearDown() override
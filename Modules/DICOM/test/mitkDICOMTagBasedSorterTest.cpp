@@ -0,0 +1,221 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMSortByTag.h"
+#include "mitkDICOMTagBasedSorter.h"
+#include "mitkSortByImagePositionPatient.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+
+namespace
+{
+  const mitk::DICOMTag SeriesInstanceUID(0x0020, 0x000e);
+  const mitk::DICOMTag InstanceNumber(0x0020, 0x0013);
+  const mitk::DICOMTag ImagePositionPatient(0x0020, 0x0032);
+  const mitk::DICOMTag ImageOrientationPatient(0x0020, 0x0037);
+
+  /** Dataset with tag values in memory. */
+  class TestDataset : public mitk::DICOMDatasetAccess
+  {
+  public:
+    TestDataset(unsigned int series, unsigned int slice) : m_Series(series), m_Slice(slice)
+    {
+      std::ostringstream seriesUID;
+      seriesUID << "1.2.826.0.1." << series;
+      m_Values[SeriesInstanceUID] = seriesUID.str();
+
+      std::ostringstream instanceNumber;
+      instanceNumber << slice + 1;
+      m_Values[InstanceNumber] = instanceNumber.str();
+
+      // the series are stacked along z, so the order of the outputs is defined by their first slices
+      std::ostringstream position;
+      position << "-125.5\\-130.25\\" << 10000.0 * series + 2.5 * slice;
+      m_Values[ImagePositionPatient] = position.str();
+
+      m_Values[ImageOrientationPatient] = "1\\0\\0\\0\\1\\0";
+    }
+
+    std::string GetFilenameIfAvailable() const override { return ""; }
+
+    mitk::DICOMDatasetFinding GetTagValueAsString(const mitk::DICOMTag& tag) const override
+    {
+      const auto value = m_Values.find(tag);
+      return value == m_Values.cend() ? mitk::DICOMDatasetFinding() : mitk::DICOMDatasetFinding(true, value->second);
+    }
+
+    FindingsListType GetTagValueAsString(const mitk::DICOMTagPath& /*path*/) const override { return FindingsListType(); }
+
+    unsigned int m_Series;
+    unsigned int m_Slice;
+
+  private:
+    std::map<mitk::DICOMTag, std::string> m_Values;
+  };
+
+  /** Delegates to another criterion without providing sort keys, so that the sorter compares datasets one by one. */
+  class ComparingCriterion : public mitk::DICOMSortCriterion
+  {
+  public:
+    mitkClassMacro(ComparingCriterion, mitk::DICOMSortCriterion);
+    mitkNewMacro1Param(ComparingCriterion, mitk::DICOMSortCriterion::Pointer);
+
+    mitk::DICOMTagList GetTagsOfInterest() const override { return m_Criterion->GetAllTagsOfInterest(); }
+
+    bool IsLeftBeforeRight(const mitk::DICOMDatasetAccess* left, const mitk::DICOMDatasetAccess* right) const override
+    {
+      return m_Criterion->IsLeftBeforeRight(left, right);
+    }
+
+    double NumericDistance(const mitk::DICOMDatasetAccess* from, const mitk::DICOMDatasetAccess* to) const override
+    {
+      return m_Criterion->NumericDistance(from, to);
+    }
+
+    void Print(std::ostream& os) const override { m_Criterion->Print(os); }
+
+    bool operator==(const mitk::DICOMSortCriterion& other) const override { return this == &other; }
+
+  protected:
+    ComparingCriterion(mitk::DICOMSortCriterion::Pointer criterion) : DICOMSortCriterion(nullptr), m_Criterion(criterion) {}
+
+    mitk::DICOMSortCriterion::Pointer m_Criterion;
+  };
+}
+
+/** Sorts shuffled synthetic series with DICOMTagBasedSorter, once with the sort keys of the criteria and once by
+  comparing datasets one by one, and prints how the sorting time scales with the number of frames. */
+class mitkDICOMTagBasedSorterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMTagBasedSorterTestSuite);
+
+  MITK_TEST(SortByPosition);
+  MITK_TEST(SortByTag);
+  MITK_TEST(SortingBenchmark);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  std::vector<std::unique_ptr<TestDataset>> m_Datasets;
+
+  mitk::DICOMDatasetList CreateShuffledDatasets(unsigned int numberOfSeries, unsigned int numberOfSlices)
+  {
+    m_Datasets.clear();
+    mitk::DICOMDatasetList datasets;
+    for (unsigned int series = 0; series < numberOfSeries; ++series)
+    {
+      for (unsigned int slice = 0; slice < numberOfSlices; ++slice)
+      {
+        m_Datasets.emplace_back(new TestDataset(series, slice));
+        datasets.push_back(m_Datasets.back().get());
+      }
+    }
+
+    std::shuffle(datasets.begin(), datasets.end(), std::mt19937(42));
+    return datasets;
+  }
+
+  mitk::DICOMTagBasedSorter::Pointer CreateSorter(mitk::DICOMSortCriterion::Pointer criterion)
+  {
+    auto sorter = mitk::DICOMTagBasedSorter::New();
+    sorter->AddDistinguishingTag(SeriesInstanceUID);
+    sorter->AddDistinguishingTag(ImageOrientationPatient, new mitk::DICOMTagBasedSorter::CutDecimalPlaces(5));
+    sorter->SetSortCriterion(criterion.GetPointer());
+    return sorter;
+  }
+
+  void CheckSorted(const mitk::DICOMDatasetSorter* sorter, unsigned int numberOfSeries, unsigned int numberOfSlices)
+  {
+    CPPUNIT_ASSERT_EQUAL(numberOfSeries, sorter->GetNumberOfOutputs());
+
+    for (unsigned int series = 0; series < numberOfSeries; ++series)
+    {
+      const mitk::DICOMDatasetList& output = sorter->GetOutput(series);
+      CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(numberOfSlices), output.size());
+
+      for (unsigned int slice = 0; slice < numberOfSlices; ++slice)
+      {
+        const auto* dataset = static_cast<const TestDataset*>(output[slice]);
+        CPPUNIT_ASSERT_EQUAL(series, dataset->m_Series);
+        CPPUNIT_ASSERT_EQUAL(slice, dataset->m_Slice);
+      }
+    }
+  }
+
+  static mitk::DICOMSortCriterion::Pointer CreatePositionCriterion()
+  {
+    return mitk::SortByImagePositionPatient::New(mitk::DICOMSortByTag::New(InstanceNumber).GetPointer()).GetPointer();
+  }
+
+public:
+
+  void tearDown() override
+  {
+    m_Datasets.clear();
+  }
+
+  void SortByPosition()
+  {
+    auto sorter = CreateSorter(CreatePositionCriterion());
+    sorter->SetInput(CreateShuffledDatasets(5, 40));
+    sorter->Sort();
+    CheckSorted(sorter, 5, 40);
+  }
+
+  void SortByTag()
+  {
+    auto sorter = CreateSorter(mitk::DICOMSortByTag::New(InstanceNumber).GetPointer());
+    sorter->SetInput(CreateShuffledDatasets(1, 120)); // numeric, not alphabetical order
+    sorter->Sort();
+    CheckSorted(sorter, 1, 120);
+  }
+
+  void SortingBenchmark()
+  {
+    const unsigned int numberOfSeries = 8;
+
+    for (unsigned int numberOfFrames : { 1000u, 2000u, 4000u, 8000u })
+    {
+      const unsigned int numberOfSlices = numberOfFrames / numberOfSeries;
+      const mitk::DICOMDatasetList datasets = CreateShuffledDatasets(numberOfSeries, numberOfSlices);
+
+      auto comparingSorter = CreateSorter(ComparingCriterion::New(CreatePositionCriterion()).GetPointer());
+      comparingSorter->SetInput(datasets);
+      auto startTime = std::chrono::steady_clock::now();
+      comparingSorter->Sort();
+      const double comparingTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+      auto sorter = CreateSorter(CreatePositionCriterion());
+      sorter->SetInput(datasets);
+      startTime = std::chrono::steady_clock::now();
+      sorter->Sort();
+      const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+      MITK_INFO << "Sorting " << numberOfFrames << " frames of " << numberOfSeries << " series: " << comparingTime
+                << " s comparing datasets, " << time << " s with sort keys";
+
+      CheckSorted(comparingSorter, numberOfSeries, numberOfSlices);
+      CheckSorted(sorter, numberOfSeries, numberOfSlices);
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMTagBasedSorter)
@@ -0,0 +1,225 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMDCMTKTagScanner.h"
+#include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMTagIndex.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkIOUtil.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <fstream>
+
+class mitkDICOMTagIndexTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMTagIndexTestSuite);
+
+  MITK_TEST(LookupAfterUpdate);
+  MITK_TEST(LookupOfChangedFile);
+  MITK_TEST(SaveAndLoad);
+  MITK_TEST(SaveRemovesLeastRecentlyUsedFiles);
+  MITK_TEST(GDCMScannerUsesIndex);
+  MITK_TEST(DCMTKScannerUsesIndex);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  std::string m_Directory;
+  mitk::StringList m_Files;
+
+  mitk::DICOMTagPath m_InstanceNumber;
+  mitk::DICOMTagPath m_InstanceUID;
+
+  mitk::DICOMTagIndex::Pointer m_Index;
+
+public:
+
+  void setUp() override
+  {
+    m_Directory = mitk::IOUtil::CreateTemporaryDirectory("mitkDICOMTagIndexTest_XXXXXX");
+
+    for (const auto& name : { "100", "101", "102", "104" })
+    {
+      const std::string fileName = m_Directory + "/" + name;
+      itksys::SystemTools::CopyFileAlways(GetTestDataFilePath(std::string("TinyCTAbdomen/") + name), fileName);
+      m_Files.push_back(fileName);
+    }
+
+    m_InstanceNumber = mitk::DICOMTagPath(0x0020, 0x0013);
+    m_InstanceUID = mitk::DICOMTagPath(0x0008, 0x0018);
+
+    m_Index = mitk::DICOMTagIndex::New();
+  }
+
+  void tearDown() override
+  {
+    m_Files.clear();
+    m_Index = nullptr;
+    itksys::SystemTools::RemoveADirectory(m_Directory.c_str());
+  }
+
+  void LookupAfterUpdate()
+  {
+    mitk::DICOMTagIndex::TagValuesType values;
+    CPPUNIT_ASSERT_MESSAGE("Unknown file", !m_Index->Lookup(m_Files[0], { m_InstanceNumber }, values));
+
+    values[m_InstanceNumber] = "12";
+    m_Index->Update(m_Files[0], { m_InstanceNumber, m_InstanceUID }, values);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_Index->GetNumberOfEntries());
+
+    mitk::DICOMTagIndex::TagValuesType foundValues;
+    CPPUNIT_ASSERT_MESSAGE("Indexed file", m_Index->Lookup(m_Files[0], { m_InstanceNumber }, foundValues));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), foundValues.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("12"), foundValues[m_InstanceNumber]);
+
+    // scanned without finding a value
+    CPPUNIT_ASSERT_MESSAGE("Indexed file", m_Index->Lookup(m_Files[0], { m_InstanceUID }, foundValues));
+    CPPUNIT_ASSERT(foundValues.empty());
+
+    CPPUNIT_ASSERT_MESSAGE("Tag that has not been scanned",
+      !m_Index->Lookup(m_Files[0], { mitk::DICOMTagPath(0x0010, 0x0010) }, foundValues));
+  }
+
+  void LookupOfChangedFile()
+  {
+    mitk::DICOMTagIndex::TagValuesType values;
+    values[m_InstanceNumber] = "12";
+    m_Index->Update(m_Files[0], { m_InstanceNumber }, values);
+
+    {
+      std::ofstream file(m_Files[0].c_str(), std::ios::app | std::ios::binary);
+      file << "changed";
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Changed file", !m_Index->Lookup(m_Files[0], { m_InstanceNumber }, values));
+  }
+
+  void SaveAndLoad()
+  {
+    const std::string indexFileName = m_Directory + "/index.txt";
+
+    mitk::DICOMTagIndex::TagValuesType values;
+    values[m_InstanceNumber] = "12";
+    values[m_InstanceUID] = "1.2\\3\t4\nfive";
+    m_Index->SetFileName(indexFileName);
+    m_Index->Update(m_Files[0], { m_InstanceNumber, m_InstanceUID }, values);
+    m_Index->Save();
+
+    auto loadedIndex = mitk::DICOMTagIndex::New();
+    loadedIndex->SetFileName(indexFileName);
+    loadedIndex->Load();
+
+    mitk::DICOMTagIndex::TagValuesType loadedValues;
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), loadedIndex->GetNumberOfEntries());
+    CPPUNIT_ASSERT(loadedIndex->Lookup(m_Files[0], { m_InstanceNumber, m_InstanceUID }, loadedValues));
+    CPPUNIT_ASSERT(values == loadedValues);
+
+    // an invalid index is ignored
+    {
+      std::ofstream file(indexFileName.c_str(), std::ios::trunc);
+      file << "no index";
+    }
+    loadedIndex->Load();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), loadedIndex->GetNumberOfEntries());
+  }
+
+  void SaveRemovesLeastRecentlyUsedFiles()
+  {
+    m_Index->SetFileName(m_Directory + "/index.txt");
+    m_Index->SetMaximumNumberOfEntries(2);
+
+    mitk::DICOMTagIndex::TagValuesType values;
+    for (const auto& fileName : m_Files)
+    {
+      m_Index->Update(fileName, { m_InstanceNumber }, values);
+    }
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), m_Index->GetNumberOfEntries());
+
+    // file 0 becomes the most recently used one
+    CPPUNIT_ASSERT(m_Index->Lookup(m_Files[0], { m_InstanceNumber }, values));
+
+    m_Index->Save();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Index->GetNumberOfEntries());
+    CPPUNIT_ASSERT_MESSAGE("Most recently used file", m_Index->Lookup(m_Files[0], { m_InstanceNumber }, values));
+    CPPUNIT_ASSERT_MESSAGE("Recently added file", m_Index->Lookup(m_Files[3], { m_InstanceNumber }, values));
+    CPPUNIT_ASSERT_MESSAGE("Least recently used file", !m_Index->Lookup(m_Files[1], { m_InstanceNumber }, values));
+
+    auto loadedIndex = mitk::DICOMTagIndex::New();
+    loadedIndex->SetFileName(m_Directory + "/index.txt");
+    loadedIndex->Load();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), loadedIndex->GetNumberOfEntries());
+  }
+
+  void GDCMScannerUsesIndex()
+  {
+    auto scanner = mitk::DICOMGDCMTagScanner::New();
+    scanner->SetTagIndex(m_Index);
+    scanner->SetInputFiles(m_Files);
+    scanner->AddTagPath(m_InstanceUID);
+    scanner->Scan();
+
+    CPPUNIT_ASSERT_EQUAL(m_Files.size(), m_Index->GetNumberOfEntries());
+    CPPUNIT_ASSERT_EQUAL(std::string("1.2.276.0.99.1.4.8323329.3795.1303917947.940051"),
+                         scanner->GetFrameInfoList()[0]->GetTagValueAsString(m_InstanceUID.GetFirstNode().tag).value);
+
+    // a value that only the index knows proves that the file is not read again
+    mitk::DICOMTagIndex::TagValuesType values;
+    values[m_InstanceUID] = "indexed";
+    m_Index->Update(m_Files[0], { m_InstanceUID }, values);
+
+    auto secondScanner = mitk::DICOMGDCMTagScanner::New();
+    secondScanner->SetTagIndex(m_Index);
+    secondScanner->SetInputFiles(m_Files);
+    secondScanner->AddTagPath(m_InstanceUID);
+    secondScanner->Scan();
+
+    mitk::DICOMDatasetAccessingImageFrameList frames = secondScanner->GetFrameInfoList();
+    CPPUNIT_ASSERT_EQUAL(m_Files.size(), frames.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("indexed"), frames[0]->GetTagValueAsString(m_InstanceUID.GetFirstNode().tag).value);
+    CPPUNIT_ASSERT_EQUAL(std::string("1.2.276.0.99.1.4.8323329.3795.1303917947.940052"),
+                         frames[1]->GetTagValueAsString(m_InstanceUID.GetFirstNode().tag).value);
+  }
+
+  void DCMTKScannerUsesIndex()
+  {
+    auto scanner = mitk::DICOMDCMTKTagScanner::New();
+    scanner->SetTagIndex(m_Index);
+    scanner->SetInputFiles(m_Files);
+    scanner->AddTagPath(m_InstanceUID);
+    scanner->Scan();
+
+    CPPUNIT_ASSERT_EQUAL(m_Files.size(), m_Index->GetNumberOfEntries());
+
+    mitk::DICOMTagIndex::TagValuesType values;
+    values[m_InstanceUID] = "indexed";
+    m_Index->Update(m_Files[0], { m_InstanceUID }, values);
+
+    auto secondScanner = mitk::DICOMDCMTKTagScanner::New();
+    secondScanner->SetTagIndex(m_Index);
+    secondScanner->SetInputFiles(m_Files);
+    secondScanner->AddTagPath(m_InstanceUID);
+    secondScanner->Scan();
+
+    mitk::DICOMDatasetAccessingImageFrameList frames = secondScanner->GetFrameInfoList();
+    CPPUNIT_ASSERT_EQUAL(m_Files.size(), frames.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("indexed"), frames[0]->GetTagValueAsString(m_InstanceUID).front().value);
+    CPPUNIT_ASSERT_EQUAL(std::string("1.2.276.0.99.1.4.8323329.3795.1303917947.940052"),
+                         frames[1]->GetTagValueAsString(m_InstanceUID).front().value);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMTagIndex)
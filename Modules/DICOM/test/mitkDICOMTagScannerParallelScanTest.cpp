@@ -0,0 +1,151 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMDCMTKTagScanner.h"
+#include "mitkDICOMGDCMTagScanner.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkIOUtil.h>
+
+#include <gdcmAttribute.h>
+#include <gdcmUIDGenerator.h>
+#include <gdcmWriter.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <chrono>
+#include <sstream>
+
+/** Scans a directory of synthetic DICOM files with one and with several threads and compares the results. */
+class mitkDICOMTagScannerParallelScanTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMTagScannerParallelScanTestSuite);
+
+  MITK_TEST(GDCMScanning);
+  MITK_TEST(DCMTKScanning);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  std::string m_Directory;
+  mitk::StringList m_Files;
+  mitk::DICOMTagList m_Tags;
+
+  void WriteFile(const std::string& fileName, int instanceNumber)
+  {
+    gdcm::UIDGenerator uidGenerator;
+
+    gdcm::Writer writer;
+    gdcm::File& file = writer.GetFile();
+    gdcm::DataSet& dataSet = file.GetDataSet();
+
+    gdcm::Attribute<0x0008, 0x0016> sopClassUID;
+    sopClassUID.SetValue("1.2.840.10008.5.1.4.1.1.2"); // CT Image Storage
+    dataSet.Insert(sopClassUID.GetAsDataElement());
+
+    gdcm::Attribute<0x0008, 0x0018> sopInstanceUID;
+    sopInstanceUID.SetValue(uidGenerator.Generate());
+    dataSet.Insert(sopInstanceUID.GetAsDataElement());
+
+    gdcm::Attribute<0x0020, 0x0013> instanceNumberAttribute;
+    instanceNumberAttribute.SetValue(instanceNumber);
+    dataSet.Insert(instanceNumberAttribute.GetAsDataElement());
+
+    gdcm::Attribute<0x0020, 0x0032> imagePositionPatient = { { 0.0, 0.0, 2.5 * instanceNumber } };
+    dataSet.Insert(imagePositionPatient.GetAsDataElement());
+
+    file.GetHeader().SetDataSetTransferSyntax(gdcm::TransferSyntax::ExplicitVRLittleEndian);
+
+    writer.SetFileName(fileName.c_str());
+    CPPUNIT_ASSERT_MESSAGE("Writing synthetic DICOM file " + fileName, writer.Write());
+  }
+
+  /** Scans the files and returns the tag values of all frames, one line per frame */
+  std::string Scan(mitk::DICOMTagScanner* scanner, unsigned int numberOfThreads)
+  {
+    // the files have to be read by the threads of the scanner, not taken from a tag index
+    scanner->SetTagIndex(nullptr);
+    scanner->SetNumberOfThreads(numberOfThreads);
+    scanner->SetInputFiles(m_Files);
+    scanner->AddTags(m_Tags);
+
+    const auto start = std::chrono::steady_clock::now();
+    scanner->Scan();
+    const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    MITK_INFO << scanner->GetNameOfClass() << ", " << numberOfThreads << " threads (0 = default): scanned "
+              << m_Files.size() << " files in " << time << " s";
+
+    mitk::DICOMDatasetAccessingImageFrameList frames = scanner->GetFrameInfoList();
+    CPPUNIT_ASSERT_EQUAL(m_Files.size(), frames.size());
+
+    std::ostringstream result;
+    for (std::size_t i = 0; i < frames.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(m_Files[i], frames[i]->GetFilenameIfAvailable());
+      for (const auto& tag : m_Tags)
+      {
+        mitk::DICOMDatasetFinding finding = frames[i]->GetTagValueAsString(tag);
+        CPPUNIT_ASSERT_MESSAGE("Testing validity of tag finding", finding.isValid);
+        result << finding.value << "|";
+      }
+      result << std::endl;
+    }
+
+    return result.str();
+  }
+
+public:
+
+  void setUp() override
+  {
+    m_Directory = mitk::IOUtil::CreateTemporaryDirectory("mitkDICOMTagScannerParallelScanTest_XXXXXX");
+
+    for (int i = 0; i < 200; ++i)
+    {
+      std::ostringstream fileName;
+      fileName << m_Directory << "/" << i << ".dcm";
+      m_Files.push_back(fileName.str());
+      WriteFile(fileName.str(), i);
+    }
+
+    m_Tags.push_back(mitk::DICOMTag(0x0008, 0x0018)); // SOP Instance UID
+    m_Tags.push_back(mitk::DICOMTag(0x0020, 0x0013)); // Instance Number
+    m_Tags.push_back(mitk::DICOMTag(0x0020, 0x0032)); // Image Position Patient
+  }
+
+  void tearDown() override
+  {
+    m_Files.clear();
+    m_Tags.clear();
+    itksys::SystemTools::RemoveADirectory(m_Directory.c_str());
+  }
+
+  void GDCMScanning()
+  {
+    const std::string sequential = Scan(mitk::DICOMGDCMTagScanner::New(), 1);
+    CPPUNIT_ASSERT_EQUAL(sequential, Scan(mitk::DICOMGDCMTagScanner::New(), 4));
+    CPPUNIT_ASSERT_EQUAL(sequential, Scan(mitk::DICOMGDCMTagScanner::New(), 0));
+  }
+
+  void DCMTKScanning()
+  {
+    const std::string sequential = Scan(mitk::DICOMDCMTKTagScanner::New(), 1);
+    CPPUNIT_ASSERT_EQUAL(sequential, Scan(mitk::DICOMDCMTKTagScanner::New(), 4));
+    CPPUNIT_ASSERT_EQUAL(sequential, Scan(mitk::DICOMDCMTKTagScanner::New(), 0));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMTagScannerParallelScan)
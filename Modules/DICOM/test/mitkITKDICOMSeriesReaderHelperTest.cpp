@@ -0,0 +1,272 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkITKDICOMSeriesReaderHelper.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkIOUtil.h>
+#include <mitkImageReadAccessor.h>
+
+#include <gdcmAttribute.h>
+#include <gdcmImageChangeTransferSyntax.h>
+#include <gdcmImageWriter.h>
+
+#include <itkImageSeriesReader.h>
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+
+namespace
+{
+  const unsigned int Size = 256;
+  const unsigned int NumberOfSlices = 64;
+}
+
+/** Loads a synthetic, compressed CT series with ITKDICOMSeriesReaderHelper and compares the result with
+  itk::ImageSeriesReader, also progressively. Also prints the load times for one and for the default number of threads. */
+class mitkITKDICOMSeriesReaderHelperTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkITKDICOMSeriesReaderHelperTestSuite);
+
+  MITK_TEST(Load);
+  MITK_TEST(Load3DnT);
+  MITK_TEST(LoadProgressively);
+  MITK_TEST(LoadBenchmark);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  typedef itk::Image<short, 3> ReferenceImageType;
+  typedef mitk::ITKDICOMSeriesReaderHelper::StringContainer StringContainer;
+
+  std::string m_Directory;
+  StringContainer m_Files;
+
+  void WriteSlice(const std::string& fileName, unsigned int z)
+  {
+    std::vector<short> pixels(Size * Size);
+    for (unsigned int y = 0; y < Size; ++y)
+      for (unsigned int x = 0; x < Size; ++x)
+        pixels[x + y * Size] = static_cast<short>((x + 2 * y + 3 * z) % 2000) - 1000;
+
+    gdcm::ImageWriter writer;
+    gdcm::Image& image = writer.GetImage();
+
+    image.SetNumberOfDimensions(2);
+    image.SetDimension(0, Size);
+    image.SetDimension(1, Size);
+    image.SetPixelFormat(gdcm::PixelFormat(gdcm::PixelFormat::INT16));
+    image.SetPhotometricInterpretation(gdcm::PhotometricInterpretation::MONOCHROME2);
+    image.SetTransferSyntax(gdcm::TransferSyntax::ExplicitVRLittleEndian);
+
+    const double origin[3] = { 0.0, 0.0, 2.5 * z };
+    const double spacing[3] = { 0.5, 0.5, 2.5 };
+    const double directionCosines[6] = { 1.0, 0.0, 0.0, 0.0, 1.0, 0.0 };
+    image.SetOrigin(origin);
+    image.SetSpacing(spacing);
+    image.SetDirectionCosines(directionCosines);
+
+    gdcm::DataElement pixelData(gdcm::Tag(0x7fe0, 0x0010));
+    pixelData.SetByteValue(reinterpret_cast<const char*>(pixels.data()), static_cast<uint32_t>(pixels.size() * sizeof(short)));
+    image.SetDataElement(pixelData);
+
+    // decoding of compressed files is what the parallel loading speeds up
+    gdcm::ImageChangeTransferSyntax change;
+    change.SetTransferSyntax(gdcm::TransferSyntax::JPEG2000Lossless);
+    change.SetInput(image);
+    if (change.Change())
+    {
+      writer.SetImage(change.GetOutput());
+    }
+
+    gdcm::Attribute<0x0008, 0x0016> sopClassUID;
+    sopClassUID.SetValue("1.2.840.10008.5.1.4.1.1.2"); // CT Image Storage
+    writer.GetFile().GetDataSet().Insert(sopClassUID.GetAsDataElement());
+
+    gdcm::Attribute<0x0008, 0x0060> modality;
+    modality.SetValue("CT");
+    writer.GetFile().GetDataSet().Insert(modality.GetAsDataElement());
+
+    writer.SetFileName(fileName.c_str());
+    CPPUNIT_ASSERT_MESSAGE("Writing synthetic DICOM file " + fileName, writer.Write());
+  }
+
+  ReferenceImageType::Pointer LoadReference(const StringContainer& files)
+  {
+    auto reader = itk::ImageSeriesReader<ReferenceImageType>::New();
+    reader->SetImageIO(itk::GDCMImageIO::New());
+    reader->ReverseOrderOff();
+    reader->SetFileNames(files);
+    reader->Update();
+    return reader->GetOutput();
+  }
+
+  void CheckEqual(const ReferenceImageType* reference, mitk::Image* image, unsigned int timeStep)
+  {
+    CPPUNIT_ASSERT(image != nullptr);
+    CPPUNIT_ASSERT(image->GetPixelType() == mitk::MakeScalarPixelType<short>());
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(reference->GetLargestPossibleRegion().GetSize()[i]), image->GetDimension(i));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(reference->GetOrigin()[i], image->GetGeometry(timeStep)->GetOrigin()[i], mitk::eps);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(reference->GetSpacing()[i], image->GetGeometry(timeStep)->GetSpacing()[i], mitk::eps);
+    }
+
+    mitk::ImageReadAccessor accessor(image, image->GetVolumeData(timeStep));
+    CPPUNIT_ASSERT(0 == std::memcmp(reference->GetBufferPointer(), accessor.GetData(),
+                                    reference->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof(short)));
+  }
+
+public:
+
+  void setUp() override
+  {
+    m_Directory = mitk::IOUtil::CreateTemporaryDirectory("mitkITKDICOMSeriesReaderHelperTest_XXXXXX");
+
+    for (unsigned int z = 0; z < NumberOfSlices; ++z)
+    {
+      std::ostringstream fileName;
+      fileName << m_Directory << "/" << z << ".dcm";
+      m_Files.push_back(fileName.str());
+      WriteSlice(fileName.str(), z);
+    }
+  }
+
+  void tearDown() override
+  {
+    m_Files.clear();
+    itksys::SystemTools::RemoveADirectory(m_Directory.c_str());
+  }
+
+  void Load()
+  {
+    const ReferenceImageType::Pointer reference = LoadReference(m_Files);
+
+    for (unsigned int numberOfThreads : { 1u, 4u, 0u })
+    {
+      std::vector<unsigned int> progress;
+
+      mitk::ITKDICOMSeriesReaderHelper helper;
+      helper.SetNumberOfThreads(numberOfThreads);
+      helper.SetProgressCallback([&progress](unsigned int loaded, unsigned int total) {
+        CPPUNIT_ASSERT_EQUAL(NumberOfSlices, total);
+        progress.push_back(loaded);
+      });
+
+      mitk::Image::Pointer image = helper.Load(m_Files, false, mitk::GantryTiltInformation());
+      CheckEqual(reference, image, 0);
+
+      CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(NumberOfSlices), progress.size());
+      for (unsigned int i = 0; i < progress.size(); ++i)
+        CPPUNIT_ASSERT_EQUAL(i + 1, progress[i]);
+    }
+  }
+
+  void Load3DnT()
+  {
+    mitk::ITKDICOMSeriesReaderHelper::StringContainerList filesOfTimeSteps;
+    filesOfTimeSteps.push_back(StringContainer(m_Files.begin(), m_Files.begin() + NumberOfSlices / 2));
+    filesOfTimeSteps.push_back(StringContainer(m_Files.begin() + NumberOfSlices / 2, m_Files.end()));
+
+    unsigned int numberOfLoadedFiles = 0;
+
+    mitk::ITKDICOMSeriesReaderHelper helper;
+    helper.SetProgressCallback([&numberOfLoadedFiles](unsigned int loaded, unsigned int total) {
+      CPPUNIT_ASSERT_EQUAL(NumberOfSlices, total);
+      numberOfLoadedFiles = loaded;
+    });
+
+    mitk::Image::Pointer image = helper.Load3DnT(filesOfTimeSteps, false, mitk::GantryTiltInformation());
+    CPPUNIT_ASSERT(image.IsNotNull());
+    CPPUNIT_ASSERT_EQUAL(2u, image->GetTimeSteps());
+    CPPUNIT_ASSERT_EQUAL(NumberOfSlices, numberOfLoadedFiles);
+
+    // the geometry is the one of the first time step
+    CheckEqual(LoadReference(filesOfTimeSteps.front()), image, 0);
+
+    const ReferenceImageType::Pointer secondReference = LoadReference(filesOfTimeSteps.back());
+    mitk::ImageReadAccessor accessor(image, image->GetVolumeData(1));
+    CPPUNIT_ASSERT(0 == std::memcmp(secondReference->GetBufferPointer(), accessor.GetData(),
+                                    secondReference->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof(short)));
+  }
+
+  void LoadProgressively()
+  {
+    const ReferenceImageType::Pointer reference = LoadReference(m_Files);
+    const std::size_t numberOfPixelsPerSlice = Size * Size;
+
+    std::vector<unsigned int> numbersOfLoadedSlices;
+    mitk::Image* loadingImage = nullptr;
+
+    mitk::ITKDICOMSeriesReaderHelper helper;
+    helper.SetChunkSize(16);
+    helper.SetSlicesLoadedCallback([&](mitk::Image* image, unsigned int timeStep, unsigned int numberOfLoadedSlices) {
+      CPPUNIT_ASSERT_EQUAL(0u, timeStep);
+      CPPUNIT_ASSERT(image != nullptr);
+      CPPUNIT_ASSERT_EQUAL(NumberOfSlices, image->GetDimension(2));
+      loadingImage = image;
+      numbersOfLoadedSlices.push_back(numberOfLoadedSlices);
+
+      // the loaded slices are complete, all others are cleared
+      mitk::ImageReadAccessor accessor(image, image->GetVolumeData(0));
+      const auto* pixels = static_cast<const short*>(accessor.GetData());
+      CPPUNIT_ASSERT(0 == std::memcmp(reference->GetBufferPointer(), pixels,
+                                      numberOfLoadedSlices * numberOfPixelsPerSlice * sizeof(short)));
+      CPPUNIT_ASSERT(std::all_of(pixels + numberOfLoadedSlices * numberOfPixelsPerSlice,
+                                 pixels + NumberOfSlices * numberOfPixelsPerSlice,
+                                 [](short pixel) { return 0 == pixel; }));
+    });
+
+    mitk::Image::Pointer image = helper.Load(m_Files, false, mitk::GantryTiltInformation());
+    CheckEqual(reference, image, 0);
+    CPPUNIT_ASSERT(image.GetPointer() == loadingImage);
+
+    const std::vector<unsigned int> expectedNumbersOfLoadedSlices = { 0, 16, 32, 48, 64 };
+    CPPUNIT_ASSERT(expectedNumbersOfLoadedSlices == numbersOfLoadedSlices);
+  }
+
+  void LoadBenchmark()
+  {
+    auto startTime = std::chrono::steady_clock::now();
+    const ReferenceImageType::Pointer reference = LoadReference(m_Files);
+    const double seriesReaderTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    mitk::ITKDICOMSeriesReaderHelper singleThreadedHelper;
+    singleThreadedHelper.SetNumberOfThreads(1);
+
+    startTime = std::chrono::steady_clock::now();
+    mitk::Image::Pointer singleThreadedImage = singleThreadedHelper.Load(m_Files, false, mitk::GantryTiltInformation());
+    const double singleThreadedTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    mitk::ITKDICOMSeriesReaderHelper helper;
+
+    startTime = std::chrono::steady_clock::now();
+    mitk::Image::Pointer image = helper.Load(m_Files, false, mitk::GantryTiltInformation());
+    const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    MITK_INFO << "Loading " << NumberOfSlices << " compressed slices of " << Size << "x" << Size << ": "
+              << seriesReaderTime << " s itk::ImageSeriesReader, " << singleThreadedTime << " s 1 thread, " << time
+              << " s default threads";
+
+    CheckEqual(reference, singleThreadedImage, 0);
+    CheckEqual(reference, image, 0);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkITKDICOMSeriesReaderHelper)
@@ -21,6 +21,7 @@ found in the LICENSE file.
 
 #include <itkObject.h>
 
+#include <cstddef>
 #include <vector>
 
 namespace mitk
@@ -30,6 +31,14 @@ namespace mitk
 
     Uses zlib to compress the data of an mitk::Image.
 
+    Each time step is split into blocks of BlockSize bytes that are compressed independently, so compression and
+    uncompression of the blocks are distributed over NumberOfThreads threads. Blocks that cannot be compressed
+    are stored as they are.
+
+    The codec and the compression level are taken into account by the next call of SetImage().
+    ZLibRunLength only searches for repeated bytes. It is much faster than ZLib and compresses
+    segmentations and other images with large homogeneous areas almost as well.
+
     $Author$
   */
   class MITKDATATYPESEXT_EXPORT CompressedImageContainer : public itk::Object
@@ -39,13 +48,36 @@ namespace mitk
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
 
-      /**
-       * \brief Creates a compressed version of the image.
-       *
-       * Will not hold any further SmartPointers to the image.
-       *
-       */
-      void SetImage(const Image *);
+    enum CompressionCodec
+    {
+      ZLib,          ///< deflate with the default strategy
+      ZLibRunLength, ///< deflate that only encodes runs of equal bytes
+      Uncompressed   ///< copies the data without compression
+    };
+
+    /** \brief Codec used to compress the image data. Default is ZLib. */
+    itkSetMacro(Codec, CompressionCodec);
+    itkGetConstMacro(Codec, CompressionCodec);
+
+    /** \brief zlib compression level from 0 (none) to 9 (best), -1 selects the default level of zlib. */
+    itkSetClampMacro(CompressionLevel, int, -1, 9);
+    itkGetConstMacro(CompressionLevel, int);
+
+    /** \brief Number of bytes of a time step that are compressed as one block. Default is 1 MiB. */
+    itkSetClampMacro(BlockSize, std::size_t, 4096, std::size_t(1) << 30);
+    itkGetConstMacro(BlockSize, std::size_t);
+
+    /** \brief Number of threads used for compression and uncompression. 0 uses the default number of ITK. */
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetConstMacro(NumberOfThreads, unsigned int);
+
+    /**
+     * \brief Creates a compressed version of the image.
+     *
+     * Will not hold any further SmartPointers to the image.
+     *
+     */
+    void SetImage(const Image *);
 
     /**
      * \brief Creates a full mitk::Image from its compressed version.
@@ -56,10 +88,24 @@ namespace mitk
      */
     Image::Pointer GetImage() const;
 
+    /**
+     * \brief Returns the number of bytes occupied by the compressed image data.
+     */
+    std::size_t GetMemorySize() const;
+
   protected:
     CompressedImageContainer(); // purposely hidden
     ~CompressedImageContainer() override;
 
+    struct Block
+    {
+      std::vector<unsigned char> Data;
+      bool IsCompressed;
+    };
+
+    /// the blocks of one time step
+    typedef std::vector<Block> BlockContainerType;
+
     PixelType *m_PixelType;
 
     unsigned int m_ImageDimension;
@@ -69,10 +115,18 @@ namespace mitk
 
     unsigned int m_NumberOfTimeSteps;
 
-    /// one for each timestep. first = pointer to compressed data; second = size of buffer in bytes
-    std::vector<std::pair<unsigned char *, unsigned long>> m_ByteBuffers;
+    /// one for each timestep
+    std::vector<BlockContainerType> m_Blocks;
+
+    /// block size of the stored blocks
+    std::size_t m_CompressedBlockSize;
 
     BaseGeometry::Pointer m_ImageGeometry;
+
+    CompressionCodec m_Codec;
+    int m_CompressionLevel;
+    std::size_t m_BlockSize;
+    unsigned int m_NumberOfThreads;
   };
 
 } // namespace
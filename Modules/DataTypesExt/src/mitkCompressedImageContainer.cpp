@@ -12,39 +12,78 @@ found in the LICENSE file.
 
 #include "mitkCompressedImageContainer.h"
 #include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
+#include "mitkParallelFor.h"
 
 #include "itk_zlib.h"
 
-#include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <memory>
 
-mitk::CompressedImageContainer::CompressedImageContainer() : m_PixelType(nullptr), m_ImageGeometry(nullptr)
+namespace
 {
+  bool CompressBlock(const unsigned char *source, std::size_t size, int level, int strategy, std::vector<unsigned char> &destination)
+  {
+    z_stream stream = z_stream();
+    if (Z_OK != deflateInit2(&stream, level, Z_DEFLATED, MAX_WBITS, 8, strategy))
+    {
+      return false;
+    }
+
+    destination.resize(deflateBound(&stream, static_cast<uLong>(size)));
+
+    stream.next_in = const_cast<Bytef *>(source);
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = destination.data();
+    stream.avail_out = static_cast<uInt>(destination.size());
+
+    const int zlibRetVal = deflate(&stream, Z_FINISH);
+    const auto compressedSize = static_cast<std::size_t>(stream.total_out);
+    deflateEnd(&stream);
+
+    // incompressible blocks are stored as they are
+    if (Z_STREAM_END != zlibRetVal || compressedSize >= size)
+    {
+      std::vector<unsigned char>().swap(destination);
+      return false;
+    }
+
+    destination.resize(compressedSize);
+    destination.shrink_to_fit();
+    return true;
+  }
 }
 
-mitk::CompressedImageContainer::~CompressedImageContainer()
+mitk::CompressedImageContainer::CompressedImageContainer()
+  : m_PixelType(nullptr),
+    m_ImageDimension(0),
+    m_OneTimeStepImageSizeInBytes(0),
+    m_NumberOfTimeSteps(0),
+    m_CompressedBlockSize(0),
+    m_ImageGeometry(nullptr),
+    m_Codec(ZLib),
+    m_CompressionLevel(Z_DEFAULT_COMPRESSION),
+    m_BlockSize(1 << 20),
+    m_NumberOfThreads(0)
 {
-  for (auto iter = m_ByteBuffers.begin(); iter != m_ByteBuffers.end(); ++iter)
-  {
-    free(iter->first);
-  }
+}
 
+mitk::CompressedImageContainer::~CompressedImageContainer()
+{
   delete m_PixelType;
 }
 
 void mitk::CompressedImageContainer::SetImage(const Image *image)
 {
-  for (auto iter = m_ByteBuffers.begin(); iter != m_ByteBuffers.end(); ++iter)
-  {
-    free(iter->first);
-  }
-
-  m_ByteBuffers.clear();
+  m_Blocks.clear();
 
   // Compress diff image using zlib (will be restored on demand)
   // determine memory size occupied by voxel data
   m_ImageDimension = image->GetDimension();
   m_ImageDimensions.clear();
 
+  delete m_PixelType;
   m_PixelType = new mitk::PixelType(image->GetPixelType());
 
   m_OneTimeStepImageSizeInBytes = m_PixelType->GetSize(); // bits per element divided by 8
@@ -66,64 +105,51 @@ void mitk::CompressedImageContainer::SetImage(const Image *image)
     m_NumberOfTimeSteps = image->GetDimension(3);
   }
 
+  m_CompressedBlockSize = m_BlockSize;
+  const std::size_t timeStepSize = m_OneTimeStepImageSizeInBytes;
+  const std::size_t numberOfBlocks = (timeStepSize + m_CompressedBlockSize - 1) / m_CompressedBlockSize;
+
+  std::vector<std::unique_ptr<ImageReadAccessor>> accessors;
+  std::vector<const unsigned char *> timeStepData;
   for (unsigned int timestep = 0; timestep < m_NumberOfTimeSteps; ++timestep)
   {
-    // allocate a buffer as specified by zlib
-    unsigned long bufferSize =
-      m_OneTimeStepImageSizeInBytes + static_cast<unsigned long>(m_OneTimeStepImageSizeInBytes * 0.2) + 12;
-    auto *byteBuffer = (unsigned char *)malloc(bufferSize);
+    accessors.emplace_back(new ImageReadAccessor(image, image->GetVolumeData(timestep)));
+    timeStepData.push_back(static_cast<const unsigned char *>(accessors.back()->GetData()));
+  }
 
-    if (itk::Object::GetDebug())
-    {
-      // compress image here into a buffer
-      MITK_INFO << "Using ZLib version: '" << zlibVersion() << "'" << std::endl
-                << "Attempting to compress " << m_OneTimeStepImageSizeInBytes << " image bytes into a buffer of size "
-                << bufferSize << std::endl;
-    }
+  m_Blocks.assign(m_NumberOfTimeSteps, BlockContainerType(numberOfBlocks));
 
-    ImageReadAccessor imgAcc(image, image->GetVolumeData(timestep));
-    ::Bytef *dest(byteBuffer);
-    ::uLongf destLen(bufferSize);
-    auto *source((unsigned char *)imgAcc.GetData());
-    ::uLongf sourceLen(m_OneTimeStepImageSizeInBytes);
-    int zlibRetVal = ::compress(dest, &destLen, source, sourceLen);
-    if (itk::Object::GetDebug())
+  const std::size_t blockSize = m_CompressedBlockSize;
+  const bool compress = Uncompressed != m_Codec;
+  const int level = m_CompressionLevel;
+  const int strategy = ZLibRunLength == m_Codec ? Z_RLE : Z_DEFAULT_STRATEGY;
+
+  mitk::ParallelFor(0, m_NumberOfTimeSteps * numberOfBlocks, [&](std::size_t task) {
+    const std::size_t timestep = task / numberOfBlocks;
+    const std::size_t offset = (task % numberOfBlocks) * blockSize;
+    const std::size_t size = std::min(blockSize, timeStepSize - offset);
+    const unsigned char *source = timeStepData[timestep] + offset;
+
+    Block &block = m_Blocks[timestep][task % numberOfBlocks];
+    block.IsCompressed = compress && CompressBlock(source, size, level, strategy, block.Data);
+
+    if (!block.IsCompressed)
     {
-      if (zlibRetVal == Z_OK)
-      {
-        MITK_INFO << "Success, using " << destLen << " bytes of the buffer (ratio "
-                  << ((double)destLen / (double)sourceLen) << ")" << std::endl;
-      }
-      else
-      {
-        switch (zlibRetVal)
-        {
-          case Z_MEM_ERROR:
-            MITK_ERROR << "not enough memory" << std::endl;
-            break;
-          case Z_BUF_ERROR:
-            MITK_ERROR << "output buffer too small" << std::endl;
-            break;
-          default:
-            MITK_ERROR << "other, unspecified error" << std::endl;
-            break;
-        }
-      }
+      block.Data.assign(source, source + size);
     }
+  }, m_NumberOfThreads);
 
-    // only use the neccessary amount of memory, realloc the buffer!
-    byteBuffer = (unsigned char *)realloc(byteBuffer, destLen);
-    bufferSize = destLen;
-    // MITK_INFO << "Using " << bufferSize << " bytes to store compressed image (" << destLen << " needed)" <<
-    // std::endl;
-
-    m_ByteBuffers.push_back(std::pair<unsigned char *, unsigned long>(byteBuffer, bufferSize));
+  if (itk::Object::GetDebug())
+  {
+    MITK_INFO << "Using ZLib version: '" << zlibVersion() << "'" << std::endl
+              << "Compressed " << m_NumberOfTimeSteps * timeStepSize << " image bytes in " << m_NumberOfTimeSteps * numberOfBlocks
+              << " blocks into " << this->GetMemorySize() << " bytes" << std::endl;
   }
 }
 
 mitk::Image::Pointer mitk::CompressedImageContainer::GetImage() const
 {
-  if (m_ByteBuffers.empty())
+  if (m_Blocks.empty())
     return nullptr;
 
   // uncompress image data, create an Image
@@ -135,40 +161,48 @@ mitk::Image::Pointer mitk::CompressedImageContainer::GetImage() const
   image->Initialize(*m_PixelType, m_ImageDimension, dims); // this IS needed, right ?? But it does allocate memory ->
                                                            // does create one big lump of memory (also in windows)
 
-  unsigned int timeStep(0);
-  for (auto iter = m_ByteBuffers.begin(); iter != m_ByteBuffers.end(); ++iter, ++timeStep)
+  const std::size_t timeStepSize = m_OneTimeStepImageSizeInBytes;
+  const std::size_t blockSize = m_CompressedBlockSize;
+  const std::size_t numberOfBlocks = m_Blocks.front().size();
+
+  std::vector<std::unique_ptr<ImageWriteAccessor>> accessors;
+  std::vector<unsigned char *> timeStepData;
+  for (unsigned int timeStep = 0; timeStep < m_NumberOfTimeSteps; ++timeStep)
   {
-    ImageReadAccessor imgAcc(image, image->GetVolumeData(timeStep));
-    auto *dest((unsigned char *)imgAcc.GetData());
-    ::uLongf destLen(m_OneTimeStepImageSizeInBytes);
-    ::Bytef *source(iter->first);
-    ::uLongf sourceLen(iter->second);
-    int zlibRetVal = ::uncompress(dest, &destLen, source, sourceLen);
-    if (itk::Object::GetDebug())
+    accessors.emplace_back(new ImageWriteAccessor(image, image->GetVolumeData(timeStep)));
+    timeStepData.push_back(static_cast<unsigned char *>(accessors.back()->GetData()));
+  }
+
+  std::atomic<std::size_t> numberOfCorruptedBlocks(0);
+
+  mitk::ParallelFor(0, m_NumberOfTimeSteps * numberOfBlocks, [&](std::size_t task) {
+    const std::size_t timeStep = task / numberOfBlocks;
+    const std::size_t offset = (task % numberOfBlocks) * blockSize;
+    const std::size_t size = std::min(blockSize, timeStepSize - offset);
+    unsigned char *destination = timeStepData[timeStep] + offset;
+
+    const Block &block = m_Blocks[timeStep][task % numberOfBlocks];
+
+    if (!block.IsCompressed)
     {
-      if (zlibRetVal == Z_OK)
-      {
-        MITK_INFO << "Success, destLen now " << destLen << " bytes" << std::endl;
-      }
-      else
-      {
-        switch (zlibRetVal)
-        {
-          case Z_DATA_ERROR:
-            MITK_ERROR << "compressed data corrupted" << std::endl;
-            break;
-          case Z_MEM_ERROR:
-            MITK_ERROR << "not enough memory" << std::endl;
-            break;
-          case Z_BUF_ERROR:
-            MITK_ERROR << "output buffer too small" << std::endl;
-            break;
-          default:
-            MITK_ERROR << "other, unspecified error" << std::endl;
-            break;
-        }
-      }
+      std::copy(block.Data.begin(), block.Data.end(), destination);
+      return;
     }
+
+    ::uLongf destLen(static_cast<uLongf>(size));
+    const int zlibRetVal = ::uncompress(destination, &destLen, block.Data.data(), static_cast<uLong>(block.Data.size()));
+
+    if (Z_OK != zlibRetVal || size != destLen)
+    {
+      ++numberOfCorruptedBlocks;
+    }
+  }, m_NumberOfThreads);
+
+  accessors.clear();
+
+  if (numberOfCorruptedBlocks > 0)
+  {
+    MITK_ERROR << "compressed data corrupted: " << numberOfCorruptedBlocks << " blocks could not be uncompressed" << std::endl;
   }
 
   image->SetGeometry(m_ImageGeometry);
@@ -176,3 +210,16 @@ mitk::Image::Pointer mitk::CompressedImageContainer::GetImage() const
 
   return image;
 }
+
+std::size_t mitk::CompressedImageContainer::GetMemorySize() const
+{
+  std::size_t size = 0;
+  for (const auto &blocks : m_Blocks)
+  {
+    for (const auto &block : blocks)
+    {
+      size += block.Data.capacity();
+    }
+  }
+  return size;
+}
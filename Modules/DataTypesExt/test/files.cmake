@@ -1,5 +1,6 @@
 set(MODULE_TESTS
   mitkColorSequenceRainbowTest.cpp
+  mitkCompressedImageContainerBenchmarkTest.cpp
   mitkMultiStepperTest.cpp
   mitkUnstructuredGridTest.cpp
 )
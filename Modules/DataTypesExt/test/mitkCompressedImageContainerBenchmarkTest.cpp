@@ -0,0 +1,155 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include <mitkCompressedImageContainer.h>
+#include <mitkITKImageImport.h>
+#include <mitkIOUtil.h>
+#include <mitkImageCast.h>
+#include <mitkImageReadAccessor.h>
+
+#include <itkImageRegionConstIterator.h>
+#include <itkImageRegionIterator.h>
+
+#include <chrono>
+#include <cstring>
+
+/** Measures throughput and compression ratio of CompressedImageContainer for the available codecs on a CT-like
+  image and on label data derived from it. The measured values are printed, the tests only check that the
+  images are restored and that the ratios are plausible. */
+class mitkCompressedImageContainerBenchmarkTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkCompressedImageContainerBenchmarkTestSuite);
+  MITK_TEST(CTImage);
+  MITK_TEST(LabelImage);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::CompressedImageContainer ContainerType;
+
+  struct Configuration
+  {
+    const char *Name;
+    ContainerType::CompressionCodec Codec;
+    int Level;
+    unsigned int Threads;
+  };
+
+  mitk::Image::Pointer m_CTImage;
+  mitk::Image::Pointer m_LabelImage;
+
+  static std::size_t GetImageSize(const mitk::Image *image)
+  {
+    std::size_t size = image->GetPixelType().GetSize();
+    for (unsigned int i = 0; i < image->GetDimension(); ++i)
+      size *= image->GetDimension(i);
+    return size;
+  }
+
+  /** Returns the compression ratio of the configuration */
+  double Benchmark(const std::string &imageName, const mitk::Image *image, const Configuration &configuration)
+  {
+    auto container = ContainerType::New();
+    container->SetCodec(configuration.Codec);
+    container->SetCompressionLevel(configuration.Level);
+    container->SetNumberOfThreads(configuration.Threads);
+
+    const auto compressionStart = std::chrono::steady_clock::now();
+    container->SetImage(image);
+    const auto compressionStop = std::chrono::steady_clock::now();
+
+    mitk::Image::Pointer restoredImage = container->GetImage();
+    const auto uncompressionStop = std::chrono::steady_clock::now();
+
+    const std::size_t imageSize = GetImageSize(image);
+    CPPUNIT_ASSERT(restoredImage.IsNotNull());
+    CPPUNIT_ASSERT_EQUAL(imageSize, GetImageSize(restoredImage));
+
+    mitk::ImageReadAccessor accessor(image);
+    mitk::ImageReadAccessor restoredAccessor(restoredImage);
+    CPPUNIT_ASSERT(0 == std::memcmp(accessor.GetData(), restoredAccessor.GetData(), imageSize));
+
+    const double megabytes = imageSize / (1024. * 1024.);
+    const double compressionTime = std::chrono::duration<double>(compressionStop - compressionStart).count();
+    const double uncompressionTime = std::chrono::duration<double>(uncompressionStop - compressionStop).count();
+    const double ratio = container->GetMemorySize() / static_cast<double>(imageSize);
+
+    MITK_INFO << imageName << ", " << configuration.Name << ": ratio " << ratio << ", compression "
+              << megabytes / compressionTime << " MiB/s, uncompression " << megabytes / uncompressionTime << " MiB/s";
+
+    return ratio;
+  }
+
+public:
+  void setUp() override
+  {
+    m_CTImage = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Pic3D.nrrd"));
+
+    // label data: three labels on top of background, derived from the intensities
+    typedef itk::Image<short, 3> CTImageType;
+    typedef itk::Image<unsigned short, 3> LabelImageType;
+
+    CTImageType::Pointer ctImage;
+    mitk::CastToItkImage(m_CTImage, ctImage);
+
+    auto labelImage = LabelImageType::New();
+    labelImage->SetRegions(ctImage->GetLargestPossibleRegion());
+    labelImage->Allocate();
+
+    itk::ImageRegionConstIterator<CTImageType> ctIt(ctImage, ctImage->GetLargestPossibleRegion());
+    itk::ImageRegionIterator<LabelImageType> labelIt(labelImage, labelImage->GetLargestPossibleRegion());
+    for (; !ctIt.IsAtEnd(); ++ctIt, ++labelIt)
+    {
+      const auto value = ctIt.Get();
+      labelIt.Set(value < 50 ? 0 : value < 120 ? 1 : value < 200 ? 2 : 3);
+    }
+
+    m_LabelImage = mitk::GrabItkImageMemory(labelImage);
+  }
+
+  void tearDown() override
+  {
+    m_CTImage = nullptr;
+    m_LabelImage = nullptr;
+  }
+
+  void CTImage()
+  {
+    const double zlibRatio = Benchmark("CT", m_CTImage, {"zlib, 1 thread", ContainerType::ZLib, -1, 1});
+    Benchmark("CT", m_CTImage, {"zlib, default threads", ContainerType::ZLib, -1, 0});
+    Benchmark("CT", m_CTImage, {"zlib level 1, default threads", ContainerType::ZLib, 1, 0});
+    Benchmark("CT", m_CTImage, {"zlib RLE, default threads", ContainerType::ZLibRunLength, -1, 0});
+    const double uncompressedRatio =
+      Benchmark("CT", m_CTImage, {"uncompressed", ContainerType::Uncompressed, -1, 0});
+
+    CPPUNIT_ASSERT(zlibRatio < 1.);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1., uncompressedRatio, 0.01);
+  }
+
+  void LabelImage()
+  {
+    const double zlibRatio = Benchmark("Label", m_LabelImage, {"zlib, 1 thread", ContainerType::ZLib, -1, 1});
+    Benchmark("Label", m_LabelImage, {"zlib, default threads", ContainerType::ZLib, -1, 0});
+    Benchmark("Label", m_LabelImage, {"zlib level 1, default threads", ContainerType::ZLib, 1, 0});
+    const double rleRatio =
+      Benchmark("Label", m_LabelImage, {"zlib RLE, default threads", ContainerType::ZLibRunLength, -1, 0});
+
+    CPPUNIT_ASSERT(zlibRatio < 0.5);
+    CPPUNIT_ASSERT(rleRatio < 0.5);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkCompressedImageContainerBenchmark)
@@ -162,6 +162,20 @@ int mitkCompressedImageContainerTest(int argc, char *argv[])
   // some real work
   mitkCompressedImageContainerTestClass::Test(container, image, numberFailed);
 
+  std::cout << "Testing small blocks on several threads" << std::endl;
+  container->SetBlockSize(4096);
+  container->SetNumberOfThreads(4);
+  mitkCompressedImageContainerTestClass::Test(container, image, numberFailed);
+
+  std::cout << "Testing run-length codec" << std::endl;
+  container->SetCodec(mitk::CompressedImageContainer::ZLibRunLength);
+  container->SetCompressionLevel(1);
+  mitkCompressedImageContainerTestClass::Test(container, image, numberFailed);
+
+  std::cout << "Testing uncompressed storage" << std::endl;
+  container->SetCodec(mitk::CompressedImageContainer::Uncompressed);
+  mitkCompressedImageContainerTestClass::Test(container, image, numberFailed);
+
   std::cout << "Testing destruction" << std::endl;
 
   // freeing
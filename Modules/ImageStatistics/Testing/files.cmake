@@ -1,13 +1,14 @@
-set(MODULE_TESTS
-  mitkImageStatisticsCalculatorTest.cpp
-  mitkPointSetStatisticsCalculatorTest.cpp
-  mitkPointSetDifferenceStatisticsCalculatorTest.cpp
-  mitkImageStatisticsTextureAnalysisTest.cpp
-  mitkImageStatisticsContainerTest.cpp
-  mitkImageStatisticsContainerManagerTest.cpp
-)
-
-set(MODULE_CUSTOM_TESTS
-  mitkImageStatisticsHotspotTest.cpp
-#  mitkMultiGaussianTest.cpp # TODO: activate test to generate new test cases for mitkImageStatisticsHotspotTest
-)
+set(MODULE_TESTS
+  mitkImageStatisticsCalculatorTest.cpp
+  mitkPointSetStatisticsCalculatorTest.cpp
+  mitkPointSetDifferenceStatisticsCalculatorTest.cpp
+  mitkImageStatisticsTextureAnalysisTest.cpp
+  mitkImageStatisticsContainerTest.cpp
+  mitkImageStatisticsContainerManagerTest.cpp
+  mitkMultiLabelStatisticsImageFilterTest.cpp
+)
+
+set(MODULE_CUSTOM_TESTS
+  mitkImageStatisticsHotspotTest.cpp
+#  mitkMultiGaussianTest.cpp # TODO: activate test to generate new test cases for mitkImageStatisticsHotspotTest
+)
@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include <mitkPlanarFigureMaskGenerator.h>
 #include <mitkImageMaskGenerator.h>
 #include <mitkImageStatisticsConstants.h>
+#include <mitkImagePixelWriteAccessor.h>
 
 /**
  * \brief Test class for mitkImageStatisticsCalculator
@@ -54,6 +55,8 @@ class mitkImageStatisticsCalculatorTestSuite : public mitk::TestFixture
   MITK_TEST(TestUS4DCroppedPlanarFigureTimeStep1);
   MITK_TEST(TestUS4DCroppedAllTimesteps);
   MITK_TEST(TestUS4DCropped3DMask);
+  MITK_TEST(TestIncrementalUpdate);
+  MITK_TEST(TestIncrementalUpdateChangingMinimum);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -84,6 +87,9 @@ public:
   void TestUS4DCroppedPlanarFigureTimeStep1();
   void TestUS4DCroppedAllTimesteps();
   void TestUS4DCropped3DMask();
+
+  void TestIncrementalUpdate();
+  void TestIncrementalUpdateChangingMinimum();
 private:
 	mitk::Image::ConstPointer m_TestImage;
 
@@ -100,6 +106,12 @@ private:
 
 	mitk::PlaneGeometry::Pointer m_Geometry;
 
+	// creates a 10x10x10 image with value x+y+z and a mask with label 1 in the cube [2,6]^3
+	void GenerateImageAndMask(mitk::Image::Pointer &image, mitk::Image::Pointer &mask);
+
+	void VerifyStatisticsAreEqual(const mitk::ImageStatisticsContainer::ImageStatisticsObject &stats,
+		const mitk::ImageStatisticsContainer::ImageStatisticsObject &expectedStats);
+
 	// creates a polygon given a geometry and a vector of 2d points
 	mitk::PlanarPolygon::Pointer GeneratePlanarPolygon(mitk::PlaneGeometry::Pointer geometry, std::vector <mitk::Point2D> points);
 
@@ -1026,6 +1038,166 @@ void mitkImageStatisticsCalculatorTestSuite::TestUS4DCropped3DMask()
 		expected_maxIndex);
 }
 
+void mitkImageStatisticsCalculatorTestSuite::TestIncrementalUpdate()
+{
+	MITK_INFO << std::endl << "Test incremental update:-----------------------------------------------------------------------------------";
+
+	mitk::Image::Pointer image;
+	mitk::Image::Pointer mask;
+	GenerateImageAndMask(image, mask);
+
+	mitk::ImageMaskGenerator::Pointer imgMaskGen = mitk::ImageMaskGenerator::New();
+	imgMaskGen->SetImageMask(mask);
+	imgMaskGen->SetInputImage(image.GetPointer());
+	imgMaskGen->SetTimeStep(0);
+
+	mitk::ImageStatisticsCalculator::Pointer imgStatCalc = mitk::ImageStatisticsCalculator::New();
+	imgStatCalc->SetInputImage(image);
+	imgStatCalc->SetMask(imgMaskGen.GetPointer());
+	imgStatCalc->IncrementalUpdateOn();
+	CPPUNIT_ASSERT_NO_THROW(imgStatCalc->GetStatistics(1));
+
+	// move voxels with values strictly inside the value ranges of label 0 (0..27) and label 1 (6..18)
+	{
+		mitk::ImagePixelWriteAccessor<unsigned short, 3> accessor(mask);
+		itk::Index<3> index = {{7, 4, 4}};
+		accessor.SetPixelByIndex(index, 1);
+		index[0] = 4;
+		accessor.SetPixelByIndex(index, 0);
+	}
+	mask->Modified();
+
+	itk::ImageRegion<3> changedRegion;
+	changedRegion.SetIndex({{4, 4, 4}});
+	changedRegion.SetSize({{4, 1, 1}});
+	CPPUNIT_ASSERT_MESSAGE("Incremental update failed", imgStatCalc->UpdateStatistics(mask, changedRegion, 0));
+
+	for (unsigned short label = 0; label < 2; ++label)
+	{
+		auto statisticsObject = imgStatCalc->GetStatistics(label)->GetStatisticsForTimeStep(0);
+		auto expectedStatisticsObject = ComputeStatistics(image.GetPointer(), imgMaskGen.GetPointer(), nullptr, label)->GetStatisticsForTimeStep(0);
+		VerifyStatisticsAreEqual(statisticsObject, expectedStatisticsObject);
+	}
+
+	CPPUNIT_ASSERT_EQUAL(mitk::ImageStatisticsContainer::VoxelCountType(125),
+		imgStatCalc->GetStatistics(1)->GetStatisticsForTimeStep(0).GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+}
+
+void mitkImageStatisticsCalculatorTestSuite::TestIncrementalUpdateChangingMinimum()
+{
+	MITK_INFO << std::endl << "Test incremental update changing the minimum:-----------------------------------------------------------------------------------";
+
+	mitk::Image::Pointer image;
+	mitk::Image::Pointer mask;
+	GenerateImageAndMask(image, mask);
+
+	mitk::ImageMaskGenerator::Pointer imgMaskGen = mitk::ImageMaskGenerator::New();
+	imgMaskGen->SetImageMask(mask);
+	imgMaskGen->SetInputImage(image.GetPointer());
+	imgMaskGen->SetTimeStep(0);
+
+	mitk::ImageStatisticsCalculator::Pointer imgStatCalc = mitk::ImageStatisticsCalculator::New();
+	imgStatCalc->SetInputImage(image);
+	imgStatCalc->SetMask(imgMaskGen.GetPointer());
+	imgStatCalc->IncrementalUpdateOn();
+	CPPUNIT_ASSERT_NO_THROW(imgStatCalc->GetStatistics(1));
+
+	// the value 0 is below the minimum of label 1
+	{
+		mitk::ImagePixelWriteAccessor<unsigned short, 3> accessor(mask);
+		itk::Index<3> index = {{0, 0, 0}};
+		accessor.SetPixelByIndex(index, 1);
+	}
+	mask->Modified();
+
+	itk::ImageRegion<3> changedRegion;
+	changedRegion.SetSize({{1, 1, 1}});
+	CPPUNIT_ASSERT_MESSAGE("Incremental update should not be possible", !imgStatCalc->UpdateStatistics(mask, changedRegion, 0));
+
+	// the statistics are calculated from scratch instead
+	auto statisticsObject = imgStatCalc->GetStatistics(1)->GetStatisticsForTimeStep(0);
+	auto expectedStatisticsObject = ComputeStatistics(image.GetPointer(), imgMaskGen.GetPointer(), nullptr, 1)->GetStatisticsForTimeStep(0);
+	VerifyStatisticsAreEqual(statisticsObject, expectedStatisticsObject);
+	CPPUNIT_ASSERT_EQUAL(mitk::ImageStatisticsContainer::RealType(0),
+		statisticsObject.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MINIMUM()));
+}
+
+void mitkImageStatisticsCalculatorTestSuite::GenerateImageAndMask(mitk::Image::Pointer &image, mitk::Image::Pointer &mask)
+{
+	unsigned int dimensions[] = { 10, 10, 10 };
+
+	image = mitk::Image::New();
+	image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions);
+	mask = mitk::Image::New();
+	mask->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 3, dimensions);
+
+	mitk::ImagePixelWriteAccessor<short, 3> imageAccessor(image);
+	mitk::ImagePixelWriteAccessor<unsigned short, 3> maskAccessor(mask);
+
+	itk::Index<3> index;
+	for (index[2] = 0; index[2] < 10; ++index[2])
+	{
+		for (index[1] = 0; index[1] < 10; ++index[1])
+		{
+			for (index[0] = 0; index[0] < 10; ++index[0])
+			{
+				imageAccessor.SetPixelByIndex(index, static_cast<short>(index[0] + index[1] + index[2]));
+
+				bool inside = true;
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					inside = inside && index[i] >= 2 && index[i] <= 6;
+				}
+				maskAccessor.SetPixelByIndex(index, inside ? 1 : 0);
+			}
+		}
+	}
+}
+
+void mitkImageStatisticsCalculatorTestSuite::VerifyStatisticsAreEqual(const mitk::ImageStatisticsContainer::ImageStatisticsObject &stats,
+	const mitk::ImageStatisticsContainer::ImageStatisticsObject &expectedStats)
+{
+	typedef mitk::ImageStatisticsContainer::RealType RealType;
+	typedef mitk::ImageStatisticsContainer::VoxelCountType VoxelCountType;
+	typedef mitk::ImageStatisticsContainer::IndexType IndexType;
+
+	CPPUNIT_ASSERT_EQUAL(expectedStats.GetValueConverted<VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()),
+		stats.GetValueConverted<VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+	CPPUNIT_ASSERT(expectedStats.GetValueConverted<IndexType>(mitk::ImageStatisticsConstants::MINIMUMPOSITION()) ==
+		stats.GetValueConverted<IndexType>(mitk::ImageStatisticsConstants::MINIMUMPOSITION()));
+	CPPUNIT_ASSERT(expectedStats.GetValueConverted<IndexType>(mitk::ImageStatisticsConstants::MAXIMUMPOSITION()) ==
+		stats.GetValueConverted<IndexType>(mitk::ImageStatisticsConstants::MAXIMUMPOSITION()));
+
+	const std::vector<std::string> names = {
+		mitk::ImageStatisticsConstants::VOLUME(), mitk::ImageStatisticsConstants::MEAN(),
+		mitk::ImageStatisticsConstants::MINIMUM(), mitk::ImageStatisticsConstants::MAXIMUM(),
+		mitk::ImageStatisticsConstants::STANDARDDEVIATION(), mitk::ImageStatisticsConstants::VARIANCE(),
+		mitk::ImageStatisticsConstants::SKEWNESS(), mitk::ImageStatisticsConstants::KURTOSIS(),
+		mitk::ImageStatisticsConstants::RMS(), mitk::ImageStatisticsConstants::MPP(),
+		mitk::ImageStatisticsConstants::ENTROPY(), mitk::ImageStatisticsConstants::MEDIAN(),
+		mitk::ImageStatisticsConstants::UNIFORMITY(), mitk::ImageStatisticsConstants::UPP() };
+
+	for (const auto &name : names)
+	{
+		const auto expectedValue = expectedStats.GetValueConverted<RealType>(name);
+		const auto value = stats.GetValueConverted<RealType>(name);
+		if (std::isnan(expectedValue))
+		{
+			CPPUNIT_ASSERT_MESSAGE(name, std::isnan(value));
+		}
+		else
+		{
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(name, expectedValue, value, 1e-6);
+		}
+	}
+
+	CPPUNIT_ASSERT_EQUAL(expectedStats.m_Histogram->Size(), stats.m_Histogram->Size());
+	for (unsigned int bin = 0; bin < expectedStats.m_Histogram->Size(); ++bin)
+	{
+		CPPUNIT_ASSERT_EQUAL(expectedStats.m_Histogram->GetFrequency(bin), stats.m_Histogram->GetFrequency(bin));
+	}
+}
+
 mitk::PlanarPolygon::Pointer mitkImageStatisticsCalculatorTestSuite::GeneratePlanarPolygon(mitk::PlaneGeometry::Pointer geometry, std::vector <mitk::Point2D> points)
 {
 	mitk::PlanarPolygon::Pointer figure = mitk::PlanarPolygon::New();
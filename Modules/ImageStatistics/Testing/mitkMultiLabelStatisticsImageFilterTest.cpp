@@ -0,0 +1,210 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include <mitkExtendedLabelStatisticsImageFilter.h>
+#include <mitkMinMaxLabelmageFilterWithIndex.h>
+#include <mitkMultiLabelStatisticsImageFilter.h>
+
+#include <itkImageRegionIteratorWithIndex.h>
+
+class mitkMultiLabelStatisticsImageFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkMultiLabelStatisticsImageFilterTestSuite);
+  MITK_TEST(IntegerImage);
+  MITK_TEST(FloatImageWithAdditionalPass);
+  MITK_TEST(BinSize);
+  MITK_TEST(UnknownLabel);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<unsigned short, 3> LabelImageType;
+
+  LabelImageType::Pointer m_LabelImage;
+
+  template <typename TImage>
+  typename TImage::Pointer CreateImage()
+  {
+    typename TImage::SizeType size;
+    size.Fill(24);
+
+    auto image = TImage::New();
+    image->SetRegions(size);
+    image->Allocate();
+
+    return image;
+  }
+
+  template <typename TImage>
+  void CompareWithLabelStatisticsFilters(const TImage *image,
+                                         const itk::MultiLabelStatisticsImageFilter<TImage, LabelImageType> *filter)
+  {
+    typedef itk::MinMaxLabelImageFilterWithIndex<TImage, LabelImageType> MinMaxFilterType;
+    typedef itk::ExtendedLabelStatisticsImageFilter<TImage, LabelImageType> StatisticsFilterType;
+    typedef typename TImage::PixelType PixelType;
+
+    auto minMaxFilter = MinMaxFilterType::New();
+    minMaxFilter->SetInput(image);
+    minMaxFilter->SetLabelInput(m_LabelImage);
+    minMaxFilter->UpdateLargestPossibleRegion();
+
+    std::map<unsigned short, PixelType> minimums;
+    std::map<unsigned short, PixelType> maximums;
+    std::map<unsigned short, unsigned int> numberOfBins;
+
+    for (auto label : minMaxFilter->GetRelevantLabels())
+    {
+      minimums[label] = minMaxFilter->GetMin(label);
+      maximums[label] = minMaxFilter->GetMax(label);
+      numberOfBins[label] = filter->GetNumberOfBins();
+    }
+
+    auto statisticsFilter = StatisticsFilterType::New();
+    statisticsFilter->SetInput(image);
+    statisticsFilter->SetLabelInput(m_LabelImage);
+    statisticsFilter->SetHistogramParametersForLabels(numberOfBins, minimums, maximums);
+    statisticsFilter->Update();
+
+    CPPUNIT_ASSERT_EQUAL(minMaxFilter->GetRelevantLabels().size(), filter->GetRelevantLabels().size());
+
+    for (auto label : minMaxFilter->GetRelevantLabels())
+    {
+      CPPUNIT_ASSERT(filter->HasLabel(label));
+      const auto &statistics = filter->GetLabelStatistics(label);
+
+      CPPUNIT_ASSERT_EQUAL(minMaxFilter->GetMin(label), statistics.m_Minimum);
+      CPPUNIT_ASSERT_EQUAL(minMaxFilter->GetMax(label), statistics.m_Maximum);
+      CPPUNIT_ASSERT_EQUAL(minMaxFilter->GetMinIndex(label), statistics.m_MinimumIndex);
+      CPPUNIT_ASSERT_EQUAL(minMaxFilter->GetMaxIndex(label), statistics.m_MaximumIndex);
+
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetCount(label), statistics.m_Count, mitk::eps);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetMean(label), statistics.m_Mean, 1e-6);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetSigma(label), statistics.m_Sigma, 1e-6);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetSkewness(label), statistics.m_Skewness, 1e-6);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetKurtosis(label), statistics.m_Kurtosis, 1e-6);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetMPP(label), statistics.m_MPP, 1e-6);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetMedian(label), statistics.m_Median, 1e-6);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetEntropy(label), statistics.m_Entropy, 1e-6);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetUniformity(label), statistics.m_Uniformity, 1e-6);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statisticsFilter->GetUPP(label), statistics.m_UPP, 1e-6);
+
+      auto expectedHistogram = statisticsFilter->GetHistogram(label);
+      CPPUNIT_ASSERT(statistics.m_Histogram.IsNotNull());
+      CPPUNIT_ASSERT_EQUAL(expectedHistogram->Size(), statistics.m_Histogram->Size());
+
+      for (unsigned int bin = 0; bin < expectedHistogram->Size(); ++bin)
+      {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(
+          expectedHistogram->GetFrequency(bin), statistics.m_Histogram->GetFrequency(bin), mitk::eps);
+      }
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_LabelImage = CreateImage<LabelImageType>();
+
+    // Three labels in slabs of different thickness and background
+    itk::ImageRegionIteratorWithIndex<LabelImageType> it(m_LabelImage, m_LabelImage->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      const auto z = it.GetIndex()[2];
+      it.Set(z < 4 ? 0 : z < 12 ? 1 : z < 14 ? 2 : 7);
+    }
+  }
+
+  void tearDown() override { m_LabelImage = nullptr; }
+
+  void IntegerImage()
+  {
+    typedef itk::Image<short, 3> ImageType;
+    auto image = CreateImage<ImageType>();
+
+    itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      const auto &index = it.GetIndex();
+      it.Set(static_cast<short>((index[0] * 7 + index[1] * 3 + index[2] * 11) % 200 - 50));
+    }
+
+    auto filter = itk::MultiLabelStatisticsImageFilter<ImageType, LabelImageType>::New();
+    filter->SetInput(image);
+    filter->SetLabelInput(m_LabelImage);
+    filter->Update();
+
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(0), filter->GetNumberOfHistogramsFilledInAdditionalPass());
+    this->CompareWithLabelStatisticsFilters<ImageType>(image, filter);
+  }
+
+  void FloatImageWithAdditionalPass()
+  {
+    typedef itk::Image<float, 3> ImageType;
+    auto image = CreateImage<ImageType>();
+
+    itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      const auto &index = it.GetIndex();
+      it.Set(std::sin(index[0] * 0.3f) * 100.f + index[1] * 0.37f - index[2] * 1.3f);
+    }
+
+    auto filter = itk::MultiLabelStatisticsImageFilter<ImageType, LabelImageType>::New();
+    filter->SetInput(image);
+    filter->SetLabelInput(m_LabelImage);
+    filter->SetMaximumNumberOfDistinctValues(16);
+    filter->Update();
+
+    CPPUNIT_ASSERT(filter->GetNumberOfHistogramsFilledInAdditionalPass() > 0);
+    this->CompareWithLabelStatisticsFilters<ImageType>(image, filter);
+  }
+
+  void BinSize()
+  {
+    typedef itk::Image<short, 3> ImageType;
+    auto image = CreateImage<ImageType>();
+
+    itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it)
+      it.Set(static_cast<short>(it.GetIndex()[0] * 20 + it.GetIndex()[2]));
+
+    auto filter = itk::MultiLabelStatisticsImageFilter<ImageType, LabelImageType>::New();
+    filter->SetInput(image);
+    filter->SetLabelInput(m_LabelImage);
+    filter->SetBinSize(5.0);
+    filter->UseBinSizeOn();
+    filter->Update();
+
+    // label 1 covers the values 4 to 471
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(93), filter->GetLabelStatistics(1).m_Histogram->Size());
+  }
+
+  void UnknownLabel()
+  {
+    typedef itk::Image<short, 3> ImageType;
+    auto image = CreateImage<ImageType>();
+    image->FillBuffer(1);
+
+    auto filter = itk::MultiLabelStatisticsImageFilter<ImageType, LabelImageType>::New();
+    filter->SetInput(image);
+    filter->SetLabelInput(m_LabelImage);
+    filter->Update();
+
+    CPPUNIT_ASSERT(!filter->HasLabel(3));
+    CPPUNIT_ASSERT_THROW(filter->GetLabelStatistics(3), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkMultiLabelStatisticsImageFilter)
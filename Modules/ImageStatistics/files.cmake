@@ -37,6 +37,7 @@ set(H_FILES
   mitkIgnorePixelMaskGenerator.h
   mitkMinMaxImageFilterWithIndex.h
   mitkMinMaxLabelmageFilterWithIndex.h
+  mitkMultiLabelStatisticsImageFilter.h
   mitkImageStatisticsPredicateHelper.h
   mitkImageStatisticsContainerNodeHelper.h
   mitkImageStatisticsContainerManager.h
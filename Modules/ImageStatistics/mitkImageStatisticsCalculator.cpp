@@ -11,8 +11,8 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkImageStatisticsCalculator.h"
-#include <mitkExtendedLabelStatisticsImageFilter.h>
 #include <mitkExtendedStatisticsImageFilter.h>
+#include <mitkHistogramStatisticsCalculator.h>
 #include <mitkImage.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
@@ -21,11 +21,46 @@ found in the LICENSE file.
 #include <mitkImageToItk.h>
 #include <mitkMaskUtilities.h>
 #include <mitkMinMaxImageFilterWithIndex.h>
-#include <mitkMinMaxLabelmageFilterWithIndex.h>
+#include <mitkMultiLabelStatisticsImageFilter.h>
 #include <mitkitkMaskImageFilter.h>
 
+#include <itkImageRegionConstIteratorWithIndex.h>
+
+#include <set>
+
 namespace mitk
 {
+  namespace
+  {
+    ImageStatisticsContainer::HistogramType::Pointer CopyHistogram(const ImageStatisticsContainer::HistogramType *histogram)
+    {
+      auto copy = ImageStatisticsContainer::HistogramType::New();
+      copy->SetMeasurementVectorSize(1);
+      copy->Initialize(histogram->GetSize());
+
+      for (unsigned int bin = 0; bin < histogram->Size(); ++bin)
+      {
+        copy->SetBinMin(0, bin, histogram->GetBinMin(0, bin));
+        copy->SetBinMax(0, bin, histogram->GetBinMax(0, bin));
+        copy->SetFrequency(bin, histogram->GetFrequency(bin));
+      }
+
+      return copy;
+    }
+
+    void ChangeFrequency(ImageStatisticsContainer::HistogramType *histogram, double value, bool increase)
+    {
+      ImageStatisticsContainer::HistogramType::MeasurementVectorType measurement(1);
+      ImageStatisticsContainer::HistogramType::IndexType index(1);
+      measurement[0] = value;
+      histogram->GetIndex(measurement, index);
+
+      const auto bin = histogram->GetInstanceIdentifier(index);
+      const auto frequency = histogram->GetFrequency(bin);
+      histogram->SetFrequency(bin, increase ? frequency + 1 : frequency - 1);
+    }
+  }
+
   void ImageStatisticsCalculator::SetInputImage(const mitk::Image *image)
   {
     if (image != m_Image)
@@ -104,6 +139,7 @@ namespace mitk
 
     if (IsUpdateRequired(label))
     {
+      m_IncrementalUpdateStates.clear();
       auto timeGeometry = m_Image->GetTimeGeometry();
       // always compute statistics on all timesteps
       for (unsigned int timeStep = 0; timeStep < m_Image->GetTimeSteps(); timeStep++)
@@ -167,6 +203,63 @@ namespace mitk
     }
   }
 
+  bool ImageStatisticsCalculator::UpdateStatistics(const mitk::Image *mask,
+                                                   const itk::ImageRegion<3> &changedRegion,
+                                                   TimeStepType timeStep)
+  {
+    auto stateIt = m_IncrementalUpdateStates.find(timeStep);
+
+    if (stateIt == m_IncrementalUpdateStates.end() || m_Image.IsNull() || nullptr == mask ||
+        mask->GetDimension() < 3 || timeStep >= mask->GetTimeSteps())
+    {
+      return false;
+    }
+
+    // only the mask may have changed since the statistics were calculated
+    const auto calculationTime = stateIt->second.CalculationTime.GetMTime();
+    if (this->GetMTime() > calculationTime || m_Image->GetMTime() > calculationTime)
+    {
+      m_IncrementalUpdateStates.clear();
+      return false;
+    }
+
+    // the time step of the mask shares the pixels of the mask, only the changed region is read
+    ImageTimeSelector::Pointer maskTimeSelector = ImageTimeSelector::New();
+    maskTimeSelector->SetInput(mask);
+    maskTimeSelector->SetTimeNr(timeStep);
+    maskTimeSelector->UpdateLargestPossibleRegion();
+    mitk::Image::Pointer maskTimeSlice = maskTimeSelector->GetOutput();
+
+    ChangedVoxelsType changedVoxels;
+    bool valid = false;
+    bool updated = false;
+
+    try
+    {
+      AccessFixedDimensionByItk_n(
+        maskTimeSlice, InternalCollectChangedVoxels, 3, (changedRegion, timeStep, changedVoxels, valid));
+
+      if (valid)
+      {
+        AccessFixedDimensionByItk_n(
+          stateIt->second.ImageTimeSlice, InternalUpdateStatisticsMasked, 3, (changedVoxels, timeStep, updated));
+      }
+    }
+    catch (const mitk::AccessByItkException &)
+    {
+      updated = false;
+    }
+
+    if (!updated)
+    {
+      // the statistics of the time step have to be calculated from scratch
+      m_IncrementalUpdateStates.clear();
+      this->Modified();
+    }
+
+    return updated;
+  }
+
   template <typename TPixel, unsigned int VImageDimension>
   void ImageStatisticsCalculator::InternalCalculateStatisticsUnmasked(
     typename itk::Image<TPixel, VImageDimension> *image, const TimeGeometry *timeGeometry, TimeStepType timeStep)
@@ -300,10 +393,8 @@ namespace mitk
     typedef itk::Image<TPixel, VImageDimension> ImageType;
     typedef itk::Image<MaskPixelType, VImageDimension> MaskType;
     typedef typename MaskType::PixelType LabelPixelType;
-    typedef itk::ExtendedLabelStatisticsImageFilter<ImageType, MaskType> ImageStatisticsFilterType;
+    typedef itk::MultiLabelStatisticsImageFilter<ImageType, MaskType> ImageStatisticsFilterType;
     typedef MaskUtilities<TPixel, VImageDimension> MaskUtilType;
-    typedef typename itk::MinMaxLabelImageFilterWithIndex<ImageType, MaskType> MinMaxLabelFilterType;
-    typedef typename ImageType::PixelType InputImgPixelType;
 
     // workaround: if m_SecondaryMaskGenerator ist not null but m_MaskGenerator is! (this is the case if we request a
     // 'ignore zuero valued pixels' mask in the gui but do not define a primary mask)
@@ -373,57 +464,34 @@ namespace mitk
 
     adaptedImage = maskUtil->ExtractMaskImageRegion(); // this also checks mask sanity
 
-    // find min, max, minindex and maxindex
-    typename MinMaxLabelFilterType::Pointer minMaxFilter = MinMaxLabelFilterType::New();
-    minMaxFilter->SetInput(adaptedImage);
-    minMaxFilter->SetLabelInput(maskImage);
-    minMaxFilter->UpdateLargestPossibleRegion();
-
-    // set histogram parameters for each label individually (min/max may be different for each label)
-    typedef typename std::map<LabelPixelType, InputImgPixelType> MapType;
-    typedef typename std::pair<LabelPixelType, InputImgPixelType> PairType;
-
-    std::vector<LabelPixelType> relevantLabels = minMaxFilter->GetRelevantLabels();
-    MapType minVals;
-    MapType maxVals;
-    std::map<LabelPixelType, unsigned int> nBins;
-
-    for (LabelPixelType label : relevantLabels)
-    {
-      minVals.insert(PairType(label, minMaxFilter->GetMin(label)));
-      maxVals.insert(PairType(label, minMaxFilter->GetMax(label)));
-
-      unsigned int nBinsForHistogram;
-      if (m_UseBinSizeOverNBins)
-      {
-        nBinsForHistogram =
-          std::max(static_cast<double>(std::ceil(minMaxFilter->GetMax(label) - minMaxFilter->GetMin(label))) /
-                     m_binSizeForHistogramStatistics,
-                   10.); // do not allow less than 10 bins
-      }
-      else
-      {
-        nBinsForHistogram = m_nBinsForHistogramStatistics;
-      }
-
-      nBins.insert(typename std::pair<LabelPixelType, unsigned int>(label, nBinsForHistogram));
-    }
-
+    // min, max, their indices, moments and histograms of all labels are calculated in a single pass
     typename ImageStatisticsFilterType::Pointer imageStatisticsFilter = ImageStatisticsFilterType::New();
     imageStatisticsFilter->SetDirectionTolerance(0.001);
     imageStatisticsFilter->SetCoordinateTolerance(0.001);
     imageStatisticsFilter->SetInput(adaptedImage);
     imageStatisticsFilter->SetLabelInput(maskImage);
-    imageStatisticsFilter->SetHistogramParametersForLabels(nBins, minVals, maxVals);
-    imageStatisticsFilter->Update();
+    imageStatisticsFilter->SetNumberOfBins(m_nBinsForHistogramStatistics);
+    imageStatisticsFilter->SetBinSize(m_binSizeForHistogramStatistics);
+    imageStatisticsFilter->SetUseBinSize(m_UseBinSizeOverNBins);
+
+    try
+    {
+      imageStatisticsFilter->Update();
+    }
+    catch (const itk::ExceptionObject &e)
+    {
+      mitkThrow() << "Image statistics calculation failed due to following ITK Exception: \n " << e.what();
+    }
 
-    std::list<int> labels = imageStatisticsFilter->GetRelevantLabels();
-    auto it = labels.begin();
+    auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
 
-    while (it != labels.end())
+    for (const auto &labelStatisticsPair : imageStatisticsFilter->GetAllLabelStatistics())
     {
+      const LabelPixelType label = labelStatisticsPair.first;
+      const auto &labelStatistics = labelStatisticsPair.second;
+
       ImageStatisticsContainer::Pointer statisticContainerForLabelImage;
-      auto labelIt = m_StatisticContainers.find(*it);
+      auto labelIt = m_StatisticContainers.find(label);
       // reset if statisticContainer already exist
       if (labelIt != m_StatisticContainers.end())
       {
@@ -434,29 +502,25 @@ namespace mitk
       {
         statisticContainerForLabelImage = ImageStatisticsContainer::New();
         statisticContainerForLabelImage->SetTimeGeometry(const_cast<mitk::TimeGeometry*>(timeGeometry));
-        // link label (*it) to statisticContainer
-        m_StatisticContainers.emplace(*it, statisticContainerForLabelImage);
+        // link label to statisticContainer
+        m_StatisticContainers.emplace(label, statisticContainerForLabelImage);
       }
 
       ImageStatisticsContainer::ImageStatisticsObject statObj;
 
-      // find min, max, minindex and maxindex
-      // make sure to only look in the masked region, use a masker for this
-
       vnl_vector<int> minIndex, maxIndex;
       mitk::Point3D worldCoordinateMin;
       mitk::Point3D worldCoordinateMax;
       mitk::Point3D indexCoordinateMin;
       mitk::Point3D indexCoordinateMax;
-      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMinIndex(*it), worldCoordinateMin);
-      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMaxIndex(*it), worldCoordinateMax);
+      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(labelStatistics.m_MinimumIndex, worldCoordinateMin);
+      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(labelStatistics.m_MaximumIndex, worldCoordinateMax);
       m_Image->GetGeometry()->WorldToIndex(worldCoordinateMin, indexCoordinateMin);
       m_Image->GetGeometry()->WorldToIndex(worldCoordinateMax, indexCoordinateMax);
 
       minIndex.set_size(3);
       maxIndex.set_size(3);
 
-      // for (unsigned int i=0; i < tmpMaxIndex.GetIndexDimension(); i++)
       for (unsigned int i = 0; i < 3; i++)
       {
         minIndex[i] = indexCoordinateMin[i];
@@ -466,36 +530,69 @@ namespace mitk
       statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
       statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
 
-      assert(std::abs(minMaxFilter->GetMax(*it) - imageStatisticsFilter->GetMaximum(*it)) < mitk::eps);
-      assert(std::abs(minMaxFilter->GetMin(*it) - imageStatisticsFilter->GetMinimum(*it)) < mitk::eps);
-
-      auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
-      auto numberOfVoxels =
-        static_cast<unsigned long>(imageStatisticsFilter->GetSum(*it) / (double)imageStatisticsFilter->GetMean(*it));
+      auto numberOfVoxels = static_cast<unsigned long>(labelStatistics.m_Count);
       auto volume = static_cast<double>(numberOfVoxels) * voxelVolume;
-      auto rms = std::sqrt(std::pow(imageStatisticsFilter->GetMean(*it), 2.) +
-                           imageStatisticsFilter->GetVariance(*it)); // variance = sigma^2
-      auto variance = imageStatisticsFilter->GetSigma(*it) * imageStatisticsFilter->GetSigma(*it);
+      auto rms = std::sqrt(labelStatistics.m_Mean * labelStatistics.m_Mean +
+                           labelStatistics.m_Variance); // variance = sigma^2
+      auto variance = labelStatistics.m_Sigma * labelStatistics.m_Sigma;
 
       statObj.AddStatistic(mitk::ImageStatisticsConstants::NUMBEROFVOXELS(), numberOfVoxels);
       statObj.AddStatistic(mitk::ImageStatisticsConstants::VOLUME(), volume);
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), imageStatisticsFilter->GetMean(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUM(), imageStatisticsFilter->GetMinimum(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUM(), imageStatisticsFilter->GetMaximum(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), imageStatisticsFilter->GetSigma(*it));
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), labelStatistics.m_Mean);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUM(),
+                           static_cast<ImageStatisticsContainer::RealType>(labelStatistics.m_Minimum));
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUM(),
+                           static_cast<ImageStatisticsContainer::RealType>(labelStatistics.m_Maximum));
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), labelStatistics.m_Sigma);
       statObj.AddStatistic(mitk::ImageStatisticsConstants::VARIANCE(), variance);
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), imageStatisticsFilter->GetSkewness(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), imageStatisticsFilter->GetKurtosis(*it));
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), labelStatistics.m_Skewness);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), labelStatistics.m_Kurtosis);
       statObj.AddStatistic(mitk::ImageStatisticsConstants::RMS(), rms);
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), imageStatisticsFilter->GetMPP(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), imageStatisticsFilter->GetEntropy(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), imageStatisticsFilter->GetMedian(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), imageStatisticsFilter->GetUniformity(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), imageStatisticsFilter->GetUPP(*it));
-      statObj.m_Histogram = imageStatisticsFilter->GetHistogram(*it).GetPointer();
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), labelStatistics.m_MPP);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), labelStatistics.m_Entropy);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), labelStatistics.m_Median);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), labelStatistics.m_Uniformity);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), labelStatistics.m_UPP);
+      statObj.m_Histogram = labelStatistics.m_Histogram.GetPointer();
 
       statisticContainerForLabelImage->SetStatisticsForTimeStep(timeStep, statObj);
-      ++it;
+    }
+
+    // keep the labels of the mask and the moments of all labels to be able to update the statistics after the mask
+    // has been edited, see UpdateStatistics()
+    if (m_IncrementalUpdate && 3 == VImageDimension && m_SecondaryMaskGenerator.IsNull() &&
+        maskImage->GetLargestPossibleRegion() == image->GetLargestPossibleRegion() &&
+        maskImage->GetBufferedRegion() == maskImage->GetLargestPossibleRegion())
+    {
+      IncrementalUpdateState &state = m_IncrementalUpdateStates[timeStep];
+      state.CalculationTime.Modified();
+      state.ImageTimeSlice = m_ImageTimeSlice;
+
+      const auto &maskRegion = maskImage->GetLargestPossibleRegion();
+      for (unsigned int i = 0; i < VImageDimension; ++i)
+      {
+        state.MaskRegion.SetIndex(i, maskRegion.GetIndex(i));
+        state.MaskRegion.SetSize(i, maskRegion.GetSize(i));
+      }
+
+      state.MaskLabels.assign(maskImage->GetBufferPointer(),
+                              maskImage->GetBufferPointer() + maskRegion.GetNumberOfPixels());
+      state.Labels.clear();
+
+      for (const auto &labelStatisticsPair : imageStatisticsFilter->GetAllLabelStatistics())
+      {
+        const auto &labelStatistics = labelStatisticsPair.second;
+        state.Labels[labelStatisticsPair.first] = LabelMoments{labelStatistics.m_Count,
+                                                               labelStatistics.m_PositivePixelCount,
+                                                               labelStatistics.m_Sum,
+                                                               labelStatistics.m_SumOfPositivePixels,
+                                                               labelStatistics.m_SumOfSquares,
+                                                               labelStatistics.m_SumOfCubes,
+                                                               labelStatistics.m_SumOfQuadruples,
+                                                               static_cast<double>(labelStatistics.m_Minimum),
+                                                               static_cast<double>(labelStatistics.m_Maximum),
+                                                               labelStatistics.m_Histogram};
+      }
     }
 
     // swap maskGenerators back
@@ -506,6 +603,182 @@ namespace mitk
     }
   }
 
+  template <typename TPixel, unsigned int VImageDimension>
+  void ImageStatisticsCalculator::InternalCollectChangedVoxels(typename itk::Image<TPixel, VImageDimension> *mask,
+                                                               const itk::ImageRegion<3> &changedRegion,
+                                                               TimeStepType timeStep,
+                                                               ChangedVoxelsType &changedVoxels,
+                                                               bool &valid)
+  {
+    const IncrementalUpdateState &state = m_IncrementalUpdateStates[timeStep];
+
+    valid = mask->GetLargestPossibleRegion() == state.MaskRegion && mask->GetBufferedRegion() == state.MaskRegion;
+
+    if (!valid)
+    {
+      return;
+    }
+
+    auto region = changedRegion;
+    if (!region.Crop(state.MaskRegion))
+    {
+      return;
+    }
+
+    itk::ImageRegionConstIteratorWithIndex<itk::Image<TPixel, VImageDimension>> it(mask, region);
+    for (; !it.IsAtEnd(); ++it)
+    {
+      const auto label = static_cast<MaskPixelType>(it.Get());
+      const auto offset = static_cast<std::size_t>(mask->ComputeOffset(it.GetIndex()));
+
+      if (label != state.MaskLabels[offset])
+      {
+        changedVoxels.emplace_back(offset, label);
+      }
+    }
+  }
+
+  template <typename TPixel, unsigned int VImageDimension>
+  void ImageStatisticsCalculator::InternalUpdateStatisticsMasked(typename itk::Image<TPixel, VImageDimension> *image,
+                                                                 const ChangedVoxelsType &changedVoxels,
+                                                                 TimeStepType timeStep,
+                                                                 bool &updated)
+  {
+    updated = false;
+    IncrementalUpdateState &state = m_IncrementalUpdateStates[timeStep];
+
+    if (image->GetLargestPossibleRegion() != state.MaskRegion || image->GetBufferedRegion() != state.MaskRegion)
+    {
+      return;
+    }
+
+    const TPixel *buffer = image->GetBufferPointer();
+    std::set<LabelIndex> changedLabels;
+
+    // the histograms are shared with the statistics handed out before, so they are copied before being modified
+    auto getMoments = [&state, &changedLabels](LabelIndex label) -> LabelMoments * {
+      auto momentsIt = state.Labels.find(label);
+      if (changedLabels.insert(label).second)
+      {
+        momentsIt->second.Histogram = CopyHistogram(momentsIt->second.Histogram);
+      }
+
+      return &momentsIt->second;
+    };
+
+    // the minimum, maximum and histogram range of both labels only stay the same if the value lies strictly inside
+    // the range of the previous label and inside the range of the new label. All voxels are checked before any
+    // statistics are changed, so that nothing is changed if the update is not possible.
+    for (const auto &changedVoxel : changedVoxels)
+    {
+      auto previousMomentsIt = state.Labels.find(state.MaskLabels[changedVoxel.first]);
+      auto momentsIt = state.Labels.find(changedVoxel.second);
+      const auto value = static_cast<double>(buffer[changedVoxel.first]);
+
+      if (previousMomentsIt == state.Labels.end() || momentsIt == state.Labels.end() ||
+          value <= previousMomentsIt->second.Minimum || value >= previousMomentsIt->second.Maximum ||
+          value < momentsIt->second.Minimum || value > momentsIt->second.Maximum)
+      {
+        return;
+      }
+    }
+
+    for (const auto &changedVoxel : changedVoxels)
+    {
+      LabelMoments *previousMoments = getMoments(state.MaskLabels[changedVoxel.first]);
+      LabelMoments *moments = getMoments(changedVoxel.second);
+      const auto value = static_cast<double>(buffer[changedVoxel.first]);
+      const double squaredValue = value * value;
+
+      --previousMoments->Count;
+      previousMoments->Sum -= value;
+      previousMoments->SumOfSquares -= squaredValue;
+      previousMoments->SumOfCubes -= squaredValue * value;
+      previousMoments->SumOfQuadruples -= squaredValue * squaredValue;
+      ChangeFrequency(previousMoments->Histogram, value, false);
+
+      ++moments->Count;
+      moments->Sum += value;
+      moments->SumOfSquares += squaredValue;
+      moments->SumOfCubes += squaredValue * value;
+      moments->SumOfQuadruples += squaredValue * squaredValue;
+      ChangeFrequency(moments->Histogram, value, true);
+
+      if (value > 0)
+      {
+        --previousMoments->PositivePixelCount;
+        previousMoments->SumOfPositivePixels -= value;
+        ++moments->PositivePixelCount;
+        moments->SumOfPositivePixels += value;
+      }
+
+      state.MaskLabels[changedVoxel.first] = changedVoxel.second;
+    }
+
+    auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
+
+    for (LabelIndex label : changedLabels)
+    {
+      auto containerIt = m_StatisticContainers.find(label);
+      if (containerIt == m_StatisticContainers.end())
+      {
+        continue;
+      }
+
+      const LabelMoments &moments = state.Labels[label];
+      const auto count = static_cast<double>(moments.Count);
+      const double mean = moments.Sum / count;
+      const double variance = (moments.SumOfSquares - moments.Sum * moments.Sum / count) / count;
+      const double sigma = std::sqrt(variance);
+
+      // same as itk::ExtendedLabelStatisticsImageFilter
+      const double secondMoment = moments.SumOfSquares / count;
+      const double thirdMoment = moments.SumOfCubes / count;
+      const double fourthMoment = moments.SumOfQuadruples / count;
+      const double centralSecondMoment = secondMoment - mean * mean;
+      const double skewness =
+        (thirdMoment - 3. * secondMoment * mean + 2. * mean * mean * mean) / std::pow(centralSecondMoment, 1.5);
+      const double kurtosis =
+        (fourthMoment - 4. * thirdMoment * mean + 6. * secondMoment * mean * mean - 3. * mean * mean * mean * mean) /
+        (centralSecondMoment * centralSecondMoment);
+
+      HistogramStatisticsCalculator histogramStatisticsCalculator;
+      histogramStatisticsCalculator.SetHistogram(moments.Histogram);
+      histogramStatisticsCalculator.CalculateStatistics();
+
+      // positions, minimum and maximum are unchanged
+      auto statObj = containerIt->second->GetStatisticsForTimeStep(timeStep);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::NUMBEROFVOXELS(), moments.Count);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::VOLUME(), count * voxelVolume);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), mean);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), sigma);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::VARIANCE(), sigma * sigma);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), skewness);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), kurtosis);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::RMS(), std::sqrt(mean * mean + variance));
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(),
+                           moments.SumOfPositivePixels / static_cast<double>(moments.PositivePixelCount));
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), histogramStatisticsCalculator.GetEntropy());
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), histogramStatisticsCalculator.GetMedian());
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), histogramStatisticsCalculator.GetUniformity());
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), histogramStatisticsCalculator.GetUPP());
+      statObj.m_Histogram = moments.Histogram.GetPointer();
+
+      containerIt->second->SetStatisticsForTimeStep(timeStep, statObj);
+    }
+
+    // the statistics of the other labels are still up to date, although the mask generator was modified
+    for (auto &container : m_StatisticContainers)
+    {
+      if (changedLabels.find(container.first) == changedLabels.end())
+      {
+        container.second->Modified();
+      }
+    }
+
+    updated = true;
+  }
+
   bool ImageStatisticsCalculator::IsUpdateRequired(LabelIndex label) const
   {
     unsigned long thisClassTimeStamp = this->GetMTime();
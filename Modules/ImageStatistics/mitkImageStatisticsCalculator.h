@@ -18,6 +18,8 @@ found in the LICENSE file.
 #include <mitkMaskGenerator.h>
 #include <mitkImageStatisticsContainer.h>
 
+#include <itkImageRegion.h>
+
 namespace mitk
 {
     class MITKIMAGESTATISTICS_EXPORT ImageStatisticsCalculator: public itk::Object
@@ -76,11 +78,32 @@ namespace mitk
          */
         ImageStatisticsContainer* GetStatistics(LabelIndex label=1);
 
+        /**Documentation
+        @brief Set whether GetStatistics() keeps what UpdateStatistics() needs to update the statistics after the mask has been edited.
+        This is a copy of the mask labels and the moments of each label per time step. It is only kept for 3D masks without secondary mask.
+        Off by default.*/
+        itkSetMacro(IncrementalUpdate, bool);
+        itkGetConstMacro(IncrementalUpdate, bool);
+        itkBooleanMacro(IncrementalUpdate);
+
+        /**Documentation
+        @brief Updates the statistics of all labels after time step @a timeStep of the mask has been edited inside @a changedRegion.
+        @a mask is the edited mask, which may be the image passed to the mask generator or a newer version of it, e.g. if the generator
+        got a copy. The region is given in index coordinates of the mask. Only the voxels inside the region are visited: voxels whose label has
+        changed are removed from the statistics of their previous label and added to the statistics of their new label.
+        This requires IncrementalUpdate to be on, that the statistics of the time step have been calculated with a 3D mask (without secondary
+        mask) by GetStatistics() and that only the mask has been modified since. Returns false if the statistics cannot be updated
+        incrementally, e.g. if the edit changes the minimum or maximum of a label or adds or removes a label. In this case, the statistics are
+        left unchanged and calculated from scratch by the next call of GetStatistics().
+         */
+        bool UpdateStatistics(const mitk::Image *mask, const itk::ImageRegion<3> &changedRegion, TimeStepType timeStep = 0);
+
     protected:
         ImageStatisticsCalculator(){
             m_nBinsForHistogramStatistics = 100;
             m_binSizeForHistogramStatistics = 10;
             m_UseBinSizeOverNBins = false;
+            m_IncrementalUpdate = false;
         };
 
 
@@ -96,8 +119,44 @@ namespace mitk
         template < typename TPixel, unsigned int VImageDimension >
         double GetVoxelVolume(typename itk::Image<TPixel, VImageDimension>* image) const;
 
+        /** Offsets of the voxels of a mask whose label has changed together with their new label */
+        typedef std::vector<std::pair<std::size_t, MaskPixelType>> ChangedVoxelsType;
+
+        template < typename TPixel, unsigned int VImageDimension > void InternalCollectChangedVoxels(
+                typename itk::Image< TPixel, VImageDimension >* mask, const itk::ImageRegion<3>& changedRegion,
+                TimeStepType timeStep, ChangedVoxelsType& changedVoxels, bool& valid);
+
+        template < typename TPixel, unsigned int VImageDimension > void InternalUpdateStatisticsMasked(
+                typename itk::Image< TPixel, VImageDimension >* image, const ChangedVoxelsType& changedVoxels,
+                TimeStepType timeStep, bool& updated);
+
         bool IsUpdateRequired(LabelIndex label) const;
 
+        /** Sums of the voxel values of a label from which its statistics can be updated incrementally */
+        struct LabelMoments
+        {
+          ImageStatisticsContainer::VoxelCountType Count;
+          ImageStatisticsContainer::VoxelCountType PositivePixelCount;
+          double Sum;
+          double SumOfPositivePixels;
+          double SumOfSquares;
+          double SumOfCubes;
+          double SumOfQuadruples;
+          double Minimum;
+          double Maximum;
+          HistogramType::Pointer Histogram;
+        };
+
+        /** The image, the labels of the mask and the moments of each label the statistics of a time step were calculated with */
+        struct IncrementalUpdateState
+        {
+          itk::TimeStamp CalculationTime;
+          mitk::Image::Pointer ImageTimeSlice;
+          itk::ImageRegion<3> MaskRegion;
+          std::vector<MaskPixelType> MaskLabels;
+          std::map<LabelIndex, LabelMoments> Labels;
+        };
+
         mitk::Image::ConstPointer m_Image;
         mitk::Image::Pointer m_ImageTimeSlice;
         mitk::Image::ConstPointer m_InternalImageForStatistics;
@@ -111,8 +170,11 @@ namespace mitk
         unsigned int m_nBinsForHistogramStatistics;
         double m_binSizeForHistogramStatistics;
         bool m_UseBinSizeOverNBins;
+        bool m_IncrementalUpdate;
 
         std::map<LabelIndex,ImageStatisticsContainer::Pointer> m_StatisticContainers;
+
+        std::map<TimeStepType, IncrementalUpdateState> m_IncrementalUpdateStates;
     };
 
 }
@@ -40,7 +40,7 @@ namespace mitk
 
   void ImageStatisticsContainer::ImageStatisticsObject::AddStatistic(const std::string &key, StatisticsVariantType value)
   {
-    m_Statistics.emplace(key, value);
+    m_Statistics[key] = value;
 
     if (std::find(m_DefaultNames.cbegin(), m_DefaultNames.cend(), key) == m_DefaultNames.cend())
     {
@@ -135,7 +135,7 @@ namespace mitk
   {
     if (timeStep < this->GetTimeSteps())
     {
-      m_TimeStepMap.emplace(timeStep, statistics);
+      m_TimeStepMap[timeStep] = statistics;
       this->Modified();
     }
     else
@@ -0,0 +1,196 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITK_MULTILABELSTATISTICSIMAGEFILTER_H
+#define MITK_MULTILABELSTATISTICSIMAGEFILTER_H
+
+#include <itkHistogram.h>
+#include <itkImage.h>
+#include <itkImageToImageFilter.h>
+#include <itkMultiThreader.h>
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace itk
+{
+  /**
+   * \brief Calculates the statistics of all labels of a label image in a single pass over the image.
+   *
+   * For each label the moments (mean, variance, skewness, kurtosis), the minimum and maximum together
+   * with their indices, the MPP and a histogram with the histogram statistics (median, entropy,
+   * uniformity, UPP) are calculated. The statistics are equal to the ones of
+   * itk::ExtendedLabelStatisticsImageFilter with per label histogram parameters taken from
+   * itk::MinMaxLabelImageFilterWithIndex, but without the separate passes of both filters.
+   *
+   * The histogram of each label ranges from the minimum to the maximum of the label, which is not known
+   * before the image has been scanned. Therefore, each thread counts the distinct pixel values of each
+   * label and the histograms are filled from these counts afterwards. Only if a label has more than
+   * MaximumNumberOfDistinctValues distinct values in a thread, e.g. for floating point images, its
+   * histogram is filled in an additional multithreaded pass.
+   *
+   * Each thread accumulates the statistics of its part of the image, the partial results are merged
+   * at the end. Pixel values are passed through as output.
+   */
+  template <typename TInputImage, typename TLabelImage>
+  class MultiLabelStatisticsImageFilter : public ImageToImageFilter<TInputImage, TInputImage>
+  {
+  public:
+    typedef MultiLabelStatisticsImageFilter Self;
+    typedef ImageToImageFilter<TInputImage, TInputImage> Superclass;
+    typedef SmartPointer<Self> Pointer;
+    typedef SmartPointer<const Self> ConstPointer;
+
+    itkNewMacro(Self);
+    itkTypeMacro(MultiLabelStatisticsImageFilter, ImageToImageFilter);
+
+    typedef typename TInputImage::RegionType RegionType;
+    typedef typename TInputImage::IndexType IndexType;
+    typedef typename TInputImage::PixelType PixelType;
+    typedef typename TLabelImage::PixelType LabelPixelType;
+    typedef double RealType;
+    typedef Statistics::Histogram<double> HistogramType;
+
+    /** \brief Statistics of a single label. */
+    class LabelStatistics
+    {
+    public:
+      LabelStatistics();
+
+      IdentifierType m_Count;
+      IdentifierType m_PositivePixelCount;
+      RealType m_Sum;
+      RealType m_SumOfPositivePixels;
+      RealType m_SumOfSquares;
+      RealType m_SumOfCubes;
+      RealType m_SumOfQuadruples;
+
+      PixelType m_Minimum;
+      PixelType m_Maximum;
+      IndexType m_MinimumIndex;
+      IndexType m_MaximumIndex;
+
+      RealType m_Mean;
+      RealType m_Variance;
+      RealType m_Sigma;
+      RealType m_Skewness;
+      RealType m_Kurtosis;
+      RealType m_MPP;
+      RealType m_Median;
+      RealType m_Entropy;
+      RealType m_Uniformity;
+      RealType m_UPP;
+
+      HistogramType::Pointer m_Histogram;
+    };
+
+    typedef std::map<LabelPixelType, LabelStatistics> LabelStatisticsMapType;
+
+    /** Set the label image */
+    void SetLabelInput(const TLabelImage *input)
+    {
+      // Process object is not const-correct so the const casting is required.
+      this->SetNthInput(1, const_cast<TLabelImage *>(input));
+    }
+
+    /** Get the label image */
+    const TLabelImage *GetLabelInput() const
+    {
+      return itkDynamicCastInDebugMode<TLabelImage *>(const_cast<DataObject *>(this->ProcessObject::GetInput(1)));
+    }
+
+    /** Number of histogram bins of each label if UseBinSize is off. Default is 100. */
+    itkSetMacro(NumberOfBins, unsigned int);
+    itkGetConstMacro(NumberOfBins, unsigned int);
+
+    /** Histogram bin size if UseBinSize is on. The number of bins of a label is then derived
+     * from its value range, but is at least 10. Default is 10. */
+    itkSetMacro(BinSize, double);
+    itkGetConstMacro(BinSize, double);
+
+    itkSetMacro(UseBinSize, bool);
+    itkGetConstMacro(UseBinSize, bool);
+    itkBooleanMacro(UseBinSize);
+
+    /** Maximum number of distinct values per label and thread that are counted during the
+     * first pass. Default is 65536. */
+    itkSetMacro(MaximumNumberOfDistinctValues, SizeValueType);
+    itkGetConstMacro(MaximumNumberOfDistinctValues, SizeValueType);
+
+    /** Returns all labels that occur in the label image in ascending order. */
+    std::vector<LabelPixelType> GetRelevantLabels() const;
+
+    bool HasLabel(LabelPixelType label) const { return m_LabelStatistics.find(label) != m_LabelStatistics.end(); }
+
+    /** Returns the statistics of a label. Throws if the label does not occur in the label image. */
+    const LabelStatistics &GetLabelStatistics(LabelPixelType label) const;
+
+    const LabelStatisticsMapType &GetAllLabelStatistics() const { return m_LabelStatistics; }
+
+    /** Number of histograms that had to be filled in an additional pass during the last update. */
+    itkGetConstMacro(NumberOfHistogramsFilledInAdditionalPass, SizeValueType);
+
+  protected:
+    MultiLabelStatisticsImageFilter();
+    ~MultiLabelStatisticsImageFilter() override {}
+
+    void AllocateOutputs() override;
+
+    void BeforeThreadedGenerateData() override;
+
+    void ThreadedGenerateData(const RegionType &outputRegionForThread, ThreadIdType threadId) override;
+
+    void AfterThreadedGenerateData() override;
+
+  private:
+    MultiLabelStatisticsImageFilter(const Self &) = delete;
+    void operator=(const Self &) = delete;
+
+    /** \brief Partial result of a thread for a single label. */
+    struct LabelAccumulator
+    {
+      LabelAccumulator() : m_ValueCountsComplete(true) {}
+
+      LabelStatistics m_Statistics;
+      std::unordered_map<PixelType, SizeValueType> m_ValueCounts;
+      bool m_ValueCountsComplete;
+    };
+
+    typedef std::map<LabelPixelType, LabelAccumulator> AccumulatorMapType;
+
+    unsigned int GetNumberOfBins(const LabelStatistics &statistics) const;
+
+    void ThreadedFillHistograms(const RegionType &regionForThread, ThreadIdType threadId);
+
+    static ITK_THREAD_RETURN_TYPE FillHistogramsThreaderCallback(void *arg);
+
+    unsigned int m_NumberOfBins;
+    double m_BinSize;
+    bool m_UseBinSize;
+    SizeValueType m_MaximumNumberOfDistinctValues;
+
+    std::vector<AccumulatorMapType> m_ThreadAccumulators;
+    LabelStatisticsMapType m_LabelStatistics;
+
+    /** Labels whose histograms are filled in the additional pass and the frequencies found by each thread */
+    std::map<LabelPixelType, HistogramType::Pointer> m_IncompleteHistograms;
+    std::vector<std::map<LabelPixelType, std::vector<double>>> m_ThreadFrequencies;
+    SizeValueType m_NumberOfHistogramsFilledInAdditionalPass;
+  };
+}
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "mitkMultiLabelStatisticsImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,416 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITK_MULTILABELSTATISTICSIMAGEFILTER_HXX
+#define MITK_MULTILABELSTATISTICSIMAGEFILTER_HXX
+
+#include "mitkMultiLabelStatisticsImageFilter.h"
+
+#include <itkImageRegionConstIterator.h>
+#include <itkImageRegionConstIteratorWithIndex.h>
+#include <mitkExceptionMacro.h>
+#include <mitkHistogramStatisticsCalculator.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+  template <typename TInputImage, typename TLabelImage>
+  MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::LabelStatistics::LabelStatistics()
+    : m_Count(0),
+      m_PositivePixelCount(0),
+      m_Sum(0.0),
+      m_SumOfPositivePixels(0.0),
+      m_SumOfSquares(0.0),
+      m_SumOfCubes(0.0),
+      m_SumOfQuadruples(0.0),
+      m_Minimum(NumericTraits<PixelType>::max()),
+      m_Maximum(NumericTraits<PixelType>::NonpositiveMin()),
+      m_Mean(0.0),
+      m_Variance(0.0),
+      m_Sigma(0.0),
+      m_Skewness(0.0),
+      m_Kurtosis(0.0),
+      m_MPP(0.0),
+      m_Median(0.0),
+      m_Entropy(0.0),
+      m_Uniformity(0.0),
+      m_UPP(0.0)
+  {
+    m_MinimumIndex.Fill(0);
+    m_MaximumIndex.Fill(0);
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::MultiLabelStatisticsImageFilter()
+    : m_NumberOfBins(100),
+      m_BinSize(10.0),
+      m_UseBinSize(false),
+      m_MaximumNumberOfDistinctValues(65536),
+      m_NumberOfHistogramsFilledInAdditionalPass(0)
+  {
+    this->SetNumberOfRequiredInputs(2);
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  std::vector<typename MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::LabelPixelType>
+    MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::GetRelevantLabels() const
+  {
+    std::vector<LabelPixelType> labels;
+    labels.reserve(m_LabelStatistics.size());
+
+    for (const auto &labelStatistics : m_LabelStatistics)
+      labels.push_back(labelStatistics.first);
+
+    return labels;
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  const typename MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::LabelStatistics &
+    MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::GetLabelStatistics(LabelPixelType label) const
+  {
+    auto it = m_LabelStatistics.find(label);
+
+    if (it == m_LabelStatistics.end())
+      mitkThrow() << "Label does not exist";
+
+    return it->second;
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  void MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::AllocateOutputs()
+  {
+    // Pass the input through as the output
+    typename TInputImage::Pointer image = const_cast<TInputImage *>(this->GetInput());
+    this->GraftOutput(image);
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  void MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::BeforeThreadedGenerateData()
+  {
+    m_ThreadAccumulators.clear();
+    m_ThreadAccumulators.resize(this->GetNumberOfThreads());
+    m_LabelStatistics.clear();
+    m_IncompleteHistograms.clear();
+    m_NumberOfHistogramsFilledInAdditionalPass = 0;
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  void MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::ThreadedGenerateData(
+    const RegionType &outputRegionForThread, ThreadIdType threadId)
+  {
+    if (0 == outputRegionForThread.GetNumberOfPixels())
+      return;
+
+    AccumulatorMapType &accumulators = m_ThreadAccumulators[threadId];
+
+    ImageRegionConstIteratorWithIndex<TInputImage> it(this->GetInput(), outputRegionForThread);
+    ImageRegionConstIterator<TLabelImage> labelIt(this->GetLabelInput(), outputRegionForThread);
+
+    // Neighbouring pixels mostly share their label, so the last accumulator is reused without a lookup
+    LabelAccumulator *accumulator = nullptr;
+    LabelPixelType accumulatorLabel = NumericTraits<LabelPixelType>::ZeroValue();
+
+    for (; !it.IsAtEnd(); ++it, ++labelIt)
+    {
+      const LabelPixelType label = labelIt.Get();
+
+      if (nullptr == accumulator || label != accumulatorLabel)
+      {
+        accumulator = &accumulators[label];
+        accumulatorLabel = label;
+      }
+
+      const PixelType pixel = it.Get();
+      const auto value = static_cast<RealType>(pixel);
+      const RealType squaredValue = value * value;
+      LabelStatistics &statistics = accumulator->m_Statistics;
+
+      if (pixel < statistics.m_Minimum || 0 == statistics.m_Count)
+      {
+        statistics.m_Minimum = pixel;
+        statistics.m_MinimumIndex = it.GetIndex();
+      }
+
+      if (pixel > statistics.m_Maximum || 0 == statistics.m_Count)
+      {
+        statistics.m_Maximum = pixel;
+        statistics.m_MaximumIndex = it.GetIndex();
+      }
+
+      ++statistics.m_Count;
+      statistics.m_Sum += value;
+      statistics.m_SumOfSquares += squaredValue;
+      statistics.m_SumOfCubes += squaredValue * value;
+      statistics.m_SumOfQuadruples += squaredValue * squaredValue;
+
+      if (value > 0)
+      {
+        ++statistics.m_PositivePixelCount;
+        statistics.m_SumOfPositivePixels += value;
+      }
+
+      if (accumulator->m_ValueCountsComplete)
+      {
+        ++accumulator->m_ValueCounts[pixel];
+
+        if (accumulator->m_ValueCounts.size() > m_MaximumNumberOfDistinctValues)
+        {
+          accumulator->m_ValueCountsComplete = false;
+          accumulator->m_ValueCounts.clear();
+        }
+      }
+    }
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  unsigned int MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::GetNumberOfBins(
+    const LabelStatistics &statistics) const
+  {
+    if (!m_UseBinSize)
+      return m_NumberOfBins;
+
+    // do not allow less than 10 bins
+    return std::max(static_cast<double>(std::ceil(statistics.m_Maximum - statistics.m_Minimum)) / m_BinSize, 10.);
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  void MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::AfterThreadedGenerateData()
+  {
+    std::map<LabelPixelType, std::unordered_map<PixelType, SizeValueType>> valueCounts;
+    std::map<LabelPixelType, bool> valueCountsComplete;
+
+    // Merge the partial results in thread order, so the first occurrence of an extremum wins
+    for (auto &accumulators : m_ThreadAccumulators)
+    {
+      for (auto &labelAccumulator : accumulators)
+      {
+        const LabelPixelType label = labelAccumulator.first;
+        const LabelStatistics &partial = labelAccumulator.second.m_Statistics;
+        auto insertion = m_LabelStatistics.insert(std::make_pair(label, partial));
+
+        if (insertion.second)
+        {
+          valueCounts[label].swap(labelAccumulator.second.m_ValueCounts);
+          valueCountsComplete[label] = labelAccumulator.second.m_ValueCountsComplete;
+          continue;
+        }
+
+        LabelStatistics &statistics = insertion.first->second;
+
+        statistics.m_Count += partial.m_Count;
+        statistics.m_PositivePixelCount += partial.m_PositivePixelCount;
+        statistics.m_Sum += partial.m_Sum;
+        statistics.m_SumOfPositivePixels += partial.m_SumOfPositivePixels;
+        statistics.m_SumOfSquares += partial.m_SumOfSquares;
+        statistics.m_SumOfCubes += partial.m_SumOfCubes;
+        statistics.m_SumOfQuadruples += partial.m_SumOfQuadruples;
+
+        if (partial.m_Minimum < statistics.m_Minimum)
+        {
+          statistics.m_Minimum = partial.m_Minimum;
+          statistics.m_MinimumIndex = partial.m_MinimumIndex;
+        }
+
+        if (partial.m_Maximum > statistics.m_Maximum)
+        {
+          statistics.m_Maximum = partial.m_Maximum;
+          statistics.m_MaximumIndex = partial.m_MaximumIndex;
+        }
+
+        bool &complete = valueCountsComplete[label];
+        complete = complete && labelAccumulator.second.m_ValueCountsComplete;
+
+        if (complete)
+        {
+          auto &counts = valueCounts[label];
+
+          for (const auto &valueCount : labelAccumulator.second.m_ValueCounts)
+            counts[valueCount.first] += valueCount.second;
+        }
+        else
+        {
+          valueCounts[label].clear();
+        }
+      }
+
+      accumulators.clear();
+    }
+
+    typename HistogramType::SizeType histogramSize(1);
+    typename HistogramType::MeasurementVectorType lowerBound(1);
+    typename HistogramType::MeasurementVectorType upperBound(1);
+    typename HistogramType::MeasurementVectorType measurement(1);
+    typename HistogramType::IndexType histogramIndex(1);
+
+    for (auto &labelStatistics : m_LabelStatistics)
+    {
+      LabelStatistics &statistics = labelStatistics.second;
+      const auto count = static_cast<RealType>(statistics.m_Count);
+
+      statistics.m_Mean = statistics.m_Sum / count;
+      statistics.m_MPP = statistics.m_SumOfPositivePixels / static_cast<RealType>(statistics.m_PositivePixelCount);
+      statistics.m_Variance = (statistics.m_SumOfSquares - statistics.m_Sum * statistics.m_Sum / count) / count;
+      statistics.m_Sigma = std::sqrt(statistics.m_Variance);
+
+      // see http://www.boost.org/doc/libs/1_51_0/doc/html/boost/accumulators/impl/skewness_impl.html and
+      // http://www.boost.org/doc/libs/1_51_0/doc/html/boost/accumulators/impl/kurtosis_impl.html, dropped -3
+      const RealType mean = statistics.m_Mean;
+      const RealType secondMoment = statistics.m_SumOfSquares / count;
+      const RealType thirdMoment = statistics.m_SumOfCubes / count;
+      const RealType fourthMoment = statistics.m_SumOfQuadruples / count;
+      const RealType centralSecondMoment = secondMoment - mean * mean;
+
+      statistics.m_Skewness = (thirdMoment - 3. * secondMoment * mean + 2. * mean * mean * mean) /
+                              std::pow(centralSecondMoment, 1.5);
+      statistics.m_Kurtosis =
+        (fourthMoment - 4. * thirdMoment * mean + 6. * secondMoment * mean * mean - 3. * mean * mean * mean * mean) /
+        (centralSecondMoment * centralSecondMoment);
+
+      histogramSize[0] = this->GetNumberOfBins(statistics);
+      lowerBound[0] = statistics.m_Minimum;
+      upperBound[0] = statistics.m_Maximum;
+
+      statistics.m_Histogram = HistogramType::New();
+      statistics.m_Histogram->SetMeasurementVectorSize(1);
+      statistics.m_Histogram->Initialize(histogramSize, lowerBound, upperBound);
+
+      if (valueCountsComplete[labelStatistics.first])
+      {
+        for (const auto &valueCount : valueCounts[labelStatistics.first])
+        {
+          measurement[0] = valueCount.first;
+          statistics.m_Histogram->GetIndex(measurement, histogramIndex);
+          statistics.m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, valueCount.second);
+        }
+      }
+      else
+      {
+        m_IncompleteHistograms[labelStatistics.first] = statistics.m_Histogram;
+      }
+    }
+
+    valueCounts.clear();
+
+    if (!m_IncompleteHistograms.empty())
+    {
+      m_NumberOfHistogramsFilledInAdditionalPass = m_IncompleteHistograms.size();
+
+      const ThreadIdType numberOfThreads = this->GetNumberOfThreads();
+      m_ThreadFrequencies.clear();
+      m_ThreadFrequencies.resize(numberOfThreads);
+
+      this->GetMultiThreader()->SetNumberOfThreads(numberOfThreads);
+      this->GetMultiThreader()->SetSingleMethod(&Self::FillHistogramsThreaderCallback, this);
+      this->GetMultiThreader()->SingleMethodExecute();
+
+      for (const auto &frequencies : m_ThreadFrequencies)
+      {
+        for (const auto &labelFrequencies : frequencies)
+        {
+          auto histogram = m_IncompleteHistograms[labelFrequencies.first];
+
+          for (std::size_t bin = 0; bin < labelFrequencies.second.size(); ++bin)
+            histogram->IncreaseFrequency(bin, labelFrequencies.second[bin]);
+        }
+      }
+
+      m_ThreadFrequencies.clear();
+      m_IncompleteHistograms.clear();
+    }
+
+    for (auto &labelStatistics : m_LabelStatistics)
+    {
+      LabelStatistics &statistics = labelStatistics.second;
+
+      mitk::HistogramStatisticsCalculator histogramStatisticsCalculator;
+      histogramStatisticsCalculator.SetHistogram(statistics.m_Histogram);
+      histogramStatisticsCalculator.CalculateStatistics();
+
+      statistics.m_Median = histogramStatisticsCalculator.GetMedian();
+      statistics.m_Entropy = histogramStatisticsCalculator.GetEntropy();
+      statistics.m_Uniformity = histogramStatisticsCalculator.GetUniformity();
+      statistics.m_UPP = histogramStatisticsCalculator.GetUPP();
+    }
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  ITK_THREAD_RETURN_TYPE MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::FillHistogramsThreaderCallback(
+    void *arg)
+  {
+    auto *threadInfo = static_cast<MultiThreader::ThreadInfoStruct *>(arg);
+    auto *self = static_cast<Self *>(threadInfo->UserData);
+
+    const ThreadIdType threadId = threadInfo->ThreadID;
+    RegionType regionForThread;
+    const ThreadIdType numberOfUsedThreads =
+      self->SplitRequestedRegion(threadId, threadInfo->NumberOfThreads, regionForThread);
+
+    if (threadId < numberOfUsedThreads)
+      self->ThreadedFillHistograms(regionForThread, threadId);
+
+    return ITK_THREAD_RETURN_VALUE;
+  }
+
+  template <typename TInputImage, typename TLabelImage>
+  void MultiLabelStatisticsImageFilter<TInputImage, TLabelImage>::ThreadedFillHistograms(
+    const RegionType &regionForThread, ThreadIdType threadId)
+  {
+    auto &frequencies = m_ThreadFrequencies[threadId];
+
+    ImageRegionConstIterator<TInputImage> it(this->GetInput(), regionForThread);
+    ImageRegionConstIterator<TLabelImage> labelIt(this->GetLabelInput(), regionForThread);
+
+    typename HistogramType::MeasurementVectorType measurement(1);
+    typename HistogramType::IndexType histogramIndex(1);
+
+    // the histogram of the label of the previous pixel, nullptr if this label needs no histogram
+    const HistogramType *histogram = nullptr;
+    std::vector<double> *labelFrequencies = nullptr;
+    LabelPixelType histogramLabel = NumericTraits<LabelPixelType>::ZeroValue();
+    bool histogramLabelValid = false;
+
+    for (; !it.IsAtEnd(); ++it, ++labelIt)
+    {
+      const LabelPixelType label = labelIt.Get();
+
+      if (!histogramLabelValid || label != histogramLabel)
+      {
+        histogramLabel = label;
+        histogramLabelValid = true;
+        auto histogramIt = m_IncompleteHistograms.find(label);
+
+        if (histogramIt == m_IncompleteHistograms.end())
+        {
+          histogram = nullptr;
+          labelFrequencies = nullptr;
+        }
+        else
+        {
+          histogram = histogramIt->second;
+          labelFrequencies = &frequencies[label];
+          labelFrequencies->resize(histogram->Size(), 0.0);
+        }
+      }
+
+      if (nullptr == labelFrequencies)
+        continue;
+
+      measurement[0] = it.Get();
+      histogram->GetIndex(measurement, histogramIndex);
+      (*labelFrequencies)[histogram->GetInstanceIdentifier(histogramIndex)] += 1.0;
+    }
+  }
+}
+
+#endif
@@ -32,6 +32,8 @@ QmitkImageStatisticsCalculationRunnable::QmitkImageStatisticsCalculationRunnable
   , m_PlanarFigureMask(nullptr)
   , m_IgnoreZeros(false)
   , m_HistogramNBins(100)
+  , m_IncrementalUpdate(false)
+  , m_MaskTimeStamp(0)
 {
 }
 
@@ -46,6 +48,7 @@ void QmitkImageStatisticsCalculationRunnable::Initialize(const mitk::Image *imag
   this->m_StatisticsImage = image;
   this->m_BinaryMask = binaryImage;
   this->m_PlanarFigureMask = planarFig;
+  this->m_MaskTimeStamp = nullptr != binaryImage ? binaryImage->GetMTime() : 0;
 }
 
 mitk::ImageStatisticsContainer* QmitkImageStatisticsCalculationRunnable::GetStatisticsData() const
@@ -88,6 +91,26 @@ unsigned int QmitkImageStatisticsCalculationRunnable::GetHistogramNBins() const
   return this->m_HistogramNBins;
 }
 
+void QmitkImageStatisticsCalculationRunnable::SetIncrementalUpdate(bool _arg)
+{
+  this->m_IncrementalUpdate = _arg;
+}
+
+bool QmitkImageStatisticsCalculationRunnable::GetIncrementalUpdate() const
+{
+  return this->m_IncrementalUpdate;
+}
+
+mitk::ImageStatisticsCalculator* QmitkImageStatisticsCalculationRunnable::GetStatisticsCalculator() const
+{
+  return this->m_StatisticsCalculator.GetPointer();
+}
+
+unsigned long QmitkImageStatisticsCalculationRunnable::GetMaskTimeStamp() const
+{
+  return this->m_MaskTimeStamp;
+}
+
 QmitkDataGenerationJobBase::ResultMapType QmitkImageStatisticsCalculationRunnable::GetResults() const
 {
   ResultMapType result;
@@ -148,6 +171,7 @@ bool QmitkImageStatisticsCalculationRunnable::RunComputation()
   }
 
   calculator->SetNBinsForHistogramStatistics(m_HistogramNBins);
+  calculator->SetIncrementalUpdate(m_IncrementalUpdate);
 
   try
   {
@@ -163,6 +187,7 @@ bool QmitkImageStatisticsCalculationRunnable::RunComputation()
   if (statisticCalculationSuccessful)
   {
     m_StatisticsContainer = calculator->GetStatistics();
+    m_StatisticsCalculator = calculator;
 
     auto imageRule = mitk::StatisticsToImageRelationRule::New();
     imageRule->Connect(m_StatisticsContainer, m_StatisticsImage);
@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkImage.h"
 #include "mitkPlanarFigure.h"
 #include "mitkImageStatisticsContainer.h"
+#include "mitkImageStatisticsCalculator.h"
 
 #include "QmitkDataGenerationJobBase.h"
 
@@ -69,6 +70,19 @@ public:
   /*!
   /brief Get bin size for histogram resolution.*/
   unsigned int GetHistogramNBins() const;
+  /*!
+  /brief Set flag to keep what is needed to update the statistics incrementally after the mask was edited.
+  See mitk::ImageStatisticsCalculator::SetIncrementalUpdate.*/
+  void SetIncrementalUpdate(bool _arg);
+  /*!
+  /brief Get flag to keep what is needed to update the statistics incrementally. */
+  bool GetIncrementalUpdate() const;
+  /*!
+  /brief returns the calculator that calculated the statistics, e.g. to update them incrementally. */
+  mitk::ImageStatisticsCalculator* GetStatisticsCalculator() const;
+  /*!
+  /brief returns the modification time of the mask at initialization. The statistics include all edits of the mask up to this time. */
+  unsigned long GetMaskTimeStamp() const;
 
   ResultMapType GetResults() const override;
 
@@ -80,7 +94,10 @@ private:
   mitk::Image::ConstPointer m_BinaryMask;                              ///< member variable holds the binary mask image for segmentation image statistics calculation.
   mitk::PlanarFigure::ConstPointer m_PlanarFigureMask;                 ///< member variable holds the planar figure for segmentation image statistics calculation.
   mitk::ImageStatisticsContainer::Pointer m_StatisticsContainer;
+  mitk::ImageStatisticsCalculator::Pointer m_StatisticsCalculator;
   bool m_IgnoreZeros;                                             ///< member variable holds flag to indicate if zero valued voxel should be suppressed
   unsigned int m_HistogramNBins;                                      ///< member variable holds the bin size for histogram resolution.
+  bool m_IncrementalUpdate;                                       ///< member variable holds flag to indicate if the statistics can be updated incrementally
+  unsigned long m_MaskTimeStamp;                                  ///< member variable holds the modification time of the mask at initialization
 };
 #endif // QMITKIMAGESTATISTICSCALCULATIONRUNNABLE_H_INCLUDED
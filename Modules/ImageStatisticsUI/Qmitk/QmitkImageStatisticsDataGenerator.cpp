@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include "mitkNodePredicateDataProperty.h"
 #include "mitkProperties.h"
 #include "mitkImageStatisticsContainerManager.h"
+#include "mitkLabelSetImage.h"
 
 #include "QmitkImageStatisticsCalculationRunnable.h"
 
@@ -78,9 +79,58 @@ bool QmitkImageStatisticsDataGenerator::ChangedNodeIsRelevant(const mitk::DataNo
 bool QmitkImageStatisticsDataGenerator::IsValidResultAvailable(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const
 {
   auto resultNode = this->GetLatestResult(imageNode, roiNode, true, true);
+
+  if (resultNode.IsNull())
+  {
+    resultNode = this->UpdateLatestResultIncrementally(imageNode, roiNode);
+  }
+
   return resultNode.IsNotNull();
 }
 
+mitk::DataNode::Pointer QmitkImageStatisticsDataGenerator::UpdateLatestResultIncrementally(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const
+{
+  if (m_IncrementalUpdates.empty() || roiNode == nullptr || imageNode == nullptr || !imageNode->GetData())
+  {
+    return nullptr;
+  }
+
+  auto mask = dynamic_cast<const mitk::LabelSetImage*>(roiNode->GetData());
+
+  // a pending or running generation will replace the result anyway
+  auto resultNode = this->GetLatestResult(imageNode, roiNode, false, false);
+  if (mask == nullptr || resultNode.IsNull() || resultNode->GetProperty(mitk::STATS_GENERATION_STATUS_PROPERTY_NAME.c_str()) != nullptr)
+  {
+    return nullptr;
+  }
+
+  auto updateIter = m_IncrementalUpdates.find(resultNode->GetData());
+  if (updateIter == m_IncrementalUpdates.end())
+  {
+    return nullptr;
+  }
+
+  // only the segmentation may have been edited, within a region it knows
+  mitk::LabelSetImage::LabelRegionType changedRegion;
+  bool updated = imageNode->GetData()->GetMTime() < resultNode->GetData()->GetMTime() &&
+    mask->GetModifiedRegion(updateIter->second.ROITimeStamp, changedRegion);
+
+  for (unsigned int timeStep = 0; updated && timeStep < mask->GetTimeSteps(); ++timeStep)
+  {
+    updated = updateIter->second.Calculator->UpdateStatistics(mask, changedRegion, timeStep);
+  }
+
+  if (!updated)
+  {
+    // the statistics are calculated from scratch by the next generation job
+    m_IncrementalUpdates.erase(updateIter);
+    return nullptr;
+  }
+
+  updateIter->second.ROITimeStamp = mask->GetMTime();
+  return resultNode;
+}
+
 mitk::DataNode::Pointer QmitkImageStatisticsDataGenerator::GetLatestResult(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode, bool onlyIfUpToDate, bool noWIP) const
 {
   auto storage = m_Storage.Lock();
@@ -179,6 +229,8 @@ std::pair<QmitkDataGenerationJobBase*, mitk::DataNode::Pointer> QmitkImageStatis
     newJob->Initialize(image, mask, planar);
     newJob->SetIgnoreZeroValueVoxel(m_IgnoreZeroValueVoxel);
     newJob->SetHistogramNBins(m_HistogramNBins);
+    // the incremental update needs the region of the segmentation that was edited, which only LabelSetImages know
+    newJob->SetIncrementalUpdate(!m_IgnoreZeroValueVoxel && dynamic_cast<const mitk::LabelSetImage*>(mask) != nullptr);
 
     return std::pair<QmitkDataGenerationJobBase*, mitk::DataNode::Pointer>(newJob, resultDataNode.GetPointer());
   }
@@ -219,6 +271,10 @@ void QmitkImageStatisticsDataGenerator::RemoveObsoleteDataNodes(const mitk::Data
     std::lock_guard<std::mutex> mutexguard(m_DataMutex);
 
     auto oldStatisticContainerNodes = storage->GetSubset(predicate);
+    for (const auto& node : *oldStatisticContainerNodes)
+    {
+      m_IncrementalUpdates.erase(node->GetData());
+    }
     storage->Remove(oldStatisticContainerNodes);
   }
 }
@@ -241,6 +297,11 @@ mitk::DataNode::Pointer QmitkImageStatisticsDataGenerator::PrepareResultForStora
     }
     resultNode->SetName(this->GenerateStatisticsNodeName(statsJob->GetStatisticsImage(), roi));
 
+    if (statsJob->GetIncrementalUpdate() && statsJob->GetStatisticsCalculator() != nullptr)
+    {
+      m_IncrementalUpdates[result] = IncrementalUpdateInfo{ statsJob->GetStatisticsCalculator(), statsJob->GetMaskTimeStamp() };
+    }
+
     return resultNode;
   }
 
@@ -15,13 +15,19 @@ found in the LICENSE file.
 
 #include "QmitkImageAndRoiDataGeneratorBase.h"
 
+#include <mitkImageStatisticsCalculator.h>
+
 #include <MitkImageStatisticsUIExports.h>
 
+#include <map>
+
 /**
 Generates ImageStatisticContainers by using QmitkImageStatisticsCalculationRunnables for each pair if image and ROIs and ensures their
 validity.
 It also encodes the HistogramNBins and IgnoreZeroValueVoxel as properties to the results as these settings are important criteria for
 discreminating statistics results.
+Results for a segmentation (mitk::LabelSetImage) as ROI are updated incrementally after the segmentation was edited, if the segmentation
+knows the edited region (see mitk::LabelSetImage::GetModifiedRegion) and the edit allows it (see mitk::ImageStatisticsCalculator::UpdateStatistics).
 For more details of how the generation is done see QmitkDataGenerationBase.
 */
 class MITKIMAGESTATISTICSUI_EXPORT QmitkImageStatisticsDataGenerator : public QmitkImageAndRoiDataGeneratorBase
@@ -59,11 +65,26 @@ protected:
   void RemoveObsoleteDataNodes(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const;
   mitk::DataNode::Pointer PrepareResultForStorage(const std::string& label, mitk::BaseData* result, const QmitkDataGenerationJobBase* job) const;
 
+  /** Updates the latest result for the given image and ROI incrementally if only the ROI was edited since its generation and
+   no other generation is in progress. Returns the result node if it is up to date afterwards, otherwise nullptr.*/
+  mitk::DataNode::Pointer UpdateLatestResultIncrementally(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const;
+
   QmitkImageStatisticsDataGenerator(const QmitkImageStatisticsDataGenerator&) = delete;
   QmitkImageStatisticsDataGenerator& operator = (const QmitkImageStatisticsDataGenerator&) = delete;
 
   bool m_IgnoreZeroValueVoxel = false;
   unsigned int m_HistogramNBins = 100;
+
+  /** Calculator of a result that can be updated incrementally and the modification time of the ROI up to which the result
+   includes all edits of the ROI.*/
+  struct IncrementalUpdateInfo
+  {
+    mitk::ImageStatisticsCalculator::Pointer Calculator;
+    unsigned long ROITimeStamp;
+  };
+
+  /** Results in the storage that can be updated incrementally, only accessed from the main thread.*/
+  mutable std::map<const mitk::BaseData*, IncrementalUpdateInfo> m_IncrementalUpdates;
 };
 
 #endif
@@ -0,0 +1,237 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// std includes
+#include <chrono>
+#include <string>
+
+// itk includes
+#include <itkImage.h>
+#include <itkImageRegionIteratorWithIndex.h>
+#include <itkMultiThreader.h>
+
+// CTK includes
+#include "mitkCommandLineParser.h"
+
+// MITK includes
+#include <mitkITKImageImport.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkLevenbergMarquardtModelFitFunctor.h>
+#include <mitkModelSignalImageGenerator.h>
+#include <mitkPixelBasedParameterFitImageGenerator.h>
+#include <mitkT2DecayModelParameterizer.h>
+
+unsigned int imageSize(32);
+unsigned int numberOfFrames(20);
+unsigned int numberOfThreads(0);
+unsigned int numberOfLinesPerBatch(1);
+unsigned int repetitions(1);
+
+void setupParser(mitkCommandLineParser& parser)
+{
+    // set general information about your MiniApp
+    parser.setCategory("Dynamic Data Analysis Tools");
+    parser.setTitle("Parameter Fit Benchmark");
+    parser.setDescription("MiniApp that measures the run time of pixel based parameter fits. It generates a synthetic 3D+t image of the T2 decay model (M0 * exp(-t/T2)) and fits the model with one thread and with the selected number of threads.");
+    parser.setContributor("DKFZ MIC");
+
+    parser.setArgumentPrefix("--", "-");
+    parser.beginGroup("Optional parameters");
+    parser.addArgument(
+        "size", "s", mitkCommandLineParser::Int, "Image size", "Number of voxels of the synthetic image in each spatial dimension.", us::Any(32));
+    parser.addArgument(
+        "frames", "f", mitkCommandLineParser::Int, "Frames", "Number of time frames of the synthetic image.", us::Any(20));
+    parser.addArgument(
+        "threads", "t", mitkCommandLineParser::Int, "Threads", "Number of threads of the parallel fit. 0 uses the default number of threads of ITK.", us::Any(0));
+    parser.addArgument(
+        "batch", "b", mitkCommandLineParser::Int, "Lines per batch", "Number of image lines a thread fits before it fetches the next batch.", us::Any(1));
+    parser.addArgument(
+        "repetitions", "r", mitkCommandLineParser::Int, "Repetitions", "Number of times each fit is repeated. The fastest run is reported.", us::Any(1));
+    parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
+    parser.endGroup();
+}
+
+bool configureApplicationSettings(std::map<std::string, us::Any> parsedArgs)
+{
+    if (parsedArgs.count("size"))
+    {
+        imageSize = us::any_cast<int>(parsedArgs["size"]);
+    }
+    if (parsedArgs.count("frames"))
+    {
+        numberOfFrames = us::any_cast<int>(parsedArgs["frames"]);
+    }
+    if (parsedArgs.count("threads"))
+    {
+        numberOfThreads = us::any_cast<int>(parsedArgs["threads"]);
+    }
+    if (parsedArgs.count("batch"))
+    {
+        numberOfLinesPerBatch = us::any_cast<int>(parsedArgs["batch"]);
+    }
+    if (parsedArgs.count("repetitions"))
+    {
+        repetitions = us::any_cast<int>(parsedArgs["repetitions"]);
+    }
+
+    return imageSize > 0 && numberOfFrames > 1 && numberOfLinesPerBatch > 0 && repetitions > 0;
+}
+
+mitk::Image::Pointer generateParameterImage(double minimum, double maximum, unsigned int dimension)
+{
+    typedef itk::Image<double, 3> ParameterImageType;
+
+    ParameterImageType::SizeType size;
+    size.Fill(imageSize);
+
+    ParameterImageType::Pointer image = ParameterImageType::New();
+    image->SetRegions(size);
+    image->Allocate();
+
+    //values increase along the passed dimension, thus the fits of the lines converge differently fast
+    itk::ImageRegionIteratorWithIndex<ParameterImageType> it(image, image->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+        const double ratio = imageSize > 1 ? it.GetIndex()[dimension] / static_cast<double>(imageSize - 1) : 0.;
+        it.Set(minimum + ratio * (maximum - minimum));
+    }
+
+    return mitk::ImportItkImage(image)->Clone();
+}
+
+mitk::Image::Pointer generateSignalImage(mitk::ModelParameterizerBase* parameterizer)
+{
+    mitk::ModelSignalImageGenerator::Pointer generator = mitk::ModelSignalImageGenerator::New();
+    generator->SetParameterizer(parameterizer);
+    generator->SetParameterInputImage(0, generateParameterImage(50., 150., 0));
+    generator->SetParameterInputImage(1, generateParameterImage(20., 200., 2));
+
+    return generator->GetGeneratedImage();
+}
+
+double fit(mitk::Image* signalImage, mitk::ModelParameterizerBase* parameterizer, unsigned int threads, mitk::Image::Pointer& m0Image)
+{
+    double fastestRun = -1.;
+
+    for (unsigned int i = 0; i < repetitions; ++i)
+    {
+        mitk::LevenbergMarquardtModelFitFunctor::Pointer fitFunctor = mitk::LevenbergMarquardtModelFitFunctor::New();
+
+        mitk::PixelBasedParameterFitImageGenerator::Pointer fitGenerator = mitk::PixelBasedParameterFitImageGenerator::New();
+        fitGenerator->SetModelParameterizer(parameterizer);
+        fitGenerator->SetFitFunctor(fitFunctor);
+        fitGenerator->SetDynamicImage(signalImage);
+        fitGenerator->TimeGridByParameterizerOn();
+        fitGenerator->SetNumberOfThreads(threads);
+        fitGenerator->SetNumberOfLinesPerBatch(numberOfLinesPerBatch);
+
+        const auto startTime = std::chrono::steady_clock::now();
+        fitGenerator->Generate();
+        const auto stopTime = std::chrono::steady_clock::now();
+
+        const double run = std::chrono::duration<double>(stopTime - startTime).count();
+        if (fastestRun < 0 || run < fastestRun)
+        {
+            fastestRun = run;
+        }
+
+        m0Image = fitGenerator->GetParameterImages()["M0"];
+    }
+
+    return fastestRun;
+}
+
+int main(int argc, char* argv[])
+{
+    mitkCommandLineParser parser;
+    setupParser(parser);
+
+    const std::map<std::string, us::Any>& parsedArgs = parser.parseArguments(argc, argv);
+
+    // Show a help message
+    if (parsedArgs.count("help") || parsedArgs.count("h"))
+    {
+        std::cout << parser.helpText();
+        return EXIT_SUCCESS;
+    }
+
+    if (!configureApplicationSettings(parsedArgs))
+    {
+        std::cout << parser.helpText();
+        return EXIT_FAILURE;
+    };
+
+    //! [do processing]
+    try
+    {
+        mitk::T2DecayModelParameterizer::Pointer parameterizer = mitk::T2DecayModelParameterizer::New();
+
+        mitk::ModelBase::TimeGridType timeGrid(numberOfFrames);
+        for (unsigned int i = 0; i < numberOfFrames; ++i)
+        {
+            timeGrid[i] = i * 10.;
+        }
+        parameterizer->SetDefaultTimeGrid(timeGrid);
+
+        std::cout << "Generating synthetic image (" << imageSize << "^3 voxels, " << numberOfFrames << " frames)..." << std::endl;
+        mitk::Image::Pointer signalImage = generateSignalImage(parameterizer);
+
+        if (0 == numberOfThreads)
+        {
+            numberOfThreads = itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+        }
+
+        mitk::Image::Pointer serialM0;
+        mitk::Image::Pointer parallelM0;
+
+        const double serialTime = fit(signalImage, parameterizer, 1, serialM0);
+        std::cout << "Fit with 1 thread: " << serialTime << " s" << std::endl;
+
+        const double parallelTime = fit(signalImage, parameterizer, numberOfThreads, parallelM0);
+        std::cout << "Fit with " << numberOfThreads << " threads: " << parallelTime << " s" << std::endl;
+
+        const double numberOfVoxels = static_cast<double>(imageSize) * imageSize * imageSize;
+        std::cout << "Voxels per second: " << numberOfVoxels / serialTime << " (1 thread), " << numberOfVoxels / parallelTime << " (" << numberOfThreads << " threads)" << std::endl;
+        std::cout << "Speedup: " << serialTime / parallelTime << std::endl;
+
+        //the fit of a pixel must not depend on the thread that processed it
+        mitk::ImagePixelReadAccessor<mitk::ScalarType, 3> serialAccessor(serialM0);
+        mitk::ImagePixelReadAccessor<mitk::ScalarType, 3> parallelAccessor(parallelM0);
+        const auto numberOfPixels = static_cast<std::size_t>(numberOfVoxels);
+        for (std::size_t i = 0; i < numberOfPixels; ++i)
+        {
+            if (serialAccessor.GetData()[i] != parallelAccessor.GetData()[i])
+            {
+                mitkThrow() << "Results of the serial and the parallel fit differ at pixel " << i << ".";
+            }
+        }
+
+        std::cout << "Processing finished." << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+    catch (const itk::ExceptionObject& e)
+    {
+        MITK_ERROR << e.what();
+        return EXIT_FAILURE;
+    }
+    catch (const std::exception& e)
+    {
+        MITK_ERROR << e.what();
+        return EXIT_FAILURE;
+    }
+    catch (...)
+    {
+        MITK_ERROR << "Unexpected error encountered.";
+        return EXIT_FAILURE;
+    }
+}
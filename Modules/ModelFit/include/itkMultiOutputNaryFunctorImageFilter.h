@@ -17,6 +17,9 @@ found in the LICENSE file.
 #include "itkImageIterator.h"
 #include "itkArray.h"
 
+#include <atomic>
+#include <vector>
+
 namespace itk
 {
 /** \class MultiOutputNaryFunctorImageFilter
@@ -34,6 +37,14 @@ namespace itk
  *
  * All the input images must be of the same type.
  *
+ * The pixels are not processed in the static regions ITK assigns to each thread. Instead the
+ * requested region is divided into batches of NumberOfLinesPerBatch image lines and each thread
+ * fetches the next unprocessed batch as soon as it has finished its current one. Therefore threads
+ * stay busy even if the processing time per pixel differs strongly within the image (e.g. masked
+ * regions or fits that converge slowly). Each thread uses its own copy of the functor, thus
+ * functors may keep reusable per thread state. The filter checks GetAbortGenerateData() before
+ * each batch and throws itk::ProcessAborted if the processing was aborted.
+ *
  * \ingroup IntensityImageFilters MultiThreaded
  * \ingroup ITKImageIntensity
  */
@@ -96,6 +107,10 @@ public:
   itkSetObjectMacro(Mask, MaskImageType);
   itkGetConstObjectMacro(Mask, MaskImageType);
 
+  /** Number of image lines a thread processes before it fetches the next batch. Default is 1.*/
+  itkSetClampMacro(NumberOfLinesPerBatch, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(NumberOfLinesPerBatch, SizeValueType);
+
   /** ImageDimension constants */
   itkStaticConstMacro(
     InputImageDimension, unsigned int, TInputImage::ImageDimension);
@@ -114,19 +129,26 @@ protected:
   MultiOutputNaryFunctorImageFilter();
   ~MultiOutputNaryFunctorImageFilter() override {}
 
-  /** MultiOutputNaryFunctorImageFilter can be implemented as a multi threaded filter.
+  /** Prepares the batches and the functor copies of the threads.*/
+  void BeforeThreadedGenerateData() override;
+
+  /** MultiOutputNaryFunctorImageFilter is implemented as a multi threaded filter.
    * Therefore, this implementation provides a ThreadedGenerateData() routine
    * which is called for each processing thread. The output image data is
    * allocated automatically by the superclass prior to calling
-   * ThreadedGenerateData().  ThreadedGenerateData can only write to the
-   * portion of the output image specified by the parameter
-   * "outputRegionForThread"
+   * ThreadedGenerateData(). In contrast to other filters the passed region
+   * "outputRegionForThread" is ignored; each thread processes batches of the
+   * requested region until all batches are done.
    *
    * \sa ImageToImageFilter::ThreadedGenerateData(),
    *     ImageToImageFilter::GenerateData()  */
   void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                             ThreadIdType threadId) override;
 
+  /** Releases the functor copies of the threads and throws itk::ProcessAborted
+   * if the processing was aborted.*/
+  void AfterThreadedGenerateData() override;
+
   /** Methods actualize the output settings of the filter according to the current functor*/
   void ActualizeOutputs();
 
@@ -136,6 +158,15 @@ private:
 
   FunctorType m_Functor;
   MaskImagePointer m_Mask;
+
+  SizeValueType m_NumberOfLinesPerBatch;
+
+  /** Copies of m_Functor used by the threads during the processing.*/
+  std::vector<FunctorType> m_ThreadFunctors;
+
+  SizeValueType m_NumberOfBatches;
+  std::atomic<SizeValueType> m_NextBatch;
+  std::atomic<SizeValueType> m_NumberOfProcessedPixels;
 };
 } // end namespace itk
 
@@ -15,7 +15,8 @@ found in the LICENSE file.
 
 #include "itkMultiOutputNaryFunctorImageFilter.h"
 #include "itkImageRegionIterator.h"
-#include "itkProgressReporter.h"
+
+#include <algorithm>
 
 namespace itk
 {
@@ -30,6 +31,11 @@ namespace itk
     // is added over the two minimum required
     this->SetNumberOfRequiredInputs(1);
 
+    m_NumberOfLinesPerBatch = 1;
+    m_NumberOfBatches = 0;
+    m_NextBatch = 0;
+    m_NumberOfProcessedPixels = 0;
+
     this->ActualizeOutputs();
   }
 
@@ -51,180 +57,204 @@ namespace itk
     }
   };
 
-  /**
-  * ThreadedGenerateData Performs the pixel-wise addition
-  */
   template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
   void
     MultiOutputNaryFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
-    ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
-    ThreadIdType threadId)
+    ::BeforeThreadedGenerateData()
   {
-    ProgressReporter progress( this, threadId,
-      outputRegionForThread.GetNumberOfPixels() );
+    const OutputImageRegionType requestedRegion = this->GetOutput()->GetRequestedRegion();
 
-    const unsigned int numberOfInputImages =
-      static_cast< unsigned int >( this->GetNumberOfIndexedInputs() );
-
-    const unsigned int numberOfOutputImages =
-      static_cast< unsigned int >( this->GetNumberOfIndexedOutputs() );
+    if (m_Mask.IsNotNull() && !m_Mask->GetLargestPossibleRegion().IsInside(requestedRegion))
+    {
+      itkExceptionMacro("Mask of filter is set but does not cover the requested region. Mask region: "<< m_Mask->GetLargestPossibleRegion() <<"Requested region: "<<requestedRegion)
+    }
 
-    typedef ImageRegionConstIterator< TInputImage > ImageRegionConstIteratorType;
-    std::vector< ImageRegionConstIteratorType * > inputItrVector;
-    inputItrVector.reserve(numberOfInputImages);
+    const SizeValueType numberOfLines = requestedRegion.GetNumberOfPixels() > 0 ? requestedRegion.GetNumberOfPixels() / requestedRegion.GetSize(0) : 0;
+    m_NumberOfBatches = (numberOfLines + m_NumberOfLinesPerBatch - 1) / m_NumberOfLinesPerBatch;
+    m_NextBatch = 0;
+    m_NumberOfProcessedPixels = 0;
 
-    typedef ImageRegionIterator< TOutputImage > OutputImageRegionIteratorType;
-    std::vector< OutputImageRegionIteratorType * > outputItrVector;
-    outputItrVector.reserve(numberOfOutputImages);
+    m_ThreadFunctors.assign(this->GetNumberOfThreads(), m_Functor);
+  }
 
-    //check if mask image is set and generate iterator if mask is valid
-    typedef ImageRegionConstIterator< TMaskImage > MaskImageRegionIteratorType;
-    MaskImageRegionIteratorType* pMaskIterator = nullptr;
+  /**
+  * ThreadedGenerateData processes batches of lines until all lines of the requested region are done.
+  */
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputNaryFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::ThreadedGenerateData(const OutputImageRegionType & /*outputRegionForThread*/,
+    ThreadIdType threadId)
+  {
+    const OutputImageRegionType requestedRegion = this->GetOutput()->GetRequestedRegion();
+    const SizeValueType numberOfPixels = requestedRegion.GetNumberOfPixels();
 
-    if (m_Mask.IsNotNull())
+    if (0 == m_NumberOfBatches)
     {
-      if (!m_Mask->GetLargestPossibleRegion().IsInside(outputRegionForThread))
-      {
-        itkExceptionMacro("Mask of filter is set but does not cover region of thread. Mask region: "<< m_Mask->GetLargestPossibleRegion() <<"Thread region: "<<outputRegionForThread)
-      }
-      pMaskIterator = new MaskImageRegionIteratorType(m_Mask,outputRegionForThread);
+      return;
     }
 
-    // go through the inputs and add iterators for non-null inputs
-    for ( unsigned int i = 0; i < numberOfInputImages; ++i )
+    const SizeValueType numberOfLines = numberOfPixels / requestedRegion.GetSize(0);
+
+    std::vector< InputImageType * > inputs;
+    for ( unsigned int i = 0; i < this->GetNumberOfIndexedInputs(); ++i )
     {
-      InputImagePointer inputPtr =
-        dynamic_cast< TInputImage * >( ProcessObject::GetInput(i) );
+      auto* inputPtr = dynamic_cast< TInputImage * >( ProcessObject::GetInput(i) );
 
       if ( inputPtr )
       {
-        inputItrVector.push_back( new ImageRegionConstIteratorType(inputPtr, outputRegionForThread) );
+        inputs.push_back(inputPtr);
       }
-
     }
 
-    // go through the outputs and add iterators for non-null outputs
-    for ( unsigned int i = 0; i < numberOfOutputImages; ++i )
+    std::vector< OutputImageType * > outputs;
+    for ( unsigned int i = 0; i < this->GetNumberOfIndexedOutputs(); ++i )
     {
-      OutputImagePointer outputPtr =
-        dynamic_cast< TOutputImage * >( ProcessObject::GetOutput(i) );
+      auto* outputPtr = dynamic_cast< TOutputImage * >( ProcessObject::GetOutput(i) );
 
       if ( outputPtr )
       {
-        outputItrVector.push_back( new OutputImageRegionIteratorType(outputPtr, outputRegionForThread) );
+        outputs.push_back(outputPtr);
       }
     }
 
-    typename std::vector< ImageRegionConstIteratorType * >::iterator regionInputIterators;
-    const typename std::vector< ImageRegionConstIteratorType * >::const_iterator regionInputItEnd =
-      inputItrVector.end();
+    if (inputs.empty() || outputs.empty())
+    {
+      return;
+    }
 
-    typename std::vector< OutputImageRegionIteratorType * >::iterator regionOutputIterators;
-    const typename std::vector< OutputImageRegionIteratorType * >::const_iterator regionOutputItEnd =
-      outputItrVector.end();
+    typedef ImageRegionConstIterator< TInputImage > ImageRegionConstIteratorType;
+    typedef ImageRegionIterator< TOutputImage > OutputImageRegionIteratorType;
+    typedef ImageRegionConstIterator< TMaskImage > MaskImageRegionIteratorType;
+
+    std::vector< ImageRegionConstIteratorType > inputIterators(inputs.size());
+    std::vector< OutputImageRegionIteratorType > outputIterators(outputs.size());
+    MaskImageRegionIteratorType maskIterator;
+
+    FunctorType& functor = m_ThreadFunctors[threadId];
 
-    const unsigned int numberOfValidInputImages = inputItrVector.size();
-    const unsigned int numberOfValidOutputImages = outputItrVector.size();
+    //the arrays are reused for all pixels of the thread
+    NaryInputArrayType naryInputArray(inputs.size());
+    NaryOutputArrayType naryOutputArray(outputs.size());
 
-    if ( (numberOfValidInputImages != 0) && ( numberOfValidOutputImages != 0))
+    OutputImageRegionType lineRegion = requestedRegion;
+    typename OutputImageRegionType::SizeType lineSize = requestedRegion.GetSize();
+    for (unsigned int d = 1; d < OutputImageDimension; ++d)
     {
-      try
+      lineSize[d] = 1;
+    }
+    lineRegion.SetSize(lineSize);
+
+    while (!this->GetAbortGenerateData())
+    {
+      const SizeValueType batch = m_NextBatch++;
+
+      if (batch >= m_NumberOfBatches)
       {
+        break;
+      }
+
+      const SizeValueType firstLine = batch * m_NumberOfLinesPerBatch;
+      const SizeValueType endLine = std::min(firstLine + m_NumberOfLinesPerBatch, numberOfLines);
 
-        while ( !(outputItrVector.front()->IsAtEnd()) )
+      for (SizeValueType line = firstLine; line < endLine; ++line)
+      {
+        //determine the start index of the line
+        typename OutputImageRegionType::IndexType lineIndex = requestedRegion.GetIndex();
+        SizeValueType remainder = line;
+        for (unsigned int d = 1; d < OutputImageDimension; ++d)
         {
-          typename NaryInputArrayType::iterator arrayInIt;
-          typename NaryOutputArrayType::iterator arrayOutIt;
-          NaryInputArrayType naryInputArray(numberOfValidInputImages);
-          NaryOutputArrayType naryOutputArray(numberOfValidOutputImages);
+          lineIndex[d] += static_cast<IndexValueType>(remainder % requestedRegion.GetSize(d));
+          remainder /= requestedRegion.GetSize(d);
+        }
+        lineRegion.SetIndex(lineIndex);
 
-          bool isValid = true;
+        for (typename std::vector< InputImageType * >::size_type i = 0; i < inputs.size(); ++i)
+        {
+          inputIterators[i] = ImageRegionConstIteratorType(inputs[i], lineRegion);
+        }
 
-          if (pMaskIterator)
-          {
-            isValid = pMaskIterator->Get() > 0;
-            ++(*pMaskIterator);
-          }
+        for (typename std::vector< OutputImageType * >::size_type i = 0; i < outputs.size(); ++i)
+        {
+          outputIterators[i] = OutputImageRegionIteratorType(outputs[i], lineRegion);
+        }
+
+        if (m_Mask.IsNotNull())
+        {
+          maskIterator = MaskImageRegionIteratorType(m_Mask, lineRegion);
+        }
 
-          arrayInIt = naryInputArray.begin();
-          regionInputIterators = inputItrVector.begin();
+        while (!outputIterators.front().IsAtEnd())
+        {
+          bool isValid = true;
 
-          typename ImageRegionConstIteratorType::IndexType currentIndex;
-          if(regionInputIterators != regionInputItEnd)
+          if (m_Mask.IsNotNull())
           {
-            currentIndex = ( *regionInputIterators )->GetIndex();
+            isValid = maskIterator.Get() > 0;
+            ++maskIterator;
           }
 
-          while ( regionInputIterators != regionInputItEnd )
+          const typename ImageRegionConstIteratorType::IndexType currentIndex = inputIterators.front().GetIndex();
+
+          for (typename std::vector< InputImageType * >::size_type i = 0; i < inputs.size(); ++i)
           {
-            *arrayInIt++ = ( *regionInputIterators )->Get();
-            ++( *( *regionInputIterators ) );
-            ++regionInputIterators;
+            naryInputArray[i] = inputIterators[i].Get();
+            ++inputIterators[i];
           }
 
           if (isValid)
           {
-            naryOutputArray = m_Functor(naryInputArray, currentIndex);
+            naryOutputArray = functor(naryInputArray, currentIndex);
 
-            if (numberOfValidOutputImages != naryOutputArray.size())
+            if (outputs.size() != naryOutputArray.size())
             {
-              itkExceptionMacro("Error. Number of valid output images do not equal number of outputs required by functor. Number of valid outputs: "<< numberOfValidOutputImages << "; needed output number:" << this->m_Functor.GetNumberOfOutputs());
+              itkExceptionMacro("Error. Number of valid output images do not equal number of outputs required by functor. Number of valid outputs: "<< outputs.size() << "; needed output number:" << this->m_Functor.GetNumberOfOutputs());
             }
           }
           else
           {
-            for (typename NaryOutputArrayType::iterator pos = naryOutputArray.begin(); pos!= naryOutputArray.end(); ++pos)
-            {
-                *pos = 0.0;
-            }
+            naryOutputArray.resize(outputs.size());
+            std::fill(naryOutputArray.begin(), naryOutputArray.end(), 0.0);
           }
 
-          arrayOutIt = naryOutputArray.begin();
-          regionOutputIterators = outputItrVector.begin();
-          while ( regionOutputIterators != regionOutputItEnd )
+          for (typename std::vector< OutputImageType * >::size_type i = 0; i < outputs.size(); ++i)
           {
-            ( *regionOutputIterators )->Set(*arrayOutIt++);
-            ++( *( *regionOutputIterators ) );
-            ++regionOutputIterators;
+            outputIterators[i].Set(naryOutputArray[i]);
+            ++outputIterators[i];
           }
-
-          progress.CompletedPixel();
         }
       }
-      catch(...)
-      {
-        // Free memory in case of exceptions
-        regionInputIterators = inputItrVector.begin();
-        while ( regionInputIterators != regionInputItEnd )
-        {
-          delete ( *regionInputIterators++ );
-        }
 
-        regionOutputIterators = outputItrVector.begin();
-        while ( regionOutputIterators != regionOutputItEnd )
-        {
-          delete ( *regionOutputIterators++ );
-        }
+      const SizeValueType processedPixels = m_NumberOfProcessedPixels += (endLine - firstLine) * requestedRegion.GetSize(0);
 
-        delete pMaskIterator;
-        throw;
+      //like itk::ProgressReporter only the first thread reports the progress
+      if (0 == threadId)
+      {
+        this->UpdateProgress(static_cast<float>(processedPixels) / numberOfPixels);
       }
     }
 
-    // Free memory regulary
-    regionInputIterators = inputItrVector.begin();
-    while ( regionInputIterators != regionInputItEnd )
+    //the first thread may not have fetched any batch, it reports the progress at least once
+    if (0 == threadId)
     {
-      delete ( *regionInputIterators++ );
+      this->UpdateProgress(static_cast<float>(m_NumberOfProcessedPixels) / numberOfPixels);
     }
+  }
+
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputNaryFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::AfterThreadedGenerateData()
+  {
+    m_ThreadFunctors.clear();
 
-    regionOutputIterators = outputItrVector.begin();
-    while ( regionOutputIterators != regionOutputItEnd )
+    if (this->GetAbortGenerateData())
     {
-      delete ( *regionOutputIterators++ );
+      ProcessAborted e(__FILE__, __LINE__);
+      e.SetDescription("Process aborted.");
+      e.SetLocation(ITK_LOCATION);
+      throw e;
     }
-
-    delete pMaskIterator;
   }
 } // end namespace itk
 
@@ -58,8 +58,19 @@ namespace mitk
     itkSetMacro(ActivateFailureThreshold, bool);
     itkGetConstMacro(ActivateFailureThreshold, bool);
 
+    /** If set to true (default), the analytic jacobian of the model is used to compute the derivatives
+     of the cost function if the model offers one (see ModelBase::HasAnalyticJacobian()). Otherwise
+     the derivatives are computed numerically with DerivativeStepLength.*/
+    itkSetMacro(UseAnalyticJacobian, bool);
+    itkGetConstMacro(UseAnalyticJacobian, bool);
+    itkBooleanMacro(UseAnalyticJacobian);
+
     ParameterNamesType GetCriterionNames() const override;
 
+    /** Returns a workspace that keeps the cost functions and the optimizer, thus they are only
+     * instantiated once for all fits done with the workspace.*/
+    std::unique_ptr<Workspace> CreateWorkspace() const override;
+
   protected:
 
     typedef Superclass::ParametersType ParametersType;
@@ -76,13 +87,35 @@ namespace mitk
     OutputPixelArrayType GetCriteria(const ModelBase* model, const ParametersType& parameters,
         const SignalType& sample) const override;
 
-    /** Generator function that instantiates and parameterizes the cost function that should be used by the fit functor*/
+    ParametersType DoModelFitInWorkspace(const SignalType& value, const ModelBase* model,
+        const ModelBase::ParametersType& initialParameters, Workspace& workspace,
+        DebugParameterMapType& debugParameters) const override;
+
+    void GetCriteriaInWorkspace(const ModelBase* model, const ParametersType& parameters,
+        const SignalType& sample, Workspace& workspace, OutputPixelArrayType& criteria) const override;
+
+    /** Generator function that instantiates and parameterizes the cost function that should be used by the fit functor.
+     * Fits in a workspace call it only once per workspace; for the following fits the model, the signal and the settings
+     * of the functor are passed to the generated cost function (and the cost function it wraps, if it is a
+     * MVConstrainedCostFunctionDecorator).*/
     virtual MVModelFitCostFunction::Pointer GenerateCostFunction(const SignalType& value,
         const ModelBase* model) const;
 
     ParameterNamesType DefineDebugParameterNames() const override;
 
   private:
+    class LevenbergMarquardtWorkspace;
+
+    /** Sets the signal, the model and the settings of the functor to the passed cost functions.
+     * decorator may be null if no constraint checker is set.*/
+    void ConfigureCostFunction(MVModelFitCostFunction* metric, MVConstrainedCostFunctionDecorator* decorator,
+        const SignalType& value, const ModelBase* model) const;
+
+    /** Optimizes the passed cost function (already set to the optimizer) and collects the debug parameters.*/
+    ParametersType Optimize(::itk::LevenbergMarquardtOptimizer* optimizer, const MVModelFitCostFunction* metric,
+        const ModelBase* model, const ModelBase::ParametersType& initialParameters,
+        DebugParameterMapType& debugParameters) const;
+
     double m_Epsilon;
     double m_GradientTolerance;
     double m_ValueTolerance;
@@ -96,6 +129,7 @@ namespace mitk
     /**If set to true and an constraint checker is set. The cost function will allways fail if the penalty of the
      checker reaches the threshold. In this case no function evaluation will be done-*/
     bool m_ActivateFailureThreshold;
+    bool m_UseAnalyticJacobian;
   };
 
 }
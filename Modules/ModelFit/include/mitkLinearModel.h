@@ -59,6 +59,8 @@ namespace mitk
 
     ParametersSizeType  GetNumberOfDerivedParameters() const override;
 
+    bool HasAnalyticJacobian() const override;
+
   protected:
     LinearModel() {};
     ~LinearModel() override {};
@@ -70,6 +72,10 @@ namespace mitk
     itk::LightObject::Pointer InternalClone() const override;
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
+
+    void ComputeModelfunctions(const ParametersMatrixType& parameters, SignalsType& signals) const override;
+
+    void ComputeJacobian(const ParametersType& parameters, JacobianType& jacobian) const override;
     DerivedParameterMapType ComputeDerivedParameters(const mitk::ModelBase::ParametersType&
         parameters) const override;
 
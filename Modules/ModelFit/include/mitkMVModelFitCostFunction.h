@@ -26,6 +26,8 @@ namespace mitk
 /** Base class for all model fit cost function that return a multiple cost value
  * It offers also a default implementation for the numerical computation of the
  * derivatives. Normaly you just have to (re)implement CalcMeasure().
+ * If the model provides an analytic jacobian (see ModelBase::HasAnalyticJacobian()) and the cost function
+ * implements CalcMeasureDerivative(), the derivatives are computed analytically instead.
 */
 class MITKMODELFIT_EXPORT MVModelFitCostFunction : public itk::MultipleValuedCostFunction, public ModelFitCostFunctionInterface
 {
@@ -54,11 +56,24 @@ public:
     itkSetMacro(DerivativeStepLength, double);
     itkGetConstMacro(DerivativeStepLength, double);
 
+    /** Indicates if the analytic jacobian of the model should be used to compute the derivatives (if the model
+     and the cost function support it). Default is true.*/
+    itkSetMacro(UseAnalyticDerivative, bool);
+    itkGetConstMacro(UseAnalyticDerivative, bool);
+    itkBooleanMacro(UseAnalyticDerivative);
+
 protected:
 
     virtual MeasureType CalcMeasure(const ParametersType &parameters, const SignalType& signal) const = 0;
 
-    MVModelFitCostFunction() : m_DerivativeStepLength(1e-5)
+    /** Computes the derivatives of the measure from the signal of the model and its jacobian
+     * (chain rule). Reimplement it in derived classes that can do so and return true.
+     * The default implementation returns false, thus the derivatives are computed numerically.
+     * @param [out] derivative Has the size (number of parameters, number of values).*/
+    virtual bool CalcMeasureDerivative(const ParametersType &parameters, const SignalType& signal,
+                                       const ModelBase::JacobianType& signalJacobian, DerivativeType& derivative) const;
+
+    MVModelFitCostFunction() : m_DerivativeStepLength(1e-5), m_UseAnalyticDerivative(true)
     {
     }
 
@@ -71,6 +86,7 @@ private:
 
     /**value (delta of parameters) used to compute the derivatives numerically*/
     double m_DerivativeStepLength;
+    bool m_UseAnalyticDerivative;
 };
 
 }
@@ -74,6 +74,14 @@ namespace mitk
     typedef double DerivedParameterValueType;
     typedef std::map<ParameterNameType, DerivedParameterValueType> DerivedParameterMapType;
 
+    /** Matrix of parameter sets. Each row is one parameter set of the model.*/
+    typedef itk::Array2D<ParameterValueType> ParametersMatrixType;
+    /** Matrix of signals. Each row is the signal for the parameter set in the same row of a ParametersMatrixType.*/
+    typedef itk::Array2D<ModelResultType::ValueType> SignalsType;
+    /** Jacobian of the signal with respect to the parameters. Row i contains the derivatives of all signal
+     * values with respect to parameter i (same layout as itk::MultipleValuedCostFunction::DerivativeType).*/
+    typedef itk::Array2D<ModelResultType::ValueType> JacobianType;
+
     /**Default implementation returns a scale of 1.0 for every defined parameter.*/
     ParamterScaleMapType GetParameterScales() const override;
 
@@ -168,10 +176,35 @@ namespace mitk
 
     ModelResultType GetSignal(const ParametersType& parameters) const;
 
+    /** Computes the signals of several parameter sets at once (e.g. the parameter sets needed for the finite
+     * differences of a derivative). The model is validated only once for all parameter sets.
+     * @param parameters Each row is one parameter set; the number of columns must equal GetNumberOfParameters().
+     * @param [out] signals Is resized to one row per parameter set and one column per time point.*/
+    void GetSignals(const ParametersMatrixType& parameters, SignalsType& signals) const;
+
+    /** Indicates if the model implements ComputeJacobian(), thus if GetJacobian() can be used.
+     * @remark Default implementation returns false.*/
+    virtual bool HasAnalyticJacobian() const;
+
+    /** Computes the derivatives of the signal with respect to the model parameters analytically.
+     * @pre HasAnalyticJacobian() must return true.
+     * @param [out] jacobian Is resized to GetNumberOfParameters() rows and one column per time point.*/
+    void GetJacobian(const ParametersType& parameters, JacobianType& jacobian) const;
+
   protected:
 
     virtual ModelResultType ComputeModelfunction(const ParametersType& parameters) const = 0;
 
+    /** Helper function called by GetSignals(). The default implementation calls ComputeModelfunction()
+     * for every row. Reimplement it in derived classes to compute the signals in one loop or to share
+     * computations between the parameter sets.
+     * @pre signals has the size (parameters.rows(), m_TimeGrid.GetSize()).*/
+    virtual void ComputeModelfunctions(const ParametersMatrixType& parameters, SignalsType& signals) const;
+
+    /** Helper function called by GetJacobian(). Must be implemented if HasAnalyticJacobian() returns true.
+     * @pre jacobian has the size (GetNumberOfParameters(), m_TimeGrid.GetSize()).*/
+    virtual void ComputeJacobian(const ParametersType& parameters, JacobianType& jacobian) const;
+
     /** Member is called by GetSignal() before ComputeModelfunction(). It indicates if model is in a valid state and
      * ready to compute the signal. The default implementation checks nothing and always returns true.
      * Reimplement to realize special behavior for derived classes.
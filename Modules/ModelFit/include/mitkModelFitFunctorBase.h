@@ -15,6 +15,8 @@ found in the LICENSE file.
 
 #include <itkObject.h>
 
+#include <memory>
+
 #include <mitkVector.h>
 
 #include "mitkModelBase.h"
@@ -54,6 +56,38 @@ namespace mitk
     OutputPixelArrayType Compute(const InputPixelArrayType& value, const ModelBase* model,
                                  const ModelBase::ParametersType& initialParameters) const;
 
+    /** Buffers and helper objects that are reused by Compute() for consecutive fits, e.g. for all pixels
+     * fitted by one thread. Derived functors may extend the workspace by overwriting CreateWorkspace().
+     * A workspace must only be used by one thread at a time.*/
+    class MITKMODELFIT_EXPORT Workspace
+    {
+    public:
+      virtual ~Workspace();
+
+      ModelFitCostFunctionInterface::SignalType Sample;
+      OutputPixelArrayType DerivedParameters;
+      OutputPixelArrayType Criteria;
+      OutputPixelArrayType EvaluationParameters;
+      /** Debug parameters of the current fit; they are cleared at the start of every fit.*/
+      std::map<std::string, ParameterImagePixelType> DebugParameters;
+      ModelBase::ParameterNamesType DebugParameterNames;
+      std::size_t NumberOfCriteria = 0;
+      bool Initialized = false;
+    };
+
+    /** Creates a workspace for Compute(). Functors that want to reuse additional objects (e.g. optimizers
+     * or cost functions) return a derived workspace.*/
+    virtual std::unique_ptr<Workspace> CreateWorkspace() const;
+
+    /** Same as the Compute() above, but reuses the buffers of the passed workspace instead of allocating
+     * them for every call and stores the values in result. Use this version if many fits are done,
+     * e.g. for every pixel of an image.
+     * @param workspace Workspace created by CreateWorkspace() of this functor.
+     * @param [out] result Values determined by the fit (see the Compute() above).*/
+    void Compute(const InputPixelArrayType& value, const ModelBase* model,
+                 const ModelBase::ParametersType& initialParameters, Workspace& workspace,
+                 OutputPixelArrayType& result) const;
+
     /** Returns the number of outputs the fit functor will return if compute is called.
      * The number depends in parts on the passed model.
      * @exception Exception will be thrown if no valid model is passed.*/
@@ -99,12 +133,20 @@ namespace mitk
     OutputPixelArrayType GetDerivedParameters(const ModelBase* model,
         const ParametersType& parameters) const;
 
+    /** Same as the GetDerivedParameters() above, but stores the values in result.*/
+    void GetDerivedParameters(const ModelBase* model, const ParametersType& parameters,
+        OutputPixelArrayType& result) const;
+
     /** Internal Method called by Compute().
       Gets the evaluation parameters for all cost functions enlisted by the user, based on
       the model with the final found parameters of the fit and the input signal.*/
     OutputPixelArrayType GetEvaluationParameters(const ModelBase* model,
         const ParametersType& parameters, const SignalType& sample) const;
 
+    /** Same as the GetEvaluationParameters() above, but stores the values in result.*/
+    void GetEvaluationParameters(const ModelBase* model, const ParametersType& parameters,
+        const SignalType& sample, OutputPixelArrayType& result) const;
+
     typedef std::map<std::string, ParameterImagePixelType> DebugParameterMapType;
 
     /** Internal Method called by Compute(). It does the real fit and returns the found parameters.
@@ -119,6 +161,17 @@ namespace mitk
                                       const ModelBase::ParametersType& initialParameters,
                                       DebugParameterMapType& debugParameters) const = 0;
 
+    /** Version of DoModelFit() that is called by Compute() with a workspace. The default implementation
+    just calls DoModelFit(). Overwrite it to reuse the objects of a derived workspace (see CreateWorkspace()).*/
+    virtual ParametersType DoModelFitInWorkspace(const SignalType& value, const ModelBase* model,
+        const ModelBase::ParametersType& initialParameters, Workspace& workspace,
+        DebugParameterMapType& debugParameters) const;
+
+    /** Version of GetCriteria() that is called by Compute() with a workspace and stores the values in
+    criteria, which is a buffer of the workspace. The default implementation just calls GetCriteria().*/
+    virtual void GetCriteriaInWorkspace(const ModelBase* model, const ParametersType& parameters,
+        const SignalType& sample, Workspace& workspace, OutputPixelArrayType& criteria) const;
+
     /** Returns names of the depug parameters generated by the functor. Will be called by GetDebugParameterNames,
     if debug is activated. */
     virtual ParameterNamesType DefineDebugParameterNames()const = 0;
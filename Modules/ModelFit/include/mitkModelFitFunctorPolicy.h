@@ -13,13 +13,21 @@ found in the LICENSE file.
 #ifndef MODELFITFUNCTOR_POLICY_H
 #define MODELFITFUNCTOR_POLICY_H
 
+#include <memory>
+
 #include "itkIndex.h"
 #include "mitkModelFitFunctorBase.h"
+#include "mitkModelParameterizerBase.h"
 #include "MitkModelFitExports.h"
 
 namespace mitk
 {
 
+  /** Functor policy that fits a model to the signal of a pixel (e.g. used with itk::MultiOutputNaryFunctorImageFilter).
+   * Each instance keeps a workspace for the fits it computes: the workspace of the fit functor,
+   * the parameterized model (if it has no local static parameters and therefore is the same for all positions),
+   * the default initial parameterization and the result of the last fit. Copies of the policy start with an empty
+   * workspace, thus every thread should use its own copy.*/
   class MITKMODELFIT_EXPORT ModelFitFunctorPolicy
   {
   public:
@@ -37,6 +45,20 @@ namespace mitk
     ModelFitFunctorPolicy()
     {};
 
+    ModelFitFunctorPolicy(const ModelFitFunctorPolicy& other) : m_Functor(other.m_Functor), m_ModelParameterizer(other.m_ModelParameterizer)
+    {};
+
+    ModelFitFunctorPolicy& operator=(const ModelFitFunctorPolicy& other)
+    {
+      if (this != &other)
+      {
+        m_Functor = other.m_Functor;
+        m_ModelParameterizer = other.m_ModelParameterizer;
+        this->ResetWorkspace();
+      }
+      return *this;
+    }
+
     ~ModelFitFunctorPolicy() {};
 
     unsigned int GetNumberOfOutputs() const
@@ -60,6 +82,7 @@ namespace mitk
       }
 
       m_Functor = functor;
+      this->ResetWorkspace();
     }
 
     void SetModelParameterizer(const ParameterizerType* parameterizer)
@@ -70,6 +93,7 @@ namespace mitk
       }
 
       m_ModelParameterizer = parameterizer;
+      this->ResetWorkspace();
     }
 
     bool operator!=(const ModelFitFunctorPolicy& other) const
@@ -83,8 +107,10 @@ namespace mitk
              (this->m_ModelParameterizer == other.m_ModelParameterizer);
     }
 
-    inline OutputPixelArrayType operator()(const InputPixelArrayType& value,
-                                           const IndexType& currentIndex) const
+    /** Fits the model to the signal of the pixel at currentIndex. The returned values are valid until
+     * the next call of this instance.*/
+    inline const OutputPixelArrayType& operator()(const InputPixelArrayType& value,
+                                                  const IndexType& currentIndex) const
     {
       if (!m_Functor)
       {
@@ -96,19 +122,64 @@ namespace mitk
         itkGenericExceptionMacro( << "Error. Cannot process operator(). Parameterizer is Null.");
       }
 
-      ParameterizerType::ModelBasePointer parameterizedModel =
-        m_ModelParameterizer->GenerateParameterizedModel(currentIndex);
-      ParameterizerType::ParametersType initialParams = m_ModelParameterizer->GetInitialParameterization(
-            currentIndex);
-      OutputPixelArrayType result = m_Functor->Compute(value, parameterizedModel, initialParams);
+      if (!m_FitWorkspace)
+      {
+        m_FitWorkspace = m_Functor->CreateWorkspace();
+        m_HasDefaultInitialParameters = !m_ModelParameterizer->HasInitialParameterizationDelegate();
+        if (m_HasDefaultInitialParameters)
+        {
+          m_DefaultInitialParameters = m_ModelParameterizer->GetDefaultInitialParameterization();
+        }
+
+        //models without local static parameters are the same for every position and can be reused;
+        //the parameterizer defines the same local static parameters for all positions
+        m_IsPositionIndependent = m_ModelParameterizer->GetLocalStaticParameters(currentIndex).empty();
+      }
 
-      return result;
+      if (!m_IsPositionIndependent || m_Model.IsNull())
+      {
+        m_Model = m_ModelParameterizer->GenerateParameterizedModel(currentIndex);
+      }
+
+      ParameterizerType::ModelBasePointer parameterizedModel = m_Model;
+      if (!m_IsPositionIndependent)
+      {
+        m_Model = nullptr;
+      }
+
+      if (m_HasDefaultInitialParameters)
+      {
+        m_Functor->Compute(value, parameterizedModel, m_DefaultInitialParameters, *m_FitWorkspace, m_Result);
+      }
+      else
+      {
+        ParameterizerType::ParametersType initialParams = m_ModelParameterizer->GetInitialParameterization(
+              currentIndex);
+        m_Functor->Compute(value, parameterizedModel, initialParams, *m_FitWorkspace, m_Result);
+      }
+
+      return m_Result;
     }
 
   private:
+    void ResetWorkspace()
+    {
+      m_FitWorkspace.reset();
+      m_Model = nullptr;
+      m_HasDefaultInitialParameters = false;
+      m_IsPositionIndependent = false;
+    }
 
     FunctorConstPointer m_Functor;
     ParameterizerConstPointer m_ModelParameterizer;
+
+    /** Workspace of the fits done by this instance; it is created with the first fit.*/
+    mutable std::unique_ptr<ModelFitFunctorBase::Workspace> m_FitWorkspace;
+    mutable ParameterizerType::ModelBasePointer m_Model;
+    mutable ParameterizerType::ParametersType m_DefaultInitialParameters;
+    mutable bool m_HasDefaultInitialParameters = false;
+    mutable bool m_IsPositionIndependent = false;
+    mutable OutputPixelArrayType m_Result;
   };
 
 }
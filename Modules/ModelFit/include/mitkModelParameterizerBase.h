@@ -70,6 +70,10 @@ namespace mitk
     /** Possibility to set a custom strategy for defining the initial parameterization via a delegate.*/
     void SetInitialParameterizationDelegate(const InitialParameterizationDelegateBase* delegate);
 
+    /** Returns true if a ParameterizationDelegate is set. If not, the initial parameterization is the same
+     for all positions.*/
+    bool HasInitialParameterizationDelegate() const;
+
     virtual ModelBasePointer GenerateParameterizedModel(const IndexType& currentPosition) const = 0;
     /** Generate model instance, only with global static parametrization.
      * Any local static parameter stay default.*/
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #ifndef __MITK_PIXEL_BASED_PARAMETER_FIT_IMAGE_GENERATOR_H_
 #define __MITK_PIXEL_BASED_PARAMETER_FIT_IMAGE_GENERATOR_H_
 
+#include <atomic>
 #include <map>
 
 #include <mitkImage.h>
@@ -36,6 +37,8 @@ namespace mitk
    * - criterion images: Images that encode the criterion value of the fitting strategy for the fitted parameters
    * - evaluation parameter images: Images that encode measures of additional evaluation cost functions defined by the user. (These were not part of the fitting strategy)
    * .
+   * The pixels are fitted in parallel. Each thread fetches batches of pixels as long as unfitted pixels are left
+   * and reuses its fit workspace (see ModelFitFunctorBase::CreateWorkspace()) for all of its pixels.
    */
 class MITKMODELFIT_EXPORT PixelBasedParameterFitImageGenerator: public ParameterFitImageGeneratorBase
 {
@@ -71,8 +74,20 @@ public:
     itkGetMacro(TimeGridByParameterizer, bool);
     itkBooleanMacro(TimeGridByParameterizer);
 
+    /** Number of threads used for the fit. 0 (default) uses the default number of threads of ITK.*/
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetConstMacro(NumberOfThreads, unsigned int);
+
+    /** Number of image lines a thread fits before it fetches the next batch. Default is 1.*/
+    itkSetMacro(NumberOfLinesPerBatch, unsigned int);
+    itkGetConstMacro(NumberOfLinesPerBatch, unsigned int);
+
     double GetProgress() const override;
 
+    /** Aborts a running fit (e.g. if called by an observer of the progress events or by another thread).
+     The fit stops after the current pixel batches of all threads and Generate() throws itk::ProcessAborted.*/
+    void AbortFit();
+
     ParameterNamesType GetParameterNames() const override;
 
     ParameterNamesType GetDerivedParameterNames() const override;
@@ -82,7 +97,8 @@ public:
     ParameterNamesType GetEvaluationParameterNames() const override;
 
 protected:
-  PixelBasedParameterFitImageGenerator() : m_Progress(0), m_TimeGridByParameterizer(false)
+  PixelBasedParameterFitImageGenerator() : m_Progress(0), m_TimeGridByParameterizer(false), m_NumberOfThreads(0),
+    m_NumberOfLinesPerBatch(1), m_AbortRequested(false)
   {
     m_InternalMask = nullptr;
     m_Mask = nullptr;
@@ -123,6 +139,10 @@ private:
     /**Indicates if the time grid defined in the parameterizer should be used (True)
     or if the filter should extract the time grid from the input image (False).*/
     bool m_TimeGridByParameterizer;
+
+    unsigned int m_NumberOfThreads;
+    unsigned int m_NumberOfLinesPerBatch;
+    std::atomic<bool> m_AbortRequested;
 };
 
 }
@@ -40,6 +40,10 @@ protected:
 
     MeasureType CalcMeasure(const ParametersType &parameters, const SignalType& signal) const override;
 
+    /** d(sample - signal)^2/dp = -2 * (sample - signal) * dsignal/dp*/
+    bool CalcMeasureDerivative(const ParametersType &parameters, const SignalType& signal,
+                               const ModelBase::JacobianType& signalJacobian, DerivativeType& derivative) const override;
+
     SquaredDifferencesFitCostFunction()
     {
     }
@@ -56,6 +56,8 @@ namespace mitk
 
     ParametersSizeType GetNumberOfStaticParameters() const override;
 
+    bool HasAnalyticJacobian() const override;
+
   protected:
     T2DecayModel() {};
     ~T2DecayModel() override {};
@@ -68,6 +70,10 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    void ComputeModelfunctions(const ParametersMatrixType& parameters, SignalsType& signals) const override;
+
+    void ComputeJacobian(const ParametersType& parameters, JacobianType& jacobian) const override;
+
     void SetStaticParameter(const ParameterNameType& name,
                                     const StaticParameterValuesType& values) override;
     StaticParameterValuesType GetStaticParameterValue(const ParameterNameType& name) const override;
@@ -31,9 +31,20 @@ void
   if (process)
   {
     this->m_Progress = process->GetProgress();
+
+    if (this->m_AbortRequested)
+    {
+      process->AbortGenerateDataOn();
+    }
   }
 };
 
+void
+  mitk::PixelBasedParameterFitImageGenerator::AbortFit()
+{
+  this->m_AbortRequested = true;
+};
+
 template <typename TPixel, unsigned int VDim>
 void
   mitk::PixelBasedParameterFitImageGenerator::DoPrepareMask(itk::Image<TPixel, VDim>* image)
@@ -132,6 +143,12 @@ void
     fitFilter->SetMask(this->m_InternalMask);
   }
 
+  if (this->m_NumberOfThreads > 0)
+  {
+    fitFilter->SetNumberOfThreads(this->m_NumberOfThreads);
+  }
+  fitFilter->SetNumberOfLinesPerBatch(this->m_NumberOfLinesPerBatch);
+
   //generate the fits
   fitFilter->Update();
 
@@ -214,6 +231,7 @@ void
 void mitk::PixelBasedParameterFitImageGenerator::DoFitAndGetResults(ParameterImageMapType& parameterImages, ParameterImageMapType& derivedParameterImages, ParameterImageMapType& criterionImages, ParameterImageMapType& evaluationParameterImages)
 {
   this->m_Progress = 0;
+  this->m_AbortRequested = false;
 
   if(this->m_Mask.IsNotNull())
   {
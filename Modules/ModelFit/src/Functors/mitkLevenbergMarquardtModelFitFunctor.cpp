@@ -17,10 +17,26 @@ found in the LICENSE file.
 #include <chrono>
 #include <mitkExceptionMacro.h>
 
+class mitk::LevenbergMarquardtModelFitFunctor::LevenbergMarquardtWorkspace : public Workspace
+{
+public:
+  /** Cost function generated by GenerateCostFunction(), the metric it wraps and its decorator (if any).*/
+  ::mitk::MVModelFitCostFunction::Pointer CostFunction;
+  ::mitk::MVModelFitCostFunction::Pointer Metric;
+  ::mitk::MVConstrainedCostFunctionDecorator::Pointer Decorator;
+  ::mitk::SumOfSquaredDifferencesFitCostFunction::Pointer CriterionMetric;
+  ::itk::LevenbergMarquardtOptimizer::Pointer Optimizer;
+
+  /** Cost function and problem size the optimizer was set up for.*/
+  const ::mitk::MVModelFitCostFunction* OptimizerCostFunction = nullptr;
+  unsigned int OptimizerNumberOfValues = 0;
+  unsigned int OptimizerNumberOfParameters = 0;
+};
+
 mitk::LevenbergMarquardtModelFitFunctor::
 LevenbergMarquardtModelFitFunctor(): m_Epsilon(1e-5), m_GradientTolerance(1e-3),
   m_ValueTolerance(1e-5), m_Iterations(1000), m_DerivativeStepLength(1e-5),
-  m_ActivateFailureThreshold(true)
+  m_ActivateFailureThreshold(true), m_UseAnalyticJacobian(true)
 {};
 
 mitk::LevenbergMarquardtModelFitFunctor::
@@ -57,27 +73,43 @@ mitk::MVModelFitCostFunction::Pointer mitk::LevenbergMarquardtModelFitFunctor::G
 {
   ::mitk::SquaredDifferencesFitCostFunction::Pointer metric
     = ::mitk::SquaredDifferencesFitCostFunction::New();
-  metric->SetModel(model);
-  metric->SetSample(value);
-  metric->SetDerivativeStepLength(m_DerivativeStepLength);
 
   mitk::MVModelFitCostFunction::Pointer result = metric.GetPointer();
+  ::mitk::MVConstrainedCostFunctionDecorator::Pointer decorator;
 
   if (m_ConstraintChecker.IsNotNull())
   {
-    ::mitk::MVConstrainedCostFunctionDecorator::Pointer decorator
-      = ::mitk::MVConstrainedCostFunctionDecorator::New();
+    decorator = ::mitk::MVConstrainedCostFunctionDecorator::New();
+    result = decorator;
+  }
+
+  this->ConfigureCostFunction(metric, decorator, value, model);
+
+  return result;
+};
+
+void mitk::LevenbergMarquardtModelFitFunctor::ConfigureCostFunction(MVModelFitCostFunction* metric,
+  MVConstrainedCostFunctionDecorator* decorator, const SignalType& value, const ModelBase* model) const
+{
+  metric->SetModel(model);
+  metric->SetSample(value);
+  metric->SetDerivativeStepLength(m_DerivativeStepLength);
+  metric->SetUseAnalyticDerivative(m_UseAnalyticJacobian);
+
+  if (decorator)
+  {
     decorator->SetConstraintChecker(m_ConstraintChecker);
     decorator->SetWrappedCostFunction(metric);
-    decorator->SetFailureThreshold(m_ConstraintChecker->GetFailedConstraintValue());
+    if (m_ConstraintChecker.IsNotNull())
+    {
+      decorator->SetFailureThreshold(m_ConstraintChecker->GetFailedConstraintValue());
+    }
 
     decorator->SetModel(model);
     decorator->SetSample(value);
     decorator->SetActivateFailureThreshold(m_ActivateFailureThreshold);
-    result = decorator;
+    decorator->ResetEvaluationCounts();
   }
-
-  return result;
 };
 
 mitk::LevenbergMarquardtModelFitFunctor::ParameterNamesType
@@ -96,11 +128,94 @@ mitk::LevenbergMarquardtModelFitFunctor::DefineDebugParameterNames() const
   return result;
 };
 
+std::unique_ptr<mitk::ModelFitFunctorBase::Workspace>
+mitk::LevenbergMarquardtModelFitFunctor::CreateWorkspace() const
+{
+  return std::unique_ptr<Workspace>(new LevenbergMarquardtWorkspace);
+};
+
 mitk::LevenbergMarquardtModelFitFunctor::ParametersType
 mitk::LevenbergMarquardtModelFitFunctor::
 DoModelFit(const SignalType& value, const ModelBase* model,
            const ModelBase::ParametersType& initialParameters,
            DebugParameterMapType& debugParameters) const
+{
+  mitk::MVModelFitCostFunction::Pointer metric = this->GenerateCostFunction(value, model);
+
+  ::itk::LevenbergMarquardtOptimizer::Pointer optimizer = ::itk::LevenbergMarquardtOptimizer::New();
+  optimizer->SetCostFunction(metric);
+
+  return this->Optimize(optimizer, metric, model, initialParameters, debugParameters);
+};
+
+mitk::LevenbergMarquardtModelFitFunctor::ParametersType
+mitk::LevenbergMarquardtModelFitFunctor::
+DoModelFitInWorkspace(const SignalType& value, const ModelBase* model,
+                      const ModelBase::ParametersType& initialParameters, Workspace& workspace,
+                      DebugParameterMapType& debugParameters) const
+{
+  auto& lmWorkspace = dynamic_cast<LevenbergMarquardtWorkspace&>(workspace);
+
+  if (lmWorkspace.CostFunction.IsNull())
+  {
+    //the cost function is generated once per workspace (thus derived functors may provide their own)
+    //and only reconfigured for the following fits
+    lmWorkspace.CostFunction = this->GenerateCostFunction(value, model);
+    lmWorkspace.Decorator = dynamic_cast<::mitk::MVConstrainedCostFunctionDecorator*>(lmWorkspace.CostFunction.GetPointer());
+    lmWorkspace.Metric = lmWorkspace.CostFunction;
+    if (lmWorkspace.Decorator.IsNotNull())
+    {
+      //the wrapped cost function has been generated for this workspace, thus it may be changed
+      lmWorkspace.Metric = const_cast<::mitk::MVModelFitCostFunction*>(lmWorkspace.Decorator->GetWrappedCostFunction());
+    }
+    lmWorkspace.Optimizer = ::itk::LevenbergMarquardtOptimizer::New();
+  }
+  else
+  {
+    this->ConfigureCostFunction(lmWorkspace.Metric, lmWorkspace.Decorator, value, model);
+  }
+
+  mitk::MVModelFitCostFunction* metric = lmWorkspace.CostFunction;
+
+  //the optimizer adapts itself to the number of values and parameters when the cost function is set;
+  //it can be reused as long as both stay the same
+  if (lmWorkspace.OptimizerCostFunction != metric
+      || lmWorkspace.OptimizerNumberOfValues != metric->GetNumberOfValues()
+      || lmWorkspace.OptimizerNumberOfParameters != metric->GetNumberOfParameters())
+  {
+    lmWorkspace.Optimizer->SetCostFunction(metric);
+    lmWorkspace.OptimizerCostFunction = metric;
+    lmWorkspace.OptimizerNumberOfValues = metric->GetNumberOfValues();
+    lmWorkspace.OptimizerNumberOfParameters = metric->GetNumberOfParameters();
+  }
+
+  return this->Optimize(lmWorkspace.Optimizer, metric, model, initialParameters, debugParameters);
+};
+
+void
+mitk::LevenbergMarquardtModelFitFunctor::
+GetCriteriaInWorkspace(const ModelBase* model, const ParametersType& parameters,
+                       const SignalType& sample, Workspace& workspace, OutputPixelArrayType& criteria) const
+{
+  auto& lmWorkspace = dynamic_cast<LevenbergMarquardtWorkspace&>(workspace);
+
+  if (lmWorkspace.CriterionMetric.IsNull())
+  {
+    lmWorkspace.CriterionMetric = ::mitk::SumOfSquaredDifferencesFitCostFunction::New();
+  }
+
+  lmWorkspace.CriterionMetric->SetModel(model);
+  lmWorkspace.CriterionMetric->SetSample(sample);
+
+  criteria.resize(1);
+  criteria[0] = lmWorkspace.CriterionMetric->GetValue(parameters);
+};
+
+mitk::LevenbergMarquardtModelFitFunctor::ParametersType
+mitk::LevenbergMarquardtModelFitFunctor::
+Optimize(::itk::LevenbergMarquardtOptimizer* optimizer, const MVModelFitCostFunction* metric,
+         const ModelBase* model, const ModelBase::ParametersType& initialParameters,
+         DebugParameterMapType& debugParameters) const
 {
     std::chrono::time_point<std::chrono::system_clock> startTime;
     startTime = std::chrono::system_clock::now();
@@ -123,11 +238,6 @@ DoModelFit(const SignalType& value, const ModelBase* model,
     scales.Fill(1.0);
   }
 
-  mitk::MVModelFitCostFunction::Pointer metric = this->GenerateCostFunction(value, model);
-
-  ::itk::LevenbergMarquardtOptimizer::Pointer optimizer = ::itk::LevenbergMarquardtOptimizer::New();
-
-  optimizer->SetCostFunction(metric);
   optimizer->SetEpsilonFunction(m_Epsilon);
   optimizer->SetGradientTolerance(m_GradientTolerance);
   optimizer->SetNumberOfIterations(m_Iterations);
@@ -152,7 +262,7 @@ DoModelFit(const SignalType& value, const ModelBase* model,
     debugParameters.insert(std::make_pair("stop_condition", value));
 
 
-    const ::mitk::MVConstrainedCostFunctionDecorator* decorator = dynamic_cast<const ::mitk::MVConstrainedCostFunctionDecorator*>(metric.GetPointer());
+    const ::mitk::MVConstrainedCostFunctionDecorator* decorator = dynamic_cast<const ::mitk::MVConstrainedCostFunctionDecorator*>(metric);
     if (decorator)
     {
       value = decorator->GetPenaltyRatio();
@@ -36,17 +36,48 @@ void mitk::MVModelFitCostFunction::GetDerivative (const ParametersType &paramete
 
   derivative.SetSize(paramCount,m_Sample.Size());
 
+  if (m_UseAnalyticDerivative && m_Model->HasAnalyticJacobian())
+  {
+    SignalType signal = m_Model->GetSignal(parameters);
+    if(signal.GetSize() != m_Sample.GetSize()) itkExceptionMacro("Signal size does not matche sample size!");
+
+    ModelBase::JacobianType jacobian;
+    m_Model->GetJacobian(parameters, jacobian);
+
+    if (CalcMeasureDerivative(parameters, signal, jacobian, derivative))
+    {
+      return;
+    }
+  }
+
+  //compute the signals of all shifted parameter sets at once; row 2*i is shifted down, row 2*i+1 up in parameter i
+  ModelBase::ParametersMatrixType shiftedParameters(2 * paramCount, paramCount);
   for ( ParametersType::SizeValueType i = 0; i < paramCount; i++ )
   {
-    ParametersType newParameters = parameters;
-    newParameters[i] -= m_DerivativeStepLength;
+    shiftedParameters.set_row(2 * i, parameters);
+    shiftedParameters(2 * i, i) -= m_DerivativeStepLength;
+    shiftedParameters.set_row(2 * i + 1, parameters);
+    shiftedParameters(2 * i + 1, i) += m_DerivativeStepLength;
+  }
 
-    MeasureType e0 = GetValue(newParameters);
+  ModelBase::SignalsType signals;
+  m_Model->GetSignals(shiftedParameters, signals);
 
-    newParameters = parameters;
-    newParameters[i] += m_DerivativeStepLength;
+  if(signals.cols() != m_Sample.GetSize()) itkExceptionMacro("Signal size does not matche sample size!");
+  if(signals.cols() == 0)  itkExceptionMacro("Signal is empty!");
 
-    MeasureType e1 = GetValue(newParameters);
+  ParametersType newParameters(paramCount);
+  SignalType signal(signals.cols());
+
+  for ( ParametersType::SizeValueType i = 0; i < paramCount; i++ )
+  {
+    newParameters.copy_in(shiftedParameters[2 * i]);
+    signal.copy_in(signals[2 * i]);
+    MeasureType e0 = CalcMeasure(newParameters, signal);
+
+    newParameters.copy_in(shiftedParameters[2 * i + 1]);
+    signal.copy_in(signals[2 * i + 1]);
+    MeasureType e1 = CalcMeasure(newParameters, signal);
 
     for(MeasureType::SizeValueType j = 0; j<measureCount; ++j)
     {
@@ -57,6 +88,12 @@ void mitk::MVModelFitCostFunction::GetDerivative (const ParametersType &paramete
 
 };
 
+bool mitk::MVModelFitCostFunction::CalcMeasureDerivative(const ParametersType & /*parameters*/, const SignalType & /*signal*/,
+  const ModelBase::JacobianType & /*signalJacobian*/, DerivativeType & /*derivative*/) const
+{
+  return false;
+};
+
 unsigned int mitk::MVModelFitCostFunction::GetNumberOfParameters() const
 {
   return m_Model->GetNumberOfParameters();
@@ -12,10 +12,34 @@ found in the LICENSE file.
 
 #include "mitkModelFitFunctorBase.h"
 
+mitk::ModelFitFunctorBase::Workspace::~Workspace()
+{
+};
+
+std::unique_ptr<mitk::ModelFitFunctorBase::Workspace>
+mitk::ModelFitFunctorBase::CreateWorkspace() const
+{
+  return std::unique_ptr<Workspace>(new Workspace);
+};
+
 mitk::ModelFitFunctorBase::OutputPixelArrayType
 mitk::ModelFitFunctorBase::
 Compute(const InputPixelArrayType& value, const ModelBase* model,
         const ModelBase::ParametersType& initialParameters) const
+{
+  std::unique_ptr<Workspace> workspace = this->CreateWorkspace();
+
+  OutputPixelArrayType result;
+  this->Compute(value, model, initialParameters, *workspace, result);
+
+  return result;
+};
+
+void
+mitk::ModelFitFunctorBase::
+Compute(const InputPixelArrayType& value, const ModelBase* model,
+        const ModelBase::ParametersType& initialParameters, Workspace& workspace,
+        OutputPixelArrayType& result) const
 {
   if (!model)
   {
@@ -28,36 +52,48 @@ Compute(const InputPixelArrayType& value, const ModelBase* model,
                       << model->GetNumberOfParameters() << "; Initial parameters: " << initialParameters);
   }
 
-  SignalType sample(value.size());
+  if (!workspace.Initialized)
+  {
+    //names and counts are determined once per workspace as they do not change between fits
+    workspace.DebugParameterNames = this->GetDebugParameterNames();
+    workspace.NumberOfCriteria = this->GetCriterionNames().size();
+    workspace.Initialized = true;
+  }
 
-  for (SignalType::SizeValueType i = 0; i < sample.Size(); ++i)
+  SignalType& sample = workspace.Sample;
+  if (sample.Size() != value.size())
   {
-    sample[i] = value [i];
+    sample.SetSize(value.size());
   }
 
-  DebugParameterMapType debugParams;
-  ParameterNamesType debugNames;
-  if (this->m_DebugParameterMaps)
+  for (SignalType::SizeValueType i = 0; i < sample.Size(); ++i)
   {
-    debugNames = this->GetDebugParameterNames();
+    sample[i] = value [i];
   }
 
-  ParametersType fittedParameters = DoModelFit(sample, model, initialParameters, debugParams);
+  //the debug parameters of the previous fit must not be mistaken for the ones of this fit
+  DebugParameterMapType& debugParams = workspace.DebugParameters;
+  debugParams.clear();
+  const ParameterNamesType& debugNames = workspace.DebugParameterNames;
+
+  ParametersType fittedParameters = DoModelFitInWorkspace(sample, model, initialParameters, workspace, debugParams);
 
-  OutputPixelArrayType derivedParameters = this->GetDerivedParameters(model, fittedParameters);
+  OutputPixelArrayType& derivedParameters = workspace.DerivedParameters;
+  this->GetDerivedParameters(model, fittedParameters, derivedParameters);
 
-  OutputPixelArrayType criteria = this->GetCriteria(model, fittedParameters, sample);
+  OutputPixelArrayType& criteria = workspace.Criteria;
+  this->GetCriteriaInWorkspace(model, fittedParameters, sample, workspace, criteria);
 
-  OutputPixelArrayType evaluationParameters = this->GetEvaluationParameters(model, fittedParameters,
-      sample);
+  OutputPixelArrayType& evaluationParameters = workspace.EvaluationParameters;
+  this->GetEvaluationParameters(model, fittedParameters, sample, evaluationParameters);
 
-  if (criteria.size() != this->GetCriterionNames().size())
+  if (criteria.size() != workspace.NumberOfCriteria)
   {
     itkExceptionMacro("ModelFitInfo implementation seems to be inconsitent. Number of criterion values is not equal to number of criterion names.");
   }
 
-  OutputPixelArrayType result(fittedParameters.Size() + derivedParameters.size() + criteria.size() +
-                              evaluationParameters.size() + debugNames.size());
+  result.resize(fittedParameters.Size() + derivedParameters.size() + criteria.size() +
+                evaluationParameters.size() + debugNames.size());
 
   for (ParametersType::SizeValueType i = 0; i < fittedParameters.Size(); ++i)
   {
@@ -96,8 +132,21 @@ Compute(const InputPixelArrayType& value, const ModelBase* model,
       result[offset + j] = pos->second;
     }
   }
+};
 
-  return result;
+mitk::ModelFitFunctorBase::ParametersType
+mitk::ModelFitFunctorBase::DoModelFitInWorkspace(const SignalType& value, const ModelBase* model,
+    const ModelBase::ParametersType& initialParameters, Workspace& /*workspace*/,
+    DebugParameterMapType& debugParameters) const
+{
+  return this->DoModelFit(value, model, initialParameters, debugParameters);
+};
+
+void
+mitk::ModelFitFunctorBase::GetCriteriaInWorkspace(const ModelBase* model, const ParametersType& parameters,
+    const SignalType& sample, Workspace& /*workspace*/, OutputPixelArrayType& criteria) const
+{
+  criteria = this->GetCriteria(model, parameters, sample);
 };
 
 unsigned int
@@ -196,9 +245,18 @@ mitk::ModelFitFunctorBase::
 mitk::ModelFitFunctorBase::OutputPixelArrayType
 mitk::ModelFitFunctorBase::GetDerivedParameters(const ModelBase* model,
     const ParametersType& parameters) const
+{
+  OutputPixelArrayType result;
+  this->GetDerivedParameters(model, parameters, result);
+  return result;
+};
+
+void
+mitk::ModelFitFunctorBase::GetDerivedParameters(const ModelBase* model,
+    const ParametersType& parameters, OutputPixelArrayType& result) const
 {
   ModelBase::DerivedParameterMapType derivedParameterMap = model->GetDerivedParameters(parameters);
-  OutputPixelArrayType result(derivedParameterMap.size());
+  result.resize(derivedParameterMap.size());
 
   unsigned int i = 0;
 
@@ -207,17 +265,24 @@ mitk::ModelFitFunctorBase::GetDerivedParameters(const ModelBase* model,
   {
     result[i] = pos->second;
   }
-
-  return result;
 };
 
 mitk::ModelFitFunctorBase::OutputPixelArrayType
 mitk::ModelFitFunctorBase::GetEvaluationParameters(const ModelBase* model,
     const ParametersType& parameters, const SignalType& sample) const
+{
+  OutputPixelArrayType result;
+  this->GetEvaluationParameters(model, parameters, sample, result);
+  return result;
+};
+
+void
+mitk::ModelFitFunctorBase::GetEvaluationParameters(const ModelBase* model,
+    const ParametersType& parameters, const SignalType& sample, OutputPixelArrayType& result) const
 {
   m_Mutex.Lock();
 
-  OutputPixelArrayType result(m_CostFunctionMap.size());
+  result.resize(m_CostFunctionMap.size());
 
   unsigned int i = 0;
 
@@ -236,6 +301,4 @@ mitk::ModelFitFunctorBase::GetEvaluationParameters(const ModelBase* model,
   }
 
   m_Mutex.Unlock();
-
-  return result;
 };
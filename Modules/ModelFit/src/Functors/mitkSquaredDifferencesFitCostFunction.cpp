@@ -24,3 +24,17 @@ mitk::SquaredDifferencesFitCostFunction::MeasureType mitk::SquaredDifferencesFit
 
   return measure;
 }
+
+bool mitk::SquaredDifferencesFitCostFunction::CalcMeasureDerivative(const ParametersType &/*parameters*/, const SignalType &signal,
+  const ModelBase::JacobianType &signalJacobian, DerivativeType &derivative) const
+{
+  for (unsigned int i = 0; i < signalJacobian.rows(); ++i)
+  {
+    for (SignalType::size_type j = 0; j < signal.GetSize(); ++j)
+    {
+      derivative[i][j] = -2.0 * (m_Sample[j] - signal[j]) * signalJacobian(i, j);
+    }
+  }
+
+  return true;
+}
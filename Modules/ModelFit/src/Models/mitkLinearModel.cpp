@@ -78,6 +78,43 @@ mitk::LinearModel::ComputeModelfunction(const ParametersType& parameters) const
   return signal;
 };
 
+void
+mitk::LinearModel::ComputeModelfunctions(const ParametersMatrixType& parameters, SignalsType& signals) const
+{
+  const unsigned int timeSteps = m_TimeGrid.GetSize();
+  const double* timeGrid = m_TimeGrid.data_block();
+
+  for (unsigned int row = 0; row < parameters.rows(); ++row)
+  {
+    const double slope = parameters(row, 0);
+    const double offset = parameters(row, 1);
+    double* signal = signals[row];
+
+    for (unsigned int i = 0; i < timeSteps; ++i)
+    {
+      signal[i] = slope * timeGrid[i] + offset;
+    }
+  }
+};
+
+bool
+mitk::LinearModel::HasAnalyticJacobian() const
+{
+  return true;
+};
+
+void
+mitk::LinearModel::ComputeJacobian(const ParametersType& /*parameters*/, JacobianType& jacobian) const
+{
+  const unsigned int timeSteps = m_TimeGrid.GetSize();
+
+  for (unsigned int i = 0; i < timeSteps; ++i)
+  {
+    jacobian(0, i) = m_TimeGrid[i];
+    jacobian(1, i) = 1.0;
+  }
+};
+
 mitk::LinearModel::ParameterNamesType mitk::LinearModel::GetStaticParameterNames() const
 {
   ParameterNamesType result;
@@ -146,6 +146,83 @@ mitk::ModelBase::ModelResultType mitk::ModelBase::GetSignal(const ParametersType
   return signal;
 }
 
+void mitk::ModelBase::GetSignals(const ParametersMatrixType& parameters, SignalsType& signals) const
+{
+  if (parameters.cols() != this->GetNumberOfParameters())
+  {
+    itkExceptionMacro("Passed parameter matrix has wrong number of columns for model. Cannot evaluate model. Required size: "
+                      << this->GetNumberOfParameters() << "; passed parameter columns: " << parameters.cols());
+  }
+
+  std::string error;
+
+  if (!ValidateModel(error))
+  {
+    itkExceptionMacro("Cannot evaluate model and return signals. Model is in an invalid state. Validation error: "
+                      << error);
+  }
+
+  signals.SetSize(parameters.rows(), m_TimeGrid.GetSize());
+
+  ComputeModelfunctions(parameters, signals);
+}
+
+void mitk::ModelBase::ComputeModelfunctions(const ParametersMatrixType& parameters, SignalsType& signals) const
+{
+  ParametersType parameterSet(parameters.cols());
+
+  for (unsigned int row = 0; row < parameters.rows(); ++row)
+  {
+    parameterSet.copy_in(parameters[row]);
+
+    const ModelResultType signal = ComputeModelfunction(parameterSet);
+
+    if (signal.GetSize() != signals.cols())
+    {
+      itkExceptionMacro("Signal computed by the model does not match the size of the time grid. Signal size: "
+                        << signal.GetSize() << "; time grid size: " << signals.cols());
+    }
+
+    signals.set_row(row, signal);
+  }
+}
+
+bool mitk::ModelBase::HasAnalyticJacobian() const
+{
+  return false;
+};
+
+void mitk::ModelBase::GetJacobian(const ParametersType& parameters, JacobianType& jacobian) const
+{
+  if (!this->HasAnalyticJacobian())
+  {
+    itkExceptionMacro("Model does not provide an analytic jacobian. Cannot compute jacobian.");
+  }
+
+  if (parameters.size() != this->GetNumberOfParameters())
+  {
+    itkExceptionMacro("Passed parameter set has wrong size for model. Cannot compute jacobian. Required size: "
+                      << this->GetNumberOfParameters() << "; passed parameters: " << parameters);
+  }
+
+  std::string error;
+
+  if (!ValidateModel(error))
+  {
+    itkExceptionMacro("Cannot compute jacobian. Model is in an invalid state. Validation error: "
+                      << error);
+  }
+
+  jacobian.SetSize(this->GetNumberOfParameters(), m_TimeGrid.GetSize());
+
+  ComputeJacobian(parameters, jacobian);
+}
+
+void mitk::ModelBase::ComputeJacobian(const ParametersType& /*parameters*/, JacobianType& /*jacobian*/) const
+{
+  itkExceptionMacro("Model does not implement ComputeJacobian(). Cannot compute jacobian.");
+}
+
 bool mitk::ModelBase::ValidateModel(std::string& /*error*/) const
 {
   return true;
@@ -51,3 +51,10 @@ SetInitialParameterizationDelegate(const InitialParameterizationDelegateBase* de
 {
   this->m_InitialDelegate = delegate;
 };
+
+bool
+mitk::ModelParameterizerBase::
+HasInitialParameterizationDelegate() const
+{
+  return this->m_InitialDelegate.IsNotNull();
+};
@@ -57,11 +57,53 @@ mitk::T2DecayModel::ComputeModelfunction(const ParametersType& parameters) const
   for (const auto& gridPos : m_TimeGrid)
   {
     *signalPos = parameters[0] * exp(-1.0 * gridPos/ parameters[1]);
+    ++signalPos;
   }
 
   return signal;
 };
 
+void
+mitk::T2DecayModel::ComputeModelfunctions(const ParametersMatrixType& parameters, SignalsType& signals) const
+{
+  const unsigned int timeSteps = m_TimeGrid.GetSize();
+  const double* timeGrid = m_TimeGrid.data_block();
+
+  for (unsigned int row = 0; row < parameters.rows(); ++row)
+  {
+    const double m0 = parameters(row, 0);
+    const double negativeRate = -1.0 / parameters(row, 1);
+    double* signal = signals[row];
+
+    for (unsigned int i = 0; i < timeSteps; ++i)
+    {
+      signal[i] = m0 * exp(negativeRate * timeGrid[i]);
+    }
+  }
+};
+
+bool
+mitk::T2DecayModel::HasAnalyticJacobian() const
+{
+  return true;
+};
+
+void
+mitk::T2DecayModel::ComputeJacobian(const ParametersType& parameters, JacobianType& jacobian) const
+{
+  const unsigned int timeSteps = m_TimeGrid.GetSize();
+  const double m0 = parameters[0];
+  const double t2 = parameters[1];
+
+  for (unsigned int i = 0; i < timeSteps; ++i)
+  {
+    const double t = m_TimeGrid[i];
+    const double decay = exp(-t / t2);
+    jacobian(0, i) = decay;
+    jacobian(1, i) = m0 * decay * t / (t2 * t2);
+  }
+};
+
 mitk::T2DecayModel::ParameterNamesType mitk::T2DecayModel::GetStaticParameterNames() const
 {
   ParameterNamesType result;
@@ -13,4 +13,5 @@ SET(MODULE_TESTS
   mitkConcreteModelFactoryBaseTest.cpp
   mitkFormulaParserTest.cpp
   mitkModelFitResultRelationRuleTest.cpp
+  mitkModelBaseBatchedSignalTest.cpp
 )
@@ -214,5 +214,21 @@ int itkMultiOutputNaryFunctorImageFilterTest(int  /*argc*/, char*[] /*argv[]*/)
   CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #4 index #4 (functor #2)",0 == out4->GetPixel(testIndex4));
   CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #4 index #5 (functor #2)",0 == out4->GetPixel(testIndex5));
 
+  //Test with more threads than lines and batches of several lines
+  testFilter->SetNumberOfThreads(8);
+  testFilter->SetNumberOfLinesPerBatch(2);
+
+  testFilter->Update();
+
+  out1 = testFilter->GetOutput(0);
+  out3 = testFilter->GetOutput(2);
+  out4 = testFilter->GetOutput(3);
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of batched output #1 index #2 (functor #2)",333 == out1->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of batched output #1 index #3 (functor #2)",444 == out1->GetPixel(testIndex3));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of batched output #1 index #4 (functor #2)",0 == out1->GetPixel(testIndex4));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of batched output #3 index #2 (functor #2)",2 == out3->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of batched output #4 index #3 (functor #2)",1 == out4->GetPixel(testIndex3));
+
   MITK_TEST_END()
 }
@@ -0,0 +1,175 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include "mitkLevenbergMarquardtModelFitFunctor.h"
+#include "mitkLinearModel.h"
+#include "mitkT2DecayModel.h"
+
+class mitkModelBaseBatchedSignalTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkModelBaseBatchedSignalTestSuite);
+  MITK_TEST(SignalsEqualSingleSignals);
+  MITK_TEST(AnalyticJacobianEqualsNumericJacobian);
+  MITK_TEST(InvalidParameters);
+  MITK_TEST(FitWithAnalyticJacobian);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::ModelBase::TimeGridType m_Grid;
+
+  mitk::ModelBase::ParametersMatrixType CreateParameters(double first, double second) const
+  {
+    mitk::ModelBase::ParametersMatrixType parameters(5, 2);
+    for (unsigned int row = 0; row < parameters.rows(); ++row)
+    {
+      parameters(row, 0) = first + row * 0.7;
+      parameters(row, 1) = second + row * 3.1;
+    }
+    return parameters;
+  }
+
+  void CheckSignals(const mitk::ModelBase *model, const mitk::ModelBase::ParametersMatrixType &parameters)
+  {
+    mitk::ModelBase::SignalsType signals;
+    model->GetSignals(parameters, signals);
+
+    CPPUNIT_ASSERT_EQUAL(parameters.rows(), signals.rows());
+    CPPUNIT_ASSERT_EQUAL(m_Grid.GetSize(), static_cast<mitk::ModelBase::TimeGridType::SizeValueType>(signals.cols()));
+
+    for (unsigned int row = 0; row < parameters.rows(); ++row)
+    {
+      mitk::ModelBase::ParametersType rowParameters(parameters[row], parameters.cols());
+      const mitk::ModelBase::ModelResultType signal = model->GetSignal(rowParameters);
+
+      for (unsigned int i = 0; i < signal.GetSize(); ++i)
+      {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(signal[i], signals(row, i), 1e-10);
+      }
+    }
+  }
+
+  void CheckJacobian(const mitk::ModelBase *model, const mitk::ModelBase::ParametersType &parameters)
+  {
+    CPPUNIT_ASSERT(model->HasAnalyticJacobian());
+
+    mitk::ModelBase::JacobianType jacobian;
+    model->GetJacobian(parameters, jacobian);
+
+    CPPUNIT_ASSERT_EQUAL(parameters.GetSize(), static_cast<mitk::ModelBase::ParametersType::SizeValueType>(jacobian.rows()));
+
+    const double step = 1e-6;
+    for (unsigned int p = 0; p < parameters.GetSize(); ++p)
+    {
+      mitk::ModelBase::ParametersType lower = parameters;
+      lower[p] -= step;
+      mitk::ModelBase::ParametersType upper = parameters;
+      upper[p] += step;
+
+      const mitk::ModelBase::ModelResultType lowerSignal = model->GetSignal(lower);
+      const mitk::ModelBase::ModelResultType upperSignal = model->GetSignal(upper);
+
+      for (unsigned int i = 0; i < lowerSignal.GetSize(); ++i)
+      {
+        const double numeric = (upperSignal[i] - lowerSignal[i]) / (2 * step);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(numeric, jacobian(p, i), 1e-4);
+      }
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_Grid.SetSize(12);
+    for (unsigned int i = 0; i < m_Grid.GetSize(); ++i)
+    {
+      m_Grid[i] = i * 2.5;
+    }
+  }
+
+  void tearDown() override {}
+
+  void SignalsEqualSingleSignals()
+  {
+    auto linearModel = mitk::LinearModel::New();
+    linearModel->SetTimeGrid(m_Grid);
+    CheckSignals(linearModel, CreateParameters(-2., 10.));
+
+    auto t2Model = mitk::T2DecayModel::New();
+    t2Model->SetTimeGrid(m_Grid);
+    CheckSignals(t2Model, CreateParameters(100., 20.));
+  }
+
+  void AnalyticJacobianEqualsNumericJacobian()
+  {
+    mitk::ModelBase::ParametersType parameters(2);
+
+    auto linearModel = mitk::LinearModel::New();
+    linearModel->SetTimeGrid(m_Grid);
+    parameters[0] = 3.;
+    parameters[1] = -4.;
+    CheckJacobian(linearModel, parameters);
+
+    auto t2Model = mitk::T2DecayModel::New();
+    t2Model->SetTimeGrid(m_Grid);
+    parameters[0] = 120.;
+    parameters[1] = 35.;
+    CheckJacobian(t2Model, parameters);
+  }
+
+  void InvalidParameters()
+  {
+    auto model = mitk::T2DecayModel::New();
+    model->SetTimeGrid(m_Grid);
+
+    mitk::ModelBase::SignalsType signals;
+    CPPUNIT_ASSERT_THROW(model->GetSignals(mitk::ModelBase::ParametersMatrixType(3, 1), signals), itk::ExceptionObject);
+
+    mitk::ModelBase::JacobianType jacobian;
+    CPPUNIT_ASSERT_THROW(model->GetJacobian(mitk::ModelBase::ParametersType(3), jacobian), itk::ExceptionObject);
+  }
+
+  void FitWithAnalyticJacobian()
+  {
+    auto model = mitk::T2DecayModel::New();
+    model->SetTimeGrid(m_Grid);
+
+    mitk::ModelBase::ParametersType parameters(2);
+    parameters[0] = 80.;
+    parameters[1] = 15.;
+    const mitk::ModelBase::ModelResultType signal = model->GetSignal(parameters);
+
+    mitk::ModelFitFunctorBase::InputPixelArrayType sample(signal.begin(), signal.end());
+
+    mitk::ModelBase::ParametersType initParameters(2);
+    initParameters[0] = 50.;
+    initParameters[1] = 10.;
+
+    auto analyticFunctor = mitk::LevenbergMarquardtModelFitFunctor::New();
+    auto numericFunctor = mitk::LevenbergMarquardtModelFitFunctor::New();
+    numericFunctor->UseAnalyticJacobianOff();
+
+    const auto analyticResult = analyticFunctor->Compute(sample, model, initParameters);
+    const auto numericResult = numericFunctor->Compute(sample, model, initParameters);
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(80., analyticResult[0], 1e-4);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(15., analyticResult[1], 1e-4);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(numericResult[0], analyticResult[0], 1e-4);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(numericResult[1], analyticResult[1], 1e-4);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkModelBaseBatchedSignal)
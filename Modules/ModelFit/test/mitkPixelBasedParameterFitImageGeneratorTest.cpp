@@ -25,6 +25,17 @@ found in the LICENSE file.
 
 #include "mitkTestDynamicImageGenerator.h"
 
+#include "itkCommand.h"
+
+void onFitProgressAbortFit(::itk::Object* caller, const itk::EventObject& /*event*/, void* /*data*/)
+{
+  auto* generator = dynamic_cast<mitk::PixelBasedParameterFitImageGenerator*>(caller);
+  if (generator)
+  {
+    generator->AbortFit();
+  }
+}
+
 int mitkPixelBasedParameterFitImageGeneratorTest(int  /*argc*/, char*[] /*argv[]*/)
 {
   // always start with this!
@@ -151,5 +162,42 @@ int mitkPixelBasedParameterFitImageGeneratorTest(int  /*argc*/, char*[] /*argv[]
     testValue = offsetAccessor2.GetPixelByIndex(testIndex6);
     MITK_TEST_CONDITION_REQUIRED(mitk::Equal(0,testValue, 1e-5, true)==true, "Check param #2 (offset) at index #6");
 
+    //Test with several threads that fetch single lines
+    mitk::PixelBasedParameterFitImageGenerator::Pointer parallelGenerator = mitk::PixelBasedParameterFitImageGenerator::New();
+    parallelGenerator->SetDynamicImage(dynamicImage);
+    parallelGenerator->SetModelParameterizer(parameterizer);
+    parallelGenerator->SetFitFunctor(testFunctor);
+    parallelGenerator->SetNumberOfThreads(4);
+    parallelGenerator->SetNumberOfLinesPerBatch(1);
+
+    parallelGenerator->Generate();
+
+    resultImages = parallelGenerator->GetParameterImages();
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> slopeAccessor3(resultImages["slope"]);
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> offsetAccessor3(resultImages["offset"]);
+
+    testValue = slopeAccessor3.GetPixelByIndex(testIndex3);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(4000,testValue, 1e-4, true)==true, "Check param #1 (slope) at index #3 (4 threads)");
+    testValue = slopeAccessor3.GetPixelByIndex(testIndex4);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(8000,testValue, 1e-4, true)==true, "Check param #1 (slope) at index #4 (4 threads)");
+    testValue = offsetAccessor3.GetPixelByIndex(testIndex2);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(10,testValue, 1e-5, true)==true, "Check param #2 (offset) at index #2 (4 threads)");
+    testValue = offsetAccessor3.GetPixelByIndex(testIndex3);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(20,testValue, 1e-5, true)==true, "Check param #2 (offset) at index #3 (4 threads)");
+
+    //Test abort of the fit
+    mitk::PixelBasedParameterFitImageGenerator::Pointer abortedGenerator = mitk::PixelBasedParameterFitImageGenerator::New();
+    abortedGenerator->SetDynamicImage(dynamicImage);
+    abortedGenerator->SetModelParameterizer(parameterizer);
+    abortedGenerator->SetFitFunctor(testFunctor);
+
+    ::itk::CStyleCommand::Pointer abortCommand = ::itk::CStyleCommand::New();
+    abortCommand->SetCallback(onFitProgressAbortFit);
+    abortedGenerator->AddObserver(::itk::ProgressEvent(), abortCommand);
+
+    MITK_TEST_FOR_EXCEPTION_BEGIN(itk::ProcessAborted)
+    abortedGenerator->Generate();
+    MITK_TEST_FOR_EXCEPTION_END(itk::ProcessAborted)
+
   MITK_TEST_END()
 }
@@ -11,11 +11,15 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkIOUtil.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
 #include <mitkImageStatisticsHolder.h>
 #include <mitkLabelSetImage.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include <algorithm>
+
 class mitkLabelSetImageTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkLabelSetImageTestSuite);
@@ -34,11 +38,31 @@ class mitkLabelSetImageTestSuite : public mitk::TestFixture
   MITK_TEST(TestRemoveLayer);
   MITK_TEST(TestRemoveLabels);
   MITK_TEST(TestMergeLabel);
+  MITK_TEST(TestLayerCompression);
+  MITK_TEST(TestLabelRegions);
   CPPUNIT_TEST_SUITE_END();
 
 private:
   mitk::LabelSetImage::Pointer m_LabelSetImage;
 
+  void FillBox(mitk::LabelSetImage *image, mitk::Label::PixelType value, int lower, int upper)
+  {
+    mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(image);
+    itk::Index<3> index;
+    for (index[2] = lower; index[2] < upper; ++index[2])
+      for (index[1] = lower; index[1] < upper; ++index[1])
+        for (index[0] = lower; index[0] < upper; ++index[0])
+          accessor.SetPixelByIndex(index, value);
+  }
+
+  unsigned int CountPixels(mitk::LabelSetImage *image, mitk::Label::PixelType value)
+  {
+    mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> accessor(image);
+    const std::size_t numberOfPixels =
+      static_cast<std::size_t>(image->GetDimension(0)) * image->GetDimension(1) * image->GetDimension(2);
+    return static_cast<unsigned int>(std::count(accessor.GetData(), accessor.GetData() + numberOfPixels, value));
+  }
+
 public:
   void setUp() override
   {
@@ -437,6 +461,155 @@ public:
     // Check if merge label has 507 + 823 = 1330 pixels
     CPPUNIT_ASSERT_MESSAGE("Label with value 7 was not remove from the image", m_LabelSetImage->GetStatistics()->GetCountOfMaxValuedVoxels() == 1330);
   }
+
+  void TestLayerCompression()
+  {
+    FillBox(m_LabelSetImage, 2, 10, 30);
+
+    mitk::LabelSet::Pointer newlayer = mitk::LabelSet::New();
+    mitk::Label::Pointer label1 = mitk::Label::New();
+    label1->SetValue(1);
+    mitk::Label::Pointer label3 = mitk::Label::New();
+    label3->SetValue(3);
+    newlayer->AddLabel(label1);
+    newlayer->AddLabel(label3);
+    m_LabelSetImage->AddLayer(newlayer);
+
+    FillBox(m_LabelSetImage, 1, 20, 40);
+    FillBox(m_LabelSetImage, 3, 25, 35);
+
+    mitk::LabelSetImage::Pointer reference = m_LabelSetImage->Clone();
+
+    m_LabelSetImage->SetLayerCompression(true);
+    CPPUNIT_ASSERT_MESSAGE("Layer 0 was not compressed", m_LabelSetImage->IsLayerCompressed(0));
+    CPPUNIT_ASSERT_MESSAGE("Layer 1 was not compressed", m_LabelSetImage->IsLayerCompressed(1));
+    CPPUNIT_ASSERT_MESSAGE("Uncompressed image reports compressed layers", !reference->IsLayerCompressed(0));
+
+    const std::size_t denseMemorySize = reference->GetLayerMemorySize(0);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong memory size of dense layer",
+                                 std::size_t(96 * 128 * 52 * sizeof(mitk::Label::PixelType)),
+                                 denseMemorySize);
+    CPPUNIT_ASSERT_MESSAGE("Compressed layer does not save memory",
+                           m_LabelSetImage->GetLayerMemorySize(0) * 10 < denseMemorySize);
+
+    // Decoding for a single use, e.g. for rendering, does not keep the decoded layer
+    const std::size_t compressedMemorySize = m_LabelSetImage->GetLayerMemorySize(0);
+    mitk::Image::ConstPointer decodedLayer = m_LabelSetImage->DecodeLayerImage(0);
+    CPPUNIT_ASSERT_MESSAGE("Decoded layer differs from uncompressed layer",
+                           mitk::Equal(*decodedLayer, *reference->GetLayerImage(0), mitk::eps, true));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Decoded layer is kept", compressedMemorySize, m_LabelSetImage->GetLayerMemorySize(0));
+    CPPUNIT_ASSERT_MESSAGE("Layer 0 is not compressed anymore", m_LabelSetImage->IsLayerCompressed(0));
+
+    // Compressed layers are decoded on access
+    CPPUNIT_ASSERT_MESSAGE("Compressed image differs from uncompressed image",
+                           mitk::Equal(*m_LabelSetImage, *reference, mitk::eps, true));
+
+    m_LabelSetImage->SetActiveLayer(0);
+    reference->SetActiveLayer(0);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong content of layer 0", 8000u, CountPixels(m_LabelSetImage, 2));
+    CPPUNIT_ASSERT_MESSAGE("Deactivated layer was not compressed", m_LabelSetImage->IsLayerCompressed(1));
+
+    // Merge label 3 into label 1 of the inactive layer, the compressed one is processed directly on its runs
+    m_LabelSetImage->MergeLabel(1, 3, 1);
+    reference->MergeLabel(1, 3, 1);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Merge changed the active layer", 8000u, CountPixels(m_LabelSetImage, 2));
+
+    m_LabelSetImage->SetActiveLayer(1);
+    reference->SetActiveLayer(1);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Label 3 was not merged", 0u, CountPixels(m_LabelSetImage, 3));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Label 3 was not merged", 8000u, CountPixels(m_LabelSetImage, 1));
+    CPPUNIT_ASSERT_MESSAGE("Compressed image differs from uncompressed image",
+                           mitk::Equal(*m_LabelSetImage, *reference, mitk::eps, true));
+
+    // Erase label 2 of the inactive layer 0
+    m_LabelSetImage->EraseLabel(2, 0);
+    reference->EraseLabel(2, 0);
+    CPPUNIT_ASSERT_MESSAGE("Compressed image differs from uncompressed image",
+                           mitk::Equal(*m_LabelSetImage, *reference, mitk::eps, true));
+
+    m_LabelSetImage->SetLayerCompression(false);
+    CPPUNIT_ASSERT_MESSAGE("Layer 0 is still compressed", !m_LabelSetImage->IsLayerCompressed(0));
+    CPPUNIT_ASSERT_MESSAGE("Layer 1 is still compressed", !m_LabelSetImage->IsLayerCompressed(1));
+
+    m_LabelSetImage->SetActiveLayer(0);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Label 2 was not erased", 0u, CountPixels(m_LabelSetImage, 2));
+  }
+
+  void TestLabelRegions()
+  {
+    typedef mitk::LabelSetImage::LabelRegionType RegionType;
+
+    mitk::Label::Pointer label = mitk::Label::New();
+    label->SetValue(1);
+    m_LabelSetImage->GetActiveLabelSet()->AddLabel(label);
+
+    FillBox(m_LabelSetImage, 1, 10, 20);
+    m_LabelSetImage->Modified();
+
+    RegionType boxRegion;
+    boxRegion.SetIndex(0, 10);
+    boxRegion.SetIndex(1, 10);
+    boxRegion.SetIndex(2, 10);
+    boxRegion.SetSize(0, 10);
+    boxRegion.SetSize(1, 10);
+    boxRegion.SetSize(2, 10);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong region of label 1", boxRegion, m_LabelSetImage->GetLabelRegion(1));
+    CPPUNIT_ASSERT_MESSAGE("Label without pixels has a region",
+                           0 == m_LabelSetImage->GetLabelRegion(2).GetNumberOfPixels());
+
+    // Write a few pixels of label 2 into slice 30 and announce the written slice
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(m_LabelSetImage);
+      itk::Index<3> index;
+      index[1] = 40;
+      index[2] = 30;
+      for (index[0] = 5; index[0] < 8; ++index[0])
+        accessor.SetPixelByIndex(index, 2);
+    }
+
+    RegionType sliceRegion;
+    sliceRegion.SetIndex(2, 30);
+    sliceRegion.SetSize(0, 96);
+    sliceRegion.SetSize(1, 128);
+    sliceRegion.SetSize(2, 1);
+    m_LabelSetImage->UpdateLabelRegions(sliceRegion);
+
+    RegionType pixelsRegion;
+    pixelsRegion.SetIndex(0, 5);
+    pixelsRegion.SetIndex(1, 40);
+    pixelsRegion.SetIndex(2, 30);
+    pixelsRegion.SetSize(0, 3);
+    pixelsRegion.SetSize(1, 1);
+    pixelsRegion.SetSize(2, 1);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Wrong region of label 2", pixelsRegion, m_LabelSetImage->GetLabelRegion(2));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Region of label 1 changed", boxRegion, m_LabelSetImage->GetLabelRegion(1));
+
+    // The merged label covers both regions
+    m_LabelSetImage->MergeLabel(1, 2);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Label 2 was not merged", 1003u, CountPixels(m_LabelSetImage, 1));
+    CPPUNIT_ASSERT_MESSAGE("Merged label still has a region",
+                           0 == m_LabelSetImage->GetLabelRegion(2).GetNumberOfPixels());
+    CPPUNIT_ASSERT_MESSAGE("Region of merged label is too small",
+                           m_LabelSetImage->GetLabelRegion(1).IsInside(boxRegion) &&
+                             m_LabelSetImage->GetLabelRegion(1).IsInside(pixelsRegion));
+
+    // The center of mass is the middle one of the label pixels in buffer order
+    m_LabelSetImage->UpdateCenterOfMass(1);
+    const mitk::Point3D center = m_LabelSetImage->GetLabel(1)->GetCenterOfMassIndex();
+    CPPUNIT_ASSERT_EQUAL(11., center[0]);
+    CPPUNIT_ASSERT_EQUAL(10., center[1]);
+    CPPUNIT_ASSERT_EQUAL(15., center[2]);
+
+    // Regions determined again from the whole image match the incrementally updated ones
+    const RegionType mergedRegion = m_LabelSetImage->GetLabelRegion(1);
+    m_LabelSetImage->Modified();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Incrementally updated region differs", mergedRegion, m_LabelSetImage->GetLabelRegion(1));
+
+    m_LabelSetImage->EraseLabel(1);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Label 1 was not erased", 0u, CountPixels(m_LabelSetImage, 1));
+    CPPUNIT_ASSERT_MESSAGE("Erased label still has a region",
+                           0 == m_LabelSetImage->GetLabelRegion(1).GetNumberOfPixels());
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkLabelSetImage)
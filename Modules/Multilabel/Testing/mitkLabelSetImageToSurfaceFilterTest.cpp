@@ -0,0 +1,308 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+#include <mitkLabelSetImageToSurfaceFilter.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <vtkFeatureEdges.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+#include <chrono>
+
+class mitkLabelSetImageToSurfaceFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLabelSetImageToSurfaceFilterTestSuite);
+  MITK_TEST(TestIncrementalUpdate);
+  MITK_TEST(TestIncrementalUpdateEqualsRegularUpdate);
+  MITK_TEST(TestIncrementalUpdateAfterLabelChange);
+  MITK_TEST(TestIncrementalUpdateOfModifiedRegion);
+  MITK_TEST(TestIncrementalSurfaceIsClosed);
+  MITK_TEST(TestAllLabels);
+  MITK_TEST(TestAllLabelsBenchmark);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::LabelSetImage::Pointer m_LabelSetImage;
+
+  void FillBox(mitk::Label::PixelType value,
+               const itk::Index<3> &lower,
+               const itk::Index<3> &upper,
+               bool announceRegion = false)
+  {
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(m_LabelSetImage);
+      itk::Index<3> index;
+      for (index[2] = lower[2]; index[2] < upper[2]; ++index[2])
+        for (index[1] = lower[1]; index[1] < upper[1]; ++index[1])
+          for (index[0] = lower[0]; index[0] < upper[0]; ++index[0])
+            accessor.SetPixelByIndex(index, value);
+    }
+
+    if (announceRegion)
+    {
+      mitk::LabelSetImage::LabelRegionType region;
+      region.SetIndex(lower);
+      for (unsigned int i = 0; i < 3; ++i)
+        region.SetSize(i, static_cast<itk::SizeValueType>(upper[i] - lower[i]));
+      m_LabelSetImage->UpdateLabelRegions(region);
+    }
+    else
+    {
+      m_LabelSetImage->Modified();
+    }
+  }
+
+  mitk::LabelSetImageToSurfaceFilter::Pointer CreateFilter(bool incremental)
+  {
+    auto filter = mitk::LabelSetImageToSurfaceFilter::New();
+    filter->SetInput(m_LabelSetImage);
+    filter->SetRequestedLabel(1);
+    filter->SetIncrementalUpdate(incremental);
+    filter->SetBlockSize(16);
+    return filter;
+  }
+
+  void CheckBounds(const double *expected, const double *actual, double tolerance)
+  {
+    for (unsigned int i = 0; i < 6; ++i)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[i], actual[i], tolerance);
+  }
+
+  void CheckClosed(vtkPolyData *surface)
+  {
+    auto boundaryEdges = vtkSmartPointer<vtkFeatureEdges>::New();
+    boundaryEdges->SetInputData(surface);
+    boundaryEdges->BoundaryEdgesOn();
+    boundaryEdges->FeatureEdgesOff();
+    boundaryEdges->ManifoldEdgesOff();
+    boundaryEdges->NonManifoldEdgesOff();
+    boundaryEdges->Update();
+
+    CPPUNIT_ASSERT(surface->GetNumberOfPolys() > 0);
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), boundaryEdges->GetOutput()->GetNumberOfCells());
+  }
+
+public:
+  void setUp() override
+  {
+    m_LabelSetImage = mitk::LabelSetImage::New();
+    mitk::Image::Pointer regularImage = mitk::Image::New();
+    unsigned int dimensions[3] = {64, 64, 64};
+    regularImage->Initialize(mitk::MakeScalarPixelType<char>(), 3, dimensions);
+    m_LabelSetImage->Initialize(regularImage);
+
+    FillBox(1, {{10, 10, 10}}, {{40, 40, 40}});
+  }
+
+  void tearDown() override { m_LabelSetImage = nullptr; }
+
+  void TestIncrementalUpdate()
+  {
+    auto filter = CreateFilter(true);
+    filter->Update();
+
+    const unsigned int numberOfBlocks = filter->GetNumberOfUpdatedBlocks();
+    CPPUNIT_ASSERT(numberOfBlocks > 0);
+    CPPUNIT_ASSERT(filter->GetOutput()->GetVtkPolyData()->GetNumberOfPoints() > 0);
+
+    // a change in one corner only touches the blocks around it
+    FillBox(0, {{36, 36, 36}}, {{40, 40, 40}});
+    filter->Update();
+
+    CPPUNIT_ASSERT(filter->GetNumberOfUpdatedBlocks() > 0);
+    CPPUNIT_ASSERT(filter->GetNumberOfUpdatedBlocks() < numberOfBlocks);
+
+    // changing the requested label drops the cache
+    FillBox(2, {{44, 44, 44}}, {{54, 54, 54}});
+    filter->SetRequestedLabel(2);
+    filter->Update();
+
+    double bounds[6];
+    filter->GetOutput()->GetVtkPolyData()->GetBounds(bounds);
+    CPPUNIT_ASSERT(bounds[0] > 42.);
+    CPPUNIT_ASSERT(bounds[1] < 55.);
+  }
+
+  void TestIncrementalUpdateEqualsRegularUpdate()
+  {
+    auto regularFilter = CreateFilter(false);
+    regularFilter->Update();
+
+    auto incrementalFilter = CreateFilter(true);
+    incrementalFilter->Update();
+
+    double regularBounds[6];
+    double incrementalBounds[6];
+    regularFilter->GetOutput()->GetVtkPolyData()->GetBounds(regularBounds);
+    incrementalFilter->GetOutput()->GetVtkPolyData()->GetBounds(incrementalBounds);
+    CheckBounds(regularBounds, incrementalBounds, 0.5);
+  }
+
+  void TestIncrementalUpdateAfterLabelChange()
+  {
+    auto incrementalFilter = CreateFilter(true);
+    incrementalFilter->Update();
+
+    // grow the label into blocks that have not been cached before
+    FillBox(1, {{30, 30, 30}}, {{50, 50, 50}});
+    incrementalFilter->Update();
+
+    auto regularFilter = CreateFilter(false);
+    regularFilter->Update();
+
+    double regularBounds[6];
+    double incrementalBounds[6];
+    regularFilter->GetOutput()->GetVtkPolyData()->GetBounds(regularBounds);
+    incrementalFilter->GetOutput()->GetVtkPolyData()->GetBounds(incrementalBounds);
+    CheckBounds(regularBounds, incrementalBounds, 0.5);
+    CPPUNIT_ASSERT(incrementalFilter->GetOutput()->GetVtkPolyData()->GetNumberOfPolys() > 0);
+  }
+
+  void TestIncrementalUpdateOfModifiedRegion()
+  {
+    auto incrementalFilter = CreateFilter(true);
+    incrementalFilter->Update();
+    const unsigned int numberOfBlocks = incrementalFilter->GetNumberOfUpdatedBlocks();
+
+    // announced writes restrict the search for changed blocks to the modified region
+    FillBox(0, {{36, 36, 36}}, {{40, 40, 40}}, true);
+    incrementalFilter->Update();
+    CPPUNIT_ASSERT(incrementalFilter->GetNumberOfUpdatedBlocks() > 0);
+    CPPUNIT_ASSERT(incrementalFilter->GetNumberOfUpdatedBlocks() < numberOfBlocks);
+
+    FillBox(1, {{30, 30, 30}}, {{50, 50, 50}}, true);
+    incrementalFilter->Update();
+
+    auto regularFilter = CreateFilter(false);
+    regularFilter->Update();
+
+    double regularBounds[6];
+    double incrementalBounds[6];
+    regularFilter->GetOutput()->GetVtkPolyData()->GetBounds(regularBounds);
+    incrementalFilter->GetOutput()->GetVtkPolyData()->GetBounds(incrementalBounds);
+    CheckBounds(regularBounds, incrementalBounds, 0.5);
+  }
+
+  void TestIncrementalSurfaceIsClosed()
+  {
+    // the label spans several blocks, whose surfaces have to be joined at the seams without gaps
+    auto filter = CreateFilter(true);
+    filter->Update();
+    CheckClosed(filter->GetOutput()->GetVtkPolyData());
+
+    FillBox(1, {{30, 30, 30}}, {{50, 50, 50}}, true);
+    filter->Update();
+    CheckClosed(filter->GetOutput()->GetVtkPolyData());
+
+    filter->SetUseSmoothing(1);
+    filter->Update();
+    CheckClosed(filter->GetOutput()->GetVtkPolyData());
+  }
+
+  void TestAllLabels()
+  {
+    // label 3 touches label 1
+    FillBox(2, {{44, 44, 44}}, {{54, 54, 54}});
+    FillBox(3, {{40, 10, 10}}, {{44, 40, 40}});
+
+    auto filter = mitk::LabelSetImageToSurfaceFilter::New();
+    filter->SetInput(m_LabelSetImage);
+    filter->GenerateAllLabelsOn();
+    filter->Update();
+
+    CPPUNIT_ASSERT_EQUAL(3u, static_cast<unsigned int>(filter->GetNumberOfIndexedOutputs()));
+    CPPUNIT_ASSERT_EQUAL(1u, static_cast<unsigned int>(filter->GetLabelForNthOutput(0)));
+    CPPUNIT_ASSERT_EQUAL(2u, static_cast<unsigned int>(filter->GetLabelForNthOutput(1)));
+    CPPUNIT_ASSERT_EQUAL(3u, static_cast<unsigned int>(filter->GetLabelForNthOutput(2)));
+
+    CPPUNIT_ASSERT_EQUAL(27000ul, filter->GetNumberOfVoxelsOfLabel(1));
+    CPPUNIT_ASSERT_EQUAL(1000ul, filter->GetNumberOfVoxelsOfLabel(2));
+    CPPUNIT_ASSERT_EQUAL(3600ul, filter->GetNumberOfVoxelsOfLabel(3));
+
+    // the surface of a box consists of two triangles per voxel face, the points are the voxel corners
+    vtkPolyData *surface = filter->GetOutput(0)->GetVtkPolyData();
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(6 * 30 * 30 * 2), surface->GetNumberOfPolys());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(31 * 31 * 31 - 29 * 29 * 29), surface->GetNumberOfPoints());
+
+    double bounds[6];
+    surface->GetBounds(bounds);
+    const double expectedBounds[6] = {9.5, 39.5, 9.5, 39.5, 9.5, 39.5};
+    CheckBounds(expectedBounds, bounds, mitk::eps);
+
+    filter->GetOutput(1)->GetVtkPolyData()->GetBounds(bounds);
+    const double expectedBounds2[6] = {43.5, 53.5, 43.5, 53.5, 43.5, 53.5};
+    CheckBounds(expectedBounds2, bounds, mitk::eps);
+  }
+
+  void TestAllLabelsBenchmark()
+  {
+    // atlas of 125 labels
+    const int boxSize = 16;
+    m_LabelSetImage = mitk::LabelSetImage::New();
+    mitk::Image::Pointer regularImage = mitk::Image::New();
+    unsigned int dimensions[3] = {5 * boxSize, 5 * boxSize, 5 * boxSize};
+    regularImage->Initialize(mitk::MakeScalarPixelType<char>(), 3, dimensions);
+    m_LabelSetImage->Initialize(regularImage);
+
+    for (int z = 0; z < 5; ++z)
+      for (int y = 0; y < 5; ++y)
+        for (int x = 0; x < 5; ++x)
+          FillBox(1 + x + 5 * y + 25 * z,
+                  {{x * boxSize, y * boxSize, z * boxSize}},
+                  {{(x + 1) * boxSize, (y + 1) * boxSize, (z + 1) * boxSize}});
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    auto allLabelsFilter = mitk::LabelSetImageToSurfaceFilter::New();
+    allLabelsFilter->SetInput(m_LabelSetImage);
+    allLabelsFilter->GenerateAllLabelsOn();
+    allLabelsFilter->Update();
+
+    const double allLabelsTime =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    CPPUNIT_ASSERT_EQUAL(125u, static_cast<unsigned int>(allLabelsFilter->GetNumberOfIndexedOutputs()));
+
+    startTime = std::chrono::steady_clock::now();
+
+    std::vector<mitk::Surface::Pointer> surfaces;
+    for (int label = 1; label <= 125; ++label)
+    {
+      auto filter = CreateFilter(false);
+      filter->SetRequestedLabel(label);
+      filter->Update();
+      surfaces.push_back(filter->GetOutput());
+    }
+
+    const double perLabelTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    MITK_INFO << "Surfaces of 125 labels: " << allLabelsTime << " s in one pass, " << perLabelTime
+              << " s label by label";
+
+    for (unsigned int i = 0; i < 125; ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(i + 1, static_cast<unsigned int>(allLabelsFilter->GetLabelForNthOutput(i)));
+
+      double bounds[6];
+      double perLabelBounds[6];
+      allLabelsFilter->GetOutput(i)->GetVtkPolyData()->GetBounds(bounds);
+      surfaces[i]->GetVtkPolyData()->GetBounds(perLabelBounds);
+      CheckBounds(perLabelBounds, bounds, 1.);
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLabelSetImageToSurfaceFilter)
@@ -9,6 +9,7 @@ set(CPP_FILES
   mitkLabelSetImageToSurfaceThreadedFilter.cpp
   mitkLabelSetImageVtkMapper2D.cpp
   mitkMultilabelObjectFactory.cpp
+  mitkRunLengthEncodedLabelLayer.cpp
   mitkLabelSetIOHelper.cpp
   mitkDICOMSegmentationPropertyHelper.cpp
   mitkDICOMSegmentationConstants.cpp
@@ -34,6 +34,8 @@ found in the LICENSE file.
 
 #include <itkCommand.h>
 
+#include <algorithm>
+
 template <typename TPixel, unsigned int VDimensions>
 void SetToZero(itk::Image<TPixel, VDimensions> *source)
 {
@@ -60,8 +62,54 @@ void CreateLabelMaskProcessing(mitk::Image *layerImage, mitk::Image *mask, mitk:
   }
 }
 
+namespace
+{
+  // Label regions are only available for 3D images, images of other dimensions are processed as a whole
+  template <typename TPixel, unsigned int VDimension>
+  itk::ImageRegion<VDimension> GetIteratedRegion(const itk::Image<TPixel, VDimension> *image,
+                                                 const mitk::LabelSetImage::LabelRegionType *)
+  {
+    return image->GetLargestPossibleRegion();
+  }
+
+  template <typename TPixel>
+  itk::ImageRegion<3> GetIteratedRegion(const itk::Image<TPixel, 3> *image,
+                                        const mitk::LabelSetImage::LabelRegionType *labelRegion)
+  {
+    return nullptr != labelRegion ? *labelRegion : image->GetLargestPossibleRegion();
+  }
+
+  // Smallest region containing both regions, empty regions are ignored
+  mitk::LabelSetImage::LabelRegionType UniteRegions(const mitk::LabelSetImage::LabelRegionType &first,
+                                                    const mitk::LabelSetImage::LabelRegionType &second)
+  {
+    if (0 == first.GetNumberOfPixels())
+      return second;
+
+    if (0 == second.GetNumberOfPixels())
+      return first;
+
+    mitk::LabelSetImage::LabelRegionType result;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      const auto lower = std::min(first.GetIndex(i), second.GetIndex(i));
+      const auto upper = std::max(first.GetUpperIndex()[i], second.GetUpperIndex()[i]);
+      result.SetIndex(i, lower);
+      result.SetSize(i, static_cast<itk::SizeValueType>(upper - lower + 1));
+    }
+    return result;
+  }
+}
+
 mitk::LabelSetImage::LabelSetImage()
-  : mitk::Image(), m_ActiveLayer(0), m_activeLayerInvalid(false), m_ExteriorLabel(nullptr)
+  : mitk::Image(),
+    m_LayerCompression(false),
+    m_ActiveLayer(0),
+    m_activeLayerInvalid(false),
+    m_ExteriorLabel(nullptr),
+    m_LabelRegionsMTime(0),
+    m_ModifiedRegionsStartMTime(0),
+    m_ModifiedRegionsMTime(0)
 {
   // Iniitlaize Background Label
   mitk::Color color;
@@ -79,9 +127,14 @@ mitk::LabelSetImage::LabelSetImage()
 
 mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
   : Image(other),
+    m_CompressedLayerContainer(other.m_CompressedLayerContainer),
+    m_LayerCompression(other.m_LayerCompression),
     m_ActiveLayer(other.GetActiveLayer()),
     m_activeLayerInvalid(false),
-    m_ExteriorLabel(other.GetExteriorLabel()->Clone())
+    m_ExteriorLabel(other.GetExteriorLabel()->Clone()),
+    m_LabelRegionsMTime(0),
+    m_ModifiedRegionsStartMTime(0),
+    m_ModifiedRegionsMTime(0)
 {
   for (unsigned int i = 0; i < other.GetNumberOfLayers(); i++)
   {
@@ -93,8 +146,8 @@ mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
     lsClone->AddObserver(itk::ModifiedEvent(), command);
     m_LabelSetContainer.push_back(lsClone);
 
-    // clone layer Image data
-    mitk::Image::Pointer liClone = other.GetLayerImage(i)->Clone();
+    // clone layer Image data, compressed layers have been copied already
+    mitk::Image::Pointer liClone = other.m_LayerContainer[i].IsNotNull() ? other.m_LayerContainer[i]->Clone() : nullptr;
     m_LayerContainer.push_back(liClone);
   }
 
@@ -104,7 +157,8 @@ mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
 
 void mitk::LabelSetImage::OnLabelSetModified()
 {
-  Superclass::Modified();
+  // changes of the label sets do not touch the pixel data
+  this->ModifiedWithKnownRegion(this->AreLabelRegionsValid(), LabelRegionType());
 }
 
 void mitk::LabelSetImage::SetExteriorLabel(mitk::Label *label)
@@ -162,14 +216,381 @@ mitk::LabelSetImage::~LabelSetImage()
 
 mitk::Image *mitk::LabelSetImage::GetLayerImage(unsigned int layer)
 {
+  this->DecodeLayer(layer);
+
+  // The caller may modify the image, thus the compressed data would be outdated
+  m_CompressedLayerContainer[layer].Clear();
+
   return m_LayerContainer[layer];
 }
 
 const mitk::Image *mitk::LabelSetImage::GetLayerImage(unsigned int layer) const
 {
+  this->DecodeLayer(layer);
   return m_LayerContainer[layer];
 }
 
+mitk::Image::ConstPointer mitk::LabelSetImage::DecodeLayerImage(unsigned int layer) const
+{
+  std::lock_guard<std::mutex> lock(m_LayerContainerMutex);
+
+  if (m_LayerContainer[layer].IsNotNull())
+    return m_LayerContainer[layer].GetPointer();
+
+  return this->CreateDecodedLayerImage(layer).GetPointer();
+}
+
+void mitk::LabelSetImage::SetLayerCompression(bool compression)
+{
+  if (compression == m_LayerCompression)
+    return;
+
+  m_LayerCompression = compression;
+
+  if (m_LayerCompression)
+  {
+    this->CompressLayers();
+  }
+  else
+  {
+    for (unsigned int layer = 0; layer < m_LayerContainer.size(); ++layer)
+    {
+      this->DecodeLayer(layer);
+      m_CompressedLayerContainer[layer].Clear();
+    }
+  }
+}
+
+bool mitk::LabelSetImage::GetLayerCompression() const
+{
+  return m_LayerCompression;
+}
+
+void mitk::LabelSetImage::CompressLayers()
+{
+  for (unsigned int layer = 0; layer < m_LayerContainer.size(); ++layer)
+  {
+    if (m_LayerContainer[layer].IsNull())
+      continue;
+
+    if (m_CompressedLayerContainer[layer].IsEmpty())
+    {
+      ImageReadAccessor accessor(m_LayerContainer[layer]);
+      m_CompressedLayerContainer[layer].Encode(static_cast<const PixelType *>(accessor.GetData()),
+                                               this->GetNumberOfLayerPixels());
+    }
+
+    m_LayerContainer[layer] = nullptr;
+  }
+}
+
+bool mitk::LabelSetImage::IsLayerCompressed(unsigned int layer) const
+{
+  return layer < m_CompressedLayerContainer.size() && !m_CompressedLayerContainer[layer].IsEmpty();
+}
+
+std::size_t mitk::LabelSetImage::GetLayerMemorySize(unsigned int layer) const
+{
+  if (layer >= m_LayerContainer.size())
+    return 0;
+
+  std::size_t memorySize = m_CompressedLayerContainer[layer].GetMemorySize();
+
+  if (m_LayerContainer[layer].IsNotNull())
+    memorySize += this->GetNumberOfLayerPixels() * sizeof(PixelType);
+
+  return memorySize;
+}
+
+mitk::LabelSetImage::LabelRegionType mitk::LabelSetImage::GetLabelRegion(PixelType pixelValue) const
+{
+  LabelRegionType region;
+  for (unsigned int i = 0; i < 3; ++i)
+    region.SetSize(i, this->GetDimension(i));
+
+  if (0 == pixelValue || 3 != this->GetDimension())
+    return region;
+
+  // the regions may be requested from other threads, e.g. by the surface filter of a job
+  std::lock_guard<std::mutex> lock(m_LabelRegionsMutex);
+
+  if (0 == m_LabelRegionsMTime || m_LabelRegionsMTime < this->GetMTime())
+    this->ComputeLabelRegions();
+
+  auto finding = m_LabelRegions.find(pixelValue);
+  return finding != m_LabelRegions.end() ? finding->second : LabelRegionType();
+}
+
+void mitk::LabelSetImage::UpdateLabelRegions(const LabelRegionType &modifiedRegion)
+{
+  bool labelRegionsValid = false;
+
+  {
+    std::lock_guard<std::mutex> lock(m_LabelRegionsMutex);
+    labelRegionsValid = 3 == this->GetDimension() && 0 != m_LabelRegionsMTime && m_LabelRegionsMTime >= this->GetMTime();
+
+    LabelRegionType region = modifiedRegion;
+    if (labelRegionsValid && region.Crop(this->GetLabelRegion(0)))
+      this->ExpandLabelRegions(region);
+  }
+
+  this->ModifiedWithKnownRegion(labelRegionsValid, modifiedRegion);
+}
+
+bool mitk::LabelSetImage::GetModifiedRegion(unsigned long sinceMTime, LabelRegionType &region) const
+{
+  std::lock_guard<std::mutex> lock(m_ModifiedRegionsMutex);
+
+  region = LabelRegionType();
+
+  if (m_ModifiedRegionsMTime != this->GetMTime() || sinceMTime < m_ModifiedRegionsStartMTime)
+    return false;
+
+  for (const auto &modifiedRegion : m_ModifiedRegions)
+  {
+    if (modifiedRegion.first > sinceMTime)
+      region = UniteRegions(region, modifiedRegion.second);
+  }
+
+  return true;
+}
+
+bool mitk::LabelSetImage::AreLabelRegionsValid() const
+{
+  std::lock_guard<std::mutex> lock(m_LabelRegionsMutex);
+  return 3 == this->GetDimension() && 0 != m_LabelRegionsMTime && m_LabelRegionsMTime >= this->GetMTime();
+}
+
+const mitk::LabelSetImage::LabelRegionType *mitk::LabelSetImage::GetProcessingRegion(PixelType pixelValue,
+                                                                                     unsigned int layer,
+                                                                                     LabelRegionType &region) const
+{
+  // the label regions describe the buffer of the LabelSetImage, i.e. the active layer
+  if (layer != this->GetActiveLayer() || 3 != this->GetDimension())
+    return nullptr;
+
+  region = this->GetLabelRegion(pixelValue);
+  return &region;
+}
+
+void mitk::LabelSetImage::MergeLabelRegions(PixelType pixelValue, PixelType sourcePixelValue, const LabelRegionType &sourceRegion)
+{
+  std::lock_guard<std::mutex> lock(m_LabelRegionsMutex);
+
+  if (0 != pixelValue && 0 != sourceRegion.GetNumberOfPixels())
+  {
+    auto &targetRegion = m_LabelRegions[pixelValue];
+    targetRegion = ::UniteRegions(targetRegion, sourceRegion);
+  }
+
+  m_LabelRegions.erase(sourcePixelValue);
+}
+
+void mitk::LabelSetImage::ComputeLabelRegions() const
+{
+  m_LabelRegions.clear();
+  this->ExpandLabelRegions(this->GetLabelRegion(0));
+  m_LabelRegionsMTime = this->GetMTime();
+}
+
+void mitk::LabelSetImage::ExpandLabelRegions(const LabelRegionType &region) const
+{
+  if (0 == region.GetNumberOfPixels())
+    return;
+
+  ImagePixelReadAccessor<PixelType, 3> accessor(this);
+  const PixelType *data = accessor.GetData();
+
+  const std::size_t dimX = this->GetDimension(0);
+  const std::size_t dimY = this->GetDimension(1);
+  const auto &start = region.GetIndex();
+  const auto upper = region.GetUpperIndex();
+
+  // Rows are processed as runs of equal values, thus each run costs at most one lookup of its label region
+  auto labelRegion = m_LabelRegions.end();
+  PixelType labelRegionValue = 0;
+
+  LabelRegionType runRegion;
+  runRegion.SetSize(1, 1);
+  runRegion.SetSize(2, 1);
+
+  for (auto z = start[2]; z <= upper[2]; ++z)
+  {
+    for (auto y = start[1]; y <= upper[1]; ++y)
+    {
+      const PixelType *row = data + (static_cast<std::size_t>(z) * dimY + y) * dimX;
+      const PixelType *rowEnd = row + upper[0] + 1;
+      const PixelType *runBegin = row + start[0];
+
+      while (runBegin != rowEnd)
+      {
+        const PixelType value = *runBegin;
+        const PixelType *runEnd =
+          std::find_if(runBegin + 1, rowEnd, [value](PixelType pixel) { return pixel != value; });
+
+        if (0 != value)
+        {
+          if (labelRegion == m_LabelRegions.end() || labelRegionValue != value)
+          {
+            labelRegion = m_LabelRegions.insert(std::make_pair(value, LabelRegionType())).first;
+            labelRegionValue = value;
+          }
+
+          runRegion.SetIndex(0, runBegin - row);
+          runRegion.SetIndex(1, y);
+          runRegion.SetIndex(2, z);
+          runRegion.SetSize(0, static_cast<itk::SizeValueType>(runEnd - runBegin));
+          labelRegion->second = UniteRegions(labelRegion->second, runRegion);
+        }
+
+        runBegin = runEnd;
+      }
+    }
+  }
+}
+
+void mitk::LabelSetImage::ModifiedWithValidLabelRegions(bool labelRegionsValid)
+{
+  this->Modified();
+
+  if (labelRegionsValid)
+  {
+    std::lock_guard<std::mutex> lock(m_LabelRegionsMutex);
+    m_LabelRegionsMTime = this->GetMTime();
+  }
+}
+
+void mitk::LabelSetImage::ModifiedWithKnownRegion(bool labelRegionsValid, const LabelRegionType &modifiedRegion)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_ModifiedRegionsMutex);
+
+    // a modification without known region since the last known one interrupts the log
+    if (m_ModifiedRegionsMTime != this->GetMTime())
+    {
+      m_ModifiedRegions.clear();
+      m_ModifiedRegionsStartMTime = this->GetMTime();
+    }
+  }
+
+  // the observers of the modification must not be called with the mutex locked
+  this->ModifiedWithValidLabelRegions(labelRegionsValid);
+
+  std::lock_guard<std::mutex> lock(m_ModifiedRegionsMutex);
+
+  if (0 != modifiedRegion.GetNumberOfPixels())
+  {
+    m_ModifiedRegions.emplace_back(this->GetMTime(), modifiedRegion);
+
+    const std::size_t maximumNumberOfModifiedRegions = 64;
+    if (m_ModifiedRegions.size() > maximumNumberOfModifiedRegions)
+    {
+      m_ModifiedRegionsStartMTime = m_ModifiedRegions.front().first;
+      m_ModifiedRegions.pop_front();
+    }
+  }
+
+  m_ModifiedRegionsMTime = this->GetMTime();
+}
+
+mitk::Image::Pointer mitk::LabelSetImage::CreateLayerImage() const
+{
+  mitk::Image::Pointer newImage = mitk::Image::New();
+  newImage->Initialize(this->GetPixelType(),
+                       this->GetDimension(),
+                       this->GetDimensions(),
+                       this->GetImageDescriptor()->GetNumberOfChannels());
+  newImage->SetTimeGeometry(this->GetTimeGeometry()->Clone());
+  return newImage;
+}
+
+std::size_t mitk::LabelSetImage::GetNumberOfLayerPixels() const
+{
+  std::size_t numberOfPixels = 1;
+  for (unsigned int dim = 0; dim < this->GetDimension(); ++dim)
+    numberOfPixels *= this->GetDimension(dim);
+  return numberOfPixels;
+}
+
+void mitk::LabelSetImage::DecodeLayer(unsigned int layer) const
+{
+  std::lock_guard<std::mutex> lock(m_LayerContainerMutex);
+
+  if (m_LayerContainer[layer].IsNull())
+    m_LayerContainer[layer] = this->CreateDecodedLayerImage(layer);
+}
+
+mitk::Image::Pointer mitk::LabelSetImage::CreateDecodedLayerImage(unsigned int layer) const
+{
+  auto layerImage = this->CreateLayerImage();
+  {
+    ImageWriteAccessor accessor(layerImage);
+    m_CompressedLayerContainer[layer].Decode(static_cast<PixelType *>(accessor.GetData()));
+  }
+  return layerImage;
+}
+
+void mitk::LabelSetImage::WriteActiveLayerToLayerContainer()
+{
+  const auto layer = this->GetActiveLayer();
+
+  if (m_LayerCompression)
+  {
+    ImageReadAccessor accessor(this);
+    m_CompressedLayerContainer[layer].Encode(static_cast<const PixelType *>(accessor.GetData()),
+                                             this->GetNumberOfLayerPixels());
+    m_LayerContainer[layer] = nullptr;
+    return;
+  }
+
+  if (m_LayerContainer[layer].IsNull())
+    m_LayerContainer[layer] = this->CreateLayerImage();
+
+  m_CompressedLayerContainer[layer].Clear();
+
+  if (4 == this->GetDimension())
+  {
+    AccessFixedDimensionByItk_n(this, ImageToLayerContainerProcessing, 4, (layer));
+  }
+  else
+  {
+    AccessByItk_1(this, ImageToLayerContainerProcessing, layer);
+  }
+}
+
+void mitk::LabelSetImage::ReadActiveLayerFromLayerContainer()
+{
+  const auto layer = this->GetActiveLayer();
+
+  if (m_LayerContainer[layer].IsNull())
+  {
+    ImageWriteAccessor accessor(this);
+    m_CompressedLayerContainer[layer].Decode(static_cast<PixelType *>(accessor.GetData()));
+    return;
+  }
+
+  if (4 == this->GetDimension())
+  {
+    AccessFixedDimensionByItk_n(this, LayerContainerToImageProcessing, 4, (layer));
+  }
+  else
+  {
+    AccessByItk_1(this, LayerContainerToImageProcessing, layer);
+  }
+
+  if (m_LayerCompression)
+  {
+    // Keep only the compressed state of the layer, the dense pixel data is held by the image itself
+    if (m_CompressedLayerContainer[layer].IsEmpty())
+    {
+      ImageReadAccessor accessor(this);
+      m_CompressedLayerContainer[layer].Encode(static_cast<const PixelType *>(accessor.GetData()),
+                                               this->GetNumberOfLayerPixels());
+    }
+    m_LayerContainer[layer] = nullptr;
+  }
+}
+
 unsigned int mitk::LabelSetImage::GetActiveLayer() const
 {
   return m_ActiveLayer;
@@ -200,6 +621,7 @@ void mitk::LabelSetImage::RemoveLayer()
   // remove labelset and image data
   m_LabelSetContainer.erase(m_LabelSetContainer.begin() + layerToDelete);
   m_LayerContainer.erase(m_LayerContainer.begin() + layerToDelete);
+  m_CompressedLayerContainer.erase(m_CompressedLayerContainer.begin() + layerToDelete);
 
   if (layerToDelete == 0)
   {
@@ -211,12 +633,15 @@ void mitk::LabelSetImage::RemoveLayer()
 
 unsigned int mitk::LabelSetImage::AddLayer(mitk::LabelSet::Pointer lset)
 {
-  mitk::Image::Pointer newImage = mitk::Image::New();
-  newImage->Initialize(this->GetPixelType(),
-                       this->GetDimension(),
-                       this->GetDimensions(),
-                       this->GetImageDescriptor()->GetNumberOfChannels());
-  newImage->SetTimeGeometry(this->GetTimeGeometry()->Clone());
+  if (m_LayerCompression)
+  {
+    // An empty layer is a single run, the dense image is not needed at all
+    RunLengthEncodedLabelLayer compressedLayer;
+    compressedLayer.Fill(0, this->GetNumberOfLayerPixels());
+    return this->InsertLayer(nullptr, compressedLayer, lset);
+  }
+
+  mitk::Image::Pointer newImage = this->CreateLayerImage();
 
   if (newImage->GetDimension() < 4)
   {
@@ -233,6 +658,13 @@ unsigned int mitk::LabelSetImage::AddLayer(mitk::LabelSet::Pointer lset)
 }
 
 unsigned int mitk::LabelSetImage::AddLayer(mitk::Image::Pointer layerImage, mitk::LabelSet::Pointer lset)
+{
+  return this->InsertLayer(layerImage, RunLengthEncodedLabelLayer(), lset);
+}
+
+unsigned int mitk::LabelSetImage::InsertLayer(mitk::Image::Pointer layerImage,
+                                              const RunLengthEncodedLabelLayer &compressedLayer,
+                                              mitk::LabelSet::Pointer lset)
 {
   unsigned int newLabelSetId = m_LayerContainer.size();
 
@@ -255,6 +687,7 @@ unsigned int mitk::LabelSetImage::AddLayer(mitk::Image::Pointer layerImage, mitk
 
   // push a new working image for the new layer
   m_LayerContainer.push_back(layerImage);
+  m_CompressedLayerContainer.push_back(compressedLayer);
 
   // push a new labelset for the new layer
   m_LabelSetContainer.push_back(ls);
@@ -299,47 +732,23 @@ void mitk::LabelSetImage::SetActiveLayer(unsigned int layer)
 {
   try
   {
-    if (4 == this->GetDimension())
+    if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
     {
-      if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
-      {
-        BeforeChangeLayerEvent.Send();
+      BeforeChangeLayerEvent.Send();
 
-        if (m_activeLayerInvalid)
-        {
-          // We should not write the invalid layer back to the vector
-          m_activeLayerInvalid = false;
-        }
-        else
-        {
-          AccessFixedDimensionByItk_n(this, ImageToLayerContainerProcessing, 4, (GetActiveLayer()));
-        }
-        m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
-        AccessFixedDimensionByItk_n(this, LayerContainerToImageProcessing, 4, (GetActiveLayer()));
-
-        AfterChangeLayerEvent.Send();
+      if (m_activeLayerInvalid)
+      {
+        // We should not write the invalid layer back to the vector
+        m_activeLayerInvalid = false;
       }
-    }
-    else
-    {
-      if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
+      else
       {
-        BeforeChangeLayerEvent.Send();
-
-        if (m_activeLayerInvalid)
-        {
-          // We should not write the invalid layer back to the vector
-          m_activeLayerInvalid = false;
-        }
-        else
-        {
-          AccessByItk_1(this, ImageToLayerContainerProcessing, GetActiveLayer());
-        }
-        m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
-        AccessByItk_1(this, LayerContainerToImageProcessing, GetActiveLayer());
-
-        AfterChangeLayerEvent.Send();
+        this->WriteActiveLayerToLayerContainer();
       }
+      m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
+      this->ReadActiveLayerFromLayerContainer();
+
+      AfterChangeLayerEvent.Send();
     }
   }
   catch (itk::ExceptionObject &e)
@@ -418,31 +827,67 @@ void mitk::LabelSetImage::MergeLabel(PixelType pixelValue, PixelType sourcePixel
 {
   try
   {
-    AccessByItk_2(this, MergeLabelProcessing, pixelValue, sourcePixelValue);
+    if (layer != this->GetActiveLayer() && this->IsLayerCompressed(layer))
+    {
+      m_LayerContainer[layer] = nullptr;
+      m_CompressedLayerContainer[layer].ReplaceValue(sourcePixelValue, pixelValue);
+    }
+    else
+    {
+      mitk::Image *layerImage = layer == this->GetActiveLayer() ? this : this->GetLayerImage(layer);
+      LabelRegionType sourceRegion;
+      const LabelRegionType *processingRegion = this->GetProcessingRegion(sourcePixelValue, layer, sourceRegion);
+      AccessByItk_3(layerImage, MergeLabelProcessing, pixelValue, sourcePixelValue, processingRegion);
+
+      if (nullptr != processingRegion)
+        this->MergeLabelRegions(pixelValue, sourcePixelValue, sourceRegion);
+    }
   }
   catch (itk::ExceptionObject &e)
   {
     mitkThrow() << e.GetDescription();
   }
+  // the label regions have been updated by the processing or are not affected by other layers
+  const bool labelRegionsValid = this->AreLabelRegionsValid();
   GetLabelSet(layer)->SetActiveLabel(pixelValue);
-  Modified();
+  this->ModifiedWithValidLabelRegions(labelRegionsValid);
 }
 
 void mitk::LabelSetImage::MergeLabels(PixelType pixelValue, std::vector<PixelType>& vectorOfSourcePixelValues, unsigned int layer)
 {
   try
   {
-    for (unsigned int idx = 0; idx < vectorOfSourcePixelValues.size(); idx++)
+    if (layer != this->GetActiveLayer() && this->IsLayerCompressed(layer))
     {
-      AccessByItk_2(this, MergeLabelProcessing, pixelValue, vectorOfSourcePixelValues[idx]);
+      m_LayerContainer[layer] = nullptr;
+      for (unsigned int idx = 0; idx < vectorOfSourcePixelValues.size(); idx++)
+      {
+        m_CompressedLayerContainer[layer].ReplaceValue(vectorOfSourcePixelValues[idx], pixelValue);
+      }
+    }
+    else
+    {
+      mitk::Image *layerImage = layer == this->GetActiveLayer() ? this : this->GetLayerImage(layer);
+      for (unsigned int idx = 0; idx < vectorOfSourcePixelValues.size(); idx++)
+      {
+        LabelRegionType sourceRegion;
+        const LabelRegionType *processingRegion =
+          this->GetProcessingRegion(vectorOfSourcePixelValues[idx], layer, sourceRegion);
+        AccessByItk_3(layerImage, MergeLabelProcessing, pixelValue, vectorOfSourcePixelValues[idx], processingRegion);
+
+        if (nullptr != processingRegion)
+          this->MergeLabelRegions(pixelValue, vectorOfSourcePixelValues[idx], sourceRegion);
+      }
     }
   }
   catch (itk::ExceptionObject &e)
   {
     mitkThrow() << e.GetDescription();
   }
+  // the label regions have been updated by the processing or are not affected by other layers
+  const bool labelRegionsValid = this->AreLabelRegionsValid();
   GetLabelSet(layer)->SetActiveLabel(pixelValue);
-  Modified();
+  this->ModifiedWithValidLabelRegions(labelRegionsValid);
 }
 
 void mitk::LabelSetImage::RemoveLabels(std::vector<PixelType> &VectorOfLabelPixelValues, unsigned int layer)
@@ -466,20 +911,35 @@ void mitk::LabelSetImage::EraseLabel(PixelType pixelValue, unsigned int layer)
 {
   try
   {
-    if (4 == this->GetDimension())
+    if (layer != this->GetActiveLayer() && this->IsLayerCompressed(layer))
     {
-      AccessFixedDimensionByItk_2(this, EraseLabelProcessing, 4, pixelValue, layer);
+      m_LayerContainer[layer] = nullptr;
+      m_CompressedLayerContainer[layer].ReplaceValue(pixelValue, 0);
     }
     else
     {
-      AccessByItk_2(this, EraseLabelProcessing, pixelValue, layer);
+      mitk::Image *layerImage = layer == this->GetActiveLayer() ? this : this->GetLayerImage(layer);
+
+      if (4 == this->GetDimension())
+      {
+        AccessFixedDimensionByItk_2(layerImage, EraseLabelProcessing, 4, pixelValue, nullptr);
+      }
+      else
+      {
+        LabelRegionType labelRegion;
+        const LabelRegionType *processingRegion = this->GetProcessingRegion(pixelValue, layer, labelRegion);
+        AccessByItk_2(layerImage, EraseLabelProcessing, pixelValue, processingRegion);
+
+        if (nullptr != processingRegion)
+          this->MergeLabelRegions(0, pixelValue, labelRegion);
+      }
     }
   }
   catch (const itk::ExceptionObject &e)
   {
     mitkThrow() << e.GetDescription();
   }
-  Modified();
+  this->ModifiedWithValidLabelRegions(this->AreLabelRegionsValid());
 }
 
 mitk::Label *mitk::LabelSetImage::GetActiveLabel(unsigned int layer)
@@ -542,11 +1002,14 @@ void mitk::LabelSetImage::UpdateCenterOfMass(PixelType pixelValue, unsigned int
 {
   if (4 == this->GetDimension())
   {
-    AccessFixedDimensionByItk_2(this, CalculateCenterOfMassProcessing, 4, pixelValue, layer);
+    AccessFixedDimensionByItk_3(this, CalculateCenterOfMassProcessing, 4, pixelValue, layer, nullptr);
   }
   else
   {
-    AccessByItk_2(this, CalculateCenterOfMassProcessing, pixelValue, layer);
+    // the buffer of the LabelSetImage holds the pixels of the active layer
+    LabelRegionType labelRegion;
+    const LabelRegionType *processingRegion = this->GetProcessingRegion(pixelValue, this->GetActiveLayer(), labelRegion);
+    AccessByItk_3(this, CalculateCenterOfMassProcessing, pixelValue, layer, processingRegion);
   }
 }
 
@@ -583,7 +1046,23 @@ void mitk::LabelSetImage::MaskStamp(mitk::Image *mask, bool forceOverwrite)
     if (paddedMask.IsNull())
       return;
 
-    AccessByItk_2(this, MaskStampProcessing, paddedMask, forceOverwrite);
+    // buffer offsets of the first and behind the last stamped pixel
+    std::pair<std::size_t, std::size_t> modifiedOffsets(0, 0);
+    AccessByItk_3(this, MaskStampProcessing, paddedMask, forceOverwrite, &modifiedOffsets);
+
+    if (modifiedOffsets.first < modifiedOffsets.second && this->AreLabelRegionsValid())
+    {
+      // only the slices between the first and the last stamped pixel have to be scanned for the label regions
+      const std::size_t sliceSize = static_cast<std::size_t>(this->GetDimension(0)) * this->GetDimension(1);
+      LabelRegionType modifiedRegion = this->GetLabelRegion(0);
+      modifiedRegion.SetIndex(2, modifiedOffsets.first / sliceSize);
+      modifiedRegion.SetSize(2, (modifiedOffsets.second - 1) / sliceSize - modifiedOffsets.first / sliceSize + 1);
+      this->UpdateLabelRegions(modifiedRegion);
+    }
+    else
+    {
+      this->Modified();
+    }
   }
   catch (...)
   {
@@ -730,57 +1209,85 @@ void mitk::LabelSetImage::InitializeByLabeledImageProcessing(LabelSetImageType *
 }
 
 template <typename ImageType>
-void mitk::LabelSetImage::MaskStampProcessing(ImageType *itkImage, mitk::Image *mask, bool forceOverwrite)
+void mitk::LabelSetImage::MaskStampProcessing(ImageType *itkImage,
+                                              mitk::Image *mask,
+                                              bool forceOverwrite,
+                                              std::pair<std::size_t, std::size_t> *modifiedOffsets)
 {
   typename ImageType::Pointer itkMask;
   mitk::CastToItkImage(mask, itkMask);
 
-  typedef itk::ImageRegionConstIterator<ImageType> SourceIteratorType;
-  typedef itk::ImageRegionIterator<ImageType> TargetIteratorType;
+  // Both images have the same size, thus the mask is processed as runs of background and foreground pixels
+  // directly on the buffers. Runs of background pixels are skipped at once.
+  typedef typename ImageType::PixelType ImagePixelType;
 
-  SourceIteratorType sourceIter(itkMask, itkMask->GetLargestPossibleRegion());
-  sourceIter.GoToBegin();
+  const ImagePixelType *source = itkMask->GetBufferPointer();
+  const ImagePixelType *sourceEnd = source + itkMask->GetLargestPossibleRegion().GetNumberOfPixels();
+  ImagePixelType *target = itkImage->GetBufferPointer();
 
-  TargetIteratorType targetIter(itkImage, itkImage->GetLargestPossibleRegion());
-  targetIter.GoToBegin();
+  const ImagePixelType activeLabel = this->GetActiveLabel(GetActiveLayer())->GetValue();
 
-  int activeLabel = this->GetActiveLabel(GetActiveLayer())->GetValue();
+  // Lookup of the locked labels instead of a label set query for each pixel
+  std::vector<bool> locked(static_cast<std::size_t>(mitk::Label::MAX_LABEL_VALUE) + 1, false);
+  const auto *labelSet = this->GetActiveLabelSet();
+  for (auto iter = labelSet->IteratorConstBegin(); iter != labelSet->IteratorConstEnd(); ++iter)
+    locked[iter->first] = iter->second->GetLocked();
 
-  while (!sourceIter.IsAtEnd())
+  auto isBackground = [](ImagePixelType value) { return value == 0; };
+  auto isForeground = [](ImagePixelType value) { return value != 0; };
+
+  const ImagePixelType *runBegin = std::find_if(source, sourceEnd, isForeground);
+  if (runBegin != sourceEnd)
+    modifiedOffsets->first = static_cast<std::size_t>(runBegin - source);
+
+  while (runBegin != sourceEnd)
   {
-    PixelType sourceValue = sourceIter.Get();
-    PixelType targetValue = targetIter.Get();
+    const ImagePixelType *runEnd = std::find_if(runBegin, sourceEnd, isBackground);
+    ImagePixelType *targetBegin = target + (runBegin - source);
+    ImagePixelType *targetEnd = target + (runEnd - source);
 
-    if ((sourceValue != 0) &&
-        (forceOverwrite || !this->GetLabel(targetValue)->GetLocked())) // skip exterior and locked labels
+    if (forceOverwrite)
     {
-      targetIter.Set(activeLabel);
+      std::fill(targetBegin, targetEnd, activeLabel);
+    }
+    else
+    {
+      // skip exterior and locked labels
+      std::replace_if(
+        targetBegin, targetEnd, [&locked](ImagePixelType value) { return !locked[static_cast<PixelType>(value)]; }, activeLabel);
     }
-    ++sourceIter;
-    ++targetIter;
-  }
 
-  this->Modified();
+    modifiedOffsets->second = static_cast<std::size_t>(runEnd - source);
+    runBegin = std::find_if(runEnd, sourceEnd, isForeground);
+  }
 }
 
 template <typename ImageType>
-void mitk::LabelSetImage::CalculateCenterOfMassProcessing(ImageType *itkImage, PixelType pixelValue, unsigned int layer)
+void mitk::LabelSetImage::CalculateCenterOfMassProcessing(ImageType *itkImage,
+                                                          PixelType pixelValue,
+                                                          unsigned int layer,
+                                                          const LabelRegionType *labelRegion)
 {
   // for now, we just retrieve the voxel in the middle
   typedef itk::ImageRegionConstIterator<ImageType> IteratorType;
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
+  const auto region = ::GetIteratedRegion(itkImage, labelRegion);
 
   std::vector<typename ImageType::IndexType> indexVector;
 
-  while (!iter.IsAtEnd())
+  if (0 != region.GetNumberOfPixels())
   {
-    // TODO fix comparison warning more effective
-    if (iter.Get() == pixelValue)
+    IteratorType iter(itkImage, region);
+    iter.GoToBegin();
+
+    while (!iter.IsAtEnd())
     {
-      indexVector.push_back(iter.GetIndex());
+      // TODO fix comparison warning more effective
+      if (iter.Get() == pixelValue)
+      {
+        indexVector.push_back(iter.GetIndex());
+      }
+      ++iter;
     }
-    ++iter;
   }
 
   mitk::Point3D pos;
@@ -893,11 +1400,17 @@ void mitk::LabelSetImage::ImageToLayerContainerProcessing(itk::Image<TPixel, VIm
 }
 
 template <typename ImageType>
-void mitk::LabelSetImage::EraseLabelProcessing(ImageType *itkImage, PixelType pixelValue, unsigned int /*layer*/)
+void mitk::LabelSetImage::EraseLabelProcessing(ImageType *itkImage,
+                                               PixelType pixelValue,
+                                               const LabelRegionType *labelRegion)
 {
   typedef itk::ImageRegionIterator<ImageType> IteratorType;
 
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
+  const auto region = ::GetIteratedRegion(itkImage, labelRegion);
+  if (0 == region.GetNumberOfPixels())
+    return;
+
+  IteratorType iter(itkImage, region);
   iter.GoToBegin();
 
   while (!iter.IsAtEnd())
@@ -913,11 +1426,18 @@ void mitk::LabelSetImage::EraseLabelProcessing(ImageType *itkImage, PixelType pi
 }
 
 template <typename ImageType>
-void mitk::LabelSetImage::MergeLabelProcessing(ImageType *itkImage, PixelType pixelValue, PixelType index)
+void mitk::LabelSetImage::MergeLabelProcessing(ImageType *itkImage,
+                                               PixelType pixelValue,
+                                               PixelType index,
+                                               const LabelRegionType *labelRegion)
 {
   typedef itk::ImageRegionIterator<ImageType> IteratorType;
 
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
+  const auto region = ::GetIteratedRegion(itkImage, labelRegion);
+  if (0 == region.GetNumberOfPixels())
+    return;
+
+  IteratorType iter(itkImage, region);
   iter.GoToBegin();
 
   while (!iter.IsAtEnd())
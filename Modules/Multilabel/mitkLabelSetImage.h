@@ -15,9 +15,16 @@ found in the LICENSE file.
 
 #include <mitkImage.h>
 #include <mitkLabelSet.h>
+#include <mitkRunLengthEncodedLabelLayer.h>
 
 #include <MitkMultilabelExports.h>
 
+#include <itkImageRegion.h>
+
+#include <deque>
+#include <map>
+#include <mutex>
+
 namespace mitk
 {
   //##Documentation
@@ -34,6 +41,9 @@ namespace mitk
 
       typedef mitk::Label::PixelType PixelType;
 
+    /** Index region of the pixels of one time step */
+    typedef itk::ImageRegion<3> LabelRegionType;
+
     /**
     * \brief BeforeChangeLayerEvent (e.g. used for GUI integration)
     * As soon as active labelset should be changed, the signal emits.
@@ -67,6 +77,9 @@ namespace mitk
     /**
      * @brief Merges the mitk::Label with a given target value with the active label
      *
+     * If the layer is not the active one and its pixel data is compressed, the label values are merged directly
+     * in the compressed data.
+     *
      * @param pixelValue          the value of the label that should be the new merged label
      * @param sourcePixelValue    the value of the label that should be merged into the specified one
      * @param layer               the layer in which the merge should be performed
@@ -98,6 +111,8 @@ namespace mitk
      * @brief Erases the label with the given value in the given layer from the underlying image.
      *        The label itself will not be erased from the respective mitk::LabelSet. In order to
      *        remove the label itself use mitk::LabelSetImage::RemoveLabels()
+     *        If the layer is not the active one and its pixel data is compressed, the label is directly erased
+     *        in the compressed data.
      * @param pixelValue the label which will be remove from the image
      * @param layer the layer in which the label should be removed
      */
@@ -244,11 +259,90 @@ namespace mitk
     void RemoveLayer();
 
     /**
-      * \brief  */
+     * @brief Returns the pixel data of a layer as dense image.
+     *
+     * A compressed layer is decoded on access. Since the returned image may be modified, the layer stays
+     * uncompressed until it is compressed again, see CompressLayers(). The pixel data of the active layer is
+     * the buffer of the LabelSetImage itself, the returned image contains the state of its last activation.
+     */
     mitk::Image *GetLayerImage(unsigned int layer);
 
+    /**
+     * @brief Returns the pixel data of a layer as dense image.
+     *
+     * A compressed layer is decoded on access. The decoded image is cached and released as soon as the layer
+     * is modified or CompressLayers() is called, the compressed data is kept.
+     */
     const mitk::Image *GetLayerImage(unsigned int layer) const;
 
+    /**
+     * @brief Returns the pixel data of a layer as dense image without caching the decoded data.
+     *
+     * A compressed layer is decoded into a new image that is released with its last reference, e.g. after it has
+     * been resliced for rendering. Uncompressed layers and layers that are decoded already are returned directly.
+     */
+    mitk::Image::ConstPointer DecodeLayerImage(unsigned int layer) const;
+
+    /**
+     * @brief Enables the run-length encoded storage of the pixel data of the layers.
+     *
+     * If enabled, the pixel data of a layer is compressed as soon as another layer gets active and new layers
+     * are created compressed. Only the active layer is kept as dense buffer, i.e. as the LabelSetImage itself.
+     * Enabling compresses all layers, disabling decodes all layers. Default is off.
+     */
+    void SetLayerCompression(bool compression);
+
+    bool GetLayerCompression() const;
+
+    /**
+     * @brief Compresses the pixel data of all layers that are currently stored as dense images,
+     *        e.g. after they have been accessed by GetLayerImage().
+     */
+    void CompressLayers();
+
+    /**
+     * @brief Returns true if the pixel data of the layer is stored run-length encoded.
+     */
+    bool IsLayerCompressed(unsigned int layer) const;
+
+    /**
+     * @brief Returns the number of bytes occupied by the stored pixel data of a layer, i.e. the compressed data
+     *        and the dense image if one exists. The buffer of the LabelSetImage holding the active layer is not
+     *        included.
+     */
+    std::size_t GetLayerMemorySize(unsigned int layer) const;
+
+    /**
+     * @brief Returns the bounding region of the pixels of a label in the active layer.
+     *
+     * The bounding regions of all labels are determined in a single pass over the image when they are requested
+     * after the pixel data has been modified. Operations of the LabelSetImage and writes announced by
+     * UpdateLabelRegions() update them incrementally instead. The returned region may be larger than the label
+     * but always contains all of its pixels; it is empty if the label has no pixels. For the exterior label and
+     * for images with more than one time step the region of the whole time step is returned.
+     */
+    LabelRegionType GetLabelRegion(PixelType pixelValue) const;
+
+    /**
+     * @brief Announces that pixels of the active layer within the given region have been written directly,
+     *        e.g. by writing a slice into the image.
+     *
+     * Call it after the pixels have been written instead of Modified(), which is called by this method. The
+     * bounding regions of the labels are then updated by scanning the given region only, otherwise they have to be
+     * determined again from the whole image on their next request.
+     */
+    void UpdateLabelRegions(const LabelRegionType &modifiedRegion);
+
+    /**
+     * @brief Returns the region of the active layer whose pixels may have been modified after the given
+     *        modification time, e.g. to update a result derived from the image incrementally.
+     *
+     * Only writes announced by UpdateLabelRegions() are tracked, for a limited number of modifications. Returns false
+     * if the pixels may have been modified in another way since then, i.e. the whole image has to be considered as
+     * modified. Otherwise region holds the modified region, which is empty if no pixel has been modified.
+     */
+    bool GetModifiedRegion(unsigned long sinceMTime, LabelRegionType &region) const;
+
     void OnLabelSetModified();
 
     /**
@@ -282,37 +376,113 @@ namespace mitk
     void ImageToLayerContainerProcessing(itk::Image<TPixel, VImageDimension> *source, unsigned int layer) const;
 
     template <typename ImageType>
-    void CalculateCenterOfMassProcessing(ImageType *input, PixelType index, unsigned int layer);
+    void CalculateCenterOfMassProcessing(ImageType *input,
+                                         PixelType index,
+                                         unsigned int layer,
+                                         const LabelRegionType *labelRegion);
 
     template <typename ImageType>
     void ClearBufferProcessing(ImageType *input);
 
     template <typename ImageType>
-    void EraseLabelProcessing(ImageType *input, PixelType index, unsigned int layer);
+    void EraseLabelProcessing(ImageType *input, PixelType index, const LabelRegionType *labelRegion);
 
     //  template < typename ImageType >
     //  void ReorderLabelProcessing( ImageType* input, int index, int layer);
 
     template <typename ImageType>
-    void MergeLabelProcessing(ImageType *input, PixelType pixelValue, PixelType index);
+    void MergeLabelProcessing(ImageType *input,
+                              PixelType pixelValue,
+                              PixelType index,
+                              const LabelRegionType *labelRegion);
 
     template <typename ImageType>
     void ConcatenateProcessing(ImageType *input, mitk::LabelSetImage *other);
 
     template <typename ImageType>
-    void MaskStampProcessing(ImageType *input, mitk::Image *mask, bool forceOverwrite);
+    void MaskStampProcessing(ImageType *input,
+                             mitk::Image *mask,
+                             bool forceOverwrite,
+                             std::pair<std::size_t, std::size_t> *modifiedOffsets);
 
     template <typename LabelSetImageType, typename ImageType>
     void InitializeByLabeledImageProcessing(LabelSetImageType *input, ImageType *other);
 
+    unsigned int InsertLayer(mitk::Image::Pointer layerImage,
+                             const RunLengthEncodedLabelLayer &compressedLayer,
+                             mitk::LabelSet::Pointer lset);
+
+    /** Creates an uninitialized dense image for the pixel data of a layer */
+    mitk::Image::Pointer CreateLayerImage() const;
+
+    /** Number of pixels of a layer including all time steps */
+    std::size_t GetNumberOfLayerPixels() const;
+
+    /** Makes sure that the dense image of the layer exists, decoding the compressed data if needed */
+    void DecodeLayer(unsigned int layer) const;
+
+    /** Creates a dense image from the compressed data of the layer */
+    mitk::Image::Pointer CreateDecodedLayerImage(unsigned int layer) const;
+
+    void WriteActiveLayerToLayerContainer();
+    void ReadActiveLayerFromLayerContainer();
+
+    /** The label regions are only maintained for images with a single time step */
+    bool AreLabelRegionsValid() const;
+
+    /** Returns the label region the processing of the active layer can be restricted to, or nullptr if the whole
+     *  image has to be processed */
+    const LabelRegionType *GetProcessingRegion(PixelType pixelValue, unsigned int layer, LabelRegionType &region) const;
+
+    /** Moves the bounding region of the source label to the label pixelValue after the pixels have been moved.
+     *  A pixelValue of 0 just removes the region of the source label. */
+    void MergeLabelRegions(PixelType pixelValue, PixelType sourcePixelValue, const LabelRegionType &sourceRegion);
+
+    /** Determines the bounding regions of all labels in the active layer, m_LabelRegionsMutex must be locked */
+    void ComputeLabelRegions() const;
+
+    /** Enlarges the bounding regions by the labels found within the region, which must be inside the image.
+     *  m_LabelRegionsMutex must be locked */
+    void ExpandLabelRegions(const LabelRegionType &region) const;
+
+    /** Marks the pixel data as modified, keeping the label regions valid if they have been valid before */
+    void ModifiedWithValidLabelRegions(bool labelRegionsValid);
+
+    /** Like ModifiedWithValidLabelRegions(), but the modified pixels are known to lie within modifiedRegion, which
+     *  is remembered for GetModifiedRegion() */
+    void ModifiedWithKnownRegion(bool labelRegionsValid, const LabelRegionType &modifiedRegion);
+
     std::vector<LabelSet::Pointer> m_LabelSetContainer;
-    std::vector<Image::Pointer> m_LayerContainer;
+
+    // Pixel data of the layers. A layer is stored as dense image, as run-length encoded data or both, in which case
+    // the dense image is a decoded copy of the compressed data.
+    mutable std::vector<Image::Pointer> m_LayerContainer;
+    std::vector<RunLengthEncodedLabelLayer> m_CompressedLayerContainer;
+
+    // Serializes the decoding of layers by the const accessors, e.g. from several render windows
+    mutable std::mutex m_LayerContainerMutex;
+
+    bool m_LayerCompression;
 
     int m_ActiveLayer;
 
     bool m_activeLayerInvalid;
 
     mitk::Label::Pointer m_ExteriorLabel;
+
+    // Bounding regions of the labels in the active layer, valid as long as the image is not modified after
+    // m_LabelRegionsMTime. Labels without pixels have no entry. Both are guarded by m_LabelRegionsMutex, because
+    // GetLabelRegion() is also called from worker threads, e.g. by LabelSetImageToSurfaceThreadedFilter.
+    mutable std::map<PixelType, LabelRegionType> m_LabelRegions;
+    mutable unsigned long m_LabelRegionsMTime;
+    mutable std::mutex m_LabelRegionsMutex;
+
+    // Regions modified at the given modification times. All modifications between m_ModifiedRegionsStartMTime and
+    // m_ModifiedRegionsMTime are known, later ones are not.
+    std::deque<std::pair<unsigned long, LabelRegionType>> m_ModifiedRegions;
+    unsigned long m_ModifiedRegionsStartMTime;
+    unsigned long m_ModifiedRegionsMTime;
+    mutable std::mutex m_ModifiedRegionsMutex;
   };
 
   /**
@@ -14,28 +14,89 @@ found in the LICENSE file.
 
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
+#include <mitkParallelFor.h>
 
 // itk
 #include <itkAntiAliasBinaryImageFilter.h>
 #include <itkAutoCropLabelMapFilter.h>
 #include <itkBinaryThresholdImageFilter.h>
+#include <itkExtractImageFilter.h>
+#include <itkImageRegionConstIterator.h>
 #include <itkLabelImageToLabelMapFilter.h>
 #include <itkLabelMap.h>
 #include <itkLabelMapToLabelImageFilter.h>
 #include <itkLabelObject.h>
+#include <itkMultiThreader.h>
 #include <itkNumericTraits.h>
 #include <itkSmoothingRecursiveGaussianImageFilter.h>
 
 // vtk
 #include <vtkCleanPolyData.h>
+#include <vtkFloatArray.h>
 #include <vtkImageChangeInformation.h>
 #include <vtkImageData.h>
 #include <vtkLinearTransform.h>
+#include <vtkCellArray.h>
 #include <vtkMarchingCubes.h>
+#include <vtkPointData.h>
+#include <vtkPolyDataNormals.h>
 #include <vtkSmartPointer.h>
+#include <vtkWindowedSincPolyDataFilter.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <set>
+#include <unordered_map>
+
+namespace
+{
+  /** Triangles of the voxel faces of one label within one slab. The points are identified by the index of their
+    voxel corner, thus the meshes of neighboring slabs are joined without searching for common points. */
+  struct LabelMesh
+  {
+    LabelMesh() : NumberOfVoxels(0) {}
+
+    std::unordered_map<std::uint64_t, vtkIdType> PointIds;
+    std::vector<std::uint64_t> Corners;
+    std::vector<vtkIdType> Triangles;
+    unsigned long NumberOfVoxels;
+
+    void AddQuad(const std::uint64_t (&corners)[4], bool reverse)
+    {
+      vtkIdType ids[4];
+      for (unsigned int i = 0; i < 4; ++i)
+      {
+        const auto inserted = PointIds.insert(std::make_pair(corners[i], static_cast<vtkIdType>(Corners.size())));
+        if (inserted.second)
+          Corners.push_back(corners[i]);
+        ids[reverse ? 3 - i : i] = inserted.first->second;
+      }
+
+      Triangles.insert(Triangles.end(), {ids[0], ids[1], ids[2], ids[0], ids[2], ids[3]});
+    }
+  };
+
+  std::size_t ComputeOffset(const itk::ImageRegion<3> &region, const itk::Index<3> &index)
+  {
+    return (static_cast<std::size_t>(index[2] - region.GetIndex(2)) * region.GetSize(1) +
+            static_cast<std::size_t>(index[1] - region.GetIndex(1))) *
+             region.GetSize(0) +
+           static_cast<std::size_t>(index[0] - region.GetIndex(0));
+  }
+}
 
 mitk::LabelSetImageToSurfaceFilter::LabelSetImageToSurfaceFilter()
-  : m_GenerateAllLabels(false), m_RequestedLabel(1), m_BackgroundLabel(0), m_UseSmoothing(0), m_Sigma(0.1)
+  : m_GenerateAllLabels(false),
+    m_RequestedLabel(1),
+    m_BackgroundLabel(0),
+    m_UseSmoothing(0),
+    m_Sigma(0.1),
+    m_IncrementalUpdate(false),
+    m_BlockSize(32),
+    m_NumberOfUpdatedBlocks(0),
+    m_BlockCacheKey(nullptr, 0, 0, 0, 0.f, 0),
+    m_BlockCacheMTime(0)
 {
 }
 
@@ -69,6 +130,13 @@ void mitk::LabelSetImageToSurfaceFilter::GenerateOutputInformation()
   itkDebugMacro(<< "GenerateOutputInformation()");
 }
 
+void mitk::LabelSetImageToSurfaceFilter::ClearBlockCache()
+{
+  m_Blocks.clear();
+  m_BlockCacheKey = BlockCacheKeyType(nullptr, 0, 0, 0, 0.f, 0);
+  m_BlockCacheMTime = 0;
+}
+
 void mitk::LabelSetImageToSurfaceFilter::GenerateData()
 {
   Image::ConstPointer inputImage = this->GetInput();
@@ -79,15 +147,672 @@ void mitk::LabelSetImageToSurfaceFilter::GenerateData()
   if (!outputSurface)
     return;
 
-  AccessFixedDimensionByItk_1(inputImage, InternalProcessing, 3, outputSurface);
+  if (m_GenerateAllLabels)
+  {
+    AccessFixedDimensionByItk(inputImage, AllLabelsProcessing, 3);
+    return;
+  }
+
+  // Only the bounding region of the label, enlarged by the crop border, has to be processed. The label regions are
+  // maintained for the active layer, which is the pixel data of the LabelSetImage.
+  itk::ImageRegion<3> labelRegion;
+  for (unsigned int i = 0; i < 3; ++i)
+    labelRegion.SetSize(i, inputImage->GetDimension(i));
+
+  const auto *labelSetImage = dynamic_cast<const LabelSetImage *>(inputImage.GetPointer());
+  if (nullptr != labelSetImage && m_RequestedLabel > 0 && m_RequestedLabel <= Label::MAX_LABEL_VALUE)
+  {
+    auto region = labelSetImage->GetLabelRegion(static_cast<Label::PixelType>(m_RequestedLabel));
+    if (0 != region.GetNumberOfPixels())
+    {
+      region.PadByRadius(3);
+      region.Crop(labelRegion);
+      labelRegion = region;
+    }
+  }
+
+  if (m_IncrementalUpdate)
+  {
+    const BlockCacheKeyType key(
+      inputImage, inputImage->GetGeometry()->GetMTime(), m_RequestedLabel, m_UseSmoothing, m_Sigma, m_BlockSize);
+    if (key != m_BlockCacheKey)
+    {
+      this->ClearBlockCache();
+      m_BlockCacheKey = key;
+    }
+
+    m_InputImageSpacing = inputImage->GetGeometry()->GetSpacing();
+    for (unsigned int i = 0; i < 3; ++i)
+      m_ImageRegion.SetSize(i, inputImage->GetDimension(i));
+
+    // Modifications while the blocks are processed are detected by the next update, thus the modification time is
+    // taken before.
+    const unsigned long mTime = inputImage->GetMTime();
+
+    LabelSetImage::LabelRegionType modifiedRegion;
+    const bool modifiedRegionKnown = !m_Blocks.empty() && nullptr != labelSetImage &&
+                                     labelSetImage->GetModifiedRegion(m_BlockCacheMTime, modifiedRegion);
+
+    AccessFixedDimensionByItk_2(
+      inputImage, IncrementalProcessing, 3, labelRegion, modifiedRegionKnown ? &modifiedRegion : nullptr);
+
+    m_BlockCacheMTime = mTime;
+    return;
+  }
+
+  AccessFixedDimensionByItk_2(inputImage, InternalProcessing, 3, outputSurface, labelRegion);
+}
+
+mitk::LabelSetImageToSurfaceFilter::LabelType mitk::LabelSetImageToSurfaceFilter::GetLabelForNthOutput(
+  unsigned int index) const
+{
+  const auto it = m_IndexToLabels.find(index);
+  return it != m_IndexToLabels.end() ? it->second : static_cast<LabelType>(m_BackgroundLabel);
+}
+
+unsigned long mitk::LabelSetImageToSurfaceFilter::GetNumberOfVoxelsOfLabel(LabelType label) const
+{
+  const auto it = m_AvailableLabels.find(label);
+  return it != m_AvailableLabels.end() ? it->second : 0;
+}
+
+template <typename TPixel, unsigned int VDimension>
+void mitk::LabelSetImageToSurfaceFilter::AllLabelsProcessing(const itk::Image<TPixel, VDimension> *input)
+{
+  typedef std::map<TPixel, LabelMesh> SlabMeshesType;
+
+  const auto &size = input->GetLargestPossibleRegion().GetSize();
+  const long sizeX = static_cast<long>(size[0]);
+  const long sizeY = static_cast<long>(size[1]);
+  const long sizeZ = static_cast<long>(size[2]);
+  const TPixel *buffer = input->GetBufferPointer();
+  const auto background = static_cast<TPixel>(m_BackgroundLabel);
+
+  // voxels outside of the image are background, thus the surfaces are closed at the image border
+  auto getLabel = [&](long x, long y, long z) {
+    if (x < 0 || y < 0 || z < 0 || x >= sizeX || y >= sizeY || z >= sizeZ)
+      return background;
+    return buffer[(z * sizeY + y) * sizeX + x];
+  };
+
+  auto getCorner = [&](long x, long y, long z) {
+    return (static_cast<std::uint64_t>(z) * (sizeY + 1) + static_cast<std::uint64_t>(y)) * (sizeX + 1) +
+           static_cast<std::uint64_t>(x);
+  };
+
+  // several slabs per thread balance the load if the labels are not distributed evenly
+  const long numberOfSlabs =
+    std::max(1l, std::min<long>(sizeZ, 4 * static_cast<long>(itk::MultiThreader::GetGlobalDefaultNumberOfThreads())));
+  std::vector<SlabMeshesType> slabMeshes(numberOfSlabs);
+
+  mitk::ParallelFor(0, numberOfSlabs, [&](std::size_t slab) {
+    SlabMeshesType &meshes = slabMeshes[slab];
+    const long firstZ = sizeZ * static_cast<long>(slab) / numberOfSlabs;
+    const long endZ = sizeZ * static_cast<long>(slab + 1) / numberOfSlabs;
+
+    TPixel cachedLabel = background;
+    LabelMesh *cachedMesh = nullptr;
+    auto getMesh = [&](TPixel label) {
+      if (nullptr == cachedMesh || label != cachedLabel)
+      {
+        cachedMesh = &meshes[label];
+        cachedLabel = label;
+      }
+      return cachedMesh;
+    };
+
+    // Adds the face between the voxel and its upper neighbor along the axis. The triangles of the label of the
+    // voxel face towards the neighbor, those of the label of the neighbor towards the voxel.
+    auto addFace = [&](long x, long y, long z, unsigned int axis) {
+      const TPixel label = getLabel(x, y, z);
+      const TPixel neighborLabel = getLabel(x + (0 == axis), y + (1 == axis), z + (2 == axis));
+      if (label == neighborLabel)
+        return;
+
+      std::uint64_t corners[4];
+      if (0 == axis)
+      {
+        corners[0] = getCorner(x + 1, y, z);
+        corners[1] = getCorner(x + 1, y + 1, z);
+        corners[2] = getCorner(x + 1, y + 1, z + 1);
+        corners[3] = getCorner(x + 1, y, z + 1);
+      }
+      else if (1 == axis)
+      {
+        corners[0] = getCorner(x, y + 1, z);
+        corners[1] = getCorner(x, y + 1, z + 1);
+        corners[2] = getCorner(x + 1, y + 1, z + 1);
+        corners[3] = getCorner(x + 1, y + 1, z);
+      }
+      else
+      {
+        corners[0] = getCorner(x, y, z + 1);
+        corners[1] = getCorner(x + 1, y, z + 1);
+        corners[2] = getCorner(x + 1, y + 1, z + 1);
+        corners[3] = getCorner(x, y + 1, z + 1);
+      }
+
+      if (label != background)
+        getMesh(label)->AddQuad(corners, false);
+      if (neighborLabel != background)
+        getMesh(neighborLabel)->AddQuad(corners, true);
+    };
+
+    for (long z = firstZ; z < endZ; ++z)
+    {
+      for (long y = 0; y < sizeY; ++y)
+      {
+        for (long x = 0; x < sizeX; ++x)
+        {
+          const TPixel label = buffer[(z * sizeY + y) * sizeX + x];
+          if (label != background)
+            ++getMesh(label)->NumberOfVoxels;
+
+          // every face is added by exactly one voxel, the faces at the lower image border by the first voxels
+          if (0 == x)
+            addFace(-1, y, z, 0);
+          if (0 == y)
+            addFace(x, -1, z, 1);
+          if (0 == z)
+            addFace(x, y, -1, 2);
+
+          addFace(x, y, z, 0);
+          addFace(x, y, z, 1);
+          addFace(x, y, z, 2);
+        }
+      }
+    }
+  });
+
+  m_AvailableLabels.clear();
+  m_IndexToLabels.clear();
+
+  std::vector<TPixel> labels;
+  for (const auto &meshes : slabMeshes)
+  {
+    for (const auto &mesh : meshes)
+    {
+      m_AvailableLabels[static_cast<LabelType>(mesh.first)] += mesh.second.NumberOfVoxels;
+      labels.push_back(mesh.first);
+    }
+  }
+
+  std::sort(labels.begin(), labels.end());
+  labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+
+  // the corner (i, j, k) is located at the index position (i - 0.5, j - 0.5, k - 0.5)
+  const auto *transform = this->GetInput()->GetGeometry()->GetIndexToWorldTransform();
+  const auto matrix = transform->GetMatrix();
+  const auto offset = transform->GetOffset();
+
+  std::vector<vtkSmartPointer<vtkPolyData>> surfaces(labels.size());
+
+  mitk::ParallelFor(0, labels.size(), [&](std::size_t labelIndex) {
+    const TPixel label = labels[labelIndex];
+
+    std::unordered_map<std::uint64_t, vtkIdType> pointIds;
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    vtkSmartPointer<vtkCellArray> triangles = vtkSmartPointer<vtkCellArray>::New();
+    std::vector<vtkIdType> slabPointIds;
+
+    for (const auto &meshes : slabMeshes)
+    {
+      const auto meshIter = meshes.find(label);
+      if (meshIter == meshes.end())
+        continue;
+
+      const LabelMesh &mesh = meshIter->second;
+
+      // points at the border of two slabs are part of both meshes
+      slabPointIds.resize(mesh.Corners.size());
+      for (std::size_t i = 0; i < mesh.Corners.size(); ++i)
+      {
+        const std::uint64_t corner = mesh.Corners[i];
+        const auto inserted = pointIds.insert(std::make_pair(corner, points->GetNumberOfPoints()));
+        if (inserted.second)
+        {
+          mitk::Point3D indexPoint;
+          indexPoint[0] = static_cast<double>(corner % (sizeX + 1)) - 0.5;
+          indexPoint[1] = static_cast<double>(corner / (sizeX + 1) % (sizeY + 1)) - 0.5;
+          indexPoint[2] = static_cast<double>(corner / (sizeX + 1) / (sizeY + 1)) - 0.5;
+          const mitk::Point3D worldPoint = matrix * indexPoint + offset;
+          points->InsertNextPoint(worldPoint[0], worldPoint[1], worldPoint[2]);
+        }
+        slabPointIds[i] = inserted.first->second;
+      }
+
+      for (std::size_t i = 0; i < mesh.Triangles.size(); i += 3)
+      {
+        const vtkIdType triangle[3] = {
+          slabPointIds[mesh.Triangles[i]], slabPointIds[mesh.Triangles[i + 1]], slabPointIds[mesh.Triangles[i + 2]]};
+        triangles->InsertNextCell(3, triangle);
+      }
+    }
+
+    vtkSmartPointer<vtkPolyData> surface = vtkSmartPointer<vtkPolyData>::New();
+    surface->SetPoints(points);
+    surface->SetPolys(triangles);
+
+    if (m_UseSmoothing)
+    {
+      vtkSmartPointer<vtkWindowedSincPolyDataFilter> smoothFilter = vtkSmartPointer<vtkWindowedSincPolyDataFilter>::New();
+      smoothFilter->SetInputData(surface);
+      smoothFilter->SetNumberOfIterations(15);
+      smoothFilter->SetPassBand(0.1);
+      smoothFilter->BoundarySmoothingOff();
+      smoothFilter->FeatureEdgeSmoothingOff();
+      smoothFilter->NonManifoldSmoothingOn();
+      smoothFilter->NormalizeCoordinatesOn();
+      smoothFilter->Update();
+      surface = smoothFilter->GetOutput();
+    }
+
+    vtkSmartPointer<vtkPolyDataNormals> normalsFilter = vtkSmartPointer<vtkPolyDataNormals>::New();
+    normalsFilter->SetInputData(surface);
+    normalsFilter->SplittingOff();
+    normalsFilter->ConsistencyOff();
+    normalsFilter->AutoOrientNormalsOff();
+    normalsFilter->Update();
+
+    surfaces[labelIndex] = vtkSmartPointer<vtkPolyData>::New();
+    surfaces[labelIndex]->ShallowCopy(normalsFilter->GetOutput());
+  });
+
+  const auto numberOfOutputs = static_cast<unsigned int>(std::max<std::size_t>(1, labels.size()));
+  this->SetNumberOfIndexedOutputs(numberOfOutputs);
+  for (unsigned int i = 0; i < numberOfOutputs; ++i)
+  {
+    if (!this->GetOutput(i))
+    {
+      mitk::Surface::Pointer output = static_cast<mitk::Surface *>(this->MakeOutput(i).GetPointer());
+      this->SetNthOutput(i, output.GetPointer());
+    }
+  }
+
+  if (labels.empty())
+  {
+    this->GetOutput(0)->SetVtkPolyData(vtkSmartPointer<vtkPolyData>::New(), 0);
+    return;
+  }
+
+  for (unsigned int i = 0; i < labels.size(); ++i)
+  {
+    this->GetOutput(i)->SetVtkPolyData(surfaces[i], 0);
+    m_IndexToLabels[i] = static_cast<LabelType>(labels[i]);
+  }
+}
+
+itk::ImageRegion<3> mitk::LabelSetImageToSurfaceFilter::GetBlockRegion(const BlockIndexType &blockIndex) const
+{
+  itk::ImageRegion<3> region;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    region.SetIndex(i, blockIndex[i] * m_BlockSize);
+    region.SetSize(i, m_BlockSize);
+  }
+
+  if (!region.Crop(m_ImageRegion))
+    return itk::ImageRegion<3>();
+
+  return region;
+}
+
+unsigned int mitk::LabelSetImageToSurfaceFilter::GetBlockMargin() const
+{
+  // the anti-aliasing changes three layers around the label border, one more layer of points of the neighbor
+  // blocks is part of the cells of a block
+  unsigned int margin = 4;
+
+  if (m_UseSmoothing)
+  {
+    const double minimumSpacing = std::min({m_InputImageSpacing[0], m_InputImageSpacing[1], m_InputImageSpacing[2]});
+    margin += static_cast<unsigned int>(std::ceil(3. * m_Sigma / minimumSpacing));
+  }
+
+  return margin;
+}
+
+void mitk::LabelSetImageToSurfaceFilter::UpdateBlockSurface(const BlockIndexType &blockIndex)
+{
+  SurfaceBlock &block = m_Blocks[blockIndex];
+  const itk::ImageRegion<3> &region = block.Region;
+
+  int extent[6];
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    extent[2 * i] = static_cast<int>(region.GetIndex(i));
+    extent[2 * i + 1] = static_cast<int>(region.GetUpperIndex()[i]);
+  }
+
+  vtkSmartPointer<vtkImageData> imageData = vtkSmartPointer<vtkImageData>::New();
+  imageData->SetExtent(extent);
+  imageData->AllocateScalars(VTK_FLOAT, 1);
+
+  auto *values = static_cast<float *>(imageData->GetScalarPointer());
+  std::copy(block.Values.begin(), block.Values.end(), values);
+
+  // The points that belong to the upper neighbors are taken from their values. Thus the surfaces of neighboring
+  // blocks share the same points at the common border and are stitched without gaps.
+  for (unsigned int neighbor = 1; neighbor < 8; ++neighbor)
+  {
+    BlockIndexType neighborIndex = blockIndex;
+    for (unsigned int i = 0; i < 3; ++i)
+      neighborIndex[i] += (neighbor >> i) & 1;
+
+    const auto neighborIter = m_Blocks.find(neighborIndex);
+    if (neighborIter == m_Blocks.end())
+      continue;
+
+    itk::ImageRegion<3> commonRegion = this->GetBlockRegion(neighborIndex);
+    if (!commonRegion.Crop(region))
+      continue;
+
+    const SurfaceBlock &neighborBlock = neighborIter->second;
+    const auto &neighborRegion = neighborBlock.Region;
+
+    const itk::Index<3> first = commonRegion.GetIndex();
+    const itk::Index<3> last = commonRegion.GetUpperIndex();
+    itk::Index<3> index;
+    for (index[2] = first[2]; index[2] <= last[2]; ++index[2])
+    {
+      for (index[1] = first[1]; index[1] <= last[1]; ++index[1])
+      {
+        index[0] = first[0];
+        const float *source = neighborBlock.Values.data() + ComputeOffset(neighborRegion, index);
+        std::copy(source, source + commonRegion.GetSize(0), values + ComputeOffset(region, index));
+      }
+    }
+  }
+
+  vtkSmartPointer<vtkMarchingCubes> marching = vtkSmartPointer<vtkMarchingCubes>::New();
+  marching->ComputeScalarsOff();
+  marching->ComputeNormalsOn();
+  marching->ComputeGradientsOn();
+  marching->SetInputData(imageData);
+  marching->SetValue(0, 0.0);
+  marching->Update();
+
+  block.Surface = vtkSmartPointer<vtkPolyData>::New();
+  block.Surface->ShallowCopy(marching->GetOutput());
+
+  // the points are generated in index coordinates of the input
+  const BaseGeometry *geometry = this->GetInput()->GetGeometry();
+  vtkPoints *points = block.Surface->GetPoints();
+  const vtkIdType numberOfPoints = nullptr != points ? points->GetNumberOfPoints() : 0;
+  block.IsSeamPoint.assign(numberOfPoints, false);
+
+  double point[3];
+  mitk::Point3D indexPoint;
+  mitk::Point3D worldPoint;
+
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    points->GetPoint(i, point);
+
+    // the lower and upper border of the block region are shared with the neighbor blocks, except at the image border
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      const auto lower = region.GetIndex(j);
+      const auto upper = region.GetUpperIndex()[j];
+      if ((lower > 0 && point[j] == static_cast<double>(lower)) ||
+          (upper < m_ImageRegion.GetUpperIndex()[j] && point[j] == static_cast<double>(upper)))
+        block.IsSeamPoint[i] = true;
+    }
+
+    indexPoint[0] = point[0];
+    indexPoint[1] = point[1];
+    indexPoint[2] = point[2];
+    geometry->IndexToWorld(indexPoint, worldPoint);
+    points->SetPoint(i, worldPoint[0], worldPoint[1], worldPoint[2]);
+  }
+}
+
+void mitk::LabelSetImageToSurfaceFilter::AssembleBlockSurfaces()
+{
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
+  vtkSmartPointer<vtkFloatArray> normals = vtkSmartPointer<vtkFloatArray>::New();
+  normals->SetNumberOfComponents(3);
+  normals->SetName("Normals");
+
+  // The seam points of neighboring blocks are generated from the same values and coincide exactly. Only these are
+  // merged, instead of cleaning the whole surface, the other points are copied.
+  std::map<std::array<double, 3>, vtkIdType> seamPointIds;
+  std::vector<vtkIdType> pointIds;
+  std::vector<vtkIdType> cellPointIds;
+
+  for (const auto &blockEntry : m_Blocks)
+  {
+    const SurfaceBlock &block = blockEntry.second;
+    if (nullptr == block.Surface || 0 == block.Surface->GetNumberOfPoints())
+      continue;
+
+    vtkPoints *blockPoints = block.Surface->GetPoints();
+    vtkDataArray *blockNormals = block.Surface->GetPointData()->GetNormals();
+    const vtkIdType numberOfPoints = blockPoints->GetNumberOfPoints();
+    pointIds.resize(numberOfPoints);
+
+    std::array<double, 3> point;
+    for (vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+      blockPoints->GetPoint(i, point.data());
+
+      if (block.IsSeamPoint[i])
+      {
+        const auto inserted = seamPointIds.insert(std::make_pair(point, points->GetNumberOfPoints()));
+        pointIds[i] = inserted.first->second;
+        if (!inserted.second)
+          continue;
+      }
+      else
+      {
+        pointIds[i] = points->GetNumberOfPoints();
+      }
+
+      points->InsertNextPoint(point.data());
+      if (nullptr != blockNormals)
+        normals->InsertNextTuple(blockNormals->GetTuple(i));
+    }
+
+    vtkCellArray *blockPolys = block.Surface->GetPolys();
+    const vtkIdType *cell(nullptr);
+    vtkIdType cellSize(0);
+
+    for (blockPolys->InitTraversal(); blockPolys->GetNextCell(cellSize, cell);)
+    {
+      cellPointIds.resize(cellSize);
+      for (vtkIdType j = 0; j < cellSize; ++j)
+        cellPointIds[j] = pointIds[cell[j]];
+      polys->InsertNextCell(cellSize, cellPointIds.data());
+    }
+  }
+
+  if (0 == points->GetNumberOfPoints())
+    throw itk::ExceptionObject(__FILE__, __LINE__, "marching cubes has failed.");
+
+  vtkSmartPointer<vtkPolyData> surface = vtkSmartPointer<vtkPolyData>::New();
+  surface->SetPoints(points);
+  surface->SetPolys(polys);
+  if (normals->GetNumberOfTuples() == points->GetNumberOfPoints())
+    surface->GetPointData()->SetNormals(normals);
+
+  mitk::Surface::Pointer output = this->GetOutput(0);
+  output->SetVtkPolyData(surface, 0);
+}
+
+template <typename TPixel, unsigned int VDimension>
+void mitk::LabelSetImageToSurfaceFilter::IncrementalProcessing(const itk::Image<TPixel, VDimension> *input,
+                                                               const itk::ImageRegion<VDimension> &labelRegion,
+                                                               const itk::ImageRegion<VDimension> *modifiedRegion)
+{
+  typedef itk::Image<TPixel, VDimension> ImageType;
+  typedef typename ImageType::RegionType RegionType;
+
+  const unsigned int margin = this->GetBlockMargin();
+  const RegionType largestRegion = input->GetLargestPossibleRegion();
+
+  std::set<BlockIndexType, BlockIndexCompareType> candidates;
+  auto addCandidates = [&](const RegionType &region) {
+    RegionType searchRegion = region;
+    searchRegion.PadByRadius(margin);
+    if (0 == region.GetNumberOfPixels() || !searchRegion.Crop(largestRegion))
+      return;
+
+    const auto first = searchRegion.GetIndex();
+    const auto last = searchRegion.GetUpperIndex();
+
+    BlockIndexType blockIndex;
+    for (blockIndex[2] = first[2] / m_BlockSize; blockIndex[2] <= last[2] / m_BlockSize; ++blockIndex[2])
+      for (blockIndex[1] = first[1] / m_BlockSize; blockIndex[1] <= last[1] / m_BlockSize; ++blockIndex[1])
+        for (blockIndex[0] = first[0] / m_BlockSize; blockIndex[0] <= last[0] / m_BlockSize; ++blockIndex[0])
+          candidates.insert(blockIndex);
+  };
+
+  if (nullptr != modifiedRegion)
+  {
+    // only blocks whose neighborhood contains modified pixels may have changed
+    addCandidates(*modifiedRegion);
+  }
+  else
+  {
+    // candidates are the cached blocks and all blocks whose neighborhood may contain the label
+    for (const auto &block : m_Blocks)
+      candidates.insert(block.first);
+
+    addCandidates(labelRegion);
+  }
+
+  // A block has to be processed again if the label changed within its neighborhood. Blocks without label border
+  // in their neighborhood have no surface and are not cached.
+  std::set<BlockIndexType, BlockIndexCompareType> changedBlocks;
+  for (const auto &blockIndex : candidates)
+  {
+    RegionType paddedRegion = this->GetBlockRegion(blockIndex);
+    paddedRegion.PadByRadius(margin);
+    if (!paddedRegion.Crop(largestRegion))
+      continue;
+
+    const auto label = static_cast<TPixel>(m_RequestedLabel);
+    std::uint64_t hash = 14695981039346656037ull;
+    itk::SizeValueType numberOfLabelPixels = 0;
+
+    for (itk::ImageRegionConstIterator<ImageType> it(input, paddedRegion); !it.IsAtEnd(); ++it)
+    {
+      const bool isLabel = it.Get() == label;
+      numberOfLabelPixels += isLabel;
+      hash = (hash ^ static_cast<std::uint64_t>(isLabel)) * 1099511628211ull;
+    }
+
+    auto blockIter = m_Blocks.find(blockIndex);
+
+    if (0 == numberOfLabelPixels || paddedRegion.GetNumberOfPixels() == numberOfLabelPixels)
+    {
+      if (blockIter != m_Blocks.end())
+      {
+        m_Blocks.erase(blockIter);
+        changedBlocks.insert(blockIndex);
+      }
+      continue;
+    }
+
+    if (blockIter != m_Blocks.end() && blockIter->second.Hash == hash)
+      continue;
+
+    SurfaceBlock &block = m_Blocks[blockIndex];
+    block.Hash = hash;
+    block.Region = this->GetBlockRegion(blockIndex);
+    for (unsigned int i = 0; i < 3; ++i)
+      block.Region.SetSize(i, block.Region.GetSize(i) + 1);
+    block.Region.Crop(m_ImageRegion);
+
+    this->ComputeBlockValues(input, paddedRegion, block);
+    changedBlocks.insert(blockIndex);
+  }
+
+  // the lower neighbors of changed blocks use their values, too
+  std::set<BlockIndexType, BlockIndexCompareType> updatedBlocks;
+  for (const auto &blockIndex : changedBlocks)
+  {
+    for (unsigned int neighbor = 0; neighbor < 8; ++neighbor)
+    {
+      BlockIndexType neighborIndex = blockIndex;
+      for (unsigned int i = 0; i < 3; ++i)
+        neighborIndex[i] -= (neighbor >> i) & 1;
+
+      if (m_Blocks.find(neighborIndex) != m_Blocks.end())
+        updatedBlocks.insert(neighborIndex);
+    }
+  }
+
+  for (const auto &blockIndex : updatedBlocks)
+    this->UpdateBlockSurface(blockIndex);
+
+  m_NumberOfUpdatedBlocks = static_cast<unsigned int>(updatedBlocks.size());
+
+  this->AssembleBlockSurfaces();
+}
+
+template <typename TPixel, unsigned int VDimension>
+void mitk::LabelSetImageToSurfaceFilter::ComputeBlockValues(const itk::Image<TPixel, VDimension> *input,
+                                                            const itk::ImageRegion<VDimension> &paddedRegion,
+                                                            SurfaceBlock &block)
+{
+  typedef itk::Image<TPixel, VDimension> ImageType;
+  typedef itk::Image<float, VDimension> RealImageType;
+
+  typedef itk::ExtractImageFilter<ImageType, ImageType> ExtractFilterType;
+  typedef itk::BinaryThresholdImageFilter<ImageType, ImageType> BinaryThresholdFilterType;
+  typedef itk::AntiAliasBinaryImageFilter<ImageType, RealImageType> AntiAliasFilterType;
+  typedef itk::SmoothingRecursiveGaussianImageFilter<RealImageType, RealImageType> GaussianFilterType;
+
+  // same processing as in InternalProcessing, restricted to the neighborhood of the block
+  typename ExtractFilterType::Pointer extractFilter = ExtractFilterType::New();
+  extractFilter->SetInput(input);
+  extractFilter->SetExtractionRegion(paddedRegion);
+  extractFilter->SetDirectionCollapseToSubmatrix();
+
+  typename BinaryThresholdFilterType::Pointer thresholdFilter = BinaryThresholdFilterType::New();
+  thresholdFilter->SetInput(extractFilter->GetOutput());
+  thresholdFilter->SetLowerThreshold(m_RequestedLabel);
+  thresholdFilter->SetUpperThreshold(m_RequestedLabel);
+  thresholdFilter->SetOutsideValue(0);
+  thresholdFilter->SetInsideValue(1);
+
+  typename AntiAliasFilterType::Pointer antiAliasFilter = AntiAliasFilterType::New();
+  antiAliasFilter->SetInput(thresholdFilter->GetOutput());
+  antiAliasFilter->SetMaximumRMSError(0.001);
+  antiAliasFilter->SetNumberOfLayers(3);
+  antiAliasFilter->SetUseImageSpacing(false);
+  antiAliasFilter->SetNumberOfIterations(40);
+  antiAliasFilter->Update();
+
+  typename RealImageType::Pointer result = antiAliasFilter->GetOutput();
+
+  if (m_UseSmoothing)
+  {
+    typename GaussianFilterType::Pointer gaussianFilter = GaussianFilterType::New();
+    gaussianFilter->SetSigma(m_Sigma);
+    gaussianFilter->SetInput(result);
+    gaussianFilter->Update();
+    result = gaussianFilter->GetOutput();
+  }
+
+  block.Values.resize(block.Region.GetNumberOfPixels());
+  std::size_t i = 0;
+  for (itk::ImageRegionConstIterator<RealImageType> it(result, block.Region); !it.IsAtEnd(); ++it, ++i)
+    block.Values[i] = it.Get();
+
+  block.Surface = nullptr;
 }
 
 template <typename TPixel, unsigned int VDimension>
 void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPixel, VDimension> *input,
-                                                            mitk::Surface * /*surface*/)
+                                                            mitk::Surface * /*surface*/,
+                                                            const itk::ImageRegion<VDimension> &labelRegion)
 {
   typedef itk::Image<TPixel, VDimension> ImageType;
 
+  typedef itk::ExtractImageFilter<ImageType, ImageType> ExtractFilterType;
   typedef itk::BinaryThresholdImageFilter<ImageType, ImageType> BinaryThresholdFilterType;
   typedef itk::LabelObject<TPixel, VDimension> LabelObjectType;
   typedef itk::LabelMap<LabelObjectType> LabelMapType;
@@ -100,8 +825,14 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
   typedef itk::AntiAliasBinaryImageFilter<ImageType, RealImageType> AntiAliasFilterType;
   typedef itk::SmoothingRecursiveGaussianImageFilter<RealImageType, RealImageType> GaussianFilterType;
 
+  // the extracted region keeps its index, thus the crop index below refers to the input image
+  typename ExtractFilterType::Pointer extractFilter = ExtractFilterType::New();
+  extractFilter->SetInput(input);
+  extractFilter->SetExtractionRegion(labelRegion);
+  extractFilter->SetDirectionCollapseToSubmatrix();
+
   typename BinaryThresholdFilterType::Pointer thresholdFilter = BinaryThresholdFilterType::New();
-  thresholdFilter->SetInput(input);
+  thresholdFilter->SetInput(extractFilter->GetOutput());
   thresholdFilter->SetLowerThreshold(m_RequestedLabel);
   thresholdFilter->SetUpperThreshold(m_RequestedLabel);
   thresholdFilter->SetOutsideValue(0);
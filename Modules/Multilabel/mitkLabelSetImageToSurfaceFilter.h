@@ -19,10 +19,15 @@ found in the LICENSE file.
 #include <mitkSurfaceSource.h>
 
 #include <vtkMatrix4x4.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
 
 #include <itkImage.h>
 
+#include <cstdint>
 #include <map>
+#include <tuple>
+#include <vector>
 
 namespace mitk
 {
@@ -30,6 +35,20 @@ namespace mitk
    * Generates surface meshes from a labelset image.
    * If you want to calculate a surface representation for all available labels,
    * you may call GenerateAllLabelsOn().
+   *
+   * All labels are extracted in a single sweep over the image, which is distributed over slabs of the volume on
+   * several threads. The surfaces consist of the voxel faces between different labels and are smoothed if
+   * smoothing is enabled. The anti-aliasing of the single label mode is not applied. Each label except the
+   * background gets its own output, see GetLabelForNthOutput().
+   *
+   * In the incremental mode (IncrementalUpdateOn()) the image is divided into blocks of BlockSize voxels that
+   * are processed independently and cached between updates. An update only processes the blocks whose
+   * neighborhood in the label changed since the previous update, e.g. while painting, and stitches their surfaces
+   * with the cached ones. If the input is a LabelSetImage that knows the region modified since the previous update
+   * (see LabelSetImage::GetModifiedRegion()), only the blocks around this region are checked for changes, otherwise
+   * all blocks around the label. The surface differs slightly from the one of the regular mode, because the anti-aliasing
+   * is restricted to the neighborhood of each block. The cache is dropped if the input, its geometry, the requested
+   * label or the smoothing parameters change.
    */
   class MITKMULTILABEL_EXPORT LabelSetImageToSurfaceFilter : public SurfaceSource
   {
@@ -105,6 +124,40 @@ namespace mitk
      */
     itkSetMacro(Sigma, float);
 
+    /**
+     * Sets whether to update the surface incrementally from cached blocks
+     */
+    itkSetMacro(IncrementalUpdate, bool);
+    itkGetMacro(IncrementalUpdate, bool);
+    itkBooleanMacro(IncrementalUpdate);
+
+    /**
+     * Sets the edge length in voxels of the blocks of the incremental mode, by default 32
+     */
+    itkSetClampMacro(BlockSize, unsigned int, 8, 1024);
+    itkGetMacro(BlockSize, unsigned int);
+
+    /**
+     * Returns the number of blocks whose surface has been generated by the last incremental update
+     */
+    itkGetConstMacro(NumberOfUpdatedBlocks, unsigned int);
+
+    /**
+     * Removes all cached blocks, the next incremental update processes the whole label
+     */
+    void ClearBlockCache();
+
+    /**
+     * Returns the label whose surface is the Nth output of the last update with GenerateAllLabels() set to true.
+     * If index is out of range, the background label is returned.
+     */
+    LabelType GetLabelForNthOutput(unsigned int index) const;
+
+    /**
+     * Returns the number of voxels of the label found by the last update with GenerateAllLabels() set to true.
+     */
+    unsigned long GetNumberOfVoxelsOfLabel(LabelType label) const;
+
   protected:
     LabelSetImageToSurfaceFilter();
 
@@ -127,7 +180,57 @@ namespace mitk
     mitk::Image::Pointer m_ResultImage;
 
     template <typename TPixel, unsigned int VImageDimension>
-    void InternalProcessing(const itk::Image<TPixel, VImageDimension> *input, mitk::Surface *surface);
+    void InternalProcessing(const itk::Image<TPixel, VImageDimension> *input,
+                            mitk::Surface *surface,
+                            const itk::ImageRegion<VImageDimension> &labelRegion);
+
+    typedef itk::Index<3> BlockIndexType;
+
+    typedef itk::Functor::IndexLexicographicCompare<3> BlockIndexCompareType;
+
+    /**
+     * Anti-aliased values of the grid points of a block and the surface generated from them. The values cover
+     * the block and the first points of the upper neighbor blocks, which are needed for the cells at the border.
+     */
+    struct SurfaceBlock
+    {
+      std::uint64_t Hash;
+      itk::ImageRegion<3> Region;
+      std::vector<float> Values;
+      vtkSmartPointer<vtkPolyData> Surface;
+      /** whether a point of Surface lies on the common border with a neighbor block and is shared with it */
+      std::vector<bool> IsSeamPoint;
+    };
+
+    typedef std::map<BlockIndexType, SurfaceBlock, BlockIndexCompareType> BlockMapType;
+
+    /** input, geometry MTime, label, smoothing, sigma and block size the cached blocks have been generated for */
+    typedef std::tuple<const Image *, unsigned long, int, int, float, unsigned int> BlockCacheKeyType;
+
+    template <typename TPixel, unsigned int VImageDimension>
+    void AllLabelsProcessing(const itk::Image<TPixel, VImageDimension> *input);
+
+    template <typename TPixel, unsigned int VImageDimension>
+    void IncrementalProcessing(const itk::Image<TPixel, VImageDimension> *input,
+                               const itk::ImageRegion<VImageDimension> &labelRegion,
+                               const itk::ImageRegion<VImageDimension> *modifiedRegion);
+
+    template <typename TPixel, unsigned int VImageDimension>
+    void ComputeBlockValues(const itk::Image<TPixel, VImageDimension> *input,
+                            const itk::ImageRegion<VImageDimension> &paddedRegion,
+                            SurfaceBlock &block);
+
+    /** Region of the voxels of a block, cropped to the image */
+    itk::ImageRegion<3> GetBlockRegion(const BlockIndexType &blockIndex) const;
+
+    /** Distance in voxels up to which label changes influence the surface of a block */
+    unsigned int GetBlockMargin() const;
+
+    /** Generates the surface of a block from its values and the values of its upper neighbors */
+    void UpdateBlockSurface(const BlockIndexType &blockIndex);
+
+    /** Stitches the surfaces of all blocks into the output, merging their shared seam points */
+    void AssembleBlockSurfaces();
 
     bool m_GenerateAllLabels;
 
@@ -145,6 +248,21 @@ namespace mitk
 
     mitk::Vector3D m_InputImageSpacing;
 
+    bool m_IncrementalUpdate;
+
+    unsigned int m_BlockSize;
+
+    unsigned int m_NumberOfUpdatedBlocks;
+
+    BlockMapType m_Blocks;
+
+    BlockCacheKeyType m_BlockCacheKey;
+
+    /** modification time of the input the cached blocks are up to date with */
+    unsigned long m_BlockCacheMTime;
+
+    itk::ImageRegion<3> m_ImageRegion;
+
     void GenerateData() override;
 
     void GenerateOutputInformation() override;
@@ -15,6 +15,14 @@ found in the LICENSE file.
 #include "mitkLabelSetImage.h"
 #include "mitkLabelSetImageToSurfaceFilter.h"
 
+#include <mutex>
+
+namespace
+{
+  // serializes the runs that share a "SurfaceFilter"
+  std::mutex SharedSurfaceFilterMutex;
+}
+
 namespace mitk
 {
   LabelSetImageToSurfaceThreadedFilter::LabelSetImageToSurfaceThreadedFilter() : m_RequestedLabel(1), m_Result(nullptr)
@@ -61,19 +69,53 @@ namespace mitk
       MITK_WARN << "\"Smooth\" parameter was not set: will use the default value (" << useSmoothing << ").";
     }
 
+    bool allLabels(false);
+    try
+    {
+      this->GetParameter("AllLabels", allLabels);
+    }
+    catch (std::invalid_argument &)
+    {
+    }
+
+    if (!allLabels)
+    {
+      try
+      {
+        this->GetParameter("RequestedLabel", m_RequestedLabel);
+      }
+      catch (std::invalid_argument &)
+      {
+        MITK_WARN << "\"RequestedLabel\" parameter was not set: will use the default value (" << m_RequestedLabel
+                  << ").";
+      }
+    }
+
+    // a filter kept by the caller updates the surface of a label incrementally from the blocks cached by the last run
+    mitk::LabelSetImageToSurfaceFilter::Pointer filter;
     try
     {
-      this->GetParameter("RequestedLabel", m_RequestedLabel);
+      this->GetPointerParameter("SurfaceFilter", filter);
     }
     catch (std::invalid_argument &)
     {
-      MITK_WARN << "\"RequestedLabel\" parameter was not set: will use the default value (" << m_RequestedLabel << ").";
     }
 
-    mitk::LabelSetImageToSurfaceFilter::Pointer filter = mitk::LabelSetImageToSurfaceFilter::New();
+    std::unique_lock<std::mutex> sharedFilterLock;
+    if (filter.IsNull() || allLabels)
+    {
+      filter = mitk::LabelSetImageToSurfaceFilter::New();
+    }
+    else
+    {
+      sharedFilterLock = std::unique_lock<std::mutex>(SharedSurfaceFilterMutex);
+      filter->IncrementalUpdateOn();
+    }
+
     filter->SetInput(image);
     //  filter->SetObserver(obsv);
-    filter->SetGenerateAllLabels(false);
+    filter->SetGenerateAllLabels(allLabels);
+    filter->SetBackgroundLabel(image->GetExteriorLabel()->GetValue());
     filter->SetRequestedLabel(m_RequestedLabel);
     filter->SetUseSmoothing(useSmoothing);
 
@@ -97,6 +139,27 @@ namespace mitk
       return false;
     }
 
+    m_Results.clear();
+    m_ResultLabels.clear();
+
+    if (allLabels)
+    {
+      for (unsigned int i = 0; i < filter->GetNumberOfIndexedOutputs(); ++i)
+      {
+        const auto label = filter->GetLabelForNthOutput(i);
+        Surface::Pointer result = filter->GetOutput(i);
+
+        if (result.IsNull() || !result->GetVtkPolyData() || 0 == filter->GetNumberOfVoxelsOfLabel(label))
+          continue;
+
+        result->DisconnectPipeline();
+        m_Results.push_back(result);
+        m_ResultLabels.push_back(label);
+      }
+
+      return !m_Results.empty();
+    }
+
     m_Result = filter->GetOutput();
 
     if (m_Result.IsNull() || !m_Result->GetVtkPolyData())
@@ -104,6 +167,9 @@ namespace mitk
 
     m_Result->DisconnectPipeline();
 
+    m_Results.push_back(m_Result);
+    m_ResultLabels.push_back(m_RequestedLabel);
+
     return true;
   }
 
@@ -112,17 +178,25 @@ namespace mitk
     LabelSetImage::Pointer image;
     this->GetPointerParameter("Input", image);
 
-    std::string name = this->GetGroupNode()->GetName();
-    name.append("-surf");
+    for (std::size_t i = 0; i < m_Results.size(); ++i)
+    {
+      std::string name = this->GetGroupNode()->GetName();
+      const auto *label = image->GetLabel(m_ResultLabels[i], image->GetActiveLayer());
+
+      // the name of the label distinguishes the surfaces of several labels
+      if (m_Results.size() > 1 && nullptr != label)
+        name.append("-").append(label->GetName());
+      name.append("-surf");
 
-    mitk::DataNode::Pointer node = mitk::DataNode::New();
-    node->SetData(m_Result);
-    node->SetName(name);
+      mitk::DataNode::Pointer node = mitk::DataNode::New();
+      node->SetData(m_Results[i]);
+      node->SetName(name);
 
-    mitk::Color color = image->GetLabel(m_RequestedLabel, image->GetActiveLayer())->GetColor();
-    node->SetColor(color);
+      if (nullptr != label)
+        node->SetColor(label->GetColor());
 
-    this->InsertBelowGroupNode(node);
+      this->InsertBelowGroupNode(node);
+    }
 
     Superclass::ThreadedUpdateSuccessful();
   }
@@ -17,8 +17,18 @@ found in the LICENSE file.
 #include "mitkSurface.h"
 #include <MitkMultilabelExports.h>
 
+#include <vector>
+
 namespace mitk
 {
+  /**
+   * Creates the surface of the label given by the parameter "RequestedLabel" in the background. If the parameter
+   * "AllLabels" is true, the surfaces of all labels of the active layer are created in a single pass instead.
+   *
+   * The optional parameter "SurfaceFilter" passes a LabelSetImageToSurfaceFilter that the caller keeps between the
+   * runs. It is switched to the incremental mode, thus repeated runs for the same label only process the blocks of
+   * the image that changed since the previous run. Runs sharing a filter are serialized.
+   */
   class MITKMULTILABEL_EXPORT LabelSetImageToSurfaceThreadedFilter : public SegmentationSink
   {
   public:
@@ -39,6 +49,10 @@ namespace mitk
   private:
     int m_RequestedLabel;
     Surface::Pointer m_Result;
+
+    // results of the "AllLabels" mode
+    std::vector<int> m_ResultLabels;
+    std::vector<Surface::Pointer> m_Results;
   };
 
 } // namespace
@@ -145,13 +145,14 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
 
   for (int lidx = 0; lidx < numberOfLayers; ++lidx)
   {
-    mitk::Image *layerImage = nullptr;
+    mitk::Image::ConstPointer layerImage;
 
-    // set main input for ExtractSliceFilter
+    // set main input for ExtractSliceFilter. A compressed layer is decoded for reslicing only, the decoded image is
+    // released below, so that it does not stay in memory in addition to the compressed data.
     if (lidx == activeLayer)
       layerImage = image;
     else
-      layerImage = image->GetLayerImage(lidx);
+      layerImage = static_cast<const mitk::LabelSetImage *>(image)->DecodeLayerImage(lidx);
 
     localStorage->m_ReslicerVector[lidx]->SetInput(layerImage);
     localStorage->m_ReslicerVector[lidx]->SetWorldGeometry(worldGeometry);
@@ -195,6 +196,9 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
     localStorage->m_ReslicerVector[lidx]->UpdateLargestPossibleRegion();
     localStorage->m_ReslicedImageVector[lidx] = localStorage->m_ReslicerVector[lidx]->GetVtkOutput();
 
+    if (lidx != activeLayer && image->IsLayerCompressed(lidx))
+      localStorage->m_ReslicerVector[lidx]->SetInput(nullptr);
+
     const auto *planeGeometry = dynamic_cast<const PlaneGeometry *>(worldGeometry);
 
     double textureClippingBounds[6];
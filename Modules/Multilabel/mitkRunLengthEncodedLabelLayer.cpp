@@ -0,0 +1,113 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkRunLengthEncodedLabelLayer.h"
+
+#include <algorithm>
+#include <limits>
+
+mitk::RunLengthEncodedLabelLayer::RunLengthEncodedLabelLayer() : m_NumberOfPixels(0)
+{
+}
+
+void mitk::RunLengthEncodedLabelLayer::Encode(const PixelType *data, std::size_t numberOfPixels)
+{
+  this->Clear();
+
+  const PixelType *end = data + numberOfPixels;
+  const PixelType *runBegin = data;
+
+  while (runBegin != end)
+  {
+    const PixelType value = *runBegin;
+    const PixelType *runEnd = std::find_if(runBegin + 1, end, [value](PixelType pixel) { return pixel != value; });
+
+    this->AppendRun(value, static_cast<std::size_t>(runEnd - runBegin));
+    runBegin = runEnd;
+  }
+
+  m_Runs.shrink_to_fit();
+}
+
+void mitk::RunLengthEncodedLabelLayer::Fill(PixelType value, std::size_t numberOfPixels)
+{
+  this->Clear();
+  this->AppendRun(value, numberOfPixels);
+}
+
+void mitk::RunLengthEncodedLabelLayer::Decode(PixelType *data) const
+{
+  for (const auto &run : m_Runs)
+  {
+    data = std::fill_n(data, run.Length, run.Value);
+  }
+}
+
+bool mitk::RunLengthEncodedLabelLayer::ReplaceValue(PixelType oldValue, PixelType newValue)
+{
+  if (oldValue == newValue || !this->ContainsValue(oldValue))
+    return false;
+
+  // Replace the values and merge runs that got equal values
+  RunContainerType runs;
+  runs.reserve(m_Runs.size());
+
+  for (auto run : m_Runs)
+  {
+    if (run.Value == oldValue)
+      run.Value = newValue;
+
+    if (!runs.empty() && runs.back().Value == run.Value &&
+        static_cast<std::size_t>(runs.back().Length) + run.Length <= std::numeric_limits<std::uint32_t>::max())
+    {
+      runs.back().Length += run.Length;
+    }
+    else
+    {
+      runs.push_back(run);
+    }
+  }
+
+  runs.shrink_to_fit();
+  m_Runs.swap(runs);
+  return true;
+}
+
+bool mitk::RunLengthEncodedLabelLayer::ContainsValue(PixelType value) const
+{
+  return std::any_of(m_Runs.begin(), m_Runs.end(), [value](const Run &run) { return run.Value == value; });
+}
+
+void mitk::RunLengthEncodedLabelLayer::Clear()
+{
+  RunContainerType().swap(m_Runs);
+  m_NumberOfPixels = 0;
+}
+
+std::size_t mitk::RunLengthEncodedLabelLayer::GetMemorySize() const
+{
+  return m_Runs.capacity() * sizeof(Run);
+}
+
+void mitk::RunLengthEncodedLabelLayer::AppendRun(PixelType value, std::size_t length)
+{
+  m_NumberOfPixels += length;
+
+  // Runs longer than the maximum run length, e.g. of large 4D images, are split
+  const std::size_t maximumLength = std::numeric_limits<std::uint32_t>::max();
+  while (length > 0)
+  {
+    const auto runLength = std::min(length, maximumLength);
+    m_Runs.push_back({value, static_cast<std::uint32_t>(runLength)});
+    length -= runLength;
+  }
+}
@@ -0,0 +1,89 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __mitkRunLengthEncodedLabelLayer_H_
+#define __mitkRunLengthEncodedLabelLayer_H_
+
+#include <mitkLabel.h>
+
+#include <MitkMultilabelExports.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * @brief Run-length encoded pixel data of a single layer of a mitk::LabelSetImage.
+   *
+   * Segmentations mostly consist of large areas with the same label value, in particular of background. Storing
+   * consecutive pixels with equal values as a single run usually needs only a small fraction of the memory of the
+   * dense buffer. Operations that replace label values, like merging or erasing labels, are directly applied to the
+   * runs without decoding the layer.
+   *
+   * The pixels are encoded in the order of the image buffer, i.e. all time steps of a 4D image are encoded one after
+   * the other.
+   */
+  class MITKMULTILABEL_EXPORT RunLengthEncodedLabelLayer
+  {
+  public:
+    typedef mitk::Label::PixelType PixelType;
+
+    struct Run
+    {
+      PixelType Value;
+      std::uint32_t Length;
+    };
+
+    typedef std::vector<Run> RunContainerType;
+
+    RunLengthEncodedLabelLayer();
+
+    /** Encodes the pixels of a dense buffer. Previously encoded data is replaced. */
+    void Encode(const PixelType *data, std::size_t numberOfPixels);
+
+    /** Encodes numberOfPixels pixels that all have the same value. Previously encoded data is replaced. */
+    void Fill(PixelType value, std::size_t numberOfPixels);
+
+    /** Decodes the pixels into a dense buffer, which must have room for GetNumberOfPixels() pixels. */
+    void Decode(PixelType *data) const;
+
+    /** Replaces all pixels of oldValue by newValue. Returns true if at least one pixel has been changed. */
+    bool ReplaceValue(PixelType oldValue, PixelType newValue);
+
+    bool ContainsValue(PixelType value) const;
+
+    /** Removes all encoded data */
+    void Clear();
+
+    /** True if no pixels are encoded */
+    bool IsEmpty() const { return m_Runs.empty(); }
+
+    std::size_t GetNumberOfPixels() const { return m_NumberOfPixels; }
+
+    std::size_t GetNumberOfRuns() const { return m_Runs.size(); }
+
+    const RunContainerType &GetRuns() const { return m_Runs; }
+
+    /** Returns the number of bytes that are occupied by the runs */
+    std::size_t GetMemorySize() const;
+
+  private:
+    void AppendRun(PixelType value, std::size_t length);
+
+    RunContainerType m_Runs;
+    std::size_t m_NumberOfPixels;
+  };
+}
+
+#endif // __mitkRunLengthEncodedLabelLayer_H_
@@ -84,6 +84,9 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    /** Interpolates the AIF only once for all parameter sets.*/
+    void ComputeModelfunctions(const ParametersMatrixType& parameters, SignalsType& signals) const override;
+
     DerivedParameterMapType ComputeDerivedParameters(const mitk::ModelBase::ParametersType&
         parameters) const override;
 
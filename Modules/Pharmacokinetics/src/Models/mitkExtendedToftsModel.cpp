@@ -150,6 +150,35 @@ mitk::ExtendedToftsModel::ModelResultType mitk::ExtendedToftsModel::ComputeModel
 }
 
 
+void mitk::ExtendedToftsModel::ComputeModelfunctions(const ParametersMatrixType& parameters,
+  SignalsType& signals) const
+{
+  if (this->m_TimeGrid.GetSize() == 0)
+  {
+    itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
+  }
+
+  const AterialInputFunctionType aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const unsigned int timeSteps = this->m_TimeGrid.GetSize();
+
+  for (unsigned int row = 0; row < parameters.rows(); ++row)
+  {
+    const double ktrans = parameters(row, POSITION_PARAMETER_Ktrans) / 6000.0;
+    const double ve = parameters(row, POSITION_PARAMETER_ve);
+    const double vp = parameters(row, POSITION_PARAMETER_vp);
+
+    const mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
+        aterialInputFunction, ktrans / ve);
+
+    double* signal = signals[row];
+    for (unsigned int i = 0; i < timeSteps; ++i)
+    {
+      signal[i] = aterialInputFunction[i] * vp + ktrans * convolution[i];
+    }
+  }
+}
+
+
 mitk::ModelBase::DerivedParameterMapType mitk::ExtendedToftsModel::ComputeDerivedParameters(
   const mitk::ModelBase::ParametersType& parameters) const
 {
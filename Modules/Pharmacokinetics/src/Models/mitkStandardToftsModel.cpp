@@ -141,6 +141,34 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
 }
 
 
+void mitk::StandardToftsModel::ComputeModelfunctions(const ParametersMatrixType& parameters,
+  SignalsType& signals) const
+{
+  if (this->m_TimeGrid.GetSize() == 0)
+  {
+    itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
+  }
+
+  const AterialInputFunctionType aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const unsigned int timeSteps = this->m_TimeGrid.GetSize();
+
+  for (unsigned int row = 0; row < parameters.rows(); ++row)
+  {
+    const double ktrans = parameters(row, POSITION_PARAMETER_Ktrans) / 6000.0;
+    const double ve = parameters(row, POSITION_PARAMETER_ve);
+
+    const mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
+        aterialInputFunction, ktrans / ve);
+
+    double* signal = signals[row];
+    for (unsigned int i = 0; i < timeSteps; ++i)
+    {
+      signal[i] = ktrans * convolution[i];
+    }
+  }
+}
+
+
 mitk::ModelBase::DerivedParameterMapType mitk::StandardToftsModel::ComputeDerivedParameters(
   const mitk::ModelBase::ParametersType& parameters) const
 {
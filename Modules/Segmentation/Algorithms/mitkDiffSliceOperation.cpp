@@ -12,12 +12,21 @@ found in the LICENSE file.
 
 #include "mitkDiffSliceOperation.h"
 
+#include <mitkExtractSliceFilter.h>
 #include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkVtkImageOverwrite.h>
 
 #include <itkCommand.h>
 
-mitk::DiffSliceOperation::DiffSliceOperation() : Operation(1)
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+mitk::DiffSliceOperation::DiffSliceOperation() : Operation(1), m_IsDifference(false), m_PixelSize(0)
 {
+  m_SliceDimensions[0] = m_SliceDimensions[1] = 0;
   m_TimeStep = 0;
   m_zlibSliceContainer = nullptr;
   m_Image = nullptr;
@@ -32,8 +41,42 @@ mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
                                              const SlicedGeometry3D *sliceGeometry,
                                              TimeStepType timestep,
                                              const BaseGeometry *currentWorldGeometry)
-  : Operation(1)
+  : Operation(1), m_IsDifference(false), m_PixelSize(0)
 
+{
+  m_SliceDimensions[0] = m_SliceDimensions[1] = 0;
+
+  m_zlibSliceContainer = CompressedImageContainer::New();
+  m_zlibSliceContainer->SetImage(slice);
+
+  this->Initialize(imageVolume, sliceGeometry, timestep, currentWorldGeometry);
+}
+
+mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
+                                             const Image *slice,
+                                             const Image *referenceSlice,
+                                             const SlicedGeometry3D *sliceGeometry,
+                                             TimeStepType timestep,
+                                             const BaseGeometry *currentWorldGeometry)
+  : Operation(1), m_IsDifference(false), m_PixelSize(0)
+{
+  m_SliceDimensions[0] = m_SliceDimensions[1] = 0;
+
+  m_IsDifference = this->EncodeDifference(slice, referenceSlice);
+
+  if (!m_IsDifference)
+  {
+    m_zlibSliceContainer = CompressedImageContainer::New();
+    m_zlibSliceContainer->SetImage(slice);
+  }
+
+  this->Initialize(imageVolume, sliceGeometry, timestep, currentWorldGeometry);
+}
+
+void mitk::DiffSliceOperation::Initialize(Image *imageVolume,
+                                          const SlicedGeometry3D *sliceGeometry,
+                                          TimeStepType timestep,
+                                          const BaseGeometry *currentWorldGeometry)
 {
   m_WorldGeometry = currentWorldGeometry->Clone();
 
@@ -48,9 +91,6 @@ mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
 
   m_TimeStep = timestep;
 
-  m_zlibSliceContainer = CompressedImageContainer::New();
-  m_zlibSliceContainer->SetImage(slice);
-
   m_Image = imageVolume;
   m_DeleteObserverTag = 0;
 
@@ -84,13 +124,224 @@ mitk::DiffSliceOperation::~DiffSliceOperation()
 
 mitk::Image::Pointer mitk::DiffSliceOperation::GetSlice()
 {
-  Image::Pointer image = m_zlibSliceContainer->GetImage();
-  return image;
+  if (!m_IsDifference)
+  {
+    Image::Pointer image = m_zlibSliceContainer->GetImage();
+    return image;
+  }
+
+  if (!m_ImageIsValid)
+    return nullptr;
+
+  // the unchanged pixels are taken from the current slice of the volume
+  vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+  reslice->SetOverwriteMode(false);
+  reslice->Modified();
+
+  ExtractSliceFilter::Pointer extractor = ExtractSliceFilter::New(reslice);
+  extractor->SetInput(m_Image);
+  extractor->SetTimeStep(m_TimeStep);
+  extractor->SetWorldGeometry(dynamic_cast<const PlaneGeometry *>(m_WorldGeometry.GetPointer()));
+  extractor->SetVtkOutputRequest(false);
+  extractor->SetResliceTransformByGeometry(m_Image->GetTimeGeometry()->GetGeometryForTimeStep(m_TimeStep));
+  extractor->Modified();
+  extractor->Update();
+
+  Image::Pointer slice = extractor->GetOutput();
+
+  if (slice.IsNull() || slice->GetDimension(0) != m_SliceDimensions[0] ||
+      slice->GetDimension(1) != m_SliceDimensions[1] || slice->GetPixelType().GetSize() != m_PixelSize)
+  {
+    MITK_ERROR << "Cannot restore slice: the slice of the image does not match the stored slice.";
+    return nullptr;
+  }
+
+  slice->DisconnectPipeline();
+  this->DecodeDifference(slice);
+
+  return slice;
+}
+
+std::size_t mitk::DiffSliceOperation::GetMemorySize() const
+{
+  std::size_t size = sizeof(DiffSliceOperation) + m_DiffRunLengths.capacity() * sizeof(std::uint32_t) +
+                     m_DiffValues.capacity();
+
+  if (m_zlibSliceContainer.IsNotNull())
+    size += m_zlibSliceContainer->GetMemorySize();
+
+  return size;
+}
+
+bool mitk::DiffSliceOperation::EncodeDifference(const Image *slice, const Image *referenceSlice)
+{
+  if (nullptr == slice || nullptr == referenceSlice || slice->GetDimension() != referenceSlice->GetDimension() ||
+      slice->GetPixelType() != referenceSlice->GetPixelType())
+    return false;
+
+  std::size_t numberOfPixels = 1;
+  for (unsigned int i = 0; i < slice->GetDimension(); ++i)
+  {
+    if (slice->GetDimension(i) != referenceSlice->GetDimension(i))
+      return false;
+
+    numberOfPixels *= slice->GetDimension(i);
+  }
+
+  const unsigned int width = slice->GetDimension(0);
+  const unsigned int height = slice->GetDimension() > 1 ? slice->GetDimension(1) : 1;
+
+  if (numberOfPixels != static_cast<std::size_t>(width) * height)
+    return false;
+
+  m_SliceDimensions[0] = width;
+  m_SliceDimensions[1] = height;
+  m_PixelSize = slice->GetPixelType().GetSize();
+
+  ImageReadAccessor sliceAccessor(slice);
+  ImageReadAccessor referenceAccessor(referenceSlice);
+  const auto *sliceData = static_cast<const unsigned char *>(sliceAccessor.GetData());
+  const auto *referenceData = static_cast<const unsigned char *>(referenceAccessor.GetData());
+
+  // bounding box of the changed pixels
+  itk::Index<2> minIndex;
+  itk::Index<2> maxIndex;
+  minIndex[0] = width;
+  minIndex[1] = height;
+  maxIndex.Fill(-1);
+
+  for (unsigned int y = 0; y < height; ++y)
+  {
+    const std::size_t rowOffset = static_cast<std::size_t>(y) * width * m_PixelSize;
+    if (0 == std::memcmp(sliceData + rowOffset, referenceData + rowOffset, width * m_PixelSize))
+      continue;
+
+    for (unsigned int x = 0; x < width; ++x)
+    {
+      const std::size_t offset = rowOffset + x * m_PixelSize;
+      if (0 != std::memcmp(sliceData + offset, referenceData + offset, m_PixelSize))
+      {
+        minIndex[0] = std::min<itk::IndexValueType>(minIndex[0], x);
+        maxIndex[0] = std::max<itk::IndexValueType>(maxIndex[0], x);
+      }
+    }
+
+    minIndex[1] = std::min<itk::IndexValueType>(minIndex[1], y);
+    maxIndex[1] = std::max<itk::IndexValueType>(maxIndex[1], y);
+  }
+
+  if (maxIndex[1] < 0)
+  {
+    // nothing changed, the slice of the volume is used as it is
+    return true;
+  }
+
+  m_DiffRegion.SetIndex(minIndex);
+  m_DiffRegion.SetSize(0, maxIndex[0] - minIndex[0] + 1);
+  m_DiffRegion.SetSize(1, maxIndex[1] - minIndex[1] + 1);
+
+  // run-length encode the pixels of the bounding box row by row, runs may continue over row borders
+  const unsigned char *runValue = nullptr;
+  for (auto y = minIndex[1]; y <= maxIndex[1]; ++y)
+  {
+    for (auto x = minIndex[0]; x <= maxIndex[0]; ++x)
+    {
+      const unsigned char *value = sliceData + (static_cast<std::size_t>(y) * width + x) * m_PixelSize;
+
+      if (nullptr != runValue && 0 == std::memcmp(value, runValue, m_PixelSize))
+      {
+        ++m_DiffRunLengths.back();
+      }
+      else
+      {
+        m_DiffRunLengths.push_back(1);
+        m_DiffValues.insert(m_DiffValues.end(), value, value + m_PixelSize);
+        runValue = value;
+      }
+    }
+  }
+
+  m_DiffRunLengths.shrink_to_fit();
+  m_DiffValues.shrink_to_fit();
+
+  return true;
+}
+
+void mitk::DiffSliceOperation::DecodeDifference(Image *slice) const
+{
+  if (m_DiffRunLengths.empty())
+    return;
+
+  ImageWriteAccessor sliceAccessor(slice);
+  auto *sliceData = static_cast<unsigned char *>(sliceAccessor.GetData());
+
+  const auto width = m_DiffRegion.GetSize(0);
+  const auto minX = m_DiffRegion.GetIndex(0);
+  const auto minY = m_DiffRegion.GetIndex(1);
+
+  std::size_t pixel = 0;
+  for (std::size_t run = 0; run < m_DiffRunLengths.size(); ++run)
+  {
+    const unsigned char *value = m_DiffValues.data() + run * m_PixelSize;
+
+    for (std::uint32_t i = 0; i < m_DiffRunLengths[run]; ++i, ++pixel)
+    {
+      const std::size_t x = minX + pixel % width;
+      const std::size_t y = minY + pixel / width;
+      std::memcpy(sliceData + (y * m_SliceDimensions[0] + x) * m_PixelSize, value, m_PixelSize);
+    }
+  }
+}
+
+itk::ImageRegion<3> mitk::DiffSliceOperation::GetChangedRegion() const
+{
+  itk::ImageRegion<3> region;
+
+  if (!m_ImageIsValid || m_WorldGeometry.IsNull() || m_Image->GetDimension() < 3)
+    return region;
+
+  auto imageGeometry = m_Image->GetTimeGeometry()->GetGeometryForTimeStep(m_TimeStep);
+
+  if (imageGeometry.IsNull())
+    return region;
+
+  // bounding box of the corners of the slice in index coordinates of the volume, enlarged by one voxel to cover the
+  // interpolation of the reslicer for oblique planes
+  itk::Index<3> minIndex;
+  itk::Index<3> maxIndex;
+  minIndex.Fill(itk::NumericTraits<itk::IndexValueType>::max());
+  maxIndex.Fill(itk::NumericTraits<itk::IndexValueType>::NonpositiveMin());
+
+  for (int corner = 0; corner < 8; ++corner)
+  {
+    Point3D indexPoint;
+    imageGeometry->WorldToIndex(m_WorldGeometry->GetCornerPoint(corner), indexPoint);
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      minIndex[i] = std::min(minIndex[i], static_cast<itk::IndexValueType>(std::floor(indexPoint[i])) - 1);
+      maxIndex[i] = std::max(maxIndex[i], static_cast<itk::IndexValueType>(std::ceil(indexPoint[i])) + 1);
+    }
+  }
+
+  itk::ImageRegion<3> imageRegion;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    region.SetIndex(i, minIndex[i]);
+    region.SetSize(i, maxIndex[i] - minIndex[i] + 1);
+    imageRegion.SetSize(i, m_Image->GetDimension(i));
+  }
+
+  if (!region.Crop(imageRegion))
+    return itk::ImageRegion<3>();
+
+  return region;
 }
 
 bool mitk::DiffSliceOperation::IsValid()
 {
-  return m_ImageIsValid && m_zlibSliceContainer.IsNotNull() && (m_WorldGeometry.IsNotNull()); // TODO improve
+  return m_ImageIsValid && (m_IsDifference || m_zlibSliceContainer.IsNotNull()) &&
+         (m_WorldGeometry.IsNotNull()); // TODO improve
 }
 
 void mitk::DiffSliceOperation::OnImageDeleted()
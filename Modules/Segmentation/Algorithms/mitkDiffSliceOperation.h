@@ -17,8 +17,13 @@ found in the LICENSE file.
 #include <MitkSegmentationExports.h>
 #include <mitkOperation.h>
 
+#include <itkImageRegion.h>
+
 #include <vtkSmartPointer.h>
 
+#include <cstdint>
+#include <vector>
+
 namespace mitk
 {
   class Image;
@@ -34,6 +39,10 @@ namespace mitk
      currentWorldGeometry   specifies the axis where the slice has to be applied in the volume.
 
     This Operation can be used to realize undo-redo functionality for e.g. segmentation purposes.
+
+    If a reference slice is passed, i.e. the slice that is in the volume when the operation is executed, only the
+    bounding box of the pixels that differ from the reference slice is stored, run-length encoded. On execution,
+    the remaining pixels are taken from the volume. Otherwise the whole slice is stored zlib compressed.
   */
   class MITKSEGMENTATION_EXPORT DiffSliceOperation : public Operation
   {
@@ -57,6 +66,17 @@ namespace mitk
                        const TimeStepType timestep,
                        const BaseGeometry *currentWorldGeometry);
 
+    /** \brief Creates an operation that only stores the pixels of the slice that differ from the reference slice.
+      The reference slice has to be the slice of the volume at the same position at the time the operation is
+      executed, e.g. the edited slice for an undo operation. If the slices differ in size or pixel type, the whole
+      slice is stored.*/
+    DiffSliceOperation(mitk::Image *imageVolume,
+                       const mitk::Image *slice,
+                       const mitk::Image *referenceSlice,
+                       const SlicedGeometry3D *sliceGeometry,
+                       const TimeStepType timestep,
+                       const BaseGeometry *currentWorldGeometry);
+
     /** \brief Check if it is a valid operation.*/
     bool IsValid();
 
@@ -64,7 +84,9 @@ namespace mitk
     mitk::Image *GetImage() { return this->m_Image; }
     const mitk::Image* GetImage() const { return this->m_Image; }
 
-    /** \brief Get the slice that is applied in the operation.*/
+    /** \brief Get the slice that is applied in the operation.
+      If only the changed pixels are stored, the slice is completed from the volume. A nullptr is returned if the
+      slice of the volume does not match the stored pixels anymore.*/
     Image::Pointer GetSlice();
 
     /** \brief Set timeStep*/
@@ -73,14 +95,42 @@ namespace mitk
     const SlicedGeometry3D *GetSliceGeometry() const { return this->m_SliceGeometry; }
     /** \brief Get the axis where the slice has to be applied in the volume.*/
     const BaseGeometry *GetWorldGeometry() const { return this->m_WorldGeometry; }
+    /** \brief Get the region of the volume that is changed by applying the slice, in index coordinates of the volume.
+      The region is empty if the operation is not valid. It can be used to update results derived from the volume
+      (e.g. mitk::ImageStatisticsCalculator::UpdateStatistics) without processing the whole volume again.*/
+    itk::ImageRegion<3> GetChangedRegion() const;
+
+    /** \brief Returns the number of bytes occupied by the stored slice data.*/
+    std::size_t GetMemorySize() const override;
   protected:
     ~DiffSliceOperation() override;
 
     /** \brief Callback for image observer.*/
     void OnImageDeleted();
 
+    void Initialize(mitk::Image *imageVolume,
+                    const SlicedGeometry3D *sliceGeometry,
+                    TimeStepType timestep,
+                    const BaseGeometry *currentWorldGeometry);
+
+    /** \brief Stores the run-length encoded pixels of the slice within the bounding box of the pixels that differ from
+      the reference slice. Returns false if the slices cannot be compared.*/
+    bool EncodeDifference(const mitk::Image *slice, const mitk::Image *referenceSlice);
+
+    /** \brief Writes the stored pixels into the slice.*/
+    void DecodeDifference(mitk::Image *slice) const;
+
     CompressedImageContainer::Pointer m_zlibSliceContainer;
 
+    // Changed pixels of the slice, used instead of m_zlibSliceContainer if a reference slice was given.
+    // m_DiffValues holds m_PixelSize bytes per run.
+    bool m_IsDifference;
+    unsigned int m_SliceDimensions[2];
+    std::size_t m_PixelSize;
+    itk::ImageRegion<2> m_DiffRegion;
+    std::vector<std::uint32_t> m_DiffRunLengths;
+    std::vector<unsigned char> m_DiffValues;
+
     mitk::Image *m_Image;
 
     vtkSmartPointer<vtkImageData> m_Slice;
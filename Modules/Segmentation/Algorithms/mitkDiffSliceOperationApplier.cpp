@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkDiffSliceOperationApplier.h"
 
 #include "mitkDiffSliceOperation.h"
+#include "mitkLabelSetImage.h"
 #include "mitkRenderingManager.h"
 #include "mitkSegTool2D.h"
 #include <mitkExtractSliceFilter.h>
@@ -44,6 +45,9 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
     vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
 
     mitk::Image::Pointer slice = imageOperation->GetSlice();
+    if (slice.IsNull())
+      return;
+
     // Set the slice as 'input'
     reslice->SetInputSlice(slice->GetVtkImageData());
 
@@ -64,7 +68,16 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
 
     // make sure the modification is rendered
     RenderingManager::GetInstance()->RequestUpdateAll();
-    imageOperation->GetImage()->Modified();
+    auto *labelSetImage = dynamic_cast<LabelSetImage *>(imageOperation->GetImage());
+    if (nullptr != labelSetImage)
+    {
+      // only the written slice has to be scanned, results derived from the image can be updated incrementally
+      labelSetImage->UpdateLabelRegions(imageOperation->GetChangedRegion());
+    }
+    else
+    {
+      imageOperation->GetImage()->Modified();
+    }
 
     mitk::ExtractSliceFilter::Pointer extractor2 = mitk::ExtractSliceFilter::New();
     extractor2->SetInput(imageOperation->GetImage());
@@ -47,6 +47,26 @@ namespace mitk
                                  unsigned int timeStep,
                                  Image::ConstPointer referenceImage) override;
 
+    /**
+      \brief Computes the signed distance map of a binary slice, negative inside and positive outside.
+
+      The distance map can be reused for all interpolations that need this slice as lower or upper slice.
+    */
+    Image::Pointer ComputeDistanceMap(const Image *binarySlice);
+
+    /**
+      \brief Interpolates the slice requestedIndex from the distance maps of the neighboring slices.
+
+      The distance maps have to be computed by ComputeDistanceMap(). resultImage is a 2D image of the geometry of
+      the requested slice, which is overwritten with the interpolation.
+    */
+    Image::Pointer InterpolateFromDistanceMaps(const Image *lowerDistanceMap,
+                                               unsigned int lowerSliceIndex,
+                                               const Image *upperDistanceMap,
+                                               unsigned int upperSliceIndex,
+                                               unsigned int requestedIndex,
+                                               Image::Pointer resultImage);
+
   private:
     typedef itk::Image<mitk::ScalarType, 2> DistanceFilterImageType;
 
@@ -55,8 +75,8 @@ namespace mitk
 
     template <typename TPixel, unsigned int VImageDimension>
     void InterpolateIntermediateSlice(itk::Image<TPixel, VImageDimension> *result,
-                                      const mitk::Image::Pointer &lowerDistanceImage,
-                                      const mitk::Image::Pointer &upperDistanceImage,
+                                      const mitk::Image *lowerDistanceImage,
+                                      const mitk::Image *upperDistanceImage,
                                       float ratio);
   };
 
@@ -14,7 +14,8 @@ found in the LICENSE file.
 
 #include "mitkImageCast.h"
 #include "mitkImageReadAccessor.h"
-#include "mitkImageTimeSelector.h"
+#include "mitkParallelFor.h"
+#include "mitkPixelTypeMultiplex.h"
 #include <mitkExtractSliceFilter.h>
 #include <mitkImageAccessByItk.h>
 //#include <mitkPlaneGeometry.h>
@@ -23,7 +24,10 @@ found in the LICENSE file.
 
 #include <itkCommand.h>
 #include <itkImage.h>
-#include <itkImageSliceConstIteratorWithIndex.h>
+#include <itkMultiThreader.h>
+
+#include <algorithm>
+#include <atomic>
 
 mitk::SegmentationInterpolationController::InterpolatorMapType
   mitk::SegmentationInterpolationController::s_InterpolatorForImage; // static member initialization
@@ -43,13 +47,24 @@ mitk::SegmentationInterpolationController *mitk::SegmentationInterpolationContro
 }
 
 mitk::SegmentationInterpolationController::SegmentationInterpolationController()
-  : m_BlockModified(false), m_2DInterpolationActivated(false)
+  : m_BlockModified(false),
+    m_2DInterpolationActivated(false),
+    m_DistanceMapAccessCounter(0),
+    m_MaximumNumberOfCachedDistanceMaps(64),
+    m_NumberOfThreads(0)
 {
 }
 
 void mitk::SegmentationInterpolationController::Activate2DInterpolation(bool status)
 {
+  const bool activated = status && !m_2DInterpolationActivated;
   m_2DInterpolationActivated = status;
+
+  // the slice counts are not updated while the interpolation is deactivated
+  if (activated && m_Segmentation.IsNotNull())
+  {
+    SetSegmentationVolume(m_Segmentation);
+  }
 }
 
 mitk::SegmentationInterpolationController *mitk::SegmentationInterpolationController::GetInstance()
@@ -93,6 +108,7 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
 {
   // clear old information (remove all time steps
   m_SegmentationCountInSlice.clear();
+  this->ClearDistanceMapCache();
 
   // delete this from the list of interpolators
   auto iter = s_InterpolatorForImage.find(segmentation);
@@ -135,14 +151,14 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
 
   // for all timesteps
   // scan whole image
+  itk::ImageRegion<3> region;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    region.SetSize(dim, m_Segmentation->GetDimension(dim));
+
   for (unsigned int timeStep = 0; timeStep < m_Segmentation->GetTimeSteps(); ++timeStep)
   {
-    ImageTimeSelector::Pointer timeSelector = ImageTimeSelector::New();
-    timeSelector->SetInput(m_Segmentation);
-    timeSelector->SetTimeNr(timeStep);
-    timeSelector->UpdateLargestPossibleRegion();
-    Image::Pointer segmentation3D = timeSelector->GetOutput();
-    AccessFixedDimensionByItk_2(segmentation3D, ScanWholeVolume, 3, m_Segmentation, timeStep);
+    mitkPixelTypeMultiplex5(
+      ScanRegion, m_Segmentation->GetPixelType(), m_Segmentation, timeStep, region, timeStep, 1);
   }
 
   // PrintStatus();
@@ -187,13 +203,43 @@ void mitk::SegmentationInterpolationController::SetChangedVolume(const Image *sl
     return;
   if (sliceDiff->GetDimension() != 3)
     return;
+  if (timeStep >= m_SegmentationCountInSlice.size())
+    return;
 
-  AccessFixedDimensionByItk_1(sliceDiff, ScanChangedVolume, 3, timeStep);
+  itk::ImageRegion<3> region;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    if (sliceDiff->GetDimension(dim) != m_SegmentationCountInSlice[timeStep][dim].size())
+      return;
+    region.SetSize(dim, sliceDiff->GetDimension(dim));
+  }
+
+  mitkPixelTypeMultiplex5(ScanRegion, sliceDiff->GetPixelType(), sliceDiff, 0, region, timeStep, 1);
 
   // PrintStatus();
   Modified();
 }
 
+void mitk::SegmentationInterpolationController::PrepareRegionChange(const itk::ImageRegion<3> &region,
+                                                                    unsigned int timeStep)
+{
+  if (!m_2DInterpolationActivated || m_Segmentation.IsNull() || timeStep >= m_SegmentationCountInSlice.size())
+    return;
+
+  mitkPixelTypeMultiplex5(ScanRegion, m_Segmentation->GetPixelType(), m_Segmentation, timeStep, region, timeStep, -1);
+}
+
+void mitk::SegmentationInterpolationController::SetChangedRegion(const itk::ImageRegion<3> &region,
+                                                                 unsigned int timeStep)
+{
+  if (!m_2DInterpolationActivated || m_Segmentation.IsNull() || timeStep >= m_SegmentationCountInSlice.size())
+    return;
+
+  mitkPixelTypeMultiplex5(ScanRegion, m_Segmentation->GetPixelType(), m_Segmentation, timeStep, region, timeStep, 1);
+
+  Modified();
+}
+
 void mitk::SegmentationInterpolationController::SetChangedSlice(const Image *sliceDiff,
                                                                 unsigned int sliceDimension,
                                                                 unsigned int sliceIndex,
@@ -264,6 +310,8 @@ void mitk::SegmentationInterpolationController::ScanChangedSlice(const itk::Imag
   unsigned int dim0max = m_SegmentationCountInSlice[timeStep][dim0].size();
   unsigned int dim1max = m_SegmentationCountInSlice[timeStep][dim1].size();
 
+  const bool invalidateDistanceMaps = !m_DistanceMapCache.empty();
+
   // scan the slice from two directions
   // and set the flags for the two dimensions of the slice
   for (unsigned int v = 0; v < dim1max; ++v)
@@ -272,6 +320,12 @@ void mitk::SegmentationInterpolationController::ScanChangedSlice(const itk::Imag
     {
       DATATYPE value = *(pixelData + u + v * dim0max);
 
+      if (invalidateDistanceMaps && value != 0)
+      {
+        this->InvalidateDistanceMap(dim0, u, timeStep);
+        this->InvalidateDistanceMap(dim1, v, timeStep);
+      }
+
       assert((signed)m_SegmentationCountInSlice[timeStep][dim0][u] + (signed)value >=
              0); // just for debugging. This must always be true, otherwise some counting is going wrong
       assert((signed)m_SegmentationCountInSlice[timeStep][dim1][v] + (signed)value >= 0);
@@ -288,85 +342,134 @@ void mitk::SegmentationInterpolationController::ScanChangedSlice(const itk::Imag
   assert((signed)m_SegmentationCountInSlice[timeStep][sliceDimension][sliceIndex] + numberOfPixels >= 0);
   m_SegmentationCountInSlice[timeStep][sliceDimension][sliceIndex] += numberOfPixels;
 
+  if (invalidateDistanceMaps && numberOfPixels != 0)
+    this->InvalidateDistanceMap(sliceDimension, sliceIndex, timeStep);
+
   // MITK_INFO << "scan t=" << timeStep << " from (0,0) to (" << dim0max << "," << dim1max << ") (" << pixelData << "-"
   // << pixelData+dim0max*dim1max-1 <<  ") in slice " << sliceIndex << " found " << numberOfPixels << " pixels" <<
   // std::endl;
 }
 
-template <typename TPixel, unsigned int VImageDimension>
-void mitk::SegmentationInterpolationController::ScanChangedVolume(const itk::Image<TPixel, VImageDimension> *diffImage,
-                                                                  unsigned int timeStep)
+template <typename DATATYPE>
+void mitk::SegmentationInterpolationController::ScanRegion(const PixelType &,
+                                                           const Image *volume,
+                                                           unsigned int volumeTimeStep,
+                                                           const itk::ImageRegion<3> &region,
+                                                           unsigned int timeStep,
+                                                           int factor)
 {
-  typedef itk::ImageSliceConstIteratorWithIndex<itk::Image<TPixel, VImageDimension>> IteratorType;
-
-  IteratorType iter(diffImage, diffImage->GetLargestPossibleRegion());
-  iter.SetFirstDirection(0);
-  iter.SetSecondDirection(1);
-
-  int numberOfPixels(0); // number of pixels in this slice that are not 0
-
-  typename IteratorType::IndexType index;
-  unsigned int x = 0;
-  unsigned int y = 0;
-  unsigned int z = 0;
+  if (!volume)
+    return;
+  if (timeStep >= m_SegmentationCountInSlice.size())
+    return;
 
-  iter.GoToBegin();
-  while (!iter.IsAtEnd())
+  itk::ImageRegion<3> volumeRegion;
+  for (unsigned int dim = 0; dim < 3; ++dim)
   {
-    while (!iter.IsAtEndOfSlice())
-    {
-      while (!iter.IsAtEndOfLine())
-      {
-        index = iter.GetIndex();
+    volumeRegion.SetSize(dim, std::min<std::size_t>(volume->GetDimension(dim),
+                                                    m_SegmentationCountInSlice[timeStep][dim].size()));
+  }
 
-        x = index[0];
-        y = index[1];
-        z = index[2];
+  itk::ImageRegion<3> scanRegion = region;
+  if (!scanRegion.Crop(volumeRegion))
+    return;
 
-        TPixel value = iter.Get();
+  ImageReadAccessor readAccess(volume, volume->GetVolumeData(volumeTimeStep));
+  const auto *rawVolume =
+    static_cast<const DATATYPE *>(readAccess.GetData()); // we again promise not to change anything, we'll just count
+
+  const std::size_t dimX = volume->GetDimension(0);
+  const std::size_t dimY = volume->GetDimension(1);
+  const auto beginX = static_cast<std::size_t>(scanRegion.GetIndex(0));
+  const auto beginY = static_cast<std::size_t>(scanRegion.GetIndex(1));
+  const auto beginZ = static_cast<std::size_t>(scanRegion.GetIndex(2));
+  const std::size_t sizeX = scanRegion.GetSize(0);
+  const std::size_t sizeY = scanRegion.GetSize(1);
+  const std::size_t sizeZ = scanRegion.GetSize(2);
+
+  // Every slab sums up the values along x and y on its own, the sums along z of different slabs are disjoint.
+  struct SlabCounts
+  {
+    std::vector<double> X;
+    std::vector<double> Y;
+    std::vector<double> Z;
+  };
+
+  const std::size_t numberOfSlabs =
+    std::min<std::size_t>(sizeZ, 4 * itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
+  if (0 == numberOfSlabs)
+    return;
 
-        assert((signed)m_SegmentationCountInSlice[timeStep][0][x] + (signed)value >=
-               0); // just for debugging. This must always be true, otherwise some counting is going wrong
-        assert((signed)m_SegmentationCountInSlice[timeStep][1][y] + (signed)value >= 0);
+  std::vector<SlabCounts> slabCounts(numberOfSlabs);
 
-        m_SegmentationCountInSlice[timeStep][0][x] =
-          static_cast<unsigned int>(m_SegmentationCountInSlice[timeStep][0][x] + value);
-        m_SegmentationCountInSlice[timeStep][1][y] =
-          static_cast<unsigned int>(m_SegmentationCountInSlice[timeStep][1][y] + value);
+  mitk::ParallelFor(0, numberOfSlabs, [&](std::size_t slab) {
+    SlabCounts &counts = slabCounts[slab];
+    counts.X.assign(sizeX, 0.);
+    counts.Y.assign(sizeY, 0.);
 
-        numberOfPixels += static_cast<int>(value);
+    const std::size_t firstZ = slab * sizeZ / numberOfSlabs;
+    const std::size_t lastZ = (slab + 1) * sizeZ / numberOfSlabs;
+    counts.Z.assign(lastZ - firstZ, 0.);
 
-        ++iter;
+    for (std::size_t z = firstZ; z < lastZ; ++z)
+    {
+      double sliceCount = 0.;
+      for (std::size_t y = 0; y < sizeY; ++y)
+      {
+        const DATATYPE *row = rawVolume + ((beginZ + z) * dimY + beginY + y) * dimX + beginX;
+
+        double rowCount = 0.;
+        for (std::size_t x = 0; x < sizeX; ++x)
+        {
+          if (row[x] != 0)
+          {
+            counts.X[x] += row[x];
+            rowCount += row[x];
+          }
+        }
+
+        counts.Y[y] += rowCount;
+        sliceCount += rowCount;
       }
-      iter.NextLine();
+      counts.Z[z - firstZ] = sliceCount;
     }
-    assert((signed)m_SegmentationCountInSlice[timeStep][2][z] + numberOfPixels >= 0);
-    m_SegmentationCountInSlice[timeStep][2][z] += numberOfPixels;
-    numberOfPixels = 0;
-
-    iter.NextSlice();
+  }, m_NumberOfThreads);
+
+  // merge the counts of the slabs
+  std::vector<double> countsX(sizeX, 0.);
+  std::vector<double> countsY(sizeY, 0.);
+  std::vector<double> countsZ;
+  countsZ.reserve(sizeZ);
+  for (const auto &counts : slabCounts)
+  {
+    for (std::size_t x = 0; x < sizeX; ++x)
+      countsX[x] += counts.X[x];
+    for (std::size_t y = 0; y < sizeY; ++y)
+      countsY[y] += counts.Y[y];
+    countsZ.insert(countsZ.end(), counts.Z.begin(), counts.Z.end());
   }
-}
-
-template <typename DATATYPE>
-void mitk::SegmentationInterpolationController::ScanWholeVolume(const itk::Image<DATATYPE, 3> *,
-                                                                const Image *volume,
-                                                                unsigned int timeStep)
-{
-  if (!volume)
-    return;
-  if (timeStep >= m_SegmentationCountInSlice.size())
-    return;
 
-  ImageReadAccessor readAccess(volume, volume->GetVolumeData(timeStep));
+  const bool invalidateDistanceMaps = !m_DistanceMapCache.empty();
+  const std::size_t begins[3] = {beginX, beginY, beginZ};
+  const std::vector<double> *regionCounts[3] = {&countsX, &countsY, &countsZ};
 
-  for (unsigned int slice = 0; slice < volume->GetDimension(2); ++slice)
+  for (unsigned int dim = 0; dim < 3; ++dim)
   {
-    const auto *rawVolume =
-      static_cast<const DATATYPE *>(readAccess.GetData()); // we again promise not to change anything, we'll just count
-    const DATATYPE *rawSlice = rawVolume + (volume->GetDimension(0) * volume->GetDimension(1) * slice);
+    DirtyVectorType &sliceCounts = m_SegmentationCountInSlice[timeStep][dim];
+    for (std::size_t i = 0; i < regionCounts[dim]->size(); ++i)
+    {
+      const double count = (*regionCounts[dim])[i];
+      if (count == 0)
+        continue;
+
+      // a negative count means that the region was changed without being reported, so the slice counts are outdated
+      const std::size_t sliceIndex = begins[dim] + i;
+      const double sliceCount = static_cast<double>(sliceCounts[sliceIndex]) + factor * count;
+      sliceCounts[sliceIndex] = static_cast<unsigned int>(std::max(0., sliceCount));
 
-    ScanChangedSlice<DATATYPE>(nullptr, SetChangedSliceOptions(2, slice, 0, 1, timeStep, rawSlice));
+      if (invalidateDistanceMaps)
+        this->InvalidateDistanceMap(dim, sliceIndex, timeStep);
+    }
   }
 }
 
@@ -429,6 +532,132 @@ void mitk::SegmentationInterpolationController::PrintStatus()
   }
 }
 
+bool mitk::SegmentationInterpolationController::FindBoundingSlices(unsigned int sliceDimension,
+                                                                   unsigned int sliceIndex,
+                                                                   unsigned int timeStep,
+                                                                   unsigned int &lowerBound,
+                                                                   unsigned int &upperBound) const
+{
+  const DirtyVectorType &counts = m_SegmentationCountInSlice[timeStep][sliceDimension];
+
+  bool bounds(false);
+  for (lowerBound = sliceIndex - 1; /*lowerBound >= 0*/; --lowerBound)
+  {
+    if (counts[lowerBound] > 0)
+    {
+      bounds = true;
+      break;
+    }
+
+    if (lowerBound == 0)
+      break; // otherwise overflow and start at something like 4294967295
+  }
+
+  if (!bounds)
+    return false;
+
+  bounds = false;
+  for (upperBound = sliceIndex + 1; upperBound < counts.size(); ++upperBound)
+  {
+    if (counts[upperBound] > 0)
+    {
+      bounds = true;
+      break;
+    }
+  }
+
+  return bounds;
+}
+
+mitk::Image::Pointer mitk::SegmentationInterpolationController::ExtractSlice(const PlaneGeometry *plane,
+                                                                             unsigned int sliceDimension,
+                                                                             unsigned int sliceIndex,
+                                                                             unsigned int timeStep) const
+{
+  // Transforming the origin of the plane so that it matches the requested slice
+  mitk::PlaneGeometry::Pointer reslicePlane = plane->Clone();
+  mitk::Point3D origin = plane->GetOrigin();
+  m_Segmentation->GetSlicedGeometry(timeStep)->WorldToIndex(origin, origin);
+  origin[sliceDimension] = sliceIndex;
+  m_Segmentation->GetSlicedGeometry(timeStep)->IndexToWorld(origin, origin);
+  reslicePlane->SetOrigin(origin);
+
+  mitk::ExtractSliceFilter::Pointer extractor = ExtractSliceFilter::New();
+  extractor->SetInput(m_Segmentation);
+  extractor->SetTimeStep(timeStep);
+  extractor->SetResliceTransformByGeometry(m_Segmentation->GetTimeGeometry()->GetGeometryForTimeStep(timeStep));
+  extractor->SetVtkOutputRequest(false);
+
+  extractor->SetWorldGeometry(reslicePlane);
+  extractor->Modified();
+  extractor->Update();
+
+  mitk::Image::Pointer slice = extractor->GetOutput();
+  if (slice.IsNotNull())
+    slice->DisconnectPipeline();
+  return slice;
+}
+
+mitk::Image::Pointer mitk::SegmentationInterpolationController::GetCachedDistanceMap(const PlaneGeometry *plane,
+                                                                                     unsigned int sliceDimension,
+                                                                                     unsigned int sliceIndex,
+                                                                                     unsigned int timeStep)
+{
+  auto iter = m_DistanceMapCache.find(std::make_tuple(timeStep, sliceDimension, sliceIndex));
+  if (iter == m_DistanceMapCache.end())
+    return nullptr;
+
+  DistanceMapCacheEntry &entry = iter->second;
+  if (!Equal(entry.RightVector, plane->GetAxisVector(0), eps) ||
+      !Equal(entry.BottomVector, plane->GetAxisVector(1), eps))
+    return nullptr;
+
+  entry.LastAccess = ++m_DistanceMapAccessCounter;
+  return entry.DistanceMap;
+}
+
+void mitk::SegmentationInterpolationController::CacheDistanceMap(const PlaneGeometry *plane,
+                                                                 unsigned int sliceDimension,
+                                                                 unsigned int sliceIndex,
+                                                                 unsigned int timeStep,
+                                                                 Image *distanceMap)
+{
+  if (0 == m_MaximumNumberOfCachedDistanceMaps || nullptr == distanceMap)
+    return;
+
+  const auto key = std::make_tuple(timeStep, sliceDimension, sliceIndex);
+
+  // drop the least recently used distance map if the cache is full
+  if (m_DistanceMapCache.size() >= m_MaximumNumberOfCachedDistanceMaps && 0 == m_DistanceMapCache.count(key))
+  {
+    auto leastRecentlyUsed = std::min_element(
+      m_DistanceMapCache.begin(),
+      m_DistanceMapCache.end(),
+      [](const DistanceMapCacheType::value_type &a, const DistanceMapCacheType::value_type &b) {
+        return a.second.LastAccess < b.second.LastAccess;
+      });
+    m_DistanceMapCache.erase(leastRecentlyUsed);
+  }
+
+  DistanceMapCacheEntry &entry = m_DistanceMapCache[key];
+  entry.RightVector = plane->GetAxisVector(0);
+  entry.BottomVector = plane->GetAxisVector(1);
+  entry.DistanceMap = distanceMap;
+  entry.LastAccess = ++m_DistanceMapAccessCounter;
+}
+
+void mitk::SegmentationInterpolationController::InvalidateDistanceMap(unsigned int sliceDimension,
+                                                                      unsigned int sliceIndex,
+                                                                      unsigned int timeStep)
+{
+  m_DistanceMapCache.erase(std::make_tuple(timeStep, sliceDimension, sliceIndex));
+}
+
+void mitk::SegmentationInterpolationController::ClearDistanceMapCache()
+{
+  m_DistanceMapCache.clear();
+}
+
 mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsigned int sliceDimension,
                                                                             unsigned int sliceIndex,
                                                                             const mitk::PlaneGeometry *currentPlane,
@@ -457,130 +686,200 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsi
 
   unsigned int lowerBound(0);
   unsigned int upperBound(0);
-  bool bounds(false);
 
-  for (lowerBound = sliceIndex - 1; /*lowerBound >= 0*/; --lowerBound)
+  if (!this->FindBoundingSlices(sliceDimension, sliceIndex, timeStep, lowerBound, upperBound))
+    return nullptr;
+
+  // ok, we have found two neighboring slices with segmentations (and we made sure that the current slice does NOT
+  // contain anything
+  // MITK_INFO << "Interpolate in timestep " << timeStep << ", dimension " << sliceDimension << ": estimate slice " <<
+  // sliceIndex << " from slices " << lowerBound << " and " << upperBound << std::endl;
+
+  // interpolation algorithm gets some inputs
+  //   two segmentations (guaranteed to be of the same data type, but no special data type guaranteed)
+  //   orientation (sliceDimension) of the segmentations
+  //   position of the two slices (sliceIndices)
+  //   one volume image (original patient image)
+  //
+  // interpolation algorithm can use e.g. itk::ImageSliceConstIteratorWithIndex to
+  //   inspect the original patient image at appropriate positions
+
+  auto algorithm = mitk::ShapeBasedInterpolationAlgorithm::New();
+
+  mitk::Image::Pointer resultImage;
+  mitk::Image::Pointer lowerDistanceMap;
+  mitk::Image::Pointer upperDistanceMap;
+
+  try
   {
-    if (m_SegmentationCountInSlice[timeStep][sliceDimension][lowerBound] > 0)
+    // Reslicing the current plane
+    resultImage = this->ExtractSlice(currentPlane, sliceDimension, sliceIndex, timeStep);
+
+    // The distance maps of the lower and upper slice are only computed if they are not cached yet
+    const unsigned int bounds[2] = {lowerBound, upperBound};
+    mitk::Image::Pointer *distanceMaps[2] = {&lowerDistanceMap, &upperDistanceMap};
+    for (unsigned int i = 0; i < 2; ++i)
     {
-      bounds = true;
-      break;
+      *distanceMaps[i] = this->GetCachedDistanceMap(currentPlane, sliceDimension, bounds[i], timeStep);
+      if (distanceMaps[i]->IsNull())
+      {
+        mitk::Image::Pointer slice = this->ExtractSlice(currentPlane, sliceDimension, bounds[i], timeStep);
+        if (slice.IsNull())
+          return nullptr;
+
+        *distanceMaps[i] = algorithm->ComputeDistanceMap(slice);
+        this->CacheDistanceMap(currentPlane, sliceDimension, bounds[i], timeStep, *distanceMaps[i]);
+      }
     }
 
-    if (lowerBound == 0)
-      break; // otherwise overflow and start at something like 4294967295
+    if (resultImage.IsNull())
+      return nullptr;
   }
-
-  if (!bounds)
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Error in 2D interpolation: " << e.what();
     return nullptr;
+  }
 
-  bounds = false;
-  for (upperBound = sliceIndex + 1; upperBound < upperLimit; ++upperBound)
+  return algorithm->InterpolateFromDistanceMaps(
+    lowerDistanceMap, lowerBound, upperDistanceMap, upperBound, sliceIndex, resultImage);
+}
+
+mitk::SegmentationInterpolationController::InterpolatedSlicesType
+  mitk::SegmentationInterpolationController::InterpolateAllSlices(unsigned int sliceDimension,
+                                                                  const mitk::PlaneGeometry *currentPlane,
+                                                                  unsigned int timeStep)
+{
+  InterpolatedSlicesType result;
+
+  if (m_Segmentation.IsNull() || !currentPlane)
+    return result;
+  if (timeStep >= m_SegmentationCountInSlice.size())
+    return result;
+  if (sliceDimension > 2)
+    return result;
+
+  const DirtyVectorType &counts = m_SegmentationCountInSlice[timeStep][sliceDimension];
+
+  // the segmented slices that enclose at least one slice without segmentation
+  std::vector<unsigned int> segmentedSlices;
+  for (unsigned int sliceIndex = 0; sliceIndex < counts.size(); ++sliceIndex)
+  {
+    if (counts[sliceIndex] > 0)
+      segmentedSlices.push_back(sliceIndex);
+  }
+
+  struct InterpolationTask
   {
-    if (m_SegmentationCountInSlice[timeStep][sliceDimension][upperBound] > 0)
+    unsigned int SliceIndex;
+    std::size_t Lower; // index into segmentedSlices
+    Image::Pointer Result;
+    bool Failed;
+  };
+
+  std::vector<InterpolationTask> tasks;
+  std::vector<bool> distanceMapNeeded(segmentedSlices.size(), false);
+  for (std::size_t i = 1; i < segmentedSlices.size(); ++i)
+  {
+    for (unsigned int sliceIndex = segmentedSlices[i - 1] + 1; sliceIndex < segmentedSlices[i]; ++sliceIndex)
     {
-      bounds = true;
-      break;
+      tasks.push_back({sliceIndex, i - 1, nullptr, false});
+      distanceMapNeeded[i - 1] = true;
+      distanceMapNeeded[i] = true;
     }
   }
 
-  if (!bounds)
-    return nullptr;
+  if (tasks.empty())
+    return result;
 
-  // ok, we have found two neighboring slices with segmentations (and we made sure that the current slice does NOT
-  // contain anything
-  // MITK_INFO << "Interpolate in timestep " << timeStep << ", dimension " << sliceDimension << ": estimate slice " <<
-  // sliceIndex << " from slices " << lowerBound << " and " << upperBound << std::endl;
+  auto algorithm = mitk::ShapeBasedInterpolationAlgorithm::New();
 
-  mitk::Image::Pointer lowerMITKSlice;
-  mitk::Image::Pointer upperMITKSlice;
-  mitk::Image::Pointer resultImage;
+  // Slices are extracted on the calling thread, the extraction shares the pipeline of the segmentation image.
+  // Distance maps and interpolations only work on the extracted slices and run in parallel.
+  std::vector<Image::Pointer> distanceMaps(segmentedSlices.size());
+  std::vector<Image::Pointer> segmentedSliceImages(segmentedSlices.size());
+  std::vector<std::size_t> missingDistanceMaps;
 
   try
   {
-    // Setting up the ExtractSliceFilter
-    mitk::ExtractSliceFilter::Pointer extractor = ExtractSliceFilter::New();
-    extractor->SetInput(m_Segmentation);
-    extractor->SetTimeStep(timeStep);
-    extractor->SetResliceTransformByGeometry(m_Segmentation->GetTimeGeometry()->GetGeometryForTimeStep(timeStep));
-    extractor->SetVtkOutputRequest(false);
+    for (std::size_t i = 0; i < segmentedSlices.size(); ++i)
+    {
+      if (!distanceMapNeeded[i])
+        continue;
 
-    // Reslicing the current plane
-    extractor->SetWorldGeometry(currentPlane);
-    extractor->Modified();
-    extractor->Update();
-    resultImage = extractor->GetOutput();
-    resultImage->DisconnectPipeline();
-
-    // Creating PlaneGeometry for lower slice
-    mitk::PlaneGeometry::Pointer reslicePlane = currentPlane->Clone();
-
-    // Transforming the current origin so that it matches the lower slice
-    mitk::Point3D origin = currentPlane->GetOrigin();
-    m_Segmentation->GetSlicedGeometry(timeStep)->WorldToIndex(origin, origin);
-    origin[sliceDimension] = lowerBound;
-    m_Segmentation->GetSlicedGeometry(timeStep)->IndexToWorld(origin, origin);
-    reslicePlane->SetOrigin(origin);
-
-    // Extract the lower slice
-    extractor = ExtractSliceFilter::New();
-    extractor->SetInput(m_Segmentation);
-    extractor->SetTimeStep(timeStep);
-    extractor->SetResliceTransformByGeometry(m_Segmentation->GetTimeGeometry()->GetGeometryForTimeStep(timeStep));
-    extractor->SetVtkOutputRequest(false);
-
-    extractor->SetWorldGeometry(reslicePlane);
-    extractor->Modified();
-    extractor->Update();
-    lowerMITKSlice = extractor->GetOutput();
-    lowerMITKSlice->DisconnectPipeline();
-
-    // Transforming the current origin so that it matches the upper slice
-    m_Segmentation->GetSlicedGeometry(timeStep)->WorldToIndex(origin, origin);
-    origin[sliceDimension] = upperBound;
-    m_Segmentation->GetSlicedGeometry(timeStep)->IndexToWorld(origin, origin);
-    reslicePlane->SetOrigin(origin);
-
-    // Extract the upper slice
-    extractor = ExtractSliceFilter::New();
-    extractor->SetInput(m_Segmentation);
-    extractor->SetTimeStep(timeStep);
-    extractor->SetResliceTransformByGeometry(m_Segmentation->GetTimeGeometry()->GetGeometryForTimeStep(timeStep));
-    extractor->SetVtkOutputRequest(false);
-
-    extractor->SetWorldGeometry(reslicePlane);
-    extractor->Modified();
-    extractor->Update();
-    upperMITKSlice = extractor->GetOutput();
-    upperMITKSlice->DisconnectPipeline();
-
-    if (lowerMITKSlice.IsNull() || upperMITKSlice.IsNull())
-      return nullptr;
+      distanceMaps[i] = this->GetCachedDistanceMap(currentPlane, sliceDimension, segmentedSlices[i], timeStep);
+      if (distanceMaps[i].IsNull())
+      {
+        segmentedSliceImages[i] = this->ExtractSlice(currentPlane, sliceDimension, segmentedSlices[i], timeStep);
+        if (segmentedSliceImages[i].IsNull())
+          return result;
+        missingDistanceMaps.push_back(i);
+      }
+    }
+
+    for (auto &task : tasks)
+    {
+      task.Result = this->ExtractSlice(currentPlane, sliceDimension, task.SliceIndex, timeStep);
+    }
   }
   catch (const std::exception &e)
   {
     MITK_ERROR << "Error in 2D interpolation: " << e.what();
-    return nullptr;
+    return result;
   }
 
-  // interpolation algorithm gets some inputs
-  //   two segmentations (guaranteed to be of the same data type, but no special data type guaranteed)
-  //   orientation (sliceDimension) of the segmentations
-  //   position of the two slices (sliceIndices)
-  //   one volume image (original patient image)
-  //
-  // interpolation algorithm can use e.g. itk::ImageSliceConstIteratorWithIndex to
-  //   inspect the original patient image at appropriate positions
+  std::atomic<bool> distanceMapFailed(false);
+  mitk::ParallelFor(0, missingDistanceMaps.size(), [&](std::size_t i) {
+    const auto index = missingDistanceMaps[i];
+    try
+    {
+      distanceMaps[index] = algorithm->ComputeDistanceMap(segmentedSliceImages[index]);
+    }
+    catch (const std::exception &e)
+    {
+      MITK_ERROR << "Error in 2D interpolation: " << e.what();
+      distanceMapFailed = true;
+    }
+    segmentedSliceImages[index] = nullptr;
+  }, m_NumberOfThreads);
+
+  if (distanceMapFailed)
+    return result;
+
+  for (auto index : missingDistanceMaps)
+  {
+    this->CacheDistanceMap(currentPlane, sliceDimension, segmentedSlices[index], timeStep, distanceMaps[index]);
+  }
+
+  mitk::ParallelFor(0, tasks.size(), [&](std::size_t i) {
+    InterpolationTask &task = tasks[i];
+    if (task.Result.IsNull())
+    {
+      task.Failed = true;
+      return;
+    }
+
+    try
+    {
+      algorithm->InterpolateFromDistanceMaps(distanceMaps[task.Lower],
+                                             segmentedSlices[task.Lower],
+                                             distanceMaps[task.Lower + 1],
+                                             segmentedSlices[task.Lower + 1],
+                                             task.SliceIndex,
+                                             task.Result);
+    }
+    catch (const std::exception &e)
+    {
+      MITK_ERROR << "Error in 2D interpolation: " << e.what();
+      task.Failed = true;
+    }
+  }, m_NumberOfThreads);
+
+  for (const auto &task : tasks)
+  {
+    if (!task.Failed)
+      result[task.SliceIndex] = task.Result;
+  }
 
-  mitk::SegmentationInterpolationAlgorithm::Pointer algorithm =
-    mitk::ShapeBasedInterpolationAlgorithm::New().GetPointer();
-  return algorithm->Interpolate(lowerMITKSlice.GetPointer(),
-                                lowerBound,
-                                upperMITKSlice.GetPointer(),
-                                upperBound,
-                                sliceIndex,
-                                sliceDimension,
-                                resultImage,
-                                timeStep,
-                                m_ReferenceImage);
+  return result;
 }
@@ -18,9 +18,11 @@ found in the LICENSE file.
 #include <MitkSegmentationExports.h>
 
 #include <itkImage.h>
+#include <itkImageRegion.h>
 #include <itkObjectFactory.h>
 
 #include <map>
+#include <tuple>
 #include <vector>
 
 namespace mitk
@@ -57,6 +59,15 @@ namespace mitk
     each dimension).
     Each item describes one image dimension, each vector item holds the count of pixels in "its" slice.
 
+    Tools that write directly into the segmentation volume can report the written region with
+    PrepareRegionChange() and SetChangedRegion(). Only this region is scanned then, before and after the change. All
+    scans work on the image buffer directly and are split into slabs that are scanned in parallel.
+
+    The distance maps of segmented slices, which the shape-based interpolation computes from them, are cached until
+    the slice changes. Repeated previews of slices between the same segmented slices thus only compute the
+    interpolation itself. InterpolateAllSlices() computes all interpolations of one orientation at once and runs the
+    distance map computation and the interpolations on several threads.
+
     $Author$
   */
   class MITKSEGMENTATION_EXPORT SegmentationInterpolationController : public itk::Object
@@ -123,6 +134,28 @@ namespace mitk
                          unsigned int timeStep);
     void SetChangedVolume(const Image *sliceDiff, unsigned int timeStep);
 
+    /**
+      \brief Prepare a direct change of a region of the segmentation.
+
+      Removes the pixels of the region from the slice counts. After the region has been written, call
+      SetChangedRegion() with the same region to add the new pixels. Together, both calls replace the scan of the
+      whole volume that would be triggered by the Modified() event of the segmentation, so block the reaction to this
+      event with BlockModified().
+
+      Like the reaction to the Modified() event, both calls do nothing while the 2D interpolation is deactivated. The
+      whole volume is scanned again when it is activated.
+
+      \param region The region in index coordinates of the segmentation volume
+
+      \param timeStep Which time step is changed
+    */
+    void PrepareRegionChange(const itk::ImageRegion<3> &region, unsigned int timeStep);
+
+    /**
+      \brief Update after a direct change of a region of the segmentation, see PrepareRegionChange().
+    */
+    void SetChangedRegion(const itk::ImageRegion<3> &region, unsigned int timeStep);
+
     /**
       \brief Generates an interpolated image for the given slice.
 
@@ -139,10 +172,48 @@ namespace mitk
                                const mitk::PlaneGeometry *currentPlane,
                                unsigned int timeStep);
 
+    typedef std::map<unsigned int, Image::Pointer> InterpolatedSlicesType;
+
+    /**
+      \brief Generates the interpolations of all slices of one orientation that lie between segmented slices.
+
+      The result is the same as calling Interpolate() for every slice index, but the distance maps of the segmented
+      slices are computed only once and the slices are interpolated in parallel.
+
+      \param sliceDimension Number of the dimension which is constant for all pixels of the meant slices.
+
+      \param currentPlane Any plane of the orientation, its position is ignored
+
+      \param timeStep Which time step to use
+
+      \return the interpolated slices by slice index
+    */
+    InterpolatedSlicesType InterpolateAllSlices(unsigned int sliceDimension,
+                                                const mitk::PlaneGeometry *currentPlane,
+                                                unsigned int timeStep);
+
+    /**
+      \brief Number of threads used by InterpolateAllSlices(). 0 (default) uses the default number of threads of ITK.
+    */
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetConstMacro(NumberOfThreads, unsigned int);
+
+    /**
+      \brief Maximum number of distance maps of segmented slices that are kept for later interpolations.
+    */
+    itkSetMacro(MaximumNumberOfCachedDistanceMaps, unsigned int);
+    itkGetConstMacro(MaximumNumberOfCachedDistanceMaps, unsigned int);
+
+    /**
+      \brief Removes all cached distance maps.
+    */
+    void ClearDistanceMapCache();
+
     void OnImageModified(const itk::EventObject &);
 
     /**
-     * Activate/Deactivate the 2D interpolation.
+     * Activate/Deactivate the 2D interpolation. Activating it scans the whole segmentation, since the slice counts
+     * are not updated while it is deactivated.
     */
     void Activate2DInterpolation(bool);
 
@@ -178,6 +249,20 @@ namespace mitk
     typedef std::vector<std::vector<DirtyVectorType>> TimeResolvedDirtyVectorType;
     typedef std::map<const Image *, SegmentationInterpolationController *> InterpolatorMapType;
 
+    /// time step, slice dimension and slice index of a cached distance map
+    typedef std::tuple<unsigned int, unsigned int, unsigned int> DistanceMapKeyType;
+
+    struct DistanceMapCacheEntry
+    {
+      /// axes of the plane the slice was extracted with, other orientations need another distance map
+      Vector3D RightVector;
+      Vector3D BottomVector;
+      Image::Pointer DistanceMap;
+      unsigned long LastAccess;
+    };
+
+    typedef std::map<DistanceMapKeyType, DistanceMapCacheEntry> DistanceMapCacheType;
+
     SegmentationInterpolationController(); // purposely hidden
     ~SegmentationInterpolationController() override;
 
@@ -185,14 +270,50 @@ namespace mitk
     template <typename DATATYPE>
     void ScanChangedSlice(const itk::Image<DATATYPE, 2> *, const SetChangedSliceOptions &options);
 
-    template <typename TPixel, unsigned int VImageDimension>
-    void ScanChangedVolume(const itk::Image<TPixel, VImageDimension> *, unsigned int timeStep);
+    /**
+      \brief Adds the pixel values of a region of a volume multiplied by factor to the counts of time step timeStep.
 
+      \param volume 3D or 3D+t image, either the segmentation or a difference image of it
+      \param volumeTimeStep Time step of volume that is scanned
+    */
     template <typename DATATYPE>
-    void ScanWholeVolume(const itk::Image<DATATYPE, 3> *, const Image *volume, unsigned int timeStep);
+    void ScanRegion(const PixelType &,
+                    const Image *volume,
+                    unsigned int volumeTimeStep,
+                    const itk::ImageRegion<3> &region,
+                    unsigned int timeStep,
+                    int factor);
 
     void PrintStatus();
 
+    /// finds the next segmented slices below and above sliceIndex, returns false if there is none on either side
+    bool FindBoundingSlices(unsigned int sliceDimension,
+                            unsigned int sliceIndex,
+                            unsigned int timeStep,
+                            unsigned int &lowerBound,
+                            unsigned int &upperBound) const;
+
+    /// extracts the slice sliceIndex with the orientation of plane
+    Image::Pointer ExtractSlice(const PlaneGeometry *plane,
+                                unsigned int sliceDimension,
+                                unsigned int sliceIndex,
+                                unsigned int timeStep) const;
+
+    /// returns the cached distance map of a slice or nullptr if there is none for the orientation of plane
+    Image::Pointer GetCachedDistanceMap(const PlaneGeometry *plane,
+                                        unsigned int sliceDimension,
+                                        unsigned int sliceIndex,
+                                        unsigned int timeStep);
+
+    void CacheDistanceMap(const PlaneGeometry *plane,
+                          unsigned int sliceDimension,
+                          unsigned int sliceIndex,
+                          unsigned int timeStep,
+                          Image *distanceMap);
+
+    /// removes the distance map of a changed slice from the cache
+    void InvalidateDistanceMap(unsigned int sliceDimension, unsigned int sliceIndex, unsigned int timeStep);
+
     /**
       An array of flags. One for each dimension of the image. A flag is set, when a slice in a certain dimension
       has at least one pixel that is not 0 (which would mean that it has to be considered by the interpolation
@@ -210,6 +331,11 @@ namespace mitk
     Image::ConstPointer m_ReferenceImage;
     bool m_BlockModified;
     bool m_2DInterpolationActivated;
+
+    DistanceMapCacheType m_DistanceMapCache;
+    unsigned long m_DistanceMapAccessCounter;
+    unsigned int m_MaximumNumberOfCachedDistanceMaps;
+    unsigned int m_NumberOfThreads;
   };
 
 } // namespace
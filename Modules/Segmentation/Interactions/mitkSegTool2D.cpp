@@ -27,6 +27,7 @@ found in the LICENSE file.
 // Includes for 3DSurfaceInterpolation
 #include "mitkImageTimeSelector.h"
 #include "mitkImageToContourFilter.h"
+#include "mitkSegmentationInterpolationController.h"
 #include "mitkSurfaceInterpolationController.h"
 
 // includes for resling and overwriting
@@ -46,8 +47,58 @@ found in the LICENSE file.
 
 #include "itkImageRegionIterator.h"
 
+#include <algorithm>
+#include <cmath>
+
 #define ROUND(a) ((a) > 0 ? (int)((a) + 0.5) : -(int)(0.5 - (a)))
 
+namespace
+{
+  // Index region of the image that contains all voxels a slice of the given plane can be written to. The corners
+  // of the plane are enlarged by one voxel, which covers the interpolation of the reslicer for oblique planes.
+  mitk::LabelSetImage::LabelRegionType GetAffectedRegion(const mitk::Image *image,
+                                                         const mitk::PlaneGeometry *plane,
+                                                         mitk::TimeStepType timeStep)
+  {
+    const mitk::BaseGeometry *imageGeometry = image->GetGeometry(timeStep);
+
+    mitk::Point3D lower;
+    mitk::Point3D upper;
+    lower.Fill(0);
+    upper.Fill(0);
+    for (int corner = 0; corner < 8; ++corner)
+    {
+      mitk::Point3D index;
+      imageGeometry->WorldToIndex(plane->GetCornerPoint(corner), index);
+
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        lower[i] = 0 == corner ? index[i] : std::min(lower[i], index[i]);
+        upper[i] = 0 == corner ? index[i] : std::max(upper[i], index[i]);
+      }
+    }
+
+    mitk::LabelSetImage::LabelRegionType region;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      const auto first = static_cast<itk::IndexValueType>(std::floor(lower[i])) - 1;
+      const auto last = static_cast<itk::IndexValueType>(std::ceil(upper[i])) + 1;
+      region.SetIndex(i, first);
+      region.SetSize(i, static_cast<itk::SizeValueType>(last - first + 1));
+    }
+
+    // an empty region is returned if the plane does not intersect the image
+    mitk::LabelSetImage::LabelRegionType imageRegion;
+    for (unsigned int i = 0; i < 3; ++i)
+      imageRegion.SetSize(i, image->GetDimension(i));
+
+    if (!region.Crop(imageRegion))
+      return mitk::LabelSetImage::LabelRegionType();
+
+    return region;
+  }
+}
+
 bool mitk::SegTool2D::m_SurfaceInterpolationEnabled = true;
 
 mitk::SegTool2D::SliceInformation::SliceInformation(const mitk::Image* aSlice, const mitk::PlaneGeometry* aPlane, mitk::TimeStepType aTimestep) :
@@ -556,20 +607,20 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
     mitkThrow() << "Cannot write slice to working node. Working node does not contain an image.";
   }
 
-  DiffSliceOperation* undoOperation = nullptr;
+  mitk::Image::Pointer originalSlice;
+
+  // the slice interpolation only rescans the written region instead of the whole volume
+  auto *interpolator = SegmentationInterpolationController::InterpolatorForImage(workingImage);
+  const auto affectedRegion = GetAffectedRegion(workingImage, sliceInfo.plane, sliceInfo.timestep);
+  if (nullptr != interpolator)
+  {
+    interpolator->PrepareRegionChange(affectedRegion, sliceInfo.timestep);
+  }
 
   if (allowUndo)
   {
-    /*============= BEGIN undo/redo feature block ========================*/
-    // Create undo operation by caching the not yet modified slices
-    mitk::Image::Pointer originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
-    undoOperation =
-      new DiffSliceOperation(workingImage,
-        originalSlice,
-        dynamic_cast<SlicedGeometry3D*>(originalSlice->GetGeometry()),
-        sliceInfo.timestep,
-        sliceInfo.plane);
-    /*============= END undo/redo feature block ========================*/
+    // keep the not yet modified slice, the undo operation only stores its difference to the written slice
+    originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
   }
 
   // Make sure that for reslicing and overwriting the same alogrithm is used. We can specify the mode of the vtk
@@ -598,17 +649,50 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
   extractor->Modified();
   extractor->Update();
 
+  if (nullptr != interpolator)
+  {
+    interpolator->BlockModified(true);
+  }
+
   // the image was modified within the pipeline, but not marked so
-  workingImage->Modified();
+  auto *labelSetImage = dynamic_cast<LabelSetImage *>(workingImage);
+  if (nullptr != labelSetImage)
+  {
+    // only the written slice has to be scanned to keep the label regions up to date
+    labelSetImage->UpdateLabelRegions(affectedRegion);
+  }
+  else
+  {
+    workingImage->Modified();
+  }
   workingImage->GetVtkImageData()->Modified();
 
+  if (nullptr != interpolator)
+  {
+    interpolator->SetChangedRegion(affectedRegion, sliceInfo.timestep);
+    interpolator->BlockModified(false);
+  }
+
   if (allowUndo)
   {
     /*============= BEGIN undo/redo feature block ========================*/
-    // specify the redo operation with the edited slice
+    // the output of the overwrite filter is the slice as it was written into the volume
+    mitk::Image::Pointer writtenSlice = extractor->GetOutput();
+
+    // Create undo operation by caching the pixels of the not yet modified slice that have been changed
+    auto* undoOperation =
+      new DiffSliceOperation(workingImage,
+        originalSlice,
+        writtenSlice,
+        dynamic_cast<SlicedGeometry3D*>(originalSlice->GetGeometry()),
+        sliceInfo.timestep,
+        sliceInfo.plane);
+
+    // specify the redo operation with the changed pixels of the edited slice
     auto* doOperation =
       new DiffSliceOperation(workingImage,
-        extractor->GetOutput(),
+        writtenSlice,
+        originalSlice,
         dynamic_cast<SlicedGeometry3D*>(sliceInfo.slice->GetGeometry()),
         sliceInfo.timestep,
         sliceInfo.plane);
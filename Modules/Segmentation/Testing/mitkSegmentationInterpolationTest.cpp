@@ -19,18 +19,23 @@ found in the LICENSE file.
 #include <mitkIOUtil.h>
 #include <mitkImage.h>
 #include <mitkImagePixelReadAccessor.h>
+#include <mitkImageReadAccessor.h>
 #include <mitkImagePixelWriteAccessor.h>
 #include <mitkSegmentationInterpolationController.h>
 #include <mitkSliceNavigationController.h>
 #include <mitkTool.h>
 #include <mitkVtkImageOverwrite.h>
 
+#include <cstring>
+
 class mitkSegmentationInterpolationTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkSegmentationInterpolationTestSuite);
   MITK_TEST(Equal_Axial_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Frontal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Sagittal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
+  MITK_TEST(Equal_InterpolateAllSlicesAndSingleInterpolations_ReturnsTrue);
+  MITK_TEST(Equal_ChangedRegionAndWholeVolumeScan_ReturnsTrue);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -144,6 +149,47 @@ private:
     }
   }
 
+  static bool EqualPixels(const mitk::Image *image1, const mitk::Image *image2)
+  {
+    if (image1->GetDimension(0) != image2->GetDimension(0) || image1->GetDimension(1) != image2->GetDimension(1))
+      return false;
+
+    mitk::ImageReadAccessor accessor1(image1);
+    mitk::ImageReadAccessor accessor2(image2);
+    const std::size_t size =
+      image1->GetPixelType().GetSize() * image1->GetDimension(0) * image1->GetDimension(1);
+    return 0 == std::memcmp(accessor1.GetData(), accessor2.GetData(), size);
+  }
+
+  /** Fills a square of an axial slice and reports the change as changed region to the interpolation controller */
+  void FillAxialSquare(int sliceOffset, int radius, mitk::Tool::DefaultSegmentationDataType value)
+  {
+    itk::ImageRegion<3> region;
+    region.SetIndex(0, m_CenterPoint[0] - radius);
+    region.SetIndex(1, m_CenterPoint[1] - radius);
+    region.SetIndex(2, m_CenterPoint[2] + sliceOffset);
+    region.SetSize(0, 2 * radius + 1);
+    region.SetSize(1, 2 * radius + 1);
+    region.SetSize(2, 1);
+
+    m_InterpolationController->PrepareRegionChange(region, 0);
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Tool::DefaultSegmentationDataType, 3> writeAccessor(m_SegmentationImage);
+      for (int i = -radius; i <= radius; ++i)
+      {
+        for (int j = -radius; j <= radius; ++j)
+        {
+          itk::Index<3> currentPoint = m_CenterPoint;
+          currentPoint[0] += i;
+          currentPoint[1] += j;
+          currentPoint[2] += sliceOffset;
+          writeAccessor.SetPixelByIndexSafe(currentPoint, value);
+        }
+      }
+    }
+    m_InterpolationController->SetChangedRegion(region, 0);
+  }
+
   mitk::Image::Pointer m_ReferenceImage;
   mitk::Image::Pointer m_SegmentationImage;
   itk::Index<3> m_CenterPoint;
@@ -177,6 +223,7 @@ public:
 
   void tearDown() override
   {
+    m_InterpolationController->Activate2DInterpolation(false);
     m_ReferenceImage = nullptr;
     m_SegmentationImage = nullptr;
     m_CenterPoint = {{0, 0, 0}};
@@ -199,6 +246,111 @@ public:
     mitk::SliceNavigationController::ViewDirection viewDirection = mitk::SliceNavigationController::Sagittal;
     testRoutine(viewDirection);
   }
+
+  void Equal_InterpolateAllSlicesAndSingleInterpolations_ReturnsTrue()
+  {
+    // three segmented axial slices with two gaps between them
+    const int dim = 2;
+    const int segmentedSlices[3] = {-3, 3, 6};
+    const int radius[3] = {4, 1, 3};
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Tool::DefaultSegmentationDataType, 3> writeAccessor(m_SegmentationImage);
+      itk::Index<3> currentPoint;
+      for (unsigned int slice = 0; slice < 3; ++slice)
+      {
+        currentPoint[dim] = m_CenterPoint[dim] + segmentedSlices[slice];
+        for (int i = -radius[slice]; i <= radius[slice]; ++i)
+        {
+          for (int j = -radius[slice]; j <= radius[slice]; ++j)
+          {
+            currentPoint[0] = m_CenterPoint[0] + i;
+            currentPoint[1] = m_CenterPoint[1] + j;
+            writeAccessor.SetPixelByIndexSafe(currentPoint, 1);
+          }
+        }
+      }
+    }
+
+    m_InterpolationController->SetSegmentationVolume(m_SegmentationImage);
+    m_InterpolationController->SetReferenceVolume(m_ReferenceImage);
+
+    mitk::SliceNavigationController::Pointer navigationController = mitk::SliceNavigationController::New();
+    navigationController->SetInputWorldTimeGeometry(m_SegmentationImage->GetTimeGeometry());
+    navigationController->Update(mitk::SliceNavigationController::Axial);
+
+    mitk::Point3D pointMM;
+    m_SegmentationImage->GetTimeGeometry()->GetGeometryForTimeStep(0)->IndexToWorld(m_CenterPoint, pointMM);
+    navigationController->SelectSliceByPoint(pointMM);
+
+    const auto interpolations =
+      m_InterpolationController->InterpolateAllSlices(dim, navigationController->GetCurrentPlaneGeometry(), 0);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(7), interpolations.size());
+
+    for (const auto &interpolation : interpolations)
+    {
+      const int offset = static_cast<int>(interpolation.first) - static_cast<int>(m_CenterPoint[dim]);
+      CPPUNIT_ASSERT_MESSAGE("Interpolated a segmented slice or a slice outside the gaps.",
+                             offset > -3 && offset < 6 && offset != 3);
+
+      itk::Index<3> slicePoint = m_CenterPoint;
+      slicePoint[dim] = interpolation.first;
+      m_SegmentationImage->GetTimeGeometry()->GetGeometryForTimeStep(0)->IndexToWorld(slicePoint, pointMM);
+      navigationController->SelectSliceByPoint(pointMM);
+
+      mitk::Image::Pointer singleInterpolation = m_InterpolationController->Interpolate(
+        dim, interpolation.first, navigationController->GetCurrentPlaneGeometry(), 0);
+
+      CPPUNIT_ASSERT(singleInterpolation.IsNotNull());
+      CPPUNIT_ASSERT_MESSAGE("Batch interpolation differs from single interpolation.",
+                             EqualPixels(singleInterpolation, interpolation.second));
+    }
+  }
+
+  void Equal_ChangedRegionAndWholeVolumeScan_ReturnsTrue()
+  {
+    m_InterpolationController->SetSegmentationVolume(m_SegmentationImage);
+    m_InterpolationController->Activate2DInterpolation(true);
+
+    FillAxialSquare(-1, 1, 1);
+    FillAxialSquare(1, 0, 1);
+    FillAxialSquare(4, 2, 1);
+
+    mitk::SliceNavigationController::Pointer navigationController = mitk::SliceNavigationController::New();
+    navigationController->SetInputWorldTimeGeometry(m_SegmentationImage->GetTimeGeometry());
+    navigationController->Update(mitk::SliceNavigationController::Axial);
+    mitk::Point3D pointMM;
+    m_SegmentationImage->GetTimeGeometry()->GetGeometryForTimeStep(0)->IndexToWorld(m_CenterPoint, pointMM);
+    navigationController->SelectSliceByPoint(pointMM);
+    auto plane = navigationController->GetCurrentPlaneGeometry();
+
+    // a controller that scans the whole volume has to come to the same result
+    auto scanningController = mitk::SegmentationInterpolationController::New();
+    scanningController->SetSegmentationVolume(m_SegmentationImage);
+
+    mitk::Image::Pointer interpolation = m_InterpolationController->Interpolate(2, m_CenterPoint[2], plane, 0);
+    mitk::Image::Pointer referenceInterpolation = scanningController->Interpolate(2, m_CenterPoint[2], plane, 0);
+    CPPUNIT_ASSERT(interpolation.IsNotNull());
+    CPPUNIT_ASSERT(referenceInterpolation.IsNotNull());
+    CPPUNIT_ASSERT(EqualPixels(interpolation, referenceInterpolation));
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3),
+                         m_InterpolationController->InterpolateAllSlices(2, plane, 0).size());
+
+    // erasing the upper slice leaves nothing to interpolate around the center
+    FillAxialSquare(1, 0, 0);
+    CPPUNIT_ASSERT(m_InterpolationController->Interpolate(2, m_CenterPoint[2], plane, 0).IsNotNull());
+    FillAxialSquare(4, 2, 0);
+    CPPUNIT_ASSERT(m_InterpolationController->Interpolate(2, m_CenterPoint[2], plane, 0).IsNull());
+
+    // changes while the interpolation is deactivated are picked up when it is activated again
+    m_InterpolationController->Activate2DInterpolation(false);
+    FillAxialSquare(1, 0, 1);
+    FillAxialSquare(-1, 1, 0);
+    m_InterpolationController->Activate2DInterpolation(true);
+    FillAxialSquare(-1, 1, 1);
+    CPPUNIT_ASSERT(m_InterpolationController->Interpolate(2, m_CenterPoint[2], plane, 0).IsNotNull());
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkSegmentationInterpolation)
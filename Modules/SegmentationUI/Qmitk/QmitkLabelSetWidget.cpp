@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include <mitkCoreObjectFactory.h>
 #include <mitkIOUtil.h>
 #include <mitkLabelSetImage.h>
+#include <mitkLabelSetImageToSurfaceFilter.h>
 #include <mitkLabelSetImageToSurfaceThreadedFilter.h>
 #include <mitkRenderingManager.h>
 #include <mitkShowSegmentationAsSurface.h>
@@ -50,7 +51,12 @@ found in the LICENSE file.
 //#include <berryIPreferencesService.h>
 
 QmitkLabelSetWidget::QmitkLabelSetWidget(QWidget *parent)
-  : QWidget(parent), m_DataStorage(nullptr), m_Completer(nullptr), m_ToolManager(nullptr)
+  : QWidget(parent),
+    m_DataStorage(nullptr),
+    m_Completer(nullptr),
+    m_ToolManager(nullptr),
+    m_SmoothedSurfaceFilter(mitk::LabelSetImageToSurfaceFilter::New()),
+    m_DetailedSurfaceFilter(mitk::LabelSetImageToSurfaceFilter::New())
 {
   m_Controls.setupUi(this);
 
@@ -191,6 +197,13 @@ void QmitkLabelSetWidget::OnTableViewContextMenuRequested(const QPoint & /*pos*/
     QObject::connect(tmp1, SIGNAL(triggered(bool)), this, SLOT(OnCreateDetailedSurface(bool)));
     QObject::connect(tmp2, SIGNAL(triggered(bool)), this, SLOT(OnCreateSmoothedSurface(bool)));
 
+    createSurfaceAction->menu()->addSeparator();
+    QAction *tmp3 = createSurfaceAction->menu()->addAction(QString("Detailed, all labels"));
+    QAction *tmp4 = createSurfaceAction->menu()->addAction(QString("Smoothed, all labels"));
+
+    QObject::connect(tmp3, SIGNAL(triggered(bool)), this, SLOT(OnCreateDetailedSurfacesOfAllLabels(bool)));
+    QObject::connect(tmp4, SIGNAL(triggered(bool)), this, SLOT(OnCreateSmoothedSurfacesOfAllLabels(bool)));
+
     menu->addAction(createSurfaceAction);
 
     QAction *createMaskAction = new QAction(QIcon(":/Qmitk/CreateMask.png"), "Create mask", this);
@@ -331,7 +344,7 @@ void QmitkLabelSetWidget::OnEraseLabel(bool /*value*/)
   if (answerButton == QMessageBox::Yes)
   {
     this->WaitCursorOn();
-    GetWorkingImage()->EraseLabel(pixelValue);
+    GetWorkingImage()->EraseLabel(pixelValue, GetWorkingImage()->GetActiveLayer());
     this->WaitCursorOff();
     mitk::RenderingManager::GetInstance()->RequestUpdateAll();
   }
@@ -352,7 +365,7 @@ void QmitkLabelSetWidget::OnRemoveLabel(bool /*value*/)
   {
     this->WaitCursorOn();
     GetWorkingImage()->GetActiveLabelSet()->RemoveLabel(pixelValue);
-    GetWorkingImage()->EraseLabel(pixelValue);
+    GetWorkingImage()->EraseLabel(pixelValue, GetWorkingImage()->GetActiveLayer());
     this->WaitCursorOff();
   }
 
@@ -1166,6 +1179,7 @@ void QmitkLabelSetWidget::OnCreateSmoothedSurface(bool /*triggered*/)
   surfaceFilter->SetPointerParameter("Input", workingImage);
   surfaceFilter->SetParameter("RequestedLabel", pixelValue);
   surfaceFilter->SetParameter("Smooth", true);
+  surfaceFilter->SetPointerParameter("SurfaceFilter", m_SmoothedSurfaceFilter);
   surfaceFilter->SetDataStorage(*m_DataStorage);
 
   mitk::StatusBar::GetInstance()->DisplayText("Surface creation is running in background...");
@@ -1208,6 +1222,7 @@ void QmitkLabelSetWidget::OnCreateDetailedSurface(bool /*triggered*/)
   surfaceFilter->SetPointerParameter("Input", workingImage);
   surfaceFilter->SetParameter("RequestedLabel", pixelValue);
   surfaceFilter->SetParameter("Smooth", false);
+  surfaceFilter->SetPointerParameter("SurfaceFilter", m_DetailedSurfaceFilter);
   surfaceFilter->SetDataStorage(*m_DataStorage);
 
   mitk::StatusBar::GetInstance()->DisplayText("Surface creation is running in background...");
@@ -1225,6 +1240,57 @@ void QmitkLabelSetWidget::OnCreateDetailedSurface(bool /*triggered*/)
   }
 }
 
+void QmitkLabelSetWidget::OnCreateDetailedSurfacesOfAllLabels(bool /*triggered*/)
+{
+  this->CreateSurfacesOfAllLabels(false);
+}
+
+void QmitkLabelSetWidget::OnCreateSmoothedSurfacesOfAllLabels(bool /*triggered*/)
+{
+  this->CreateSurfacesOfAllLabels(true);
+}
+
+void QmitkLabelSetWidget::CreateSurfacesOfAllLabels(bool smooth)
+{
+  m_ToolManager->ActivateTool(-1);
+
+  mitk::DataNode::Pointer workingNode = GetWorkingNode();
+  mitk::LabelSetImage *workingImage = GetWorkingImage();
+
+  mitk::LabelSetImageToSurfaceThreadedFilter::Pointer surfaceFilter = mitk::LabelSetImageToSurfaceThreadedFilter::New();
+
+  itk::SimpleMemberCommand<QmitkLabelSetWidget>::Pointer successCommand =
+    itk::SimpleMemberCommand<QmitkLabelSetWidget>::New();
+  successCommand->SetCallbackFunction(this, &QmitkLabelSetWidget::OnThreadedCalculationDone);
+  surfaceFilter->AddObserver(mitk::ResultAvailable(), successCommand);
+
+  itk::SimpleMemberCommand<QmitkLabelSetWidget>::Pointer errorCommand =
+    itk::SimpleMemberCommand<QmitkLabelSetWidget>::New();
+  errorCommand->SetCallbackFunction(this, &QmitkLabelSetWidget::OnThreadedCalculationDone);
+  surfaceFilter->AddObserver(mitk::ProcessingError(), errorCommand);
+
+  mitk::DataNode::Pointer groupNode = workingNode;
+  surfaceFilter->SetPointerParameter("Group node", groupNode);
+  surfaceFilter->SetPointerParameter("Input", workingImage);
+  surfaceFilter->SetParameter("AllLabels", true);
+  surfaceFilter->SetParameter("Smooth", smooth);
+  surfaceFilter->SetDataStorage(*m_DataStorage);
+
+  mitk::StatusBar::GetInstance()->DisplayText("Surface creation is running in background...");
+
+  try
+  {
+    surfaceFilter->StartAlgorithm();
+  }
+  catch (mitk::Exception &e)
+  {
+    MITK_ERROR << "Exception caught: " << e.GetDescription();
+    QMessageBox::information(this,
+                             "Create Surface",
+                             "Could not create surface meshes out of the labels. See error log for details.\n");
+  }
+}
+
 void QmitkLabelSetWidget::OnImportLabeledImage()
 {
   /*
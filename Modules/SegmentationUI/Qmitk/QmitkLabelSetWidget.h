@@ -20,12 +20,15 @@ found in the LICENSE file.
 #include "mitkNumericTypes.h"
 #include <ui_QmitkLabelSetWidgetControls.h>
 
+#include <itkSmartPointer.h>
+
 class QmitkDataStorageComboBox;
 class QCompleter;
 
 namespace mitk
 {
   class LabelSetImage;
+  class LabelSetImageToSurfaceFilter;
   class LabelSet;
   class Label;
   class DataStorage;
@@ -106,6 +109,8 @@ private slots:
   // LabelSetImage Dependet
   void OnCreateDetailedSurface(bool);
   void OnCreateSmoothedSurface(bool);
+  void OnCreateDetailedSurfacesOfAllLabels(bool);
+  void OnCreateSmoothedSurfacesOfAllLabels(bool);
   // reaction to the signal "createMask" from QmitkLabelSetTableWidget
   void OnCreateMask(bool);
   void OnCreateMasks(bool);
@@ -145,6 +150,9 @@ private:
 
   void OnThreadedCalculationDone();
 
+  // creates the surfaces of all labels of the active layer in a single pass in the background
+  void CreateSurfacesOfAllLabels(bool smooth);
+
   void InitializeTableWidget();
 
   int GetPixelValueOfSelectedItem();
@@ -166,6 +174,10 @@ private:
   QStringList m_OrganColors;
 
   QStringList m_LabelStringList;
+
+  // kept between the surface creations to update the surfaces incrementally
+  itk::SmartPointer<mitk::LabelSetImageToSurfaceFilter> m_SmoothedSurfaceFilter;
+  itk::SmartPointer<mitk::LabelSetImageToSurfaceFilter> m_DetailedSurfaceFilter;
 };
 
 #endif
@@ -150,6 +150,12 @@ QmitkSlicesInterpolator::QmitkSlicesInterpolator(QWidget *parent, const char * /
   command2->SetCallbackFunction(this, &QmitkSlicesInterpolator::OnSurfaceInterpolationInfoChanged);
   SurfaceInterpolationInfoChangedObserverTag = m_SurfaceInterpolator->AddObserver(itk::ModifiedEvent(), command2);
 
+  itk::ReceptorMemberCommand<QmitkSlicesInterpolator>::Pointer command3 =
+    itk::ReceptorMemberCommand<QmitkSlicesInterpolator>::New();
+  command3->SetCallbackFunction(this, &QmitkSlicesInterpolator::OnSurfaceInterpolationFinishedEvent);
+  SurfaceInterpolationFinishedObserverTag =
+    m_SurfaceInterpolator->AddObserver(mitk::SurfaceInterpolationFinishedEvent(), command3);
+
   // feedback node and its visualization properties
   m_FeedbackNode = mitk::DataNode::New();
   mitk::CoreObjectFactory::GetInstance()->SetDefaultProperties(m_FeedbackNode);
@@ -196,12 +202,6 @@ QmitkSlicesInterpolator::QmitkSlicesInterpolator(QWidget *parent, const char * /
     QWidget::layout()->setContentsMargins(0, 0, 0, 0);
   }
 
-  // For running 3D Interpolation in background
-  // create a QFuture and a QFutureWatcher
-
-  connect(&m_Watcher, SIGNAL(started()), this, SLOT(StartUpdateInterpolationTimer()));
-  connect(&m_Watcher, SIGNAL(finished()), this, SLOT(OnSurfaceInterpolationFinished()));
-  connect(&m_Watcher, SIGNAL(finished()), this, SLOT(StopUpdateInterpolationTimer()));
   m_Timer = new QTimer(this);
   connect(m_Timer, SIGNAL(timeout()), this, SLOT(ChangeSurfaceColor()));
 }
@@ -346,6 +346,7 @@ QmitkSlicesInterpolator::~QmitkSlicesInterpolator()
   // remove observer
   m_Interpolator->RemoveObserver(InterpolationInfoChangedObserverTag);
   m_SurfaceInterpolator->RemoveObserver(SurfaceInterpolationInfoChangedObserverTag);
+  m_SurfaceInterpolator->RemoveObserver(SurfaceInterpolationFinishedObserverTag);
 
   delete m_Timer;
 }
@@ -762,46 +763,45 @@ void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationContr
     int sliceIndex(-1);
     mitk::SegTool2D::DetermineAffectedImageSlice(m_Segmentation, reslicePlane, sliceDimension, sliceIndex);
 
-    unsigned int zslices = m_Segmentation->GetDimension(sliceDimension);
-    mitk::ProgressBar::GetInstance()->AddStepsToDo(zslices);
+    // all slices are interpolated at once, m_Interpolator decides which slices need an interpolation
+    const mitk::SegmentationInterpolationController::InterpolatedSlicesType interpolations =
+      m_Interpolator->InterpolateAllSlices(sliceDimension, reslicePlane, timeStep);
+    mitk::ProgressBar::GetInstance()->AddStepsToDo(interpolations.size());
 
     mitk::Point3D origin = reslicePlane->GetOrigin();
     unsigned int totalChangedSlices(0);
 
-    for (unsigned int sliceIndex = 0; sliceIndex < zslices; ++sliceIndex)
+    for (const auto &sliceInterpolation : interpolations)
     {
+      const unsigned int sliceIndex = sliceInterpolation.first;
+      const mitk::Image::Pointer &interpolation = sliceInterpolation.second;
+
       // Transforming the current origin of the reslice plane
       // so that it matches the one of the next slice
       m_Segmentation->GetSlicedGeometry()->WorldToIndex(origin, origin);
       origin[sliceDimension] = sliceIndex;
       m_Segmentation->GetSlicedGeometry()->IndexToWorld(origin, origin);
       reslicePlane->SetOrigin(origin);
-      // Set the slice as 'input'
-      mitk::Image::Pointer interpolation =
-        m_Interpolator->Interpolate(sliceDimension, sliceIndex, reslicePlane, timeStep);
 
-      if (interpolation.IsNotNull()) // we don't check if interpolation is necessary/sensible - but m_Interpolator does
-      {
-        // Setting up the reslicing pipeline which allows us to write the interpolation results back into
-        // the image volume
-        vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
-
-        // set overwrite mode to true to write back to the image volume
-        reslice->SetInputSlice(interpolation->GetSliceData()->GetVtkImageAccessor(interpolation)->GetVtkImageData());
-        reslice->SetOverwriteMode(true);
-        reslice->Modified();
-
-        mitk::ExtractSliceFilter::Pointer diffslicewriter = mitk::ExtractSliceFilter::New(reslice);
-        diffslicewriter->SetInput(diffImage);
-        diffslicewriter->SetTimeStep(0);
-        diffslicewriter->SetWorldGeometry(reslicePlane);
-        diffslicewriter->SetVtkOutputRequest(true);
-        diffslicewriter->SetResliceTransformByGeometry(diffImage->GetTimeGeometry()->GetGeometryForTimeStep(0));
-
-        diffslicewriter->Modified();
-        diffslicewriter->Update();
-        ++totalChangedSlices;
-      }
+      // Setting up the reslicing pipeline which allows us to write the interpolation results back into
+      // the image volume
+      vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+
+      // set overwrite mode to true to write back to the image volume
+      reslice->SetInputSlice(interpolation->GetSliceData()->GetVtkImageAccessor(interpolation)->GetVtkImageData());
+      reslice->SetOverwriteMode(true);
+      reslice->Modified();
+
+      mitk::ExtractSliceFilter::Pointer diffslicewriter = mitk::ExtractSliceFilter::New(reslice);
+      diffslicewriter->SetInput(diffImage);
+      diffslicewriter->SetTimeStep(0);
+      diffslicewriter->SetWorldGeometry(reslicePlane);
+      diffslicewriter->SetVtkOutputRequest(true);
+      diffslicewriter->SetResliceTransformByGeometry(diffImage->GetTimeGeometry()->GetGeometryForTimeStep(0));
+
+      diffslicewriter->Modified();
+      diffslicewriter->Update();
+      ++totalChangedSlices;
       mitk::ProgressBar::GetInstance()->Progress();
     }
     mitk::RenderingManager::GetInstance()->RequestUpdateAll();
@@ -1144,7 +1144,17 @@ void QmitkSlicesInterpolator::OnInterpolationActivated(bool on)
 
 void QmitkSlicesInterpolator::Run3DInterpolation()
 {
-  m_SurfaceInterpolator->Interpolate();
+  // The 3D interpolation runs in the background thread of the controller. Requests that follow each other quickly
+  // are coalesced and outdated runs are cancelled, thus the UI is never blocked by a running interpolation.
+  m_SurfaceInterpolator->RequestInterpolation();
+  this->StartUpdateInterpolationTimer();
+}
+
+void QmitkSlicesInterpolator::OnSurfaceInterpolationFinishedEvent(const itk::EventObject & /*e*/)
+{
+  // Invoked from the background thread of the controller
+  QMetaObject::invokeMethod(this, "OnSurfaceInterpolationFinished", Qt::QueuedConnection);
+  QMetaObject::invokeMethod(this, "StopUpdateInterpolationTimer", Qt::QueuedConnection);
 }
 
 void QmitkSlicesInterpolator::StartUpdateInterpolationTimer()
@@ -1204,13 +1214,9 @@ void QmitkSlicesInterpolator::On3DInterpolationActivated(bool on)
             ret = msgBox.exec();
           }
 
-          if (m_Watcher.isRunning())
-            m_Watcher.waitForFinished();
-
           if (ret == QMessageBox::Yes)
           {
-            m_Future = QtConcurrent::run(this, &QmitkSlicesInterpolator::Run3DInterpolation);
-            m_Watcher.setFuture(m_Future);
+            this->Run3DInterpolation();
           }
           else
           {
@@ -1226,6 +1232,7 @@ void QmitkSlicesInterpolator::On3DInterpolationActivated(bool on)
     }
     if (!m_3DInterpolationEnabled)
     {
+      this->CancelInterpolation();
       this->Show3DInterpolationResult(false);
       m_BtnApply3D->setEnabled(m_3DInterpolationEnabled);
 
@@ -1269,10 +1276,7 @@ void QmitkSlicesInterpolator::OnSurfaceInterpolationInfoChanged(const itk::Event
 {
   if (m_3DInterpolationEnabled)
   {
-    if (m_Watcher.isRunning())
-      m_Watcher.waitForFinished();
-    m_Future = QtConcurrent::run(this, &QmitkSlicesInterpolator::Run3DInterpolation);
-    m_Watcher.setFuture(m_Future);
+    this->Run3DInterpolation();
   }
 }
 
@@ -1325,10 +1329,7 @@ void QmitkSlicesInterpolator::SetCurrentContourListID()
 
       if (m_3DInterpolationEnabled)
       {
-        if (m_Watcher.isRunning())
-          m_Watcher.waitForFinished();
-        m_Future = QtConcurrent::run(this, &QmitkSlicesInterpolator::Run3DInterpolation);
-        m_Watcher.setFuture(m_Future);
+        this->Run3DInterpolation();
       }
     }
     else
@@ -1380,12 +1381,20 @@ void QmitkSlicesInterpolator::OnSliceNavigationControllerDeleted(const itk::Obje
   }
 }
 
+void QmitkSlicesInterpolator::CancelInterpolation()
+{
+  m_SurfaceInterpolator->CancelInterpolation();
+
+  m_Timer->stop();
+  if (m_InterpolatedSurfaceNode.IsNotNull())
+    m_InterpolatedSurfaceNode->SetProperty("color", mitk::ColorProperty::New(SURFACE_COLOR_RGB));
+}
+
 void QmitkSlicesInterpolator::WaitForFutures()
 {
-  if (m_Watcher.isRunning())
-  {
-    m_Watcher.waitForFinished();
-  }
+  // Results of the 3D interpolation are not needed anymore
+  this->CancelInterpolation();
+  m_SurfaceInterpolator->WaitForInterpolation();
 
   if (m_PlaneWatcher.isRunning())
   {
@@ -114,6 +114,11 @@ public:
   */
   void OnSurfaceInterpolationInfoChanged(const itk::EventObject &);
 
+  /**
+    Called from the background thread of the SurfaceInterpolationController when an interpolation has finished
+  */
+  void OnSurfaceInterpolationFinishedEvent(const itk::EventObject &);
+
   /**
    * @brief Set the visibility of the 3d interpolation
    */
@@ -231,6 +236,9 @@ private:
   void Show2DInterpolationControls(bool show);
   void Show3DInterpolationControls(bool show);
   void CheckSupportedImageDimension();
+  /** Cancels the 3D interpolation and stops the blinking of the interpolated surface, as a cancelled interpolation
+      does not finish. */
+  void CancelInterpolation();
   void WaitForFutures();
   void NodeRemoved(const mitk::DataNode* node);
 
@@ -249,6 +257,7 @@ private:
 
   unsigned int InterpolationInfoChangedObserverTag;
   unsigned int SurfaceInterpolationInfoChangedObserverTag;
+  unsigned int SurfaceInterpolationFinishedObserverTag;
 
   QGroupBox *m_GroupBoxEnableExclusiveInterpolationMode;
   QComboBox *m_CmbInterpolation;
@@ -279,8 +288,6 @@ private:
 
   mitk::DataStorage::Pointer m_DataStorage;
 
-  QFuture<void> m_Future;
-  QFutureWatcher<void> m_Watcher;
   QTimer *m_Timer;
 
   QFuture<void> m_PlaneFuture;
@@ -14,10 +14,20 @@ found in the LICENSE file.
 #include <mitkCreateDistanceImageFromSurfaceFilter.h>
 #include <mitkIOUtil.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkImageCast.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include <itkImageRegionConstIterator.h>
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
 #include <vtkDebugLeaks.h>
+#include <vtkDoubleArray.h>
+#include <vtkPolyData.h>
+#include <vtkPolygon.h>
+
+#include <chrono>
 
 class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixture
 {
@@ -26,11 +36,83 @@ class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixtu
   // Basically tests the same as the other test below
   // MITK_TEST(TestCreateDistanceImageForLiver);
   MITK_TEST(TestCreateDistanceImageForTube);
+  MITK_TEST(TestPartitionOfUnityMatchesGlobalInterpolation);
+  MITK_TEST(TestInterpolationTimeForGrowingContourSets);
   CPPUNIT_TEST_SUITE_END();
 
 private:
+  typedef mitk::CreateDistanceImageFromSurfaceFilter::DistanceImageType DistanceImageType;
+
   std::vector<mitk::Surface::Pointer> contourList;
 
+  // Axial circle around the center of the sphere (32, 32, 32) with normals pointing outwards
+  mitk::Surface::Pointer CreateCircleContour(double z, double radius, unsigned int numberOfPoints)
+  {
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    auto normals = vtkSmartPointer<vtkDoubleArray>::New();
+    normals->SetNumberOfComponents(3);
+    auto polygon = vtkSmartPointer<vtkPolygon>::New();
+    polygon->GetPointIds()->SetNumberOfIds(numberOfPoints);
+
+    for (unsigned int i = 0; i < numberOfPoints; ++i)
+    {
+      const double angle = 2 * itk::Math::pi * i / numberOfPoints;
+      points->InsertNextPoint(32 + radius * std::cos(angle), 32 + radius * std::sin(angle), z);
+      normals->InsertNextTuple3(std::cos(angle), std::sin(angle), 0);
+      polygon->GetPointIds()->SetId(i, i);
+    }
+
+    auto polys = vtkSmartPointer<vtkCellArray>::New();
+    polys->InsertNextCell(polygon);
+
+    auto polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetPolys(polys);
+    polyData->GetCellData()->SetNormals(normals);
+
+    auto surface = mitk::Surface::New();
+    surface->SetVtkPolyData(polyData);
+    return surface;
+  }
+
+  // Contours of a sphere with radius 20, evenly distributed between z = 16 and z = 48
+  mitk::CreateDistanceImageFromSurfaceFilter::Pointer CreateSphereFilter(unsigned int numberOfContours,
+                                                                         unsigned int numberOfPointsPerContour)
+  {
+    auto referenceImage = itk::Image<unsigned char, 3>::New();
+    itk::Image<unsigned char, 3>::SizeType size;
+    size.Fill(64);
+    referenceImage->SetRegions(size);
+
+    auto filter = mitk::CreateDistanceImageFromSurfaceFilter::New();
+    filter->SetReferenceImage(referenceImage.GetPointer());
+
+    for (unsigned int i = 0; i < numberOfContours; ++i)
+    {
+      const double z = 16 + 32.0 * i / (numberOfContours - 1);
+      const double radius = std::sqrt(400 - (z - 32) * (z - 32));
+      filter->SetInput(i, CreateCircleContour(z, radius, numberOfPointsPerContour));
+    }
+
+    return filter;
+  }
+
+  DistanceImageType::Pointer GetDistanceImage(mitk::CreateDistanceImageFromSurfaceFilter *filter)
+  {
+    DistanceImageType::Pointer distanceImage;
+    mitk::CastToItkImage(filter->GetOutput(), distanceImage);
+    return distanceImage;
+  }
+
+  double GetDistanceAtSphereCenter(const DistanceImageType *distanceImage)
+  {
+    DistanceImageType::PointType center;
+    center.Fill(32);
+    DistanceImageType::IndexType index;
+    CPPUNIT_ASSERT(distanceImage->TransformPhysicalPointToIndex(center, index));
+    return distanceImage->GetPixel(index);
+  }
+
 public:
   void setUp() override {}
   template <typename TPixel, unsigned int VImageDimension>
@@ -128,6 +210,62 @@ public:
     CPPUNIT_ASSERT_MESSAGE("HolesDistanceImages are not equal!",
                            mitk::Equal(*(holesDistanceImageReference), *(holeDistanceImage), 0.0001, true));
   }
+
+  void TestPartitionOfUnityMatchesGlobalInterpolation()
+  {
+    auto globalFilter = CreateSphereFilter(8, 48);
+    globalFilter->SetInterpolationMethod(mitk::CreateDistanceImageFromSurfaceFilter::GLOBAL_INTERPOLATION);
+    globalFilter->Update();
+    CPPUNIT_ASSERT(!globalFilter->GetUsedPartitionOfUnity());
+
+    auto partitionOfUnityFilter = CreateSphereFilter(8, 48);
+    partitionOfUnityFilter->SetInterpolationMethod(
+      mitk::CreateDistanceImageFromSurfaceFilter::PARTITION_OF_UNITY_INTERPOLATION);
+    partitionOfUnityFilter->Update();
+    CPPUNIT_ASSERT(partitionOfUnityFilter->GetUsedPartitionOfUnity());
+
+    auto globalImage = GetDistanceImage(globalFilter);
+    auto partitionOfUnityImage = GetDistanceImage(partitionOfUnityFilter);
+
+    CPPUNIT_ASSERT(globalImage->GetLargestPossibleRegion() == partitionOfUnityImage->GetLargestPossibleRegion());
+    CPPUNIT_ASSERT(GetDistanceAtSphereCenter(globalImage) < 0);
+    CPPUNIT_ASSERT(GetDistanceAtSphereCenter(partitionOfUnityImage) < 0);
+
+    // Both interpolations have to separate inside and outside almost identically
+    itk::ImageRegionConstIterator<DistanceImageType> globalIt(globalImage, globalImage->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<DistanceImageType> partitionOfUnityIt(partitionOfUnityImage,
+                                                                       partitionOfUnityImage->GetLargestPossibleRegion());
+    unsigned int numberOfDifferentPixels = 0;
+
+    for (; !globalIt.IsAtEnd(); ++globalIt, ++partitionOfUnityIt)
+    {
+      if ((globalIt.Get() < 0) != (partitionOfUnityIt.Get() < 0))
+        ++numberOfDifferentPixels;
+    }
+
+    CPPUNIT_ASSERT(numberOfDifferentPixels < 0.05 * globalImage->GetLargestPossibleRegion().GetNumberOfPixels());
+  }
+
+  void TestInterpolationTimeForGrowingContourSets()
+  {
+    for (unsigned int numberOfContours = 5; numberOfContours <= 40; numberOfContours *= 2)
+    {
+      auto filter = CreateSphereFilter(numberOfContours, 64);
+
+      const auto start = std::chrono::steady_clock::now();
+      filter->Update();
+      const auto stop = std::chrono::steady_clock::now();
+
+      MITK_INFO << "Interpolation of " << numberOfContours << " contours ("
+                << (filter->GetUsedPartitionOfUnity() ? "partition of unity" : "global")
+                << "): " << std::chrono::duration<double>(stop - start).count() << " s";
+
+      // 3 centers per contour point
+      CPPUNIT_ASSERT_EQUAL(numberOfContours * 64 * 3 > filter->GetMaximumNumberOfCentersForGlobalInterpolation(),
+                           filter->GetUsedPartitionOfUnity());
+      CPPUNIT_ASSERT(GetDistanceAtSphereCenter(GetDistanceImage(filter)) < 0);
+    }
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkCreateDistanceImageFromSurfaceFilter)
@@ -41,6 +41,7 @@ class mitkSurfaceInterpolationControllerTestSuite : public mitk::TestFixture
 
   MITK_TEST(TestAddNewContour);
   MITK_TEST(TestRemoveContour);
+  MITK_TEST(TestAsynchronousInterpolation);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -512,6 +513,85 @@ public:
         mitk::Equal(*(surf_1->GetVtkPolyData()), *(remainingContour->GetVtkPolyData()), 0.000001, true) && success);
   }
 
+  void TestAsynchronousInterpolation()
+  {
+    // Create a segmentation image containing a cylinder
+    unsigned int dimensions[] = {20, 20, 12};
+    mitk::Image::Pointer segmentation = createImage(dimensions);
+    {
+      mitk::ImagePixelWriteAccessor<unsigned char, 3> writeAccessor(segmentation);
+      itk::Index<3> index;
+      for (index[2] = 0; index[2] < 12; ++index[2])
+        for (index[1] = 0; index[1] < 20; ++index[1])
+          for (index[0] = 0; index[0] < 20; ++index[0])
+          {
+            const double dx = index[0] - 10.0;
+            const double dy = index[1] - 10.0;
+            writeAccessor.SetPixelByIndex(index, index[2] >= 3 && index[2] <= 8 && dx * dx + dy * dy <= 16.0 ? 1 : 0);
+          }
+    }
+    m_Controller->SetCurrentInterpolationSession(segmentation);
+
+    // Add parallel contours of the cylinder
+    for (double z = 3.0; z <= 8.0; z += 2.5)
+    {
+      double center[3] = {10.0, 10.0, z};
+      double normal[3] = {0.0, 0.0, 1.0};
+      vtkSmartPointer<vtkRegularPolygonSource> source = vtkSmartPointer<vtkRegularPolygonSource>::New();
+      source->SetNumberOfSides(30);
+      source->SetCenter(center);
+      source->SetRadius(4);
+      source->SetNormal(normal);
+      source->Update();
+      mitk::Surface::Pointer contour = mitk::Surface::New();
+      contour->SetVtkPolyData(source->GetOutput());
+      m_Controller->AddNewContour(contour);
+    }
+
+    m_Controller->Interpolate();
+    mitk::Surface::Pointer synchronousResult = m_Controller->GetInterpolationResult();
+    CPPUNIT_ASSERT_MESSAGE("Synchronous interpolation failed", synchronousResult.IsNotNull());
+    const vtkIdType numberOfPoints = synchronousResult->GetVtkPolyData()->GetNumberOfPoints();
+    CPPUNIT_ASSERT(numberOfPoints > 0);
+
+    // Requests that follow each other quickly are coalesced into a single run
+    m_Controller->RequestInterpolation();
+    m_Controller->RequestInterpolation();
+    m_Controller->RequestInterpolation();
+    m_Controller->WaitForInterpolation();
+
+    CPPUNIT_ASSERT(!m_Controller->IsInterpolationRunning());
+    mitk::Surface::Pointer asynchronousResult = m_Controller->GetInterpolationResult();
+    CPPUNIT_ASSERT_MESSAGE("Asynchronous interpolation failed", asynchronousResult.IsNotNull());
+    CPPUNIT_ASSERT_MESSAGE("No new result has been published", asynchronousResult != synchronousResult);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Asynchronous and synchronous result differ",
+                                 numberOfPoints,
+                                 asynchronousResult->GetVtkPolyData()->GetNumberOfPoints());
+
+    // A synchronous interpolation replaces a pending request
+    const unsigned int delay = m_Controller->GetInterpolationDelay();
+    m_Controller->SetInterpolationDelay(1000);
+    m_Controller->RequestInterpolation();
+    m_Controller->Interpolate();
+    CPPUNIT_ASSERT(!m_Controller->IsInterpolationRunning());
+    synchronousResult = m_Controller->GetInterpolationResult();
+    CPPUNIT_ASSERT_MESSAGE("Synchronous interpolation was discarded",
+                           synchronousResult.IsNotNull() && synchronousResult != asynchronousResult);
+
+    // A cancelled request keeps the last published result
+    m_Controller->RequestInterpolation();
+    CPPUNIT_ASSERT(m_Controller->IsInterpolationRunning());
+    m_Controller->CancelInterpolation();
+    m_Controller->WaitForInterpolation();
+    m_Controller->SetInterpolationDelay(delay);
+
+    CPPUNIT_ASSERT(!m_Controller->IsInterpolationRunning());
+    CPPUNIT_ASSERT_MESSAGE("Cancelled interpolation replaced the result",
+                           m_Controller->GetInterpolationResult() == synchronousResult);
+
+    m_Controller->RemoveAllInterpolationSessions();
+  }
+
   bool AssertImagesEqual4D(mitk::Image *img1, mitk::Image *img2)
   {
     mitk::ImageTimeSelector::Pointer selector1 = mitk::ImageTimeSelector::New();
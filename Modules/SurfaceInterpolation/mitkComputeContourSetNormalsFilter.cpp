@@ -21,7 +21,8 @@ mitk::ComputeContourSetNormalsFilter::ComputeContourSetNormalsFilter()
     m_NegativeNormalCounter(0),
     m_PositiveNormalCounter(0),
     m_UseProgressBar(false),
-    m_ProgressStepSize(1)
+    m_ProgressStepSize(1),
+    m_CancelFlag(nullptr)
 {
   mitk::Surface::Pointer output = mitk::Surface::New();
   this->SetNthOutput(0, output.GetPointer());
@@ -31,6 +32,21 @@ mitk::ComputeContourSetNormalsFilter::~ComputeContourSetNormalsFilter()
 {
 }
 
+void mitk::ComputeContourSetNormalsFilter::SetCancelFlag(const std::atomic<bool> *cancelFlag)
+{
+  m_CancelFlag = cancelFlag;
+}
+
+void mitk::ComputeContourSetNormalsFilter::AbortIfRequested() const
+{
+  if (nullptr != m_CancelFlag && *m_CancelFlag)
+  {
+    itk::ProcessAborted e(__FILE__, __LINE__);
+    e.SetDescription("ComputeContourSetNormalsFilter has been aborted.");
+    throw e;
+  }
+}
+
 void mitk::ComputeContourSetNormalsFilter::GenerateData()
 {
   unsigned int numberOfInputs = this->GetNumberOfIndexedInputs();
@@ -38,6 +54,8 @@ void mitk::ComputeContourSetNormalsFilter::GenerateData()
   // Iterating over each input
   for (unsigned int i = 0; i < numberOfInputs; i++)
   {
+    this->AbortIfRequested();
+
     // Getting the inputs polydata and polygons
     auto *currentSurface = this->GetInput(i);
     vtkPolyData *polyData = currentSurface->GetVtkPolyData();
@@ -28,6 +28,8 @@ found in the LICENSE file.
 
 #include "mitkImage.h"
 
+#include <atomic>
+
 namespace mitk
 {
   /**
@@ -79,6 +81,15 @@ namespace mitk
     void SetProgressStepSize(unsigned int stepSize);
 
     void SetSegmentationBinaryImage(mitk::Image *segmentationImage) { m_SegmentationBinaryImage = segmentationImage; }
+
+    /**
+      \brief Set a flag that the filter polls while it runs, e.g. to cancel it from another thread.
+
+      If the flag becomes true, the filter throws itk::ProcessAborted. The flag must outlive the
+      execution of the filter. nullptr (default) disables the polling.
+    */
+    void SetCancelFlag(const std::atomic<bool> *cancelFlag);
+
   protected:
     ComputeContourSetNormalsFilter();
     ~ComputeContourSetNormalsFilter() override;
@@ -86,6 +97,9 @@ namespace mitk
     void GenerateOutputInformation() override;
 
   private:
+    /** Throws itk::ProcessAborted if the cancel flag has been set */
+    void AbortIfRequested() const;
+
     // The segmentation out of which the contours were extracted. Can be used to determine the direction of the normals
     mitk::Image::Pointer m_SegmentationBinaryImage;
     double m_MaxSpacing;
@@ -96,6 +110,8 @@ namespace mitk
     bool m_UseProgressBar;
     unsigned int m_ProgressStepSize;
 
+    const std::atomic<bool> *m_CancelFlag;
+
   }; // class
 
 } // namespace
@@ -22,7 +22,11 @@ found in the LICENSE file.
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkNeighborhoodIterator.h"
 
+#include <algorithm>
+#include <array>
+#include <numeric>
 #include <queue>
+#include <set>
 
 void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 {
@@ -105,7 +109,13 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 }
 
 mitk::CreateDistanceImageFromSurfaceFilter::CreateDistanceImageFromSurfaceFilter()
-  : m_DistanceImageSpacing(0.0), m_DistanceImageDefaultBufferValue(0.0)
+  : m_InterpolationMethod(AUTOMATIC_INTERPOLATION),
+    m_MaximumNumberOfCentersForGlobalInterpolation(3000),
+    m_NumberOfCentersPerPatch(64),
+    m_UsedPartitionOfUnity(false),
+    m_DistanceImageSpacing(0.0),
+    m_DistanceImageDefaultBufferValue(0.0),
+    m_CancelFlag(nullptr)
 {
   m_DistanceImageVolume = 50000;
   this->m_UseProgressBar = false;
@@ -125,12 +135,26 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
   this->CreateEmptyDistanceImage();
 
   // First of all we have to build the equation-system from the existing contour-edge-points
-  this->CreateSolutionMatrixAndFunctionValues();
+  this->CreateInnerAndOuterPoints();
+  this->AbortIfRequested();
+
+  m_UsedPartitionOfUnity =
+    PARTITION_OF_UNITY_INTERPOLATION == m_InterpolationMethod ||
+    (AUTOMATIC_INTERPOLATION == m_InterpolationMethod && m_Centers.size() > m_MaximumNumberOfCentersForGlobalInterpolation);
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(1);
 
-  m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+  if (m_UsedPartitionOfUnity)
+  {
+    this->SolvePartitionOfUnityInterpolation();
+  }
+  else
+  {
+    this->SolveGlobalInterpolation();
+  }
+
+  this->AbortIfRequested();
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(2);
@@ -143,6 +167,22 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
 
   m_Centers.clear();
   m_Normals.clear();
+  m_Patches.clear();
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::SetCancelFlag(const std::atomic<bool> *cancelFlag)
+{
+  m_CancelFlag = cancelFlag;
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::AbortIfRequested() const
+{
+  if (this->GetAbortGenerateData() || (nullptr != m_CancelFlag && *m_CancelFlag))
+  {
+    itk::ProcessAborted e(__FILE__, __LINE__);
+    e.SetDescription("CreateDistanceImageFromSurfaceFilter has been aborted.");
+    throw e;
+  }
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
@@ -168,6 +208,9 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
   PointType currentPoint;
   PointType normal;
 
+  // Points that are shared by several contours are only used once
+  std::set<std::array<double, 3>> existingCenters;
+
   for (unsigned int i = 0; i < numberOfInputs; i++)
   {
     auto currentSurface = this->GetInput(i);
@@ -199,9 +242,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
 
         currentPoint.copy_in(p);
 
-        int count = std::count(m_Centers.begin(), m_Centers.end(), currentPoint);
-
-        if (count == 0)
+        if (existingCenters.insert({{p[0], p[1], p[2]}}).second)
         {
           double currentNormal[3];
           currentCellNormals->GetTuple(cell[j], currentNormal);
@@ -218,9 +259,9 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
   }     // end for all outputs
 }
 
-void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrixAndFunctionValues()
+void mitk::CreateDistanceImageFromSurfaceFilter::CreateInnerAndOuterPoints()
 {
-  // For we can now calculate the exact size of the centers we initialize the data structures
+  // As we can now calculate the exact size of the centers we initialize the data structures
   unsigned int numberOfCenters = m_Centers.size();
   m_Centers.reserve(numberOfCenters * 3);
 
@@ -261,28 +302,206 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrixAndFunction
     m_FunctionValues[numberOfCenters * 2 + i] = m_DistanceImageSpacing;
   }
 
-  // Now we have created all centers and all function values. Next step is to create the solution matrix
+  // Keep the centers in a contiguous matrix for the evaluation of the distance function
   numberOfCenters = m_Centers.size();
+  m_CenterMatrix.resize(3, numberOfCenters);
 
-  m_SolutionMatrix.resize(numberOfCenters, numberOfCenters);
+  for (unsigned int i = 0; i < numberOfCenters; i++)
+  {
+    m_CenterMatrix.col(i) = EigenPointType(m_Centers[i][0], m_Centers[i][1], m_Centers[i][2]);
+  }
+}
 
-  m_Weights.resize(numberOfCenters);
+void mitk::CreateDistanceImageFromSurfaceFilter::SolveGlobalInterpolation()
+{
+  // Now we have created all centers and all function values. Next step is to create the solution matrix
+  const Eigen::Index numberOfCenters = m_CenterMatrix.cols();
 
-  PointType p1;
-  PointType p2;
-  double norm;
+  m_SolutionMatrix.resize(numberOfCenters, numberOfCenters);
 
-  for (unsigned int i = 0; i < numberOfCenters; i++)
+  for (Eigen::Index j = 0; j < numberOfCenters; j++)
   {
-    for (unsigned int j = 0; j < numberOfCenters; j++)
+    if (0 == j % 256)
+      this->AbortIfRequested();
+
+    m_SolutionMatrix(j, j) = 0.0;
+
+    for (Eigen::Index i = j + 1; i < numberOfCenters; i++)
     {
       // Calculate the RBF value. Currently using Phi(r) = r with r is the euclidian distance between two points
-      p1 = m_Centers.at(i);
-      p2 = m_Centers.at(j);
-      p1 = p1 - p2;
-      norm = p1.two_norm();
+      const double norm = (m_CenterMatrix.col(i) - m_CenterMatrix.col(j)).norm();
       m_SolutionMatrix(i, j) = norm;
+      m_SolutionMatrix(j, i) = norm;
+    }
+  }
+
+  m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::SolvePartitionOfUnityInterpolation()
+{
+  m_SolutionMatrix.resize(0, 0);
+  m_Weights.resize(0);
+  m_Patches.clear();
+
+  // The patches have to cover the region of the distance image in which the surface is searched. It exceeds
+  // the bounding box of the centers by a few pixels.
+  const EigenPointType margin = EigenPointType::Constant(4 * m_DistanceImageSpacing);
+  m_PatchesMinimum = m_CenterMatrix.rowwise().minCoeff() - margin;
+  m_PatchesMaximum = m_CenterMatrix.rowwise().maxCoeff() + margin;
+
+  // Limit the number of buckets to 64 per dimension
+  const double bucketSize =
+    std::max(2 * m_DistanceImageSpacing, (m_PatchesMaximum - m_PatchesMinimum).maxCoeff() / 64);
+
+  m_CenterGrid.Initialize(m_PatchesMinimum, m_PatchesMaximum, bucketSize);
+
+  std::vector<unsigned int> centerIds(m_CenterMatrix.cols());
+  std::iota(centerIds.begin(), centerIds.end(), 0);
+
+  for (auto id : centerIds)
+  {
+    m_CenterGrid.Insert(id, m_CenterMatrix.col(id), m_CenterMatrix.col(id));
+  }
+
+  this->SubdivideCell(m_PatchesMinimum, m_PatchesMaximum, centerIds, 0);
+
+  m_PatchGrid.Initialize(m_PatchesMinimum, m_PatchesMaximum, bucketSize);
+
+  for (unsigned int id = 0; id < m_Patches.size(); ++id)
+  {
+    const EigenPointType radius = EigenPointType::Constant(m_Patches[id].Radius);
+    m_PatchGrid.Insert(id, m_Patches[id].Center - radius, m_Patches[id].Center + radius);
+  }
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::SubdivideCell(const EigenPointType &minimum,
+                                                               const EigenPointType &maximum,
+                                                               const std::vector<unsigned int> &centerIds,
+                                                               unsigned int depth)
+{
+  const unsigned int maximumDepth = 10;
+  const EigenPointType middle = (minimum + maximum) / 2;
+
+  if (centerIds.size() <= m_NumberOfCentersPerPatch || maximumDepth == depth)
+  {
+    // The sphere through the corners of the cell is enlarged, thus the patches of neighbouring cells overlap
+    this->CreatePatch(middle, 0.75 * (maximum - minimum).norm());
+    return;
+  }
+
+  std::vector<unsigned int> octantIds[8];
+
+  for (auto id : centerIds)
+  {
+    const auto center = m_CenterMatrix.col(id);
+    const int octant = (center[0] >= middle[0] ? 1 : 0) | (center[1] >= middle[1] ? 2 : 0) | (center[2] >= middle[2] ? 4 : 0);
+    octantIds[octant].push_back(id);
+  }
+
+  for (int octant = 0; octant < 8; ++octant)
+  {
+    EigenPointType octantMinimum;
+    EigenPointType octantMaximum;
+
+    for (int dim = 0; dim < 3; ++dim)
+    {
+      const bool upperHalf = 0 != (octant & (1 << dim));
+      octantMinimum[dim] = upperHalf ? middle[dim] : minimum[dim];
+      octantMaximum[dim] = upperHalf ? maximum[dim] : middle[dim];
     }
+
+    this->SubdivideCell(octantMinimum, octantMaximum, octantIds[octant], depth + 1);
+  }
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::CreatePatch(const EigenPointType &center, double radius)
+{
+  this->AbortIfRequested();
+
+  const std::size_t minimumNumberOfCenters = std::max(1u, m_NumberOfCentersPerPatch / 2);
+  const std::size_t maximumNumberOfCenters = 2 * static_cast<std::size_t>(m_NumberOfCentersPerPatch);
+  const double maximumRadius = (m_PatchesMaximum - m_PatchesMinimum).norm();
+
+  std::vector<unsigned int> centerIds;
+  this->GetCentersInSphere(center, radius, centerIds);
+
+  // Cells between the contours contain only few centers. Their patches are enlarged until they reach
+  // the neighbouring contours, otherwise the local interpolation would not be defined.
+  double grownRadius = radius;
+  while (centerIds.size() < minimumNumberOfCenters && grownRadius < maximumRadius)
+  {
+    grownRadius *= 1.5;
+    centerIds.clear();
+    this->GetCentersInSphere(center, grownRadius, centerIds);
+  }
+
+  if (centerIds.empty())
+    return;
+
+  // Enlarging may have collected far more centers than needed, only the nearest are kept
+  if (grownRadius > radius && centerIds.size() > maximumNumberOfCenters)
+  {
+    auto squaredDistance = [this, &center](unsigned int id) { return (m_CenterMatrix.col(id) - center).squaredNorm(); };
+
+    std::nth_element(centerIds.begin(),
+                     centerIds.begin() + (maximumNumberOfCenters - 1),
+                     centerIds.end(),
+                     [&squaredDistance](unsigned int a, unsigned int b) { return squaredDistance(a) < squaredDistance(b); });
+    grownRadius = std::max(radius, std::sqrt(squaredDistance(centerIds[maximumNumberOfCenters - 1])));
+    centerIds.resize(maximumNumberOfCenters);
+  }
+
+  const Eigen::Index numberOfCenters = centerIds.size();
+
+  Patch patch;
+  patch.Center = center;
+  patch.Radius = grownRadius;
+  patch.Centers.resize(3, numberOfCenters);
+
+  Eigen::VectorXd functionValues(numberOfCenters);
+
+  for (Eigen::Index i = 0; i < numberOfCenters; ++i)
+  {
+    patch.Centers.col(i) = m_CenterMatrix.col(centerIds[i]);
+    functionValues[i] = m_FunctionValues[centerIds[i]];
+  }
+
+  // Local equation system with the same RBF as the global interpolation: Phi(r) = r
+  Eigen::MatrixXd solutionMatrix(numberOfCenters, numberOfCenters);
+
+  for (Eigen::Index j = 0; j < numberOfCenters; ++j)
+  {
+    solutionMatrix(j, j) = 0.0;
+
+    for (Eigen::Index i = j + 1; i < numberOfCenters; ++i)
+    {
+      const double norm = (patch.Centers.col(i) - patch.Centers.col(j)).norm();
+      solutionMatrix(i, j) = norm;
+      solutionMatrix(j, i) = norm;
+    }
+  }
+
+  patch.Weights = solutionMatrix.partialPivLu().solve(functionValues);
+
+  m_Patches.push_back(std::move(patch));
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::GetCentersInSphere(const EigenPointType &center,
+                                                                    double radius,
+                                                                    std::vector<unsigned int> &centerIds) const
+{
+  const EigenPointType extent = EigenPointType::Constant(radius);
+
+  std::vector<unsigned int> candidateIds;
+  m_CenterGrid.GetIds(center - extent, center + extent, candidateIds);
+
+  const double squaredRadius = radius * radius;
+
+  for (auto id : candidateIds)
+  {
+    if ((m_CenterMatrix.col(id) - center).squaredNorm() <= squaredRadius)
+      centerIds.push_back(id);
   }
 }
 
@@ -328,8 +547,12 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   unsigned int relativeNbIdx[] = {4, 10, 12, 14, 16, 22};
 
   bool isInBounds = false;
+  unsigned int numberOfProcessedPoints = 0;
   while (!narrowbandPoints.empty())
   {
+    if (0 == ++numberOfProcessedPoints % 4096)
+      this->AbortIfRequested();
+
     nIt.SetLocation(narrowbandPoints.front());
     narrowbandPoints.pop();
 
@@ -419,25 +642,40 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   CastToMitkImage(m_DistanceImageITK, resultImage);
 }
 
-double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(PointType p)
+double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(const PointType &p) const
 {
-  double distanceValue(0);
-  PointType p1;
-  PointType p2;
-  double norm;
+  const EigenPointType point(p[0], p[1], p[2]);
+
+  if (!m_UsedPartitionOfUnity)
+  {
+    // Sum of the weighted RBF values Phi(r) = r with r is the euclidian distance between p and each center
+    return (m_CenterMatrix.colwise() - point).colwise().norm().dot(m_Weights.transpose());
+  }
+
+  // Only the patches near p contribute, they are blended with the Wendland function (1-r)^4 * (4r+1)
+  const std::vector<unsigned int> *patchIds = m_PatchGrid.GetBucket(point);
 
-  CenterList::iterator centerIter;
+  double weightedDistanceValue(0);
+  double sumOfWeights(0);
 
-  unsigned int count(0);
-  for (centerIter = m_Centers.begin(); centerIter != m_Centers.end(); centerIter++)
+  if (nullptr != patchIds)
   {
-    p1 = *centerIter;
-    p2 = p - p1;
-    norm = p2.two_norm();
-    distanceValue = distanceValue + (norm * m_Weights[count]);
-    ++count;
+    for (auto id : *patchIds)
+    {
+      const Patch &patch = m_Patches[id];
+      const double r = (point - patch.Center).norm() / patch.Radius;
+
+      if (r >= 1.0)
+        continue;
+
+      const double weight = std::pow(1.0 - r, 4) * (4.0 * r + 1.0);
+      weightedDistanceValue += weight * (patch.Centers.colwise() - point).colwise().norm().dot(patch.Weights.transpose());
+      sumOfWeights += weight;
+    }
   }
-  return distanceValue;
+
+  // Points that are not covered by any patch are far away from the contours, thus outside
+  return sumOfWeights > 0 ? weightedDistanceValue / sumOfWeights : m_DistanceImageDefaultBufferValue;
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::GenerateOutputInformation()
@@ -615,3 +853,76 @@ void mitk::CreateDistanceImageFromSurfaceFilter::DetermineBounds(
   m_ReferenceImage->TransformIndexToPhysicalPoint(minPointInIndexCoordinates, minPointInWorldCoordinates);
   m_ReferenceImage->TransformIndexToPhysicalPoint(maxPointInIndexCoordinates, maxPointInWorldCoordinates);
 }
+
+void mitk::CreateDistanceImageFromSurfaceFilter::BucketGrid::Initialize(const EigenPointType &minimum,
+                                                                        const EigenPointType &maximum,
+                                                                        double bucketSize)
+{
+  m_Origin = minimum;
+  m_BucketSize = bucketSize;
+  m_Size = (((maximum - minimum) / bucketSize).array().floor().cast<int>() + 1).max(1);
+
+  m_Buckets.clear();
+  m_Buckets.resize(m_Size.prod());
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::BucketGrid::Insert(unsigned int id,
+                                                                    const EigenPointType &minimum,
+                                                                    const EigenPointType &maximum)
+{
+  Eigen::Array3i lower;
+  Eigen::Array3i upper;
+  this->ClampedBucketIndex(minimum, lower);
+  this->ClampedBucketIndex(maximum, upper);
+
+  for (int z = lower[2]; z <= upper[2]; ++z)
+    for (int y = lower[1]; y <= upper[1]; ++y)
+      for (int x = lower[0]; x <= upper[0]; ++x)
+        m_Buckets[(z * m_Size[1] + y) * m_Size[0] + x].push_back(id);
+}
+
+const std::vector<unsigned int> *mitk::CreateDistanceImageFromSurfaceFilter::BucketGrid::GetBucket(
+  const EigenPointType &point) const
+{
+  Eigen::Array3i index;
+
+  if (!this->GetBucketIndex(point, index))
+    return nullptr;
+
+  return &m_Buckets[(index[2] * m_Size[1] + index[1]) * m_Size[0] + index[0]];
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::BucketGrid::GetIds(const EigenPointType &minimum,
+                                                                    const EigenPointType &maximum,
+                                                                    std::vector<unsigned int> &ids) const
+{
+  Eigen::Array3i lower;
+  Eigen::Array3i upper;
+  this->ClampedBucketIndex(minimum, lower);
+  this->ClampedBucketIndex(maximum, upper);
+
+  for (int z = lower[2]; z <= upper[2]; ++z)
+  {
+    for (int y = lower[1]; y <= upper[1]; ++y)
+    {
+      for (int x = lower[0]; x <= upper[0]; ++x)
+      {
+        const auto &bucket = m_Buckets[(z * m_Size[1] + y) * m_Size[0] + x];
+        ids.insert(ids.end(), bucket.begin(), bucket.end());
+      }
+    }
+  }
+}
+
+bool mitk::CreateDistanceImageFromSurfaceFilter::BucketGrid::GetBucketIndex(const EigenPointType &point,
+                                                                            Eigen::Array3i &index) const
+{
+  index = ((point - m_Origin).array() / m_BucketSize).floor().cast<int>();
+  return (index >= 0).all() && (index < m_Size).all();
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::BucketGrid::ClampedBucketIndex(const EigenPointType &point,
+                                                                                Eigen::Array3i &index) const
+{
+  index = ((point - m_Origin).array() / m_BucketSize).floor().cast<int>().max(0).min(m_Size - 1);
+}
@@ -25,6 +25,8 @@ found in the LICENSE file.
 
 #include <Eigen/Dense>
 
+#include <atomic>
+
 namespace mitk
 {
   /**
@@ -57,6 +59,13 @@ namespace mitk
          adjusted by calling SetDistanceImageVolume(unsigned int volume) which specifies the number ob pixels enclosed
   by the image.
 
+         Solving one global equation system for all centers scales cubically with the number of centers. For large
+         contour sets the filter therefore switches to a partition of unity interpolation (see InterpolationMethod):
+         The bounding box of the centers is recursively subdivided into cells (octree) until each cell contains at most
+         NumberOfCentersPerPatch centers. Each cell is covered by a spherical patch with a small local RBF system, the
+         local interpolants are blended with compactly supported Wendland weights. A grid of buckets limits the
+         evaluation of the distance function to the patches that are near the evaluated point.
+
   \ingroup Process
 
   $Author: fetzer$
@@ -74,6 +83,20 @@ namespace mitk
 
     typedef std::vector<Surface::Pointer> SurfaceList;
 
+    /**
+    \brief Methods to solve the interpolation problem.
+    */
+    enum InterpolationMethod
+    {
+      /** One global equation system over all centers. */
+      GLOBAL_INTERPOLATION = 0,
+      /** Local equation systems on overlapping patches, blended by a partition of unity. */
+      PARTITION_OF_UNITY_INTERPOLATION = 1,
+      /** Global interpolation for up to MaximumNumberOfCentersForGlobalInterpolation centers, partition of unity
+      interpolation otherwise. */
+      AUTOMATIC_INTERPOLATION = 2
+    };
+
     mitkClassMacro(CreateDistanceImageFromSurfaceFilter, ImageSource);
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
@@ -99,6 +122,31 @@ namespace mitk
     */
     itkSetMacro(DistanceImageVolume, unsigned int);
 
+    /**
+    \brief Set the method used to solve the interpolation problem. Default is AUTOMATIC_INTERPOLATION.
+    */
+    itkSetMacro(InterpolationMethod, InterpolationMethod);
+    itkGetMacro(InterpolationMethod, InterpolationMethod);
+
+    /**
+    \brief Maximum number of centers (contour points plus the inner and outer points) that are interpolated
+           globally if the interpolation method is AUTOMATIC_INTERPOLATION. Default is 3000.
+    */
+    itkSetMacro(MaximumNumberOfCentersForGlobalInterpolation, unsigned int);
+    itkGetMacro(MaximumNumberOfCentersForGlobalInterpolation, unsigned int);
+
+    /**
+    \brief Maximum number of centers in an octree cell of the partition of unity interpolation. Patches containing
+           less than half of this number are enlarged. Default is 64.
+    */
+    itkSetMacro(NumberOfCentersPerPatch, unsigned int);
+    itkGetMacro(NumberOfCentersPerPatch, unsigned int);
+
+    /**
+    \brief Returns true if the last update used the partition of unity interpolation.
+    */
+    itkGetMacro(UsedPartitionOfUnity, bool);
+
     void PrintEquationSystem();
 
     // Resets the filter, i.e. removes all inputs and outputs
@@ -120,6 +168,14 @@ namespace mitk
 
     void SetReferenceImage(itk::ImageBase<3>::Pointer referenceImage);
 
+    /**
+      \brief Set a flag that the filter polls while it runs, e.g. to cancel it from another thread.
+
+      If the flag becomes true, the filter throws itk::ProcessAborted. The flag must outlive the
+      execution of the filter. nullptr (default) disables the polling.
+    */
+    void SetCancelFlag(const std::atomic<bool> *cancelFlag);
+
   protected:
     CreateDistanceImageFromSurfaceFilter();
     ~CreateDistanceImageFromSurfaceFilter() override;
@@ -127,8 +183,53 @@ namespace mitk
     void GenerateOutputInformation() override;
 
   private:
-    void CreateSolutionMatrixAndFunctionValues();
-    double CalculateDistanceValue(PointType p);
+    typedef Eigen::Vector3d EigenPointType;
+
+    /**
+    \brief A local interpolation problem of the partition of unity interpolation.
+    */
+    struct Patch
+    {
+      EigenPointType Center;
+      double Radius;
+      Eigen::Matrix3Xd Centers;
+      Eigen::VectorXd Weights;
+    };
+
+    /**
+    \brief Regular grid of buckets that stores ids of objects overlapping each bucket.
+    */
+    class BucketGrid
+    {
+    public:
+      void Initialize(const EigenPointType &minimum, const EigenPointType &maximum, double bucketSize);
+      void Insert(unsigned int id, const EigenPointType &minimum, const EigenPointType &maximum);
+      /** Returns the ids of the bucket that contains the point or nullptr if the point is outside the grid. */
+      const std::vector<unsigned int> *GetBucket(const EigenPointType &point) const;
+      /** Appends the ids of all buckets overlapping the box [minimum, maximum] to ids. */
+      void GetIds(const EigenPointType &minimum, const EigenPointType &maximum, std::vector<unsigned int> &ids) const;
+
+    private:
+      bool GetBucketIndex(const EigenPointType &point, Eigen::Array3i &index) const;
+      void ClampedBucketIndex(const EigenPointType &point, Eigen::Array3i &index) const;
+
+      EigenPointType m_Origin;
+      double m_BucketSize;
+      Eigen::Array3i m_Size;
+      std::vector<std::vector<unsigned int>> m_Buckets;
+    };
+
+    double CalculateDistanceValue(const PointType &p) const;
+
+    void CreateInnerAndOuterPoints();
+    void SolveGlobalInterpolation();
+    void SolvePartitionOfUnityInterpolation();
+    void SubdivideCell(const EigenPointType &minimum,
+                       const EigenPointType &maximum,
+                       const std::vector<unsigned int> &centerIds,
+                       unsigned int depth);
+    void CreatePatch(const EigenPointType &center, double radius);
+    void GetCentersInSphere(const EigenPointType &center, double radius, std::vector<unsigned int> &centerIds) const;
 
     void FillDistanceImage();
 
@@ -154,14 +255,30 @@ namespace mitk
     void PreprocessContourPoints();
     void CreateEmptyDistanceImage();
 
+    /** Throws itk::ProcessAborted if AbortGenerateData or the cancel flag has been set */
+    void AbortIfRequested() const;
+
     // Datastructures for the interpolation
     CenterList m_Centers;
     NormalList m_Normals;
 
+    Eigen::Matrix3Xd m_CenterMatrix;
     Eigen::MatrixXd m_SolutionMatrix;
     Eigen::VectorXd m_FunctionValues;
     Eigen::VectorXd m_Weights;
 
+    // Datastructures for the partition of unity interpolation
+    std::vector<Patch> m_Patches;
+    BucketGrid m_CenterGrid;
+    BucketGrid m_PatchGrid;
+    EigenPointType m_PatchesMinimum;
+    EigenPointType m_PatchesMaximum;
+
+    InterpolationMethod m_InterpolationMethod;
+    unsigned int m_MaximumNumberOfCentersForGlobalInterpolation;
+    unsigned int m_NumberOfCentersPerPatch;
+    bool m_UsedPartitionOfUnity;
+
     DistanceImageType::Pointer m_DistanceImageITK;
     itk::ImageBase<3>::Pointer m_ReferenceImage;
 
@@ -171,6 +288,8 @@ namespace mitk
 
     bool m_UseProgressBar;
     unsigned int m_ProgressStepSize;
+
+    const std::atomic<bool> *m_CancelFlag;
   };
 
 } // namespace
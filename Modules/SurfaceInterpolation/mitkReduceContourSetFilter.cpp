@@ -23,6 +23,7 @@ mitk::ReduceContourSetFilter::ReduceContourSetFilter()
   this->m_UseProgressBar = false;
   this->m_ProgressStepSize = 1;
   m_NumberOfPointsAfterReduction = 0;
+  m_CancelFlag = nullptr;
 
   mitk::Surface::Pointer output = mitk::Surface::New();
   this->SetNthOutput(0, output.GetPointer());
@@ -43,6 +44,21 @@ void mitk::ReduceContourSetFilter::SetInput(const mitk::Surface *surface)
   this->SetInput(0, surface);
 }
 
+void mitk::ReduceContourSetFilter::SetCancelFlag(const std::atomic<bool> *cancelFlag)
+{
+  m_CancelFlag = cancelFlag;
+}
+
+void mitk::ReduceContourSetFilter::AbortIfRequested() const
+{
+  if (nullptr != m_CancelFlag && *m_CancelFlag)
+  {
+    itk::ProcessAborted e(__FILE__, __LINE__);
+    e.SetDescription("ReduceContourSetFilter has been aborted.");
+    throw e;
+  }
+}
+
 void mitk::ReduceContourSetFilter::GenerateData()
 {
   unsigned int numberOfInputs = this->GetNumberOfIndexedInputs();
@@ -58,6 +74,8 @@ void mitk::ReduceContourSetFilter::GenerateData()
 
   for (unsigned int i = 0; i < numberOfInputs; i++)
   {
+    this->AbortIfRequested();
+
     auto *currentSurface = this->GetInput(i);
     vtkSmartPointer<vtkPolyData> polyData = currentSurface->GetVtkPolyData();
 
@@ -25,6 +25,7 @@ found in the LICENSE file.
 #include "vtkPolygon.h"
 #include "vtkSmartPointer.h"
 
+#include <atomic>
 #include <stack>
 
 namespace mitk
@@ -96,6 +97,14 @@ namespace mitk
     */
     void SetProgressStepSize(unsigned int stepSize);
 
+    /**
+      \brief Set a flag that the filter polls while it runs, e.g. to cancel it from another thread.
+
+      If the flag becomes true, the filter throws itk::ProcessAborted. The flag must outlive the
+      execution of the filter. nullptr (default) disables the polling.
+    */
+    void SetCancelFlag(const std::atomic<bool> *cancelFlag);
+
   protected:
     ReduceContourSetFilter();
     ~ReduceContourSetFilter() override;
@@ -103,6 +112,9 @@ namespace mitk
     void GenerateOutputInformation() override;
 
   private:
+    /** Throws itk::ProcessAborted if the cancel flag has been set */
+    void AbortIfRequested() const;
+
     void ReduceNumberOfPointsByNthPoint(
       vtkIdType cellSize, const vtkIdType *cell, vtkPoints *points, vtkPolygon *reducedPolygon, vtkPoints *reducedPoints);
 
@@ -128,6 +140,8 @@ namespace mitk
 
     unsigned int m_NumberOfPointsAfterReduction;
 
+    const std::atomic<bool> *m_CancelFlag;
+
   }; // class
 
 } // namespace
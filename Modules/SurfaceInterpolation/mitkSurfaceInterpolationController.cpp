@@ -19,6 +19,50 @@ found in the LICENSE file.
 //#include "vtkXMLPolyDataWriter.h"
 #include "vtkPolyDataWriter.h"
 
+#include <algorithm>
+#include <atomic>
+
+struct mitk::SurfaceInterpolationController::InterpolationJob
+{
+  InterpolationJob()
+    : Generation(0),
+      Cancelled(false),
+      UseProgressBar(false),
+      TimeStep(0),
+      NumberOfReducedContours(0),
+      NumberOfPointsAfterReduction(0),
+      DistanceImageSpacing(0.0)
+  {
+  }
+
+  // Stops the job as soon as possible. May be called from another thread than the one running the job,
+  // thus only the flag is set, which the filters of the job poll.
+  void Cancel() { Cancelled = true; }
+
+  unsigned long Generation;
+  std::atomic<bool> Cancelled;
+  bool UseProgressBar;
+
+  // Input captured when the job is created
+  std::vector<Surface::Pointer> Contours;
+  Image::Pointer ReferenceImage;
+  TimeGeometry::Pointer SegmentationTimeGeometry;
+  TimeStepType TimeStep;
+
+  // Pipeline that is only used by this job
+  ReduceContourSetFilter::Pointer ReduceFilter;
+  ComputeContourSetNormalsFilter::Pointer NormalsFilter;
+  CreateDistanceImageFromSurfaceFilter::Pointer InterpolateSurfaceFilter;
+
+  // Results
+  unsigned int NumberOfReducedContours;
+  unsigned int NumberOfPointsAfterReduction;
+  Surface::Pointer InterpolationResult;
+  Surface::Pointer ContoursAsSurface;
+  Image::Pointer DistanceImage;
+  double DistanceImageSpacing;
+};
+
 // Check whether the given contours are coplanar
 bool ContoursCoplanar(mitk::SurfaceInterpolationController::ContourPositionInformation leftHandSide,
                       mitk::SurfaceInterpolationController::ContourPositionInformation rightHandSide)
@@ -74,20 +118,17 @@ mitk::SurfaceInterpolationController::ContourPositionInformation CreateContourPo
 }
 
 mitk::SurfaceInterpolationController::SurfaceInterpolationController()
-  : m_SelectedSegmentation(nullptr), m_CurrentTimePoint(0.)
+  : m_SelectedSegmentation(nullptr),
+    m_CurrentTimePoint(0.),
+    m_MinSpacing(-1.0),
+    m_MaxSpacing(-1.0),
+    m_DistanceImageVolume(50000),
+    m_RunningInterpolationJob(nullptr),
+    m_InterpolationGeneration(0),
+    m_InterpolationDelay(100),
+    m_StopInterpolationThread(false)
 {
   m_DistanceImageSpacing = 0.0;
-  m_ReduceFilter = ReduceContourSetFilter::New();
-  m_NormalsFilter = ComputeContourSetNormalsFilter::New();
-  m_InterpolateSurfaceFilter = CreateDistanceImageFromSurfaceFilter::New();
-  // m_TimeSelector = ImageTimeSelector::New();
-
-  m_ReduceFilter->SetUseProgressBar(false);
-  //  m_ReduceFilter->SetProgressStepSize(1);
-  m_NormalsFilter->SetUseProgressBar(true);
-  m_NormalsFilter->SetProgressStepSize(1);
-  m_InterpolateSurfaceFilter->SetUseProgressBar(true);
-  m_InterpolateSurfaceFilter->SetProgressStepSize(7);
 
   m_Contours = Surface::New();
 
@@ -97,10 +138,25 @@ mitk::SurfaceInterpolationController::SurfaceInterpolationController()
 
   m_InterpolationResult = nullptr;
   m_CurrentNumberOfReducedContours = 0;
+  m_NumberOfPointsAfterReduction = 0;
 }
 
 mitk::SurfaceInterpolationController::~SurfaceInterpolationController()
 {
+  {
+    std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+    m_StopInterpolationThread = true;
+    m_PendingInterpolationJob.reset();
+
+    if (nullptr != m_RunningInterpolationJob)
+      m_RunningInterpolationJob->Cancel();
+  }
+
+  m_InterpolationCondition.notify_all();
+
+  if (m_InterpolationThread.joinable())
+    m_InterpolationThread.join();
+
   // Removing all observers
   auto dataIter = m_SegmentationObserverTags.begin();
   for (; dataIter != m_SegmentationObserverTags.end(); ++dataIter)
@@ -177,14 +233,11 @@ void mitk::SurfaceInterpolationController::AddToInterpolationPipeline(ContourPos
   // Don't save a new empty contour
   if (pos == -1 && newContour->GetVtkPolyData()->GetNumberOfPoints() > 0)
   {
-    m_ReduceFilter->SetInput(m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].size(),
-                             newContour);
     m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].push_back(contourInfo);
   }
   else if (pos != -1 && newContour->GetVtkPolyData()->GetNumberOfPoints() > 0)
   {
     m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].at(pos) = contourInfo;
-    m_ReduceFilter->SetInput(pos, newContour);
   }
   else if (newContour->GetVtkPolyData()->GetNumberOfPoints() == 0)
   {
@@ -262,23 +315,140 @@ unsigned int mitk::SurfaceInterpolationController::GetNumberOfContours()
 
 void mitk::SurfaceInterpolationController::Interpolate()
 {
-  if (!m_SelectedSegmentation->GetTimeGeometry()->IsValidTimePoint(m_CurrentTimePoint))
+  auto job = this->CreateInterpolationJob();
+
+  std::unique_lock<std::mutex> lock(m_InterpolationMutex);
+
+  // Like an asynchronous request, the synchronous interpolation makes the results of all earlier requests outdated
+  const auto generation = ++m_InterpolationGeneration;
+  m_PendingInterpolationJob.reset();
+
+  if (nullptr != m_RunningInterpolationJob)
+    m_RunningInterpolationJob->Cancel();
+
+  lock.unlock();
+  m_InterpolationCondition.notify_all();
+
+  if (nullptr != job)
   {
-    MITK_WARN << "No interpolation possible, currently selected timepoint is not in the time bounds of currently selected segmentation. Time point: " << m_CurrentTimePoint;
+    job->Generation = generation;
+    job->UseProgressBar = true;
+    this->RunInterpolationJob(*job);
+  }
+
+  lock.lock();
+
+  // Results of outdated requests are discarded
+  if (generation != m_InterpolationGeneration)
+    return;
+
+  if (nullptr == job)
+  {
+    m_InterpolationResult = nullptr;
+    return;
+  }
+
+  this->PublishInterpolationResult(*job);
+}
+
+void mitk::SurfaceInterpolationController::RequestInterpolation()
+{
+  auto job = this->CreateInterpolationJob();
+
+  std::unique_lock<std::mutex> lock(m_InterpolationMutex);
+
+  // Every request makes the results of all earlier requests outdated
+  ++m_InterpolationGeneration;
+
+  if (nullptr != m_RunningInterpolationJob)
+    m_RunningInterpolationJob->Cancel();
+
+  if (nullptr == job)
+  {
+    m_PendingInterpolationJob.reset();
     m_InterpolationResult = nullptr;
+    lock.unlock();
+
+    m_InterpolationCondition.notify_all();
+    this->InvokeEvent(SurfaceInterpolationFinishedEvent());
     return;
   }
+
+  job->Generation = m_InterpolationGeneration;
+  m_PendingInterpolationJob = std::move(job);
+  m_LastInterpolationRequest = std::chrono::steady_clock::now();
+
+  if (!m_InterpolationThread.joinable())
+    m_InterpolationThread = std::thread(&SurfaceInterpolationController::InterpolationThreadLoop, this);
+
+  lock.unlock();
+  m_InterpolationCondition.notify_all();
+}
+
+void mitk::SurfaceInterpolationController::CancelInterpolation()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+    ++m_InterpolationGeneration;
+    m_PendingInterpolationJob.reset();
+
+    if (nullptr != m_RunningInterpolationJob)
+      m_RunningInterpolationJob->Cancel();
+  }
+
+  m_InterpolationCondition.notify_all();
+}
+
+void mitk::SurfaceInterpolationController::WaitForInterpolation()
+{
+  std::unique_lock<std::mutex> lock(m_InterpolationMutex);
+  m_InterpolationCondition.wait(
+    lock, [this] { return nullptr == m_PendingInterpolationJob && nullptr == m_RunningInterpolationJob; });
+}
+
+bool mitk::SurfaceInterpolationController::IsInterpolationRunning() const
+{
+  std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+  return nullptr != m_PendingInterpolationJob || nullptr != m_RunningInterpolationJob;
+}
+
+void mitk::SurfaceInterpolationController::SetInterpolationDelay(unsigned int milliseconds)
+{
+  std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+  m_InterpolationDelay = milliseconds;
+}
+
+unsigned int mitk::SurfaceInterpolationController::GetInterpolationDelay() const
+{
+  std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+  return m_InterpolationDelay;
+}
+
+std::unique_ptr<mitk::SurfaceInterpolationController::InterpolationJob>
+  mitk::SurfaceInterpolationController::CreateInterpolationJob()
+{
+  if (!m_SelectedSegmentation)
+  {
+    return nullptr;
+  }
+
+  if (!m_SelectedSegmentation->GetTimeGeometry()->IsValidTimePoint(m_CurrentTimePoint))
+  {
+    MITK_WARN << "No interpolation possible, currently selected timepoint is not in the time bounds of currently selected segmentation. Time point: " << m_CurrentTimePoint;
+    return nullptr;
+  }
   const auto currentTimeStep = m_SelectedSegmentation->GetTimeGeometry()->TimePointToTimeStep(m_CurrentTimePoint);
 
-  m_ReduceFilter->Update();
+  auto job = std::make_unique<InterpolationJob>();
+  job->TimeStep = currentTimeStep;
+  job->SegmentationTimeGeometry = m_SelectedSegmentation->GetTimeGeometry()->Clone();
 
-  m_CurrentNumberOfReducedContours = m_ReduceFilter->GetNumberOfOutputs();
-  if (m_CurrentNumberOfReducedContours == 1)
+  const ContourPositionInformationVec2D &sessionContours = m_ListOfInterpolationSessions[m_SelectedSegmentation];
+  if (currentTimeStep < sessionContours.size())
   {
-    vtkPolyData *tmp = m_ReduceFilter->GetOutput(0)->GetVtkPolyData();
-    if (tmp == nullptr)
+    for (const auto &contourInfo : sessionContours[currentTimeStep])
     {
-      m_CurrentNumberOfReducedContours = 0;
+      job->Contours.push_back(contourInfo.contour);
     }
   }
 
@@ -287,78 +457,226 @@ void mitk::SurfaceInterpolationController::Interpolate()
   timeSelector->SetTimeNr(currentTimeStep);
   timeSelector->SetChannelNr(0);
   timeSelector->Update();
-  mitk::Image::Pointer refSegImage = timeSelector->GetOutput();
+  job->ReferenceImage = timeSelector->GetOutput();
 
-  m_NormalsFilter->SetSegmentationBinaryImage(refSegImage);
-  for (unsigned int i = 0; i < m_CurrentNumberOfReducedContours; i++)
-  {
-    mitk::Surface::Pointer reducedContour = m_ReduceFilter->GetOutput(i);
-    reducedContour->DisconnectPipeline();
-    m_NormalsFilter->SetInput(i, reducedContour);
-    m_InterpolateSurfaceFilter->SetInput(i, m_NormalsFilter->GetOutput(i));
-  }
+  itk::ImageBase<3>::Pointer itkImage = itk::ImageBase<3>::New();
+  AccessFixedDimensionByItk_1(job->ReferenceImage, GetImageBase, 3, itkImage);
+
+  // Each job has its own pipeline, thus it does not interfere with contours that are added meanwhile
+  job->ReduceFilter = ReduceContourSetFilter::New();
+  job->ReduceFilter->SetMinSpacing(m_MinSpacing);
+  job->ReduceFilter->SetMaxSpacing(m_MaxSpacing);
+  job->ReduceFilter->SetCancelFlag(&job->Cancelled);
+
+  job->NormalsFilter = ComputeContourSetNormalsFilter::New();
+  if (m_MaxSpacing > 0)
+    job->NormalsFilter->SetMaxSpacing(m_MaxSpacing);
+  job->NormalsFilter->SetSegmentationBinaryImage(job->ReferenceImage);
+  job->NormalsFilter->SetCancelFlag(&job->Cancelled);
+
+  job->InterpolateSurfaceFilter = CreateDistanceImageFromSurfaceFilter::New();
+  job->InterpolateSurfaceFilter->SetReferenceImage(itkImage.GetPointer());
+  job->InterpolateSurfaceFilter->SetDistanceImageVolume(m_DistanceImageVolume);
+  job->InterpolateSurfaceFilter->SetCancelFlag(&job->Cancelled);
+
+  return job;
+}
 
-  if (m_CurrentNumberOfReducedContours < 2)
+bool mitk::SurfaceInterpolationController::RunInterpolationJob(InterpolationJob &job) const
+{
+  job.ReduceFilter->SetUseProgressBar(false);
+  job.NormalsFilter->SetUseProgressBar(job.UseProgressBar);
+  job.NormalsFilter->SetProgressStepSize(1);
+  job.InterpolateSurfaceFilter->SetUseProgressBar(job.UseProgressBar);
+  job.InterpolateSurfaceFilter->SetProgressStepSize(7);
+
+  if (job.Contours.empty())
   {
     // If no interpolation is possible reset the interpolation result
-    m_InterpolationResult = nullptr;
-    return;
+    job.InterpolationResult = nullptr;
+    return true;
   }
 
-  // Setting up progress bar
-  mitk::ProgressBar::GetInstance()->AddStepsToDo(10);
+  try
+  {
+    for (unsigned int i = 0; i < job.Contours.size(); ++i)
+    {
+      job.ReduceFilter->SetInput(i, job.Contours[i]);
+    }
+
+    if (job.Cancelled)
+      return false;
+
+    job.ReduceFilter->Update();
 
-  // create a surface from the distance-image
-  mitk::ImageToSurfaceFilter::Pointer imageToSurfaceFilter = mitk::ImageToSurfaceFilter::New();
-  imageToSurfaceFilter->SetInput(m_InterpolateSurfaceFilter->GetOutput());
-  imageToSurfaceFilter->SetThreshold(0);
-  imageToSurfaceFilter->SetSmooth(true);
-  imageToSurfaceFilter->SetSmoothIteration(20);
-  imageToSurfaceFilter->Update();
+    job.NumberOfPointsAfterReduction = job.ReduceFilter->GetNumberOfPointsAfterReduction();
+    job.NumberOfReducedContours = job.ReduceFilter->GetNumberOfOutputs();
+    if (job.NumberOfReducedContours == 1)
+    {
+      vtkPolyData *tmp = job.ReduceFilter->GetOutput(0)->GetVtkPolyData();
+      if (tmp == nullptr)
+      {
+        job.NumberOfReducedContours = 0;
+      }
+    }
+
+    if (job.NumberOfReducedContours < 2)
+    {
+      // If no interpolation is possible reset the interpolation result
+      job.InterpolationResult = nullptr;
+      return true;
+    }
+
+    for (unsigned int i = 0; i < job.NumberOfReducedContours; i++)
+    {
+      mitk::Surface::Pointer reducedContour = job.ReduceFilter->GetOutput(i);
+      reducedContour->DisconnectPipeline();
+      job.NormalsFilter->SetInput(i, reducedContour);
+      job.InterpolateSurfaceFilter->SetInput(i, job.NormalsFilter->GetOutput(i));
+    }
 
-  mitk::Surface::Pointer interpolationResult = mitk::Surface::New();
-  interpolationResult->Expand(m_SelectedSegmentation->GetTimeSteps());
+    if (job.Cancelled)
+      return false;
 
-  auto geometry = m_SelectedSegmentation->GetTimeGeometry()->Clone();
-  geometry->ReplaceTimeStepGeometries(mitk::Geometry3D::New());
-  interpolationResult->SetTimeGeometry(geometry);
+    // Setting up progress bar
+    if (job.UseProgressBar)
+      mitk::ProgressBar::GetInstance()->AddStepsToDo(10);
 
-  interpolationResult->SetVtkPolyData(imageToSurfaceFilter->GetOutput()->GetVtkPolyData(), currentTimeStep);
+    // create a surface from the distance-image
+    mitk::ImageToSurfaceFilter::Pointer imageToSurfaceFilter = mitk::ImageToSurfaceFilter::New();
+    imageToSurfaceFilter->SetInput(job.InterpolateSurfaceFilter->GetOutput());
+    imageToSurfaceFilter->SetThreshold(0);
+    imageToSurfaceFilter->SetSmooth(true);
+    imageToSurfaceFilter->SetSmoothIteration(20);
+    imageToSurfaceFilter->Update();
 
-  m_InterpolationResult = interpolationResult;
+    if (job.Cancelled)
+      return false;
 
-  m_DistanceImageSpacing = m_InterpolateSurfaceFilter->GetDistanceImageSpacing();
+    mitk::Surface::Pointer interpolationResult = mitk::Surface::New();
+    interpolationResult->Expand(job.SegmentationTimeGeometry->CountTimeSteps());
 
-  vtkSmartPointer<vtkAppendPolyData> polyDataAppender = vtkSmartPointer<vtkAppendPolyData>::New();
-  for (unsigned int i = 0; i < m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].size(); i++)
+    auto geometry = job.SegmentationTimeGeometry->Clone();
+    geometry->ReplaceTimeStepGeometries(mitk::Geometry3D::New());
+    interpolationResult->SetTimeGeometry(geometry);
+
+    interpolationResult->SetVtkPolyData(imageToSurfaceFilter->GetOutput()->GetVtkPolyData(), job.TimeStep);
+    interpolationResult->DisconnectPipeline();
+
+    job.InterpolationResult = interpolationResult;
+    job.DistanceImage = job.InterpolateSurfaceFilter->GetOutput();
+    job.DistanceImageSpacing = job.InterpolateSurfaceFilter->GetDistanceImageSpacing();
+
+    vtkSmartPointer<vtkAppendPolyData> polyDataAppender = vtkSmartPointer<vtkAppendPolyData>::New();
+    for (const auto &contour : job.Contours)
+    {
+      polyDataAppender->AddInputData(contour->GetVtkPolyData());
+    }
+    polyDataAppender->Update();
+
+    job.ContoursAsSurface = Surface::New();
+    job.ContoursAsSurface->SetVtkPolyData(polyDataAppender->GetOutput());
+
+    auto *contoursGeometry = static_cast<mitk::ProportionalTimeGeometry *>(job.ContoursAsSurface->GetTimeGeometry());
+    auto timeBounds = geometry->GetTimeBounds(job.TimeStep);
+    contoursGeometry->SetFirstTimePoint(timeBounds[0]);
+    contoursGeometry->SetStepDuration(timeBounds[1] - timeBounds[0]);
+
+    // Last progress step
+    if (job.UseProgressBar)
+      mitk::ProgressBar::GetInstance()->Progress(20);
+  }
+  catch (const itk::ProcessAborted &)
   {
-    polyDataAppender->AddInputData(
-      m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].at(i).contour->GetVtkPolyData());
+    return false;
   }
-  polyDataAppender->Update();
-  m_Contours->SetVtkPolyData(polyDataAppender->GetOutput());
 
-  auto* contoursGeometry = static_cast<mitk::ProportionalTimeGeometry*>(m_Contours->GetTimeGeometry());
-  auto timeBounds = geometry->GetTimeBounds(currentTimeStep);
-  contoursGeometry->SetFirstTimePoint(timeBounds[0]);
-  contoursGeometry->SetStepDuration(timeBounds[1] - timeBounds[0]);
+  return !job.Cancelled;
+}
 
-  // Last progress step
-  mitk::ProgressBar::GetInstance()->Progress(20);
+void mitk::SurfaceInterpolationController::PublishInterpolationResult(InterpolationJob &job)
+{
+  m_InterpolationResult = job.InterpolationResult;
+  m_CurrentNumberOfReducedContours = job.NumberOfReducedContours;
+  m_NumberOfPointsAfterReduction = job.NumberOfPointsAfterReduction;
 
-  m_InterpolationResult->DisconnectPipeline();
+  if (job.InterpolationResult.IsNotNull())
+  {
+    m_Contours = job.ContoursAsSurface;
+    m_DistanceImage = job.DistanceImage;
+    m_DistanceImageSpacing = job.DistanceImageSpacing;
+  }
+}
+
+void mitk::SurfaceInterpolationController::InterpolationThreadLoop()
+{
+  std::unique_lock<std::mutex> lock(m_InterpolationMutex);
+
+  while (true)
+  {
+    m_InterpolationCondition.wait(lock, [this] { return m_StopInterpolationThread || nullptr != m_PendingInterpolationJob; });
+
+    if (m_StopInterpolationThread)
+      break;
+
+    // Coalesce requests that follow each other within the delay, e.g. while contours are drawn quickly
+    const auto start = m_LastInterpolationRequest + std::chrono::milliseconds(m_InterpolationDelay);
+    if (std::chrono::steady_clock::now() < start)
+    {
+      m_InterpolationCondition.wait_until(lock, start);
+      continue;
+    }
+
+    std::unique_ptr<InterpolationJob> job = std::move(m_PendingInterpolationJob);
+    m_RunningInterpolationJob = job.get();
+    lock.unlock();
+
+    bool finished = false;
+
+    try
+    {
+      finished = this->RunInterpolationJob(*job);
+    }
+    catch (const std::exception &e)
+    {
+      MITK_ERROR << "3D interpolation failed: " << e.what();
+    }
+
+    lock.lock();
+
+    // Results of outdated requests are discarded
+    if (finished && job->Generation == m_InterpolationGeneration)
+    {
+      this->PublishInterpolationResult(*job);
+
+      lock.unlock();
+      this->InvokeEvent(SurfaceInterpolationFinishedEvent());
+      lock.lock();
+    }
+
+    m_RunningInterpolationJob = nullptr;
+    m_InterpolationCondition.notify_all();
+  }
 }
 
 mitk::Surface::Pointer mitk::SurfaceInterpolationController::GetInterpolationResult()
 {
+  std::lock_guard<std::mutex> lock(m_InterpolationMutex);
   return m_InterpolationResult;
 }
 
 mitk::Surface *mitk::SurfaceInterpolationController::GetContoursAsSurface()
 {
+  std::lock_guard<std::mutex> lock(m_InterpolationMutex);
   return m_Contours;
 }
 
+double mitk::SurfaceInterpolationController::GetDistanceImageSpacing() const
+{
+  std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+  return m_DistanceImageSpacing;
+}
+
 void mitk::SurfaceInterpolationController::SetDataStorage(DataStorage::Pointer ds)
 {
   m_DataStorage = ds;
@@ -366,18 +684,17 @@ void mitk::SurfaceInterpolationController::SetDataStorage(DataStorage::Pointer d
 
 void mitk::SurfaceInterpolationController::SetMinSpacing(double minSpacing)
 {
-  m_ReduceFilter->SetMinSpacing(minSpacing);
+  m_MinSpacing = minSpacing;
 }
 
 void mitk::SurfaceInterpolationController::SetMaxSpacing(double maxSpacing)
 {
-  m_ReduceFilter->SetMaxSpacing(maxSpacing);
-  m_NormalsFilter->SetMaxSpacing(maxSpacing);
+  m_MaxSpacing = maxSpacing;
 }
 
 void mitk::SurfaceInterpolationController::SetDistanceImageVolume(unsigned int distImgVolume)
 {
-  m_InterpolateSurfaceFilter->SetDistanceImageVolume(distImgVolume);
+  m_DistanceImageVolume = distImgVolume;
 }
 
 mitk::Image::Pointer mitk::SurfaceInterpolationController::GetCurrentSegmentation()
@@ -387,12 +704,18 @@ mitk::Image::Pointer mitk::SurfaceInterpolationController::GetCurrentSegmentatio
 
 mitk::Image *mitk::SurfaceInterpolationController::GetImage()
 {
-  return m_InterpolateSurfaceFilter->GetOutput();
+  std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+  return m_DistanceImage;
 }
 
 double mitk::SurfaceInterpolationController::EstimatePortionOfNeededMemory()
 {
-  double numberOfPointsAfterReduction = m_ReduceFilter->GetNumberOfPointsAfterReduction() * 3;
+  unsigned int numberOfPoints = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+    numberOfPoints = m_NumberOfPointsAfterReduction;
+  }
+  double numberOfPointsAfterReduction = numberOfPoints * 3.0;
   double sizeOfPoints = pow(numberOfPointsAfterReduction, 2) * sizeof(double);
   double totalMem = mitk::MemoryUtilities::GetTotalSizeOfPhysicalRam();
   double percentage = sizeOfPoints / totalMem;
@@ -421,6 +744,9 @@ void mitk::SurfaceInterpolationController::SetCurrentInterpolationSession(mitk::
   if (currentSegmentationImage.GetPointer() == m_SelectedSegmentation)
     return;
 
+  // Results of the previous session must not be published for the new one
+  this->CancelInterpolation();
+
   if (currentSegmentationImage.IsNull())
   {
     m_SelectedSegmentation = nullptr;
@@ -437,8 +763,11 @@ void mitk::SurfaceInterpolationController::SetCurrentInterpolationSession(mitk::
     ContourPositionInformationVec2D newList;
     m_ListOfInterpolationSessions.insert(
       std::pair<mitk::Image *, ContourPositionInformationVec2D>(m_SelectedSegmentation, newList));
-    m_InterpolationResult = nullptr;
-    m_CurrentNumberOfReducedContours = 0;
+    {
+      std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+      m_InterpolationResult = nullptr;
+      m_CurrentNumberOfReducedContours = 0;
+    }
 
     itk::MemberCommand<SurfaceInterpolationController>::Pointer command =
       itk::MemberCommand<SurfaceInterpolationController>::New();
@@ -485,16 +814,6 @@ bool mitk::SurfaceInterpolationController::ReplaceInterpolationSession(mitk::Ima
   if (m_SelectedSegmentation == oldSession)
     m_SelectedSegmentation = newSession;
 
-  const auto currentTimeStep = m_SelectedSegmentation->GetTimeGeometry()->TimePointToTimeStep(m_CurrentTimePoint);
-
-  mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-  timeSelector->SetInput(m_SelectedSegmentation);
-  timeSelector->SetTimeNr(currentTimeStep);
-  timeSelector->SetChannelNr(0);
-  timeSelector->Update();
-  mitk::Image::Pointer refSegImage = timeSelector->GetOutput();
-  m_NormalsFilter->SetSegmentationBinaryImage(refSegImage);
-
   this->RemoveInterpolationSession(oldSession);
   return true;
 }
@@ -510,7 +829,7 @@ void mitk::SurfaceInterpolationController::RemoveInterpolationSession(mitk::Imag
   {
     if (m_SelectedSegmentation == segmentationImage)
     {
-      m_NormalsFilter->SetSegmentationBinaryImage(nullptr);
+      this->CancelInterpolation();
       m_SelectedSegmentation = nullptr;
     }
     m_ListOfInterpolationSessions.erase(segmentationImage);
@@ -526,6 +845,8 @@ void mitk::SurfaceInterpolationController::RemoveInterpolationSession(mitk::Imag
 
 void mitk::SurfaceInterpolationController::RemoveAllInterpolationSessions()
 {
+  this->CancelInterpolation();
+
   // Removing all observers
   auto dataIter = m_SegmentationObserverTags.begin();
   while (dataIter != m_SegmentationObserverTags.end())
@@ -656,7 +977,7 @@ void mitk::SurfaceInterpolationController::OnSegmentationDeleted(const itk::Obje
   {
     if (m_SelectedSegmentation == tempImage)
     {
-      m_NormalsFilter->SetSegmentationBinaryImage(nullptr);
+      this->CancelInterpolation();
       m_SelectedSegmentation = nullptr;
     }
     m_SegmentationObserverTags.erase(tempImage);
@@ -666,12 +987,13 @@ void mitk::SurfaceInterpolationController::OnSegmentationDeleted(const itk::Obje
 
 void mitk::SurfaceInterpolationController::ReinitializeInterpolation()
 {
-  // If session has changed reset the pipeline
-  m_ReduceFilter->Reset();
-  m_NormalsFilter->Reset();
-  m_InterpolateSurfaceFilter->Reset();
-
-  itk::ImageBase<3>::Pointer itkImage = itk::ImageBase<3>::New();
+  // The pipeline is set up by each interpolation job, thus only the results of the old session are discarded
+  this->CancelInterpolation();
+  {
+    std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+    m_CurrentNumberOfReducedContours = 0;
+    m_NumberOfPointsAfterReduction = 0;
+  }
 
   if (m_SelectedSegmentation)
   {
@@ -680,16 +1002,6 @@ void mitk::SurfaceInterpolationController::ReinitializeInterpolation()
       MITK_WARN << "Interpolation cannot be reinitialized. Currently selected timepoint is not in the time bounds of the currently selected segmentation. Time point: " << m_CurrentTimePoint;
       return;
     }
-    const auto currentTimeStep = m_SelectedSegmentation->GetTimeGeometry()->TimePointToTimeStep(m_CurrentTimePoint);
-
-    mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-    timeSelector->SetInput(m_SelectedSegmentation);
-    timeSelector->SetTimeNr(currentTimeStep);
-    timeSelector->SetChannelNr(0);
-    timeSelector->Update();
-    mitk::Image::Pointer refSegImage = timeSelector->GetOutput();
-    AccessFixedDimensionByItk_1(refSegImage, GetImageBase, 3, itkImage);
-    m_InterpolateSurfaceFilter->SetReferenceImage(itkImage.GetPointer());
 
     unsigned int numTimeSteps = m_SelectedSegmentation->GetTimeSteps();
     unsigned int size = m_ListOfInterpolationSessions[m_SelectedSegmentation].size();
@@ -698,34 +1010,6 @@ void mitk::SurfaceInterpolationController::ReinitializeInterpolation()
       m_ListOfInterpolationSessions[m_SelectedSegmentation].resize(numTimeSteps);
     }
 
-    if (currentTimeStep < numTimeSteps)
-    {
-      unsigned int numContours = m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep].size();
-      for (unsigned int c = 0; c < numContours; ++c)
-      {
-        m_ReduceFilter->SetInput(c,
-                                 m_ListOfInterpolationSessions[m_SelectedSegmentation][currentTimeStep][c].contour);
-      }
-
-      m_ReduceFilter->Update();
-
-      m_CurrentNumberOfReducedContours = m_ReduceFilter->GetNumberOfOutputs();
-      if (m_CurrentNumberOfReducedContours == 1)
-      {
-        vtkPolyData *tmp = m_ReduceFilter->GetOutput(0)->GetVtkPolyData();
-        if (tmp == nullptr)
-        {
-          m_CurrentNumberOfReducedContours = 0;
-        }
-      }
-
-      for (unsigned int i = 0; i < m_CurrentNumberOfReducedContours; i++)
-      {
-        m_NormalsFilter->SetInput(i, m_ReduceFilter->GetOutput(i));
-        m_InterpolateSurfaceFilter->SetInput(i, m_NormalsFilter->GetOutput(i));
-      }
-    }
-
     Modified();
   }
 }
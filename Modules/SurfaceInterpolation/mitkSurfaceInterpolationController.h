@@ -43,15 +43,32 @@ found in the LICENSE file.
 
 #include "mitkProgressBar.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 namespace mitk
 {
+  /**
+   * @brief Invoked by SurfaceInterpolationController after an asynchronous interpolation has published its result.
+   *
+   * The event is invoked from the background thread of the interpolation (or from the thread calling
+   * RequestInterpolation() if there is nothing to interpolate). Observers must therefore be thread-safe and should
+   * only forward the notification to their own thread, e.g. with a queued Qt connection, where they query
+   * GetInterpolationResult(). Observers must not be added or removed while an interpolation is pending or running.
+   */
+  itkEventMacro(SurfaceInterpolationFinishedEvent, itk::AnyEvent);
+
   class MITKSURFACEINTERPOLATION_EXPORT SurfaceInterpolationController : public itk::Object
   {
   public:
     mitkClassMacroItkParent(SurfaceInterpolationController, itk::Object);
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
-    itkGetMacro(DistanceImageSpacing, double);
+
+    double GetDistanceImageSpacing() const;
 
     struct ContourPositionInformation
     {
@@ -117,9 +134,45 @@ namespace mitk
 
     /**
      * Interpolates the 3D surface from the given extracted contours
+     *
+     * Pending and running asynchronous interpolations are cancelled since their results would be outdated. The result
+     * is only published if no asynchronous interpolation has been requested in the meantime.
      */
     void Interpolate();
 
+    /**
+     * @brief Interpolates the 3D surface from the given extracted contours in a background thread.
+     *
+     * The contours of the current session are captured when the request is made. A running interpolation is
+     * cancelled and requests that follow each other within the interpolation delay are coalesced into a single run.
+     * The result of the latest request is published atomically, afterwards a SurfaceInterpolationFinishedEvent
+     * is invoked from the background thread.
+     */
+    void RequestInterpolation();
+
+    /**
+     * @brief Cancels the pending and the running asynchronous interpolation. The last published result is kept.
+     */
+    void CancelInterpolation();
+
+    /**
+     * @brief Blocks until no asynchronous interpolation is pending or running
+     */
+    void WaitForInterpolation();
+
+    /**
+     * @brief Returns true if an asynchronous interpolation is pending or running
+     */
+    bool IsInterpolationRunning() const;
+
+    /**
+     * @brief Sets the time in milliseconds an asynchronous interpolation waits for further requests before it
+     * starts. Default is 100 ms.
+     */
+    void SetInterpolationDelay(unsigned int milliseconds);
+
+    unsigned int GetInterpolationDelay() const;
+
     mitk::Surface::Pointer GetInterpolationResult();
 
     /**
@@ -216,16 +269,26 @@ namespace mitk
     void GetImageBase(itk::Image<TPixel, VImageDimension> *input, itk::ImageBase<3>::Pointer &result);
 
   private:
+    struct InterpolationJob;
+
     void ReinitializeInterpolation();
 
+    /** Captures everything the interpolation of the current session needs. Returns nullptr if no interpolation
+    is possible for the current time point. */
+    std::unique_ptr<InterpolationJob> CreateInterpolationJob();
+
+    /** Runs the interpolation pipeline of the job. Returns false if the job has been cancelled. */
+    bool RunInterpolationJob(InterpolationJob &job) const;
+
+    /** Makes the results of the job the current results. The caller has to lock the interpolation mutex. */
+    void PublishInterpolationResult(InterpolationJob &job);
+
+    void InterpolationThreadLoop();
+
     void OnSegmentationDeleted(const itk::Object *caller, const itk::EventObject &event);
 
     void AddToInterpolationPipeline(ContourPositionInformation contourInfo);
 
-    ReduceContourSetFilter::Pointer m_ReduceFilter;
-    ComputeContourSetNormalsFilter::Pointer m_NormalsFilter;
-    CreateDistanceImageFromSurfaceFilter::Pointer m_InterpolateSurfaceFilter;
-
     Surface::Pointer m_Contours;
 
     double m_DistanceImageSpacing;
@@ -239,12 +302,31 @@ namespace mitk
     mitk::Surface::Pointer m_InterpolationResult;
 
     unsigned int m_CurrentNumberOfReducedContours;
+    unsigned int m_NumberOfPointsAfterReduction;
 
     mitk::Image *m_SelectedSegmentation;
 
     std::map<mitk::Image *, unsigned long> m_SegmentationObserverTags;
 
     mitk::TimePointType m_CurrentTimePoint;
+
+    // Settings of the interpolation pipeline, which is instantiated for each job
+    double m_MinSpacing;
+    double m_MaxSpacing;
+    unsigned int m_DistanceImageVolume;
+
+    mitk::Image::Pointer m_DistanceImage;
+
+    // Asynchronous interpolation
+    mutable std::mutex m_InterpolationMutex;
+    std::condition_variable m_InterpolationCondition;
+    std::thread m_InterpolationThread;
+    std::unique_ptr<InterpolationJob> m_PendingInterpolationJob;
+    InterpolationJob *m_RunningInterpolationJob;
+    std::chrono::steady_clock::time_point m_LastInterpolationRequest;
+    unsigned long m_InterpolationGeneration;
+    unsigned int m_InterpolationDelay;
+    bool m_StopInterpolationThread;
   };
 }
 #endif
@@ -71,6 +71,12 @@ void QmitkDicomPreferencePage::CreateQtControl(QWidget* parent)
   displayOptionsLayout->addWidget(m_PathDefault);
 
   formLayout->addRow("Local database path:",displayOptionsLayout);
+
+  m_RememberHeaders = new QCheckBox("Remember scanned DICOM headers", m_MainControl);
+  m_RememberHeaders->setToolTip("Loading the same DICOM files again is faster if their headers are kept between sessions.\n"
+                                "The headers are stored unencrypted in the data directory of the application and contain patient data.");
+  formLayout->addRow("Loading:", m_RememberHeaders);
+
   m_MainControl->setLayout(formLayout);
 
   connect(m_PathDefault, SIGNAL(clicked()), this, SLOT(DefaultButtonPushed()));
@@ -91,6 +97,8 @@ void QmitkDicomPreferencePage::PerformCancel()
 bool QmitkDicomPreferencePage::PerformOk()
 {
   m_DicomPreferencesNode->Put("default dicom path",m_PathEdit->text());
+  m_DicomPreferencesNode->PutBool("remember scanned dicom headers", m_RememberHeaders->isChecked());
+  mitk::PluginActivator::UpdateDICOMTagIndex();
   return true;
 }
 
@@ -98,6 +106,7 @@ void QmitkDicomPreferencePage::Update()
 {
   QString path = m_DicomPreferencesNode->Get("default dicom path", CreateDefaultPath());
   m_PathEdit->setText(path);
+  m_RememberHeaders->setChecked(m_DicomPreferencesNode->GetBool("remember scanned dicom headers", false));
 }
 
 void QmitkDicomPreferencePage::DefaultButtonPushed()
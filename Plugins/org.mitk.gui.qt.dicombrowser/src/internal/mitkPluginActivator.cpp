@@ -15,23 +15,85 @@ found in the LICENSE file.
 #include "QmitkDicomPreferencePage.h"
 #include <usModuleInitialization.h>
 
+#include <mitkExceptionMacro.h>
+#include <mitkLogMacros.h>
+
+#include <berryIPreferencesService.h>
+#include <berryPlatform.h>
+
+#include <QFile>
+
 US_INITIALIZE_MODULE
 
 namespace mitk {
 ctkPluginContext* PluginActivator::pluginContext = nullptr;
+DICOMTagIndex::Pointer PluginActivator::dicomTagIndex;
 
 void PluginActivator::start(ctkPluginContext* context)
 {
   BERRY_REGISTER_EXTENSION_CLASS(QmitkDicomBrowser, context)
   BERRY_REGISTER_EXTENSION_CLASS(QmitkDicomPreferencePage, context)
   pluginContext = context;
+
+  UpdateDICOMTagIndex();
 }
 
 void PluginActivator::stop(ctkPluginContext* context)
 {
   Q_UNUSED(context)
+
+  if (dicomTagIndex.IsNotNull())
+  {
+    try
+    {
+      dicomTagIndex->Save();
+    }
+    catch (const mitk::Exception& e)
+    {
+      MITK_WARN << "Cannot save the DICOM tag index: " << e.GetDescription();
+    }
+
+    if (DICOMTagIndex::GetDefaultIndex() == dicomTagIndex)
+    {
+      DICOMTagIndex::SetDefaultIndex(nullptr);
+    }
+    dicomTagIndex = nullptr;
+  }
+
   pluginContext = nullptr;
 }
+
+void PluginActivator::UpdateDICOMTagIndex()
+{
+  if (nullptr == pluginContext)
+  {
+    return;
+  }
+
+  berry::IPreferences::Pointer prefs =
+    berry::Platform::GetPreferencesService()->GetSystemPreferences()->Node("/org.mitk.views.dicomreader");
+  const bool enabled = prefs->GetBool("remember scanned dicom headers", false);
+  const QString fileName = pluginContext->getDataFile("DICOMTagIndex.txt").absoluteFilePath();
+
+  if (enabled && dicomTagIndex.IsNull())
+  {
+    dicomTagIndex = DICOMTagIndex::New();
+    dicomTagIndex->SetFileName(fileName.toStdString());
+    dicomTagIndex->Load();
+    DICOMTagIndex::SetDefaultIndex(dicomTagIndex);
+  }
+  else if (!enabled && dicomTagIndex.IsNotNull())
+  {
+    if (DICOMTagIndex::GetDefaultIndex() == dicomTagIndex)
+    {
+      DICOMTagIndex::SetDefaultIndex(nullptr);
+    }
+    dicomTagIndex = nullptr;
+
+    // the user does not want the headers to be kept, so the stored ones are removed as well
+    QFile::remove(fileName);
+  }
+}
 ctkPluginContext* PluginActivator::getContext()
 {
     return pluginContext;
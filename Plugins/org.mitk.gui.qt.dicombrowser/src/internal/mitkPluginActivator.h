@@ -15,6 +15,8 @@ found in the LICENSE file.
 
 #include <ctkPluginActivator.h>
 
+#include <mitkDICOMTagIndex.h>
+
 namespace mitk {
 
 class PluginActivator :
@@ -29,8 +31,14 @@ public:
   void start(ctkPluginContext* context) override;
   void stop(ctkPluginContext* context) override;
   static ctkPluginContext* getContext();
+
+  /** Enables or disables the persistent index of scanned DICOM headers according to the preferences.
+   The index stores patient data in plain text, so it is only used if the user has enabled it.*/
+  static void UpdateDICOMTagIndex();
+
 private:
     static ctkPluginContext* pluginContext;
+    static DICOMTagIndex::Pointer dicomTagIndex;
 }; // PluginActivator
 
 }
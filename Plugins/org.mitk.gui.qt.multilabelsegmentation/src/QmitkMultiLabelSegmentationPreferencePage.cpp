@@ -31,6 +31,7 @@ QmitkMultiLabelSegmentationPreferencePage::QmitkMultiLabelSegmentationPreference
     m_SmoothingSpinBox(nullptr),
     m_DecimationSpinBox(nullptr),
     m_SelectionModeCheckBox(nullptr),
+    m_LayerCompressionCheckBox(nullptr),
     m_Initializing(false)
 {
 
@@ -91,6 +92,10 @@ void QmitkMultiLabelSegmentationPreferencePage::CreateQtControl(QWidget* parent)
 
   formLayout->addRow("Smoothed surface creation", surfaceLayout);
 
+  m_LayerCompressionCheckBox = new QCheckBox("Compress inactive layers", m_MainControl);
+  m_LayerCompressionCheckBox->setToolTip("If checked the pixel data of the layers that are not active is stored run-length encoded, which saves memory for segmentations with many layers. Switching layers takes longer.");
+  formLayout->addRow("Memory", m_LayerCompressionCheckBox);
+
   m_MainControl->setLayout(formLayout);
   this->Update();
   m_Initializing = false;
@@ -107,6 +112,7 @@ bool QmitkMultiLabelSegmentationPreferencePage::PerformOk()
   m_SegmentationPreferencesNode->PutDouble("smoothing value", m_SmoothingSpinBox->value());
   m_SegmentationPreferencesNode->PutDouble("decimation rate", m_DecimationSpinBox->value());
   m_SegmentationPreferencesNode->PutBool("auto selection", m_SelectionModeCheckBox->isChecked());
+  m_SegmentationPreferencesNode->PutBool("layer compression", m_LayerCompressionCheckBox->isChecked());
   return true;
 }
 
@@ -137,6 +143,7 @@ void QmitkMultiLabelSegmentationPreferencePage::Update()
   }
 
   m_SelectionModeCheckBox->setChecked( m_SegmentationPreferencesNode->GetBool("auto selection", false) );
+  m_LayerCompressionCheckBox->setChecked( m_SegmentationPreferencesNode->GetBool("layer compression", false) );
 
   m_SmoothingSpinBox->setValue(m_SegmentationPreferencesNode->GetDouble("smoothing value", 0.1));
   m_DecimationSpinBox->setValue(m_SegmentationPreferencesNode->GetDouble("decimation rate", 0.5));
@@ -66,6 +66,7 @@ protected:
   QDoubleSpinBox* m_SmoothingSpinBox;
   QDoubleSpinBox* m_DecimationSpinBox;
   QCheckBox* m_SelectionModeCheckBox;
+  QCheckBox* m_LayerCompressionCheckBox;
 
   bool m_Initializing;
 
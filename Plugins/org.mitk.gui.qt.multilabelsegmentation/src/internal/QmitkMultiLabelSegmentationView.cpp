@@ -63,6 +63,7 @@ QmitkMultiLabelSegmentationView::QmitkMultiLabelSegmentationView()
     m_ReferenceNode(nullptr),
     m_WorkingNode(nullptr),
     m_AutoSelectionEnabled(false),
+    m_LayerCompressionEnabled(false),
     m_MouseCursorSet(false)
 {
   m_SegmentationPredicate = mitk::NodePredicateAnd::New();
@@ -732,6 +733,11 @@ void QmitkMultiLabelSegmentationView::OnSegmentationSelectionChanged(QList<mitk:
   {
     OnEstablishLabelSetConnection();
 
+    // segmentations that have been created or loaded after the preferences were applied
+    auto *workingImage = dynamic_cast<mitk::LabelSetImage *>(m_WorkingNode->GetData());
+    if (nullptr != workingImage)
+      workingImage->SetLayerCompression(m_LayerCompressionEnabled);
+
     if (m_AutoSelectionEnabled)
     {
       // hide all segmentation nodes to later show only the automatically selected ones
@@ -781,6 +787,7 @@ void QmitkMultiLabelSegmentationView::OnInterpolationSelectionChanged(int index)
 void QmitkMultiLabelSegmentationView::OnPreferencesChanged(const berry::IBerryPreferences* prefs)
 {
   m_AutoSelectionEnabled = prefs->GetBool("auto selection", false);
+  m_LayerCompressionEnabled = prefs->GetBool("layer compression", false);
 
   mitk::BoolProperty::Pointer drawOutline = mitk::BoolProperty::New(prefs->GetBool("draw outline", true));
   mitk::LabelSetImage* labelSetImage;
@@ -799,6 +806,7 @@ void QmitkMultiLabelSegmentationView::OnPreferencesChanged(const berry::IBerryPr
     {
       // segmentation node is a multi label segmentation
       segmentation->SetProperty("labelset.contour.active", drawOutline);
+      labelSetImage->SetLayerCompression(m_LayerCompressionEnabled);
       //segmentation->SetProperty("opacity", mitk::FloatProperty::New(drawOutline->GetValue() ? 1.0f : 0.3f));
       // force render window update to show outline
       segmentation->GetData()->Modified();
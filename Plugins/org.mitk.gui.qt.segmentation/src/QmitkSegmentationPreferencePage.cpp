@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include <QRadioButton>
 #include <QMessageBox>
 #include <QDoubleSpinBox>
+#include <QSpinBox>
 
 #include <berryIPreferencesService.h>
 #include <berryPlatform.h>
@@ -34,6 +35,7 @@ QmitkSegmentationPreferencePage::QmitkSegmentationPreferencePage()
     m_DecimationSpinBox(nullptr),
     m_ClosingSpinBox(nullptr),
     m_SelectionModeCheckBox(nullptr),
+    m_UndoMemoryLimitSpinBox(nullptr),
     m_Initializing(false)
 {
 }
@@ -107,6 +109,14 @@ void QmitkSegmentationPreferencePage::CreateQtControl(QWidget* parent)
 
   formLayout->addRow("Smoothed surface creation", surfaceLayout);
 
+  m_UndoMemoryLimitSpinBox = new QSpinBox(m_MainControl);
+  m_UndoMemoryLimitSpinBox->setRange(0, 65536);
+  m_UndoMemoryLimitSpinBox->setSingleStep(256);
+  m_UndoMemoryLimitSpinBox->setSuffix(" MiB");
+  m_UndoMemoryLimitSpinBox->setSpecialValueText("Unlimited");
+  m_UndoMemoryLimitSpinBox->setToolTip("Memory of the undo history. The oldest changes cannot be undone anymore if it is exceeded. A value of 0 disables the limit.");
+  formLayout->addRow("Undo memory limit", m_UndoMemoryLimitSpinBox);
+
   m_MainControl->setLayout(formLayout);
   this->Update();
   m_Initializing = false;
@@ -126,6 +136,7 @@ bool QmitkSegmentationPreferencePage::PerformOk()
   m_SegmentationPreferencesNode->PutDouble("decimation rate", m_DecimationSpinBox->value());
   m_SegmentationPreferencesNode->PutDouble("closing ratio", m_ClosingSpinBox->value());
   m_SegmentationPreferencesNode->PutBool("auto selection", m_SelectionModeCheckBox->isChecked());
+  m_SegmentationPreferencesNode->PutInt("undo memory limit", m_UndoMemoryLimitSpinBox->value());
   return true;
 }
 
@@ -165,6 +176,7 @@ void QmitkSegmentationPreferencePage::Update()
   m_SmoothingSpinBox->setValue(m_SegmentationPreferencesNode->GetDouble("smoothing value", 1.0));
   m_DecimationSpinBox->setValue(m_SegmentationPreferencesNode->GetDouble("decimation rate", 0.5));
   m_ClosingSpinBox->setValue(m_SegmentationPreferencesNode->GetDouble("closing ratio", 0.0));
+  m_UndoMemoryLimitSpinBox->setValue(m_SegmentationPreferencesNode->GetInt("undo memory limit", 1024));
 }
 
 void QmitkSegmentationPreferencePage::OnSmoothingCheckboxChecked(int state)
@@ -22,6 +22,7 @@ class QWidget;
 class QCheckBox;
 class QRadioButton;
 class QDoubleSpinBox;
+class QSpinBox;
 
 class MITK_QT_SEGMENTATION QmitkSegmentationPreferencePage : public QObject, public berry::IQtPreferencePage
 {
@@ -69,6 +70,7 @@ protected:
   QDoubleSpinBox* m_DecimationSpinBox;
   QDoubleSpinBox* m_ClosingSpinBox;
   QCheckBox* m_SelectionModeCheckBox;
+  QSpinBox* m_UndoMemoryLimitSpinBox;
 
   bool m_Initializing;
 
@@ -34,6 +34,8 @@ found in the LICENSE file.
 #include "mitkPluginActivator.h"
 #include "mitkCameraController.h"
 #include "mitkLabelSetImage.h"
+#include "mitkLimitedLinearUndo.h"
+#include "mitkUndoController.h"
 #include "mitkImageTimeSelector.h"
 #include "mitkNodePredicateSubGeometry.h"
 
@@ -46,6 +48,7 @@ found in the LICENSE file.
 #include "mitkToolManagerProvider.h"
 
 #include <mitkWorkbenchUtil.h>
+#include <algorithm>
 #include <regex>
 
 const std::string QmitkSegmentationView::VIEW_ID = "org.mitk.views.segmentation";
@@ -177,6 +180,15 @@ void QmitkSegmentationView::OnPreferencesChanged(const berry::IBerryPreferences*
    auto autoSelectionEnabled = prefs->GetBool("auto selection", true);
    m_Controls->patImageSelector->SetAutoSelectNewNodes(autoSelectionEnabled);
    m_Controls->segImageSelector->SetAutoSelectNewNodes(autoSelectionEnabled);
+
+   // the undo history holds the slice differences of the segmentation tools, 0 means no limit
+   auto* undoModel = dynamic_cast<mitk::LimitedLinearUndo*>(mitk::UndoController::GetCurrentUndoModel());
+   if (undoModel != nullptr)
+   {
+     const auto memoryLimit = static_cast<std::size_t>(std::max(0, prefs->GetInt("undo memory limit", 1024)));
+     undoModel->SetMemoryLimit(memoryLimit * 1024 * 1024);
+   }
+
    this->ForceDisplayPreferencesUponAllImages();
 }
 